@@ -0,0 +1,71 @@
+#include "async_executor.hpp"
+#include "handles.hpp"
+#include "diagnostics.hpp"
+
+namespace mock_odbc {
+
+AsyncExecutor& AsyncExecutor::instance() {
+    static AsyncExecutor instance;
+    return instance;
+}
+
+void AsyncExecutor::submit(std::function<void()> task, int workers) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    queue_.push_back(std::move(task));
+
+    if (workers < 1) workers = 1;
+    while (static_cast<int>(workers_.size()) < workers) {
+        workers_.emplace_back([this] { worker_loop(); });
+    }
+    cv_.notify_one();
+}
+
+void AsyncExecutor::shutdown() {
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        workers.swap(workers_);
+    }
+    cv_.notify_all();
+
+    for (auto& t : workers) {
+        if (t.joinable()) t.join();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = false;
+}
+
+void AsyncExecutor::worker_loop() {
+    for (;;) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) return;  // stopping and drained
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        task();
+    }
+}
+
+bool reject_if_async_pending(StatementHandle* stmt) {
+    if (!std::atomic_load(&stmt->async_op_)) return false;
+
+    // The worker posts under the same lock; recheck once holding it
+    HandleLock lock(stmt);
+    auto op = std::atomic_load(&stmt->async_op_);
+    if (!op) return false;
+    add_async_pending_diagnostic(stmt, *op);
+    return true;
+}
+
+void add_async_pending_diagnostic(StatementHandle* stmt, const AsyncOperation& op) {
+    stmt->add_diagnostic(sqlstate::FUNCTION_SEQUENCE_ERROR, 0,
+                         std::string("Function sequence error: ") +
+                         op.function + " is still executing asynchronously");
+}
+
+} // namespace mock_odbc
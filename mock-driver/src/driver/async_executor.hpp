@@ -0,0 +1,61 @@
+#pragma once
+
+#include "common.hpp"
+#include "diagnostics.hpp"
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <thread>
+
+namespace mock_odbc {
+
+// State of a function running asynchronously on a statement
+// (SQL_ATTR_ASYNC_ENABLE = SQL_ASYNC_ENABLE_ON). Owned jointly by the
+// statement and the worker running it.
+struct AsyncOperation {
+    explicit AsyncOperation(const char* fn) : function(fn) {}
+
+    const char* function;                  // "SQLExecDirect", "SQLExecute", "SQLFetch"
+    std::atomic<bool> done{false};
+    std::atomic<bool> canceled{false};     // Set by SQLCancel
+    SQLRETURN result = SQL_SUCCESS;        // Valid once done
+    // The operation's own records. The worker posts into these rather than
+    // the statement's, so an HY010 posted by another call while it runs
+    // does not mix in; the call that collects the result publishes them.
+    DiagnosticArea diagnostics;
+};
+
+// Driver-internal worker pool that runs asynchronous statement work.
+// Workers are started on first use and stopped when the last environment
+// handle is freed, so nothing runs while the driver may be unloaded.
+class AsyncExecutor {
+public:
+    static AsyncExecutor& instance();
+
+    // Queue a task; starts `workers` threads if the pool is not running
+    void submit(std::function<void()> task, int workers);
+
+    // Drain the queue and join all workers
+    void shutdown();
+
+private:
+    AsyncExecutor() = default;
+    void worker_loop();
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::deque<std::function<void()>> queue_;
+    std::vector<std::thread> workers_;
+    bool stopping_ = false;
+};
+
+// Post HY010 and return true if `stmt` has an asynchronously executing
+// function. While one is running only that function, SQLCancel and the
+// diagnostic functions may be called on the statement. Locks the
+// statement, so call it before taking HandleLock.
+bool reject_if_async_pending(StatementHandle* stmt);
+
+// Post the HY010 for a call made while `op` runs; the statement is locked
+void add_async_pending_diagnostic(StatementHandle* stmt, const AsyncOperation& op);
+
+} // namespace mock_odbc
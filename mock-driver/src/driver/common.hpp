@@ -52,5 +52,7 @@ enum class HandleType {
 
 // Magic number to validate handles
 constexpr uint32_t HANDLE_MAGIC = 0x4D4F434B;  // "MOCK"
+// Left in a handle's memory when it is freed, so validation fails on it
+constexpr uint32_t HANDLE_FREED_MAGIC = 0x46524545;  // "FREE"
 
 } // namespace mock_odbc
@@ -1,7 +1,10 @@
 #include "config.hpp"
 #include <algorithm>
 #include <cctype>
+#include <cmath>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
 #include <thread>
 #include <random>
 
@@ -16,6 +19,13 @@ std::string to_lower(const std::string& s) {
     return result;
 }
 
+std::string to_upper(const std::string& s) {
+    std::string result = s;
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return std::toupper(c); });
+    return result;
+}
+
 std::string trim(const std::string& s) {
     auto start = s.find_first_not_of(" \t\r\n");
     if (start == std::string::npos) return "";
@@ -23,8 +33,168 @@ std::string trim(const std::string& s) {
     return s.substr(start, end - start + 1);
 }
 
+// Parse "250us", "10ms", "2s" or a bare number of milliseconds
+std::chrono::microseconds parse_duration(const std::string& str) {
+    double value = 0.0;
+    try {
+        value = std::stod(str);
+    } catch (...) {
+        return std::chrono::microseconds(0);
+    }
+    if (value < 0.0) value = 0.0;
+    
+    std::string unit = to_lower(str);
+    double scale = 1000.0;  // milliseconds
+    if (unit.find("us") != std::string::npos) {
+        scale = 1.0;
+    } else if (unit.find("ms") != std::string::npos) {
+        scale = 1000.0;
+    } else if (unit.find('s') != std::string::npos) {
+        scale = 1000000.0;
+    }
+    return std::chrono::microseconds(static_cast<long long>(value * scale));
+}
+
+// Parse "64000", "512K", "10MB", "1G" as bytes (binary multiples)
+uint64_t parse_byte_count(const std::string& str) {
+    double value = 0.0;
+    try {
+        value = std::stod(str);
+    } catch (...) {
+        return 0;
+    }
+    if (value < 0.0) return 0;
+    
+    std::string unit = to_lower(str);
+    if (unit.find('g') != std::string::npos) {
+        value *= 1024.0 * 1024.0 * 1024.0;
+    } else if (unit.find('m') != std::string::npos) {
+        value *= 1024.0 * 1024.0;
+    } else if (unit.find('k') != std::string::npos) {
+        value *= 1024.0;
+    }
+    return static_cast<uint64_t>(value);
+}
+
+constexpr const char* kDriverFunctionNames[] = {
+    "SQLDriverConnect",
+    "SQLExecDirect",
+    "SQLExecute",
+    "SQLPrepare",
+    "SQLFetch",
+    "SQLBulkOperations",
+    "SQLTables",
+    "SQLColumns",
+    "SQLGetTypeInfo",
+    "SQLEndTran",
+    "SQLFetchScroll",
+    "SQLGetData",
+    "SQLPrimaryKeys",
+    "SQLForeignKeys",
+    "SQLStatistics",
+    "SQLSpecialColumns",
+    "SQLProcedures",
+    "SQLProcedureColumns",
+    "SQLTablePrivileges",
+    "SQLColumnPrivileges",
+};
+static_assert(std::size(kDriverFunctionNames) == static_cast<size_t>(DriverFunction::Count),
+              "one name per DriverFunction");
+static_assert(static_cast<size_t>(DriverFunction::Count) <= 32,
+              "every DriverFunction needs a bit in fail_mask");
+
+std::mt19937_64& latency_rng() {
+    thread_local std::mt19937_64 gen(std::random_device{}());
+    return gen;
+}
+
 } // anonymous namespace
 
+const char* driver_function_name(DriverFunction function) {
+    return kDriverFunctionNames[static_cast<size_t>(function)];
+}
+
+bool LatencyProfile::enabled() const {
+    return base.count() > 0 ||
+           (distribution == LatencyDistribution::Bimodal &&
+            spike.count() > 0 && spike_probability > 0.0);
+}
+
+std::chrono::microseconds LatencyProfile::sample() const {
+    auto& gen = latency_rng();
+    double mean = static_cast<double>(base.count());
+    double spread = static_cast<double>(jitter.count());
+    double us = mean;
+    
+    switch (distribution) {
+        case LatencyDistribution::Fixed:
+            break;
+        case LatencyDistribution::Uniform:
+            if (spread > 0.0) {
+                us = std::uniform_real_distribution<double>(mean - spread, mean + spread)(gen);
+            }
+            break;
+        case LatencyDistribution::Normal:
+            if (spread > 0.0) {
+                us = std::normal_distribution<double>(mean, spread)(gen);
+            }
+            break;
+        case LatencyDistribution::LogNormal:
+            if (mean > 0.0 && spread > 0.0) {
+                // Pick mu/sigma so the samples have the configured mean and stddev
+                double sigma2 = std::log1p((spread / mean) * (spread / mean));
+                double mu = std::log(mean) - sigma2 / 2.0;
+                us = std::lognormal_distribution<double>(mu, std::sqrt(sigma2))(gen);
+            }
+            break;
+        case LatencyDistribution::Bimodal:
+            if (std::uniform_real_distribution<double>(0.0, 100.0)(gen) < spike_probability) {
+                us = static_cast<double>(spike.count());
+            }
+            break;
+    }
+    
+    return std::chrono::microseconds(us > 0.0 ? static_cast<long long>(us) : 0);
+}
+
+bool LatencyProfile::wait(CancelSignal* cancel) const {
+    auto delay = sample();
+    if (delay.count() <= 0) return true;
+    
+    if (!cancel) {
+        std::this_thread::sleep_for(delay);
+        return true;
+    }
+    return cancel->wait_for(delay);
+}
+
+std::chrono::microseconds NetworkProfile::transfer_time(size_t bytes) const {
+    auto wire = round_trip;
+    if (bandwidth > 0) {
+        wire += std::chrono::microseconds(static_cast<long long>(
+            static_cast<double>(bytes) * 1000000.0 / static_cast<double>(bandwidth)));
+    }
+    return wire;
+}
+
+void CancelSignal::reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    canceled_ = false;
+}
+
+void CancelSignal::cancel() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        canceled_ = true;
+    }
+    cv_.notify_all();
+}
+
+bool CancelSignal::wait_for(std::chrono::microseconds duration) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return !cv_.wait_for(lock, duration, [this] { return canceled_; });
+}
+
 bool DriverConfig::should_fail(const std::string& function_name) const {
     switch (mode) {
         case BehaviorMode::Success:
@@ -33,12 +203,8 @@ bool DriverConfig::should_fail(const std::string& function_name) const {
         case BehaviorMode::Failure:
             return true;
             
-        case BehaviorMode::Random: {
-            static std::random_device rd;
-            static std::mt19937 gen(rd());
-            std::uniform_int_distribution<> dis(1, 100);
-            return dis(gen) <= failure_probability;
-        }
+        case BehaviorMode::Random:
+            return random_failure();
         
         case BehaviorMode::Partial: {
             std::string lower_name = to_lower(function_name);
@@ -53,12 +219,37 @@ bool DriverConfig::should_fail(const std::string& function_name) const {
     return false;
 }
 
-void DriverConfig::apply_latency() const {
-    if (latency.count() > 0) {
-        std::this_thread::sleep_for(latency);
+bool DriverConfig::random_failure() const {
+    static std::random_device rd;
+    static std::mt19937 gen(rd());
+    std::uniform_int_distribution<> dis(1, 100);
+    return dis(gen) <= failure_probability;
+}
+
+void DriverConfig::update_fail_mask() {
+    fail_mask = 0;
+    for (size_t i = 0; i < static_cast<size_t>(DriverFunction::Count); ++i) {
+        std::string lower_name = to_lower(kDriverFunctionNames[i]);
+        for (const auto& f : fail_on) {
+            if (to_lower(f) == lower_name) {
+                fail_mask |= 1u << i;
+                break;
+            }
+        }
     }
 }
 
+bool DriverConfig::apply_latency(DriverFunction function, bool round_trip,
+                                 CancelSignal* cancel) const {
+    const LatencyProfile* profile = latency_for(function, round_trip);
+    return !profile || !profile->enabled() || profile->wait(cancel);
+}
+
+void DriverConfig::apply_round_trip(size_t bytes) const {
+    if (!network.enabled()) return;
+    std::this_thread::sleep_for(network.transfer_time(bytes));
+}
+
 std::unordered_map<std::string, std::string> parse_connection_string_pairs(
     const std::string& conn_str) {
     std::unordered_map<std::string, std::string> result;
@@ -154,6 +345,9 @@ DriverConfig parse_connection_string(const std::string& conn_str) {
     
     // Catalog
     config.catalog = get_string_value(pairs, "catalog", "Default");
+    config.catalog_tables = std::max(0, get_int_value(pairs, "catalogtables", 100));
+    config.catalog_columns = std::max(1, get_int_value(pairs, "catalogcolumns", 20));
+    config.data_file = get_string_value(pairs, "datafile", "");
     
     // Types
     config.types = get_string_value(pairs, "types", "AllTypes");
@@ -161,6 +355,26 @@ DriverConfig parse_connection_string(const std::string& conn_str) {
     // Result set size
     config.result_set_size = get_int_value(pairs, "resultsetsize", 100);
     
+    // Data generator
+    std::string seed_str = get_string_value(pairs, "dataseed", "");
+    if (!seed_str.empty()) {
+        // DataGenerator::configure() fails the connect on a bad value
+        bool digits = std::all_of(seed_str.begin(), seed_str.end(),
+                                  [](unsigned char c) { return std::isdigit(c); });
+        try {
+            if (digits) config.data_seed = std::stoull(seed_str);
+        } catch (const std::out_of_range&) {}
+        if (!config.data_seed) config.bad_data_seed = seed_str;
+    }
+    config.data_spec_file = get_string_value(pairs, "dataspec", "");
+    config.data_threads = std::max(0, get_int_value(pairs, "datathreads", 0));
+    const std::string gen_prefix = "gen.";
+    for (const auto& [key, value] : pairs) {
+        if (key.compare(0, gen_prefix.size(), gen_prefix) != 0) continue;
+        config.column_specs.emplace_back(to_upper(key.substr(gen_prefix.size())), value);
+    }
+    std::sort(config.column_specs.begin(), config.column_specs.end());  // Stable order
+    
     // FailOn - comma-separated list of functions
     std::string fail_on_str = get_string_value(pairs, "failon", "");
     if (!fail_on_str.empty()) {
@@ -170,30 +384,71 @@ DriverConfig parse_connection_string(const std::string& conn_str) {
             config.fail_on.push_back(trim(func));
         }
     }
+    config.update_fail_mask();
     
     // Error code
     config.error_code = get_string_value(pairs, "errorcode", "42000");
     
-    // Latency
-    std::string latency_str = get_string_value(pairs, "latency", "0");
-    if (!latency_str.empty()) {
-        int value = 0;
-        try {
-            value = std::stoi(latency_str);
-        } catch (...) {}
-        
-        if (latency_str.find("ms") != std::string::npos) {
-            config.latency = std::chrono::milliseconds(value);
-        } else if (latency_str.find("us") != std::string::npos) {
-            config.latency = std::chrono::milliseconds(value / 1000);
-        } else {
-            config.latency = std::chrono::milliseconds(value);
+    // Latency and its distribution
+    config.latency.base = parse_duration(get_string_value(pairs, "latency", "0"));
+    config.latency.jitter = parse_duration(get_string_value(pairs, "latencyjitter", "0"));
+    config.latency.spike = parse_duration(get_string_value(pairs, "latencyspike", "0"));
+    try {
+        config.latency.spike_probability =
+            std::stod(get_string_value(pairs, "latencyspikeprobability", "0"));
+    } catch (...) {}
+    config.latency.spike_probability =
+        std::clamp(config.latency.spike_probability, 0.0, 100.0);
+    
+    std::string distribution_str = to_lower(get_string_value(pairs, "latencydistribution", "fixed"));
+    if (distribution_str == "uniform") {
+        config.latency.distribution = LatencyDistribution::Uniform;
+    } else if (distribution_str == "normal") {
+        config.latency.distribution = LatencyDistribution::Normal;
+    } else if (distribution_str == "lognormal") {
+        config.latency.distribution = LatencyDistribution::LogNormal;
+    } else if (distribution_str == "bimodal") {
+        config.latency.distribution = LatencyDistribution::Bimodal;
+    } else {
+        config.latency.distribution = LatencyDistribution::Fixed;
+    }
+    
+    // Per-function latency: same distribution, own base value. Names are
+    // resolved here so the calls themselves index by DriverFunction.
+    const std::string latency_prefix = "latency.";
+    for (const auto& [key, value] : pairs) {
+        if (key.compare(0, latency_prefix.size(), latency_prefix) != 0) continue;
+        std::string name = key.substr(latency_prefix.size());
+        bool known = false;
+        for (size_t i = 0; i < static_cast<size_t>(DriverFunction::Count); ++i) {
+            if (to_lower(kDriverFunctionNames[i]) != name) continue;
+            LatencyProfile profile = config.latency;
+            profile.base = parse_duration(value);
+            config.function_latency[i] = profile;
+            known = true;
+            break;
         }
+        if (!known) config.bad_latency_function = name;
     }
     
+    // Simulated network
+    config.network.round_trip = parse_duration(get_string_value(pairs, "networkrtt", "0"));
+    config.network.bandwidth = parse_byte_count(get_string_value(pairs, "networkbandwidth", "0"));
+    config.network.fetch_batch_rows = get_int_value(pairs, "fetchbatchrows", 1);
+    if (config.network.fetch_batch_rows < 1) config.network.fetch_batch_rows = 1;
+    
     // Max connections
     config.max_connections = get_int_value(pairs, "maxconnections", 0);
     
+    // Async worker pool size
+    config.async_workers = get_int_value(pairs, "asyncworkers", 4);
+    if (config.async_workers < 1) config.async_workers = 1;
+    
+    // Handle locking
+    std::string thread_safety_str = to_lower(get_string_value(pairs, "threadsafety", "handle"));
+    config.thread_safety = thread_safety_str == "none" ? ThreadSafetyMode::None
+                                                       : ThreadSafetyMode::Handle;
+    
     // Transaction mode
     config.transaction_mode = get_string_value(pairs, "transactionmode", "Autocommit");
     
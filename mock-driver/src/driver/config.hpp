@@ -1,9 +1,14 @@
 #pragma once
 
 #include "common.hpp"
+#include <array>
+#include <optional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <chrono>
+#include <condition_variable>
+#include <mutex>
 
 namespace mock_odbc {
 
@@ -15,6 +20,101 @@ enum class BehaviorMode {
     Partial     // Some operations fail based on FailOn
 };
 
+// Functions that check for injected failures (FailOn=) or wait out a
+// simulated latency. The position of each one is its bit in
+// DriverConfig::fail_mask and its slot in DriverConfig::function_latency.
+enum class DriverFunction : uint8_t {
+    SQLDriverConnect,
+    SQLExecDirect,
+    SQLExecute,
+    SQLPrepare,
+    SQLFetch,
+    SQLBulkOperations,
+    SQLTables,
+    SQLColumns,
+    SQLGetTypeInfo,
+    SQLEndTran,
+    SQLFetchScroll,
+    SQLGetData,
+    SQLPrimaryKeys,
+    SQLForeignKeys,
+    SQLStatistics,
+    SQLSpecialColumns,
+    SQLProcedures,
+    SQLProcedureColumns,
+    SQLTablePrivileges,
+    SQLColumnPrivileges,
+    Count
+};
+
+// Name of a DriverFunction, e.g. "SQLFetch"
+const char* driver_function_name(DriverFunction function);
+
+// Whether the driver locks a handle for the length of each call
+enum class ThreadSafetyMode {
+    Handle,     // Lock per handle, so several threads may share one
+    None        // No handle locks; each handle used by one thread at a time
+};
+
+// Shape of a simulated latency distribution
+enum class LatencyDistribution {
+    Fixed,      // Always `base`
+    Uniform,    // Uniform in [base - jitter, base + jitter]
+    Normal,     // Normal with mean `base` and standard deviation `jitter`
+    LogNormal,  // Log-normal with mean `base` and standard deviation `jitter`
+    Bimodal     // `base`, or `spike` with probability `spike_probability`
+};
+
+class CancelSignal;
+
+// Simulated latency for one function or for the whole driver
+struct LatencyProfile {
+    LatencyDistribution distribution = LatencyDistribution::Fixed;
+    std::chrono::microseconds base{0};
+    std::chrono::microseconds jitter{0};
+    std::chrono::microseconds spike{0};
+    double spike_probability = 0.0;  // Percent (0-100)
+    
+    bool enabled() const;
+    
+    // Draw one delay (never negative)
+    std::chrono::microseconds sample() const;
+    
+    // Sleep for one sampled delay. Returns false if `cancel` was
+    // signalled during the wait.
+    bool wait(CancelSignal* cancel = nullptr) const;
+};
+
+// Simulated wire between the application and the database server
+struct NetworkProfile {
+    std::chrono::microseconds round_trip{0};  // Latency per request/response
+    uint64_t bandwidth = 0;                    // Bytes per second, 0 = unlimited
+    SQLLEN fetch_batch_rows = 1;               // Minimum rows per fetch round trip
+    
+    bool enabled() const { return round_trip.count() > 0 || bandwidth > 0; }
+    
+    // Time for one round trip that carries `bytes` of payload
+    std::chrono::microseconds transfer_time(size_t bytes) const;
+};
+
+// Lets SQLCancel interrupt a latency wait running on another thread
+class CancelSignal {
+public:
+    // Clear a previous cancel; called as a function starts waiting
+    void reset();
+    
+    // Wake the current wait, which then reports cancellation
+    void cancel();
+    
+    // Wait up to `duration`; returns false if cancel() was called first
+    bool wait_for(std::chrono::microseconds duration);
+    
+private:
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool canceled_ = false;
+};
+
 // Configuration from connection string
 struct DriverConfig {
     // Behavior mode
@@ -23,24 +123,57 @@ struct DriverConfig {
     // Catalog preset
     std::string catalog = "Default";
     
+    // Generated tables, and columns per table, of the Large preset
+    int catalog_tables = 100;
+    int catalog_columns = 20;
+    
+    // File holding user tables across runs (DataFile=); empty keeps them in memory
+    std::string data_file;
+    
     // Data types
     std::string types = "AllTypes";
     
     // Result set size
     int result_set_size = 100;
     
+    // Seeded generator for preset table rows; off unless one of these is set
+    std::optional<uint64_t> data_seed;                 // DataSeed=
+    std::string bad_data_seed;                         // DataSeed= that is not a number
+    std::string data_spec_file;                        // DataSpec= (column specs, one per line)
+    std::vector<std::pair<std::string, std::string>> column_specs;  // Gen.<[TABLE.]COLUMN|*>=<spec>
+    int data_threads = 0;                              // DataThreads=; 0 = hardware threads
+    
     // Functions to fail on
     std::vector<std::string> fail_on;
     
+    // Bits of the DriverFunctions named in fail_on; see update_fail_mask()
+    uint32_t fail_mask = 0;
+    
     // SQLSTATE to return on failure
     std::string error_code = "42000";
     
-    // Simulated latency
-    std::chrono::milliseconds latency{0};
+    // Simulated latency of round-trip functions (execute, connect, commit)
+    LatencyProfile latency;
+    
+    // Per-function latency (Latency.SQLFetch=200us), indexed by
+    // DriverFunction. Overrides `latency` and also applies to functions
+    // that are not delayed by default.
+    std::array<std::optional<LatencyProfile>, static_cast<size_t>(DriverFunction::Count)>
+        function_latency;
+    std::string bad_latency_function;  // Latency.<name> naming no DriverFunction; fails the connect
+    
+    // Simulated network: round trips and bytes on the wire
+    NetworkProfile network;
     
     // Max connections
     int max_connections = 0;  // 0 = unlimited
     
+    // Worker threads for statements with SQL_ATTR_ASYNC_ENABLE on
+    int async_workers = 4;
+    
+    // Handle locking (ThreadSafety=)
+    ThreadSafetyMode thread_safety = ThreadSafetyMode::Handle;
+    
     // Transaction mode
     std::string transaction_mode = "Autocommit";
     
@@ -77,8 +210,43 @@ struct DriverConfig {
     // Check if a function should fail
     bool should_fail(const std::string& function_name) const;
     
-    // Apply latency if configured
-    void apply_latency() const;
+    // Same for a driver entry point, without comparing or building names:
+    // a mode switch, then a bit test in Partial mode
+    bool should_fail(DriverFunction function) const {
+        switch (mode) {
+            case BehaviorMode::Success:
+                return false;
+            case BehaviorMode::Failure:
+                return true;
+            case BehaviorMode::Random:
+                return random_failure();
+            case BehaviorMode::Partial:
+                return (fail_mask >> static_cast<unsigned>(function)) & 1u;
+        }
+        return false;
+    }
+    
+    // Random mode: fail with failure_probability percent
+    bool random_failure() const;
+    
+    // Recompute fail_mask from fail_on
+    void update_fail_mask();
+    
+    // Latency for a function: its own entry, else the driver-wide profile
+    // when `round_trip` is set, else nullptr
+    const LatencyProfile* latency_for(DriverFunction function, bool round_trip) const {
+        const auto& own = function_latency[static_cast<size_t>(function)];
+        if (own) return &*own;
+        return round_trip ? &latency : nullptr;
+    }
+    
+    // Wait out the latency for a function. Returns false if `cancel` was
+    // signalled during the wait.
+    bool apply_latency(DriverFunction function, bool round_trip = true,
+                       CancelSignal* cancel = nullptr) const;
+    
+    // Wait for one network round trip carrying `bytes` (not cancellable)
+    void apply_round_trip(size_t bytes = 0) const;
 };
 
 // Parse connection string into configuration
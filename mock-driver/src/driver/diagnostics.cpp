@@ -1,19 +1,42 @@
 #include "diagnostics.hpp"
+#include <algorithm>
+#include <cstring>
 
 namespace mock_odbc {
 
-DiagnosticRecord make_diagnostic(const std::string& sqlstate,
-                                  SQLINTEGER native_error,
-                                  const std::string& message) {
+void DiagnosticArea::add(std::string_view sqlstate, SQLINTEGER native_error,
+                         std::string_view message, DiagnosticFormat format,
+                         SQLLEN row_number) {
     DiagnosticRecord rec;
-    rec.sqlstate = sqlstate;
+    std::memcpy(rec.sqlstate, sqlstate.data(), std::min<size_t>(sqlstate.size(), 5));
     rec.native_error = native_error;
-    rec.message = message;
-    rec.class_origin = "ISO 9075";
-    rec.subclass_origin = "ODBC 3.0";
-    rec.connection_name = "";
-    rec.server_name = "MockDB";
-    return rec;
+    rec.row_number = row_number;
+    rec.format = format;
+    rec.text_offset = static_cast<uint32_t>(text_.size());
+    rec.text_length = static_cast<uint32_t>(message.size());
+    text_.append(message.data(), message.size());
+    
+    if (count_ < kInlineRecords) {
+        inline_[count_] = rec;
+    } else {
+        overflow_.push_back(rec);
+    }
+    ++count_;
+}
+
+std::string_view DiagnosticArea::message(const DiagnosticRecord& rec) const {
+    std::string_view text(text_.data() + rec.text_offset, rec.text_length);
+    switch (rec.format) {
+        case DiagnosticFormat::Text:
+            return text;
+        case DiagnosticFormat::ParameterSet:
+            formatted_ = "Parameter set ";
+            formatted_ += std::to_string(rec.row_number);
+            formatted_ += ": ";
+            formatted_.append(text.data(), text.size());
+            return formatted_;
+    }
+    return text;
 }
 
 } // namespace mock_odbc
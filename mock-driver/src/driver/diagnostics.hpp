@@ -1,22 +1,74 @@
 #pragma once
 
 #include "common.hpp"
+#include <cstdint>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace mock_odbc {
 
-// Diagnostic record structure
+// How a record's message text is produced when the application reads it
+enum class DiagnosticFormat : uint8_t {
+    Text,           // The stored text as is
+    ParameterSet    // "Parameter set <row_number>: <text>"
+};
+
+// Diagnostic record structure. Trivially copyable: the SQLSTATE is held
+// inline and the message text lives in the owning DiagnosticArea.
 struct DiagnosticRecord {
-    std::string sqlstate;       // 5-character SQLSTATE
-    SQLINTEGER native_error;    // Native error code
-    std::string message;        // Error message
-    std::string class_origin;   // Class origin
-    std::string subclass_origin; // Subclass origin
-    std::string connection_name; // Connection name
-    std::string server_name;    // Server name
+    char sqlstate[6] = {0};     // 5-character SQLSTATE, NUL-terminated
+    SQLINTEGER native_error = 0; // Native error code
     SQLINTEGER column_number = SQL_NO_COLUMN_NUMBER;
     SQLLEN row_number = SQL_NO_ROW_NUMBER;
+    DiagnosticFormat format = DiagnosticFormat::Text;
+    uint32_t text_offset = 0;   // Message text in DiagnosticArea::text_
+    uint32_t text_length = 0;
+    
+    // The same for every record the mock driver posts
+    static constexpr const char* class_origin = "ISO 9075";
+    static constexpr const char* subclass_origin = "ODBC 3.0";
+    static constexpr const char* connection_name = "";
+    static constexpr const char* server_name = "MockDB";
+};
+
+// The diagnostic records of one handle. The first kInlineRecords live in
+// the handle itself; more go to a vector, and all message text to one
+// buffer. clear() keeps both allocations, so a call that succeeds never
+// touches the heap, and a handle that keeps failing stops allocating
+// once its buffers have grown to fit.
+class DiagnosticArea {
+public:
+    static constexpr size_t kInlineRecords = 4;
+    
+    void clear() {
+        count_ = 0;
+        overflow_.clear();
+        text_.clear();
+    }
+    
+    void add(std::string_view sqlstate, SQLINTEGER native_error, std::string_view message,
+             DiagnosticFormat format = DiagnosticFormat::Text,
+             SQLLEN row_number = SQL_NO_ROW_NUMBER);
+    
+    size_t size() const { return count_; }
+    
+    // Record `index` (0-based), or nullptr
+    const DiagnosticRecord* get(size_t index) const {
+        if (index >= count_) return nullptr;
+        return index < kInlineRecords ? &inline_[index] : &overflow_[index - kInlineRecords];
+    }
+    
+    // Message text of a record from this area, formatted on demand. The
+    // view is valid until the next call.
+    std::string_view message(const DiagnosticRecord& rec) const;
+    
+private:
+    DiagnosticRecord inline_[kInlineRecords];
+    std::vector<DiagnosticRecord> overflow_;
+    size_t count_ = 0;
+    std::string text_;
+    mutable std::string formatted_;
 };
 
 // Common SQLSTATE codes
@@ -40,9 +92,12 @@ namespace sqlstate {
     constexpr const char* OPTIONAL_FEATURE_NOT_IMPLEMENTED = "HYC00";
     constexpr const char* DRIVER_NOT_SUPPORT_FUNCTION = "IM001";
     constexpr const char* TIMEOUT_EXPIRED = "HYT00";
+    constexpr const char* OPERATION_CANCELED = "HY008";
     constexpr const char* GENERAL_ERROR = "HY000";
     constexpr const char* MEMORY_ALLOCATION_ERROR = "HY001";
     constexpr const char* INVALID_ARGUMENT_VALUE = "HY009";
+    constexpr const char* NON_CHARACTER_DATA_IN_PIECES = "HY019";
+    constexpr const char* INVALID_USE_OF_AUTO_DESC = "HY017";
     constexpr const char* INVALID_PARAMETER_NUMBER = "07009";
     constexpr const char* DATA_TYPE_ATTRIBUTE_VIOLATION = "07006";
     constexpr const char* INVALID_APPLICATION_BUFFER_TYPE = "HY003";
@@ -54,9 +109,4 @@ namespace sqlstate {
     constexpr const char* NO_DATA = "02000";
 }
 
-// Create diagnostic from SQLSTATE
-DiagnosticRecord make_diagnostic(const std::string& sqlstate, 
-                                  SQLINTEGER native_error,
-                                  const std::string& message);
-
 } // namespace mock_odbc
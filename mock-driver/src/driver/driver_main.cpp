@@ -2,6 +2,7 @@
 // This file contains the DLL entry point and SQLAllocHandle/SQLFreeHandle implementations
 
 #include "driver/handles.hpp"
+#include "driver/async_executor.hpp"
 #include "driver/diagnostics.hpp"
 #include "mock/mock_catalog.hpp"
 #include "mock/behaviors.hpp"
@@ -41,6 +42,13 @@ static void driver_fini() {
 
 using namespace mock_odbc;
 
+namespace {
+
+// Live environment handles; the async worker pool is stopped with the last one
+std::atomic<int> g_environment_count{0};
+
+} // anonymous namespace
+
 extern "C" {
 
 // SQLAllocHandle - Allocate a handle
@@ -63,6 +71,7 @@ SQLRETURN SQL_API SQLAllocHandle(
             }
             
             auto* env = new EnvironmentHandle();
+            g_environment_count.fetch_add(1);
             *phOutput = static_cast<SQLHANDLE>(env);
             return SQL_SUCCESS;
         }
@@ -90,7 +99,7 @@ SQLRETURN SQL_API SQLAllocHandle(
                 return SQL_ERROR;
             }
             
-            auto* stmt = new StatementHandle(conn);
+            auto* stmt = conn->allocate_statement();
             *phOutput = static_cast<SQLHANDLE>(stmt);
             return SQL_SUCCESS;
         }
@@ -101,7 +110,7 @@ SQLRETURN SQL_API SQLAllocHandle(
                 return SQL_INVALID_HANDLE;
             }
             
-            auto* desc = new DescriptorHandle(conn, true);
+            auto* desc = conn->allocate_descriptor();
             *phOutput = static_cast<SQLHANDLE>(desc);
             return SQL_SUCCESS;
         }
@@ -129,6 +138,9 @@ SQLRETURN SQL_API SQLFreeHandle(
             }
             
             delete env;
+            if (g_environment_count.fetch_sub(1) == 1) {
+                AsyncExecutor::instance().shutdown();
+            }
             return SQL_SUCCESS;
         }
         
@@ -157,8 +169,9 @@ SQLRETURN SQL_API SQLFreeHandle(
         case SQL_HANDLE_STMT: {
             auto* stmt = validate_stmt_handle(hHandle);
             if (!stmt) return SQL_INVALID_HANDLE;
+            if (reject_if_async_pending(stmt)) return SQL_ERROR;
             
-            delete stmt;
+            stmt->connection()->free_statement(stmt);
             return SQL_SUCCESS;
         }
         
@@ -166,7 +179,14 @@ SQLRETURN SQL_API SQLFreeHandle(
             auto* desc = validate_desc_handle(hHandle);
             if (!desc) return SQL_INVALID_HANDLE;
             
-            delete desc;
+            // Implicit descriptors are freed with their statement
+            if (desc->alloc_type_ == SQL_DESC_ALLOC_AUTO) {
+                desc->add_diagnostic(sqlstate::INVALID_USE_OF_AUTO_DESC, 0,
+                                    "Invalid use of an automatically allocated descriptor handle");
+                return SQL_ERROR;
+            }
+            
+            desc->connection()->free_descriptor(desc);
             return SQL_SUCCESS;
         }
         
@@ -284,6 +304,7 @@ SQLRETURN SQL_API SQLSetCursorName(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     (void)szCursor;
     (void)cbCursor;
@@ -300,6 +321,7 @@ SQLRETURN SQL_API SQLGetCursorName(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     // Return a generated cursor name
     std::string cursor_name = "SQL_CUR" + std::to_string(reinterpret_cast<uintptr_t>(stmt));
@@ -326,9 +348,11 @@ SQLRETURN SQL_API SQLFetchScroll(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);
     
     stmt->clear_diagnostics();
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLFetchScroll, false)) return SQL_ERROR;
     
     if (!stmt->executed_) {
         stmt->add_diagnostic(sqlstate::INVALID_CURSOR_STATE, 0,
@@ -344,7 +368,7 @@ SQLRETURN SQL_API SQLFetchScroll(
     }
     
     SQLLEN new_row = stmt->current_row_;
-    SQLLEN total_rows = static_cast<SQLLEN>(stmt->result_data_.size());
+    SQLLEN total_rows = static_cast<SQLLEN>(stmt->result_row_count());
     
     switch (fFetchType) {
         case SQL_FETCH_NEXT:
@@ -380,11 +404,14 @@ SQLRETURN SQL_API SQLFetchScroll(
         return SQL_NO_DATA;
     }
     
+    if (!simulate_network_delay(stmt, claim_fetch_transfer(stmt, new_row))) return SQL_ERROR;
+    
     stmt->current_row_ = new_row;
     stmt->cursor_open_ = true;
+    stmt->get_data_ = {};
     
     // Transfer data to bound columns (same logic as SQLFetch)
-    const auto& row = stmt->result_data_[stmt->current_row_];
+    const auto& row = stmt->result_row(static_cast<size_t>(stmt->current_row_));
     
     for (const auto& [col_num, binding] : stmt->column_bindings_) {
         if (col_num < 1 || col_num > static_cast<SQLUSMALLINT>(row.size())) {
@@ -469,21 +496,6 @@ SQLRETURN SQL_API SQLFetchScroll(
     return SQL_SUCCESS;
 }
 
-// Bulk operations (stub)
-SQLRETURN SQL_API SQLBulkOperations(
-    SQLHSTMT hstmt,
-    SQLSMALLINT Operation) {
-    
-    auto* stmt = validate_stmt_handle(hstmt);
-    if (!stmt) return SQL_INVALID_HANDLE;
-    
-    (void)Operation;
-    
-    stmt->add_diagnostic(sqlstate::OPTIONAL_FEATURE_NOT_IMPLEMENTED, 0,
-                        "Bulk operations not supported");
-    return SQL_ERROR;
-}
-
 // SetPos (stub)
 SQLRETURN SQL_API SQLSetPos(
     SQLHSTMT hstmt,
@@ -493,6 +505,7 @@ SQLRETURN SQL_API SQLSetPos(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     (void)iRow;
     (void)fOption;
@@ -503,33 +516,4 @@ SQLRETURN SQL_API SQLSetPos(
     return SQL_ERROR;
 }
 
-// ParamData/PutData for long data
-SQLRETURN SQL_API SQLParamData(
-    SQLHSTMT hstmt,
-    SQLPOINTER* prgbValue) {
-    
-    auto* stmt = validate_stmt_handle(hstmt);
-    if (!stmt) return SQL_INVALID_HANDLE;
-    
-    (void)prgbValue;
-    
-    // Mock: no data-at-execution parameters
-    return SQL_SUCCESS;
-}
-
-SQLRETURN SQL_API SQLPutData(
-    SQLHSTMT hstmt,
-    SQLPOINTER rgbValue,
-    SQLLEN cbValue) {
-    
-    auto* stmt = validate_stmt_handle(hstmt);
-    if (!stmt) return SQL_INVALID_HANDLE;
-    
-    (void)rgbValue;
-    (void)cbValue;
-    
-    // Mock: accept but don't use
-    return SQL_SUCCESS;
-}
-
 } // extern "C"
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace mock_odbc {
+
+// Doubly linked list of child handles, threaded through the handles'
+// own sibling_prev_/sibling_next_ links. Adding and removing a handle
+// is O(1) and allocates nothing. A handle is in at most one list.
+template<typename T>
+class HandleList {
+public:
+    class iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T*;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T**;
+        using reference = T*;
+
+        explicit iterator(T* node) : node_(node) {}
+        T* operator*() const { return node_; }
+        iterator& operator++() {
+            node_ = static_cast<T*>(node_->sibling_next_);
+            return *this;
+        }
+        bool operator==(const iterator& other) const { return node_ == other.node_; }
+        bool operator!=(const iterator& other) const { return node_ != other.node_; }
+    private:
+        T* node_;
+    };
+
+    HandleList() = default;
+    HandleList(const HandleList&) = delete;
+    HandleList& operator=(const HandleList&) = delete;
+
+    iterator begin() const { return iterator(head_); }
+    iterator end() const { return iterator(nullptr); }
+    bool empty() const { return head_ == nullptr; }
+    size_t size() const { return size_; }
+    T* front() const { return head_; }
+
+    void push_back(T* handle) {
+        handle->sibling_prev_ = tail_;
+        handle->sibling_next_ = nullptr;
+        if (tail_) tail_->sibling_next_ = handle;
+        else head_ = handle;
+        tail_ = handle;
+        ++size_;
+    }
+
+    void remove(T* handle) {
+        auto* prev = static_cast<T*>(handle->sibling_prev_);
+        auto* next = static_cast<T*>(handle->sibling_next_);
+        if (prev) prev->sibling_next_ = next;
+        else head_ = next;
+        if (next) next->sibling_prev_ = prev;
+        else tail_ = prev;
+        handle->sibling_prev_ = handle->sibling_next_ = nullptr;
+        --size_;
+    }
+
+private:
+    T* head_ = nullptr;
+    T* tail_ = nullptr;
+    size_t size_ = 0;
+};
+
+// Slab allocator for one handle type. Slots are carved from slabs of
+// kSlabSlots and never returned to the heap until the pool goes away, so
+// a freed handle's memory stays mapped and keeps its freed magic number:
+// validating it fails instead of reading memory malloc gave to someone
+// else. Free slots are reused oldest first, which keeps a just-freed
+// handle detectable until every other free slot has been handed out.
+template<typename T, size_t kSlabSlots = 32>
+class HandlePool {
+public:
+    HandlePool() = default;
+    HandlePool(const HandlePool&) = delete;
+    HandlePool& operator=(const HandlePool&) = delete;
+
+    // Every handle must have been destroyed before the pool is
+    ~HandlePool() = default;
+
+    template<typename... Args>
+    T* create(Args&&... args) {
+        if (!free_head_) grow();
+        Slot* slot = free_head_;
+        free_head_ = slot->next_free;
+        if (!free_head_) free_tail_ = nullptr;
+        T* handle;
+        try {
+            handle = ::new (static_cast<void*>(slot->storage)) T(std::forward<Args>(args)...);
+        } catch (...) {
+            push_free(slot);
+            throw;
+        }
+        ++live_;
+        return handle;
+    }
+
+    void destroy(T* handle) {
+        // storage is the slot's first member, so the handle's address is
+        // the slot's
+        Slot* slot = reinterpret_cast<Slot*>(handle);
+        handle->~T();
+        push_free(slot);
+        --live_;
+    }
+
+    size_t live() const { return live_; }
+    size_t capacity() const { return slabs_.size() * kSlabSlots; }
+
+private:
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Slot* next_free;
+    };
+
+    void grow() {
+        slabs_.emplace_back(new Slot[kSlabSlots]);
+        for (size_t i = 0; i < kSlabSlots; ++i) {
+            push_free(&slabs_.back()[i]);
+        }
+    }
+
+    void push_free(Slot* slot) {
+        slot->next_free = nullptr;
+        if (free_tail_) free_tail_->next_free = slot;
+        else free_head_ = slot;
+        free_tail_ = slot;
+    }
+
+    std::vector<std::unique_ptr<Slot[]>> slabs_;
+    Slot* free_head_ = nullptr;
+    Slot* free_tail_ = nullptr;
+    size_t live_ = 0;
+};
+
+} // namespace mock_odbc
@@ -1,5 +1,6 @@
 #include "handles.hpp"
-#include <algorithm>
+#include "../mock/data_file.hpp"
+#include "../mock/mock_catalog.hpp"
 
 namespace mock_odbc {
 
@@ -8,20 +9,25 @@ OdbcHandle::OdbcHandle(HandleType type)
     : magic_(HANDLE_MAGIC), type_(type) {
 }
 
-void OdbcHandle::clear_diagnostics() {
-    diagnostics_.clear();
+OdbcHandle::~OdbcHandle() {
+    // Written through volatile so the store isn't dropped as dead: pooled
+    // handles keep their memory, and validation reads this afterwards
+    *static_cast<volatile uint32_t*>(&magic_) = HANDLE_FREED_MAGIC;
 }
 
-void OdbcHandle::add_diagnostic(const std::string& sqlstate, SQLINTEGER native_error,
-                                 const std::string& message) {
-    diagnostics_.push_back(make_diagnostic(sqlstate, native_error, message));
+void OdbcHandle::add_diagnostic(std::string_view sqlstate, SQLINTEGER native_error,
+                                std::string_view message) {
+    diagnostics_.add(sqlstate, native_error, message);
+}
+
+void OdbcHandle::add_parameter_diagnostic(std::string_view sqlstate, SQLLEN param_set,
+                                          std::string_view message) {
+    diagnostics_.add(sqlstate, 0, message, DiagnosticFormat::ParameterSet, param_set);
 }
 
 const DiagnosticRecord* OdbcHandle::get_diagnostic(SQLSMALLINT rec_number) const {
-    if (rec_number < 1 || static_cast<size_t>(rec_number) > diagnostics_.size()) {
-        return nullptr;
-    }
-    return &diagnostics_[rec_number - 1];
+    if (rec_number < 1) return nullptr;
+    return diagnostics_.get(static_cast<size_t>(rec_number - 1));
 }
 
 // EnvironmentHandle
@@ -29,12 +35,10 @@ EnvironmentHandle::EnvironmentHandle() : OdbcHandle(HandleType::ENV) {
 }
 
 EnvironmentHandle::~EnvironmentHandle() {
-    // Clean up any remaining connections
-    for (auto* conn : connections_) {
-        delete conn;
+    // Clean up any remaining connections; each unlinks itself
+    while (!connections_.empty()) {
+        delete connections_.front();
     }
-    connections_.clear();
-    magic_ = 0;  // Invalidate handle
 }
 
 // ConnectionHandle
@@ -46,80 +50,107 @@ ConnectionHandle::ConnectionHandle(EnvironmentHandle* env)
 }
 
 ConnectionHandle::~ConnectionHandle() {
-    // Clean up any remaining statements
-    for (auto* stmt : statements_) {
-        delete stmt;
+    // Clean up any remaining statements and descriptors
+    while (!statements_.empty()) {
+        StatementHandle* stmt = statements_.front();
+        statements_.remove(stmt);
+        release_statement(stmt);
+    }
+    while (!descriptors_.empty()) {
+        DescriptorHandle* desc = descriptors_.front();
+        descriptors_.remove(desc);
+        descriptor_pool_.destroy(desc);
     }
-    statements_.clear();
     
     // Remove from environment
     if (env_) {
-        auto it = std::find(env_->connections_.begin(), env_->connections_.end(), this);
-        if (it != env_->connections_.end()) {
-            env_->connections_.erase(it);
-        }
+        env_->connections_.remove(this);
     }
-    magic_ = 0;
 }
 
-// StatementHandle
-StatementHandle::StatementHandle(ConnectionHandle* conn) 
-    : OdbcHandle(HandleType::STMT), conn_(conn) {
-    if (conn_) {
-        conn_->statements_.push_back(this);
-    }
+StatementHandle* ConnectionHandle::allocate_statement() {
+    std::unique_lock<std::mutex> lock(handles_mutex_, std::defer_lock);
+    if (thread_safe_) lock.lock();
+    auto* stmt = statement_pool_.create(this);
+    stmt->thread_safe_ = thread_safe_;
+    stmt->metadata_id_ = metadata_id_;
     // The Windows DM calls SQLGetStmtAttrW for the four implicit
     // descriptor handles immediately after SQLAllocHandle(SQL_HANDLE_STMT).
     // If they are NULL the DM's internal statement structure is incomplete
     // and every subsequent statement-level call crashes (access violation
     // at ODBC32.dll+0x3E48).  Allocate them here unconditionally.
-    app_param_desc_ = new DescriptorHandle(conn_, true);
-    imp_param_desc_ = new DescriptorHandle(conn_, false);
-    app_row_desc_   = new DescriptorHandle(conn_, true);
-    imp_row_desc_   = new DescriptorHandle(conn_, false);
-}
-
-StatementHandle::~StatementHandle() {
-    // Clean up descriptors if we own them
-    delete app_param_desc_;
-    delete imp_param_desc_;
-    delete app_row_desc_;
-    delete imp_row_desc_;
-    
-    // Remove from connection
-    if (conn_) {
-        auto it = std::find(conn_->statements_.begin(), conn_->statements_.end(), this);
-        if (it != conn_->statements_.end()) {
-            conn_->statements_.erase(it);
-        }
+    stmt->app_param_desc_ = descriptor_pool_.create(this, true);
+    stmt->imp_param_desc_ = descriptor_pool_.create(this, false);
+    stmt->app_row_desc_   = descriptor_pool_.create(this, true);
+    stmt->imp_row_desc_   = descriptor_pool_.create(this, false);
+    statements_.push_back(stmt);
+    return stmt;
+}
+
+void ConnectionHandle::free_statement(StatementHandle* stmt) {
+    std::unique_lock<std::mutex> lock(handles_mutex_, std::defer_lock);
+    if (thread_safe_) lock.lock();
+    statements_.remove(stmt);
+    release_statement(stmt);
+}
+
+// Caller holds handles_mutex_ and has unlinked the statement
+void ConnectionHandle::release_statement(StatementHandle* stmt) {
+    DescriptorHandle* descs[] = {stmt->app_param_desc_, stmt->imp_param_desc_,
+                                 stmt->app_row_desc_, stmt->imp_row_desc_};
+    statement_pool_.destroy(stmt);
+    for (auto* desc : descs) {
+        descriptor_pool_.destroy(desc);
     }
-    magic_ = 0;
 }
 
-// DescriptorHandle
-DescriptorHandle::DescriptorHandle(ConnectionHandle* conn, bool is_app_desc)
-    : OdbcHandle(HandleType::DESC), conn_(conn), is_app_desc_(is_app_desc) {
+DescriptorHandle* ConnectionHandle::allocate_descriptor() {
+    std::lock_guard<std::mutex> lock(handles_mutex_);
+    auto* desc = descriptor_pool_.create(this, true);
+    desc->alloc_type_ = SQL_DESC_ALLOC_USER;
+    descriptors_.push_back(desc);
+    return desc;
 }
 
-DescriptorHandle::~DescriptorHandle() {
-    magic_ = 0;
+void ConnectionHandle::free_descriptor(DescriptorHandle* desc) {
+    std::lock_guard<std::mutex> lock(handles_mutex_);
+    descriptors_.remove(desc);
+    descriptor_pool_.destroy(desc);
 }
 
-// Handle validation helpers
-EnvironmentHandle* validate_env_handle(SQLHENV handle) {
-    return validate_handle<EnvironmentHandle>(handle);
+void ConnectionHandle::open_transaction() {
+    std::lock_guard<std::mutex> lock(MockCatalog::instance().mutex());
+    if (!transaction_) transaction_ = std::make_unique<Transaction>();
 }
 
-ConnectionHandle* validate_dbc_handle(SQLHDBC handle) {
-    return validate_handle<ConnectionHandle>(handle);
+// StatementHandle
+StatementHandle::StatementHandle(ConnectionHandle* conn) 
+    : OdbcHandle(HandleType::STMT), conn_(conn) {
 }
 
-StatementHandle* validate_stmt_handle(SQLHSTMT handle) {
-    return validate_handle<StatementHandle>(handle);
+size_t StatementHandle::result_row_count() const {
+    return result_scan_ ? result_scan_->row_count() : result_data_.size();
+}
+
+const StatementHandle::ResultRow& StatementHandle::result_row(size_t row) {
+    if (!result_scan_) return result_data_[row];
+    if (scan_row_index_ != row) {
+        result_scan_->read_row(row, scan_columns_, scan_row_);
+        scan_row_index_ = row;
+    }
+    return scan_row_;
 }
 
-DescriptorHandle* validate_desc_handle(SQLHDESC handle) {
-    return validate_handle<DescriptorHandle>(handle);
+void StatementHandle::clear_result_rows() {
+    result_data_.clear();
+    result_scan_.reset();
+    scan_columns_.clear();
+    scan_row_index_ = SIZE_MAX;
+}
+
+// DescriptorHandle
+DescriptorHandle::DescriptorHandle(ConnectionHandle* conn, bool is_app_desc)
+    : OdbcHandle(HandleType::DESC), conn_(conn), is_app_desc_(is_app_desc) {
 }
 
 } // namespace mock_odbc
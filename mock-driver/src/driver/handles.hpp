@@ -1,17 +1,27 @@
 #pragma once
 
 #include "common.hpp"
+#include "config.hpp"
 #include "diagnostics.hpp"
+#include "handle_pool.hpp"
 #include <cstdint>
+#include <memory>
 #include <mutex>
+#include <type_traits>
+#include <utility>
 
 namespace mock_odbc {
 
+struct AsyncOperation;
+struct ParsedQuery;
+struct Transaction;
+class TableSnapshot;
+
 // Base class for all ODBC handles
 class OdbcHandle {
 public:
     explicit OdbcHandle(HandleType type);
-    virtual ~OdbcHandle() = default;
+    virtual ~OdbcHandle();
     
     // Prevent copying
     OdbcHandle(const OdbcHandle&) = delete;
@@ -21,12 +31,22 @@ public:
     bool is_valid() const { return magic_ == HANDLE_MAGIC; }
     HandleType type() const { return type_; }
     
-    // Diagnostics
-    void clear_diagnostics();
-    void add_diagnostic(const std::string& sqlstate, SQLINTEGER native_error, 
-                       const std::string& message);
+    // Diagnostics. Clearing and posting reuse the handle's buffers; see
+    // DiagnosticArea.
+    void clear_diagnostics() { diagnostics_.clear(); }
+    // Exchange the handle's records with `other` (async operations)
+    void swap_diagnostics(DiagnosticArea& other) { std::swap(diagnostics_, other); }
+    void add_diagnostic(std::string_view sqlstate, SQLINTEGER native_error,
+                        std::string_view message);
+    // Error for one set of an array of parameters (1-based); the record's
+    // SQL_DIAG_ROW_NUMBER is the set and the message is prefixed with it
+    void add_parameter_diagnostic(std::string_view sqlstate, SQLLEN param_set,
+                                  std::string_view message);
     size_t diagnostic_count() const { return diagnostics_.size(); }
     const DiagnosticRecord* get_diagnostic(SQLSMALLINT rec_number) const;
+    std::string_view diagnostic_message(const DiagnosticRecord& rec) const {
+        return diagnostics_.message(rec);
+    }
     
     // Header fields for all handles
     SQLINTEGER cursor_row_count_ = 0;
@@ -39,16 +59,26 @@ public:
     // Per-handle mutex for thread safety
     std::mutex& mutex() { return mutex_; }
     
+    // False with ThreadSafety=None: HandleLock leaves this handle unlocked.
+    // Set on connect and inherited by the connection's statements.
+    bool thread_safe_ = true;
+    
+    // Links in the parent's HandleList
+    OdbcHandle* sibling_prev_ = nullptr;
+    OdbcHandle* sibling_next_ = nullptr;
+    
 protected:
     uint32_t magic_;
     HandleType type_;
-    std::vector<DiagnosticRecord> diagnostics_;
+    DiagnosticArea diagnostics_;
     std::mutex mutex_;
 };
 
 // Environment Handle
 class EnvironmentHandle : public OdbcHandle {
 public:
+    static constexpr HandleType kHandleType = HandleType::ENV;
+    
     EnvironmentHandle();
     ~EnvironmentHandle() override;
     
@@ -59,12 +89,14 @@ public:
     SQLINTEGER output_nts_ = SQL_TRUE;
     
     // Allocated connections
-    std::vector<ConnectionHandle*> connections_;
+    HandleList<ConnectionHandle> connections_;
 };
 
 // Connection Handle
 class ConnectionHandle : public OdbcHandle {
 public:
+    static constexpr HandleType kHandleType = HandleType::DBC;
+    
     explicit ConnectionHandle(EnvironmentHandle* env);
     ~ConnectionHandle() override;
     
@@ -86,19 +118,47 @@ public:
     SQLUINTEGER txn_isolation_ = SQL_TXN_READ_COMMITTED;
     SQLUINTEGER current_catalog_ = 0;
     std::string current_catalog_name_;
+    SQLULEN metadata_id_ = SQL_FALSE;   // SQL_ATTR_METADATA_ID for statements allocated later
+    
+    // Statements and their implicit descriptors come from per-connection
+    // slab pools, so allocating and freeing them recycles memory instead
+    // of going to the heap. Safe to call from several threads at once
+    // unless ThreadSafety=None.
+    StatementHandle* allocate_statement();
+    void free_statement(StatementHandle* stmt);
+    DescriptorHandle* allocate_descriptor();         // SQLAllocHandle(SQL_HANDLE_DESC)
+    void free_descriptor(DescriptorHandle* desc);
+    
+    // Allocated statements and explicitly allocated descriptors; freed
+    // with the connection. Guarded by handles_mutex_ while it is in use.
+    HandleList<StatementHandle> statements_;
+    HandleList<DescriptorHandle> descriptors_;
     
-    // Allocated statements
-    std::vector<StatementHandle*> statements_;
+    // The transaction statements run in; nullptr in autocommit mode. It is
+    // created (under MockCatalog::mutex()) when a connection opens with
+    // autocommit off or turns it off, and released when autocommit is turned
+    // back on or the connection closes. Statements only read the pointer.
+    Transaction* transaction() { return transaction_.get(); }
+    void open_transaction();
+    std::unique_ptr<Transaction> transaction_;
     
 private:
+    void release_statement(StatementHandle* stmt);
+    
     EnvironmentHandle* env_;
+    std::mutex handles_mutex_;
+    HandlePool<StatementHandle> statement_pool_;
+    HandlePool<DescriptorHandle> descriptor_pool_;
 };
 
 // Statement Handle
 class StatementHandle : public OdbcHandle {
 public:
+    static constexpr HandleType kHandleType = HandleType::STMT;
+    
+    // Use ConnectionHandle::allocate_statement(), which also attaches the
+    // implicit descriptors
     explicit StatementHandle(ConnectionHandle* conn);
-    ~StatementHandle() override;
     
     ConnectionHandle* connection() const { return conn_; }
     
@@ -107,11 +167,15 @@ public:
     bool executed_ = false;
     bool cursor_open_ = false;
     std::string sql_;
+    // sql_ as parsed by SQLPrepare; SQLExecute starts from a copy instead
+    // of parsing the text again
+    std::shared_ptr<const ParsedQuery> prepared_query_;
     
     // Result set
     SQLSMALLINT num_result_cols_ = 0;
     SQLLEN row_count_ = 0;
     SQLLEN current_row_ = -1;
+    SQLLEN wire_rows_received_ = 0;  // Rows the simulated network has delivered
     
     // Attributes
     SQLULEN cursor_type_ = SQL_CURSOR_FORWARD_ONLY;
@@ -119,11 +183,24 @@ public:
     SQLULEN max_rows_ = 0;
     SQLULEN query_timeout_ = 0;
     SQLULEN row_array_size_ = 1;
+    SQLULEN row_bind_type_ = SQL_BIND_BY_COLUMN;     // SQL_ATTR_ROW_BIND_TYPE
+    SQLUSMALLINT* row_status_ptr_ = nullptr;         // SQL_ATTR_ROW_STATUS_PTR
     SQLULEN paramset_size_ = 1;
     SQLULEN async_enable_ = SQL_ASYNC_ENABLE_OFF;
+    
+    // Function currently executing asynchronously; cleared when the
+    // application calls it again and receives its final return code.
+    // Written with std::atomic_store so SQLCancel can copy it unlocked.
+    std::shared_ptr<AsyncOperation> async_op_;
+    
+    // Signalled by SQLCancel to cut a simulated latency wait short
+    CancelSignal cancel_signal_;
     SQLULEN noscan_ = SQL_NOSCAN_OFF;
     SQLULEN max_length_ = 0;
     SQLULEN retrieve_data_ = SQL_RD_ON;
+    // SQL_ATTR_METADATA_ID: catalog function arguments are identifiers,
+    // not search patterns
+    SQLULEN metadata_id_ = SQL_FALSE;
     
     // Array parameter attributes (ODBC Arrays of Parameter Values)
     SQLUSMALLINT* param_status_ptr_ = nullptr;       // SQL_ATTR_PARAM_STATUS_PTR
@@ -153,13 +230,54 @@ public:
         SQLLEN* str_len_or_ind;
     };
     std::unordered_map<SQLUSMALLINT, ParameterBinding> parameter_bindings_;
-    
+
+    // Data-at-execution parameters (SQL_DATA_AT_EXEC / SQL_LEN_DATA_AT_EXEC).
+    // Set while SQLExecute or SQLExecDirect has returned SQL_NEED_DATA and
+    // the application is sending values with SQLParamData/SQLPutData.
+    struct DataAtExecParam {
+        SQLUSMALLINT number = 0;
+        std::string data;          // Chunks from SQLPutData, reserved up front
+        bool is_null = false;
+        bool received = false;     // SQLPutData called for this parameter
+    };
+    struct DataAtExecState {
+        std::vector<DataAtExecParam> params;
+        int current = -1;          // Parameter being sent; -1 before the first SQLParamData
+    };
+    std::optional<DataAtExecState> data_at_exec_;
+
     // Mock result data (populated after execute)
-    std::vector<std::vector<std::variant<std::monostate, long long, double, std::string>>> result_data_;
+    using ResultRow = std::vector<std::variant<std::monostate, long long, double, std::string>>;
+    std::vector<ResultRow> result_data_;
+    
+    // Set instead of result_data_ when a SELECT reads a table in the data
+    // file: rows are decoded from the mapping as they are fetched.
+    // scan_columns_ lists the table columns returned (empty for all).
+    std::shared_ptr<const TableSnapshot> result_scan_;
+    std::vector<size_t> scan_columns_;
+    
+    // Access the result set whichever way it is held. result_row() is valid
+    // until the next call for a different row.
+    size_t result_row_count() const;
+    const ResultRow& result_row(size_t row);
+    void clear_result_rows();
     std::vector<std::string> column_names_;
     std::vector<SQLSMALLINT> column_types_;
-    
-    // Descriptors
+    std::string result_table_;   // Table the result set reads; target of SQLBulkOperations(SQL_ADD)
+
+    // Progress of SQLGetData through one column of the current row, so
+    // successive calls return successive pieces. Reset on every fetch.
+    struct GetDataProgress {
+        SQLUSMALLINT column = 0;     // 0 = no column read yet
+        SQLSMALLINT c_type = 0;
+        size_t offset = 0;           // Bytes of the stored value already returned
+        size_t remaining = 0;        // Target-type bytes still to return
+        SQLWCHAR pending_low = 0;    // Low surrogate owed after a split pair
+        bool done = false;           // Whole value returned; next call gets SQL_NO_DATA
+    };
+    GetDataProgress get_data_;
+
+    // Implicit descriptors, owned by the statement
     DescriptorHandle* app_param_desc_ = nullptr;
     DescriptorHandle* imp_param_desc_ = nullptr;
     DescriptorHandle* app_row_desc_ = nullptr;
@@ -167,13 +285,16 @@ public:
     
 private:
     ConnectionHandle* conn_;
+    ResultRow scan_row_;            // Row decoded from result_scan_
+    size_t scan_row_index_ = SIZE_MAX;
 };
 
 // Descriptor Handle
 class DescriptorHandle : public OdbcHandle {
 public:
+    static constexpr HandleType kHandleType = HandleType::DESC;
+    
     explicit DescriptorHandle(ConnectionHandle* conn, bool is_app_desc);
-    ~DescriptorHandle() override;
     
     ConnectionHandle* connection() const { return conn_; }
     bool is_app_descriptor() const { return is_app_desc_; }
@@ -214,10 +335,11 @@ private:
     bool is_app_desc_;
 };
 
-// RAII lock guard for any OdbcHandle
+// RAII lock guard for any OdbcHandle; a no-op for handles with
+// thread_safe_ off
 class HandleLock {
 public:
-    explicit HandleLock(OdbcHandle* h) : handle_(h) {
+    explicit HandleLock(OdbcHandle* h) : handle_(h && h->thread_safe_ ? h : nullptr) {
         if (handle_) handle_->mutex().lock();
     }
     ~HandleLock() {
@@ -229,34 +351,34 @@ private:
     OdbcHandle* handle_;
 };
 
-// Handle validation helpers
+// Handle validation helpers. Lock-free: a magic number and a type tag
+// compared against T's compile-time kHandleType. Freed pooled handles
+// fail the magic check.
 template<typename T>
-T* validate_handle(SQLHANDLE handle) {
+inline T* validate_handle(SQLHANDLE handle) {
+    static_assert(std::is_base_of<OdbcHandle, T>::value, "T must be an ODBC handle class");
     if (!handle) return nullptr;
     auto* h = static_cast<OdbcHandle*>(handle);
-    if (!h->is_valid()) return nullptr;
-    
-    // Use manual type checking instead of dynamic_cast to avoid DLL boundary issues
-    HandleType expected_type;
-    if (std::is_same<T, EnvironmentHandle>::value) {
-        expected_type = HandleType::ENV;
-    } else if (std::is_same<T, ConnectionHandle>::value) {
-        expected_type = HandleType::DBC;
-    } else if (std::is_same<T, StatementHandle>::value) {
-        expected_type = HandleType::STMT;
-    } else if (std::is_same<T, DescriptorHandle>::value) {
-        expected_type = HandleType::DESC;
-    } else {
-        return nullptr;
-    }
     
-    if (h->type() != expected_type) return nullptr;
+    // Manual type checking instead of dynamic_cast avoids DLL boundary issues
+    if (!h->is_valid() || h->type() != T::kHandleType) return nullptr;
     return static_cast<T*>(h);
 }
 
-EnvironmentHandle* validate_env_handle(SQLHENV handle);
-ConnectionHandle* validate_dbc_handle(SQLHDBC handle);
-StatementHandle* validate_stmt_handle(SQLHSTMT handle);
-DescriptorHandle* validate_desc_handle(SQLHDESC handle);
+inline EnvironmentHandle* validate_env_handle(SQLHENV handle) {
+    return validate_handle<EnvironmentHandle>(handle);
+}
+
+inline ConnectionHandle* validate_dbc_handle(SQLHDBC handle) {
+    return validate_handle<ConnectionHandle>(handle);
+}
+
+inline StatementHandle* validate_stmt_handle(SQLHSTMT handle) {
+    return validate_handle<StatementHandle>(handle);
+}
+
+inline DescriptorHandle* validate_desc_handle(SQLHDESC handle) {
+    return validate_handle<DescriptorHandle>(handle);
+}
 
 } // namespace mock_odbc
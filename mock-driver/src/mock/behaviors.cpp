@@ -1,7 +1,28 @@
 #include "behaviors.hpp"
+#include "../driver/handles.hpp"
+#include <algorithm>
 
 namespace mock_odbc {
 
+namespace {
+
+// Bytes a row occupies on the simulated wire
+size_t wire_size(const std::vector<std::variant<std::monostate, long long, double, std::string>>& row) {
+    size_t bytes = 0;
+    for (const auto& cell : row) {
+        if (std::holds_alternative<std::string>(cell)) {
+            bytes += 4 + std::get<std::string>(cell).size();  // Length prefix + data
+        } else if (std::holds_alternative<std::monostate>(cell)) {
+            bytes += 1;  // NULL marker
+        } else {
+            bytes += 8;
+        }
+    }
+    return bytes;
+}
+
+} // anonymous namespace
+
 BehaviorController& BehaviorController::instance() {
     static BehaviorController instance;
     return instance;
@@ -15,8 +36,48 @@ bool BehaviorController::should_fail(const std::string& function_name) const {
     return config_.should_fail(function_name);
 }
 
-void BehaviorController::apply_latency() const {
-    config_.apply_latency();
+bool BehaviorController::apply_latency(DriverFunction function, bool round_trip) const {
+    return config_.apply_latency(function, round_trip);
+}
+
+bool simulate_statement_latency(StatementHandle* stmt, DriverFunction function, bool round_trip) {
+    const auto& config = BehaviorController::instance().config();
+    // Most calls have no latency configured; skip the cancel signal's lock
+    const LatencyProfile* profile = config.latency_for(function, round_trip);
+    if (!profile || !profile->enabled()) return true;
+    
+    stmt->cancel_signal_.reset();
+    if (profile->wait(&stmt->cancel_signal_)) {
+        return true;
+    }
+    stmt->add_diagnostic(sqlstate::OPERATION_CANCELED, 0, "Operation canceled");
+    return false;
+}
+
+std::chrono::microseconds claim_fetch_transfer(StatementHandle* stmt, SQLLEN row) {
+    const auto& network = BehaviorController::instance().config().network;
+    SQLLEN total = static_cast<SQLLEN>(stmt->result_row_count());
+    if (!network.enabled() || !stmt->executed_ ||
+        row < stmt->wire_rows_received_ || row >= total) {
+        return std::chrono::microseconds(0);
+    }
+    
+    SQLLEN batch = std::max(network.fetch_batch_rows, static_cast<SQLLEN>(stmt->row_array_size_));
+    SQLLEN end = std::min(total, row + batch);
+    size_t bytes = 0;
+    for (SQLLEN i = row; i < end; ++i) {
+        bytes += wire_size(stmt->result_row(static_cast<size_t>(i)));
+    }
+    stmt->wire_rows_received_ = end;
+    return network.transfer_time(bytes);
+}
+
+bool simulate_network_delay(StatementHandle* stmt, std::chrono::microseconds delay) {
+    if (delay.count() <= 0) return true;
+    stmt->cancel_signal_.reset();
+    if (stmt->cancel_signal_.wait_for(delay)) return true;
+    stmt->add_diagnostic(sqlstate::OPERATION_CANCELED, 0, "Operation canceled");
+    return false;
 }
 
 } // namespace mock_odbc
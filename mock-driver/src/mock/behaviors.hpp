@@ -15,13 +15,28 @@ public:
     
     // Check if we should fail
     bool should_fail(const std::string& function_name) const;
+    bool should_fail(DriverFunction function) const { return config_.should_fail(function); }
     
-    // Apply configured latency
-    void apply_latency() const;
+    // Apply configured latency for a function
+    bool apply_latency(DriverFunction function, bool round_trip = true) const;
     
 private:
     BehaviorController() = default;
     DriverConfig config_;
 };
 
+// Wait out the latency configured for a statement function, interruptible
+// by SQLCancel. Posts HY008 and returns false when canceled.
+bool simulate_statement_latency(StatementHandle* stmt, DriverFunction function, bool round_trip);
+
+// Network time to deliver row `row` of the current result set. Rows arrive
+// in batches of max(FetchBatchRows, SQL_ATTR_ROW_ARRAY_SIZE), one round trip
+// each, sized by the bytes in the batch; rows already received are free.
+// Marks the batch as received.
+std::chrono::microseconds claim_fetch_transfer(StatementHandle* stmt, SQLLEN row);
+
+// Wait out a network delay on a statement, interruptible by SQLCancel.
+// Posts HY008 and returns false when canceled.
+bool simulate_network_delay(StatementHandle* stmt, std::chrono::microseconds delay);
+
 } // namespace mock_odbc
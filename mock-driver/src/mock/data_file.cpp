@@ -0,0 +1,678 @@
+#include "data_file.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <io.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace mock_odbc {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr char kMagic[8] = {'M', 'O', 'C', 'K', 'D', 'A', 'T', '1'};
+constexpr uint32_t kVersion = 1;
+constexpr uint64_t kHeaderSize = 16;
+constexpr uint64_t kRecordHeaderSize = 16;
+
+// Record kinds
+constexpr uint32_t kTableDef = 1;
+constexpr uint32_t kRowGroup = 2;
+constexpr uint32_t kDropTable = 3;
+constexpr uint32_t kDeleteRows = 4;
+
+// Cell type tags in a row group column
+constexpr unsigned char kNull = 0;
+constexpr unsigned char kInteger = 1;
+constexpr unsigned char kDouble = 2;
+constexpr unsigned char kString = 3;
+
+// Column flags in a table definition
+constexpr int16_t kColumnPrimaryKey = 1;
+
+uint64_t align8(uint64_t n) { return (n + 7) & ~uint64_t(7); }
+
+template<typename T>
+T read_at(const unsigned char* p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    return value;
+}
+
+template<typename T>
+void put(std::string& out, T value) {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template<typename T>
+void store(std::string& out, size_t pos, T value) {
+    std::memcpy(&out[pos], &value, sizeof(T));
+}
+
+void put_string(std::string& out, const std::string& s) {
+    put<uint32_t>(out, static_cast<uint32_t>(s.size()));
+    out.append(s);
+}
+
+void pad8(std::string& out) {
+    out.resize(align8(out.size()), '\0');
+}
+
+// Bounds-checked reader over one record payload
+class PayloadReader {
+public:
+    PayloadReader(const unsigned char* data, uint64_t size) : data_(data), size_(size) {}
+
+    template<typename T>
+    bool read(T& value) {
+        if (size_ - pos_ < sizeof(T)) return false;
+        value = read_at<T>(data_ + pos_);
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    bool read_string(std::string& s) {
+        uint32_t length = 0;
+        if (!read(length) || size_ - pos_ < length) return false;
+        s.assign(reinterpret_cast<const char*>(data_ + pos_), length);
+        pos_ += length;
+        return true;
+    }
+
+    bool align() {
+        uint64_t next = align8(pos_);
+        if (next > size_) return false;
+        pos_ = next;
+        return true;
+    }
+
+private:
+    const unsigned char* data_;
+    uint64_t size_;
+    uint64_t pos_ = 0;
+};
+
+// Decode one cell of a row group. `payload` points at the record payload,
+// `index` is the row within the group.
+CellValue decode_cell(const unsigned char* payload, size_t column, uint64_t index, uint64_t rows) {
+    const unsigned char* segment = payload + read_at<uint64_t>(payload + 16 + 8 * column);
+    const unsigned char* slots = segment + align8(rows);
+    switch (segment[index]) {
+        case kInteger:
+            return static_cast<long long>(read_at<int64_t>(slots + 8 * index));
+        case kDouble:
+            return read_at<double>(slots + 8 * index);
+        case kString: {
+            const unsigned char* heap = slots + 8 * rows;
+            uint64_t heap_size = read_at<uint64_t>(heap);
+            uint64_t offset = read_at<uint64_t>(slots + 8 * index);
+            if (offset > heap_size || heap_size - offset < 8) return std::monostate{};
+            uint64_t length = read_at<uint64_t>(heap + 8 + offset);
+            if (length > heap_size - offset - 8) return std::monostate{};
+            return std::string(reinterpret_cast<const char*>(heap + 16 + offset),
+                               static_cast<size_t>(length));
+        }
+        default:
+            return std::monostate{};
+    }
+}
+
+// True when `payload` holds a well-formed row group for a table with
+// `column_count` columns; sets `rows` to its row count
+bool valid_row_group(const unsigned char* payload, uint64_t payload_size, size_t column_count,
+                     uint64_t& rows) {
+    if (payload_size < 16 || read_at<uint32_t>(payload + 4) != column_count) return false;
+    rows = read_at<uint64_t>(payload + 8);
+    if (rows > payload_size || 16 + 8 * uint64_t(column_count) > payload_size) return false;
+    // Every column segment must fit: tags, slots, heap size and heap
+    for (size_t c = 0; c < column_count; ++c) {
+        uint64_t segment = read_at<uint64_t>(payload + 16 + 8 * c);
+        uint64_t fixed = align8(rows) + 8 * rows + 8;
+        if (segment > payload_size || payload_size - segment < fixed) return false;
+        uint64_t heap_size = read_at<uint64_t>(payload + segment + fixed - 8);
+        if (heap_size > payload_size - segment - fixed) return false;
+    }
+    return true;
+}
+
+// Payload of a row group record for `rows` of a table with `column_count` columns
+std::string encode_row_group(uint32_t table_id, size_t column_count, const std::vector<MockRow>& rows) {
+    const uint64_t row_count = rows.size();
+    std::string out;
+    put<uint32_t>(out, table_id);
+    put<uint32_t>(out, static_cast<uint32_t>(column_count));
+    put<uint64_t>(out, row_count);
+    size_t offsets_pos = out.size();
+    out.resize(out.size() + 8 * column_count, '\0');
+
+    std::string heap;
+    for (size_t c = 0; c < column_count; ++c) {
+        store<uint64_t>(out, offsets_pos + 8 * c, out.size());
+
+        size_t tags_pos = out.size();
+        out.resize(tags_pos + align8(row_count), '\0');
+        size_t slots_pos = out.size();
+        out.resize(slots_pos + 8 * row_count, '\0');
+        heap.clear();
+
+        for (size_t r = 0; r < row_count; ++r) {
+            if (c >= rows[r].size()) continue;  // Missing trailing cells are NULL
+            const CellValue& cell = rows[r][c];
+            unsigned char tag = kNull;
+            if (std::holds_alternative<long long>(cell)) {
+                tag = kInteger;
+                store<int64_t>(out, slots_pos + 8 * r, std::get<long long>(cell));
+            } else if (std::holds_alternative<double>(cell)) {
+                tag = kDouble;
+                store<double>(out, slots_pos + 8 * r, std::get<double>(cell));
+            } else if (std::holds_alternative<std::string>(cell)) {
+                tag = kString;
+                const auto& s = std::get<std::string>(cell);
+                store<uint64_t>(out, slots_pos + 8 * r, heap.size());
+                put<uint64_t>(heap, s.size());
+                heap.append(s);
+            }
+            out[tags_pos + r] = static_cast<char>(tag);
+        }
+
+        put<uint64_t>(out, heap.size());
+        out.append(heap);
+        pad8(out);
+    }
+    return out;
+}
+
+} // anonymous namespace
+
+// ── FileMapping ──────────────────────────────────────────────────────────────
+
+std::shared_ptr<const FileMapping> FileMapping::map(std::FILE* file, uint64_t size,
+                                                    std::string& error) {
+    std::shared_ptr<FileMapping> mapping(new FileMapping());
+    if (size == 0) return mapping;
+#ifdef _WIN32
+    HANDLE fh = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file)));
+    HANDLE mh = CreateFileMappingW(fh, nullptr, PAGE_READONLY,
+                                   static_cast<DWORD>(size >> 32),
+                                   static_cast<DWORD>(size & 0xFFFFFFFFu), nullptr);
+    if (!mh) {
+        error = "CreateFileMapping failed with error " + std::to_string(GetLastError());
+        return nullptr;
+    }
+    void* view = MapViewOfFile(mh, FILE_MAP_READ, 0, 0, static_cast<SIZE_T>(size));
+    if (!view) {
+        error = "MapViewOfFile failed with error " + std::to_string(GetLastError());
+        CloseHandle(mh);
+        return nullptr;
+    }
+    mapping->mapping_handle_ = mh;
+#else
+    void* view = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fileno(file), 0);
+    if (view == MAP_FAILED) {
+        error = std::string("mmap failed: ") + std::strerror(errno);
+        return nullptr;
+    }
+#endif
+    mapping->data_ = static_cast<const unsigned char*>(view);
+    mapping->size_ = size;
+    return mapping;
+}
+
+FileMapping::~FileMapping() {
+    if (!data_) return;
+#ifdef _WIN32
+    UnmapViewOfFile(data_);
+    CloseHandle(mapping_handle_);
+#else
+    munmap(const_cast<unsigned char*>(data_), static_cast<size_t>(size_));
+#endif
+}
+
+// ── TableSnapshot ────────────────────────────────────────────────────────────
+
+const TableSnapshot::RowGroup& TableSnapshot::group_for(size_t row) const {
+    auto begin = groups_->begin();
+    auto end = begin + static_cast<std::ptrdiff_t>(group_count_);
+    auto it = std::upper_bound(begin, end, static_cast<uint64_t>(row),
+                               [](uint64_t r, const RowGroup& g) { return r < g.first_row; });
+    return *(it - 1);
+}
+
+CellValue TableSnapshot::cell(size_t row, size_t column) const {
+    if (row >= row_count_ || column >= column_count_) return std::monostate{};
+    uint64_t physical = physical_row(row);
+    const RowGroup& group = group_for(physical);
+    return decode_cell(mapping_->data() + group.offset, column,
+                       physical - group.first_row, group.rows);
+}
+
+void TableSnapshot::read_row(size_t row, const std::vector<size_t>& columns, MockRow& out) const {
+    size_t width = columns.empty() ? column_count_ : columns.size();
+    out.resize(width);
+    if (row >= row_count_) {
+        std::fill(out.begin(), out.end(), CellValue{});
+        return;
+    }
+    uint64_t physical = physical_row(row);
+    const RowGroup& group = group_for(physical);
+    const unsigned char* payload = mapping_->data() + group.offset;
+    uint64_t index = physical - group.first_row;
+    for (size_t i = 0; i < width; ++i) {
+        size_t column = columns.empty() ? i : columns[i];
+        out[i] = column < column_count_ ? decode_cell(payload, column, index, group.rows)
+                                        : CellValue{};
+    }
+}
+
+bool TableSnapshot::find_row(uint64_t physical, size_t& row) const {
+    if (!live_rows_) {
+        if (physical >= row_count_) return false;
+        row = static_cast<size_t>(physical);
+        return true;
+    }
+    auto end = live_rows_->begin() + static_cast<std::ptrdiff_t>(row_count_);
+    auto it = std::lower_bound(live_rows_->begin(), end, physical);
+    if (it == end || *it != physical) return false;
+    row = static_cast<size_t>(it - live_rows_->begin());
+    return true;
+}
+
+std::vector<MockRow> TableSnapshot::materialize(const std::vector<size_t>& columns) const {
+    std::vector<MockRow> rows;
+    rows.reserve(row_count_);
+    if (live_rows_) {
+        rows.resize(row_count_);
+        for (size_t r = 0; r < row_count_; ++r) read_row(r, columns, rows[r]);
+        return rows;
+    }
+    size_t width = columns.empty() ? column_count_ : columns.size();
+    for (size_t g = 0; g < group_count_; ++g) {
+        const RowGroup& group = (*groups_)[g];
+        const unsigned char* payload = mapping_->data() + group.offset;
+        for (uint64_t index = 0; index < group.rows; ++index) {
+            MockRow row(width);
+            for (size_t i = 0; i < width; ++i) {
+                size_t column = columns.empty() ? i : columns[i];
+                if (column < column_count_) {
+                    row[i] = decode_cell(payload, column, index, group.rows);
+                }
+            }
+            rows.push_back(std::move(row));
+        }
+    }
+    return rows;
+}
+
+// ── DataFile ─────────────────────────────────────────────────────────────────
+
+std::shared_ptr<DataFile> DataFile::open(const std::string& path, std::string& error) {
+    std::shared_ptr<DataFile> file(new DataFile());
+    file->path_ = path;
+    if (!file->load(error)) return nullptr;
+    return file;
+}
+
+DataFile::~DataFile() {
+    mapping_.reset();
+    if (file_) std::fclose(file_);
+}
+
+bool DataFile::load(std::string& error) {
+    std::error_code ec;
+    uint64_t file_size = fs::exists(path_, ec) ? fs::file_size(path_, ec) : 0;
+    if (ec) {
+        error = "Cannot read data file " + path_ + ": " + ec.message();
+        return false;
+    }
+
+    // Append mode: every write lands at the end of the file
+    file_ = std::fopen(path_.c_str(), "a+b");
+    if (!file_) {
+        error = "Cannot open data file " + path_ + ": " + std::strerror(errno);
+        return false;
+    }
+
+    if (file_size == 0) {
+        std::string header(kMagic, sizeof(kMagic));
+        put<uint32_t>(header, kVersion);
+        put<uint32_t>(header, 0);
+        if (std::fwrite(header.data(), 1, header.size(), file_) != header.size() ||
+            std::fflush(file_) != 0) {
+            error = "Cannot write data file " + path_ + ": " + std::strerror(errno);
+            return false;
+        }
+        size_ = kHeaderSize;
+        return true;
+    }
+
+    mapping_ = FileMapping::map(file_, file_size, error);
+    if (!mapping_) {
+        error = "Cannot map data file " + path_ + ": " + error;
+        return false;
+    }
+    const unsigned char* data = mapping_->data();
+    if (file_size < kHeaderSize || std::memcmp(data, kMagic, sizeof(kMagic)) != 0) {
+        error = "Not a mock driver data file: " + path_;
+        return false;
+    }
+    if (read_at<uint32_t>(data + 8) != kVersion) {
+        error = "Unsupported data file version in " + path_;
+        return false;
+    }
+
+    uint64_t pos = kHeaderSize;
+    while (file_size - pos >= kRecordHeaderSize) {
+        uint32_t kind = read_at<uint32_t>(data + pos);
+        uint64_t payload_size = read_at<uint64_t>(data + pos + 8);
+        if (payload_size > file_size - pos - kRecordHeaderSize) break;
+        if (!apply_record(kind, pos + kRecordHeaderSize, payload_size)) break;
+        pos = std::min(file_size, pos + kRecordHeaderSize + align8(payload_size));
+    }
+    size_ = pos;
+
+    // Drop a record cut short by a crash so new records follow valid data
+    if (size_ < file_size) {
+        mapping_.reset();
+        std::fclose(file_);
+        fs::resize_file(path_, size_, ec);
+        file_ = std::fopen(path_.c_str(), "a+b");
+        if (ec || !file_) {
+            error = "Cannot truncate data file " + path_;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool DataFile::apply_record(uint32_t kind, uint64_t payload_offset, uint64_t payload_size) {
+    const unsigned char* payload = mapping_->data() + payload_offset;
+    PayloadReader reader(payload, payload_size);
+
+    switch (kind) {
+        case kTableDef: {
+            uint32_t id = 0;
+            uint32_t column_count = 0;
+            TableEntry entry;
+            MockTable& table = entry.definition;
+            if (!reader.read(id) || id != tables_.size() || !reader.read(column_count) ||
+                !reader.read_string(table.name) || !reader.align()) {
+                return false;
+            }
+            table.type = "TABLE";
+            table.remarks = "User-created table";
+            for (uint32_t c = 0; c < column_count; ++c) {
+                MockColumn col{};
+                int16_t data_type = 0, decimal_digits = 0, nullable = 0, flags = 0;
+                uint64_t column_size = 0;
+                if (!reader.read(data_type) || !reader.read(decimal_digits) ||
+                    !reader.read(nullable) || !reader.read(flags) ||
+                    !reader.read(column_size) || !reader.read_string(col.name) ||
+                    !reader.align()) {
+                    return false;
+                }
+                col.data_type = data_type;
+                col.decimal_digits = decimal_digits;
+                col.nullable = nullable;
+                col.is_primary_key = (flags & kColumnPrimaryKey) != 0;
+                col.column_size = static_cast<SQLULEN>(column_size);
+                table.columns.push_back(std::move(col));
+            }
+            entry.groups = std::make_shared<std::vector<TableSnapshot::RowGroup>>();
+            live_[table.name] = id;
+            tables_.push_back(std::move(entry));
+            return true;
+        }
+
+        case kRowGroup: {
+            uint32_t id = 0;
+            uint64_t rows = 0;
+            if (!reader.read(id) || id >= tables_.size() || !tables_[id].groups ||
+                !valid_row_group(payload, payload_size, tables_[id].definition.columns.size(), rows)) {
+                return false;
+            }
+            add_group(tables_[id], payload_offset, rows);
+            return true;
+        }
+
+        case kDeleteRows: {
+            uint32_t id = 0, reserved = 0;
+            uint64_t count = 0;
+            if (!reader.read(id) || id >= tables_.size() || !tables_[id].groups ||
+                !reader.read(reserved) || !reader.read(count) || count > payload_size / 8) {
+                return false;
+            }
+            TableEntry& entry = tables_[id];
+            std::vector<uint64_t> physical(static_cast<size_t>(count));
+            for (auto& row : physical) {
+                if (!reader.read(row) || row >= entry.row_count) return false;
+            }
+            // Replacement rows follow the list as an embedded row group
+            uint64_t group_offset = 16 + 8 * count;
+            uint64_t rows = 0;
+            bool replaced = group_offset < payload_size;
+            if (replaced && !valid_row_group(payload + group_offset, payload_size - group_offset,
+                                             entry.definition.columns.size(), rows)) {
+                return false;
+            }
+            remove_rows(entry, physical);
+            if (replaced) add_group(entry, payload_offset + group_offset, rows);
+            return true;
+        }
+
+        case kDropTable: {
+            uint32_t id = 0;
+            if (!reader.read(id) || id >= tables_.size() || !tables_[id].groups) return false;
+            live_.erase(tables_[id].definition.name);
+            tables_[id].groups.reset();
+            tables_[id].live_rows.reset();
+            tables_[id].row_count = 0;
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+bool DataFile::append_record(uint32_t kind, const std::string& payload) {
+    if (write_failed_) return false;
+    std::string header;
+    put<uint32_t>(header, kind);
+    put<uint32_t>(header, 0);
+    put<uint64_t>(header, payload.size());
+    std::string padding(align8(payload.size()) - payload.size(), '\0');
+
+    bool ok = std::fwrite(header.data(), 1, header.size(), file_) == header.size() &&
+              std::fwrite(payload.data(), 1, payload.size(), file_) == payload.size() &&
+              std::fwrite(padding.data(), 1, padding.size(), file_) == padding.size() &&
+              std::fflush(file_) == 0;
+    if (!ok) {
+        // Offsets past this point are unknown; reopening truncates the tail
+        write_failed_ = true;
+        return false;
+    }
+    size_ += header.size() + payload.size() + padding.size();
+    return true;
+}
+
+bool DataFile::matches_disk() const {
+    std::error_code ec;
+    uint64_t size = fs::file_size(path_, ec);
+    return !ec && size == size_;
+}
+
+std::vector<MockTable> DataFile::tables() const {
+    std::vector<MockTable> result;
+    for (const auto& entry : tables_) {
+        if (entry.groups) result.push_back(entry.definition);
+    }
+    return result;
+}
+
+std::vector<std::string> DataFile::table_names() const {
+    std::vector<std::string> names;
+    names.reserve(live_.size());
+    for (const auto& entry : live_) names.push_back(entry.first);
+    return names;
+}
+
+bool DataFile::has_table(const std::string& upper_name) const {
+    return live_.count(upper_name) > 0;
+}
+
+bool DataFile::create_table(const MockTable& table) {
+    uint32_t id = static_cast<uint32_t>(tables_.size());
+    std::string payload;
+    put<uint32_t>(payload, id);
+    put<uint32_t>(payload, static_cast<uint32_t>(table.columns.size()));
+    put_string(payload, table.name);
+    pad8(payload);
+    for (const auto& col : table.columns) {
+        put<int16_t>(payload, col.data_type);
+        put<int16_t>(payload, col.decimal_digits);
+        put<int16_t>(payload, col.nullable);
+        put<int16_t>(payload, col.is_primary_key ? kColumnPrimaryKey : 0);
+        put<uint64_t>(payload, col.column_size);
+        put_string(payload, col.name);
+        pad8(payload);
+    }
+    if (!append_record(kTableDef, payload)) return false;
+
+    TableEntry entry;
+    entry.definition = table;
+    entry.groups = std::make_shared<std::vector<TableSnapshot::RowGroup>>();
+    live_[table.name] = id;
+    tables_.push_back(std::move(entry));
+    return true;
+}
+
+bool DataFile::drop_table(const std::string& upper_name) {
+    auto it = live_.find(upper_name);
+    if (it == live_.end()) return false;
+    std::string payload;
+    put<uint32_t>(payload, it->second);
+    put<uint32_t>(payload, 0);
+    if (!append_record(kDropTable, payload)) return false;
+
+    tables_[it->second].groups.reset();
+    tables_[it->second].live_rows.reset();
+    tables_[it->second].row_count = 0;
+    live_.erase(it);
+    return true;
+}
+
+bool DataFile::append_rows(const std::string& upper_name, const std::vector<MockRow>& rows) {
+    auto it = live_.find(upper_name);
+    if (it == live_.end()) return false;
+    if (rows.empty()) return true;
+    TableEntry& entry = tables_[it->second];
+
+    uint64_t payload_offset = size_ + kRecordHeaderSize;
+    if (!append_record(kRowGroup, encode_row_group(it->second, entry.definition.columns.size(), rows))) {
+        return false;
+    }
+
+    add_group(entry, payload_offset, rows.size());
+    return true;
+}
+
+bool DataFile::delete_rows(const std::string& upper_name, const std::vector<uint32_t>& rows,
+                           const std::vector<MockRow>& replacements) {
+    auto it = live_.find(upper_name);
+    if (it == live_.end()) return false;
+    if (rows.empty() && replacements.empty()) return true;
+    TableEntry& entry = tables_[it->second];
+
+    // The record names rows by their position among all rows appended
+    std::vector<uint64_t> physical;
+    physical.reserve(rows.size());
+    for (uint32_t row : rows) {
+        physical.push_back(entry.live_rows ? (*entry.live_rows)[row] : row);
+    }
+
+    std::string payload;
+    put<uint32_t>(payload, it->second);
+    put<uint32_t>(payload, 0);
+    put<uint64_t>(payload, physical.size());
+    for (uint64_t row : physical) put<uint64_t>(payload, row);
+    uint64_t group_offset = payload.size();
+    if (!replacements.empty()) {
+        payload += encode_row_group(it->second, entry.definition.columns.size(), replacements);
+    }
+    uint64_t payload_offset = size_ + kRecordHeaderSize;
+    if (!append_record(kDeleteRows, payload)) return false;
+
+    remove_rows(entry, physical);
+    if (!replacements.empty()) add_group(entry, payload_offset + group_offset, replacements.size());
+    return true;
+}
+
+void DataFile::add_group(TableEntry& entry, uint64_t payload_offset, uint64_t rows) {
+    // Snapshots share the group and row lists; copy them rather than grow
+    // them under a reader
+    if (entry.groups.use_count() > 1) {
+        entry.groups = std::make_shared<std::vector<TableSnapshot::RowGroup>>(*entry.groups);
+    }
+    entry.groups->push_back({payload_offset, entry.row_count, rows});
+    if (entry.live_rows) {
+        if (entry.live_rows.use_count() > 1) {
+            entry.live_rows = std::make_shared<std::vector<uint64_t>>(*entry.live_rows);
+        }
+        for (uint64_t r = 0; r < rows; ++r) entry.live_rows->push_back(entry.row_count + r);
+    }
+    entry.row_count += rows;
+}
+
+void DataFile::remove_rows(TableEntry& entry, const std::vector<uint64_t>& physical) {
+    if (physical.empty()) return;
+    std::vector<uint64_t> live;
+    if (entry.live_rows) {
+        live = *entry.live_rows;
+    } else {
+        live.resize(static_cast<size_t>(entry.row_count));
+        for (size_t r = 0; r < live.size(); ++r) live[r] = r;
+    }
+    // Both lists ascend, so one merge pass drops the deleted rows
+    size_t out = 0;
+    auto next = physical.begin();
+    for (uint64_t row : live) {
+        while (next != physical.end() && *next < row) ++next;
+        if (next != physical.end() && *next == row) continue;
+        live[out++] = row;
+    }
+    live.resize(out);
+    entry.live_rows = std::make_shared<std::vector<uint64_t>>(std::move(live));
+}
+
+std::shared_ptr<const TableSnapshot> DataFile::snapshot(const std::string& upper_name) {
+    auto it = live_.find(upper_name);
+    if (it == live_.end()) return nullptr;
+
+    // Appends went through stdio; map again to see them
+    if (!mapping_ || mapping_->size() < size_) {
+        std::string error;
+        auto mapping = FileMapping::map(file_, size_, error);
+        if (!mapping) return nullptr;
+        mapping_ = std::move(mapping);
+    }
+
+    const TableEntry& entry = tables_[it->second];
+    auto snapshot = std::make_shared<TableSnapshot>();
+    snapshot->mapping_ = mapping_;
+    snapshot->groups_ = entry.groups;
+    snapshot->live_rows_ = entry.live_rows;
+    snapshot->group_count_ = entry.groups->size();
+    snapshot->row_count_ = entry.live_rows ? entry.live_rows->size()
+                                           : static_cast<size_t>(entry.row_count);
+    snapshot->column_count_ = entry.definition.columns.size();
+    return snapshot;
+}
+
+} // namespace mock_odbc
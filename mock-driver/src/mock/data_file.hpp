@@ -0,0 +1,149 @@
+#pragma once
+
+#include "mock_catalog.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mock_odbc {
+
+// Read-only mapping of a data file. Snapshots hold it by shared_ptr, so
+// remapping after an append never unmaps pages a statement still reads.
+class FileMapping {
+public:
+    static std::shared_ptr<const FileMapping> map(std::FILE* file, uint64_t size,
+                                                  std::string& error);
+    ~FileMapping();
+
+    FileMapping(const FileMapping&) = delete;
+    FileMapping& operator=(const FileMapping&) = delete;
+
+    const unsigned char* data() const { return data_; }
+    uint64_t size() const { return size_; }
+
+private:
+    FileMapping() = default;
+
+    const unsigned char* data_ = nullptr;
+    uint64_t size_ = 0;
+#ifdef _WIN32
+    void* mapping_handle_ = nullptr;
+#endif
+};
+
+// Rows of one file-backed table as they were when the snapshot was taken.
+// Cells are decoded straight from the mapping; nothing is copied up front.
+class TableSnapshot {
+public:
+    size_t row_count() const { return row_count_; }
+    size_t column_count() const { return column_count_; }
+
+    CellValue cell(size_t row, size_t column) const;
+
+    // Decode `columns` of a row into `out` (all columns when empty)
+    void read_row(size_t row, const std::vector<size_t>& columns, MockRow& out) const;
+
+    // Decode every row, for queries that filter or sort
+    std::vector<MockRow> materialize(const std::vector<size_t>& columns = {}) const;
+
+    // Position of a table row among all rows ever appended to the table.
+    // A row keeps it until deleted (an UPDATE deletes and appends), so
+    // transactions use it to identify the row.
+    uint64_t physical_row(size_t row) const { return live_rows_ ? (*live_rows_)[row] : row; }
+
+    // Row number of physical row `physical`; false when it was deleted
+    bool find_row(uint64_t physical, size_t& row) const;
+
+private:
+    friend class DataFile;
+
+    struct RowGroup {
+        uint64_t offset;      // Record payload in the file
+        uint64_t first_row;   // Table row of the group's first row
+        uint64_t rows;
+    };
+
+    const RowGroup& group_for(size_t row) const;
+
+    std::shared_ptr<const FileMapping> mapping_;
+    std::shared_ptr<const std::vector<RowGroup>> groups_;
+    std::shared_ptr<const std::vector<uint64_t>> live_rows_;   // Null when no row was deleted
+    size_t group_count_ = 0;
+    size_t row_count_ = 0;
+    size_t column_count_ = 0;
+};
+
+// Tables kept in a file named by the DataFile= connection-string key.
+//
+// The file is an append-only log in host byte order: a 16-byte header
+// ("MOCKDAT1", version) followed by 8-byte aligned records, each a
+// { uint32 kind, uint32 reserved, uint64 payload size } header and a
+// payload. Records define a table, append a group of rows, delete rows
+// or drop a table. A delete record lists the positions of the deleted rows
+// among all rows ever appended and may carry a row group of replacements,
+// so an UPDATE is one record. A row group is columnar: per column, a one-byte type tag for
+// every row, then an 8-byte slot for every row (integer, double bits or
+// offset into a string heap), then the heap. Opening the file scans the
+// record headers only; a truncated trailing record is discarded.
+class DataFile {
+public:
+    static std::shared_ptr<DataFile> open(const std::string& path, std::string& error);
+    ~DataFile();
+
+    DataFile(const DataFile&) = delete;
+    DataFile& operator=(const DataFile&) = delete;
+
+    const std::string& path() const { return path_; }
+
+    // False when the file was removed or changed size since this instance
+    // last wrote it, meaning another writer touched it and it must be reopened
+    bool matches_disk() const;
+
+    // Tables currently defined in the file
+    std::vector<MockTable> tables() const;
+    std::vector<std::string> table_names() const;   // Upper-case
+    bool has_table(const std::string& upper_name) const;
+
+    // Each call appends one record and flushes it; false on a write error
+    bool create_table(const MockTable& table);
+    bool drop_table(const std::string& upper_name);
+    bool append_rows(const std::string& upper_name, const std::vector<MockRow>& rows);
+
+    // Delete `rows` (ascending row numbers of a current snapshot) and append
+    // `replacements` after the remaining rows, in one record
+    bool delete_rows(const std::string& upper_name, const std::vector<uint32_t>& rows,
+                     const std::vector<MockRow>& replacements = {});
+
+    // nullptr when the table is not in the file
+    std::shared_ptr<const TableSnapshot> snapshot(const std::string& upper_name);
+
+private:
+    DataFile() = default;
+
+    struct TableEntry {
+        MockTable definition;
+        std::shared_ptr<std::vector<TableSnapshot::RowGroup>> groups;
+        uint64_t row_count = 0;                            // Rows appended, deleted ones included
+        std::shared_ptr<std::vector<uint64_t>> live_rows;  // Rows not deleted; null until one is
+    };
+
+    static void add_group(TableEntry& entry, uint64_t payload_offset, uint64_t rows);
+    static void remove_rows(TableEntry& entry, const std::vector<uint64_t>& physical);
+
+    bool load(std::string& error);
+    bool append_record(uint32_t kind, const std::string& payload);
+    bool apply_record(uint32_t kind, uint64_t payload_offset, uint64_t payload_size);
+
+    std::string path_;
+    std::FILE* file_ = nullptr;
+    uint64_t size_ = 0;                                 // End of the last valid record
+    std::shared_ptr<const FileMapping> mapping_;
+    std::vector<TableEntry> tables_;                    // Indexed by table id, dropped ones included
+    std::unordered_map<std::string, uint32_t> live_;    // Upper-case name -> table id
+    bool write_failed_ = false;                         // File may end in a partial record
+};
+
+} // namespace mock_odbc
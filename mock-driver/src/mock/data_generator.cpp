@@ -0,0 +1,578 @@
+#include "data_generator.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+namespace mock_odbc {
+
+namespace {
+
+std::string to_upper(const std::string& s) {
+    std::string result = s;
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return std::toupper(c); });
+    return result;
+}
+
+std::string to_lower(const std::string& s) {
+    std::string result = s;
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    return result;
+}
+
+// SplitMix64 finalizer
+uint64_t mix64(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xBF58476D1CE4E5B9ULL;
+    x ^= x >> 27;
+    x *= 0x94D049BB133111EBULL;
+    x ^= x >> 31;
+    return x;
+}
+
+// FNV-1a; std::hash is not stable across platforms
+uint64_t hash_name(const std::string& s) {
+    uint64_t h = 0xCBF29CE484222325ULL;
+    for (unsigned char c : s) {
+        h ^= c;
+        h *= 0x100000001B3ULL;
+    }
+    return h;
+}
+
+// Counter-based random stream for one cell: the same seed and row always
+// give the same numbers, whichever thread asks
+class CellRandom {
+public:
+    CellRandom(uint64_t seed, uint64_t row) : state_(mix64(seed ^ mix64(row + 1))) {}
+
+    uint64_t next() {
+        state_ += 0x9E3779B97F4A7C15ULL;
+        return mix64(state_);
+    }
+
+    // Uniform in [0, 1)
+    double uniform() { return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0); }
+
+    uint64_t below(uint64_t n) { return n ? next() % n : 0; }
+
+    // Standard normal (Box-Muller)
+    double gaussian() {
+        double u1 = 1.0 - uniform();
+        double u2 = uniform();
+        return std::sqrt(-2.0 * std::log(u1)) * std::cos(6.283185307179586 * u2);
+    }
+
+private:
+    uint64_t state_;
+};
+
+// Zipf ranks in [1, n] by rejection-inversion (Hoermann and Derflinger),
+// constant expected time with no table of probabilities
+class ZipfSampler {
+public:
+    ZipfSampler() = default;
+    ZipfSampler(uint64_t n, double skew) : n_(std::max<uint64_t>(n, 1)), s_(skew) {
+        h_integral_x1_ = h_integral(1.5) - 1.0;
+        h_integral_n_ = h_integral(static_cast<double>(n_) + 0.5);
+        threshold_ = 2.0 - h_integral_inverse(h_integral(2.5) - h(2.0));
+    }
+
+    uint64_t sample(CellRandom& rng) const {
+        if (n_ == 1) return 1;
+        for (;;) {
+            double u = h_integral_n_ + rng.uniform() * (h_integral_x1_ - h_integral_n_);
+            double x = h_integral_inverse(u);
+            double k = std::floor(x + 0.5);
+            if (k < 1.0) k = 1.0;
+            else if (k > static_cast<double>(n_)) k = static_cast<double>(n_);
+            if (k - x <= threshold_ || u >= h_integral(k + 0.5) - h(k)) {
+                return static_cast<uint64_t>(k);
+            }
+        }
+    }
+
+private:
+    static double helper1(double x) {  // log1p(x) / x
+        return std::abs(x) > 1e-8 ? std::log1p(x) / x : 1.0 - x * (0.5 - x * (1.0 / 3.0 - 0.25 * x));
+    }
+    static double helper2(double x) {  // expm1(x) / x
+        return std::abs(x) > 1e-8 ? std::expm1(x) / x : 1.0 + x * 0.5 * (1.0 + x / 3.0 * (1.0 + 0.25 * x));
+    }
+    double h(double x) const { return std::exp(-s_ * std::log(x)); }
+    double h_integral(double x) const {
+        double log_x = std::log(x);
+        return helper2((1.0 - s_) * log_x) * log_x;
+    }
+    double h_integral_inverse(double x) const {
+        double t = std::max(x * (1.0 - s_), -1.0);
+        return std::exp(helper1(t) * x);
+    }
+
+    uint64_t n_ = 1;
+    double s_ = 1.0;
+    double h_integral_x1_ = 0;
+    double h_integral_n_ = 0;
+    double threshold_ = 0;
+};
+
+// Characters for generated strings
+const char kAlphanumeric[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789";
+
+// Code point ranges for the non-ASCII share: Latin-1 letters, Greek, CJK, emoji
+const uint32_t kUnicodeRanges[][2] = {
+    {0x00C0, 0x00FF}, {0x0391, 0x03C9}, {0x4E00, 0x4FFF}, {0x1F600, 0x1F64F}
+};
+
+void append_utf8(std::string& out, uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+// Days from 1970-01-01 to a civil date (Howard Hinnant's algorithm)
+std::string format_date(long long days) {
+    days += 719468;
+    long long era = (days >= 0 ? days : days - 146096) / 146097;
+    long long doe = days - era * 146097;
+    long long yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    long long doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    long long mp = (5 * doy + 2) / 153;
+    long long d = doy - (153 * mp + 2) / 5 + 1;
+    long long m = mp < 10 ? mp + 3 : mp - 9;
+    long long y = yoe + era * 400 + (m <= 2 ? 1 : 0);
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%04lld-%02lld-%02lld", y, m, d);
+    return buf;
+}
+
+std::string format_time(long long seconds) {
+    char buf[16];
+    std::snprintf(buf, sizeof(buf), "%02lld:%02lld:%02lld",
+                  seconds / 3600, (seconds / 60) % 60, seconds % 60);
+    return buf;
+}
+
+constexpr long long kEpoch2000 = 10957;   // 2000-01-01 in days since 1970-01-01
+constexpr long long kDateSpan = 9132;     // Dates fall in 2000-01-01 .. 2024-12-31
+
+bool parse_number(const std::string& text, double& value) {
+    try {
+        size_t used = 0;
+        value = std::stod(text, &used);
+        return used == text.size() && std::isfinite(value);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool parse_count(const std::string& text, uint64_t& value) {
+    if (text.empty() || !std::all_of(text.begin(), text.end(),
+                                     [](unsigned char c) { return std::isdigit(c); })) {
+        return false;
+    }
+    try {
+        value = std::stoull(text);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+// What a column generates, worked out once per table
+struct ColumnPlan {
+    enum class Kind { Integer, Real, Bit, Text, Date, Time, Timestamp };
+
+    const MockColumn* column = nullptr;
+    ColumnSpec spec;
+    Kind kind = Kind::Text;
+    uint64_t seed = 0;        // Stream of each row
+    uint64_t key_seed = 0;    // Stream of each key, when cardinality is set
+    ZipfSampler zipf;
+    size_t min_length = 0;
+    size_t max_length = 0;
+    double scale = 0;         // 10^digits for DECIMAL/NUMERIC; 0 = no rounding
+};
+
+ColumnPlan::Kind kind_of(SQLSMALLINT data_type) {
+    switch (data_type) {
+        case SQL_INTEGER:
+        case SQL_BIGINT:
+        case SQL_SMALLINT:
+        case SQL_TINYINT:
+            return ColumnPlan::Kind::Integer;
+        case SQL_DECIMAL:
+        case SQL_NUMERIC:
+        case SQL_REAL:
+        case SQL_FLOAT:
+        case SQL_DOUBLE:
+            return ColumnPlan::Kind::Real;
+        case SQL_BIT:
+            return ColumnPlan::Kind::Bit;
+        case SQL_TYPE_DATE:
+            return ColumnPlan::Kind::Date;
+        case SQL_TYPE_TIME:
+            return ColumnPlan::Kind::Time;
+        case SQL_TYPE_TIMESTAMP:
+            return ColumnPlan::Kind::Timestamp;
+        default:
+            return ColumnPlan::Kind::Text;
+    }
+}
+
+double draw_number(const ColumnPlan& plan, CellRandom& rng, uint64_t key, bool keyed) {
+    const ColumnSpec& spec = plan.spec;
+    switch (spec.distribution) {
+        case ValueDistribution::Sequential:
+            return spec.min + static_cast<double>(key);
+        case ValueDistribution::Normal:
+            return spec.mean + spec.stddev * rng.gaussian();
+        case ValueDistribution::Zipf:
+            return spec.min + static_cast<double>(keyed ? key : plan.zipf.sample(rng) - 1);
+        case ValueDistribution::Uniform:
+        default:
+            if (plan.kind == ColumnPlan::Kind::Integer) {
+                double lo = std::ceil(spec.min);
+                double span = std::floor(spec.max) - lo + 1.0;
+                return lo + static_cast<double>(rng.below(span > 0 ? static_cast<uint64_t>(span) : 1));
+            }
+            return spec.min + rng.uniform() * (spec.max - spec.min);
+    }
+}
+
+std::string draw_text(const ColumnPlan& plan, CellRandom& rng, uint64_t key) {
+    const ColumnSpec& spec = plan.spec;
+    if (spec.distribution == ValueDistribution::Sequential) {
+        return std::to_string(static_cast<long long>(spec.min) + static_cast<long long>(key));
+    }
+
+    size_t length = plan.min_length;
+    size_t span = plan.max_length - plan.min_length;
+    if (span > 0) {
+        if (spec.normal_length) {
+            double mid = (plan.min_length + plan.max_length) / 2.0;
+            double drawn = std::round(mid + (span / 6.0) * rng.gaussian());
+            length = static_cast<size_t>(std::clamp(drawn, static_cast<double>(plan.min_length),
+                                                    static_cast<double>(plan.max_length)));
+        } else {
+            length += static_cast<size_t>(rng.below(span + 1));
+        }
+    }
+
+    std::string out;
+    out.reserve(length);
+    for (size_t i = 0; i < length; ++i) {
+        if (spec.unicode_ratio > 0 && rng.uniform() < spec.unicode_ratio) {
+            const auto& range = kUnicodeRanges[rng.below(4)];
+            append_utf8(out, range[0] + static_cast<uint32_t>(rng.below(range[1] - range[0] + 1)));
+        } else {
+            out += kAlphanumeric[rng.below(sizeof(kAlphanumeric) - 1)];
+        }
+    }
+    return out;
+}
+
+CellValue generate_cell(const ColumnPlan& plan, uint64_t row) {
+    const ColumnSpec& spec = plan.spec;
+    CellRandom rng(plan.seed, row);
+    if (spec.null_ratio > 0 && plan.column->nullable != SQL_NO_NULLS &&
+        rng.uniform() < spec.null_ratio) {
+        return std::monostate{};
+    }
+
+    // With a cardinality the value depends on the row's key, not the row
+    uint64_t key = row;
+    bool keyed = spec.cardinality > 0;
+    if (keyed) {
+        key = spec.distribution == ValueDistribution::Zipf ? plan.zipf.sample(rng) - 1
+                                                           : rng.below(spec.cardinality);
+        rng = CellRandom(plan.key_seed, key);
+    }
+
+    switch (plan.kind) {
+        case ColumnPlan::Kind::Text:
+            return draw_text(plan, rng, key);
+        case ColumnPlan::Kind::Bit:
+            return static_cast<long long>(
+                spec.distribution == ValueDistribution::Sequential || keyed ? key % 2 : rng.below(2));
+        case ColumnPlan::Kind::Date:
+        case ColumnPlan::Kind::Time:
+        case ColumnPlan::Kind::Timestamp: {
+            long long day = static_cast<long long>(
+                spec.distribution == ValueDistribution::Sequential ? key % kDateSpan : rng.below(kDateSpan));
+            long long second = static_cast<long long>(rng.below(86400));
+            if (plan.kind == ColumnPlan::Kind::Date) return format_date(kEpoch2000 + day);
+            if (plan.kind == ColumnPlan::Kind::Time) return format_time(second);
+            return format_date(kEpoch2000 + day) + " " + format_time(second);
+        }
+        case ColumnPlan::Kind::Integer:
+            return static_cast<long long>(std::llround(draw_number(plan, rng, key, keyed)));
+        case ColumnPlan::Kind::Real:
+        default: {
+            double value = draw_number(plan, rng, key, keyed);
+            if (plan.scale > 0) value = std::round(value * plan.scale) / plan.scale;
+            return value;
+        }
+    }
+}
+
+} // anonymous namespace
+
+bool apply_column_spec(const std::string& text, ColumnSpec& spec, std::string& error) {
+    std::string items = text;
+    std::replace(items.begin(), items.end(), ',', ' ');
+    std::istringstream iss(items);
+    std::string item;
+    while (iss >> item) {
+        auto eq = item.find('=');
+        if (eq == std::string::npos) {
+            error = "expected key=value, got '" + item + "'";
+            return false;
+        }
+        std::string key = to_lower(item.substr(0, eq));
+        std::string value = item.substr(eq + 1);
+        std::string lower_value = to_lower(value);
+        double number = 0;
+        bool ok = true;
+
+        if (key == "dist" || key == "distribution") {
+            if (lower_value == "sequential") spec.distribution = ValueDistribution::Sequential;
+            else if (lower_value == "uniform") spec.distribution = ValueDistribution::Uniform;
+            else if (lower_value == "normal") spec.distribution = ValueDistribution::Normal;
+            else if (lower_value == "zipf") spec.distribution = ValueDistribution::Zipf;
+            else ok = false;
+        } else if (key == "min") {
+            ok = parse_number(value, spec.min);
+        } else if (key == "max") {
+            ok = parse_number(value, spec.max);
+        } else if (key == "mean") {
+            ok = parse_number(value, spec.mean);
+            spec.has_mean = ok;
+        } else if (key == "stddev") {
+            ok = parse_number(value, spec.stddev) && spec.stddev >= 0;
+            spec.has_stddev = ok;
+        } else if (key == "skew") {
+            ok = parse_number(value, spec.skew) && spec.skew > 0;
+        } else if (key == "nulls") {
+            ok = parse_number(value, number) && number >= 0 && number <= 1;
+            if (ok) spec.null_ratio = number;
+        } else if (key == "unicode") {
+            ok = parse_number(value, number) && number >= 0 && number <= 1;
+            if (ok) spec.unicode_ratio = number;
+        } else if (key == "cardinality") {
+            ok = parse_count(value, spec.cardinality);
+        } else if (key == "length") {
+            uint64_t lo = 0, hi = 0;
+            auto dots = value.find("..");
+            if (dots == std::string::npos) {
+                ok = parse_count(value, lo);
+                hi = lo;
+            } else {
+                ok = parse_count(value.substr(0, dots), lo) && parse_count(value.substr(dots + 2), hi) &&
+                     lo <= hi;
+            }
+            if (ok) {
+                spec.min_length = static_cast<size_t>(lo);
+                spec.max_length = static_cast<size_t>(hi);
+            }
+        } else if (key == "lengthdist") {
+            if (lower_value == "uniform") spec.normal_length = false;
+            else if (lower_value == "normal") spec.normal_length = true;
+            else ok = false;
+        } else {
+            error = "unknown key '" + key + "'";
+            return false;
+        }
+
+        if (!ok) {
+            error = "bad value for " + key + ": '" + value + "'";
+            return false;
+        }
+    }
+    if (spec.min > spec.max) {
+        error = "min is greater than max";
+        return false;
+    }
+    return true;
+}
+
+DataGenerator& DataGenerator::instance() {
+    static DataGenerator instance;
+    return instance;
+}
+
+bool DataGenerator::configure(const DriverConfig& config, std::string& error) {
+    enabled_ = false;
+    seed_ = 0;
+    threads_ = config.data_threads;
+    specs_.clear();
+
+    if (!config.bad_data_seed.empty()) {
+        error = "Invalid DataSeed: " + config.bad_data_seed;
+        return false;
+    }
+
+    std::vector<std::pair<std::string, std::string>> specs;
+    uint64_t file_seed = 0;
+    if (!config.data_spec_file.empty()) {
+        std::ifstream in(config.data_spec_file);
+        if (!in) {
+            error = "Cannot read data spec file " + config.data_spec_file;
+            return false;
+        }
+        // Lines are "<[TABLE.]COLUMN|*> <spec>" or "seed <n>"; '#' starts a comment
+        std::string line;
+        int line_number = 0;
+        while (std::getline(in, line)) {
+            ++line_number;
+            line = line.substr(0, line.find('#'));
+            std::istringstream iss(line);
+            std::string pattern;
+            if (!(iss >> pattern)) continue;
+            std::string rest;
+            std::getline(iss, rest);
+            if (to_lower(pattern) == "seed") {
+                std::string value;
+                std::istringstream(rest) >> value;
+                if (!parse_count(value, file_seed)) {
+                    error = config.data_spec_file + ":" + std::to_string(line_number) + ": bad seed";
+                    return false;
+                }
+                continue;
+            }
+            specs.emplace_back(to_upper(pattern), rest);
+        }
+    }
+    // Connection string entries come last so they win over the file
+    specs.insert(specs.end(), config.column_specs.begin(), config.column_specs.end());
+
+    for (const auto& [pattern, text] : specs) {
+        ColumnSpec probe;
+        std::string reason;
+        if (!apply_column_spec(text, probe, reason)) {
+            error = "Invalid data spec for " + pattern + ": " + reason;
+            return false;
+        }
+    }
+
+    enabled_ = config.data_seed.has_value() || !config.data_spec_file.empty() ||
+               !config.column_specs.empty();
+    seed_ = config.data_seed.value_or(file_seed);
+    specs_ = std::move(specs);
+    return true;
+}
+
+ColumnSpec DataGenerator::spec_for(const MockTable& table, const MockColumn& column,
+                                   size_t row_count) const {
+    ColumnSpec spec;
+    bool is_key = column.is_primary_key || column.is_auto_increment;
+    if (is_key) {
+        spec.distribution = ValueDistribution::Sequential;
+        spec.min = 1;
+    } else if (!column.fk_table.empty()) {
+        spec.min = 1;
+        spec.max = static_cast<double>(std::max<size_t>(row_count, 1));
+    }
+
+    const std::string name = to_upper(column.name);
+    const std::string qualified = to_upper(table.name) + "." + name;
+    std::string error;
+    // "*" leaves key columns alone so joins on generated ids still match
+    for (const std::string& pattern : {std::string("*"), name, qualified}) {
+        if (pattern == "*" && is_key) continue;
+        for (const auto& [p, text] : specs_) {
+            if (p == pattern) apply_column_spec(text, spec, error);
+        }
+    }
+    return spec;
+}
+
+std::vector<MockRow> DataGenerator::generate(const MockTable& table, size_t row_count) const {
+    std::vector<ColumnPlan> plans;
+    plans.reserve(table.columns.size());
+    for (const auto& column : table.columns) {
+        ColumnPlan plan;
+        plan.column = &column;
+        plan.spec = spec_for(table, column, row_count);
+        plan.kind = kind_of(column.data_type);
+        plan.seed = mix64(seed_ ^ hash_name(to_upper(table.name) + "." + to_upper(column.name)));
+        plan.key_seed = mix64(plan.seed ^ 0x5851F42D4C957F2DULL);
+
+        ColumnSpec& spec = plan.spec;
+        if (!spec.has_mean) spec.mean = (spec.min + spec.max) / 2.0;
+        if (!spec.has_stddev) spec.stddev = (spec.max - spec.min) / 6.0;
+        if (spec.distribution == ValueDistribution::Zipf) {
+            double range = std::floor(spec.max - spec.min) + 1.0;
+            uint64_t n = spec.cardinality > 0 ? spec.cardinality
+                                              : static_cast<uint64_t>(std::max(range, 1.0));
+            plan.zipf = ZipfSampler(n, spec.skew);
+        }
+        size_t limit = column.column_size > 0 ? static_cast<size_t>(column.column_size) : 64;
+        plan.max_length = std::min(spec.max_length > 0 ? spec.max_length : std::min<size_t>(limit, 64),
+                                   limit);
+        plan.min_length = std::min(spec.min_length, plan.max_length);
+        if ((column.data_type == SQL_DECIMAL || column.data_type == SQL_NUMERIC) &&
+            column.decimal_digits > 0) {
+            plan.scale = std::pow(10.0, column.decimal_digits);
+        }
+        plans.push_back(std::move(plan));
+    }
+
+    std::vector<MockRow> rows(row_count);
+    auto fill = [&](size_t begin, size_t end) {
+        for (size_t r = begin; r < end; ++r) {
+            MockRow& row = rows[r];
+            row.reserve(plans.size());
+            for (const auto& plan : plans) {
+                row.push_back(generate_cell(plan, r));
+            }
+        }
+    };
+
+    // Chunks are claimed dynamically; cells don't depend on which thread runs them
+    constexpr size_t kChunkRows = 8192;
+    size_t chunks = (row_count + kChunkRows - 1) / kChunkRows;
+    size_t threads = threads_ > 0 ? static_cast<size_t>(threads_)
+                                  : std::max(1u, std::thread::hardware_concurrency());
+    threads = std::min(threads, chunks);
+    if (threads <= 1) {
+        fill(0, row_count);
+        return rows;
+    }
+
+    std::atomic<size_t> next_chunk{0};
+    auto worker = [&]() {
+        for (size_t c = next_chunk++; c < chunks; c = next_chunk++) {
+            fill(c * kChunkRows, std::min(row_count, (c + 1) * kChunkRows));
+        }
+    };
+    std::vector<std::thread> pool;
+    for (size_t i = 1; i < threads; ++i) {
+        pool.emplace_back(worker);
+    }
+    worker();
+    for (auto& t : pool) {
+        t.join();
+    }
+    return rows;
+}
+
+} // namespace mock_odbc
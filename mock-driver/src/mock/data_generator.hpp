@@ -0,0 +1,87 @@
+#pragma once
+
+#include "../driver/config.hpp"
+#include "mock_catalog.hpp"
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace mock_odbc {
+
+// How a column's values are drawn
+enum class ValueDistribution {
+    Sequential,   // min, min + 1, ... by row
+    Uniform,      // Uniform in [min, max]
+    Normal,       // Normal with `mean` and `stddev`
+    Zipf          // Rank k in [1, N] with probability ~ 1 / k^skew; value min + k - 1
+};
+
+// Generator settings for one column. Written as space- or comma-separated
+// key=value items, e.g. "dist=zipf skew=1.2 min=1 max=5000 nulls=0.05".
+//
+//   dist=sequential|uniform|normal|zipf   min=<n>  max=<n>
+//   mean=<n>  stddev=<n>                  (normal; default to the middle
+//                                          and a sixth of [min, max])
+//   skew=<s>                              (zipf exponent, > 0)
+//   nulls=<ratio 0-1>                     cardinality=<distinct values>
+//   length=<n>|<min>..<max>  lengthdist=uniform|normal   (strings)
+//   unicode=<ratio 0-1>                   (share of non-ASCII characters)
+//
+// With a cardinality, each row picks one of that many keys (zipf-ranked
+// with dist=zipf, uniform otherwise) and every row with the same key gets
+// the same value.
+struct ColumnSpec {
+    ValueDistribution distribution = ValueDistribution::Uniform;
+    double min = 0;
+    double max = 1000000;
+    double mean = 0;
+    double stddev = 0;
+    bool has_mean = false;
+    bool has_stddev = false;
+    double skew = 1.0;
+    double null_ratio = 0;
+    uint64_t cardinality = 0;        // 0 = every row draws independently
+    size_t min_length = 1;
+    size_t max_length = 0;           // 0 = column size, capped at 64
+    bool normal_length = false;
+    double unicode_ratio = 0;
+};
+
+// Apply the items in `text` on top of `spec`. Returns false and sets
+// `error` on an unknown key or a bad value.
+bool apply_column_spec(const std::string& text, ColumnSpec& spec, std::string& error);
+
+// Seeded, deterministic row generator for preset tables. A cell depends
+// only on the seed, table, column and row number, so rows can be made in
+// parallel chunks and every run with the same settings returns the same
+// data whatever the thread count.
+class DataGenerator {
+public:
+    static DataGenerator& instance();
+
+    // Take settings from DataSeed=, DataSpec=, Gen.*= and DataThreads=.
+    // Disabled when none of the first three is set. Returns false and sets
+    // `error` when the spec file can't be read or a spec is invalid.
+    bool configure(const DriverConfig& config, std::string& error);
+
+    bool enabled() const { return enabled_; }
+    uint64_t seed() const { return seed_; }
+
+    // Spec for a column: built-in defaults, then "*", "COLUMN" and
+    // "TABLE.COLUMN" entries in that order. Keys and auto-increment columns
+    // default to sequential; foreign keys to uniform over [1, row_count].
+    ColumnSpec spec_for(const MockTable& table, const MockColumn& column, size_t row_count) const;
+
+    std::vector<MockRow> generate(const MockTable& table, size_t row_count) const;
+
+private:
+    DataGenerator() = default;
+
+    bool enabled_ = false;
+    uint64_t seed_ = 0;
+    int threads_ = 0;
+    std::vector<std::pair<std::string, std::string>> specs_;   // Upper-case pattern -> spec text
+};
+
+} // namespace mock_odbc
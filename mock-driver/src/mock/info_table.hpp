@@ -0,0 +1,207 @@
+#pragma once
+
+#include "../driver/common.hpp"
+#include "sorted_table.hpp"
+#include <string_view>
+
+namespace mock_odbc {
+
+// One SQLGetInfo information type and the driver's answer
+struct InfoValue {
+    enum class Kind : unsigned char { String, UShort, ULong };
+
+    SQLUSMALLINT info_type;
+    Kind kind;
+    bool dynamic;             // Answered from the connection or DriverConfig, not from text/number
+    std::string_view text;    // Kind::String
+    SQLUINTEGER number;       // Kind::UShort, Kind::ULong
+};
+
+namespace info_table_detail {
+
+constexpr InfoValue text(SQLUSMALLINT type, std::string_view value) {
+    return {type, InfoValue::Kind::String, false, value, 0};
+}
+constexpr InfoValue usmallint(SQLUSMALLINT type, SQLUINTEGER value) {
+    return {type, InfoValue::Kind::UShort, false, {}, value};
+}
+constexpr InfoValue uinteger(SQLUSMALLINT type, SQLUINTEGER value) {
+    return {type, InfoValue::Kind::ULong, false, {}, value};
+}
+constexpr InfoValue dynamic(SQLUSMALLINT type, InfoValue::Kind kind) {
+    return {type, kind, true, {}, 0};
+}
+
+constexpr SQLUSMALLINT info_type(const InfoValue& v) { return v.info_type; }
+
+constexpr SQLUINTEGER kConvertChar = SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_INTEGER |
+                                     SQL_CVT_DOUBLE | SQL_CVT_DATE | SQL_CVT_TIMESTAMP;
+constexpr SQLUINTEGER kConvertInteger = SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_INTEGER |
+                                        SQL_CVT_SMALLINT | SQL_CVT_BIGINT | SQL_CVT_DOUBLE |
+                                        SQL_CVT_DECIMAL | SQL_CVT_NUMERIC;
+constexpr SQLUINTEGER kConvertDecimal = SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_INTEGER |
+                                        SQL_CVT_DOUBLE | SQL_CVT_DECIMAL | SQL_CVT_NUMERIC |
+                                        SQL_CVT_FLOAT | SQL_CVT_REAL;
+constexpr SQLUINTEGER kConvertBinary = SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_BINARY |
+                                       SQL_CVT_VARBINARY | SQL_CVT_LONGVARBINARY;
+constexpr SQLUINTEGER kConvertWChar = SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_WCHAR |
+                                      SQL_CVT_WVARCHAR | SQL_CVT_INTEGER | SQL_CVT_DOUBLE;
+constexpr SQLUINTEGER kTimedateIntervals = SQL_FN_TSI_DAY | SQL_FN_TSI_MONTH | SQL_FN_TSI_YEAR |
+                                           SQL_FN_TSI_HOUR | SQL_FN_TSI_MINUTE | SQL_FN_TSI_SECOND;
+
+} // namespace info_table_detail
+
+// Every information type SQLGetInfo answers, sorted by info type at compile
+// time. Lookups are a binary search, and nothing is built at library load.
+inline constexpr auto kInfoValues = [] {
+    using namespace info_table_detail;
+    using Kind = InfoValue::Kind;
+    return sort_by_key(std::array{
+        // Driver Information
+        text(SQL_DRIVER_NAME, "mockodbc.dll"),
+        dynamic(SQL_DRIVER_VER, Kind::String),
+        dynamic(SQL_DRIVER_ODBC_VER, Kind::String),
+        text(SQL_ODBC_VER, "03.80.0000"),
+
+        // DBMS Information
+        dynamic(SQL_DBMS_NAME, Kind::String),
+        dynamic(SQL_DBMS_VER, Kind::String),
+        text(SQL_SERVER_NAME, "MockDBServer"),
+
+        // Data Source Information
+        dynamic(SQL_DATA_SOURCE_NAME, Kind::String),
+        dynamic(SQL_DATA_SOURCE_READ_ONLY, Kind::String),
+        text(SQL_DATABASE_NAME, "MockDatabase"),
+        dynamic(SQL_USER_NAME, Kind::String),
+
+        // Supported SQL
+        uinteger(SQL_SQL_CONFORMANCE, SQL_SC_SQL92_INTERMEDIATE),
+        usmallint(SQL_ODBC_SQL_CONFORMANCE, SQL_OSC_CORE),
+
+        // Cursor Characteristics
+        usmallint(SQL_CURSOR_COMMIT_BEHAVIOR, SQL_CB_CLOSE),
+        usmallint(SQL_CURSOR_ROLLBACK_BEHAVIOR, SQL_CB_CLOSE),
+        uinteger(SQL_CURSOR_SENSITIVITY, SQL_INSENSITIVE),
+        uinteger(SQL_SCROLL_OPTIONS, SQL_SO_FORWARD_ONLY | SQL_SO_STATIC),
+        uinteger(SQL_STATIC_CURSOR_ATTRIBUTES1,
+                 SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE | SQL_CA1_BULK_ADD),
+        uinteger(SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1, SQL_CA1_NEXT | SQL_CA1_BULK_ADD),
+        uinteger(SQL_DYNAMIC_CURSOR_ATTRIBUTES1, 0),
+        uinteger(SQL_KEYSET_CURSOR_ATTRIBUTES1, 0),
+
+        // Transaction Support
+        usmallint(SQL_TXN_CAPABLE, SQL_TC_ALL),
+        uinteger(SQL_TXN_ISOLATION_OPTION, SQL_TXN_READ_UNCOMMITTED | SQL_TXN_READ_COMMITTED |
+                                          SQL_TXN_REPEATABLE_READ | SQL_TXN_SERIALIZABLE),
+        uinteger(SQL_DEFAULT_TXN_ISOLATION, SQL_TXN_READ_COMMITTED),
+
+        // Identifier Case
+        usmallint(SQL_IDENTIFIER_CASE, SQL_IC_UPPER),
+        text(SQL_IDENTIFIER_QUOTE_CHAR, "\""),
+
+        // Catalog Support
+        text(SQL_CATALOG_NAME, "Y"),
+        text(SQL_CATALOG_NAME_SEPARATOR, "."),
+        text(SQL_CATALOG_TERM, "catalog"),
+        text(SQL_SCHEMA_TERM, "schema"),
+        text(SQL_TABLE_TERM, "table"),
+        text(SQL_PROCEDURE_TERM, "procedure"),
+
+        // Max Lengths
+        usmallint(SQL_MAX_CATALOG_NAME_LEN, 128),
+        usmallint(SQL_MAX_SCHEMA_NAME_LEN, 128),
+        usmallint(SQL_MAX_TABLE_NAME_LEN, 128),
+        usmallint(SQL_MAX_COLUMN_NAME_LEN, 128),
+        usmallint(SQL_MAX_CURSOR_NAME_LEN, 64),
+        usmallint(SQL_MAX_IDENTIFIER_LEN, 128),
+        usmallint(SQL_MAX_PROCEDURE_NAME_LEN, 128),
+        usmallint(SQL_MAX_USER_NAME_LEN, 128),
+        dynamic(SQL_MAX_DRIVER_CONNECTIONS, Kind::UShort),
+        usmallint(SQL_MAX_CONCURRENT_ACTIVITIES, 0),  // No limit
+
+        // Feature Support
+        uinteger(SQL_GETDATA_EXTENSIONS, SQL_GD_ANY_COLUMN | SQL_GD_ANY_ORDER | SQL_GD_BOUND),
+        uinteger(SQL_PARAM_ARRAY_ROW_COUNTS, SQL_PARC_BATCH),
+        uinteger(SQL_PARAM_ARRAY_SELECTS, SQL_PAS_NO_SELECT),
+        uinteger(SQL_BATCH_ROW_COUNT, SQL_BRC_EXPLICIT),
+        uinteger(SQL_BATCH_SUPPORT, SQL_BS_SELECT_EXPLICIT | SQL_BS_ROW_COUNT_EXPLICIT),
+        uinteger(SQL_BOOKMARK_PERSISTENCE, 0),
+        text(SQL_DESCRIBE_PARAMETER, "Y"),
+        text(SQL_MULT_RESULT_SETS, "N"),
+        text(SQL_MULTIPLE_ACTIVE_TXN, "Y"),
+        text(SQL_NEED_LONG_DATA_LEN, "N"),
+        usmallint(SQL_NULL_COLLATION, SQL_NC_HIGH),
+        text(SQL_OUTER_JOINS, "Y"),
+        text(SQL_ORDER_BY_COLUMNS_IN_SELECT, "N"),
+        text(SQL_PROCEDURES, "N"),
+        text(SQL_ROW_UPDATES, "N"),
+        text(SQL_SEARCH_PATTERN_ESCAPE, "\\"),
+        text(SQL_SPECIAL_CHARACTERS, ""),
+
+        // Scalar Functions
+        uinteger(SQL_NUMERIC_FUNCTIONS, SQL_FN_NUM_ABS | SQL_FN_NUM_CEILING | SQL_FN_NUM_FLOOR |
+                                       SQL_FN_NUM_ROUND | SQL_FN_NUM_SQRT),
+        uinteger(SQL_STRING_FUNCTIONS, SQL_FN_STR_CONCAT | SQL_FN_STR_LENGTH | SQL_FN_STR_LTRIM |
+                                      SQL_FN_STR_RTRIM | SQL_FN_STR_SUBSTRING | SQL_FN_STR_UCASE |
+                                      SQL_FN_STR_LCASE),
+        uinteger(SQL_SYSTEM_FUNCTIONS, SQL_FN_SYS_DBNAME | SQL_FN_SYS_USERNAME),
+        uinteger(SQL_TIMEDATE_FUNCTIONS, SQL_FN_TD_NOW | SQL_FN_TD_CURDATE | SQL_FN_TD_CURTIME |
+                                        SQL_FN_TD_YEAR | SQL_FN_TD_MONTH | SQL_FN_TD_DAYOFWEEK),
+        uinteger(SQL_CONVERT_FUNCTIONS, SQL_FN_CVT_CAST | SQL_FN_CVT_CONVERT),
+        uinteger(SQL_AGGREGATE_FUNCTIONS, SQL_AF_AVG | SQL_AF_COUNT | SQL_AF_MAX | SQL_AF_MIN | SQL_AF_SUM),
+
+        // Queries
+        uinteger(SQL_SUBQUERIES, SQL_SQ_COMPARISON | SQL_SQ_EXISTS | SQL_SQ_IN),
+        uinteger(SQL_UNION, SQL_U_UNION | SQL_U_UNION_ALL),
+        uinteger(SQL_ASYNC_MODE, SQL_AM_STATEMENT),
+        uinteger(SQL_OJ_CAPABILITIES, SQL_OJ_LEFT | SQL_OJ_RIGHT | SQL_OJ_NOT_ORDERED |
+                                     SQL_OJ_ALL_COMPARISON_OPS),
+        text(SQL_LIKE_ESCAPE_CLAUSE, "Y"),
+        uinteger(SQL_DATETIME_LITERALS, SQL_DL_SQL92_DATE | SQL_DL_SQL92_TIME | SQL_DL_SQL92_TIMESTAMP),
+        uinteger(SQL_TIMEDATE_ADD_INTERVALS, kTimedateIntervals),
+        uinteger(SQL_TIMEDATE_DIFF_INTERVALS, kTimedateIntervals),
+
+        // SQL_CONVERT_* types — support basic conversions
+        uinteger(SQL_CONVERT_CHAR, kConvertChar),
+        uinteger(SQL_CONVERT_VARCHAR, kConvertChar),
+        uinteger(SQL_CONVERT_LONGVARCHAR, kConvertChar),
+        uinteger(SQL_CONVERT_INTEGER, kConvertInteger),
+        uinteger(SQL_CONVERT_SMALLINT, kConvertInteger),
+        uinteger(SQL_CONVERT_BIGINT, kConvertInteger),
+        uinteger(SQL_CONVERT_TINYINT, kConvertInteger),
+        uinteger(SQL_CONVERT_DECIMAL, kConvertDecimal),
+        uinteger(SQL_CONVERT_NUMERIC, kConvertDecimal),
+        uinteger(SQL_CONVERT_DOUBLE, kConvertDecimal),
+        uinteger(SQL_CONVERT_FLOAT, kConvertDecimal),
+        uinteger(SQL_CONVERT_REAL, kConvertDecimal),
+        uinteger(SQL_CONVERT_DATE, SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_DATE | SQL_CVT_TIMESTAMP),
+        uinteger(SQL_CONVERT_TIME, SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_TIME | SQL_CVT_TIMESTAMP),
+        uinteger(SQL_CONVERT_TIMESTAMP, SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_DATE |
+                                       SQL_CVT_TIME | SQL_CVT_TIMESTAMP),
+        uinteger(SQL_CONVERT_BIT, SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_INTEGER | SQL_CVT_BIT),
+        uinteger(SQL_CONVERT_BINARY, kConvertBinary),
+        uinteger(SQL_CONVERT_VARBINARY, kConvertBinary),
+        uinteger(SQL_CONVERT_LONGVARBINARY, kConvertBinary),
+        uinteger(SQL_CONVERT_WCHAR, kConvertWChar),
+        uinteger(SQL_CONVERT_WVARCHAR, kConvertWChar),
+        uinteger(SQL_CONVERT_WLONGVARCHAR, kConvertWChar),
+        uinteger(SQL_CONVERT_GUID, SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_GUID),
+
+        // Conformance
+        uinteger(SQL_ODBC_INTERFACE_CONFORMANCE, SQL_OIC_CORE),
+        uinteger(SQL_SQL92_PREDICATES, SQL_SP_BETWEEN | SQL_SP_COMPARISON | SQL_SP_EXISTS |
+                                      SQL_SP_IN | SQL_SP_ISNOTNULL | SQL_SP_ISNULL | SQL_SP_LIKE),
+        uinteger(SQL_SQL92_VALUE_EXPRESSIONS, SQL_SVE_CASE | SQL_SVE_CAST | SQL_SVE_COALESCE | SQL_SVE_NULLIF),
+    }, info_table_detail::info_type);
+}();
+
+static_assert(keys_unique(kInfoValues, info_table_detail::info_type),
+              "an information type is listed twice");
+
+// The entry for `info_type`, or nullptr when SQLGetInfo doesn't answer it
+constexpr const InfoValue* find_info(SQLUSMALLINT info_type) {
+    size_t i = lower_bound_by_key(kInfoValues, info_table_detail::info_type, info_type);
+    return i < kInfoValues.size() && kInfoValues[i].info_type == info_type ? &kInfoValues[i] : nullptr;
+}
+
+} // namespace mock_odbc
@@ -0,0 +1,154 @@
+#include "like_pattern.hpp"
+
+namespace mock_odbc {
+
+namespace {
+
+// Catalog names are ASCII; folding by hand keeps matching locale-free
+char upper(char c) {
+    return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A') : c;
+}
+
+std::string to_upper(std::string_view s) {
+    std::string result(s);
+    for (auto& c : result) c = upper(c);
+    return result;
+}
+
+// `upper_text` (already upper-case) equals value[pos, pos + size)
+bool equals_at(std::string_view value, size_t pos, const std::string& upper_text) {
+    for (size_t i = 0; i < upper_text.size(); ++i) {
+        if (upper(value[pos + i]) != upper_text[i]) return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+LikePattern::LikePattern(std::string_view pattern, char escape) {
+    bool leading_percent = false;
+    bool trailing_percent = false;
+    bool has_percent = false;
+    bool has_underscore = false;
+    Segment current;
+
+    for (size_t i = 0; i < pattern.size(); ++i) {
+        char c = pattern[i];
+        bool wildcard = c == '%' || c == '_';
+        // An escape before a wildcard or itself makes that one literal; an
+        // escape before anything else is an ordinary character
+        if (escape != '\0' && c == escape && i + 1 < pattern.size() &&
+            (pattern[i + 1] == '%' || pattern[i + 1] == '_' || pattern[i + 1] == escape)) {
+            c = pattern[++i];
+            wildcard = false;
+        }
+
+        if (wildcard && c == '%') {
+            if (i == 0) leading_percent = true;
+            has_percent = true;
+            trailing_percent = true;
+            if (!current.text.empty()) {
+                segments_.push_back(std::move(current));
+                current = Segment{};
+            }
+            continue;
+        }
+        trailing_percent = false;
+        has_underscore |= wildcard;
+        current.text.push_back(wildcard ? '_' : upper(c));
+        current.any.push_back(wildcard);
+    }
+    if (!current.text.empty()) segments_.push_back(std::move(current));
+
+    anchored_start_ = !leading_percent;
+    anchored_end_ = !trailing_percent;
+    if (segments_.empty()) {
+        kind_ = Kind::All;
+    } else if (has_underscore || segments_.size() > 1) {
+        kind_ = Kind::General;
+    } else if (!has_percent) {
+        kind_ = Kind::Exact;
+    } else if (anchored_start_ && !anchored_end_) {
+        kind_ = Kind::Prefix;
+    } else if (!anchored_start_ && anchored_end_) {
+        kind_ = Kind::Suffix;
+    } else {
+        kind_ = Kind::General;    // %NAME%
+    }
+    if (kind_ != Kind::General) {
+        if (!segments_.empty()) literal_ = std::move(segments_.front().text);
+        segments_.clear();
+    }
+}
+
+LikePattern LikePattern::identifier(std::string_view name) {
+    LikePattern pattern;
+    pattern.kind_ = Kind::Exact;
+    if (name.size() >= 2 && name.front() == '"' && name.back() == '"') {
+        // "a""b" names a"b
+        name = name.substr(1, name.size() - 2);
+        for (size_t i = 0; i < name.size(); ++i) {
+            pattern.literal_.push_back(upper(name[i]));
+            if (name[i] == '"' && i + 1 < name.size() && name[i + 1] == '"') ++i;
+        }
+    } else {
+        pattern.literal_ = to_upper(name);
+    }
+    return pattern;
+}
+
+bool LikePattern::segment_at(const Segment& segment, std::string_view value, size_t pos) {
+    for (size_t i = 0; i < segment.text.size(); ++i) {
+        if (!segment.any[i] && upper(value[pos + i]) != segment.text[i]) return false;
+    }
+    return true;
+}
+
+bool LikePattern::matches(std::string_view value) const {
+    switch (kind_) {
+        case Kind::All:
+            return true;
+        case Kind::Exact:
+            return value.size() == literal_.size() && equals_at(value, 0, literal_);
+        case Kind::Prefix:
+            return value.size() >= literal_.size() && equals_at(value, 0, literal_);
+        case Kind::Suffix:
+            return value.size() >= literal_.size() &&
+                   equals_at(value, value.size() - literal_.size(), literal_);
+        case Kind::General:
+            break;
+    }
+
+    // No '%' at all: the one segment is the whole value
+    if (anchored_start_ && anchored_end_ && segments_.size() == 1) {
+        return value.size() == segments_[0].text.size() && segment_at(segments_[0], value, 0);
+    }
+
+    // Pin the first and last segments to the ends, then find the ones in
+    // between left to right. Segments have a fixed length, so taking the
+    // leftmost place for each never rules out a match.
+    size_t begin = 0;
+    size_t end = value.size();
+    size_t first = 0;
+    size_t last = segments_.size();
+    if (anchored_start_) {
+        const Segment& s = segments_[first++];
+        if (s.text.size() > end || !segment_at(s, value, 0)) return false;
+        begin = s.text.size();
+    }
+    if (anchored_end_) {
+        const Segment& s = segments_[--last];
+        if (s.text.size() > end - begin || !segment_at(s, value, end - s.text.size())) return false;
+        end -= s.text.size();
+    }
+    for (size_t i = first; i < last; ++i) {
+        const Segment& s = segments_[i];
+        size_t pos = begin;
+        while (pos + s.text.size() <= end && !segment_at(s, value, pos)) ++pos;
+        if (pos + s.text.size() > end) return false;
+        begin = pos + s.text.size();
+    }
+    return true;
+}
+
+} // namespace mock_odbc
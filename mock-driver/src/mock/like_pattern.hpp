@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace mock_odbc {
+
+// Search pattern argument of a catalog function (the TableName of
+// SQLTables, the ColumnName of SQLColumns, ...), compiled once per call
+// and then matched against every name in the catalog.
+//
+// Pattern syntax is SQL LIKE: '%' matches any run of characters, '_' any
+// one character, and the escape character (SQL_SEARCH_PATTERN_ESCAPE)
+// before '%', '_' or itself makes that character literal. Matching is
+// case-insensitive, like every name lookup in the catalog, and doesn't
+// allocate. Patterns without '_' that are a plain name, a name followed by
+// '%' or '%' followed by a name take a single comparison; others are
+// matched run by run between the '%'s.
+class LikePattern {
+public:
+    // An empty pattern or "%" matches everything
+    explicit LikePattern(std::string_view pattern, char escape = '\\');
+
+    // An identifier argument (SQL_ATTR_METADATA_ID is SQL_TRUE): no
+    // wildcards or escapes, surrounding double quotes are stripped and the
+    // result must equal the whole name
+    static LikePattern identifier(std::string_view name);
+
+    bool matches(std::string_view value) const;
+
+    bool matches_all() const { return kind_ == Kind::All; }
+
+    // The name a pattern without wildcards stands for (upper-case), else
+    // nullptr; callers look the table up instead of scanning for it
+    const std::string* exact_name() const {
+        return kind_ == Kind::Exact ? &literal_ : nullptr;
+    }
+
+private:
+    enum class Kind { All, Exact, Prefix, Suffix, General };
+
+    // A run of the pattern between '%'s: upper-case text, with any_[i] set
+    // where the pattern has '_'
+    struct Segment {
+        std::string text;
+        std::vector<bool> any;
+    };
+
+    LikePattern() = default;
+    static bool segment_at(const Segment& segment, std::string_view value, size_t pos);
+
+    Kind kind_ = Kind::All;
+    std::string literal_;              // Exact: the name; Prefix/Suffix: the fixed part
+    std::vector<Segment> segments_;    // General only
+    bool anchored_start_ = true;       // General: no '%' before the first segment
+    bool anchored_end_ = true;         // General: no '%' after the last segment
+};
+
+} // namespace mock_odbc
@@ -1,6 +1,11 @@
 #include "mock_catalog.hpp"
+#include "data_file.hpp"
+#include "like_pattern.hpp"
+#include "table_index.hpp"
 #include <algorithm>
 #include <cctype>
+#include <iterator>
+#include <tuple>
 
 namespace mock_odbc {
 
@@ -20,10 +25,18 @@ MockCatalog& MockCatalog::instance() {
     return instance;
 }
 
-void MockCatalog::initialize(const std::string& preset) {
+bool MockCatalog::initialize(const std::string& preset, int large_tables, int large_columns,
+                             const std::string& data_file, std::string* error) {
     tables_.clear();
     indexes_.clear();
     inserted_data_.clear();
+    row_indexes_.clear();
+    // Held only until it is reattached; otherwise its mapping is released
+    // when this returns
+    std::shared_ptr<DataFile> previous_file = std::move(data_file_);
+    table_versions_.clear();
+    // Transactions that began before this can't commit into the new catalog
+    initialized_version_ = ++commit_version_;
     
     std::string lower_preset = preset;
     std::transform(lower_preset.begin(), lower_preset.end(), lower_preset.begin(),
@@ -32,10 +45,19 @@ void MockCatalog::initialize(const std::string& preset) {
     if (lower_preset == "empty") {
         create_empty_catalog();
     } else if (lower_preset == "large") {
-        create_large_catalog();
+        create_large_catalog(large_tables, large_columns);
     } else {
         create_default_catalog();
     }
+    index_tables();
+    
+    if (data_file.empty()) return true;
+    std::string attach_error;
+    if (!attach_data_file(data_file, std::move(previous_file), attach_error)) {
+        if (error) *error = attach_error;
+        return false;
+    }
+    return true;
 }
 
 void MockCatalog::create_default_catalog() {
@@ -160,11 +182,12 @@ void MockCatalog::create_empty_catalog() {
     // No tables
 }
 
-void MockCatalog::create_large_catalog() {
+void MockCatalog::create_large_catalog(int tables, int columns) {
     create_default_catalog();
     
     // Add more tables for performance testing
-    for (int i = 1; i <= 100; ++i) {
+    tables_.reserve(tables_.size() + static_cast<size_t>(tables));
+    for (int i = 1; i <= tables; ++i) {
         MockTable table;
         table.catalog = "";
         table.schema = "";
@@ -173,7 +196,8 @@ void MockCatalog::create_large_catalog() {
         table.remarks = "Generated table " + std::to_string(i);
         
         // Add columns
-        for (int j = 1; j <= 20; ++j) {
+        table.columns.reserve(static_cast<size_t>(columns));
+        for (int j = 1; j <= columns; ++j) {
             MockColumn col;
             col.name = "COLUMN_" + std::to_string(j);
             col.data_type = (j % 3 == 0) ? SQL_INTEGER : SQL_VARCHAR;
@@ -182,51 +206,472 @@ void MockCatalog::create_large_catalog() {
             col.nullable = (j == 1) ? SQL_NO_NULLS : SQL_NULLABLE;
             col.is_primary_key = (j == 1);
             col.is_auto_increment = (j == 1);
-            table.columns.push_back(col);
+            table.columns.push_back(std::move(col));
         }
         
-        tables_.push_back(table);
+        tables_.push_back(std::move(table));
+    }
+}
+
+void MockCatalog::index_tables() {
+    table_positions_.clear();
+    table_positions_.reserve(tables_.size());
+    for (size_t i = 0; i < tables_.size(); ++i) {
+        // The first of two same-named tables wins, as it did for a scan
+        table_positions_.emplace(to_upper(tables_[i].name), i);
     }
 }
 
 const MockTable* MockCatalog::find_table(const std::string& name) const {
-    std::string upper_name = to_upper(name);
-    for (const auto& table : tables_) {
-        if (to_upper(table.name) == upper_name) {
-            return &table;
-        }
+    auto it = table_positions_.find(to_upper(name));
+    return it != table_positions_.end() ? &tables_[it->second] : nullptr;
+}
+
+bool MockCatalog::attach_data_file(const std::string& path, std::shared_ptr<DataFile> previous,
+                                   std::string& error) {
+    // initialize() runs again when all connections closed; reconnecting to
+    // the same file doesn't rescan it
+    auto file = std::move(previous);
+    if (!file || file->path() != path || !file->matches_disk()) {
+        file.reset();
+        file = DataFile::open(path, error);
+        if (!file) return false;
     }
-    return nullptr;
+    data_file_ = file;
+    
+    // File tables replace preset tables of the same name
+    for (auto& table : data_file_->tables()) {
+        tables_.erase(
+            std::remove_if(tables_.begin(), tables_.end(),
+                           [&table](const MockTable& t) { return to_upper(t.name) == table.name; }),
+            tables_.end());
+        tables_.push_back(std::move(table));
+    }
+    index_tables();
+    return true;
+}
+
+std::shared_ptr<const TableSnapshot> MockCatalog::scan_table(const std::string& name) const {
+    if (!data_file_) return nullptr;
+    return data_file_->snapshot(to_upper(name));
 }
 
-void MockCatalog::add_table(const MockTable& table) {
+bool MockCatalog::add_table(const MockTable& table) {
+    // With a data file attached, CREATE TABLE makes a file-backed table
+    if (data_file_ && !data_file_->create_table(table)) {
+        return false;
+    }
+    table_positions_.emplace(to_upper(table.name), tables_.size());
     tables_.push_back(table);
+    return true;
 }
 
-void MockCatalog::remove_table(const std::string& name) {
+bool MockCatalog::remove_table(const std::string& name) {
     std::string upper_name = to_upper(name);
+    if (data_file_ && data_file_->has_table(upper_name) && !data_file_->drop_table(upper_name)) {
+        return false;
+    }
     tables_.erase(
         std::remove_if(tables_.begin(), tables_.end(),
                        [&upper_name](const MockTable& t) { return to_upper(t.name) == upper_name; }),
         tables_.end());
+    index_tables();
     // Also remove inserted data and indexes for this table
     inserted_data_.erase(upper_name);
+    row_indexes_.erase(upper_name);
+    table_versions_.erase(upper_name);
     indexes_.erase(
         std::remove_if(indexes_.begin(), indexes_.end(),
                        [&upper_name](const MockIndex& idx) { return to_upper(idx.table_name) == upper_name; }),
         indexes_.end());
+    return true;
+}
+
+bool MockCatalog::read_rows(const std::string& table_name, Transaction* txn, RowSource& source,
+                            std::shared_ptr<const TableSnapshot>& scan, bool& current) {
+    std::string upper_name = to_upper(table_name);
+    current = true;
+    if (txn) {
+        begin(*txn);
+        auto writes = txn->writes.find(upper_name);
+        if (writes != txn->writes.end()) {
+            if (!writes->second.has_view) build_view(*txn, upper_name, writes->second);
+            source.rows = &writes->second.view_rows;
+            current = false;
+            return true;
+        }
+        auto version = table_versions_.find(upper_name);
+        current = txn->snapshot_version >= initialized_version_ &&
+                  (version == table_versions_.end() || version->second <= txn->snapshot_version);
+        auto file = txn->pinned_files.find(upper_name);
+        if (file != txn->pinned_files.end()) {
+            scan = file->second;
+            source.snapshot = scan.get();
+            return true;
+        }
+        auto rows = txn->pinned_rows.find(upper_name);
+        if (rows != txn->pinned_rows.end()) {
+            source.rows = &rows->second->rows;
+            return true;
+        }
+        return false;
+    }
+    
+    scan = scan_table(upper_name);
+    if (scan) {
+        source.snapshot = scan.get();
+        return true;
+    }
+    auto it = inserted_data_.find(upper_name);
+    if (it == inserted_data_.end()) return false;
+    source.rows = &it->second->rows;
+    return true;
 }
 
-void MockCatalog::insert_row(const std::string& table_name, MockRow row) {
-    inserted_data_[to_upper(table_name)].push_back(std::move(row));
+bool MockCatalog::is_file_table(const std::string& upper_name) const {
+    return data_file_ && data_file_->has_table(upper_name);
 }
 
-void MockCatalog::clear_inserted_data() {
-    inserted_data_.clear();
+StoredRows& MockCatalog::writable_rows(const std::string& upper_name) {
+    auto& data = inserted_data_[upper_name];
+    if (!data) {
+        data = std::make_shared<StoredRows>();
+    } else if (data.use_count() > 1) {
+        data = std::make_shared<StoredRows>(*data);
+    }
+    return *data;
+}
+
+void MockCatalog::begin(Transaction& txn) {
+    if (txn.active) return;
+    txn.active = true;
+    txn.snapshot_version = commit_version_;
+    for (const auto& entry : inserted_data_) {
+        txn.pinned_rows.emplace(entry.first, entry.second);
+    }
+    if (data_file_) {
+        for (const auto& name : data_file_->table_names()) {
+            if (auto snapshot = data_file_->snapshot(name)) {
+                txn.pinned_files.emplace(name, std::move(snapshot));
+            }
+        }
+    }
+}
+
+Transaction::TableWrites& MockCatalog::table_writes(Transaction& txn, const std::string& upper_name) {
+    begin(txn);
+    return txn.writes[upper_name];
 }
 
-void MockCatalog::clear_inserted_data(const std::string& table_name) {
-    inserted_data_.erase(to_upper(table_name));
+uint64_t MockCatalog::row_id(const Transaction& txn, const std::string& upper_name,
+                             const Transaction::TableWrites& writes, uint32_t row) const {
+    if (writes.has_view) return writes.view_ids[row];
+    // No view: the statement read the snapshot, because the table had no
+    // writes yet
+    auto file = txn.pinned_files.find(upper_name);
+    if (file != txn.pinned_files.end()) return file->second->physical_row(row);
+    return txn.pinned_rows.at(upper_name)->ids[row];
+}
+
+void MockCatalog::build_view(const Transaction& txn, const std::string& upper_name,
+                             Transaction::TableWrites& writes) const {
+    auto add = [&writes](uint64_t id, const MockRow* row) {
+        auto changed = writes.changed.find(id);
+        if (changed != writes.changed.end()) {
+            if (!changed->second) return;
+            row = &*changed->second;
+        }
+        writes.view_rows.push_back(*row);
+        writes.view_ids.push_back(id);
+    };
+    auto file = txn.pinned_files.find(upper_name);
+    auto rows = txn.pinned_rows.find(upper_name);
+    if (file != txn.pinned_files.end()) {
+        const TableSnapshot& snapshot = *file->second;
+        MockRow row;
+        for (size_t r = 0; r < snapshot.row_count(); ++r) {
+            row.clear();
+            snapshot.read_row(r, {}, row);
+            add(snapshot.physical_row(r), &row);
+        }
+    } else if (rows != txn.pinned_rows.end()) {
+        for (size_t r = 0; r < rows->second->rows.size(); ++r) {
+            add(rows->second->ids[r], &rows->second->rows[r]);
+        }
+    }
+    for (const auto& [id, row] : writes.inserted) {
+        writes.view_rows.push_back(row);
+        writes.view_ids.push_back(id);
+    }
+    writes.has_view = true;
+}
+
+bool MockCatalog::insert_row(const std::string& table_name, MockRow row, Transaction* txn) {
+    std::vector<MockRow> rows;
+    rows.push_back(std::move(row));
+    return insert_rows(table_name, std::move(rows), txn);
+}
+
+bool MockCatalog::insert_rows(const std::string& table_name, std::vector<MockRow> rows,
+                              Transaction* txn) {
+    std::string upper_name = to_upper(table_name);
+    if (txn) {
+        auto& writes = table_writes(*txn, upper_name);
+        for (auto& row : rows) {
+            uint64_t id = writes.next_new_row++;
+            if (writes.has_view) {
+                writes.view_rows.push_back(row);
+                writes.view_ids.push_back(id);
+            }
+            writes.inserted.emplace_hint(writes.inserted.end(), id, std::move(row));
+        }
+        return true;
+    }
+    
+    uint64_t version = ++commit_version_;
+    table_versions_[upper_name] = version;
+    if (is_file_table(upper_name)) {
+        return data_file_->append_rows(upper_name, rows);
+    }
+    auto& data = writable_rows(upper_name);
+    for (size_t i = 0; i < rows.size(); ++i) data.ids.push_back(++next_row_id_);
+    data.versions.resize(data.versions.size() + rows.size(), version);
+    if (data.rows.empty()) {
+        data.rows = std::move(rows);
+        return true;
+    }
+    data.rows.reserve(data.rows.size() + rows.size());
+    std::move(rows.begin(), rows.end(), std::back_inserter(data.rows));
+    return true;
+}
+
+bool MockCatalog::update_rows(const std::string& table_name, const std::vector<uint32_t>& rows,
+                              std::vector<MockRow> values, const std::vector<size_t>& changed_columns,
+                              Transaction* txn) {
+    std::string upper_name = to_upper(table_name);
+    if (rows.empty()) return true;
+    if (txn) {
+        auto& writes = table_writes(*txn, upper_name);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            uint64_t id = row_id(*txn, upper_name, writes, rows[i]);
+            if (writes.has_view) writes.view_rows[rows[i]] = values[i];
+            if (id >= Transaction::kFirstNewRow) {
+                writes.inserted[id] = std::move(values[i]);
+            } else {
+                writes.changed[id] = std::move(values[i]);
+            }
+        }
+        return true;
+    }
+    
+    uint64_t version = ++commit_version_;
+    table_versions_[upper_name] = version;
+    if (is_file_table(upper_name)) {
+        if (!data_file_->delete_rows(upper_name, rows, values)) return false;
+        reset_row_indexes(upper_name);
+        return true;
+    }
+    
+    auto& data = writable_rows(upper_name);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        move_index_keys(upper_name, rows[i], data.rows[rows[i]], values[i], &changed_columns);
+        data.rows[rows[i]] = std::move(values[i]);
+        data.versions[rows[i]] = version;
+    }
+    return true;
+}
+
+namespace {
+
+// Remove `rows` (ascending) from each vector in one pass
+template <typename... Vectors>
+void erase_rows(const std::vector<uint32_t>& rows, Vectors&... vectors) {
+    size_t size = std::get<0>(std::tie(vectors...)).size();
+    size_t out = 0;
+    auto next = rows.begin();
+    for (size_t r = 0; r < size; ++r) {
+        if (next != rows.end() && *next == r) {
+            ++next;
+            continue;
+        }
+        if (out != r) ((vectors[out] = std::move(vectors[r])), ...);
+        ++out;
+    }
+    (vectors.resize(out), ...);
+}
+
+} // anonymous namespace
+
+bool MockCatalog::delete_rows(const std::string& table_name, const std::vector<uint32_t>& rows,
+                              Transaction* txn) {
+    std::string upper_name = to_upper(table_name);
+    if (rows.empty()) return true;
+    if (txn) {
+        auto& writes = table_writes(*txn, upper_name);
+        for (uint32_t r : rows) {
+            uint64_t id = row_id(*txn, upper_name, writes, r);
+            if (id >= Transaction::kFirstNewRow) {
+                writes.inserted.erase(id);
+            } else {
+                writes.changed[id] = std::nullopt;
+            }
+        }
+        if (writes.has_view) erase_rows(rows, writes.view_rows, writes.view_ids);
+        return true;
+    }
+    
+    table_versions_[upper_name] = ++commit_version_;
+    if (is_file_table(upper_name)) {
+        if (!data_file_->delete_rows(upper_name, rows)) return false;
+        reset_row_indexes(upper_name);
+        return true;
+    }
+    
+    // The table stays stored even when emptied, so a preset table doesn't
+    // fall back to generated rows
+    auto& data = writable_rows(upper_name);
+    erase_rows(rows, data.rows, data.ids, data.versions);
+    reset_row_indexes(upper_name);
+    return true;
+}
+
+bool MockCatalog::commit(Transaction& txn, std::string& sqlstate, std::string& message) {
+    if (txn.writes.empty()) {
+        rollback(txn);
+        return true;
+    }
+    
+    // Check every table before writing any, so the commit applies whole
+    // or not at all
+    bool conflict = txn.snapshot_version < initialized_version_;
+    for (const auto& [upper_name, writes] : txn.writes) {
+        if (conflict) break;
+        conflict = conflicts(txn, upper_name, writes);
+    }
+    if (conflict) {
+        rollback(txn);
+        sqlstate = "40001";
+        message = "Serialization failure: a row this transaction changed was changed "
+                  "by another transaction that committed first";
+        return false;
+    }
+    
+    uint64_t version = ++commit_version_;
+    bool written = true;
+    for (auto& [upper_name, writes] : txn.writes) {
+        // A table dropped since takes the transaction's rows with it
+        if (!find_table(upper_name)) continue;
+        table_versions_[upper_name] = version;
+        written = publish(upper_name, writes, version) && written;
+    }
+    rollback(txn);
+    if (!written) {
+        sqlstate = "HY000";
+        message = "Could not write to the data file";
+    }
+    return written;
+}
+
+void MockCatalog::rollback(Transaction& txn) {
+    txn = Transaction();
+}
+
+bool MockCatalog::conflicts(const Transaction& txn, const std::string& upper_name,
+                            const Transaction::TableWrites& writes) const {
+    if (writes.changed.empty() || !find_table(upper_name)) return false;
+    if (is_file_table(upper_name)) {
+        // A file row changes only by being deleted (an UPDATE appends a new one)
+        auto snapshot = data_file_->snapshot(upper_name);
+        size_t row = 0;
+        for (const auto& entry : writes.changed) {
+            if (!snapshot || !snapshot->find_row(entry.first, row)) return true;
+        }
+        return false;
+    }
+    auto it = inserted_data_.find(upper_name);
+    if (it == inserted_data_.end()) return true;
+    const StoredRows& data = *it->second;
+    for (const auto& entry : writes.changed) {
+        uint64_t id = entry.first;
+        auto pos = std::lower_bound(data.ids.begin(), data.ids.end(), id);
+        if (pos == data.ids.end() || *pos != id ||
+            data.versions[pos - data.ids.begin()] > txn.snapshot_version) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool MockCatalog::publish(const std::string& upper_name, Transaction::TableWrites& writes,
+                          uint64_t version) {
+    // Only the rows the transaction changed or inserted are touched;
+    // `changed` is ordered by id, and so by row
+    if (is_file_table(upper_name)) {
+        auto snapshot = data_file_->snapshot(upper_name);
+        std::vector<uint32_t> rows;
+        std::vector<MockRow> replacements;
+        size_t row = 0;
+        for (auto& [id, value] : writes.changed) {
+            if (snapshot && snapshot->find_row(id, row)) rows.push_back(static_cast<uint32_t>(row));
+            if (value) replacements.push_back(std::move(*value));
+        }
+        for (auto& entry : writes.inserted) replacements.push_back(std::move(entry.second));
+        if (rows.empty()) {
+            return replacements.empty() || data_file_->append_rows(upper_name, replacements);
+        }
+        if (!data_file_->delete_rows(upper_name, rows, replacements)) return false;
+        reset_row_indexes(upper_name);
+        return true;
+    }
+    
+    auto& data = writable_rows(upper_name);
+    std::vector<uint32_t> deleted;
+    for (auto& [id, value] : writes.changed) {
+        auto row = static_cast<uint32_t>(std::lower_bound(data.ids.begin(), data.ids.end(), id) -
+                                         data.ids.begin());
+        if (!value) {
+            deleted.push_back(row);
+            continue;
+        }
+        move_index_keys(upper_name, row, data.rows[row], *value, nullptr);
+        data.rows[row] = std::move(*value);
+        data.versions[row] = version;
+    }
+    if (!deleted.empty()) {
+        erase_rows(deleted, data.rows, data.ids, data.versions);
+        reset_row_indexes(upper_name);
+    }
+    for (auto& entry : writes.inserted) {
+        data.rows.push_back(std::move(entry.second));
+        data.ids.push_back(++next_row_id_);
+        data.versions.push_back(version);
+    }
+    return true;
+}
+
+void MockCatalog::move_index_keys(const std::string& upper_name, uint32_t row, const MockRow& old_row,
+                                  const MockRow& new_row, const std::vector<size_t>* changed_columns) {
+    auto indexes = row_indexes_.find(upper_name);
+    if (indexes == row_indexes_.end()) return;
+    static const CellValue none;
+    for (auto& index : indexes->second) {
+        size_t column = index->column();
+        if (changed_columns &&
+            std::find(changed_columns->begin(), changed_columns->end(), column) == changed_columns->end()) {
+            continue;
+        }
+        const CellValue& old_key = column < old_row.size() ? old_row[column] : none;
+        const CellValue& new_key = column < new_row.size() ? new_row[column] : none;
+        if (!changed_columns && old_key == new_key) continue;
+        index->update_row(row, old_key, new_key);
+    }
+}
+
+void MockCatalog::reset_row_indexes(const std::string& upper_name) {
+    auto it = row_indexes_.find(upper_name);
+    if (it != row_indexes_.end()) {
+        for (auto& index : it->second) index->reset();
+    }
 }
 
 std::vector<MockColumn> MockCatalog::get_columns(const std::string& table_name,
@@ -235,8 +680,9 @@ std::vector<MockColumn> MockCatalog::get_columns(const std::string& table_name,
     const MockTable* table = find_table(table_name);
     if (!table) return result;
     
+    LikePattern pattern(column_pattern);
     for (const auto& col : table->columns) {
-        if (matches_pattern(col.name, column_pattern)) {
+        if (pattern.matches(col.name)) {
             result.push_back(col);
         }
     }
@@ -290,47 +736,82 @@ std::vector<MockIndex> MockCatalog::get_statistics(const std::string& table_name
     return result;
 }
 
-bool MockCatalog::matches_pattern(const std::string& value, const std::string& pattern) {
-    if (pattern.empty() || pattern == "%") return true;
-    
-    std::string upper_value = to_upper(value);
-    std::string upper_pattern = to_upper(pattern);
-    
-    // Simple pattern matching with % and _
-    size_t v = 0, p = 0;
-    size_t vlen = upper_value.length();
-    size_t plen = upper_pattern.length();
-    
-    while (v < vlen && p < plen) {
-        if (upper_pattern[p] == '%') {
-            // Skip consecutive %
-            while (p < plen && upper_pattern[p] == '%') ++p;
-            if (p >= plen) return true;  // Trailing %
-            
-            // Find next match
-            while (v < vlen) {
-                if (matches_pattern(upper_value.substr(v), upper_pattern.substr(p))) {
-                    return true;
-                }
-                ++v;
-            }
-            return false;
-        } else if (upper_pattern[p] == '_') {
-            // Match single character
-            ++v;
-            ++p;
-        } else if (upper_pattern[p] == upper_value[v]) {
-            ++v;
-            ++p;
-        } else {
-            return false;
+bool MockCatalog::create_index(const MockIndex& index, bool hash) {
+    std::string upper_index = to_upper(index.index_name);
+    for (const auto& existing : indexes_) {
+        if (to_upper(existing.index_name) == upper_index) return false;
+    }
+    const MockTable* table = find_table(index.table_name);
+    if (!table || index.columns.empty()) return false;
+    
+    size_t column = table->columns.size();
+    for (size_t i = 0; i < table->columns.size(); ++i) {
+        if (to_upper(table->columns[i].name) == to_upper(index.columns.front())) {
+            column = i;
+            break;
         }
     }
+    if (column == table->columns.size()) return false;
     
-    // Handle trailing %
-    while (p < plen && upper_pattern[p] == '%') ++p;
+    indexes_.push_back(index);
+    row_indexes_[to_upper(index.table_name)].push_back(std::make_shared<TableIndex>(
+        upper_index, column, hash ? TableIndex::Kind::Hash : TableIndex::Kind::Sorted));
+    return true;
+}
+
+bool MockCatalog::drop_index(const std::string& index_name) {
+    std::string upper_index = to_upper(index_name);
+    auto it = std::find_if(indexes_.begin(), indexes_.end(), [&upper_index](const MockIndex& idx) {
+        return to_upper(idx.index_name) == upper_index;
+    });
+    if (it == indexes_.end()) return false;
+    
+    auto rows = row_indexes_.find(to_upper(it->table_name));
+    if (rows != row_indexes_.end()) {
+        auto& list = rows->second;
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [&upper_index](const std::shared_ptr<TableIndex>& idx) {
+                                      return idx->name() == upper_index;
+                                  }),
+                   list.end());
+    }
+    indexes_.erase(it);
+    return true;
+}
+
+TableIndex* MockCatalog::row_index(const std::string& table_name, size_t column, bool need_range,
+                                   const RowSource& source) {
+    std::string upper_name = to_upper(table_name);
+    const MockTable* table = find_table(upper_name);
+    if (!table || column >= table->columns.size()) return nullptr;
+    
+    auto& indexes = row_indexes_[upper_name];
+    TableIndex* found = nullptr;
+    for (auto& index : indexes) {
+        if (index->column() != column) continue;
+        if (index->kind() == TableIndex::Kind::Sorted) {
+            found = index.get();
+        } else if (!need_range) {
+            found = index.get();
+            break;   // Hash is the better choice for equality
+        }
+    }
+    
+    if (!found && !need_range) {
+        size_t key_columns = std::count_if(table->columns.begin(), table->columns.end(),
+                                           [](const MockColumn& c) { return c.is_primary_key; });
+        if (key_columns == 1 && table->columns[column].is_primary_key) {
+            indexes.push_back(std::make_shared<TableIndex>("PRIMARY KEY", column, TableIndex::Kind::Hash));
+            found = indexes.back().get();
+        }
+    }
     
-    return v == vlen && p == plen;
+    if (found) found->catch_up(source);
+    return found;
+}
+
+bool MockCatalog::matches_pattern(const std::string& value, const std::string& pattern) {
+    return LikePattern(pattern).matches(value);
 }
 
 } // namespace mock_odbc
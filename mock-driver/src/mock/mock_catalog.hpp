@@ -1,6 +1,11 @@
 #pragma once
 
 #include "../driver/common.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 #include <variant>
@@ -12,6 +17,11 @@ namespace mock_odbc {
 using CellValue = std::variant<std::monostate, long long, double, std::string>;
 using MockRow = std::vector<CellValue>;
 
+class DataFile;
+class TableSnapshot;
+class TableIndex;
+struct RowSource;
+
 // Column definition for mock catalog
 struct MockColumn {
     std::string name;
@@ -46,28 +56,112 @@ struct MockIndex {
     std::vector<std::string> columns;
 };
 
+// Rows of a table held in memory. Every row has an id, ascending in row
+// order and kept through UPDATEs, and the commit version that last wrote
+// it, which a committing transaction checks for rows another transaction
+// changed since its snapshot.
+struct StoredRows {
+    std::vector<MockRow> rows;
+    std::vector<uint64_t> ids;
+    std::vector<uint64_t> versions;
+};
+
+// A connection's transaction while autocommit is off. It begins at the
+// first statement, reads the stored tables as they were then, and records
+// what it changes in each table it writes. MockCatalog::commit() publishes
+// the changes; rollback drops them.
+struct Transaction {
+    static constexpr uint64_t kFirstNewRow = uint64_t(1) << 63;   // Ids from here on are inserted rows
+
+    // What this transaction wrote to a table. Snapshot rows are keyed by
+    // their id (row id in memory, physical row in the data file); inserted
+    // rows get ids from kFirstNewRow up, in insert order.
+    struct TableWrites {
+        std::map<uint64_t, std::optional<MockRow>> changed;   // New row, or nullopt when deleted
+        std::map<uint64_t, MockRow> inserted;
+        uint64_t next_new_row = kFirstNewRow;
+        
+        // The table as the transaction sees it, built by the first read
+        // after a write and kept up to date by later writes
+        bool has_view = false;
+        std::vector<MockRow> view_rows;
+        std::vector<uint64_t> view_ids;
+    };
+
+    bool active = false;
+    uint64_t snapshot_version = 0;
+    std::unordered_map<std::string, std::shared_ptr<const StoredRows>> pinned_rows;
+    std::unordered_map<std::string, std::shared_ptr<const TableSnapshot>> pinned_files;
+    std::unordered_map<std::string, TableWrites> writes;   // By upper-case table name
+};
+
 // The mock catalog
 class MockCatalog {
 public:
     static MockCatalog& instance();
     
-    // Initialize catalog based on preset
-    void initialize(const std::string& preset);
+    // Initialize catalog based on preset. The Large preset adds
+    // `large_tables` generated tables of `large_columns` columns each.
+    // A non-empty `data_file` (DataFile= connection key) keeps user tables
+    // in that file and adds the tables already in it; the file is reused
+    // when the previous initialize() attached the same unchanged file.
+    // Returns false and sets `error` when the file can't be used.
+    bool initialize(const std::string& preset, int large_tables = 100, int large_columns = 20,
+                    const std::string& data_file = "", std::string* error = nullptr);
+    
+    // Rows of a table kept in the attached data file; nullptr for tables
+    // held in memory
+    std::shared_ptr<const TableSnapshot> scan_table(const std::string& name) const;
+    
+    // Stored rows of a table as `txn` sees them: its own copy once it wrote
+    // the table, else the rows of its snapshot. Without a transaction, the
+    // latest committed rows. Sets `source` (and `scan` for the data file);
+    // false when the table has no stored rows. `current` is set when they
+    // are the latest committed rows, which the table's row indexes cover.
+    bool read_rows(const std::string& table_name, Transaction* txn, RowSource& source,
+                   std::shared_ptr<const TableSnapshot>& scan, bool& current);
+    
+    // Statements and commits from all connections run one at a time under
+    // this mutex (execute_query() and the batched INSERT paths take it)
+    std::mutex& mutex() { return mutex_; }
     
-    // Table operations
+    // Publish the writes of `txn` as one commit and end it. When another
+    // transaction committed a change to a row `txn` updated or deleted after
+    // its snapshot, nothing is written and the SQLSTATE is 40001 (the first
+    // committer wins). The writes are dropped either way.
+    bool commit(Transaction& txn, std::string& sqlstate, std::string& message);
+    void rollback(Transaction& txn);
+    
+    // Table operations. find_table is a hash lookup by upper-case name.
     const std::vector<MockTable>& tables() const { return tables_; }
     const MockTable* find_table(const std::string& name) const;
     
-    // Mutable catalog operations (for CREATE TABLE / DROP TABLE)
-    void add_table(const MockTable& table);
-    void remove_table(const std::string& name);
+    // Mutable catalog operations (for CREATE TABLE / DROP TABLE). They
+    // return false when the change can't be written to the data file, and
+    // then leave the catalog as it was.
+    bool add_table(const MockTable& table);
+    bool remove_table(const std::string& name);
+    
+    // Mutable data operations (for INSERT). Without a transaction each call
+    // is a commit of its own: rows of a file-backed table are written to the
+    // data file (false when that fails), others are kept in memory. With
+    // one, the rows go to the transaction's copy of the table.
+    bool insert_row(const std::string& table_name, MockRow row, Transaction* txn = nullptr);
+    bool insert_rows(const std::string& table_name, std::vector<MockRow> rows,
+                     Transaction* txn = nullptr);
     
-    // Mutable data operations (for INSERT / transaction support)
-    void insert_row(const std::string& table_name, MockRow row);
-    void clear_inserted_data();
-    void clear_inserted_data(const std::string& table_name);
-    std::unordered_map<std::string, std::vector<MockRow>>& inserted_data() { return inserted_data_; }
-    const std::unordered_map<std::string, std::vector<MockRow>>& inserted_data() const { return inserted_data_; }
+    // UPDATE / DELETE of stored rows. `rows` are ascending row numbers of the
+    // rows read_rows() gave for the same transaction. Rows in memory are
+    // updated in place and deleted by compacting the vector; a file-backed
+    // table gets one delete record carrying any updated rows, which then move
+    // to the end. `values` holds the new full row for each entry of `rows`,
+    // and `changed_columns` the columns the UPDATE assigned.
+    bool update_rows(const std::string& table_name, const std::vector<uint32_t>& rows,
+                     std::vector<MockRow> values, const std::vector<size_t>& changed_columns,
+                     Transaction* txn = nullptr);
+    bool delete_rows(const std::string& table_name, const std::vector<uint32_t>& rows,
+                     Transaction* txn = nullptr);
+
     
     // Column operations
     std::vector<MockColumn> get_columns(const std::string& table_name,
@@ -83,18 +177,68 @@ public:
     // Index operations
     std::vector<MockIndex> get_statistics(const std::string& table_name) const;
     
-    // Pattern matching (SQL LIKE)
+    // CREATE INDEX: report `index` in SQLStatistics and keep a row index on
+    // its first column (hashed, or sorted to also answer ranges). False when
+    // an index of that name already exists.
+    bool create_index(const MockIndex& index, bool hash);
+    bool drop_index(const std::string& index_name);
+    
+    // Row index on `column` of a stored table, brought up to date with
+    // `source` (the table's inserted rows or data-file snapshot); nullptr
+    // when there is none. With `need_range` only a sorted index qualifies.
+    // A single-column primary key gets a hash index on first use.
+    TableIndex* row_index(const std::string& table_name, size_t column, bool need_range,
+                          const RowSource& source);
+    
+    // Pattern matching (SQL LIKE). Catalog functions compile their pattern
+    // arguments once with LikePattern instead.
     static bool matches_pattern(const std::string& value, const std::string& pattern);
     
 private:
+    // Add the tables of the data file at `path`, reusing `previous` when it
+    // is that file and unchanged on disk
+    bool attach_data_file(const std::string& path, std::shared_ptr<DataFile> previous,
+                          std::string& error);
+    
     MockCatalog() = default;
     void create_default_catalog();
     void create_empty_catalog();
-    void create_large_catalog();
+    void create_large_catalog(int tables, int columns);
+    void index_tables();    // Rebuild table_positions_ after tables_ changed
+    void reset_row_indexes(const std::string& upper_name);
+    void move_index_keys(const std::string& upper_name, uint32_t row, const MockRow& old_row,
+                         const MockRow& new_row, const std::vector<size_t>* changed_columns);
+    bool is_file_table(const std::string& upper_name) const;
+    
+    // Rows of a table held in memory, copied first when a transaction's
+    // snapshot still reads them
+    StoredRows& writable_rows(const std::string& upper_name);
+    
+    void begin(Transaction& txn);
+    // The writes of `txn` to a table, and the id of row `row` of what the
+    // statement read from it (the view once there are writes, else the
+    // snapshot)
+    Transaction::TableWrites& table_writes(Transaction& txn, const std::string& upper_name);
+    uint64_t row_id(const Transaction& txn, const std::string& upper_name,
+                    const Transaction::TableWrites& writes, uint32_t row) const;
+    void build_view(const Transaction& txn, const std::string& upper_name,
+                    Transaction::TableWrites& writes) const;
+    bool conflicts(const Transaction& txn, const std::string& upper_name,
+                   const Transaction::TableWrites& writes) const;
+    bool publish(const std::string& upper_name, Transaction::TableWrites& writes, uint64_t version);
     
     std::vector<MockTable> tables_;
+    std::unordered_map<std::string, size_t> table_positions_;   // Upper-case name -> index in tables_
     std::vector<MockIndex> indexes_;
-    std::unordered_map<std::string, std::vector<MockRow>> inserted_data_;
+    std::unordered_map<std::string, std::shared_ptr<StoredRows>> inserted_data_;
+    std::unordered_map<std::string, std::vector<std::shared_ptr<TableIndex>>> row_indexes_;   // By upper-case table name
+    std::shared_ptr<DataFile> data_file_;   // Attached by initialize(); released by the next one
+    
+    std::mutex mutex_;
+    uint64_t commit_version_ = 0;       // Last commit; autocommit statements count as commits
+    uint64_t initialized_version_ = 0;  // commit_version_ when initialize() last ran
+    uint64_t next_row_id_ = 0;
+    std::unordered_map<std::string, uint64_t> table_versions_;   // Last commit that wrote each table
 };
 
 } // namespace mock_odbc
@@ -1,6 +1,15 @@
 #include "mock_data.hpp"
+#include "data_file.hpp"
+#include "data_generator.hpp"
+#include "predicate.hpp"
+#include "row_order.hpp"
+#include "table_index.hpp"
 #include <algorithm>
 #include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <numeric>
 #include <sstream>
 #include <regex>
 #include <cmath>
@@ -68,6 +77,44 @@ int count_param_markers(const std::string& sql) {
     return count;
 }
 
+// Position of `word` (upper case) in `upper` at or after `from`, outside
+// quotes and parentheses and on word boundaries; npos when absent
+size_t find_clause(const std::string& upper, const std::string& word, size_t from) {
+    int depth = 0;
+    bool in_single_quote = false;
+    bool in_double_quote = false;
+    for (size_t i = from; i < upper.length(); ++i) {
+        char c = upper[i];
+        if (c == '\'' && !in_double_quote) {
+            in_single_quote = !in_single_quote;
+        } else if (c == '"' && !in_single_quote) {
+            in_double_quote = !in_double_quote;
+        } else if (in_single_quote || in_double_quote) {
+            continue;
+        } else if (c == '(') {
+            ++depth;
+        } else if (c == ')') {
+            --depth;
+        } else if (depth == 0 && upper.compare(i, word.length(), word) == 0 &&
+                   (i == 0 || std::isspace(static_cast<unsigned char>(upper[i - 1]))) &&
+                   (i + word.length() == upper.length() ||
+                    std::isspace(static_cast<unsigned char>(upper[i + word.length()])))) {
+            return i;
+        }
+    }
+    return std::string::npos;
+}
+
+// Drop a trailing ';' and surrounding whitespace
+std::string strip_statement_end(const std::string& s) {
+    std::string result = trim(s);
+    while (!result.empty() && result.back() == ';') {
+        result.pop_back();
+        result = trim(result);
+    }
+    return result;
+}
+
 // Parse a SQL type name to SQL type constant
 SQLSMALLINT parse_sql_type(const std::string& type_str, SQLULEN& column_size, SQLSMALLINT& decimal_digits) {
     std::string upper = to_upper(trim(type_str));
@@ -151,6 +198,209 @@ std::vector<std::string> split_expressions(const std::string& str) {
     return result;
 }
 
+// Split a clause into words at whitespace, with ',' a word of its own.
+// A quoted name ("...", [...] or `...`) stays one word.
+std::vector<std::string> clause_words(const std::string& clause) {
+    std::vector<std::string> words;
+    size_t i = 0;
+    while (i < clause.size()) {
+        char c = clause[i];
+        if (std::isspace(static_cast<unsigned char>(c))) {
+            ++i;
+            continue;
+        }
+        size_t start = i;
+        if (c == ',') {
+            ++i;
+        } else if (c == '"' || c == '[' || c == '`') {
+            char close = c == '[' ? ']' : c;
+            size_t end = clause.find(close, i + 1);
+            i = end == std::string::npos ? clause.size() : end + 1;
+        } else {
+            while (i < clause.size() && clause[i] != ',' &&
+                   !std::isspace(static_cast<unsigned char>(clause[i]))) {
+                ++i;
+            }
+        }
+        words.push_back(clause.substr(start, i - start));
+    }
+    return words;
+}
+
+// A row count of 1 to 18 digits
+bool parse_count(const std::string& word, long long& value) {
+    if (word.empty() || word.size() > 18) return false;
+    for (char c : word) {
+        if (!std::isdigit(static_cast<unsigned char>(c))) return false;
+    }
+    value = std::stoll(word);
+    return true;
+}
+
+bool is_name_char(char c) {
+    return std::isalnum(static_cast<unsigned char>(c)) || c == '_' || c == '$';
+}
+
+// [qualifier.]name, each part a letter or '_' followed by letters, digits,
+// '_' or '$'; `name` receives the part after the dot
+bool parse_column_name(const std::string& text, std::string& name) {
+    size_t dot = text.find('.');
+    size_t start = dot == std::string::npos ? 0 : dot + 1;
+    auto valid = [&](size_t from, size_t to) {
+        if (from >= to || std::isdigit(static_cast<unsigned char>(text[from])) || text[from] == '$') {
+            return false;
+        }
+        return std::all_of(text.begin() + from, text.begin() + to, is_name_char);
+    };
+    if (dot != std::string::npos && !valid(0, dot)) return false;
+    if (!valid(start, text.size())) return false;
+    name = text.substr(start);
+    return true;
+}
+
+// Remove a leading TOP n or TOP (n) from a SELECT's column list and store
+// n in `limit`; leaves `cols` alone when it doesn't start with one
+void strip_top(std::string& cols, long long& limit) {
+    if (cols.size() < 3 || to_upper(cols.substr(0, 3)) != "TOP") return;
+    size_t i = 3;
+    auto skip_space = [&]() {
+        size_t from = i;
+        while (i < cols.size() && std::isspace(static_cast<unsigned char>(cols[i]))) ++i;
+        return i > from;
+    };
+    auto digits = [&]() {
+        size_t from = i;
+        while (i < cols.size() && std::isdigit(static_cast<unsigned char>(cols[i]))) ++i;
+        return cols.substr(from, i - from);
+    };
+    skip_space();
+    bool parens = i < cols.size() && cols[i] == '(';
+    if (parens) {
+        ++i;
+        skip_space();
+    }
+    long long value = 0;
+    if (!parse_count(digits(), value)) return;
+    if (parens) {
+        skip_space();
+        if (i >= cols.size() || cols[i] != ')') return;
+        ++i;
+    }
+    if (!skip_space()) return;
+    limit = value;
+    cols = trim(cols.substr(i));
+}
+
+// Parse the items of an ORDER BY clause:
+// <column | position> [ASC | DESC] [NULLS FIRST | NULLS LAST], ...
+bool parse_order_by(const std::string& clause, std::vector<ParsedQuery::OrderItem>& items,
+                    std::string& error) {
+    for (const auto& text : split_expressions(clause)) {
+        auto words = clause_words(text);
+        size_t w = 0;
+        bool valid = !words.empty();
+        ParsedQuery::OrderItem item;
+        if (valid) {
+            std::string name = words[w++];
+            if (name.front() == '"' || name.front() == '[' || name.front() == '`') {
+                char close = name.front() == '[' ? ']' : name.front();
+                valid = name.size() > 2 && name.back() == close;
+                name = valid ? name.substr(1, name.size() - 2) : name;
+            } else {
+                valid = std::all_of(name.begin(), name.end(), [](char c) {
+                    return is_name_char(c) || c == '#' || c == '.';
+                });
+                if (auto dot = name.rfind('.'); dot != std::string::npos) {
+                    name = name.substr(dot + 1);
+                }
+            }
+            item.column = name;
+        }
+        if (valid && w < words.size()) {
+            std::string dir = to_upper(words[w]);
+            if (dir == "ASC" || dir == "DESC") {
+                item.descending = dir == "DESC";
+                ++w;
+            }
+        }
+        item.nulls_first = !item.descending;
+        if (valid && w < words.size()) {
+            std::string where = w + 1 < words.size() ? to_upper(words[w + 1]) : "";
+            valid = to_upper(words[w]) == "NULLS" && (where == "FIRST" || where == "LAST");
+            item.nulls_first = where == "FIRST";
+            w += 2;
+        }
+        if (!valid || w != words.size()) {
+            error = "Unsupported ORDER BY item: " + text;
+            return false;
+        }
+        items.push_back(std::move(item));
+    }
+    if (items.empty()) {
+        error = "ORDER BY without items";
+        return false;
+    }
+    return true;
+}
+
+// Parse the paging clause ending a SELECT: LIMIT n [OFFSET m],
+// LIMIT m, n, or [OFFSET m ROWS] [FETCH FIRST|NEXT [n] ROWS ONLY]
+bool parse_paging(const std::string& clause, long long& limit, long long& offset,
+                  std::string& error) {
+    auto words = clause_words(clause);
+    for (auto& word : words) word = to_upper(word);
+    size_t w = 0;
+    auto next_is = [&](const char* word) {
+        if (w < words.size() && words[w] == word) {
+            ++w;
+            return true;
+        }
+        return false;
+    };
+    auto next_rows = [&]() { return next_is("ROWS") || next_is("ROW"); };
+    auto next_count = [&](long long& value) {
+        if (w < words.size() && parse_count(words[w], value)) {
+            ++w;
+            return true;
+        }
+        return false;
+    };
+    
+    bool valid = !words.empty();
+    long long first = 0;
+    long long second = 0;
+    if (valid && next_is("LIMIT")) {
+        valid = next_count(first);
+        if (valid && next_is("OFFSET")) {
+            valid = next_count(second);
+            offset = second;
+        } else if (valid && next_is(",")) {
+            // LIMIT offset, count
+            valid = next_count(second);
+            offset = first;
+            first = second;
+        }
+        limit = first;
+    } else if (valid) {
+        if (next_is("OFFSET")) {
+            valid = next_count(second) && next_rows();
+            offset = second;
+        }
+        if (valid && next_is("FETCH")) {
+            valid = (next_is("FIRST") || next_is("NEXT"));
+            first = 1;
+            if (valid) next_count(first);
+            valid = valid && next_rows() && next_is("ONLY");
+            limit = first;
+        }
+    }
+    if (!valid || w != words.size()) {
+        error = "Unsupported paging clause: " + clause;
+        return false;
+    }
+    return true;
+}
+
 // Parse a literal value from SQL expression
 ParsedQuery::LiteralExpr parse_literal_expression(const std::string& expr_str) {
     ParsedQuery::LiteralExpr lit;
@@ -335,13 +585,95 @@ InsertValuesResult parse_insert_values(const std::string& values_str) {
     return result;
 }
 
+// Parse one operand of an UPDATE SET value: '?', a column or a literal.
+// `next_param` is the number of the next parameter marker.
+bool parse_set_operand(const std::string& text, ParsedQuery::SetOperand& operand, int& next_param) {
+    std::string upper = to_upper(text);
+    std::string column;
+    if (text == "?") {
+        operand.kind = ParsedQuery::SetOperand::Kind::Param;
+        operand.param = next_param++;
+        return true;
+    }
+    if (upper != "NULL" && parse_column_name(text, column)) {
+        operand.kind = ParsedQuery::SetOperand::Kind::Column;
+        operand.column = to_upper(column);
+        return true;
+    }
+    auto parsed = parse_insert_values(text);
+    if (parsed.values.size() != 1) return false;
+    // Anything parse_insert_values() keeps as raw text is an expression
+    // this parser doesn't evaluate
+    if (std::holds_alternative<std::string>(parsed.values[0]) && text.front() != '\'') return false;
+    operand.kind = ParsedQuery::SetOperand::Kind::Value;
+    operand.value = std::move(parsed.values[0]);
+    return true;
+}
+
+// Parse the value of an UPDATE SET item: an operand, or two operands joined
+// by +, -, * or / outside quotes and parentheses
+bool parse_set_value(const std::string& text, ParsedQuery::Assignment& assignment, int& next_param) {
+    if (text.empty()) return false;
+    size_t op_pos = std::string::npos;
+    bool in_quote = false;
+    int depth = 0;
+    for (size_t i = 1; i < text.length() && op_pos == std::string::npos; ++i) {
+        char c = text[i];
+        if (c == '\'') in_quote = !in_quote;
+        if (in_quote) continue;
+        if (c == '(') ++depth;
+        else if (c == ')') --depth;
+        else if (depth == 0 && (c == '+' || c == '-' || c == '*' || c == '/')) {
+            // Not a sign: the operator comes after an operand, and an
+            // exponent like 1e-5 is part of its number
+            size_t prev = text.find_last_not_of(" \t\r\n", i - 1);
+            if (prev == std::string::npos || std::strchr("+-*/(", text[prev])) continue;
+            if ((c == '+' || c == '-') && (text[i - 1] == 'e' || text[i - 1] == 'E') && i >= 2 &&
+                std::isdigit(static_cast<unsigned char>(text[i - 2]))) {
+                continue;
+            }
+            op_pos = i;
+        }
+    }
+    if (op_pos == std::string::npos) {
+        return parse_set_operand(text, assignment.left, next_param);
+    }
+    assignment.op = text[op_pos];
+    std::string left = trim(text.substr(0, op_pos));
+    std::string right = trim(text.substr(op_pos + 1));
+    return !left.empty() && !right.empty() &&
+           parse_set_operand(left, assignment.left, next_param) &&
+           parse_set_operand(right, assignment.right, next_param);
+}
+
 // Parse column definitions for CREATE TABLE
 std::vector<ParsedQuery::ColumnDef> parse_column_defs(const std::string& defs_str) {
     std::vector<ParsedQuery::ColumnDef> result;
+    std::vector<std::string> key_columns;   // From a table-level PRIMARY KEY (...)
     auto cols = split_expressions(defs_str);
     for (const auto& col_str : cols) {
         std::string trimmed = trim(col_str);
         if (trimmed.empty()) continue;
+        std::string upper = to_upper(trimmed);
+        auto starts_with_word = [&upper](const std::string& word) {
+            return upper.compare(0, word.size(), word) == 0 &&
+                   (upper.size() == word.size() || std::isspace(static_cast<unsigned char>(upper[word.size()])) ||
+                    upper[word.size()] == '(');
+        };
+        if (starts_with_word("PRIMARY KEY")) {
+            auto open = trimmed.find('(');
+            auto close = trimmed.rfind(')');
+            if (open != std::string::npos && close != std::string::npos && close > open) {
+                for (const auto& c : split_expressions(trimmed.substr(open + 1, close - open - 1))) {
+                    key_columns.push_back(to_upper(trim(c)));
+                }
+            }
+            continue;
+        }
+        if (starts_with_word("CONSTRAINT") || starts_with_word("UNIQUE") ||
+            starts_with_word("FOREIGN KEY") || starts_with_word("CHECK")) {
+            continue;
+        }
         auto first_space = trimmed.find(' ');
         if (first_space == std::string::npos) continue;
         ParsedQuery::ColumnDef def;
@@ -355,8 +687,15 @@ std::vector<ParsedQuery::ColumnDef> parse_column_defs(const std::string& defs_st
         }
         std::string type_part = (constraint_pos != std::string::npos) ? trim(rest.substr(0, constraint_pos)) : rest;
         def.data_type = parse_sql_type(type_part, def.column_size, def.decimal_digits);
+        def.primary_key = upper_rest.find("PRIMARY KEY") != std::string::npos;
+        def.not_null = upper_rest.find("NOT NULL") != std::string::npos;
         result.push_back(def);
     }
+    for (auto& def : result) {
+        if (std::find(key_columns.begin(), key_columns.end(), def.name) != key_columns.end()) {
+            def.primary_key = true;
+        }
+    }
     return result;
 }
 
@@ -450,6 +789,11 @@ CellValue generate_value(const MockColumn& column, int row_index) {
 }
 
 std::vector<MockRow> generate_mock_data(const MockTable& table, int row_count) {
+    const auto& generator = DataGenerator::instance();
+    if (generator.enabled()) {
+        return generator.generate(table, static_cast<size_t>(std::max(row_count, 0)));
+    }
+    
     std::vector<MockRow> data;
     data.reserve(row_count);
     
@@ -804,6 +1148,39 @@ ParsedQuery parse_sql(const std::string& sql) {
     
     std::string upper = to_upper(trimmed);
     
+    // ---- CREATE INDEX / DROP INDEX ----
+    if (upper.compare(0, 6, "CREATE") == 0 || upper.compare(0, 4, "DROP") == 0) {
+        static const std::regex create_index(
+            R"(^CREATE\s+(UNIQUE\s+)?INDEX\s+([^\s(]+)\s+ON\s+([^\s(]+)\s*\(([^)]*)\)(\s+USING\s+(\w+))?\s*;?\s*$)",
+            std::regex::icase);
+        static const std::regex drop_index(
+            R"(^DROP\s+INDEX\s+([^\s;]+)(\s+ON\s+([^\s;]+))?\s*;?\s*$)", std::regex::icase);
+        std::smatch m;
+        if (std::regex_match(trimmed, m, create_index)) {
+            result.query_type = ParsedQuery::QueryType::CreateIndex;
+            result.index_unique = m[1].matched;
+            result.index_name = to_upper(m[2].str());
+            result.table_name = to_upper(m[3].str());
+            for (const auto& c : split_expressions(m[4].str())) {
+                // Drop ASC/DESC after the column name
+                std::string name = to_upper(trim(c));
+                name = name.substr(0, name.find(' '));
+                if (!name.empty()) result.index_columns.push_back(name);
+            }
+            result.index_hash = m[6].matched && to_upper(m[6].str()) == "HASH";
+            result.is_valid = !result.index_columns.empty();
+            if (!result.is_valid) result.error_message = "CREATE INDEX without columns";
+            return result;
+        }
+        if (std::regex_match(trimmed, m, drop_index)) {
+            result.query_type = ParsedQuery::QueryType::DropIndex;
+            result.index_name = to_upper(m[1].str());
+            result.table_name = to_upper(m[3].str());
+            result.is_valid = true;
+            return result;
+        }
+    }
+    
     // ---- CREATE TABLE ----
     if (upper.find("CREATE") == 0 && upper.find("TABLE") != std::string::npos) {
         result.query_type = ParsedQuery::QueryType::CreateTable;
@@ -886,14 +1263,38 @@ ParsedQuery parse_sql(const std::string& sql) {
                 return result;
             }
             
-            // WHERE clause
-            auto where_pos = upper.find("WHERE", table_end);
+            // WHERE, ORDER BY and paging clauses; each runs to the next one
+            auto where_pos = find_clause(upper, "WHERE", table_end);
+            auto order_pos = find_clause(upper, "ORDER BY", table_end);
+            auto paging_pos = std::min({find_clause(upper, "LIMIT", table_end),
+                                        find_clause(upper, "OFFSET", table_end),
+                                        find_clause(upper, "FETCH", table_end)});
+            auto clause_text = [&](size_t start, size_t keyword_length) {
+                size_t end = std::string::npos;
+                for (size_t pos : {where_pos, order_pos, paging_pos}) {
+                    if (pos != std::string::npos && pos > start && pos < end) end = pos;
+                }
+                start += keyword_length;
+                return strip_statement_end(
+                    trimmed.substr(start, end == std::string::npos ? end : end - start));
+            };
             if (where_pos != std::string::npos) {
-                result.where_clause = trimmed.substr(where_pos + 5);
+                result.where_clause = clause_text(where_pos, 5);
+                result.where_first_param = 1 + count_param_markers(trimmed.substr(0, where_pos));
+            }
+            if (order_pos != std::string::npos &&
+                !parse_order_by(clause_text(order_pos, 8), result.order_by, result.error_message)) {
+                return result;
+            }
+            if (paging_pos != std::string::npos &&
+                !parse_paging(clause_text(paging_pos, 0), result.limit, result.offset,
+                              result.error_message)) {
+                return result;
             }
             
-            // Parse column list
+            // Parse column list, after SQL Server's TOP n
             std::string cols_str = trim(trimmed.substr(6, from_pos - 7));
+            strip_top(cols_str, result.limit);
             std::string upper_cols = to_upper(cols_str);
             
             // COUNT(*)
@@ -982,10 +1383,37 @@ ParsedQuery parse_sql(const std::string& sql) {
         auto table_end = table_start;
         while (table_end < (int)upper.length() && !std::isspace(upper[table_end]) && upper[table_end] != ';') ++table_end;
         result.table_name = trimmed.substr(table_start, table_end - table_start);
+        
+        // SET a = <value>, ... [WHERE <condition>]
+        auto set_pos = find_clause(upper, "SET", table_end);
+        auto where_pos = find_clause(upper, "WHERE", table_end);
+        if (set_pos == std::string::npos || (where_pos != std::string::npos && where_pos < set_pos)) {
+            result.error_message = "UPDATE without SET clause";
+            return result;
+        }
+        size_t set_length = where_pos == std::string::npos ? std::string::npos : where_pos - set_pos - 3;
+        int next_param = 1 + count_param_markers(trimmed.substr(0, set_pos));
+        for (const auto& item : split_expressions(strip_statement_end(trimmed.substr(set_pos + 3, set_length)))) {
+            ParsedQuery::Assignment assignment;
+            auto eq = item.find('=');
+            std::string column = eq == std::string::npos ? "" : to_upper(trim(item.substr(0, eq)));
+            column = column.substr(column.rfind('.') == std::string::npos ? 0 : column.rfind('.') + 1);
+            if (column.empty() || !parse_set_value(trim(item.substr(eq + 1)), assignment, next_param)) {
+                result.error_message = "Unsupported SET item: " + item;
+                return result;
+            }
+            assignment.column = column;
+            result.assignments.push_back(std::move(assignment));
+        }
+        if (result.assignments.empty()) {
+            result.error_message = "UPDATE without SET clause";
+            return result;
+        }
+        if (where_pos != std::string::npos) {
+            result.where_clause = strip_statement_end(trimmed.substr(where_pos + 5));
+            result.where_first_param = 1 + count_param_markers(trimmed.substr(0, where_pos));
+        }
         result.is_valid = true;
-        result.affected_rows = 1;
-        auto where_pos = upper.find("WHERE");
-        if (where_pos != std::string::npos) result.where_clause = trimmed.substr(where_pos + 5);
     } else if (upper.find("DELETE") == 0) {
         result.query_type = ParsedQuery::QueryType::Delete;
         auto from_pos = upper.find("FROM");
@@ -995,8 +1423,12 @@ ParsedQuery parse_sql(const std::string& sql) {
             auto table_end = table_start;
             while (table_end < upper.length() && !std::isspace(upper[table_end]) && upper[table_end] != ';') ++table_end;
             result.table_name = trimmed.substr(table_start, table_end - table_start);
+            auto where_pos = find_clause(upper, "WHERE", table_end);
+            if (where_pos != std::string::npos) {
+                result.where_clause = strip_statement_end(trimmed.substr(where_pos + 5));
+                result.where_first_param = 1 + count_param_markers(trimmed.substr(0, where_pos));
+            }
             result.is_valid = true;
-            result.affected_rows = 1;
         } else {
             result.error_message = "DELETE without FROM clause";
         }
@@ -1008,7 +1440,348 @@ ParsedQuery parse_sql(const std::string& sql) {
     return result;
 }
 
-QueryResult execute_query(const ParsedQuery& query, int result_set_size) {
+bool plan_insert(const ParsedQuery& query, InsertPlan& plan) {
+    if (!query.is_valid || query.query_type != ParsedQuery::QueryType::Insert ||
+        query.insert_values.empty()) {
+        return false;
+    }
+    const MockTable* table = MockCatalog::instance().find_table(query.table_name);
+    if (!table || query.insert_values.size() > table->columns.size()) {
+        return false;
+    }
+    
+    plan.table_name = to_upper(query.table_name);
+    plan.column_count = table->columns.size();
+    plan.value_columns.assign(query.insert_values.size(), -1);
+    
+    // Same mapping as the INSERT branch of execute_query()
+    if (!query.insert_columns.empty() && query.insert_columns.size() == query.insert_values.size()) {
+        for (size_t i = 0; i < query.insert_columns.size(); ++i) {
+            for (size_t j = 0; j < table->columns.size(); ++j) {
+                if (to_upper(table->columns[j].name) == query.insert_columns[i]) {
+                    plan.value_columns[i] = static_cast<int>(j);
+                    break;
+                }
+            }
+        }
+    } else {
+        for (size_t i = 0; i < query.insert_values.size(); ++i) {
+            plan.value_columns[i] = static_cast<int>(i);
+        }
+    }
+    return true;
+}
+
+size_t QueryResult::row_count() const {
+    return scan ? scan->row_count() : data.size();
+}
+
+void materialize_scan(QueryResult& result) {
+    if (!result.scan) return;
+    result.data = result.scan->materialize(result.scan_columns);
+    result.scan.reset();
+    result.scan_columns.clear();
+}
+
+namespace {
+
+// Where a statement reads rows from: the data file, rows inserted in
+// memory (as `txn` sees them), or rows generated for a preset table (none
+// for an empty user table). Returns true for stored rows; `indexed` is set
+// when they are the latest committed rows, which indexes cover.
+bool select_source(const MockTable& table, int result_set_size, Transaction* txn,
+                   std::shared_ptr<const TableSnapshot>& scan,
+                   std::vector<MockRow>& generated, RowSource& source, bool& indexed) {
+    // A table emptied by DELETE stays stored rather than reverting to
+    // generated rows
+    if (MockCatalog::instance().read_rows(table.name, txn, source, scan, indexed)) {
+        return true;
+    }
+    indexed = false;
+    if (table.remarks != "User-created table") {
+        generated = generate_mock_data(table, result_set_size);
+        source.rows = &generated;
+    }
+    return false;
+}
+
+// Rows of `source` that satisfy the WHERE clause, in table order. With
+// `indexed`, an index that answers one of the ANDed conditions narrows the
+// rows before the rest of the clause is checked. Returns false with the
+// error in `result` when the clause doesn't compile.
+bool match_rows(const ParsedQuery& query, const MockTable& table, const RowSource& source,
+                bool indexed, std::vector<uint32_t>& rows, QueryResult& result) {
+    Predicate predicate;
+    if (!predicate.compile(query.where_clause, table, query.params, query.where_first_param,
+                           result.error_sqlstate, result.error_message)) {
+        result.success = false;
+        return false;
+    }
+    if (indexed) {
+        // Equality first: a point lookup usually returns the fewest rows
+        for (bool range : {false, true}) {
+            for (const auto& key : predicate.key_conditions()) {
+                if (key.is_range() != range) continue;
+                TableIndex* index = MockCatalog::instance().row_index(table.name, key.column, range, source);
+                if (index && index->lookup(key, rows)) {
+                    predicate.filter(source, rows);
+                    return true;
+                }
+            }
+        }
+    }
+    rows = predicate.scan(source);
+    return true;
+}
+
+// An UPDATE SET operand bound to a table column or a value
+struct SetValue {
+    bool is_column = false;
+    size_t column = 0;
+    CellValue value;
+};
+
+struct ResolvedAssignment {
+    size_t column = 0;
+    SetValue left;
+    char op = 0;
+    SetValue right;
+};
+
+bool resolve_operand(const ParsedQuery::SetOperand& operand, const ParsedQuery& query,
+                     const MockTable& table, SetValue& out, QueryResult& result) {
+    switch (operand.kind) {
+        case ParsedQuery::SetOperand::Kind::Column: {
+            auto col = std::find_if(table.columns.begin(), table.columns.end(),
+                [&operand](const MockColumn& c) { return to_upper(c.name) == operand.column; });
+            if (col == table.columns.end()) {
+                result.success = false;
+                result.error_message = "Column not found: " + operand.column;
+                result.error_sqlstate = "42S22";
+                return false;
+            }
+            out.is_column = true;
+            out.column = static_cast<size_t>(col - table.columns.begin());
+            return true;
+        }
+        case ParsedQuery::SetOperand::Kind::Param:
+            // An unbound marker is NULL
+            if (operand.param >= 1 && static_cast<size_t>(operand.param) <= query.params.size()) {
+                out.value = query.params[operand.param - 1];
+            }
+            return true;
+        default:
+            out.value = operand.value;
+            return true;
+    }
+}
+
+// Bind the SET list to table columns
+bool resolve_assignments(const ParsedQuery& query, const MockTable& table,
+                         std::vector<ResolvedAssignment>& assignments, QueryResult& result) {
+    for (const auto& a : query.assignments) {
+        ResolvedAssignment resolved;
+        ParsedQuery::SetOperand target;
+        target.kind = ParsedQuery::SetOperand::Kind::Column;
+        target.column = a.column;
+        SetValue column;
+        if (!resolve_operand(target, query, table, column, result) ||
+            !resolve_operand(a.left, query, table, resolved.left, result) ||
+            (a.op && !resolve_operand(a.right, query, table, resolved.right, result))) {
+            return false;
+        }
+        resolved.column = column.column;
+        resolved.op = a.op;
+        assignments.push_back(std::move(resolved));
+    }
+    return true;
+}
+
+// Number held by a cell for SET arithmetic; numeric text counts. False for
+// other text.
+bool numeric_cell(const CellValue& cell, bool& is_integer, long long& i, double& d) {
+    if (const auto* v = std::get_if<long long>(&cell)) {
+        is_integer = true;
+        i = *v;
+        return true;
+    }
+    if (const auto* v = std::get_if<double>(&cell)) {
+        is_integer = false;
+        d = *v;
+        return true;
+    }
+    const auto& s = std::get<std::string>(cell);
+    std::string text = trim(s);
+    if (text.empty()) return false;
+    char* end = nullptr;
+    errno = 0;
+    long long parsed = std::strtoll(text.c_str(), &end, 10);
+    if (end == text.c_str() + text.size() && errno == 0) {
+        is_integer = true;
+        i = parsed;
+        return true;
+    }
+    d = std::strtod(text.c_str(), &end);
+    is_integer = false;
+    return end == text.c_str() + text.size();
+}
+
+// a op b for +, -, * or / on integers; false when the result doesn't fit
+// in a long long (including LLONG_MIN / -1)
+bool checked_integer_op(char op, long long a, long long b, long long& out) {
+#if defined(__GNUC__) || defined(__clang__)
+    switch (op) {
+        case '+': return !__builtin_add_overflow(a, b, &out);
+        case '-': return !__builtin_sub_overflow(a, b, &out);
+        case '*': return !__builtin_mul_overflow(a, b, &out);
+        default: break;
+    }
+#else
+    switch (op) {
+        case '+':
+            if ((b > 0 && a > LLONG_MAX - b) || (b < 0 && a < LLONG_MIN - b)) return false;
+            out = a + b;
+            return true;
+        case '-':
+            if ((b < 0 && a > LLONG_MAX + b) || (b > 0 && a < LLONG_MIN + b)) return false;
+            out = a - b;
+            return true;
+        case '*':
+            if (a != 0 && b != 0 &&
+                (a > 0 ? (b > 0 ? a > LLONG_MAX / b : b < LLONG_MIN / a)
+                       : (b > 0 ? a < LLONG_MIN / b : a < LLONG_MAX / b))) {
+                return false;
+            }
+            out = a * b;
+            return true;
+        default: break;
+    }
+#endif
+    if (a == LLONG_MIN && b == -1) return false;
+    out = a / b;
+    return true;
+}
+
+// Apply +, -, * or / to two cells; NULL when either is NULL
+bool apply_operator(char op, const CellValue& a, const CellValue& b, CellValue& out,
+                    QueryResult& result) {
+    if (std::holds_alternative<std::monostate>(a) || std::holds_alternative<std::monostate>(b)) {
+        out = std::monostate{};
+        return true;
+    }
+    bool a_int = false, b_int = false;
+    long long ai = 0, bi = 0;
+    double ad = 0, bd = 0;
+    if (!numeric_cell(a, a_int, ai, ad) || !numeric_cell(b, b_int, bi, bd)) {
+        result.success = false;
+        result.error_message = "Invalid character value for arithmetic in SET";
+        result.error_sqlstate = "22018";
+        return false;
+    }
+    if ((op == '/') && (b_int ? bi == 0 : bd == 0.0)) {
+        result.success = false;
+        result.error_message = "Division by zero";
+        result.error_sqlstate = "22012";
+        return false;
+    }
+    if (a_int && b_int) {
+        long long value = 0;
+        if (!checked_integer_op(op, ai, bi, value)) {
+            result.success = false;
+            result.error_message = "Numeric value out of range";
+            result.error_sqlstate = "22003";
+            return false;
+        }
+        out = value;
+        return true;
+    }
+    double x = a_int ? static_cast<double>(ai) : ad;
+    double y = b_int ? static_cast<double>(bi) : bd;
+    switch (op) {
+        case '+': out = x + y; break;
+        case '-': out = x - y; break;
+        case '*': out = x * y; break;
+        default:  out = x / y; break;
+    }
+    return true;
+}
+
+// Run an UPDATE or DELETE. Rows are chosen like a SELECT's (through an
+// index where one answers the WHERE clause) and changed in the table's
+// storage. Preset tables without stored rows are generated on every read,
+// so for them the statement only reports the rows it matched.
+void execute_write(const ParsedQuery& query, const MockTable& table, int result_set_size,
+                   Transaction* txn, QueryResult& result) {
+    MockCatalog& catalog = MockCatalog::instance();
+    std::vector<ResolvedAssignment> assignments;
+    if (query.query_type == ParsedQuery::QueryType::Update &&
+        !resolve_assignments(query, table, assignments, result)) {
+        return;
+    }
+    
+    std::shared_ptr<const TableSnapshot> scan;
+    std::vector<MockRow> generated;
+    RowSource source;
+    bool indexed = false;
+    bool stored = select_source(table, result_set_size, txn, scan, generated, source, indexed);
+    std::vector<uint32_t> rows;
+    if (!query.where_clause.empty()) {
+        if (!match_rows(query, table, source, indexed, rows, result)) return;
+    } else {
+        rows.resize(source.size());
+        std::iota(rows.begin(), rows.end(), 0u);
+    }
+    
+    result.success = true;
+    result.affected_rows = static_cast<SQLLEN>(rows.size());
+    if (!stored || rows.empty()) return;
+    
+    bool written = true;
+    if (query.query_type == ParsedQuery::QueryType::Delete) {
+        written = catalog.delete_rows(table.name, rows, txn);
+    } else {
+        // Every assignment reads the row as it was
+        std::vector<MockRow> values(rows.size());
+        std::vector<size_t> changed;
+        for (const auto& a : assignments) changed.push_back(a.column);
+        auto operand = [](const SetValue& v, const MockRow& row) -> const CellValue& {
+            static const CellValue null_cell;
+            if (!v.is_column) return v.value;
+            return v.column < row.size() ? row[v.column] : null_cell;
+        };
+        for (size_t i = 0; i < rows.size(); ++i) {
+            MockRow old_row;
+            if (source.rows) {
+                old_row = (*source.rows)[rows[i]];
+            } else {
+                scan->read_row(rows[i], {}, old_row);
+            }
+            old_row.resize(table.columns.size());
+            MockRow& row = values[i];
+            row = old_row;
+            for (const auto& a : assignments) {
+                if (!a.op) {
+                    row[a.column] = operand(a.left, old_row);
+                } else if (!apply_operator(a.op, operand(a.left, old_row), operand(a.right, old_row),
+                                           row[a.column], result)) {
+                    result.affected_rows = 0;
+                    return;
+                }
+            }
+        }
+        written = catalog.update_rows(table.name, rows, std::move(values), changed, txn);
+    }
+    if (!written) {
+        result.success = false;
+        result.affected_rows = 0;
+        result.error_message = "Could not write to the data file";
+        result.error_sqlstate = "HY000";
+    }
+}
+
+} // anonymous namespace
+
+QueryResult execute_query(ParsedQuery query, int result_set_size, Transaction* txn) {
     QueryResult result;
     
     if (!query.is_valid) {
@@ -1019,6 +1792,7 @@ QueryResult execute_query(const ParsedQuery& query, int result_set_size) {
     }
     
     MockCatalog& catalog = MockCatalog::instance();
+    std::lock_guard<std::mutex> lock(catalog.mutex());
     
     // ---- CREATE TABLE ----
     if (query.query_type == ParsedQuery::QueryType::CreateTable) {
@@ -1040,12 +1814,17 @@ QueryResult execute_query(const ParsedQuery& query, int result_set_size) {
             col.data_type = def.data_type;
             col.column_size = def.column_size;
             col.decimal_digits = def.decimal_digits;
-            col.nullable = SQL_NULLABLE;
-            col.is_primary_key = false;
+            col.nullable = def.primary_key || def.not_null ? SQL_NO_NULLS : SQL_NULLABLE;
+            col.is_primary_key = def.primary_key;
             col.is_auto_increment = false;
             new_table.columns.push_back(col);
         }
-        catalog.add_table(new_table);
+        if (!catalog.add_table(new_table)) {
+            result.success = false;
+            result.error_message = "Could not write table to the data file: " + query.table_name;
+            result.error_sqlstate = "HY000";
+            return result;
+        }
         result.success = true;
         result.affected_rows = 0;
         return result;
@@ -1059,12 +1838,64 @@ QueryResult execute_query(const ParsedQuery& query, int result_set_size) {
             result.error_sqlstate = "42S02";
             return result;
         }
-        catalog.remove_table(query.table_name);
+        if (!catalog.remove_table(query.table_name)) {
+            result.success = false;
+            result.error_message = "Could not drop table from the data file: " + query.table_name;
+            result.error_sqlstate = "HY000";
+            return result;
+        }
         result.success = true;
         result.affected_rows = 0;
         return result;
     }
     
+    // ---- CREATE INDEX ----
+    if (query.query_type == ParsedQuery::QueryType::CreateIndex) {
+        const MockTable* table = catalog.find_table(query.table_name);
+        if (!table) {
+            result.success = false;
+            result.error_message = "Table not found: " + query.table_name;
+            result.error_sqlstate = "42S02";
+            return result;
+        }
+        for (const auto& col_name : query.index_columns) {
+            bool found = std::any_of(table->columns.begin(), table->columns.end(),
+                                     [&col_name](const MockColumn& c) { return to_upper(c.name) == col_name; });
+            if (!found) {
+                result.success = false;
+                result.error_message = "Column not found: " + col_name;
+                result.error_sqlstate = "42S22";
+                return result;
+            }
+        }
+        MockIndex index;
+        index.table_name = table->name;
+        index.index_name = query.index_name;
+        index.non_unique = !query.index_unique;
+        index.type = query.index_hash ? SQL_INDEX_HASHED : SQL_INDEX_OTHER;
+        index.columns = query.index_columns;
+        if (!catalog.create_index(index, query.index_hash)) {
+            result.success = false;
+            result.error_message = "Index already exists: " + query.index_name;
+            result.error_sqlstate = "42S11";
+            return result;
+        }
+        result.success = true;
+        return result;
+    }
+    
+    // ---- DROP INDEX ----
+    if (query.query_type == ParsedQuery::QueryType::DropIndex) {
+        if (!catalog.drop_index(query.index_name)) {
+            result.success = false;
+            result.error_message = "Index not found: " + query.index_name;
+            result.error_sqlstate = "42S12";
+            return result;
+        }
+        result.success = true;
+        return result;
+    }
+    
     // ---- Literal SELECT ----
     if (query.is_literal_select) {
         result.success = true;
@@ -1097,11 +1928,19 @@ QueryResult execute_query(const ParsedQuery& query, int result_set_size) {
                 result.column_types.push_back(SQL_INTEGER);
                 result.column_sizes.push_back(10);
                 long long count = 0;
-                auto& inserted = catalog.inserted_data();
-                std::string upper_name = to_upper(query.table_name);
-                auto it = inserted.find(upper_name);
-                if (it != inserted.end()) {
-                    count = static_cast<long long>(it->second.size());
+                std::shared_ptr<const TableSnapshot> scan;
+                RowSource source;
+                bool indexed = false;
+                if (!query.where_clause.empty()) {
+                    std::vector<MockRow> generated;
+                    select_source(*table, result_set_size, txn, scan, generated, source, indexed);
+                    std::vector<uint32_t> rows;
+                    if (!match_rows(query, *table, source, indexed, rows, result)) {
+                        return result;
+                    }
+                    count = static_cast<long long>(rows.size());
+                } else if (catalog.read_rows(table->name, txn, source, scan, indexed)) {
+                    count = static_cast<long long>(source.size());
                 } else if (table->remarks != "User-created table") {
                     count = static_cast<long long>(result_set_size);
                 }
@@ -1112,6 +1951,7 @@ QueryResult execute_query(const ParsedQuery& query, int result_set_size) {
             }
             
             result.success = true;
+            result.source_table = to_upper(query.table_name);
             bool all_columns = query.columns.empty() || 
                                (query.columns.size() == 1 && query.columns[0] == "*");
             if (all_columns) {
@@ -1141,125 +1981,119 @@ QueryResult execute_query(const ParsedQuery& query, int result_set_size) {
                 }
             }
             
-            // Return inserted data if available, otherwise generate mock data
-            auto& inserted = catalog.inserted_data();
-            std::string upper_name = to_upper(query.table_name);
-            auto it = inserted.find(upper_name);
-            if (it != inserted.end() && !it->second.empty()) {
-                result.data = it->second;
-            } else if (table->remarks == "User-created table") {
-                // User-created table with no data — empty result
-            } else {
-                result.data = generate_mock_data(*table, result_set_size);
+            // ORDER BY items name a column or a position in the select list
+            std::vector<SortKey> sort_keys;
+            for (const auto& item : query.order_by) {
+                std::string name = item.column;
+                bool position = std::all_of(name.begin(), name.end(),
+                                            [](unsigned char c) { return std::isdigit(c); });
+                if (position) {
+                    size_t n = name.size() > 9 ? 0 : static_cast<size_t>(std::stoul(name));
+                    size_t select_count = all_columns ? table->columns.size() : query.columns.size();
+                    if (n == 0 || n > select_count) {
+                        result.success = false;
+                        result.error_message = "ORDER BY position out of range: " + name;
+                        result.error_sqlstate = "42000";
+                        return result;
+                    }
+                    name = all_columns ? table->columns[n - 1].name : query.columns[n - 1];
+                }
+                SortKey key;
+                auto col = std::find_if(table->columns.begin(), table->columns.end(),
+                    [&name](const MockColumn& c) { return to_upper(c.name) == to_upper(name); });
+                if (col == table->columns.end()) {
+                    result.success = false;
+                    result.error_message = "Column not found: " + name;
+                    result.error_sqlstate = "42S22";
+                    return result;
+                }
+                key.column = static_cast<size_t>(col - table->columns.begin());
+                key.data_type = col->data_type;
+                key.descending = item.descending;
+                key.nulls_first = item.nulls_first;
+                sort_keys.push_back(key);
             }
+            const bool filtered = !query.where_clause.empty();
+            const bool paged = query.limit >= 0 || query.offset > 0;
             
-            // ── Basic WHERE filtering ──
-            // Supports: "column IN (v1, v2, ...)" and "column = value"
-            if (!query.where_clause.empty() && !result.data.empty()) {
-                std::string wc = trim(query.where_clause);
-                std::string wcu = to_upper(wc);
-                
-                // Find the target column index
-                auto in_pos = wcu.find(" IN ");
-                auto eq_pos = wcu.find(" = ");
-                auto eq2_pos = wcu.find("=");
-                
-                std::string filter_col;
-                std::vector<CellValue> filter_values;
-                
-                if (in_pos != std::string::npos) {
-                    // "COLUMN IN (v1, v2, ...)"
-                    filter_col = to_upper(trim(wc.substr(0, in_pos)));
-                    auto paren_open = wc.find('(', in_pos);
-                    auto paren_close = wc.find(')', paren_open);
-                    if (paren_open != std::string::npos && paren_close != std::string::npos) {
-                        auto val_list = split_expressions(
-                            wc.substr(paren_open + 1, paren_close - paren_open - 1));
-                        for (auto& v : val_list) {
-                            std::string tv = trim(v);
-                            if (tv.empty()) continue;
-                            if (tv.front() == '\'' && tv.back() == '\'') {
-                                filter_values.push_back(tv.substr(1, tv.size() - 2));
-                            } else {
-                                try { filter_values.push_back(static_cast<long long>(std::stoll(tv))); }
-                                catch (...) { filter_values.push_back(tv); }
+            // Without WHERE or ORDER BY, rows past OFFSET + LIMIT are never
+            // read, so generated tables make only the rows returned
+            int rows_needed = result_set_size;
+            if (!filtered && sort_keys.empty() && query.limit >= 0) {
+                rows_needed = static_cast<int>(std::min<long long>(result_set_size, query.offset + query.limit));
+            }
+            
+            // Tables in the data file are read from its mapping: for a plain
+            // SELECT the statement decodes rows as it fetches them, otherwise
+            // only the rows returned are decoded here.
+            std::shared_ptr<const TableSnapshot> scan;
+            std::vector<MockRow> generated;
+            RowSource source;
+            bool indexed = false;
+            select_source(*table, rows_needed, txn, scan, generated, source, indexed);
+            if (scan && !filtered && sort_keys.empty() && !paged) {
+                if (!all_columns) {
+                    for (const auto& col_name : query.columns) {
+                        for (size_t j = 0; j < table->columns.size(); ++j) {
+                            if (to_upper(table->columns[j].name) == to_upper(col_name)) {
+                                result.scan_columns.push_back(j);
+                                break;
                             }
                         }
                     }
-                } else if (eq_pos != std::string::npos || eq2_pos != std::string::npos) {
-                    // "COLUMN = value"
-                    auto pos = (eq_pos != std::string::npos) ? eq_pos : eq2_pos;
-                    filter_col = to_upper(trim(wc.substr(0, pos)));
-                    std::string val = trim(wc.substr(pos + ((eq_pos != std::string::npos) ? 3 : 1)));
-                    if (val.front() == '\'' && val.back() == '\'') {
-                        filter_values.push_back(val.substr(1, val.size() - 2));
+                }
+                result.scan = std::move(scan);
+                break;
+            }
+            
+            if (!filtered && sort_keys.empty() && !paged) {
+                if (source.rows == &generated) {
+                    result.data = std::move(generated);
+                } else if (source.rows) {
+                    result.data = *source.rows;
+                }
+            } else {
+                // Work on row numbers; only the rows returned are copied
+                auto copy_row = [&](uint32_t r) {
+                    if (source.rows == &generated) {
+                        result.data.push_back(std::move(generated[r]));
+                    } else if (source.rows) {
+                        result.data.push_back((*source.rows)[r]);
                     } else {
-                        try { filter_values.push_back(static_cast<long long>(std::stoll(val))); }
-                        catch (...) { filter_values.push_back(val); }
+                        MockRow row;
+                        scan->read_row(r, {}, row);
+                        result.data.push_back(std::move(row));
                     }
-                }
+                };
+                auto window_end = [&](size_t count) {
+                    if (query.limit < 0) return count;
+                    return static_cast<size_t>(std::min<long long>(static_cast<long long>(count),
+                                                                   query.offset + query.limit));
+                };
                 
-                if (!filter_col.empty() && !filter_values.empty()) {
-                    // Find column index in table
-                    int col_idx = -1;
-                    for (size_t ci = 0; ci < table->columns.size(); ++ci) {
-                        if (to_upper(table->columns[ci].name) == filter_col) {
-                            col_idx = static_cast<int>(ci);
-                            break;
-                        }
-                    }
-                    if (col_idx >= 0) {
-                        std::vector<MockRow> filtered;
-                        for (const auto& row : result.data) {
-                            if (col_idx < static_cast<int>(row.size())) {
-                                for (const auto& fv : filter_values) {
-                                    if (row[col_idx] == fv) {
-                                        filtered.push_back(row);
-                                        break;
-                                    }
-                                }
-                            }
+                if (!filtered && sort_keys.empty()) {
+                    // Paging alone: the window is a range of row numbers
+                    size_t end = window_end(source.size());
+                    size_t begin = std::min(static_cast<size_t>(query.offset), end);
+                    result.data.reserve(end - begin);
+                    for (size_t r = begin; r < end; ++r) copy_row(static_cast<uint32_t>(r));
+                } else {
+                    std::vector<uint32_t> rows;
+                    if (filtered) {
+                        if (!match_rows(query, *table, source, indexed, rows, result)) {
+                            return result;
                         }
-                        result.data = std::move(filtered);
+                    } else {
+                        rows.resize(source.size());
+                        std::iota(rows.begin(), rows.end(), 0u);
                     }
-                }
-            }
-            
-            // ── Basic ORDER BY ──
-            // Supports: "ORDER BY column [ASC|DESC]"
-            {
-                std::string wcu = to_upper(query.where_clause.empty()
-                    ? "" : query.where_clause);
-                // Also check original SQL for ORDER BY after WHERE
-                std::string full_upper = to_upper(query.table_name); // check sql later
-                // Parse ORDER BY from where_clause tail or from sql
-                auto order_pos = wcu.find("ORDER BY");
-                if (order_pos != std::string::npos) {
-                    std::string order_spec = trim(
-                        query.where_clause.substr(order_pos + 8));
-                    bool desc = (to_upper(order_spec).find("DESC") != std::string::npos);
-                    // Extract column name
-                    auto space = order_spec.find(' ');
-                    std::string order_col = to_upper(
-                        space != std::string::npos ? order_spec.substr(0, space) : order_spec);
                     
-                    int col_idx = -1;
-                    for (size_t ci = 0; ci < table->columns.size(); ++ci) {
-                        if (to_upper(table->columns[ci].name) == order_col) {
-                            col_idx = static_cast<int>(ci);
-                            break;
-                        }
-                    }
-                    if (col_idx >= 0 && result.data.size() > 1) {
-                        std::sort(result.data.begin(), result.data.end(),
-                            [col_idx, desc](const MockRow& a, const MockRow& b) {
-                                if (col_idx >= static_cast<int>(a.size())) return !desc;
-                                if (col_idx >= static_cast<int>(b.size())) return desc;
-                                // Compare variants
-                                return desc ? (b[col_idx] < a[col_idx])
-                                            : (a[col_idx] < b[col_idx]);
-                            });
-                    }
+                    size_t end = window_end(rows.size());
+                    order_rows(source, sort_keys, rows, end);
+                    size_t begin = std::min(static_cast<size_t>(query.offset), end);
+                    
+                    result.data.reserve(end - begin);
+                    for (size_t i = begin; i < end; ++i) copy_row(rows[i]);
                 }
             }
             
@@ -1302,24 +2136,27 @@ QueryResult execute_query(const ParsedQuery& query, int result_set_size) {
                     for (size_t i = 0; i < query.insert_columns.size(); ++i) {
                         for (size_t j = 0; j < table->columns.size(); ++j) {
                             if (to_upper(table->columns[j].name) == query.insert_columns[i]) {
-                                row[j] = query.insert_values[i];
+                                row[j] = std::move(query.insert_values[i]);
                                 break;
                             }
                         }
                     }
                 } else {
-                    row = query.insert_values;
+                    row = std::move(query.insert_values);
                     while (row.size() < table->columns.size()) row.push_back(std::monostate{});
                 }
-                catalog.insert_row(to_upper(query.table_name), std::move(row));
+                if (!catalog.insert_row(to_upper(query.table_name), std::move(row), txn)) {
+                    result.success = false;
+                    result.error_message = "Could not write row to the data file";
+                    result.error_sqlstate = "HY000";
+                }
             }
             break;
         }
         
         case ParsedQuery::QueryType::Update:
         case ParsedQuery::QueryType::Delete:
-            result.success = true;
-            result.affected_rows = query.affected_rows;
+            execute_write(query, *table, result_set_size, txn, result);
             break;
             
         default:
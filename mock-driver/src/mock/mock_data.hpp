@@ -2,6 +2,7 @@
 
 #include "../driver/common.hpp"
 #include "mock_catalog.hpp"
+#include <memory>
 #include <string>
 #include <vector>
 #include <variant>
@@ -22,11 +23,23 @@ CellValue generate_value(const MockColumn& column, int row_index);
 
 // Parse simple SQL and determine result
 struct ParsedQuery {
-    enum class QueryType { Select, Insert, Update, Delete, CreateTable, DropTable, Other };
+    enum class QueryType { Select, Insert, Update, Delete, CreateTable, DropTable,
+                           CreateIndex, DropIndex, Other };
     QueryType query_type = QueryType::Other;
     std::string table_name;
     std::vector<std::string> columns;  // For SELECT: requested columns (* = all)
-    std::string where_clause;
+    std::string where_clause;          // Condition only, without ORDER BY or paging
+    int where_first_param = 1;         // Number of the first '?' in the WHERE clause
+
+    // For SELECT: ORDER BY items, then LIMIT / TOP / OFFSET ... FETCH FIRST
+    struct OrderItem {
+        std::string column;            // Column name, or a 1-based select-list position
+        bool descending = false;
+        bool nulls_first = true;       // NULLs sort low unless NULLS FIRST/LAST is given
+    };
+    std::vector<OrderItem> order_by;
+    long long limit = -1;              // Rows to return; -1 for all
+    long long offset = 0;              // Rows to skip first
     int affected_rows = 0;
     bool is_valid = false;
     bool is_literal_select = false;    // SELECT without FROM (literal values)
@@ -49,9 +62,35 @@ struct ParsedQuery {
         SQLSMALLINT data_type = SQL_VARCHAR;
         SQLULEN column_size = 255;
         SQLSMALLINT decimal_digits = 0;
+        bool primary_key = false;
+        bool not_null = false;
     };
     std::vector<ColumnDef> create_columns;
 
+    // For CREATE INDEX / DROP INDEX
+    std::string index_name;
+    std::vector<std::string> index_columns;
+    bool index_unique = false;
+    bool index_hash = false;           // USING HASH
+
+    // For UPDATE: SET assignments. Each value is one operand, or two joined
+    // by +, -, * or /; an operand is a literal, a column or a '?' marker.
+    // Every assignment sees the row as it was before the UPDATE.
+    struct SetOperand {
+        enum class Kind { Value, Column, Param };
+        Kind kind = Kind::Value;
+        CellValue value;
+        std::string column;            // Upper case, for Column
+        int param = 0;                 // Marker number, for Param
+    };
+    struct Assignment {
+        std::string column;            // Upper case
+        SetOperand left;
+        char op = 0;                   // 0 when there is no right operand
+        SetOperand right;
+    };
+    std::vector<Assignment> assignments;
+
     // For INSERT: parsed values
     std::vector<CellValue> insert_values;
     std::vector<bool> insert_param_markers;  // true for each insert_value that was a '?' marker
@@ -59,6 +98,11 @@ struct ParsedQuery {
 
     // Parameter count
     int param_count = 0;
+
+    // Bound parameter values by marker number - 1, for markers evaluated
+    // when the statement runs (WHERE, UPDATE SET); set by the statement
+    // before execution
+    std::vector<CellValue> params;
 };
 
 ParsedQuery parse_sql(const std::string& sql);
@@ -73,8 +117,40 @@ struct QueryResult {
     std::vector<SQLULEN> column_sizes;
     std::vector<MockRow> data;
     SQLLEN affected_rows = 0;
+    std::string source_table;   // Table a SELECT read from (empty for literal and COUNT queries)
+    
+    // Set instead of `data` when a SELECT reads a table in the data file
+    // and needs no filtering: rows are decoded from the mapping on fetch.
+    // `scan_columns` lists the table columns to return (empty for all).
+    std::shared_ptr<const TableSnapshot> scan;
+    std::vector<size_t> scan_columns;
+    
+    // Rows in the result, whichever way they are held
+    size_t row_count() const;
+};
+
+// Decode a scan result into `data`, for callers that combine results
+void materialize_scan(QueryResult& result);
+
+// Takes the query by value so INSERT can move its values into the catalog.
+// `txn` is the connection's transaction, nullptr in autocommit mode. Holds
+// MockCatalog::mutex() while it runs.
+QueryResult execute_query(ParsedQuery query, int result_set_size, Transaction* txn = nullptr);
+
+// Where one INSERT puts each of its VALUES entries, worked out once so the
+// statement can run for a whole array of parameter sets and append all
+// rows with MockCatalog::insert_rows
+struct InsertPlan {
+    std::string table_name;            // Upper-case catalog key
+    size_t column_count = 0;           // Columns in a stored row
+    std::vector<int> value_columns;    // Table column per VALUES entry, -1 when dropped
 };
 
-QueryResult execute_query(const ParsedQuery& query, int result_set_size);
+// Build the plan for an INSERT. Returns false when the statement is not an
+// INSERT with VALUES into an existing table, or when execute_query() would
+// store its values differently; the caller then executes it row by row.
+// Call with MockCatalog::mutex() held, and keep holding it until the rows
+// are inserted.
+bool plan_insert(const ParsedQuery& query, InsertPlan& plan);
 
 } // namespace mock_odbc
@@ -1,11 +1,14 @@
 #include "mock_types.hpp"
-#include <algorithm>
+#include "sorted_table.hpp"
 
 namespace mock_odbc {
 
 namespace {
 
-std::vector<MockTypeInfo> all_types = {
+constexpr SQLSMALLINT data_type_of(const MockTypeInfo& type) { return type.data_type; }
+
+// Sorted by DATA_TYPE at compile time
+constexpr auto kTypes = sort_by_key(to_array<MockTypeInfo>({
     // Character types
     {"CHAR", SQL_CHAR, 255, "'", "'", "length", SQL_NULLABLE, SQL_TRUE, SQL_SEARCHABLE, SQL_FALSE, SQL_FALSE, SQL_FALSE, "CHAR", 0, 0, SQL_CHAR, 0, 0, 0},
     {"VARCHAR", SQL_VARCHAR, 65535, "'", "'", "max length", SQL_NULLABLE, SQL_TRUE, SQL_SEARCHABLE, SQL_FALSE, SQL_FALSE, SQL_FALSE, "VARCHAR", 0, 0, SQL_VARCHAR, 0, 0, 0},
@@ -44,48 +47,42 @@ std::vector<MockTypeInfo> all_types = {
     
     // GUID type
     {"GUID", SQL_GUID, 36, "'", "'", "", SQL_NULLABLE, SQL_FALSE, SQL_SEARCHABLE, SQL_FALSE, SQL_FALSE, SQL_FALSE, "UNIQUEIDENTIFIER", 0, 0, SQL_GUID, 0, 0, 0}
-};
+}), data_type_of);
 
 } // anonymous namespace
 
-std::vector<MockTypeInfo> get_mock_types(const std::string& preset) {
+MockTypeRange find_mock_types(SQLSMALLINT data_type) {
+    if (data_type == SQL_ALL_TYPES) {
+        return {kTypes.data(), kTypes.data() + kTypes.size()};
+    }
+    size_t first = lower_bound_by_key(kTypes, data_type_of, data_type);
+    size_t last = first;
+    while (last < kTypes.size() && kTypes[last].data_type == data_type) ++last;
+    return {kTypes.data() + first, kTypes.data() + last};
+}
+
+bool in_type_preset(const MockTypeInfo& type, std::string_view preset) {
     if (preset == "BasicTypes") {
-        std::vector<MockTypeInfo> basic;
-        for (const auto& type : all_types) {
-            if (type.data_type == SQL_INTEGER || 
-                type.data_type == SQL_VARCHAR ||
-                type.data_type == SQL_TYPE_DATE) {
-                basic.push_back(type);
-            }
-        }
-        return basic;
-    } else if (preset == "NumericOnly") {
-        std::vector<MockTypeInfo> numeric;
-        for (const auto& type : all_types) {
-            if (type.data_type == SQL_SMALLINT ||
-                type.data_type == SQL_INTEGER ||
-                type.data_type == SQL_BIGINT ||
-                type.data_type == SQL_DECIMAL ||
-                type.data_type == SQL_NUMERIC ||
-                type.data_type == SQL_REAL ||
-                type.data_type == SQL_FLOAT ||
-                type.data_type == SQL_DOUBLE) {
-                numeric.push_back(type);
-            }
-        }
-        return numeric;
+        return type.data_type == SQL_INTEGER ||
+               type.data_type == SQL_VARCHAR ||
+               type.data_type == SQL_TYPE_DATE;
     }
-    
-    return all_types;
+    if (preset == "NumericOnly") {
+        return type.data_type == SQL_SMALLINT ||
+               type.data_type == SQL_INTEGER ||
+               type.data_type == SQL_BIGINT ||
+               type.data_type == SQL_DECIMAL ||
+               type.data_type == SQL_NUMERIC ||
+               type.data_type == SQL_REAL ||
+               type.data_type == SQL_FLOAT ||
+               type.data_type == SQL_DOUBLE;
+    }
+    return true;
 }
 
 const MockTypeInfo* get_type_info(SQLSMALLINT data_type) {
-    for (const auto& type : all_types) {
-        if (type.data_type == data_type) {
-            return &type;
-        }
-    }
-    return nullptr;
+    size_t i = lower_bound_by_key(kTypes, data_type_of, data_type);
+    return i < kTypes.size() && kTypes[i].data_type == data_type ? &kTypes[i] : nullptr;
 }
 
 } // namespace mock_odbc
@@ -1,26 +1,26 @@
 #pragma once
 
 #include "../driver/common.hpp"
-#include <string>
-#include <vector>
+#include <string_view>
 
 namespace mock_odbc {
 
-// SQL type information for SQLGetTypeInfo
+// SQL type information for SQLGetTypeInfo. Entries live in a compile-time
+// table, so the text fields view string literals.
 struct MockTypeInfo {
-    std::string type_name;
+    std::string_view type_name;
     SQLSMALLINT data_type;
     SQLINTEGER column_size;
-    std::string literal_prefix;
-    std::string literal_suffix;
-    std::string create_params;
+    std::string_view literal_prefix;
+    std::string_view literal_suffix;
+    std::string_view create_params;
     SQLSMALLINT nullable;
     SQLSMALLINT case_sensitive;
     SQLSMALLINT searchable;
     SQLSMALLINT unsigned_attribute;
     SQLSMALLINT fixed_prec_scale;
     SQLSMALLINT auto_unique_value;
-    std::string local_type_name;
+    std::string_view local_type_name;
     SQLSMALLINT minimum_scale;
     SQLSMALLINT maximum_scale;
     SQLSMALLINT sql_data_type;
@@ -29,8 +29,20 @@ struct MockTypeInfo {
     SQLSMALLINT interval_precision;
 };
 
-// Get all supported types
-std::vector<MockTypeInfo> get_mock_types(const std::string& preset = "AllTypes");
+// Consecutive entries of the type table
+struct MockTypeRange {
+    const MockTypeInfo* first = nullptr;
+    const MockTypeInfo* last = nullptr;
+    const MockTypeInfo* begin() const { return first; }
+    const MockTypeInfo* end() const { return last; }
+};
+
+// The types SQLGetTypeInfo reports for `data_type` (SQL_ALL_TYPES for all of
+// them), ordered by DATA_TYPE as its result set must be
+MockTypeRange find_mock_types(SQLSMALLINT data_type);
+
+// Whether `type` belongs to the Types= preset (AllTypes, BasicTypes, NumericOnly)
+bool in_type_preset(const MockTypeInfo& type, std::string_view preset);
 
 // Get type info for a specific SQL type
 const MockTypeInfo* get_type_info(SQLSMALLINT data_type);
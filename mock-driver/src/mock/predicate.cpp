@@ -0,0 +1,743 @@
+#include "predicate.hpp"
+#include "data_file.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <iterator>
+#include <numeric>
+
+namespace mock_odbc {
+
+namespace {
+
+using Node = Predicate::Node;
+using Operand = Predicate::Operand;
+using CompareOp = Predicate::CompareOp;
+using Truth = Predicate::Truth;
+
+// Rows per batch when scanning a whole table
+constexpr size_t kBatchRows = 1024;
+
+const CellValue kNullCell;
+
+std::string to_upper(const std::string& s) {
+    std::string result = s;
+    std::transform(result.begin(), result.end(), result.begin(),
+                   [](unsigned char c) { return std::toupper(c); });
+    return result;
+}
+
+bool is_null(const CellValue& v) {
+    return std::holds_alternative<std::monostate>(v);
+}
+
+// Parse all of `s` as a number
+bool parse_double(const std::string& s, double& out) {
+    if (s.empty()) return false;
+    char* end = nullptr;
+    out = std::strtod(s.c_str(), &end);
+    return end == s.c_str() + s.size();
+}
+
+bool as_number(const CellValue& v, double& out) {
+    if (auto* i = std::get_if<long long>(&v)) { out = static_cast<double>(*i); return true; }
+    if (auto* d = std::get_if<double>(&v)) { out = *d; return true; }
+    if (auto* s = std::get_if<std::string>(&v)) return parse_double(*s, out);
+    return false;
+}
+
+std::string cell_text(const CellValue& v) {
+    if (auto* s = std::get_if<std::string>(&v)) return *s;
+    if (auto* i = std::get_if<long long>(&v)) return std::to_string(*i);
+    if (auto* d = std::get_if<double>(&v)) {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.15g", *d);
+        return buf;
+    }
+    return std::string();
+}
+
+// SQL LIKE with % and _, case-sensitive
+bool like_match(const std::string& s, const std::string& p) {
+    size_t si = 0, pi = 0;
+    size_t star = std::string::npos, mark = 0;
+    while (si < s.size()) {
+        if (pi < p.size() && (p[pi] == '_' || p[pi] == s[si])) {
+            ++si;
+            ++pi;
+        } else if (pi < p.size() && p[pi] == '%') {
+            star = pi++;
+            mark = si;
+        } else if (star != std::string::npos) {
+            pi = star + 1;
+            si = ++mark;
+        } else {
+            return false;
+        }
+    }
+    while (pi < p.size() && p[pi] == '%') ++pi;
+    return pi == p.size();
+}
+
+// Literals compared with a column take the column's type, so a parameter
+// bound as text matches an integer column
+CellValue coerce(const CellValue& v, SQLSMALLINT data_type) {
+    const auto* s = std::get_if<std::string>(&v);
+    if (!s) return v;
+    switch (data_type) {
+        case SQL_INTEGER:
+        case SQL_BIGINT:
+        case SQL_SMALLINT:
+        case SQL_TINYINT:
+        case SQL_BIT: {
+            char* end = nullptr;
+            long long i = std::strtoll(s->c_str(), &end, 10);
+            if (!s->empty() && end == s->c_str() + s->size()) return i;
+            double d = 0;
+            if (parse_double(*s, d)) return d;
+            return v;
+        }
+        case SQL_DECIMAL:
+        case SQL_NUMERIC:
+        case SQL_REAL:
+        case SQL_FLOAT:
+        case SQL_DOUBLE: {
+            double d = 0;
+            if (parse_double(*s, d)) return d;
+            return v;
+        }
+        default:
+            return v;
+    }
+}
+
+CompareOp inverse(CompareOp op) {
+    switch (op) {
+        case CompareOp::Eq: return CompareOp::Ne;
+        case CompareOp::Ne: return CompareOp::Eq;
+        case CompareOp::Lt: return CompareOp::Ge;
+        case CompareOp::Le: return CompareOp::Gt;
+        case CompareOp::Gt: return CompareOp::Le;
+        case CompareOp::Ge: return CompareOp::Lt;
+    }
+    return op;
+}
+
+// The operator with its operands swapped: 5 < x is x > 5
+CompareOp mirror(CompareOp op) {
+    switch (op) {
+        case CompareOp::Lt: return CompareOp::Gt;
+        case CompareOp::Le: return CompareOp::Ge;
+        case CompareOp::Gt: return CompareOp::Lt;
+        case CompareOp::Ge: return CompareOp::Le;
+        default: return op;
+    }
+}
+
+// Push a NOT down to the leaves (De Morgan). A leaf and its negation are
+// both false on NULL, and NOT leaves an unknown constant unknown, so only
+// rows for which the condition is true match, as in SQL.
+void negate(Node& node) {
+    switch (node.kind) {
+        case Node::Kind::Constant:
+            if (node.constant == Truth::True) {
+                node.constant = Truth::False;
+            } else if (node.constant == Truth::False) {
+                node.constant = Truth::True;
+            }
+            break;
+        case Node::Kind::And:
+        case Node::Kind::Or:
+            node.kind = node.kind == Node::Kind::And ? Node::Kind::Or : Node::Kind::And;
+            for (auto& child : node.children) negate(child);
+            break;
+        case Node::Kind::Compare:
+            node.op = inverse(node.op);
+            break;
+        default:
+            node.negated = !node.negated;
+            break;
+    }
+}
+
+bool leaf_matches(const Node& node, const CellValue* const* v) {
+    switch (node.kind) {
+        case Node::Kind::Compare: {
+            if (is_null(*v[0]) || is_null(*v[1])) return false;
+            int c = compare_cells(*v[0], *v[1]);
+            switch (node.op) {
+                case CompareOp::Eq: return c == 0;
+                case CompareOp::Ne: return c != 0;
+                case CompareOp::Lt: return c < 0;
+                case CompareOp::Le: return c <= 0;
+                case CompareOp::Gt: return c > 0;
+                case CompareOp::Ge: return c >= 0;
+            }
+            return false;
+        }
+        case Node::Kind::Between: {
+            if (is_null(*v[0]) || is_null(*v[1]) || is_null(*v[2])) return false;
+            bool inside = compare_cells(*v[0], *v[1]) >= 0 && compare_cells(*v[0], *v[2]) <= 0;
+            return inside != node.negated;
+        }
+        case Node::Kind::In: {
+            if (is_null(*v[0])) return false;
+            bool saw_null = false;
+            for (size_t i = 1; i < node.args.size(); ++i) {
+                if (is_null(*v[i])) {
+                    saw_null = true;
+                } else if (compare_cells(*v[0], *v[i]) == 0) {
+                    return !node.negated;
+                }
+            }
+            return node.negated && !saw_null;
+        }
+        case Node::Kind::Like: {
+            if (is_null(*v[0]) || is_null(*v[1])) return false;
+            const auto* s = std::get_if<std::string>(v[0]);
+            const auto* p = std::get_if<std::string>(v[1]);
+            bool match = s && p ? like_match(*s, *p) : like_match(cell_text(*v[0]), cell_text(*v[1]));
+            return match != node.negated;
+        }
+        case Node::Kind::IsNull:
+            return is_null(*v[0]) != node.negated;
+        default:
+            return node.constant == Truth::True;
+    }
+}
+
+// Keep the rows of `selection` that satisfy a leaf
+void filter_leaf(const Node& node, const RowSource& source, std::vector<uint32_t>& selection) {
+    const size_t argc = node.args.size();
+    std::vector<const CellValue*> values(argc);
+    std::vector<CellValue> decoded(source.rows ? 0 : argc);
+    std::vector<size_t> column_args;
+    for (size_t i = 0; i < argc; ++i) {
+        if (node.args[i].is_column) {
+            column_args.push_back(i);
+        } else {
+            values[i] = &node.args[i].value;
+        }
+    }
+
+    size_t kept = 0;
+    for (uint32_t r : selection) {
+        for (size_t i : column_args) {
+            size_t column = node.args[i].column;
+            if (source.rows) {
+                const MockRow& row = (*source.rows)[r];
+                values[i] = column < row.size() ? &row[column] : &kNullCell;
+            } else {
+                decoded[i] = source.snapshot->cell(r, column);
+                values[i] = &decoded[i];
+            }
+        }
+        if (leaf_matches(node, values.data())) {
+            selection[kept++] = r;
+        }
+    }
+    selection.resize(kept);
+}
+
+struct Token {
+    enum class Type { Word, Quoted, Number, String, Param, Symbol, End };
+    Type type;
+    std::string text;
+};
+
+bool tokenize(const std::string& s, std::vector<Token>& tokens, std::string& error) {
+    size_t i = 0;
+    while (i < s.size()) {
+        unsigned char c = static_cast<unsigned char>(s[i]);
+        if (std::isspace(c)) {
+            ++i;
+        } else if (c == '\'') {
+            std::string value;
+            bool closed = false;
+            for (++i; i < s.size(); ++i) {
+                if (s[i] == '\'') {
+                    if (i + 1 < s.size() && s[i + 1] == '\'') {
+                        value += '\'';
+                        ++i;
+                        continue;
+                    }
+                    closed = true;
+                    ++i;
+                    break;
+                }
+                value += s[i];
+            }
+            if (!closed) {
+                error = "Unterminated string literal";
+                return false;
+            }
+            tokens.push_back({Token::Type::String, std::move(value)});
+        } else if (c == '"' || c == '[' || c == '`') {
+            char close = c == '[' ? ']' : static_cast<char>(c);
+            auto end = s.find(close, i + 1);
+            if (end == std::string::npos) {
+                error = "Unterminated quoted identifier";
+                return false;
+            }
+            tokens.push_back({Token::Type::Quoted, s.substr(i + 1, end - i - 1)});
+            i = end + 1;
+        } else if (std::isdigit(c) || (c == '.' && i + 1 < s.size() &&
+                                       std::isdigit(static_cast<unsigned char>(s[i + 1])))) {
+            size_t j = i;
+            while (j < s.size() && (std::isdigit(static_cast<unsigned char>(s[j])) || s[j] == '.')) ++j;
+            if (j < s.size() && (s[j] == 'e' || s[j] == 'E')) {
+                size_t k = j + 1;
+                if (k < s.size() && (s[k] == '+' || s[k] == '-')) ++k;
+                if (k < s.size() && std::isdigit(static_cast<unsigned char>(s[k]))) {
+                    j = k;
+                    while (j < s.size() && std::isdigit(static_cast<unsigned char>(s[j]))) ++j;
+                }
+            }
+            tokens.push_back({Token::Type::Number, s.substr(i, j - i)});
+            i = j;
+        } else if (std::isalpha(c) || c == '_') {
+            size_t j = i;
+            while (j < s.size() && (std::isalnum(static_cast<unsigned char>(s[j])) ||
+                                    s[j] == '_' || s[j] == '$' || s[j] == '#' || s[j] == '.')) {
+                ++j;
+            }
+            tokens.push_back({Token::Type::Word, s.substr(i, j - i)});
+            i = j;
+        } else if (c == '?') {
+            tokens.push_back({Token::Type::Param, "?"});
+            ++i;
+        } else {
+            std::string two = s.substr(i, 2);
+            if (two == "<>" || two == "!=" || two == "<=" || two == ">=") {
+                tokens.push_back({Token::Type::Symbol, two});
+                i += 2;
+            } else if (std::string("(),=<>-+").find(static_cast<char>(c)) != std::string::npos) {
+                tokens.push_back({Token::Type::Symbol, std::string(1, static_cast<char>(c))});
+                ++i;
+            } else {
+                error = std::string("Unexpected character '") + static_cast<char>(c) + "' in WHERE clause";
+                return false;
+            }
+        }
+    }
+    tokens.push_back({Token::Type::End, ""});
+    return true;
+}
+
+// Recursive descent over the tokens of one WHERE clause:
+//   or   := and { OR and }
+//   and  := not { AND not }
+//   not  := NOT not | '(' or ')' | condition
+class Parser {
+public:
+    Parser(const std::vector<Token>& tokens, const MockTable& table,
+           const std::vector<CellValue>& params, int first_param)
+        : tokens_(tokens), table_(table), params_(params), next_param_(first_param) {}
+
+    bool parse(Node& root) {
+        if (!parse_or(root)) return false;
+        if (peek().type != Token::Type::End) return fail("Unexpected '" + peek().text + "' in WHERE clause");
+        return true;
+    }
+
+    std::string sqlstate = "42000";
+    std::string error;
+
+private:
+    const Token& peek(size_t ahead = 0) const {
+        return tokens_[std::min(pos_ + ahead, tokens_.size() - 1)];
+    }
+
+    bool is_word(const char* keyword, size_t ahead = 0) const {
+        const Token& t = peek(ahead);
+        return t.type == Token::Type::Word && to_upper(t.text) == keyword;
+    }
+
+    bool accept_word(const char* keyword) {
+        if (!is_word(keyword)) return false;
+        ++pos_;
+        return true;
+    }
+
+    bool accept_symbol(const char* symbol) {
+        if (peek().type != Token::Type::Symbol || peek().text != symbol) return false;
+        ++pos_;
+        return true;
+    }
+
+    bool fail(const std::string& message) {
+        if (error.empty()) error = message;
+        return false;
+    }
+
+    bool parse_or(Node& out) {
+        return parse_list(out, Node::Kind::Or, "OR", &Parser::parse_and);
+    }
+
+    bool parse_and(Node& out) {
+        return parse_list(out, Node::Kind::And, "AND", &Parser::parse_not);
+    }
+
+    bool parse_list(Node& out, Node::Kind kind, const char* keyword, bool (Parser::*next)(Node&)) {
+        Node first;
+        if (!(this->*next)(first)) return false;
+        if (!is_word(keyword)) {
+            out = std::move(first);
+            return true;
+        }
+        Node list;
+        list.kind = kind;
+        list.children.push_back(std::move(first));
+        while (accept_word(keyword)) {
+            Node item;
+            if (!(this->*next)(item)) return false;
+            list.children.push_back(std::move(item));
+        }
+        out = std::move(list);
+        return true;
+    }
+
+    bool parse_not(Node& out) {
+        if (accept_word("NOT")) {
+            if (!parse_not(out)) return false;
+            negate(out);
+            return true;
+        }
+        if (accept_symbol("(")) {
+            if (!parse_or(out)) return false;
+            if (!accept_symbol(")")) return fail("Expected ')' in WHERE clause");
+            return true;
+        }
+        return parse_condition(out);
+    }
+
+    bool parse_condition(Node& out) {
+        Operand lhs;
+        if (!parse_operand(lhs)) return false;
+
+        Node leaf;
+        leaf.args.push_back(std::move(lhs));
+        if (accept_word("IS")) {
+            leaf.kind = Node::Kind::IsNull;
+            leaf.negated = accept_word("NOT");
+            if (!accept_word("NULL")) return fail("Expected NULL after IS");
+        } else {
+            if (is_word("NOT") && (is_word("BETWEEN", 1) || is_word("IN", 1) || is_word("LIKE", 1))) {
+                ++pos_;
+                leaf.negated = true;
+            }
+            if (accept_word("BETWEEN")) {
+                leaf.kind = Node::Kind::Between;
+                Operand low, high;
+                if (!parse_operand(low)) return false;
+                if (!accept_word("AND")) return fail("Expected AND in BETWEEN");
+                if (!parse_operand(high)) return false;
+                leaf.args.push_back(std::move(low));
+                leaf.args.push_back(std::move(high));
+            } else if (accept_word("IN")) {
+                leaf.kind = Node::Kind::In;
+                if (!accept_symbol("(")) return fail("Expected '(' after IN");
+                do {
+                    Operand item;
+                    if (!parse_operand(item)) return false;
+                    leaf.args.push_back(std::move(item));
+                } while (accept_symbol(","));
+                if (!accept_symbol(")")) return fail("Expected ')' after IN list");
+            } else if (accept_word("LIKE")) {
+                leaf.kind = Node::Kind::Like;
+                Operand pattern;
+                if (!parse_operand(pattern)) return false;
+                leaf.args.push_back(std::move(pattern));
+                if (is_word("ESCAPE")) return fail("LIKE ... ESCAPE is not supported");
+            } else if (leaf.negated) {
+                return fail("Expected BETWEEN, IN or LIKE after NOT");
+            } else {
+                leaf.kind = Node::Kind::Compare;
+                if (!parse_compare_op(leaf.op)) {
+                    return fail("Expected a comparison in WHERE clause near '" + peek().text + "'");
+                }
+                Operand rhs;
+                if (!parse_operand(rhs)) return false;
+                if (!leaf.args[0].is_column && rhs.is_column) {
+                    std::swap(leaf.args[0], rhs);
+                    leaf.op = mirror(leaf.op);
+                }
+                leaf.args.push_back(std::move(rhs));
+            }
+        }
+
+        finish_leaf(leaf);
+        out = std::move(leaf);
+        return true;
+    }
+
+    bool parse_compare_op(CompareOp& op) {
+        if (peek().type != Token::Type::Symbol) return false;
+        const std::string& s = peek().text;
+        if (s == "=") op = CompareOp::Eq;
+        else if (s == "<>" || s == "!=") op = CompareOp::Ne;
+        else if (s == "<") op = CompareOp::Lt;
+        else if (s == "<=") op = CompareOp::Le;
+        else if (s == ">") op = CompareOp::Gt;
+        else if (s == ">=") op = CompareOp::Ge;
+        else return false;
+        ++pos_;
+        return true;
+    }
+
+    bool parse_operand(Operand& out) {
+        const Token& t = peek();
+        switch (t.type) {
+            case Token::Type::Param: {
+                size_t n = static_cast<size_t>(next_param_++);
+                out.value = n >= 1 && n <= params_.size() ? params_[n - 1] : CellValue{};
+                ++pos_;
+                return true;
+            }
+            case Token::Type::String:
+                out.value = t.text;
+                ++pos_;
+                return true;
+            case Token::Type::Number:
+                out.value = parse_number(t.text, false);
+                ++pos_;
+                return true;
+            case Token::Type::Symbol:
+                if ((t.text == "-" || t.text == "+") && peek(1).type == Token::Type::Number) {
+                    out.value = parse_number(peek(1).text, t.text == "-");
+                    pos_ += 2;
+                    return true;
+                }
+                break;
+            case Token::Type::Quoted:
+                ++pos_;
+                return resolve_column(t.text, out);
+            case Token::Type::Word: {
+                std::string upper = to_upper(t.text);
+                if (upper == "NULL") {
+                    out.value = std::monostate{};
+                } else if (upper == "TRUE" || upper == "FALSE") {
+                    out.value = static_cast<long long>(upper == "TRUE");
+                } else if (upper == "AND" || upper == "OR" || upper == "NOT" || upper == "IN" ||
+                           upper == "IS" || upper == "LIKE" || upper == "BETWEEN") {
+                    break;
+                } else {
+                    ++pos_;
+                    auto dot = t.text.rfind('.');
+                    return resolve_column(dot == std::string::npos ? t.text : t.text.substr(dot + 1), out);
+                }
+                ++pos_;
+                return true;
+            }
+            default:
+                break;
+        }
+        return fail(t.type == Token::Type::End ? "Incomplete WHERE clause"
+                                              : "Expected a value near '" + t.text + "'");
+    }
+
+    static CellValue parse_number(const std::string& text, bool negative) {
+        if (text.find_first_of(".eE") == std::string::npos) {
+            errno = 0;
+            long long v = std::strtoll(text.c_str(), nullptr, 10);
+            if (errno != ERANGE) return negative ? -v : v;
+        }
+        double d = std::strtod(text.c_str(), nullptr);
+        return negative ? -d : d;
+    }
+
+    bool resolve_column(const std::string& name, Operand& out) {
+        std::string upper = to_upper(name);
+        for (size_t i = 0; i < table_.columns.size(); ++i) {
+            if (to_upper(table_.columns[i].name) == upper) {
+                out.is_column = true;
+                out.column = i;
+                return true;
+            }
+        }
+        sqlstate = "42S22";
+        return fail("Column not found: " + name);
+    }
+
+    // Give literals the type of the leaf's column, and fold a leaf without
+    // columns (such as 1 = 0) to a constant. A leaf that is neither true nor
+    // false when negated (such as NULL = 1) is unknown.
+    void finish_leaf(Node& leaf) {
+        const Operand* column = nullptr;
+        for (const auto& arg : leaf.args) {
+            if (arg.is_column) {
+                column = &arg;
+                break;
+            }
+        }
+        if (!column) {
+            std::vector<const CellValue*> values;
+            for (const auto& arg : leaf.args) values.push_back(&arg.value);
+            Node inverse = leaf;
+            negate(inverse);
+            Truth result = leaf_matches(leaf, values.data())    ? Truth::True
+                           : leaf_matches(inverse, values.data()) ? Truth::False
+                                                                  : Truth::Unknown;
+            leaf = Node{};
+            leaf.constant = result;
+            return;
+        }
+        SQLSMALLINT type = table_.columns[column->column].data_type;
+        for (auto& arg : leaf.args) {
+            if (!arg.is_column) arg.value = coerce(arg.value, type);
+        }
+    }
+
+    const std::vector<Token>& tokens_;
+    const MockTable& table_;
+    const std::vector<CellValue>& params_;
+    int next_param_;
+    size_t pos_ = 0;
+};
+
+} // anonymous namespace
+
+size_t RowSource::size() const {
+    if (rows) return rows->size();
+    if (snapshot) return snapshot->row_count();
+    return 0;
+}
+
+int compare_cells(const CellValue& a, const CellValue& b) {
+    auto sign = [](auto x, auto y) { return (x > y) - (x < y); };
+    const auto* ia = std::get_if<long long>(&a);
+    const auto* ib = std::get_if<long long>(&b);
+    if (ia && ib) return sign(*ia, *ib);
+    const auto* sa = std::get_if<std::string>(&a);
+    const auto* sb = std::get_if<std::string>(&b);
+    if (sa && sb) return sign(sa->compare(*sb), 0);
+    if (is_null(a) || is_null(b)) return sign(a.index(), b.index());
+    double x = 0, y = 0;
+    if (as_number(a, x) && as_number(b, y)) return sign(x, y);
+    // A string that isn't a number against a number: compare as text
+    return sign(cell_text(a).compare(cell_text(b)), 0);
+}
+
+bool Predicate::compile(const std::string& where, const MockTable& table,
+                        const std::vector<CellValue>& params, int first_param,
+                        std::string& sqlstate, std::string& error) {
+    root_ = Node{};
+    keys_.clear();
+
+    std::vector<Token> tokens;
+    if (!tokenize(where, tokens, error)) {
+        sqlstate = "42000";
+        return false;
+    }
+    Parser parser(tokens, table, params, first_param);
+    if (!parser.parse(root_)) {
+        sqlstate = parser.sqlstate;
+        error = parser.error;
+        return false;
+    }
+    collect_keys();
+    return true;
+}
+
+void Predicate::filter(const RowSource& source, std::vector<uint32_t>& selection) const {
+    eval(root_, source, selection);
+}
+
+std::vector<uint32_t> Predicate::scan(const RowSource& source) const {
+    std::vector<uint32_t> result;
+    std::vector<uint32_t> batch;
+    const size_t total = source.size();
+    for (size_t begin = 0; begin < total; begin += kBatchRows) {
+        size_t end = std::min(total, begin + kBatchRows);
+        batch.resize(end - begin);
+        std::iota(batch.begin(), batch.end(), static_cast<uint32_t>(begin));
+        eval(root_, source, batch);
+        result.insert(result.end(), batch.begin(), batch.end());
+    }
+    return result;
+}
+
+void Predicate::eval(const Node& node, const RowSource& source,
+                     std::vector<uint32_t>& selection) const {
+    if (selection.empty()) return;
+    switch (node.kind) {
+        case Node::Kind::Constant:
+            if (node.constant != Truth::True) selection.clear();
+            return;
+
+        case Node::Kind::And:
+            for (const auto& child : node.children) {
+                eval(child, source, selection);
+                if (selection.empty()) return;
+            }
+            return;
+
+        case Node::Kind::Or: {
+            // Each branch only tests the rows no earlier branch matched
+            std::vector<uint32_t> remaining = selection;
+            std::vector<uint32_t> matched, part, merged;
+            for (const auto& child : node.children) {
+                part = remaining;
+                eval(child, source, part);
+                if (part.empty()) continue;
+                merged.clear();
+                std::merge(matched.begin(), matched.end(), part.begin(), part.end(),
+                           std::back_inserter(merged));
+                matched.swap(merged);
+                merged.clear();
+                std::set_difference(remaining.begin(), remaining.end(), part.begin(), part.end(),
+                                    std::back_inserter(merged));
+                remaining.swap(merged);
+                if (remaining.empty()) break;
+            }
+            selection.swap(matched);
+            return;
+        }
+
+        default:
+            filter_leaf(node, source, selection);
+            return;
+    }
+}
+
+void Predicate::collect_keys() {
+    std::vector<const Node*> conjuncts;
+    if (root_.kind == Node::Kind::And) {
+        for (const auto& child : root_.children) conjuncts.push_back(&child);
+    } else {
+        conjuncts.push_back(&root_);
+    }
+
+    for (const Node* leaf : conjuncts) {
+        if (leaf->args.empty() || !leaf->args[0].is_column) continue;
+        bool values_only = std::none_of(leaf->args.begin() + 1, leaf->args.end(),
+                                        [](const Operand& a) { return a.is_column || is_null(a.value); });
+        if (!values_only) continue;
+
+        KeyCondition key;
+        key.column = leaf->args[0].column;
+        if (leaf->kind == Node::Kind::Compare) {
+            const CellValue& v = leaf->args[1].value;
+            switch (leaf->op) {
+                case CompareOp::Eq: key.keys.push_back(v); break;
+                case CompareOp::Lt: key.high = v; key.high_inclusive = false; break;
+                case CompareOp::Le: key.high = v; break;
+                case CompareOp::Gt: key.low = v; key.low_inclusive = false; break;
+                case CompareOp::Ge: key.low = v; break;
+                case CompareOp::Ne: continue;
+            }
+        } else if (leaf->kind == Node::Kind::Between && !leaf->negated) {
+            key.low = leaf->args[1].value;
+            key.high = leaf->args[2].value;
+        } else if (leaf->kind == Node::Kind::In && !leaf->negated) {
+            for (size_t i = 1; i < leaf->args.size(); ++i) key.keys.push_back(leaf->args[i].value);
+        } else {
+            continue;
+        }
+        keys_.push_back(std::move(key));
+    }
+}
+
+} // namespace mock_odbc
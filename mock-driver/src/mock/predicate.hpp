@@ -0,0 +1,93 @@
+#pragma once
+
+#include "mock_catalog.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace mock_odbc {
+
+// Rows a predicate reads: rows held in memory or a data-file snapshot
+struct RowSource {
+    const std::vector<MockRow>* rows = nullptr;
+    const TableSnapshot* snapshot = nullptr;
+
+    size_t size() const;
+};
+
+// Order two non-NULL cells. Integers and doubles compare by value, and a
+// numeric string compares as a number against a number.
+int compare_cells(const CellValue& a, const CellValue& b);
+
+// A top-level condition an index can answer: column = value, column IN
+// (...), or a range from <, <=, >, >= or BETWEEN
+struct KeyCondition {
+    size_t column = 0;
+    std::vector<CellValue> keys;          // Equality keys; empty for a range
+    std::optional<CellValue> low;
+    std::optional<CellValue> high;
+    bool low_inclusive = true;
+    bool high_inclusive = true;
+
+    bool is_range() const { return keys.empty(); }
+};
+
+// A compiled WHERE clause. Supports AND, OR, NOT, parentheses, comparisons
+// (=, <>, !=, <, <=, >, >=), [NOT] BETWEEN, [NOT] IN (...), [NOT] LIKE and
+// IS [NOT] NULL over columns, literals and parameter markers. Conditions
+// follow SQL's three-valued logic: a comparison with NULL is unknown, NOT
+// of unknown is still unknown, and a row matches only when the whole
+// condition is true.
+//
+// Rows are filtered a batch at a time: each condition narrows a selection
+// vector of row numbers, so AND only tests rows that passed its left side.
+class Predicate {
+public:
+    // Compile `where` against the columns of `table`. Parameter markers are
+    // numbered from `first_param` and take their values from `params`
+    // (marker n is params[n - 1]; missing ones are NULL). On failure sets
+    // `sqlstate` (42000 for syntax, 42S22 for an unknown column) and `error`.
+    bool compile(const std::string& where, const MockTable& table,
+                 const std::vector<CellValue>& params, int first_param,
+                 std::string& sqlstate, std::string& error);
+
+    // Drop the rows in `selection` (ascending row numbers) that don't match
+    void filter(const RowSource& source, std::vector<uint32_t>& selection) const;
+
+    // Every matching row of `source`, in order
+    std::vector<uint32_t> scan(const RowSource& source) const;
+
+    // ANDed conditions an index could answer; the full predicate must still
+    // be applied to the rows an index returns
+    const std::vector<KeyCondition>& key_conditions() const { return keys_; }
+
+    enum class CompareOp { Eq, Ne, Lt, Le, Gt, Ge };
+
+    struct Operand {
+        bool is_column = false;
+        size_t column = 0;
+        CellValue value;
+    };
+
+    enum class Truth { False, True, Unknown };
+
+    struct Node {
+        enum class Kind { Constant, And, Or, Compare, Between, In, Like, IsNull };
+        Kind kind = Kind::Constant;
+        CompareOp op = CompareOp::Eq;
+        bool negated = false;            // NOT BETWEEN, NOT IN, NOT LIKE, IS NOT NULL
+        Truth constant = Truth::True;    // Value of a Constant node
+        std::vector<Operand> args;       // Leaf operands; the column comes first when there is one
+        std::vector<Node> children;      // And, Or
+    };
+
+private:
+    void eval(const Node& node, const RowSource& source, std::vector<uint32_t>& selection) const;
+    void collect_keys();
+
+    Node root_;
+    std::vector<KeyCondition> keys_;
+};
+
+} // namespace mock_odbc
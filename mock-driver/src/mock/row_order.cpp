@@ -0,0 +1,193 @@
+#include "row_order.hpp"
+#include "data_file.hpp"
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+
+namespace mock_odbc {
+
+namespace {
+
+// Below this share of the input, a top-N heap beats a full sort
+constexpr size_t kPartialSortRatio = 8;
+
+// Values of one key for every row being ordered, by position in the input
+struct KeyColumn {
+    enum class Kind { Integer, Real, Text, Mixed };
+
+    Kind kind = Kind::Text;
+    bool descending = false;
+    bool nulls_first = true;
+    std::vector<uint8_t> nulls;
+    std::vector<long long> integers;
+    std::vector<double> reals;
+    std::vector<std::string_view> texts;
+    std::vector<std::string> owned;      // Text decoded from a data-file snapshot
+    std::vector<CellValue> cells;        // Mixed
+
+    // <0, 0 or >0 as row a sorts before, with or after row b
+    int compare(uint32_t a, uint32_t b) const {
+        if (nulls[a] || nulls[b]) {
+            if (nulls[a] == nulls[b]) return 0;
+            return (nulls[a] != 0) == nulls_first ? -1 : 1;
+        }
+        int c = 0;
+        switch (kind) {
+            case Kind::Integer: c = (integers[a] > integers[b]) - (integers[a] < integers[b]); break;
+            case Kind::Real: c = (reals[a] > reals[b]) - (reals[a] < reals[b]); break;
+            case Kind::Text: c = texts[a].compare(texts[b]); break;
+            case Kind::Mixed: c = compare_cells(cells[a], cells[b]); break;
+        }
+        return descending ? -c : c;
+    }
+};
+
+KeyColumn::Kind kind_for(SQLSMALLINT data_type) {
+    switch (data_type) {
+        case SQL_INTEGER:
+        case SQL_SMALLINT:
+        case SQL_TINYINT:
+        case SQL_BIGINT:
+        case SQL_BIT:
+            return KeyColumn::Kind::Integer;
+        case SQL_DOUBLE:
+        case SQL_FLOAT:
+        case SQL_REAL:
+        case SQL_DECIMAL:
+        case SQL_NUMERIC:
+            return KeyColumn::Kind::Real;
+        default:
+            return KeyColumn::Kind::Text;
+    }
+}
+
+// Copy cell `column` of each row into `cells`
+void read_cells(const RowSource& source, size_t column, const std::vector<uint32_t>& rows,
+                std::vector<CellValue>& cells) {
+    cells.clear();
+    cells.reserve(rows.size());
+    for (uint32_t r : rows) {
+        if (source.rows) {
+            const MockRow& row = (*source.rows)[r];
+            cells.push_back(column < row.size() ? row[column] : CellValue{});
+        } else {
+            cells.push_back(source.snapshot->cell(r, column));
+        }
+    }
+}
+
+// Fill `key` with the typed values of `column`; false when a cell doesn't
+// have the key's type
+bool extract_typed(const RowSource& source, size_t column, const std::vector<uint32_t>& rows,
+                   KeyColumn& key) {
+    const size_t n = rows.size();
+    key.nulls.assign(n, 0);
+    switch (key.kind) {
+        case KeyColumn::Kind::Integer: key.integers.resize(n); break;
+        case KeyColumn::Kind::Real: key.reals.resize(n); break;
+        default: key.texts.resize(n); break;
+    }
+    if (!source.rows && key.kind == KeyColumn::Kind::Text) {
+        key.owned.resize(n);
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        CellValue decoded;
+        const CellValue* cell = &decoded;
+        if (source.rows) {
+            const MockRow& row = (*source.rows)[rows[i]];
+            if (column < row.size()) cell = &row[column];
+        } else {
+            decoded = source.snapshot->cell(rows[i], column);
+        }
+
+        if (std::holds_alternative<std::monostate>(*cell)) {
+            key.nulls[i] = 1;
+            continue;
+        }
+        switch (key.kind) {
+            case KeyColumn::Kind::Integer:
+                if (const auto* v = std::get_if<long long>(cell)) {
+                    key.integers[i] = *v;
+                    continue;
+                }
+                return false;
+            case KeyColumn::Kind::Real:
+                if (const auto* v = std::get_if<double>(cell)) {
+                    key.reals[i] = *v;
+                    continue;
+                }
+                if (const auto* v = std::get_if<long long>(cell)) {
+                    key.reals[i] = static_cast<double>(*v);
+                    continue;
+                }
+                return false;
+            default:
+                if (const auto* v = std::get_if<std::string>(cell)) {
+                    if (source.rows) {
+                        key.texts[i] = *v;
+                    } else {
+                        key.owned[i] = std::move(std::get<std::string>(decoded));
+                        key.texts[i] = key.owned[i];
+                    }
+                    continue;
+                }
+                return false;
+        }
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+void order_rows(const RowSource& source, const std::vector<SortKey>& keys,
+                std::vector<uint32_t>& rows, size_t count) {
+    const size_t n = rows.size();
+    count = std::min(count, n);
+    if (keys.empty() || n < 2 || count == 0) return;
+
+    std::vector<KeyColumn> columns(keys.size());
+    for (size_t k = 0; k < keys.size(); ++k) {
+        KeyColumn& key = columns[k];
+        key.kind = kind_for(keys[k].data_type);
+        key.descending = keys[k].descending;
+        key.nulls_first = keys[k].nulls_first;
+        if (!extract_typed(source, keys[k].column, rows, key)) {
+            key.kind = KeyColumn::Kind::Mixed;
+            key.integers.clear();
+            key.reals.clear();
+            key.texts.clear();
+            key.owned.clear();
+            read_cells(source, keys[k].column, rows, key.cells);
+            for (size_t i = 0; i < n; ++i) {
+                key.nulls[i] = std::holds_alternative<std::monostate>(key.cells[i]) ? 1 : 0;
+            }
+        }
+    }
+
+    // Order positions in `rows`; ties keep the input order
+    std::vector<uint32_t> order(n);
+    std::iota(order.begin(), order.end(), 0u);
+    auto less = [&columns](uint32_t a, uint32_t b) {
+        for (const auto& key : columns) {
+            int c = key.compare(a, b);
+            if (c != 0) return c < 0;
+        }
+        return a < b;
+    };
+    if (count * kPartialSortRatio < n) {
+        std::partial_sort(order.begin(), order.begin() + count, order.end(), less);
+        order.resize(count);
+    } else {
+        std::sort(order.begin(), order.end(), less);
+    }
+
+    std::vector<uint32_t> sorted;
+    sorted.reserve(order.size());
+    for (uint32_t i : order) {
+        sorted.push_back(rows[i]);
+    }
+    rows = std::move(sorted);
+}
+
+} // namespace mock_odbc
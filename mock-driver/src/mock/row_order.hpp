@@ -0,0 +1,29 @@
+#pragma once
+
+#include "predicate.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace mock_odbc {
+
+// One ORDER BY key, resolved to a table column
+struct SortKey {
+    size_t column = 0;
+    SQLSMALLINT data_type = SQL_VARCHAR;   // Declared type; picks the key representation
+    bool descending = false;
+    bool nulls_first = true;
+};
+
+// Reorder `rows` (row numbers of `source`) by `keys`, keeping table order
+// between equal rows. Only the first `count` rows need to end up in order:
+// when that is a small part of the input, a bounded heap (partial_sort)
+// picks them instead of sorting everything, and `rows` is cut to `count`.
+//
+// Keys are copied out of the rows once into typed columns (integers,
+// doubles or string views) so the comparisons don't go through CellValue.
+// A column holding values of another type than declared falls back to
+// compare_cells().
+void order_rows(const RowSource& source, const std::vector<SortKey>& keys,
+                std::vector<uint32_t>& rows, size_t count);
+
+} // namespace mock_odbc
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+namespace mock_odbc {
+
+// Compile-time lookup tables: an array of entries written in whatever order
+// reads best, sorted by key during compilation and searched by binary
+// search. Keys are ODBC constants whose values differ between driver
+// managers' headers, so the order can't be written out by hand.
+
+// A braced list of entries as a std::array, counted by the compiler
+template <typename T, size_t N>
+constexpr std::array<T, N> to_array(const T (&entries)[N]) {
+    std::array<T, N> result{};
+    for (size_t i = 0; i < N; ++i) result[i] = entries[i];
+    return result;
+}
+
+// `entries` ordered by key(entry); entries with equal keys keep their order
+template <typename T, size_t N, typename Key>
+constexpr std::array<T, N> sort_by_key(std::array<T, N> entries, Key key) {
+    for (size_t i = 1; i < N; ++i) {
+        T entry = entries[i];
+        size_t j = i;
+        for (; j > 0 && key(entry) < key(entries[j - 1]); --j) entries[j] = entries[j - 1];
+        entries[j] = entry;
+    }
+    return entries;
+}
+
+template <typename T, size_t N, typename Key>
+constexpr bool keys_unique(const std::array<T, N>& sorted, Key key) {
+    for (size_t i = 1; i < N; ++i) {
+        if (!(key(sorted[i - 1]) < key(sorted[i]))) return false;
+    }
+    return true;
+}
+
+// Index of the first entry of `sorted` whose key is not less than `value`
+template <typename T, size_t N, typename Key, typename V>
+constexpr size_t lower_bound_by_key(const std::array<T, N>& sorted, Key key, V value) {
+    size_t first = 0;
+    size_t count = N;
+    while (count > 0) {
+        size_t half = count / 2;
+        if (key(sorted[first + half]) < value) {
+            first += half + 1;
+            count -= half + 1;
+        } else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+} // namespace mock_odbc
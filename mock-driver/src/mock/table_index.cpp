@@ -0,0 +1,174 @@
+#include "table_index.hpp"
+#include "data_file.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+
+namespace mock_odbc {
+
+namespace {
+
+// Hash keys compare by value whatever their type: 5, 5.0 and '5' are one
+// key. Over-matching is harmless since rows from an index are filtered by
+// the full predicate again.
+CellValue normalize_key(const CellValue& v) {
+    double d = 0;
+    if (const auto* s = std::get_if<std::string>(&v)) {
+        if (s->empty()) return v;
+        char* end = nullptr;
+        d = std::strtod(s->c_str(), &end);
+        if (end != s->c_str() + s->size()) return v;
+    } else if (const auto* p = std::get_if<double>(&v)) {
+        d = *p;
+    } else {
+        return v;
+    }
+    if (std::floor(d) == d && std::abs(d) < 9.2e18) {
+        return static_cast<long long>(d);
+    }
+    return d;
+}
+
+bool sorted_less(const std::pair<CellValue, uint32_t>& a, const std::pair<CellValue, uint32_t>& b) {
+    int c = compare_cells(a.first, b.first);
+    return c != 0 ? c < 0 : a.second < b.second;
+}
+
+} // anonymous namespace
+
+size_t TableIndex::KeyHash::operator()(const CellValue& v) const {
+    if (const auto* i = std::get_if<long long>(&v)) return std::hash<long long>()(*i);
+    if (const auto* d = std::get_if<double>(&v)) return std::hash<double>()(*d);
+    if (const auto* s = std::get_if<std::string>(&v)) return std::hash<std::string>()(*s);
+    return 0;
+}
+
+void TableIndex::catch_up(const RowSource& source) {
+    const size_t total = source.size();
+    if (total < indexed_rows_) {
+        reset();
+    }
+    if (kind_ == Kind::Hash) {
+        hash_.reserve(total);
+    } else {
+        sorted_.reserve(total);
+    }
+
+    for (size_t r = indexed_rows_; r < total; ++r) {
+        CellValue cell;
+        if (source.rows) {
+            const MockRow& row = (*source.rows)[r];
+            if (column_ < row.size()) cell = row[column_];
+        } else {
+            cell = source.snapshot->cell(r, column_);
+        }
+        // NULL never satisfies a condition an index answers
+        if (std::holds_alternative<std::monostate>(cell)) continue;
+
+        if (kind_ == Kind::Hash) {
+            hash_.emplace(normalize_key(cell), static_cast<uint32_t>(r));
+        } else {
+            if (!sorted_.empty() && compare_cells(cell, sorted_.back().first) < 0) {
+                sorted_dirty_ = true;
+            }
+            sorted_.emplace_back(std::move(cell), static_cast<uint32_t>(r));
+        }
+    }
+    indexed_rows_ = total;
+}
+
+void TableIndex::reset() {
+    hash_.clear();
+    sorted_.clear();
+    sorted_dirty_ = false;
+    indexed_rows_ = 0;
+}
+
+void TableIndex::update_row(uint32_t row, const CellValue& old_key, const CellValue& new_key) {
+    if (row >= indexed_rows_) return;
+    const bool had_key = !std::holds_alternative<std::monostate>(old_key);
+    const bool has_key = !std::holds_alternative<std::monostate>(new_key);
+
+    if (kind_ == Kind::Hash) {
+        if (had_key) {
+            auto range = hash_.equal_range(normalize_key(old_key));
+            for (auto it = range.first; it != range.second; ++it) {
+                if (it->second == row) {
+                    hash_.erase(it);
+                    break;
+                }
+            }
+        }
+        if (has_key) hash_.emplace(normalize_key(new_key), row);
+        return;
+    }
+
+    std::pair<CellValue, uint32_t> old_entry(old_key, row);
+    if (had_key) {
+        auto it = sorted_dirty_
+            ? std::find_if(sorted_.begin(), sorted_.end(),
+                           [row](const std::pair<CellValue, uint32_t>& e) { return e.second == row; })
+            : std::lower_bound(sorted_.begin(), sorted_.end(), old_entry, sorted_less);
+        if (it != sorted_.end() && it->second == row) sorted_.erase(it);
+    }
+    if (has_key) {
+        std::pair<CellValue, uint32_t> entry(new_key, row);
+        auto pos = sorted_dirty_ ? sorted_.end()
+                                 : std::upper_bound(sorted_.begin(), sorted_.end(), entry, sorted_less);
+        sorted_.insert(pos, std::move(entry));
+    }
+}
+
+bool TableIndex::lookup(const KeyCondition& condition, std::vector<uint32_t>& rows) {
+    rows.clear();
+    if (kind_ == Kind::Hash) {
+        if (condition.is_range()) return false;
+        for (const auto& key : condition.keys) {
+            auto range = hash_.equal_range(normalize_key(key));
+            for (auto it = range.first; it != range.second; ++it) {
+                rows.push_back(it->second);
+            }
+        }
+    } else {
+        if (sorted_dirty_) {
+            std::sort(sorted_.begin(), sorted_.end(), sorted_less);
+            sorted_dirty_ = false;
+        }
+        auto key_less = [](const std::pair<CellValue, uint32_t>& e, const CellValue& k) {
+            return compare_cells(e.first, k) < 0;
+        };
+        auto key_greater = [](const CellValue& k, const std::pair<CellValue, uint32_t>& e) {
+            return compare_cells(k, e.first) < 0;
+        };
+        auto lower = [&](const CellValue& k, bool inclusive) {
+            return inclusive ? std::lower_bound(sorted_.begin(), sorted_.end(), k, key_less)
+                             : std::upper_bound(sorted_.begin(), sorted_.end(), k, key_greater);
+        };
+        auto upper = [&](const CellValue& k, bool inclusive) {
+            return inclusive ? std::upper_bound(sorted_.begin(), sorted_.end(), k, key_greater)
+                             : std::lower_bound(sorted_.begin(), sorted_.end(), k, key_less);
+        };
+
+        if (!condition.is_range()) {
+            for (const auto& key : condition.keys) {
+                for (auto it = lower(key, true), end = upper(key, true); it < end; ++it) {
+                    rows.push_back(it->second);
+                }
+            }
+        } else {
+            auto begin = condition.low ? lower(*condition.low, condition.low_inclusive) : sorted_.begin();
+            auto end = condition.high ? upper(*condition.high, condition.high_inclusive) : sorted_.end();
+            for (auto it = begin; it < end; ++it) {
+                rows.push_back(it->second);
+            }
+        }
+    }
+
+    // Return rows in table order, each once (IN may repeat a key)
+    std::sort(rows.begin(), rows.end());
+    rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+    return true;
+}
+
+} // namespace mock_odbc
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "predicate.hpp"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace mock_odbc {
+
+// Index over one column of a stored table (rows inserted in memory or kept
+// in the data file), used to answer WHERE conditions without a scan.
+//
+// Indexes are maintained lazily: catch_up() adds the rows appended since
+// the last call. An UPDATE that keeps row numbers moves the changed keys
+// with update_row(); a DELETE renumbers rows and resets the index. A hash
+// index answers = and IN in O(1) per key; a sorted index also answers ranges.
+class TableIndex {
+public:
+    enum class Kind { Hash, Sorted };
+
+    TableIndex(std::string name, size_t column, Kind kind)
+        : name_(std::move(name)), column_(column), kind_(kind) {}
+
+    const std::string& name() const { return name_; }
+    size_t column() const { return column_; }
+    Kind kind() const { return kind_; }
+    size_t indexed_rows() const { return indexed_rows_; }
+
+    // Index rows [indexed_rows(), source.size())
+    void catch_up(const RowSource& source);
+
+    // Forget all rows, for when the table's rows were replaced
+    void reset();
+
+    // Row `row` now holds `new_key` instead of `old_key`; rows not indexed
+    // yet are left to catch_up()
+    void update_row(uint32_t row, const CellValue& old_key, const CellValue& new_key);
+
+    // Rows matching `condition`, ascending. False when the index can't
+    // answer it (a range on a hash index).
+    bool lookup(const KeyCondition& condition, std::vector<uint32_t>& rows);
+
+private:
+    struct KeyHash {
+        size_t operator()(const CellValue& v) const;
+    };
+
+    std::string name_;
+    size_t column_;
+    Kind kind_;
+    size_t indexed_rows_ = 0;
+
+    std::unordered_multimap<CellValue, uint32_t, KeyHash> hash_;
+    std::vector<std::pair<CellValue, uint32_t>> sorted_;   // By key, then row
+    bool sorted_dirty_ = false;                            // Rows appended out of order
+};
+
+} // namespace mock_odbc
@@ -1,8 +1,10 @@
 // Catalog API - SQLTables, SQLColumns, SQLPrimaryKeys, etc.
 
 #include "driver/handles.hpp"
+#include "driver/async_executor.hpp"
 #include "driver/diagnostics.hpp"
 #include "mock/mock_catalog.hpp"
+#include "mock/like_pattern.hpp"
 #include "mock/behaviors.hpp"
 #include "utils/string_utils.hpp"
 
@@ -17,10 +19,31 @@ void setup_catalog_result(StatementHandle* stmt,
     stmt->executed_ = true;
     stmt->cursor_open_ = true;
     stmt->current_row_ = -1;
+    stmt->wire_rows_received_ = 0;
     stmt->num_result_cols_ = static_cast<SQLSMALLINT>(col_names.size());
     stmt->column_names_ = col_names;
     stmt->column_types_ = col_types;
-    stmt->result_data_.clear();
+    stmt->clear_result_rows();
+}
+
+// A pattern argument of a catalog function, compiled once for the call. With
+// SQL_ATTR_METADATA_ID it is an identifier instead.
+LikePattern catalog_pattern(const StatementHandle* stmt, const std::string& argument) {
+    return stmt->metadata_id_ == SQL_TRUE ? LikePattern::identifier(argument)
+                                          : LikePattern(argument);
+}
+
+// Call `fn` for each table whose name `pattern` matches: a hash lookup when
+// the pattern is a plain name, else a scan of the catalog
+template <typename Fn>
+void for_each_table(const MockCatalog& catalog, const LikePattern& pattern, Fn&& fn) {
+    if (const std::string* name = pattern.exact_name()) {
+        if (const MockTable* table = catalog.find_table(*name)) fn(*table);
+        return;
+    }
+    for (const auto& table : catalog.tables()) {
+        if (pattern.matches(table.name)) fn(table);
+    }
 }
 
 } // anonymous namespace
@@ -40,15 +63,25 @@ SQLRETURN SQL_API SQLTables(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);    
     stmt->clear_diagnostics();
     
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLTables, false)) return SQL_ERROR;
+    
     const auto& config = BehaviorController::instance().config();
-    if (config.should_fail("SQLTables")) {
+    if (config.should_fail(DriverFunction::SQLTables)) {
         stmt->add_diagnostic(config.error_code, 0, "Simulated SQLTables failure");
         return SQL_ERROR;
     }
     
+    // Identifiers can't be left out the way patterns can
+    if (stmt->metadata_id_ == SQL_TRUE && !szTableName) {
+        stmt->add_diagnostic(sqlstate::INVALID_ARGUMENT_VALUE, 0,
+                             "TableName is a null pointer with SQL_ATTR_METADATA_ID set");
+        return SQL_ERROR;
+    }
+    
     std::string table_pattern = sql_to_string(szTableName, cbTableName);
     std::string type_pattern = sql_to_string(szTableType, cbTableType);
     
@@ -64,18 +97,14 @@ SQLRETURN SQL_API SQLTables(
     
     // Get matching tables
     MockCatalog& catalog = MockCatalog::instance();
+    std::lock_guard<std::mutex> catalog_lock(catalog.mutex());
+    LikePattern pattern = catalog_pattern(stmt, table_pattern);
     
-    for (const auto& table : catalog.tables()) {
-        // Filter by pattern
-        if (!table_pattern.empty() && table_pattern != "%" && 
-            !MockCatalog::matches_pattern(table.name, table_pattern)) {
-            continue;
-        }
-        
+    for_each_table(catalog, pattern, [&](const MockTable& table) {
         // Filter by type
         if (!type_pattern.empty() && type_pattern != "%" &&
             type_pattern.find(table.type) == std::string::npos) {
-            continue;
+            return;
         }
         
         std::vector<std::variant<std::monostate, long long, double, std::string>> row;
@@ -86,7 +115,7 @@ SQLRETURN SQL_API SQLTables(
         row.push_back(table.remarks);
         
         stmt->result_data_.push_back(std::move(row));
-    }
+    });
     
     stmt->row_count_ = static_cast<SQLLEN>(stmt->result_data_.size());
     
@@ -106,11 +135,14 @@ SQLRETURN SQL_API SQLColumns(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);    
     stmt->clear_diagnostics();
     
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLColumns, false)) return SQL_ERROR;
+    
     const auto& config = BehaviorController::instance().config();
-    if (config.should_fail("SQLColumns")) {
+    if (config.should_fail(DriverFunction::SQLColumns)) {
         stmt->add_diagnostic(config.error_code, 0, "Simulated SQLColumns failure");
         return SQL_ERROR;
     }
@@ -120,11 +152,15 @@ SQLRETURN SQL_API SQLColumns(
     (void)szSchemaName;
     (void)cbSchemaName;
     
+    if (stmt->metadata_id_ == SQL_TRUE && (!szTableName || !szColumnName)) {
+        stmt->add_diagnostic(sqlstate::INVALID_ARGUMENT_VALUE, 0,
+                             "TableName or ColumnName is a null pointer with SQL_ATTR_METADATA_ID set");
+        return SQL_ERROR;
+    }
+    
     std::string table_pattern = sql_to_string(szTableName, cbTableName);
     std::string column_pattern = sql_to_string(szColumnName, cbColumnName);
     
-    if (column_pattern.empty()) column_pattern = "%";
-    
     // Set up result columns as per ODBC spec (18 columns)
     setup_catalog_result(stmt,
         {"TABLE_CAT", "TABLE_SCHEM", "TABLE_NAME", "COLUMN_NAME", "DATA_TYPE",
@@ -137,16 +173,14 @@ SQLRETURN SQL_API SQLColumns(
          SQL_INTEGER, SQL_INTEGER, SQL_WVARCHAR});
     
     MockCatalog& catalog = MockCatalog::instance();
+    std::lock_guard<std::mutex> catalog_lock(catalog.mutex());
+    LikePattern table_match = catalog_pattern(stmt, table_pattern);
+    LikePattern column_match = catalog_pattern(stmt, column_pattern);
     
-    for (const auto& table : catalog.tables()) {
-        if (!table_pattern.empty() && table_pattern != "%" &&
-            !MockCatalog::matches_pattern(table.name, table_pattern)) {
-            continue;
-        }
-        
+    for_each_table(catalog, table_match, [&](const MockTable& table) {
         int ordinal = 1;
         for (const auto& col : table.columns) {
-            if (!MockCatalog::matches_pattern(col.name, column_pattern)) {
+            if (!column_match.matches(col.name)) {
                 continue;
             }
             
@@ -189,7 +223,7 @@ SQLRETURN SQL_API SQLColumns(
             stmt->result_data_.push_back(std::move(row));
             ordinal++;
         }
-    }
+    });
     
     stmt->row_count_ = static_cast<SQLLEN>(stmt->result_data_.size());
     
@@ -207,9 +241,12 @@ SQLRETURN SQL_API SQLPrimaryKeys(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);    
     stmt->clear_diagnostics();
     
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLPrimaryKeys, false)) return SQL_ERROR;
+    
     (void)szCatalogName;
     (void)cbCatalogName;
     (void)szSchemaName;
@@ -223,6 +260,7 @@ SQLRETURN SQL_API SQLPrimaryKeys(
         {SQL_WVARCHAR, SQL_WVARCHAR, SQL_WVARCHAR, SQL_WVARCHAR, SQL_SMALLINT, SQL_WVARCHAR});
     
     MockCatalog& catalog = MockCatalog::instance();
+    std::lock_guard<std::mutex> catalog_lock(catalog.mutex());
     auto pk_cols = catalog.get_primary_keys(table_name);
     
     int seq = 1;
@@ -260,9 +298,12 @@ SQLRETURN SQL_API SQLForeignKeys(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);    
     stmt->clear_diagnostics();
     
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLForeignKeys, false)) return SQL_ERROR;
+    
     (void)szPkCatalogName;
     (void)cbPkCatalogName;
     (void)szPkSchemaName;
@@ -285,6 +326,7 @@ SQLRETURN SQL_API SQLForeignKeys(
          SQL_SMALLINT, SQL_SMALLINT, SQL_SMALLINT, SQL_WVARCHAR, SQL_WVARCHAR, SQL_SMALLINT});
     
     MockCatalog& catalog = MockCatalog::instance();
+    std::lock_guard<std::mutex> catalog_lock(catalog.mutex());
     
     // Collect FK table names to iterate
     std::vector<std::string> fk_tables_to_check;
@@ -344,9 +386,12 @@ SQLRETURN SQL_API SQLStatistics(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);    
     stmt->clear_diagnostics();
     
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLStatistics, false)) return SQL_ERROR;
+    
     (void)szCatalogName;
     (void)cbCatalogName;
     (void)szSchemaName;
@@ -366,6 +411,7 @@ SQLRETURN SQL_API SQLStatistics(
          SQL_INTEGER, SQL_INTEGER, SQL_WVARCHAR});
     
     MockCatalog& catalog = MockCatalog::instance();
+    std::lock_guard<std::mutex> catalog_lock(catalog.mutex());
     auto indexes = catalog.get_statistics(table_name);
     
     for (const auto& idx : indexes) {
@@ -411,9 +457,12 @@ SQLRETURN SQL_API SQLSpecialColumns(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);    
     stmt->clear_diagnostics();
     
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLSpecialColumns, false)) return SQL_ERROR;
+    
     (void)szCatalogName;
     (void)cbCatalogName;
     (void)szSchemaName;
@@ -431,6 +480,7 @@ SQLRETURN SQL_API SQLSpecialColumns(
          SQL_INTEGER, SQL_SMALLINT, SQL_SMALLINT});
     
     MockCatalog& catalog = MockCatalog::instance();
+    std::lock_guard<std::mutex> catalog_lock(catalog.mutex());
     
     if (fColType == SQL_BEST_ROWID) {
         // Return primary key columns as row identifier
@@ -467,9 +517,12 @@ SQLRETURN SQL_API SQLProcedures(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);    
     stmt->clear_diagnostics();
     
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLProcedures, false)) return SQL_ERROR;
+    
     (void)szCatalogName;
     (void)cbCatalogName;
     (void)szSchemaName;
@@ -502,9 +555,12 @@ SQLRETURN SQL_API SQLProcedureColumns(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);    
     stmt->clear_diagnostics();
     
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLProcedureColumns, false)) return SQL_ERROR;
+    
     (void)szCatalogName;
     (void)cbCatalogName;
     (void)szSchemaName;
@@ -537,7 +593,9 @@ SQLRETURN SQL_API SQLTablePrivileges(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);    
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLTablePrivileges, false)) return SQL_ERROR;
     (void)szCatalogName;
     (void)cbCatalogName;
     (void)szSchemaName;
@@ -568,7 +626,9 @@ SQLRETURN SQL_API SQLColumnPrivileges(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);    
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLColumnPrivileges, false)) return SQL_ERROR;
     (void)szCatalogName;
     (void)cbCatalogName;
     (void)szSchemaName;
@@ -1,14 +1,38 @@
 // Connection API - SQLConnect, SQLDriverConnect, SQLDisconnect, etc.
 
 #include "driver/handles.hpp"
+#include "driver/async_executor.hpp"
 #include "driver/config.hpp"
 #include "driver/diagnostics.hpp"
 #include "mock/mock_catalog.hpp"
+#include "mock/data_generator.hpp"
 #include "mock/behaviors.hpp"
 #include "utils/string_utils.hpp"
+#include <mutex>
 
 using namespace mock_odbc;
 
+namespace {
+
+// The mock database, behaviors and data generator are process-wide. The
+// first connection builds them and they are kept while any connection is
+// open, so a second connection with the same connection string (a
+// reconnect, a pool filling up, a connect storm) neither wipes tables the
+// others are using nor rewrites the configuration they are reading. A
+// different connection string rebuilds them as before.
+struct SharedSetup {
+    std::mutex mutex;
+    size_t open_connections = 0;
+    std::string applied;
+};
+
+SharedSetup& shared_setup() {
+    static SharedSetup setup;
+    return setup;
+}
+
+} // anonymous namespace
+
 extern "C" {
 
 SQLRETURN SQL_API SQLConnect(
@@ -39,9 +63,26 @@ SQLRETURN SQL_API SQLConnect(
     conn->connection_string_ = "DSN=" + conn->dsn_ + ";UID=" + conn->uid_ + ";";
     
     // Parse configuration (use defaults for simple connect)
-    DriverConfig config;
-    BehaviorController::instance().set_config(config);
-    MockCatalog::instance().initialize(config.catalog);
+    {
+        auto& shared = shared_setup();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        if (shared.open_connections == 0 || shared.applied != conn->connection_string_) {
+            DriverConfig config;
+            auto& catalog = MockCatalog::instance();
+            std::lock_guard<std::mutex> catalog_lock(catalog.mutex());
+            BehaviorController::instance().set_config(config);
+            catalog.initialize(config.catalog);
+            std::string error;
+            DataGenerator::instance().configure(config, error);
+            shared.applied = conn->connection_string_;
+        }
+        ++shared.open_connections;
+    }
+    
+    // Autocommit may have been turned off before connecting
+    if (conn->autocommit_ == SQL_AUTOCOMMIT_OFF) {
+        conn->open_transaction();
+    }
     
     conn->connected_ = true;
     return SQL_SUCCESS;
@@ -75,15 +116,22 @@ SQLRETURN SQL_API SQLDriverConnect(
     
     // Parse configuration from connection string
     DriverConfig config = parse_connection_string(conn->connection_string_);
+    if (!config.bad_latency_function.empty()) {
+        conn->add_diagnostic(sqlstate::CONNECTION_FAILURE, 0,
+                            "Invalid Latency key: no per-function latency for '" +
+                            config.bad_latency_function + "'");
+        return SQL_ERROR;
+    }
     
     // Check if we should fail
-    if (config.should_fail("SQLDriverConnect")) {
+    if (config.should_fail(DriverFunction::SQLDriverConnect)) {
         conn->add_diagnostic(config.error_code, 0, "Simulated connection failure");
         return SQL_ERROR;
     }
     
     // Apply latency
-    config.apply_latency();
+    config.apply_latency(DriverFunction::SQLDriverConnect);
+    config.apply_round_trip();
     
     // Check max connections
     if (config.max_connections > 0) {
@@ -95,11 +143,36 @@ SQLRETURN SQL_API SQLDriverConnect(
         }
     }
     
-    // Store configuration
-    BehaviorController::instance().set_config(config);
+    conn->thread_safe_ = config.thread_safety != ThreadSafetyMode::None;
     
-    // Initialize catalog
-    MockCatalog::instance().initialize(config.catalog);
+    {
+        auto& shared = shared_setup();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        if (shared.open_connections == 0 || shared.applied != conn->connection_string_) {
+            // A failed setup leaves nothing reusable behind
+            shared.applied.clear();
+            
+            // Replace the configuration and rebuild the catalog under the
+            // mutex other connections' statements hold while they use it
+            auto& catalog = MockCatalog::instance();
+            std::lock_guard<std::mutex> catalog_lock(catalog.mutex());
+            BehaviorController::instance().set_config(config);
+            
+            // Initialize catalog (and attach the data file)
+            std::string error;
+            if (!catalog.initialize(config.catalog, config.catalog_tables, config.catalog_columns,
+                                    config.data_file, &error)) {
+                conn->add_diagnostic(sqlstate::CONNECTION_FAILURE, 0, error);
+                return SQL_ERROR;
+            }
+            if (!DataGenerator::instance().configure(config, error)) {
+                conn->add_diagnostic(sqlstate::CONNECTION_FAILURE, 0, error);
+                return SQL_ERROR;
+            }
+            shared.applied = conn->connection_string_;
+        }
+        ++shared.open_connections;
+    }
     
     // Set up transaction mode
     if (config.transaction_mode == "ReadOnly") {
@@ -108,6 +181,9 @@ SQLRETURN SQL_API SQLDriverConnect(
     if (config.transaction_mode == "Manual") {
         conn->autocommit_ = SQL_AUTOCOMMIT_OFF;
     }
+    if (conn->autocommit_ == SQL_AUTOCOMMIT_OFF) {
+        conn->open_transaction();
+    }
     conn->txn_isolation_ = config.isolation_level;
     
     conn->connected_ = true;
@@ -135,6 +211,15 @@ SQLRETURN SQL_API SQLDisconnect(SQLHDBC hdbc) {
         return SQL_ERROR;
     }
     
+    // Statements still executing asynchronously must finish first
+    for (auto* stmt : conn->statements_) {
+        if (stmt->async_op_) {
+            conn->add_diagnostic(sqlstate::FUNCTION_SEQUENCE_ERROR, 0,
+                                "Asynchronously executing statement on this connection");
+            return SQL_ERROR;
+        }
+    }
+    
     // Check for open statements with transactions
     // (simplified - just close all statements)
     for (auto* stmt : conn->statements_) {
@@ -142,7 +227,18 @@ SQLRETURN SQL_API SQLDisconnect(SQLHDBC hdbc) {
         stmt->executed_ = false;
     }
     
+    // An open transaction is rolled back
+    if (conn->transaction_) {
+        std::lock_guard<std::mutex> lock(MockCatalog::instance().mutex());
+        conn->transaction_.reset();
+    }
+    
     conn->connected_ = false;
+    {
+        auto& shared = shared_setup();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        --shared.open_connections;
+    }
     conn->connection_string_.clear();
     conn->dsn_.clear();
     conn->uid_.clear();
@@ -205,6 +301,11 @@ SQLRETURN SQL_API SQLGetConnectAttr(
             if (pcbValue) *pcbValue = static_cast<SQLINTEGER>(conn->current_catalog_name_.length());
             break;
             
+        case SQL_ATTR_METADATA_ID:
+            if (rgbValue) *static_cast<SQLULEN*>(rgbValue) = conn->metadata_id_;
+            if (pcbValue) *pcbValue = sizeof(SQLULEN);
+            break;
+            
         default:
             conn->add_diagnostic(sqlstate::INVALID_ATTRIBUTE_VALUE, 0,
                                 "Unknown connection attribute");
@@ -233,9 +334,26 @@ SQLRETURN SQL_API SQLSetConnectAttr(
             conn->access_mode_ = reinterpret_cast<SQLUINTEGER>(rgbValue);
             break;
             
-        case SQL_ATTR_AUTOCOMMIT:
-            conn->autocommit_ = reinterpret_cast<SQLUINTEGER>(rgbValue);
+        case SQL_ATTR_AUTOCOMMIT: {
+            SQLUINTEGER autocommit = reinterpret_cast<SQLUINTEGER>(rgbValue);
+            // Turning autocommit on commits the open transaction
+            if (autocommit == SQL_AUTOCOMMIT_ON && conn->transaction_) {
+                auto& catalog = MockCatalog::instance();
+                std::lock_guard<std::mutex> lock(catalog.mutex());
+                std::string state, message;
+                bool committed = catalog.commit(*conn->transaction_, state, message);
+                conn->transaction_.reset();
+                if (!committed) {
+                    conn->add_diagnostic(state, 0, message);
+                    return SQL_ERROR;
+                }
+            }
+            if (autocommit == SQL_AUTOCOMMIT_OFF && conn->connected_) {
+                conn->open_transaction();
+            }
+            conn->autocommit_ = autocommit;
             break;
+        }
             
         case SQL_ATTR_CONNECTION_TIMEOUT:
             conn->connection_timeout_ = reinterpret_cast<SQLUINTEGER>(rgbValue);
@@ -249,6 +367,12 @@ SQLRETURN SQL_API SQLSetConnectAttr(
             conn->txn_isolation_ = reinterpret_cast<SQLUINTEGER>(rgbValue);
             break;
             
+        case SQL_ATTR_METADATA_ID:
+            // A statement attribute; set on the connection it applies to
+            // the statements allocated afterwards
+            conn->metadata_id_ = reinterpret_cast<SQLULEN>(rgbValue);
+            break;
+            
         case SQL_ATTR_CONNECTION_DEAD:
             // Read-only attribute
             conn->add_diagnostic(sqlstate::INVALID_ATTRIBUTE_VALUE, 0,
@@ -1,6 +1,7 @@
 // Descriptor API - SQLGetDescField, SQLSetDescField, etc.
 
 #include "driver/handles.hpp"
+#include "driver/async_executor.hpp"
 #include "driver/diagnostics.hpp"
 
 using namespace mock_odbc;
@@ -164,6 +165,7 @@ SQLRETURN SQL_API SQLColAttribute(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     if (iCol < 1 || iCol > static_cast<SQLUSMALLINT>(stmt->column_names_.size())) {
         stmt->add_diagnostic(sqlstate::INVALID_PARAMETER_NUMBER, 0,
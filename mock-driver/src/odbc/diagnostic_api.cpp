@@ -47,7 +47,7 @@ SQLRETURN SQL_API SQLGetDiagRec(
     
     // Copy SQLSTATE
     if (szSqlState) {
-        std::memcpy(szSqlState, rec->sqlstate.c_str(), 5);
+        std::memcpy(szSqlState, rec->sqlstate, 5);
         szSqlState[5] = '\0';
     }
     
@@ -58,10 +58,11 @@ SQLRETURN SQL_API SQLGetDiagRec(
     
     // Copy message
     SQLRETURN ret = SQL_SUCCESS;
+    std::string_view message = handle->diagnostic_message(*rec);
     if (szErrorMsg && cbErrorMsgMax > 0) {
-        ret = copy_string_to_buffer(rec->message, szErrorMsg, cbErrorMsgMax, pcbErrorMsg);
+        ret = copy_string_to_buffer(message, szErrorMsg, cbErrorMsgMax, pcbErrorMsg);
     } else if (pcbErrorMsg) {
-        *pcbErrorMsg = static_cast<SQLSMALLINT>(rec->message.length());
+        *pcbErrorMsg = static_cast<SQLSMALLINT>(message.length());
     }
     
     return ret;
@@ -166,7 +167,7 @@ SQLRETURN SQL_API SQLGetDiagField(
             return SQL_SUCCESS;
             
         case SQL_DIAG_MESSAGE_TEXT:
-            return copy_string_to_buffer(rec->message,
+            return copy_string_to_buffer(handle->diagnostic_message(*rec),
                                         static_cast<SQLCHAR*>(rgbDiagInfo),
                                         cbDiagInfoMax, pcbDiagInfo);
             
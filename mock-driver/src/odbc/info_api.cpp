@@ -1,7 +1,9 @@
 // Info API - SQLGetInfo, SQLGetTypeInfo, SQLGetFunctions
 
 #include "driver/handles.hpp"
+#include "driver/async_executor.hpp"
 #include "driver/diagnostics.hpp"
+#include "mock/info_table.hpp"
 #include "mock/mock_types.hpp"
 #include "mock/behaviors.hpp"
 #include "utils/string_utils.hpp"
@@ -148,349 +150,49 @@ SQLRETURN SQL_API SQLGetInfo(
     
     conn->clear_diagnostics();
     
-    const auto& config = BehaviorController::instance().config();
-    
-    #define RETURN_STRING(s) \
-        return copy_string_to_buffer(s, static_cast<SQLCHAR*>(rgbInfoValue), \
-                                     cbInfoValueMax, pcbInfoValue)
-    
-    #define RETURN_USHORT(v) \
-        if (rgbInfoValue) *static_cast<SQLUSMALLINT*>(rgbInfoValue) = (v); \
-        if (pcbInfoValue) *pcbInfoValue = sizeof(SQLUSMALLINT); \
-        return SQL_SUCCESS
-    
-    #define RETURN_ULONG(v) \
-        if (rgbInfoValue) *static_cast<SQLUINTEGER*>(rgbInfoValue) = (v); \
-        if (pcbInfoValue) *pcbInfoValue = sizeof(SQLUINTEGER); \
-        return SQL_SUCCESS
+    // Answers come from a compile-time table (mock/info_table.hpp); only
+    // the few that depend on the connection or configuration are looked up
+    const InfoValue* info = find_info(fInfoType);
+    if (!info) {
+        conn->add_diagnostic(sqlstate::INVALID_INFO_TYPE, 0,
+                            "Information type out of range");
+        return SQL_ERROR;
+    }
     
-    switch (fInfoType) {
-        // Driver Information
-        case SQL_DRIVER_NAME:
-            RETURN_STRING("mockodbc.dll");
-            
-        case SQL_DRIVER_VER:
-            RETURN_STRING(config.driver_version);
-            
-        case SQL_DRIVER_ODBC_VER:
-            RETURN_STRING(config.driver_odbc_version);
-            
-        case SQL_ODBC_VER:
-            RETURN_STRING("03.80.0000");
-            
-        // DBMS Information
-        case SQL_DBMS_NAME:
-            RETURN_STRING(config.dbms_name);
-            
-        case SQL_DBMS_VER:
-            RETURN_STRING(config.dbms_version);
-            
-        case SQL_SERVER_NAME:
-            RETURN_STRING("MockDBServer");
-            
-        // Data Source Information
-        case SQL_DATA_SOURCE_NAME:
-            RETURN_STRING(conn->dsn_);
-            
-        case SQL_DATA_SOURCE_READ_ONLY:
-            RETURN_STRING(conn->access_mode_ == SQL_MODE_READ_ONLY ? "Y" : "N");
-            
-        case SQL_DATABASE_NAME:
-            RETURN_STRING("MockDatabase");
-            
-        case SQL_USER_NAME:
-            RETURN_STRING(conn->uid_);
-            
-        // Supported SQL
-        case SQL_SQL_CONFORMANCE:
-            RETURN_ULONG(SQL_SC_SQL92_INTERMEDIATE);
-            
-        case SQL_ODBC_SQL_CONFORMANCE:
-            RETURN_USHORT(SQL_OSC_CORE);
-            
-        // Cursor Characteristics
-        case SQL_CURSOR_COMMIT_BEHAVIOR:
-            RETURN_USHORT(SQL_CB_CLOSE);
-            
-        case SQL_CURSOR_ROLLBACK_BEHAVIOR:
-            RETURN_USHORT(SQL_CB_CLOSE);
-            
-        case SQL_CURSOR_SENSITIVITY:
-            RETURN_ULONG(SQL_INSENSITIVE);
-            
-        case SQL_SCROLL_OPTIONS:
-            RETURN_ULONG(SQL_SO_FORWARD_ONLY | SQL_SO_STATIC);
-            
-        case SQL_STATIC_CURSOR_ATTRIBUTES1:
-            RETURN_ULONG(SQL_CA1_NEXT | SQL_CA1_ABSOLUTE | SQL_CA1_RELATIVE);
-            
-        case SQL_FORWARD_ONLY_CURSOR_ATTRIBUTES1:
-            RETURN_ULONG(SQL_CA1_NEXT);
-            
-        case SQL_DYNAMIC_CURSOR_ATTRIBUTES1:
-            RETURN_ULONG(0);
-            
-        case SQL_KEYSET_CURSOR_ATTRIBUTES1:
-            RETURN_ULONG(0);
-            
-        // Transaction Support
-        case SQL_TXN_CAPABLE:
-            RETURN_USHORT(SQL_TC_ALL);
-            
-        case SQL_TXN_ISOLATION_OPTION:
-            RETURN_ULONG(SQL_TXN_READ_UNCOMMITTED | SQL_TXN_READ_COMMITTED | 
-                        SQL_TXN_REPEATABLE_READ | SQL_TXN_SERIALIZABLE);
-            
-        case SQL_DEFAULT_TXN_ISOLATION:
-            RETURN_ULONG(SQL_TXN_READ_COMMITTED);
-            
-        // Identifier Case
-        case SQL_IDENTIFIER_CASE:
-            RETURN_USHORT(SQL_IC_UPPER);
-            
-        case SQL_IDENTIFIER_QUOTE_CHAR:
-            RETURN_STRING("\"");
-            
-        // Catalog Support
-        case SQL_CATALOG_NAME:
-            RETURN_STRING("Y");
-            
-        case SQL_CATALOG_NAME_SEPARATOR:
-            RETURN_STRING(".");
-            
-        case SQL_CATALOG_TERM:
-            RETURN_STRING("catalog");
-            
-        case SQL_SCHEMA_TERM:
-            RETURN_STRING("schema");
-            
-        case SQL_TABLE_TERM:
-            RETURN_STRING("table");
-            
-        case SQL_PROCEDURE_TERM:
-            RETURN_STRING("procedure");
-            
-        // Max Lengths
-        case SQL_MAX_CATALOG_NAME_LEN:
-            RETURN_USHORT(128);
-            
-        case SQL_MAX_SCHEMA_NAME_LEN:
-            RETURN_USHORT(128);
-            
-        case SQL_MAX_TABLE_NAME_LEN:
-            RETURN_USHORT(128);
-            
-        case SQL_MAX_COLUMN_NAME_LEN:
-            RETURN_USHORT(128);
-            
-        case SQL_MAX_CURSOR_NAME_LEN:
-            RETURN_USHORT(64);
-            
-        case SQL_MAX_IDENTIFIER_LEN:
-            RETURN_USHORT(128);
-            
-        case SQL_MAX_PROCEDURE_NAME_LEN:
-            RETURN_USHORT(128);
-            
-        case SQL_MAX_USER_NAME_LEN:
-            RETURN_USHORT(128);
-            
-        case SQL_MAX_DRIVER_CONNECTIONS:
-            RETURN_USHORT(config.max_connections > 0 ? config.max_connections : 0);
-            
-        case SQL_MAX_CONCURRENT_ACTIVITIES:
-            RETURN_USHORT(0);  // No limit
-            
-        // Feature Support
-        case SQL_GETDATA_EXTENSIONS:
-            RETURN_ULONG(SQL_GD_ANY_COLUMN | SQL_GD_ANY_ORDER | SQL_GD_BOUND);
-            
-        case SQL_PARAM_ARRAY_ROW_COUNTS:
-            RETURN_ULONG(SQL_PARC_BATCH);
-            
-        case SQL_PARAM_ARRAY_SELECTS:
-            RETURN_ULONG(SQL_PAS_NO_SELECT);
-            
-        case SQL_BATCH_ROW_COUNT:
-            RETURN_ULONG(SQL_BRC_EXPLICIT);
-            
-        case SQL_BATCH_SUPPORT:
-            RETURN_ULONG(SQL_BS_SELECT_EXPLICIT | SQL_BS_ROW_COUNT_EXPLICIT);
-            
-        case SQL_BOOKMARK_PERSISTENCE:
-            RETURN_ULONG(0);
-            
-        case SQL_DESCRIBE_PARAMETER:
-            RETURN_STRING("Y");
-            
-        case SQL_MULT_RESULT_SETS:
-            RETURN_STRING("N");
-            
-        case SQL_MULTIPLE_ACTIVE_TXN:
-            RETURN_STRING("Y");
-            
-        case SQL_NEED_LONG_DATA_LEN:
-            RETURN_STRING("N");
-            
-        case SQL_NULL_COLLATION:
-            RETURN_USHORT(SQL_NC_HIGH);
-            
-        case SQL_OUTER_JOINS:
-            RETURN_STRING("Y");
-            
-        case SQL_ORDER_BY_COLUMNS_IN_SELECT:
-            RETURN_STRING("N");
-            
-        case SQL_PROCEDURES:
-            RETURN_STRING("N");
-            
-        case SQL_ROW_UPDATES:
-            RETURN_STRING("N");
-            
-        case SQL_SEARCH_PATTERN_ESCAPE:
-            RETURN_STRING("\\");
-            
-        case SQL_SPECIAL_CHARACTERS:
-            RETURN_STRING("");
-            
-        // Numeric Functions
-        case SQL_NUMERIC_FUNCTIONS:
-            RETURN_ULONG(SQL_FN_NUM_ABS | SQL_FN_NUM_CEILING | SQL_FN_NUM_FLOOR |
-                        SQL_FN_NUM_ROUND | SQL_FN_NUM_SQRT);
-            
-        // String Functions
-        case SQL_STRING_FUNCTIONS:
-            RETURN_ULONG(SQL_FN_STR_CONCAT | SQL_FN_STR_LENGTH | SQL_FN_STR_LTRIM |
-                        SQL_FN_STR_RTRIM | SQL_FN_STR_SUBSTRING | SQL_FN_STR_UCASE |
-                        SQL_FN_STR_LCASE);
-            
-        // System Functions
-        case SQL_SYSTEM_FUNCTIONS:
-            RETURN_ULONG(SQL_FN_SYS_DBNAME | SQL_FN_SYS_USERNAME);
-            
-        // Timedate Functions
-        case SQL_TIMEDATE_FUNCTIONS:
-            RETURN_ULONG(SQL_FN_TD_NOW | SQL_FN_TD_CURDATE | SQL_FN_TD_CURTIME |
-                        SQL_FN_TD_YEAR | SQL_FN_TD_MONTH | SQL_FN_TD_DAYOFWEEK);
-            
-        // Convert Functions
-        case SQL_CONVERT_FUNCTIONS:
-            RETURN_ULONG(SQL_FN_CVT_CAST | SQL_FN_CVT_CONVERT);
-            
-        // Aggregate Functions
-        case SQL_AGGREGATE_FUNCTIONS:
-            RETURN_ULONG(SQL_AF_AVG | SQL_AF_COUNT | SQL_AF_MAX | SQL_AF_MIN | SQL_AF_SUM);
-            
-        // SQL Subqueries
-        case SQL_SUBQUERIES:
-            RETURN_ULONG(SQL_SQ_COMPARISON | SQL_SQ_EXISTS | SQL_SQ_IN);
-            
-        // Union Support
-        case SQL_UNION:
-            RETURN_ULONG(SQL_U_UNION | SQL_U_UNION_ALL);
-            
-        // Async Mode
-        case SQL_ASYNC_MODE:
-            RETURN_ULONG(SQL_AM_NONE);
-            
-        // Outer Join capabilities
-        case SQL_OJ_CAPABILITIES:
-            RETURN_ULONG(SQL_OJ_LEFT | SQL_OJ_RIGHT | SQL_OJ_NOT_ORDERED |
-                        SQL_OJ_ALL_COMPARISON_OPS);
-
-        // LIKE escape clause
-        case SQL_LIKE_ESCAPE_CLAUSE:
-            RETURN_STRING("Y");
-
-        // Datetime literals
-        case SQL_DATETIME_LITERALS:
-            RETURN_ULONG(SQL_DL_SQL92_DATE | SQL_DL_SQL92_TIME | SQL_DL_SQL92_TIMESTAMP);
-
-        // Timedate add/diff intervals
-        case SQL_TIMEDATE_ADD_INTERVALS:
-            RETURN_ULONG(SQL_FN_TSI_DAY | SQL_FN_TSI_MONTH | SQL_FN_TSI_YEAR |
-                        SQL_FN_TSI_HOUR | SQL_FN_TSI_MINUTE | SQL_FN_TSI_SECOND);
-
-        case SQL_TIMEDATE_DIFF_INTERVALS:
-            RETURN_ULONG(SQL_FN_TSI_DAY | SQL_FN_TSI_MONTH | SQL_FN_TSI_YEAR |
-                        SQL_FN_TSI_HOUR | SQL_FN_TSI_MINUTE | SQL_FN_TSI_SECOND);
-
-        // SQL_CONVERT_* types — support basic conversions
-        case SQL_CONVERT_CHAR:
-        case SQL_CONVERT_VARCHAR:
-        case SQL_CONVERT_LONGVARCHAR:
-            RETURN_ULONG(SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_INTEGER |
-                        SQL_CVT_DOUBLE | SQL_CVT_DATE | SQL_CVT_TIMESTAMP);
-
-        case SQL_CONVERT_INTEGER:
-        case SQL_CONVERT_SMALLINT:
-        case SQL_CONVERT_BIGINT:
-        case SQL_CONVERT_TINYINT:
-            RETURN_ULONG(SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_INTEGER |
-                        SQL_CVT_SMALLINT | SQL_CVT_BIGINT | SQL_CVT_DOUBLE |
-                        SQL_CVT_DECIMAL | SQL_CVT_NUMERIC);
-
-        case SQL_CONVERT_DECIMAL:
-        case SQL_CONVERT_NUMERIC:
-        case SQL_CONVERT_DOUBLE:
-        case SQL_CONVERT_FLOAT:
-        case SQL_CONVERT_REAL:
-            RETURN_ULONG(SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_INTEGER |
-                        SQL_CVT_DOUBLE | SQL_CVT_DECIMAL | SQL_CVT_NUMERIC |
-                        SQL_CVT_FLOAT | SQL_CVT_REAL);
-
-        case SQL_CONVERT_DATE:
-            RETURN_ULONG(SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_DATE |
-                        SQL_CVT_TIMESTAMP);
-
-        case SQL_CONVERT_TIME:
-            RETURN_ULONG(SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_TIME |
-                        SQL_CVT_TIMESTAMP);
-
-        case SQL_CONVERT_TIMESTAMP:
-            RETURN_ULONG(SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_DATE |
-                        SQL_CVT_TIME | SQL_CVT_TIMESTAMP);
-
-        case SQL_CONVERT_BIT:
-            RETURN_ULONG(SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_INTEGER |
-                        SQL_CVT_BIT);
-
-        case SQL_CONVERT_BINARY:
-        case SQL_CONVERT_VARBINARY:
-        case SQL_CONVERT_LONGVARBINARY:
-            RETURN_ULONG(SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_BINARY |
-                        SQL_CVT_VARBINARY | SQL_CVT_LONGVARBINARY);
-
-        case SQL_CONVERT_WCHAR:
-        case SQL_CONVERT_WVARCHAR:
-        case SQL_CONVERT_WLONGVARCHAR:
-            RETURN_ULONG(SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_WCHAR |
-                        SQL_CVT_WVARCHAR | SQL_CVT_INTEGER | SQL_CVT_DOUBLE);
-
-        case SQL_CONVERT_GUID:
-            RETURN_ULONG(SQL_CVT_CHAR | SQL_CVT_VARCHAR | SQL_CVT_GUID);
-
-        // ODBC Interface Conformance
-        case SQL_ODBC_INTERFACE_CONFORMANCE:
-            RETURN_ULONG(SQL_OIC_CORE);
-
-        // SQL92 Features
-        case SQL_SQL92_PREDICATES:
-            RETURN_ULONG(SQL_SP_BETWEEN | SQL_SP_COMPARISON | SQL_SP_EXISTS |
-                        SQL_SP_IN | SQL_SP_ISNOTNULL | SQL_SP_ISNULL | SQL_SP_LIKE);
-            
-        case SQL_SQL92_VALUE_EXPRESSIONS:
-            RETURN_ULONG(SQL_SVE_CASE | SQL_SVE_CAST | SQL_SVE_COALESCE | SQL_SVE_NULLIF);
-            
-        default:
-            conn->add_diagnostic(sqlstate::INVALID_INFO_TYPE, 0,
-                                "Information type out of range");
-            return SQL_ERROR;
+    std::string_view text = info->text;
+    SQLUINTEGER number = info->number;
+    if (info->dynamic) {
+        const auto& config = BehaviorController::instance().config();
+        switch (fInfoType) {
+            case SQL_DRIVER_VER: text = config.driver_version; break;
+            case SQL_DRIVER_ODBC_VER: text = config.driver_odbc_version; break;
+            case SQL_DBMS_NAME: text = config.dbms_name; break;
+            case SQL_DBMS_VER: text = config.dbms_version; break;
+            case SQL_DATA_SOURCE_NAME: text = conn->dsn_; break;
+            case SQL_DATA_SOURCE_READ_ONLY:
+                text = conn->access_mode_ == SQL_MODE_READ_ONLY ? "Y" : "N";
+                break;
+            case SQL_USER_NAME: text = conn->uid_; break;
+            case SQL_MAX_DRIVER_CONNECTIONS:
+                number = static_cast<SQLUINTEGER>(config.max_connections > 0 ? config.max_connections : 0);
+                break;
+        }
     }
     
-    #undef RETURN_STRING
-    #undef RETURN_USHORT
-    #undef RETURN_ULONG
+    switch (info->kind) {
+        case InfoValue::Kind::String:
+            return copy_string_to_buffer(text, static_cast<SQLCHAR*>(rgbInfoValue),
+                                         cbInfoValueMax, pcbInfoValue);
+        case InfoValue::Kind::UShort:
+            if (rgbInfoValue) *static_cast<SQLUSMALLINT*>(rgbInfoValue) = static_cast<SQLUSMALLINT>(number);
+            if (pcbInfoValue) *pcbInfoValue = sizeof(SQLUSMALLINT);
+            break;
+        case InfoValue::Kind::ULong:
+            if (rgbInfoValue) *static_cast<SQLUINTEGER*>(rgbInfoValue) = number;
+            if (pcbInfoValue) *pcbInfoValue = sizeof(SQLUINTEGER);
+            break;
+    }
+    return SQL_SUCCESS;
 }
 
 SQLRETURN SQL_API SQLGetTypeInfo(
@@ -499,12 +201,13 @@ SQLRETURN SQL_API SQLGetTypeInfo(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);
     
     stmt->clear_diagnostics();
     
     const auto& config = BehaviorController::instance().config();
-    if (config.should_fail("SQLGetTypeInfo")) {
+    if (config.should_fail(DriverFunction::SQLGetTypeInfo)) {
         stmt->add_diagnostic(config.error_code, 0, "Simulated SQLGetTypeInfo failure");
         return SQL_ERROR;
     }
@@ -513,6 +216,7 @@ SQLRETURN SQL_API SQLGetTypeInfo(
     stmt->executed_ = true;
     stmt->cursor_open_ = true;
     stmt->current_row_ = -1;
+    stmt->wire_rows_received_ = 0;
     
     stmt->column_names_ = {
         "TYPE_NAME", "DATA_TYPE", "COLUMN_SIZE", "LITERAL_PREFIX", "LITERAL_SUFFIX",
@@ -531,36 +235,33 @@ SQLRETURN SQL_API SQLGetTypeInfo(
     };
     
     stmt->num_result_cols_ = 19;
-    stmt->result_data_.clear();
+    stmt->clear_result_rows();
     
-    auto types = get_mock_types(config.types);
+    using Cell = std::variant<std::monostate, long long, double, std::string>;
+    auto text_or_null = [](std::string_view text) {
+        return text.empty() ? Cell(std::monostate{}) : Cell(std::string(text));
+    };
     
-    for (const auto& type : types) {
-        // Filter by requested type
-        if (fSqlType != SQL_ALL_TYPES && type.data_type != fSqlType) {
+    for (const auto& type : find_mock_types(fSqlType)) {
+        if (!in_type_preset(type, config.types)) {
             continue;
         }
         
-        std::vector<std::variant<std::monostate, long long, double, std::string>> row;
-        row.push_back(type.type_name);
+        std::vector<Cell> row;
+        row.reserve(19);
+        row.push_back(std::string(type.type_name));
         row.push_back(static_cast<long long>(type.data_type));
         row.push_back(static_cast<long long>(type.column_size));
-        row.push_back(type.literal_prefix.empty() ? 
-                     std::variant<std::monostate, long long, double, std::string>(std::monostate{}) : 
-                     type.literal_prefix);
-        row.push_back(type.literal_suffix.empty() ? 
-                     std::variant<std::monostate, long long, double, std::string>(std::monostate{}) : 
-                     type.literal_suffix);
-        row.push_back(type.create_params.empty() ? 
-                     std::variant<std::monostate, long long, double, std::string>(std::monostate{}) : 
-                     type.create_params);
+        row.push_back(text_or_null(type.literal_prefix));
+        row.push_back(text_or_null(type.literal_suffix));
+        row.push_back(text_or_null(type.create_params));
         row.push_back(static_cast<long long>(type.nullable));
         row.push_back(static_cast<long long>(type.case_sensitive));
         row.push_back(static_cast<long long>(type.searchable));
         row.push_back(static_cast<long long>(type.unsigned_attribute));
         row.push_back(static_cast<long long>(type.fixed_prec_scale));
         row.push_back(static_cast<long long>(type.auto_unique_value));
-        row.push_back(type.local_type_name);
+        row.push_back(std::string(type.local_type_name));
         row.push_back(static_cast<long long>(type.minimum_scale));
         row.push_back(static_cast<long long>(type.maximum_scale));
         row.push_back(static_cast<long long>(type.sql_data_type));
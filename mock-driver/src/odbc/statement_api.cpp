@@ -2,11 +2,16 @@
 
 #include "driver/handles.hpp"
 #include "driver/diagnostics.hpp"
+#include "driver/async_executor.hpp"
 #include "mock/mock_data.hpp"
+#include "mock/data_file.hpp"
 #include "mock/behaviors.hpp"
 #include "utils/string_utils.hpp"
+#include <algorithm>
 #include <cstring>
+#include <iterator>
 #include <cmath>
+#include <new>
 
 using namespace mock_odbc;
 
@@ -32,46 +37,50 @@ static SQLLEN c_type_element_size(SQLSMALLINT value_type, SQLLEN buffer_length)
     }
 }
 
-// Read a CellValue from a parameter binding for parameter-set index 'row'.
-// When param_bind_type == SQL_PARAM_BIND_BY_COLUMN (0), column-wise:
+// Read a CellValue from an application buffer bound as element 'row' of
+// an array (parameter sets or a rowset). When bind_type is 0
+// (SQL_PARAM_BIND_BY_COLUMN / SQL_BIND_BY_COLUMN), column-wise:
 //   data_ptr  = base_data_ptr  + row * element_size
 //   ind_ptr   = base_ind_ptr   + row
-// When param_bind_type != 0 (row-wise):
-//   data_ptr  = (char*)base_data_ptr + row * param_bind_type
-//   ind_ptr   = (SQLLEN*)((char*)base_ind_ptr + row * param_bind_type)
-static CellValue read_param_value(
-    const StatementHandle::ParameterBinding& pb,
+// Otherwise row-wise, bind_type being the struct size:
+//   data_ptr  = (char*)base_data_ptr + row * bind_type
+//   ind_ptr   = (SQLLEN*)((char*)base_ind_ptr + row * bind_type)
+static CellValue read_bound_value(
+    SQLSMALLINT value_type,
+    SQLPOINTER value,
+    SQLLEN buffer_length,
+    const SQLLEN* base_ind,
     SQLULEN row,
-    SQLULEN param_bind_type)
+    SQLULEN bind_type)
 {
-    if (!pb.param_value) return std::monostate{};
+    if (!value) return std::monostate{};
 
-    const char* base_data = static_cast<const char*>(pb.param_value);
-    const SQLLEN* base_ind = pb.str_len_or_ind;
+    const char* base_data = static_cast<const char*>(value);
 
     const char* data_ptr;
     const SQLLEN* ind_ptr;
 
-    if (param_bind_type == SQL_PARAM_BIND_BY_COLUMN) {
+    if (bind_type == SQL_PARAM_BIND_BY_COLUMN) {
         // Column-wise: stride by element size for data, by sizeof(SQLLEN) for indicator
-        SQLLEN elem_size = c_type_element_size(pb.value_type, pb.buffer_length);
+        SQLLEN elem_size = c_type_element_size(value_type, buffer_length);
         data_ptr = base_data + row * elem_size;
         ind_ptr  = base_ind ? (base_ind + row) : nullptr;
     } else {
-        // Row-wise: stride by the struct size (param_bind_type) for both
-        data_ptr = base_data + row * param_bind_type;
+        // Row-wise: stride by the struct size (bind_type) for both
+        data_ptr = base_data + row * bind_type;
         ind_ptr  = base_ind
             ? reinterpret_cast<const SQLLEN*>(
-                  reinterpret_cast<const char*>(base_ind) + row * param_bind_type)
+                  reinterpret_cast<const char*>(base_ind) + row * bind_type)
             : nullptr;
     }
 
-    // Check for SQL_NULL_DATA
-    if (ind_ptr && *ind_ptr == SQL_NULL_DATA) {
+    // SQL_NULL_DATA, or SQL_COLUMN_IGNORE from SQLBulkOperations (no default
+    // values in the mock, so the column is NULL)
+    if (ind_ptr && (*ind_ptr == SQL_NULL_DATA || *ind_ptr == SQL_COLUMN_IGNORE)) {
         return std::monostate{};
     }
 
-    switch (pb.value_type) {
+    switch (value_type) {
         case SQL_C_SLONG:
         case SQL_C_LONG:
             return static_cast<long long>(*reinterpret_cast<const SQLINTEGER*>(data_ptr));
@@ -96,29 +105,59 @@ static CellValue read_param_value(
         }
         case SQL_C_CHAR:
         default: {
-            SQLLEN len = pb.buffer_length;
-            if (ind_ptr && *ind_ptr != SQL_NTS) {
-                len = *ind_ptr;
+            if (ind_ptr && *ind_ptr >= 0) {
+                return std::string(data_ptr, static_cast<size_t>(*ind_ptr));
             }
-            if (len == SQL_NTS || len < 0) {
-                return std::string(data_ptr);
-            } else {
-                return std::string(data_ptr, static_cast<size_t>(len));
+            // Null-terminated, but never read past the element's buffer
+            if (buffer_length > 0) {
+                return std::string(data_ptr, strnlen(data_ptr, static_cast<size_t>(buffer_length)));
             }
+            return std::string(data_ptr);
         }
     }
 }
 
+// Read parameter `pb` for parameter-set index 'row'
+static CellValue read_param_value(
+    const StatementHandle::ParameterBinding& pb,
+    SQLULEN row,
+    SQLULEN param_bind_type)
+{
+    return read_bound_value(pb.value_type, pb.param_value, pb.buffer_length,
+                            pb.str_len_or_ind, row, param_bind_type);
+}
+
+// Values collected for data-at-execution parameters, by parameter number
+using ParamOverrides = std::unordered_map<SQLUSMALLINT, CellValue>;
+
 // Substitute bound parameter values into a ParsedQuery for param-set 'row'.
-// Handles both INSERT (insert_values) and literal SELECT (literal_exprs).
+// Handles INSERT (insert_values), literal SELECT (literal_exprs), and WHERE
+// clauses and UPDATE SET lists (params).
+// Parameters present in `overrides` take that value instead of reading the
+// binding; the override is moved out so large values are not copied.
 static void substitute_params(
     ParsedQuery& parsed,
     const std::unordered_map<SQLUSMALLINT, StatementHandle::ParameterBinding>& bindings,
     SQLULEN row,
-    SQLULEN param_bind_type)
+    SQLULEN param_bind_type,
+    ParamOverrides* overrides = nullptr)
 {
     if (bindings.empty() || parsed.param_count == 0) return;
 
+    auto param_value = [&](SQLUSMALLINT param_idx, CellValue& out) {
+        if (overrides) {
+            auto ov = overrides->find(param_idx);
+            if (ov != overrides->end()) {
+                out = std::move(ov->second);
+                return true;
+            }
+        }
+        auto it = bindings.find(param_idx);
+        if (it == bindings.end()) return false;
+        out = read_param_value(it->second, row, param_bind_type);
+        return true;
+    };
+
     // INSERT parameter substitution — only substitute for '?' markers
     if (parsed.query_type == ParsedQuery::QueryType::Insert) {
         SQLUSMALLINT param_idx = 0;
@@ -127,10 +166,7 @@ static void substitute_params(
                              && parsed.insert_param_markers[vi];
             if (is_marker) {
                 param_idx++;
-                auto it = bindings.find(param_idx);
-                if (it != bindings.end()) {
-                    parsed.insert_values[vi] = read_param_value(it->second, row, param_bind_type);
-                }
+                param_value(param_idx, parsed.insert_values[vi]);
             }
         }
         return;
@@ -142,9 +178,8 @@ static void substitute_params(
         for (auto& lit : parsed.literal_exprs) {
             param_idx++;
             if (lit.is_parameter_marker) {
-                auto it = bindings.find(param_idx);
-                if (it != bindings.end()) {
-                    CellValue cv = read_param_value(it->second, row, param_bind_type);
+                CellValue cv;
+                if (param_value(param_idx, cv)) {
                     if (std::holds_alternative<std::monostate>(cv)) {
                         lit.value = std::monostate{};
                         lit.sql_type = SQL_VARCHAR;
@@ -157,31 +192,194 @@ static void substitute_params(
                         lit.sql_type = SQL_DOUBLE;
                         lit.column_size = 15;
                     } else {
-                        lit.value = std::get<std::string>(cv);
+                        lit.value = std::move(std::get<std::string>(cv));
                         lit.sql_type = SQL_VARCHAR;
                         lit.column_size = 255;
                     }
                 }
             }
         }
+        return;
+    }
+
+    // Markers in a WHERE clause or UPDATE SET list are read when the
+    // statement runs
+    if (!parsed.where_clause.empty() || !parsed.assignments.empty()) {
+        parsed.params.resize(static_cast<size_t>(parsed.param_count));
+        for (int i = 0; i < parsed.param_count; ++i) {
+            param_value(static_cast<SQLUSMALLINT>(i + 1), parsed.params[i]);
+        }
     }
 }
 
-} // anonymous namespace
+// C types SQLPutData may send in several pieces
+bool is_piecewise_type(SQLSMALLINT value_type) {
+    return value_type == SQL_C_CHAR || value_type == SQL_C_WCHAR || value_type == SQL_C_BINARY;
+}
 
-extern "C" {
+// True when a bound parameter's indicator asks for its value at execution
+// time (SQL_DATA_AT_EXEC or SQL_LEN_DATA_AT_EXEC(length))
+bool is_data_at_exec(const StatementHandle::ParameterBinding& pb) {
+    if (!pb.str_len_or_ind) return false;
+    SQLLEN ind = *pb.str_len_or_ind;
+    return ind == SQL_DATA_AT_EXEC || ind <= SQL_LEN_DATA_AT_EXEC_OFFSET;
+}
 
-SQLRETURN SQL_API SQLExecDirect(
-    SQLHSTMT hstmt,
-    SQLCHAR* szSqlStr,
-    SQLINTEGER cbSqlStr) {
+// Enter the data-at-execution state when any bound parameter asks for it
+// and return SQL_NEED_DATA for the caller to pass on. Buffers are reserved
+// for the lengths announced with SQL_LEN_DATA_AT_EXEC so a value streamed
+// in many chunks is collected without reallocating. Bindings beyond the
+// statement's `param_count` markers are ignored. Only single parameter sets
+// are supported: with an array of them this posts HYC00 and returns
+// SQL_ERROR. Returns SQL_SUCCESS when no parameter is data-at-execution.
+SQLRETURN begin_data_at_exec(StatementHandle* stmt, int param_count) {
+    StatementHandle::DataAtExecState state;
+    for (const auto& [number, pb] : stmt->parameter_bindings_) {
+        if (number > param_count || !is_data_at_exec(pb)) continue;
+        if (stmt->paramset_size_ != 1) {
+            stmt->add_diagnostic(sqlstate::OPTIONAL_FEATURE_NOT_IMPLEMENTED, 0,
+                                "Data-at-execution parameters are not supported with "
+                                "arrays of parameters");
+            return SQL_ERROR;
+        }
+        
+        StatementHandle::DataAtExecParam param;
+        param.number = number;
+        SQLLEN ind = *pb.str_len_or_ind;
+        if (ind <= SQL_LEN_DATA_AT_EXEC_OFFSET) {
+            try {
+                param.data.reserve(static_cast<size_t>(SQL_LEN_DATA_AT_EXEC_OFFSET - ind));
+            } catch (const std::exception&) {
+                // Announced length too large to reserve; grow as chunks arrive
+            }
+        }
+        state.params.push_back(std::move(param));
+    }
+    if (state.params.empty()) return SQL_SUCCESS;
     
-    auto* stmt = validate_stmt_handle(hstmt);
-    if (!stmt) return SQL_INVALID_HANDLE;
-    HandleLock lock(stmt);
+    // SQLParamData asks for parameters in parameter-number order
+    std::sort(state.params.begin(), state.params.end(),
+              [](const auto& a, const auto& b) { return a.number < b.number; });
+    stmt->data_at_exec_ = std::move(state);
+    return SQL_NEED_DATA;
+}
+
+// Post HY010 and return true while the statement waits for
+// data-at-execution values; only SQLParamData, SQLPutData and SQLCancel
+// are allowed then.
+bool reject_if_need_data(StatementHandle* stmt) {
+    if (!stmt->data_at_exec_) return false;
+    
+    stmt->add_diagnostic(sqlstate::FUNCTION_SEQUENCE_ERROR, 0,
+                         "Function sequence error: data-at-execution parameters are pending");
+    return true;
+}
+
+// Append a SQLPutData chunk. When the value outgrows its reserved buffer
+// the capacity at least doubles, so a value of unannounced length costs a
+// logarithmic number of reallocations rather than one per chunk.
+void append_chunk(std::string& buffer, const char* data, size_t length) {
+    constexpr size_t kMinCapacity = 64 * 1024;
+    size_t needed = buffer.size() + length;
+    if (needed > buffer.capacity()) {
+        buffer.reserve(std::max({needed, buffer.capacity() * 2, kMinCapacity}));
+    }
+    buffer.append(data, length);
+}
+
+// Copy a QueryResult into the statement's result set after an execution
+void store_result(StatementHandle* stmt, QueryResult& result) {
+    stmt->executed_ = true;
+    stmt->cursor_open_ = result.row_count() > 0;
+    stmt->current_row_ = -1;
+    stmt->wire_rows_received_ = 0;
+    stmt->num_result_cols_ = static_cast<SQLSMALLINT>(result.column_names.size());
+    stmt->row_count_ = result.affected_rows > 0 ? result.affected_rows :
+                       static_cast<SQLLEN>(result.row_count());
+    
+    stmt->column_names_ = std::move(result.column_names);
+    stmt->result_table_ = std::move(result.source_table);
+    stmt->column_types_.clear();
+    for (auto t : result.column_types) {
+        stmt->column_types_.push_back(t);
+    }
+    stmt->clear_result_rows();
+    if (result.scan) {
+        stmt->result_scan_ = std::move(result.scan);
+        stmt->scan_columns_ = std::move(result.scan_columns);
+        return;
+    }
+    for (auto& row : result.data) {
+        stmt->result_data_.push_back(std::move(row));
+    }
+}
+
+// Run a statement function on the async worker pool when
+// SQL_ATTR_ASYNC_ENABLE is on, or report on the one already running.
+// Called with the statement locked. Returns true when `rc` holds the
+// caller's return value: SQL_STILL_EXECUTING while the worker runs, the
+// worker's result and diagnostics on the first call after it finished, or
+// HY010 when a different function is still executing. Returns false when
+// the call should run synchronously. `round_trip` selects the latency as
+// for simulate_statement_latency(); `wire` returns the simulated network
+// time and is only called when a new operation starts.
+template<typename Wire, typename Work>
+bool dispatch_async(StatementHandle* stmt, DriverFunction function, bool round_trip,
+                    Wire wire, Work work, SQLRETURN& rc) {
+    if (stmt->async_op_) {
+        if (std::strcmp(stmt->async_op_->function, driver_function_name(function)) != 0) {
+            add_async_pending_diagnostic(stmt, *stmt->async_op_);
+            rc = SQL_ERROR;
+        } else if (!stmt->async_op_->done.load()) {
+            rc = SQL_STILL_EXECUTING;
+        } else {
+            rc = stmt->async_op_->result;
+            stmt->swap_diagnostics(stmt->async_op_->diagnostics);
+            std::atomic_store(&stmt->async_op_, std::shared_ptr<AsyncOperation>());
+        }
+        return true;
+    }
+    
+    if (stmt->async_enable_ != SQL_ASYNC_ENABLE_ON) {
+        return false;
+    }
     
     stmt->clear_diagnostics();
+    auto op = std::make_shared<AsyncOperation>(driver_function_name(function));
+    std::atomic_store(&stmt->async_op_, op);
+    
+    stmt->cancel_signal_.reset();
+    std::chrono::microseconds network_delay = wire();
+    DriverConfig config = BehaviorController::instance().config();
+    AsyncExecutor::instance().submit([stmt, op, config, function, round_trip, network_delay, work]() {
+        // Wait out the latency without holding the statement so the
+        // application can keep polling it; SQLCancel cuts the wait short
+        if (!op->canceled.load() &&
+            config.apply_latency(function, round_trip, &stmt->cancel_signal_)) {
+            stmt->cancel_signal_.wait_for(network_delay);
+        }
+        
+        HandleLock lock(stmt);
+        stmt->swap_diagnostics(op->diagnostics);
+        SQLRETURN result;
+        if (op->canceled.load()) {
+            stmt->add_diagnostic(sqlstate::OPERATION_CANCELED, 0, "Operation canceled");
+            result = SQL_ERROR;
+        } else {
+            result = work(stmt);
+        }
+        stmt->swap_diagnostics(op->diagnostics);
+        op->result = result;
+        op->done.store(true);
+    }, config.async_workers);
     
+    rc = SQL_STILL_EXECUTING;
+    return true;
+}
+
+// SQLExecDirect body; the statement is locked and its diagnostics cleared.
+// Latency is skipped when an async worker already waited it out unlocked.
+SQLRETURN exec_direct(StatementHandle* stmt, const std::string& sql, bool simulate_latency) {
     auto* conn = stmt->connection();
     if (!conn || !conn->is_connected()) {
         stmt->add_diagnostic(sqlstate::CONNECTION_NOT_OPEN, 0,
@@ -191,7 +389,7 @@ SQLRETURN SQL_API SQLExecDirect(
     
     // Check for failure injection
     const auto& config = BehaviorController::instance().config();
-    if (config.should_fail("SQLExecDirect")) {
+    if (config.should_fail(DriverFunction::SQLExecDirect)) {
         for (int i = 0; i < config.error_count; ++i) {
             stmt->add_diagnostic(config.error_code, i + 1,
                 "Simulated execution failure (record " + std::to_string(i + 1) + " of " + std::to_string(config.error_count) + ")");
@@ -199,10 +397,15 @@ SQLRETURN SQL_API SQLExecDirect(
         return SQL_ERROR;
     }
     
-    config.apply_latency();
+    if (simulate_latency &&
+        (!simulate_statement_latency(stmt, DriverFunction::SQLExecDirect, true) ||
+         !simulate_network_delay(stmt, config.network.transfer_time(sql.size())))) {
+        return SQL_ERROR;
+    }
     
     // Parse and execute SQL
-    stmt->sql_ = sql_to_string(szSqlStr, static_cast<SQLSMALLINT>(cbSqlStr));
+    stmt->sql_ = sql;
+    stmt->prepared_query_.reset();
     auto parsed = parse_sql(stmt->sql_);
     
     if (!parsed.is_valid) {
@@ -210,86 +413,125 @@ SQLRETURN SQL_API SQLExecDirect(
         return SQL_ERROR;
     }
     
-    auto result = execute_query(parsed, config.result_set_size);
+    SQLRETURN data_rc = begin_data_at_exec(stmt, parsed.param_count);
+    if (data_rc != SQL_SUCCESS) {
+        if (data_rc == SQL_NEED_DATA) stmt->prepared_ = false;
+        return data_rc;
+    }
+    
+    substitute_params(parsed, stmt->parameter_bindings_, 0, stmt->param_bind_type_);
+    auto result = execute_query(std::move(parsed), config.result_set_size,
+                                stmt->connection()->transaction());
     
     if (!result.success) {
         stmt->add_diagnostic(result.error_sqlstate, 0, result.error_message);
         return SQL_ERROR;
     }
     
-    // Store result
-    stmt->executed_ = true;
+    store_result(stmt, result);
     stmt->prepared_ = false;
-    stmt->cursor_open_ = !result.data.empty();
-    stmt->current_row_ = -1;
-    stmt->num_result_cols_ = static_cast<SQLSMALLINT>(result.column_names.size());
-    stmt->row_count_ = result.affected_rows > 0 ? result.affected_rows : 
-                       static_cast<SQLLEN>(result.data.size());
-    
-    stmt->column_names_ = std::move(result.column_names);
-    stmt->column_types_.clear();
-    for (auto t : result.column_types) {
-        stmt->column_types_.push_back(t);
-    }
-    stmt->result_data_.clear();
-    for (const auto& row : result.data) {
-        std::vector<std::variant<std::monostate, long long, double, std::string>> converted_row;
-        for (const auto& cell : row) {
-            converted_row.push_back(cell);
-        }
-        stmt->result_data_.push_back(std::move(converted_row));
-    }
-    
     return SQL_SUCCESS;
 }
 
-SQLRETURN SQL_API SQLPrepare(
-    SQLHSTMT hstmt,
-    SQLCHAR* szSqlStr,
-    SQLINTEGER cbSqlStr) {
+// Execute a single parameter set: substitute the bound parameters (or the
+// data-at-execution values in `overrides`) and store the result
+SQLRETURN execute_single(StatementHandle* stmt, ParsedQuery parsed, ParamOverrides* overrides) {
+    const auto& config = BehaviorController::instance().config();
     
-    auto* stmt = validate_stmt_handle(hstmt);
-    if (!stmt) return SQL_INVALID_HANDLE;
-    HandleLock lock(stmt);
+    // Substitute bound parameter values into the parsed query (INSERT, literal SELECT and WHERE)
+    substitute_params(parsed, stmt->parameter_bindings_, 0, stmt->param_bind_type_, overrides);
     
-    stmt->clear_diagnostics();
+    auto result = execute_query(std::move(parsed), config.result_set_size,
+                                stmt->connection()->transaction());
     
-    auto* conn = stmt->connection();
-    if (!conn || !conn->is_connected()) {
-        stmt->add_diagnostic(sqlstate::CONNECTION_NOT_OPEN, 0,
-                            "Connection not open");
+    if (!result.success) {
+        stmt->add_diagnostic(result.error_sqlstate, 0, result.error_message);
         return SQL_ERROR;
     }
     
-    const auto& config = BehaviorController::instance().config();
-    if (config.should_fail("SQLPrepare")) {
-        stmt->add_diagnostic(config.error_code, 0, "Simulated prepare failure");
-        return SQL_ERROR;
+    // Set params processed for single execution too
+    if (stmt->params_processed_ptr_) {
+        *stmt->params_processed_ptr_ = 1;
+    }
+    if (stmt->param_status_ptr_) {
+        stmt->param_status_ptr_[0] = SQL_PARAM_SUCCESS;
     }
     
-    stmt->sql_ = sql_to_string(szSqlStr, static_cast<SQLSMALLINT>(cbSqlStr));
+    store_result(stmt, result);
+    return SQL_SUCCESS;
+}
+
+// Execute an INSERT for every parameter set of an array in one pass: the
+// rows are built column by column straight from the bound buffers (column-
+// or row-wise) and appended to the table with a single reservation, with no
+// per-row substitution or execute_query() call. Called with
+// MockCatalog::mutex() held since `plan` was built.
+SQLRETURN execute_insert_array(StatementHandle* stmt, const ParsedQuery& parsed,
+                               const InsertPlan& plan) {
+    const SQLULEN sets = stmt->paramset_size_;
+    
+    // Parameter sets to run, skipping those marked SQL_PARAM_IGNORE
+    std::vector<SQLULEN> active;
+    active.reserve(sets);
+    for (SQLULEN i = 0; i < sets; ++i) {
+        bool ignored = stmt->param_operation_ptr_ &&
+                       stmt->param_operation_ptr_[i] == SQL_PARAM_IGNORE;
+        if (stmt->param_status_ptr_) {
+            stmt->param_status_ptr_[i] = ignored ? SQL_PARAM_UNUSED : SQL_PARAM_SUCCESS;
+        }
+        if (!ignored) active.push_back(i);
+    }
     
-    // Validate SQL syntax
-    auto parsed = parse_sql(stmt->sql_);
-    if (!parsed.is_valid) {
-        stmt->add_diagnostic(sqlstate::SYNTAX_ERROR, 0, parsed.error_message);
+    std::vector<MockRow> rows(active.size(), MockRow(plan.column_count));
+    SQLUSMALLINT param_idx = 0;
+    for (size_t vi = 0; vi < parsed.insert_values.size(); ++vi) {
+        bool is_marker = vi < parsed.insert_param_markers.size() && parsed.insert_param_markers[vi];
+        if (is_marker) param_idx++;
+        int column = plan.value_columns[vi];
+        if (column < 0) continue;
+        
+        const StatementHandle::ParameterBinding* binding = nullptr;
+        if (is_marker) {
+            auto it = stmt->parameter_bindings_.find(param_idx);
+            if (it != stmt->parameter_bindings_.end()) binding = &it->second;
+        }
+        for (size_t r = 0; r < active.size(); ++r) {
+            rows[r][column] = binding
+                ? read_param_value(*binding, active[r], stmt->param_bind_type_)
+                : parsed.insert_values[vi];
+        }
+    }
+    
+    bool written = MockCatalog::instance().insert_rows(plan.table_name, std::move(rows),
+                                                       stmt->connection()->transaction());
+    if (!written) {
+        if (stmt->param_status_ptr_) {
+            for (SQLULEN i : active) stmt->param_status_ptr_[i] = SQL_PARAM_ERROR;
+        }
+        stmt->add_diagnostic(sqlstate::GENERAL_ERROR, 0,
+                            "Could not write rows to the data file");
         return SQL_ERROR;
     }
     
-    stmt->prepared_ = true;
-    stmt->executed_ = false;
-    stmt->cursor_open_ = false;
+    if (stmt->params_processed_ptr_) {
+        *stmt->params_processed_ptr_ = sets;
+    }
     
+    stmt->executed_ = true;
+    stmt->cursor_open_ = false;
+    stmt->current_row_ = -1;
+    stmt->wire_rows_received_ = 0;
+    stmt->row_count_ = static_cast<SQLLEN>(active.size()) * parsed.affected_rows;
+    stmt->num_result_cols_ = 0;
+    stmt->column_names_.clear();
+    stmt->column_types_.clear();
+    stmt->result_table_.clear();
+    stmt->clear_result_rows();
     return SQL_SUCCESS;
 }
 
-SQLRETURN SQL_API SQLExecute(SQLHSTMT hstmt) {
-    auto* stmt = validate_stmt_handle(hstmt);
-    if (!stmt) return SQL_INVALID_HANDLE;
-    HandleLock lock(stmt);
-    
-    stmt->clear_diagnostics();
-    
+// SQLExecute body; same contract as exec_direct()
+SQLRETURN execute_prepared(StatementHandle* stmt, bool simulate_latency) {
     if (!stmt->prepared_) {
         stmt->add_diagnostic(sqlstate::FUNCTION_SEQUENCE_ERROR, 0,
                             "Statement not prepared");
@@ -304,7 +546,7 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT hstmt) {
     }
     
     const auto& config = BehaviorController::instance().config();
-    if (config.should_fail("SQLExecute")) {
+    if (config.should_fail(DriverFunction::SQLExecute)) {
         // For array params, fill status array with errors
         if (stmt->paramset_size_ > 1 && stmt->param_status_ptr_) {
             for (SQLULEN i = 0; i < stmt->paramset_size_; ++i) {
@@ -318,13 +560,32 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT hstmt) {
         return SQL_ERROR;
     }
     
-    config.apply_latency();
+    if (simulate_latency &&
+        (!simulate_statement_latency(stmt, DriverFunction::SQLExecute, true) ||
+         !simulate_network_delay(stmt, config.network.transfer_time(0)))) {
+        return SQL_ERROR;
+    }
     
-    // Parse SQL once
-    auto parsed = parse_sql(stmt->sql_);
+    // Start from the query parsed by SQLPrepare
+    ParsedQuery parsed = stmt->prepared_query_ ? *stmt->prepared_query_ : parse_sql(stmt->sql_);
+    
+    SQLRETURN data_rc = begin_data_at_exec(stmt, parsed.param_count);
+    if (data_rc != SQL_SUCCESS) {
+        return data_rc;
+    }
     
     // --- Array parameter execution ---
     if (stmt->paramset_size_ > 1) {
+        {
+            // Plan and insert under one lock so the table cannot change
+            // in between; the row-by-row path below locks per query
+            std::lock_guard<std::mutex> catalog_lock(MockCatalog::instance().mutex());
+            InsertPlan plan;
+            if (plan_insert(parsed, plan)) {
+                return execute_insert_array(stmt, parsed, plan);
+            }
+        }
+        
         SQLULEN success_count = 0;
         SQLULEN error_count = 0;
         SQLULEN processed = 0;
@@ -333,6 +594,7 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT hstmt) {
         // Accumulate result data from all parameter sets
         std::vector<std::string> result_col_names;
         std::vector<SQLSMALLINT> result_col_types;
+        std::string result_table;
         std::vector<std::vector<std::variant<std::monostate, long long, double, std::string>>> all_result_data;
         
         for (SQLULEN i = 0; i < stmt->paramset_size_; ++i) {
@@ -350,7 +612,9 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT hstmt) {
             // Execute with current parameter set — substitute bound param values
             ParsedQuery row_parsed = parsed;
             substitute_params(row_parsed, stmt->parameter_bindings_, i, stmt->param_bind_type_);
-            auto result = execute_query(row_parsed, config.result_set_size);
+            auto result = execute_query(std::move(row_parsed), config.result_set_size,
+                                        stmt->connection()->transaction());
+            materialize_scan(result);
             
             if (result.success) {
                 if (stmt->param_status_ptr_) {
@@ -363,26 +627,23 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT hstmt) {
                 // Capture column metadata from first successful execution
                 if (result_col_names.empty() && !result.column_names.empty()) {
                     result_col_names = result.column_names;
+                    result_table = result.source_table;
                     for (auto t : result.column_types) {
                         result_col_types.push_back(t);
                     }
                 }
                 
                 // Accumulate result data
-                for (const auto& row : result.data) {
-                    std::vector<std::variant<std::monostate, long long, double, std::string>> converted_row;
-                    for (const auto& cell : row) {
-                        converted_row.push_back(cell);
-                    }
-                    all_result_data.push_back(std::move(converted_row));
-                }
+                all_result_data.insert(all_result_data.end(),
+                                       std::make_move_iterator(result.data.begin()),
+                                       std::make_move_iterator(result.data.end()));
             } else {
                 if (stmt->param_status_ptr_) {
                     stmt->param_status_ptr_[i] = SQL_PARAM_ERROR;
                 }
                 error_count++;
-                stmt->add_diagnostic(result.error_sqlstate, 0, 
-                    "Parameter set " + std::to_string(i + 1) + ": " + result.error_message);
+                stmt->add_parameter_diagnostic(result.error_sqlstate,
+                                               static_cast<SQLLEN>(i + 1), result.error_message);
             }
         }
         
@@ -395,10 +656,13 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT hstmt) {
         stmt->executed_ = true;
         stmt->cursor_open_ = !all_result_data.empty();
         stmt->current_row_ = -1;
+        stmt->wire_rows_received_ = 0;
         stmt->row_count_ = total_affected;
         stmt->num_result_cols_ = static_cast<SQLSMALLINT>(result_col_names.size());
         stmt->column_names_ = std::move(result_col_names);
         stmt->column_types_ = std::move(result_col_types);
+        stmt->result_table_ = std::move(result_table);
+        stmt->clear_result_rows();
         stmt->result_data_ = std::move(all_result_data);
         
         // Determine return code based on success/error counts
@@ -413,56 +677,11 @@ SQLRETURN SQL_API SQLExecute(SQLHSTMT hstmt) {
     }
     
     // --- Single parameter set execution (original path) ---
-    
-    // Substitute bound parameter values into the parsed query (INSERT and literal SELECT)
-    substitute_params(parsed, stmt->parameter_bindings_, 0, stmt->param_bind_type_);
-    
-    auto result = execute_query(parsed, config.result_set_size);
-    
-    if (!result.success) {
-        stmt->add_diagnostic(result.error_sqlstate, 0, result.error_message);
-        return SQL_ERROR;
-    }
-    
-    // Set params processed for single execution too
-    if (stmt->params_processed_ptr_) {
-        *stmt->params_processed_ptr_ = 1;
-    }
-    if (stmt->param_status_ptr_) {
-        stmt->param_status_ptr_[0] = SQL_PARAM_SUCCESS;
-    }
-    
-    stmt->executed_ = true;
-    stmt->cursor_open_ = !result.data.empty();
-    stmt->current_row_ = -1;
-    stmt->num_result_cols_ = static_cast<SQLSMALLINT>(result.column_names.size());
-    stmt->row_count_ = result.affected_rows > 0 ? result.affected_rows :
-                       static_cast<SQLLEN>(result.data.size());
-    
-    stmt->column_names_ = std::move(result.column_names);
-    stmt->column_types_.clear();
-    for (auto t : result.column_types) {
-        stmt->column_types_.push_back(t);
-    }
-    stmt->result_data_.clear();
-    for (const auto& row : result.data) {
-        std::vector<std::variant<std::monostate, long long, double, std::string>> converted_row;
-        for (const auto& cell : row) {
-            converted_row.push_back(cell);
-        }
-        stmt->result_data_.push_back(std::move(converted_row));
-    }
-    
-    return SQL_SUCCESS;
+    return execute_single(stmt, std::move(parsed), nullptr);
 }
 
-SQLRETURN SQL_API SQLFetch(SQLHSTMT hstmt) {
-    auto* stmt = validate_stmt_handle(hstmt);
-    if (!stmt) return SQL_INVALID_HANDLE;
-    HandleLock lock(stmt);
-    
-    stmt->clear_diagnostics();
-    
+// SQLFetch body; the statement is locked and its diagnostics cleared
+SQLRETURN fetch_next_row(StatementHandle* stmt) {
     if (!stmt->executed_) {
         stmt->add_diagnostic(sqlstate::INVALID_CURSOR_STATE, 0,
                             "Cursor is not open");
@@ -470,21 +689,22 @@ SQLRETURN SQL_API SQLFetch(SQLHSTMT hstmt) {
     }
     
     const auto& config = BehaviorController::instance().config();
-    if (config.should_fail("SQLFetch")) {
+    if (config.should_fail(DriverFunction::SQLFetch)) {
         stmt->add_diagnostic(config.error_code, 0, "Simulated fetch failure");
         return SQL_ERROR;
     }
     
     // Move to next row
     stmt->current_row_++;
+    stmt->get_data_ = {};
     
-    if (stmt->current_row_ >= static_cast<SQLLEN>(stmt->result_data_.size())) {
+    if (stmt->current_row_ >= static_cast<SQLLEN>(stmt->result_row_count())) {
         stmt->cursor_open_ = false;
         return SQL_NO_DATA;
     }
     
     // Transfer data to bound columns
-    const auto& row = stmt->result_data_[stmt->current_row_];
+    const auto& row = stmt->result_row(static_cast<size_t>(stmt->current_row_));
     
     for (const auto& [col_num, binding] : stmt->column_bindings_) {
         if (col_num < 1 || col_num > static_cast<SQLUSMALLINT>(row.size())) {
@@ -607,6 +827,237 @@ SQLRETURN SQL_API SQLFetch(SQLHSTMT hstmt) {
     return SQL_SUCCESS;
 }
 
+// Run the statement with the values collected by SQLPutData once the last
+// data-at-execution parameter has been sent; the statement is locked
+SQLRETURN finish_data_at_exec(StatementHandle* stmt) {
+    StatementHandle::DataAtExecState state = std::move(*stmt->data_at_exec_);
+    stmt->data_at_exec_.reset();
+    
+    ParamOverrides values;
+    for (auto& param : state.params) {
+        auto it = stmt->parameter_bindings_.find(param.number);
+        if (param.is_null || it == stmt->parameter_bindings_.end()) {
+            values[param.number] = std::monostate{};
+            continue;
+        }
+        
+        const auto& pb = it->second;
+        if (pb.value_type == SQL_C_WCHAR) {
+            values[param.number] = sqlw_to_string(
+                reinterpret_cast<const SQLWCHAR*>(param.data.data()),
+                static_cast<SQLINTEGER>(param.data.size() / sizeof(SQLWCHAR)));
+        } else if (is_piecewise_type(pb.value_type)) {
+            values[param.number] = std::move(param.data);
+        } else if (!param.received) {
+            values[param.number] = std::monostate{};
+        } else {
+            // Fixed-size value sent in one piece: decode it as if bound
+            StatementHandle::ParameterBinding fixed = pb;
+            fixed.param_value = param.data.data();
+            fixed.str_len_or_ind = nullptr;
+            values[param.number] = read_param_value(fixed, 0, SQL_PARAM_BIND_BY_COLUMN);
+        }
+    }
+    
+    const ParsedQuery* prepared = stmt->prepared_query_.get();
+    return execute_single(stmt, prepared ? *prepared : parse_sql(stmt->sql_), &values);
+}
+
+// Return the next piece of a string cell read as SQL_C_CHAR, SQL_C_WCHAR or
+// SQL_C_BINARY. Successive calls on the same column continue where the
+// previous one stopped: 01004 while data remains, with *str_len_or_ind set
+// to the bytes remaining before the call, then SQL_NO_DATA once the whole
+// value has been returned. Pieces are copied (or UTF-16 encoded) straight
+// from the stored value. SQL_C_WCHAR pieces end before a surrogate pair
+// that does not fit, unless the buffer has room for a single unit; then the
+// pair is split and the next piece starts with its low surrogate.
+SQLRETURN get_data_piece(StatementHandle* stmt, SQLUSMALLINT column, SQLSMALLINT c_type,
+                         const std::string& value, SQLPOINTER target,
+                         SQLLEN buffer_length, SQLLEN* str_len_or_ind) {
+    auto& progress = stmt->get_data_;
+    if (progress.column != column || progress.c_type != c_type) {
+        progress = {};
+        progress.column = column;
+        progress.c_type = c_type;
+        progress.remaining = c_type == SQL_C_WCHAR
+            ? utf16_length(value.data(), value.size()) * sizeof(SQLWCHAR)
+            : value.size();
+    }
+    
+    if (progress.done) {
+        return SQL_NO_DATA;
+    }
+    
+    if (str_len_or_ind) *str_len_or_ind = static_cast<SQLLEN>(progress.remaining);
+    
+    size_t capacity = (target && buffer_length > 0) ? static_cast<size_t>(buffer_length) : 0;
+    size_t copied = 0;
+    if (c_type == SQL_C_WCHAR) {
+        size_t max_units = capacity / sizeof(SQLWCHAR);
+        if (max_units > 0) {
+            auto* wtarget = static_cast<SQLWCHAR*>(target);
+            size_t room = max_units - 1;
+            size_t units = 0;
+            if (progress.pending_low && room > 0) {
+                wtarget[units++] = progress.pending_low;
+                progress.pending_low = 0;
+            }
+            units += utf8_to_utf16_partial(value.data(), value.size(), progress.offset,
+                                           wtarget + units, room - units);
+            if (units == 0 && room > 0) {
+                // Only a surrogate pair is left to return next and it does not
+                // fit; without splitting it the read would make no progress
+                SQLWCHAR pair[2];
+                size_t offset = progress.offset;
+                if (utf8_to_utf16_partial(value.data(), value.size(), offset, pair, 2) == 2) {
+                    wtarget[units++] = pair[0];
+                    progress.pending_low = pair[1];
+                    progress.offset = offset;
+                }
+            }
+            wtarget[units] = 0;
+            copied = units * sizeof(SQLWCHAR);
+        }
+    } else if (c_type == SQL_C_BINARY) {
+        copied = std::min(progress.remaining, capacity);
+        if (copied > 0) {
+            std::memcpy(target, value.data() + progress.offset, copied);
+        }
+        progress.offset += copied;
+    } else if (capacity > 0) {
+        copied = std::min(progress.remaining, capacity - 1);
+        std::memcpy(target, value.data() + progress.offset, copied);
+        static_cast<char*>(target)[copied] = '\0';
+        progress.offset += copied;
+    }
+    progress.remaining -= copied;
+    
+    // A zero-length buffer returns nothing, so it only reports the length
+    if (progress.remaining > 0) {
+        stmt->add_diagnostic(sqlstate::STRING_TRUNCATED, 0,
+                            "String data, right truncated");
+        return SQL_SUCCESS_WITH_INFO;
+    }
+    progress.done = true;
+    return SQL_SUCCESS;
+}
+
+} // anonymous namespace
+
+extern "C" {
+
+SQLRETURN SQL_API SQLExecDirect(
+    SQLHSTMT hstmt,
+    SQLCHAR* szSqlStr,
+    SQLINTEGER cbSqlStr) {
+    
+    auto* stmt = validate_stmt_handle(hstmt);
+    if (!stmt) return SQL_INVALID_HANDLE;
+    HandleLock lock(stmt);
+    if (!stmt->async_op_ && reject_if_need_data(stmt)) return SQL_ERROR;
+    
+    std::string sql = stmt->async_op_ ? std::string()
+                                      : sql_to_string(szSqlStr, static_cast<SQLSMALLINT>(cbSqlStr));
+    SQLRETURN rc;
+    if (dispatch_async(stmt, DriverFunction::SQLExecDirect, true,
+            [&] { return BehaviorController::instance().config().network.transfer_time(sql.size()); },
+            [sql](StatementHandle* s) { return exec_direct(s, sql, false); }, rc)) {
+        return rc;
+    }
+    
+    stmt->clear_diagnostics();
+    return exec_direct(stmt, sql, true);
+}
+
+SQLRETURN SQL_API SQLPrepare(
+    SQLHSTMT hstmt,
+    SQLCHAR* szSqlStr,
+    SQLINTEGER cbSqlStr) {
+    
+    auto* stmt = validate_stmt_handle(hstmt);
+    if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
+    HandleLock lock(stmt);
+    
+    stmt->clear_diagnostics();
+    if (reject_if_need_data(stmt)) return SQL_ERROR;
+    
+    auto* conn = stmt->connection();
+    if (!conn || !conn->is_connected()) {
+        stmt->add_diagnostic(sqlstate::CONNECTION_NOT_OPEN, 0,
+                            "Connection not open");
+        return SQL_ERROR;
+    }
+    
+    const auto& config = BehaviorController::instance().config();
+    if (config.should_fail(DriverFunction::SQLPrepare)) {
+        stmt->add_diagnostic(config.error_code, 0, "Simulated prepare failure");
+        return SQL_ERROR;
+    }
+    
+    // A failed prepare leaves the statement unprepared
+    stmt->prepared_ = false;
+    stmt->prepared_query_.reset();
+    stmt->sql_ = sql_to_string(szSqlStr, static_cast<SQLSMALLINT>(cbSqlStr));
+    
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLPrepare, false) ||
+        !simulate_network_delay(stmt, config.network.transfer_time(stmt->sql_.size()))) {
+        return SQL_ERROR;
+    }
+    
+    // Validate SQL syntax
+    auto parsed = parse_sql(stmt->sql_);
+    if (!parsed.is_valid) {
+        stmt->add_diagnostic(sqlstate::SYNTAX_ERROR, 0, parsed.error_message);
+        return SQL_ERROR;
+    }
+    
+    stmt->prepared_query_ = std::make_shared<const ParsedQuery>(std::move(parsed));
+    stmt->prepared_ = true;
+    stmt->executed_ = false;
+    stmt->cursor_open_ = false;
+    
+    return SQL_SUCCESS;
+}
+
+SQLRETURN SQL_API SQLExecute(SQLHSTMT hstmt) {
+    auto* stmt = validate_stmt_handle(hstmt);
+    if (!stmt) return SQL_INVALID_HANDLE;
+    HandleLock lock(stmt);
+    if (!stmt->async_op_ && reject_if_need_data(stmt)) return SQL_ERROR;
+    
+    SQLRETURN rc;
+    if (dispatch_async(stmt, DriverFunction::SQLExecute, true,
+            [] { return BehaviorController::instance().config().network.transfer_time(0); },
+            [](StatementHandle* s) { return execute_prepared(s, false); }, rc)) {
+        return rc;
+    }
+    
+    stmt->clear_diagnostics();
+    return execute_prepared(stmt, true);
+}
+
+SQLRETURN SQL_API SQLFetch(SQLHSTMT hstmt) {
+    auto* stmt = validate_stmt_handle(hstmt);
+    if (!stmt) return SQL_INVALID_HANDLE;
+    HandleLock lock(stmt);
+    if (!stmt->async_op_ && reject_if_need_data(stmt)) return SQL_ERROR;
+    
+    SQLRETURN rc;
+    if (dispatch_async(stmt, DriverFunction::SQLFetch, false,
+            [stmt] { return claim_fetch_transfer(stmt, stmt->current_row_ + 1); },
+            fetch_next_row, rc)) {
+        return rc;
+    }
+    
+    stmt->clear_diagnostics();
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLFetch, false) ||
+        !simulate_network_delay(stmt, claim_fetch_transfer(stmt, stmt->current_row_ + 1))) {
+        return SQL_ERROR;
+    }
+    return fetch_next_row(stmt);
+}
+
 SQLRETURN SQL_API SQLGetData(
     SQLHSTMT hstmt,
     SQLUSMALLINT icol,
@@ -617,6 +1068,7 @@ SQLRETURN SQL_API SQLGetData(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     HandleLock lock(stmt);
     
     if (!stmt->executed_ || stmt->current_row_ < 0) {
@@ -625,20 +1077,22 @@ SQLRETURN SQL_API SQLGetData(
         return SQL_ERROR;
     }
     
-    if (stmt->result_data_.empty() || 
-        static_cast<size_t>(stmt->current_row_) >= stmt->result_data_.size()) {
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLGetData, false)) return SQL_ERROR;
+    
+    if (static_cast<size_t>(stmt->current_row_) >= stmt->result_row_count()) {
         stmt->add_diagnostic(sqlstate::INVALID_CURSOR_STATE, 0,
                             "Invalid row position");
         return SQL_ERROR;
     }
     
-    if (icol < 1 || icol > static_cast<SQLUSMALLINT>(stmt->result_data_[stmt->current_row_].size())) {
+    const auto& row = stmt->result_row(static_cast<size_t>(stmt->current_row_));
+    if (icol < 1 || icol > static_cast<SQLUSMALLINT>(row.size())) {
         stmt->add_diagnostic(sqlstate::INVALID_PARAMETER_NUMBER, 0,
                             "Invalid column number");
         return SQL_ERROR;
     }
     
-    const auto& cell = stmt->result_data_[stmt->current_row_][icol - 1];
+    const auto& cell = row[icol - 1];
     
     // Handle NULL
     if (std::holds_alternative<std::monostate>(cell)) {
@@ -782,19 +1236,11 @@ SQLRETURN SQL_API SQLGetData(
     } else if (std::holds_alternative<std::string>(cell)) {
         const std::string& value = std::get<std::string>(cell);
         
-        if (effective_type == SQL_C_WCHAR) {
-            // Convert UTF-8 string to UTF-16 (SQLWCHAR)
-            SQLSMALLINT wbytes = 0;
-            SQLRETURN r = copy_string_to_wbuffer(value,
-                              static_cast<SQLWCHAR*>(rgbValue),
-                              static_cast<SQLINTEGER>(cbValueMax), &wbytes);
-            // pcbValue reports total bytes needed (excl NUL), regardless of truncation
-            if (pcbValue) *pcbValue = static_cast<SQLLEN>(wbytes);
-            if (r == SQL_SUCCESS_WITH_INFO) {
-                stmt->add_diagnostic(sqlstate::STRING_TRUNCATED, 0,
-                                    "String data, right truncated");
-                return SQL_SUCCESS_WITH_INFO;
-            }
+        if (effective_type == SQL_C_CHAR || effective_type == SQL_C_WCHAR ||
+            effective_type == SQL_C_BINARY) {
+            // Long data: successive calls return successive pieces
+            return get_data_piece(stmt, icol, effective_type, value,
+                                  rgbValue, cbValueMax, pcbValue);
         } else if (effective_type == SQL_C_TYPE_DATE) {
             // Parse date string "YYYY-MM-DD" into SQL_DATE_STRUCT
             SQL_DATE_STRUCT ds = {0, 0, 0};
@@ -835,7 +1281,7 @@ SQLRETURN SQL_API SQLGetData(
             if (rgbValue) *static_cast<SQL_TIMESTAMP_STRUCT*>(rgbValue) = tss;
             if (pcbValue) *pcbValue = sizeof(SQL_TIMESTAMP_STRUCT);
         } else {
-            // SQL_C_CHAR or default — return ANSI
+            // Other types — return ANSI
             if (rgbValue && cbValueMax > 0) {
                 size_t copy_len = std::min(value.length(), static_cast<size_t>(cbValueMax - 1));
                 std::memcpy(rgbValue, value.c_str(), copy_len);
@@ -889,6 +1335,7 @@ SQLRETURN SQL_API SQLNumResultCols(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     if (pccol) {
         *pccol = stmt->num_result_cols_;
@@ -910,6 +1357,7 @@ SQLRETURN SQL_API SQLDescribeCol(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     if (icol < 1 || icol > static_cast<SQLUSMALLINT>(stmt->column_names_.size())) {
         stmt->add_diagnostic(sqlstate::INVALID_PARAMETER_NUMBER, 0,
@@ -961,6 +1409,7 @@ SQLRETURN SQL_API SQLBindCol(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     if (icol == 0) {
         // Unbind bookmark column - not supported
@@ -1000,6 +1449,7 @@ SQLRETURN SQL_API SQLBindParameter(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     if (ipar == 0) {
         stmt->add_diagnostic(sqlstate::INVALID_PARAMETER_NUMBER, 0,
@@ -1062,6 +1512,7 @@ SQLRETURN SQL_API SQLRowCount(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     if (pcrow) {
         *pcrow = stmt->row_count_;
@@ -1073,6 +1524,7 @@ SQLRETURN SQL_API SQLRowCount(
 SQLRETURN SQL_API SQLCloseCursor(SQLHSTMT hstmt) {
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     if (!stmt->cursor_open_) {
         stmt->add_diagnostic(sqlstate::INVALID_CURSOR_STATE, 0,
@@ -1082,7 +1534,8 @@ SQLRETURN SQL_API SQLCloseCursor(SQLHSTMT hstmt) {
     
     stmt->cursor_open_ = false;
     stmt->current_row_ = -1;
-    stmt->result_data_.clear();
+    stmt->wire_rows_received_ = 0;
+    stmt->clear_result_rows();
     
     return SQL_SUCCESS;
 }
@@ -1090,6 +1543,7 @@ SQLRETURN SQL_API SQLCloseCursor(SQLHSTMT hstmt) {
 SQLRETURN SQL_API SQLMoreResults(SQLHSTMT hstmt) {
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     // Mock driver doesn't support multiple result sets
     return SQL_NO_DATA;
@@ -1137,6 +1591,16 @@ SQLRETURN SQL_API SQLGetStmtAttr(
             if (pcbValue) *pcbValue = sizeof(SQLULEN);
             break;
             
+        case SQL_ATTR_ROW_BIND_TYPE:
+            if (rgbValue) *static_cast<SQLULEN*>(rgbValue) = stmt->row_bind_type_;
+            if (pcbValue) *pcbValue = sizeof(SQLULEN);
+            break;
+            
+        case SQL_ATTR_ROW_STATUS_PTR:
+            if (rgbValue) *static_cast<SQLUSMALLINT**>(rgbValue) = stmt->row_status_ptr_;
+            if (pcbValue) *pcbValue = sizeof(SQLUSMALLINT*);
+            break;
+            
         case SQL_ATTR_PARAMSET_SIZE:
             if (rgbValue) *static_cast<SQLULEN*>(rgbValue) = stmt->paramset_size_;
             if (pcbValue) *pcbValue = sizeof(SQLULEN);
@@ -1146,6 +1610,11 @@ SQLRETURN SQL_API SQLGetStmtAttr(
             if (rgbValue) *static_cast<SQLULEN*>(rgbValue) = stmt->async_enable_;
             if (pcbValue) *pcbValue = sizeof(SQLULEN);
             break;
+            
+        case SQL_ATTR_METADATA_ID:
+            if (rgbValue) *static_cast<SQLULEN*>(rgbValue) = stmt->metadata_id_;
+            if (pcbValue) *pcbValue = sizeof(SQLULEN);
+            break;
 
         // Array parameter attributes
         case SQL_ATTR_PARAM_STATUS_PTR:
@@ -1210,6 +1679,7 @@ SQLRETURN SQL_API SQLSetStmtAttr(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     SQLULEN value = reinterpret_cast<SQLULEN>(rgbValue);
     
@@ -1234,12 +1704,27 @@ SQLRETURN SQL_API SQLSetStmtAttr(
             stmt->row_array_size_ = value;
             break;
             
+        case SQL_ATTR_ROW_BIND_TYPE:
+            stmt->row_bind_type_ = value;
+            break;
+            
+        case SQL_ATTR_ROW_STATUS_PTR:
+            stmt->row_status_ptr_ = static_cast<SQLUSMALLINT*>(rgbValue);
+            break;
+            
         case SQL_ATTR_PARAMSET_SIZE:
             stmt->paramset_size_ = value;
             break;
             
         case SQL_ATTR_ASYNC_ENABLE:
             stmt->async_enable_ = value;
+            // The async worker and the application's polling thread share
+            // the statement, so it locks even with ThreadSafety=None
+            stmt->thread_safe_ = value == SQL_ASYNC_ENABLE_ON || stmt->connection()->thread_safe_;
+            break;
+            
+        case SQL_ATTR_METADATA_ID:
+            stmt->metadata_id_ = value;
             break;
             
         // Array parameter attributes
@@ -1277,12 +1762,15 @@ SQLRETURN SQL_API SQLFreeStmt(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     switch (fOption) {
         case SQL_CLOSE:
             stmt->cursor_open_ = false;
             stmt->current_row_ = -1;
-            stmt->result_data_.clear();
+            stmt->wire_rows_received_ = 0;
+            stmt->clear_result_rows();
+            stmt->result_table_.clear();
             break;
             
         case SQL_UNBIND:
@@ -1294,7 +1782,7 @@ SQLRETURN SQL_API SQLFreeStmt(
             break;
             
         case SQL_DROP:
-            delete stmt;
+            stmt->connection()->free_statement(stmt);
             break;
     }
     
@@ -1305,9 +1793,254 @@ SQLRETURN SQL_API SQLCancel(SQLHSTMT hstmt) {
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
     
-    // Mock: just reset state
+    // An asynchronous function that has not started its work yet completes
+    // with HY008 on the next poll. The operation is copied without taking
+    // the statement lock, which its worker may be holding.
+    if (auto op = std::atomic_load(&stmt->async_op_)) {
+        op->canceled.store(true);
+        stmt->cancel_signal_.cancel();
+        return SQL_SUCCESS;
+    }
+    
+    // A synchronous call waiting out its latency on another thread fails
+    // with HY008; signalled before locking, since that call holds the lock
+    stmt->cancel_signal_.cancel();
+    
+    // Mock: just reset state, abandoning any data-at-execution sequence
+    HandleLock lock(stmt);
     stmt->cursor_open_ = false;
+    stmt->data_at_exec_.reset();
+    
+    return SQL_SUCCESS;
+}
+
+// Data-at-execution parameters: after SQLExecute/SQLExecDirect returns
+// SQL_NEED_DATA, SQLParamData names each parameter in turn (by its bound
+// value pointer) and SQLPutData sends its value, in pieces for character
+// and binary data. The SQLParamData call after the last parameter runs the
+// statement.
+SQLRETURN SQL_API SQLParamData(
+    SQLHSTMT hstmt,
+    SQLPOINTER* prgbValue) {
+    
+    auto* stmt = validate_stmt_handle(hstmt);
+    if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
+    HandleLock lock(stmt);
+    
+    stmt->clear_diagnostics();
+    
+    if (!stmt->data_at_exec_) {
+        stmt->add_diagnostic(sqlstate::FUNCTION_SEQUENCE_ERROR, 0,
+                            "No data-at-execution parameters are pending");
+        return SQL_ERROR;
+    }
+    
+    auto& state = *stmt->data_at_exec_;
+    state.current++;
+    if (state.current < static_cast<int>(state.params.size())) {
+        auto it = stmt->parameter_bindings_.find(state.params[state.current].number);
+        if (prgbValue) {
+            *prgbValue = it != stmt->parameter_bindings_.end() ? it->second.param_value : nullptr;
+        }
+        return SQL_NEED_DATA;
+    }
+    
+    return finish_data_at_exec(stmt);
+}
+
+SQLRETURN SQL_API SQLPutData(
+    SQLHSTMT hstmt,
+    SQLPOINTER rgbValue,
+    SQLLEN cbValue) {
+    
+    auto* stmt = validate_stmt_handle(hstmt);
+    if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
+    HandleLock lock(stmt);
+    
+    stmt->clear_diagnostics();
     
+    auto& state = stmt->data_at_exec_;
+    if (!state || state->current < 0 ||
+        state->current >= static_cast<int>(state->params.size())) {
+        stmt->add_diagnostic(sqlstate::FUNCTION_SEQUENCE_ERROR, 0,
+                            "SQLPutData called without a current data-at-execution parameter");
+        return SQL_ERROR;
+    }
+    
+    auto& param = state->params[state->current];
+    auto it = stmt->parameter_bindings_.find(param.number);
+    SQLSMALLINT value_type = it != stmt->parameter_bindings_.end() ? it->second.value_type : SQL_C_BINARY;
+    
+    if (param.received && (param.is_null || !is_piecewise_type(value_type))) {
+        stmt->add_diagnostic(sqlstate::NON_CHARACTER_DATA_IN_PIECES, 0,
+                            "Non-character and non-binary data sent in pieces");
+        return SQL_ERROR;
+    }
+    
+    if (cbValue == SQL_NULL_DATA) {
+        if (param.received) {
+            stmt->add_diagnostic(sqlstate::INVALID_ARGUMENT_VALUE, 0,
+                                "SQL_NULL_DATA sent after data for the same parameter");
+            return SQL_ERROR;
+        }
+        param.is_null = true;
+        param.received = true;
+        return SQL_SUCCESS;
+    }
+    
+    // Chunk length in bytes
+    size_t length;
+    if (!is_piecewise_type(value_type)) {
+        length = value_type == SQL_C_NUMERIC
+            ? sizeof(SQL_NUMERIC_STRUCT)
+            : static_cast<size_t>(c_type_element_size(value_type, cbValue));
+    } else if (cbValue == SQL_NTS) {
+        length = 0;
+        if (rgbValue && value_type == SQL_C_WCHAR) {
+            const auto* w = static_cast<const SQLWCHAR*>(rgbValue);
+            while (w[length]) ++length;
+            length *= sizeof(SQLWCHAR);
+        } else if (rgbValue) {
+            length = std::strlen(static_cast<const char*>(rgbValue));
+        }
+    } else if (cbValue < 0) {
+        stmt->add_diagnostic(sqlstate::INVALID_STRING_OR_BUFFER_LENGTH, 0,
+                            "Invalid string or buffer length");
+        return SQL_ERROR;
+    } else {
+        length = static_cast<size_t>(cbValue);
+    }
+    
+    if (!rgbValue && length > 0) {
+        stmt->add_diagnostic(sqlstate::INVALID_ARGUMENT_VALUE, 0,
+                            "Invalid use of null pointer");
+        return SQL_ERROR;
+    }
+    
+    const auto& config = BehaviorController::instance().config();
+    if (!simulate_network_delay(stmt, config.network.transfer_time(length))) {
+        return SQL_ERROR;
+    }
+    
+    try {
+        append_chunk(param.data, static_cast<const char*>(rgbValue), length);
+    } catch (const std::bad_alloc&) {
+        stmt->add_diagnostic(sqlstate::MEMORY_ALLOCATION_ERROR, 0,
+                            "Memory allocation error");
+        return SQL_ERROR;
+    }
+    param.received = true;
+    
+    return SQL_SUCCESS;
+}
+
+// Bulk operations: SQL_ADD appends the rowset in the bound column buffers
+// (SQL_ATTR_ROW_ARRAY_SIZE rows) to the table of the current result set in
+// one batch, with no SQL to parse. Other operations are not supported.
+SQLRETURN SQL_API SQLBulkOperations(
+    SQLHSTMT hstmt,
+    SQLSMALLINT Operation) {
+    
+    auto* stmt = validate_stmt_handle(hstmt);
+    if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
+    HandleLock lock(stmt);
+    
+    stmt->clear_diagnostics();
+    if (reject_if_need_data(stmt)) return SQL_ERROR;
+    
+    if (Operation != SQL_ADD) {
+        stmt->add_diagnostic(sqlstate::OPTIONAL_FEATURE_NOT_IMPLEMENTED, 0,
+                            "Only SQL_ADD bulk operations are supported");
+        return SQL_ERROR;
+    }
+    
+    if (!stmt->executed_ || stmt->result_table_.empty()) {
+        stmt->add_diagnostic(sqlstate::FUNCTION_SEQUENCE_ERROR, 0,
+                            "No result set over a table to add rows to");
+        return SQL_ERROR;
+    }
+    
+    if (stmt->concurrency_ == SQL_CONCUR_READ_ONLY) {
+        stmt->add_diagnostic(sqlstate::INVALID_HANDLE_TYPE, 0,
+                            "SQL_ADD requires SQL_ATTR_CONCURRENCY other than SQL_CONCUR_READ_ONLY");
+        return SQL_ERROR;
+    }
+    
+    const auto& config = BehaviorController::instance().config();
+    if (config.should_fail(DriverFunction::SQLBulkOperations)) {
+        stmt->add_diagnostic(config.error_code, 0, "Simulated bulk operation failure");
+        return SQL_ERROR;
+    }
+    
+    // Read the rowset from each bound result column
+    struct BoundColumn {
+        const std::string* name;    // Result columns carry the table's column names
+        std::vector<CellValue> values;
+    };
+    const SQLULEN rows = std::max<SQLULEN>(stmt->row_array_size_, 1);
+    std::vector<BoundColumn> bound;
+    size_t wire_bytes = 0;
+    for (const auto& [col_num, b] : stmt->column_bindings_) {
+        if (col_num < 1 || col_num > stmt->column_names_.size()) continue;
+        BoundColumn column{&stmt->column_names_[col_num - 1], {}};
+        column.values.reserve(rows);
+        for (SQLULEN r = 0; r < rows; ++r) {
+            CellValue value = read_bound_value(b.target_type, b.target_value, b.buffer_length,
+                                               b.str_len_or_ind, r, stmt->row_bind_type_);
+            wire_bytes += std::holds_alternative<std::string>(value)
+                ? std::get<std::string>(value).size() : sizeof(long long);
+            column.values.push_back(std::move(value));
+        }
+        bound.push_back(std::move(column));
+    }
+    
+    // One round trip carries the whole rowset
+    if (!simulate_statement_latency(stmt, DriverFunction::SQLBulkOperations, true) ||
+        !simulate_network_delay(stmt, config.network.transfer_time(wire_bytes))) {
+        return SQL_ERROR;
+    }
+    
+    // Look up the table, map the columns and insert under one catalog lock
+    // so the table cannot change in between
+    auto& catalog = MockCatalog::instance();
+    bool written;
+    {
+        std::lock_guard<std::mutex> catalog_lock(catalog.mutex());
+        const MockTable* table = catalog.find_table(stmt->result_table_);
+        if (!table) {
+            stmt->add_diagnostic(sqlstate::TABLE_NOT_FOUND, 0,
+                                "Table not found: " + stmt->result_table_);
+            return SQL_ERROR;
+        }
+        
+        std::vector<MockRow> batch(rows, MockRow(table->columns.size()));
+        for (auto& column : bound) {
+            for (size_t j = 0; j < table->columns.size(); ++j) {
+                if (table->columns[j].name == *column.name) {
+                    for (SQLULEN r = 0; r < rows; ++r) {
+                        batch[r][j] = std::move(column.values[r]);
+                    }
+                    break;
+                }
+            }
+        }
+        written = catalog.insert_rows(stmt->result_table_, std::move(batch),
+                                      stmt->connection()->transaction());
+    }
+    if (!written) {
+        stmt->add_diagnostic(sqlstate::GENERAL_ERROR, 0,
+                            "Could not write rows to the data file");
+        return SQL_ERROR;
+    }
+    
+    if (stmt->row_status_ptr_) {
+        std::fill(stmt->row_status_ptr_, stmt->row_status_ptr_ + rows,
+                  static_cast<SQLUSMALLINT>(SQL_ROW_ADDED));
+    }
+    stmt->row_count_ = static_cast<SQLLEN>(rows);
     return SQL_SUCCESS;
 }
 
@@ -1317,6 +2050,7 @@ SQLRETURN SQL_API SQLNumParams(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     // Count ? placeholders in SQL
     int count = 0;
@@ -1339,6 +2073,7 @@ SQLRETURN SQL_API SQLDescribeParam(
     
     auto* stmt = validate_stmt_handle(hstmt);
     if (!stmt) return SQL_INVALID_HANDLE;
+    if (reject_if_async_pending(stmt)) return SQL_ERROR;
     
     if (!stmt->prepared_) {
         stmt->add_diagnostic(sqlstate::FUNCTION_SEQUENCE_ERROR, 0,
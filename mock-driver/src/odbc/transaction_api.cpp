@@ -7,6 +7,37 @@
 
 using namespace mock_odbc;
 
+namespace {
+
+// Close the connection's cursors and commit or roll back its transaction.
+// A failed commit posts its diagnostic on `handle` (the one SQLEndTran was
+// called with); the transaction is rolled back either way.
+bool end_transaction(ConnectionHandle* conn, SQLSMALLINT type, OdbcHandle* handle) {
+    for (auto* stmt : conn->statements_) {
+        stmt->cursor_open_ = false;
+        if (type == SQL_ROLLBACK) {
+            stmt->executed_ = false;
+            stmt->clear_result_rows();
+        }
+    }
+    if (!conn->transaction_) return true;
+    
+    auto& catalog = MockCatalog::instance();
+    std::lock_guard<std::mutex> lock(catalog.mutex());
+    if (type == SQL_ROLLBACK) {
+        catalog.rollback(*conn->transaction_);
+        return true;
+    }
+    std::string state, message;
+    if (!catalog.commit(*conn->transaction_, state, message)) {
+        handle->add_diagnostic(state, 0, message);
+        return false;
+    }
+    return true;
+}
+
+} // anonymous namespace
+
 extern "C" {
 
 SQLRETURN SQL_API SQLEndTran(
@@ -15,7 +46,7 @@ SQLRETURN SQL_API SQLEndTran(
     SQLSMALLINT fType) {
     
     const auto& config = BehaviorController::instance().config();
-    if (config.should_fail("SQLEndTran")) {
+    if (config.should_fail(DriverFunction::SQLEndTran)) {
         if (fHandleType == SQL_HANDLE_DBC) {
             auto* conn = validate_dbc_handle(hHandle);
             if (conn) {
@@ -25,27 +56,21 @@ SQLRETURN SQL_API SQLEndTran(
         return SQL_ERROR;
     }
     
-    config.apply_latency();
+    config.apply_latency(DriverFunction::SQLEndTran);
+    config.apply_round_trip();
     
     if (fHandleType == SQL_HANDLE_ENV) {
         auto* env = validate_env_handle(hHandle);
         if (!env) return SQL_INVALID_HANDLE;
         
+        env->clear_diagnostics();
+        
         // Commit/rollback all connections
+        bool failed = false;
         for (auto* conn : env->connections_) {
-            // Close all cursors
-            for (auto* stmt : conn->statements_) {
-                stmt->cursor_open_ = false;
-                if (fType == SQL_ROLLBACK) {
-                    stmt->executed_ = false;
-                    stmt->result_data_.clear();
-                }
-            }
-        }
-        
-        if (fType == SQL_ROLLBACK) {
-            MockCatalog::instance().clear_inserted_data();
+            if (!end_transaction(conn, fType, env)) failed = true;
         }
+        if (failed) return SQL_ERROR;
     } else if (fHandleType == SQL_HANDLE_DBC) {
         auto* conn = validate_dbc_handle(hHandle);
         if (!conn) return SQL_INVALID_HANDLE;
@@ -58,18 +83,7 @@ SQLRETURN SQL_API SQLEndTran(
             return SQL_ERROR;
         }
         
-        // Close all cursors on this connection
-        for (auto* stmt : conn->statements_) {
-            stmt->cursor_open_ = false;
-            if (fType == SQL_ROLLBACK) {
-                stmt->executed_ = false;
-                stmt->result_data_.clear();
-            }
-        }
-        
-        if (fType == SQL_ROLLBACK) {
-            MockCatalog::instance().clear_inserted_data();
-        }
+        if (!end_transaction(conn, fType, conn)) return SQL_ERROR;
     } else {
         return SQL_INVALID_HANDLE;
     }
@@ -14,7 +14,7 @@ namespace mock_odbc {
 // ============================================================
 
 SQLRETURN copy_string_to_buffer(
-    const std::string& src,
+    std::string_view src,
     SQLCHAR* target,
     SQLSMALLINT buffer_length,
     SQLSMALLINT* string_length) {
@@ -31,7 +31,7 @@ SQLRETURN copy_string_to_buffer(
     
     // Copy with truncation check
     SQLSMALLINT copy_len = std::min(src_len, static_cast<SQLSMALLINT>(buffer_length - 1));
-    std::memcpy(target, src.c_str(), copy_len);
+    std::memcpy(target, src.data(), copy_len);
     target[copy_len] = '\0';
     
     if (src_len >= buffer_length) {
@@ -117,6 +117,30 @@ static std::string utf16_to_utf8(const SQLWCHAR* src, SQLINTEGER char_count) {
 #endif
 }
 
+// Internal: decode one UTF-8 sequence at p, advancing p past it.
+// Returns false (after skipping one byte) for an invalid lead byte.
+static bool decode_utf8(const unsigned char*& p, const unsigned char* end, uint32_t& cp) {
+    if (*p < 0x80) {
+        cp = *p++;
+    } else if ((*p & 0xE0) == 0xC0) {
+        cp = (*p++ & 0x1F) << 6;
+        if (p < end) cp |= (*p++ & 0x3F);
+    } else if ((*p & 0xF0) == 0xE0) {
+        cp = (*p++ & 0x0F) << 12;
+        if (p < end) cp |= (*p++ & 0x3F) << 6;
+        if (p < end) cp |= (*p++ & 0x3F);
+    } else if ((*p & 0xF8) == 0xF0) {
+        cp = (*p++ & 0x07) << 18;
+        if (p < end) cp |= (*p++ & 0x3F) << 12;
+        if (p < end) cp |= (*p++ & 0x3F) << 6;
+        if (p < end) cp |= (*p++ & 0x3F);
+    } else {
+        ++p;
+        return false;
+    }
+    return true;
+}
+
 // Internal: UTF-8 → UTF-16 conversion
 // Returns number of SQLWCHAR characters written (excluding null terminator).
 // If target is null, just returns the required character count.
@@ -159,24 +183,7 @@ static SQLINTEGER utf8_to_utf16(const std::string& src,
     const unsigned char* end = p + src.length();
     while (p < end) {
         uint32_t cp;
-        if (*p < 0x80) {
-            cp = *p++;
-        } else if ((*p & 0xE0) == 0xC0) {
-            cp = (*p++ & 0x1F) << 6;
-            if (p < end) cp |= (*p++ & 0x3F);
-        } else if ((*p & 0xF0) == 0xE0) {
-            cp = (*p++ & 0x0F) << 12;
-            if (p < end) cp |= (*p++ & 0x3F) << 6;
-            if (p < end) cp |= (*p++ & 0x3F);
-        } else if ((*p & 0xF8) == 0xF0) {
-            cp = (*p++ & 0x07) << 18;
-            if (p < end) cp |= (*p++ & 0x3F) << 12;
-            if (p < end) cp |= (*p++ & 0x3F) << 6;
-            if (p < end) cp |= (*p++ & 0x3F);
-        } else {
-            ++p; // skip invalid byte
-            continue;
-        }
+        if (!decode_utf8(p, end, cp)) continue;  // skip invalid byte
         if (cp < 0x10000) {
             ++total_chars;
             if (target && out_idx < max_chars - 1) {
@@ -246,6 +253,45 @@ SQLRETURN copy_string_to_wbuffer(
     return SQL_SUCCESS;
 }
 
+size_t utf16_length(const char* src, size_t length) {
+    const unsigned char* p = reinterpret_cast<const unsigned char*>(src);
+    const unsigned char* end = p + length;
+    size_t units = 0;
+    while (p < end) {
+        uint32_t cp;
+        if (!decode_utf8(p, end, cp)) continue;
+        units += cp < 0x10000 ? 1 : 2;
+    }
+    return units;
+}
+
+size_t utf8_to_utf16_partial(const char* src, size_t length, size_t& offset,
+                             SQLWCHAR* target, size_t max_chars) {
+    const unsigned char* base = reinterpret_cast<const unsigned char*>(src);
+    const unsigned char* p = base + offset;
+    const unsigned char* end = base + length;
+    size_t out = 0;
+    while (p < end) {
+        const unsigned char* start = p;
+        uint32_t cp;
+        if (!decode_utf8(p, end, cp)) continue;
+        size_t units = cp < 0x10000 ? 1 : 2;
+        if (out + units > max_chars) {
+            p = start;  // Does not fit; resume here next time
+            break;
+        }
+        if (units == 1) {
+            target[out++] = static_cast<SQLWCHAR>(cp);
+        } else {
+            cp -= 0x10000;
+            target[out++] = static_cast<SQLWCHAR>(0xD800 + (cp >> 10));
+            target[out++] = static_cast<SQLWCHAR>(0xDC00 + (cp & 0x3FF));
+        }
+    }
+    offset = static_cast<size_t>(p - base);
+    return out;
+}
+
 std::string sqlw_to_string(const SQLWCHAR* sql_str, SQLSMALLINT length) {
     return sqlw_to_string(sql_str, static_cast<SQLINTEGER>(length));
 }
@@ -2,12 +2,13 @@
 
 #include "../driver/common.hpp"
 #include <string>
+#include <string_view>
 
 namespace mock_odbc {
 
 // Copy string to SQLCHAR buffer with proper truncation handling
 SQLRETURN copy_string_to_buffer(
-    const std::string& src,
+    std::string_view src,
     SQLCHAR* target,
     SQLSMALLINT buffer_length,
     SQLSMALLINT* string_length);
@@ -27,6 +28,17 @@ SQLRETURN copy_string_to_wbuffer(
     SQLINTEGER buffer_length,
     SQLSMALLINT* string_length);
 
+// Number of UTF-16 code units needed for `length` bytes of UTF-8
+size_t utf16_length(const char* src, size_t length);
+
+// Encode UTF-8 from byte `offset` as UTF-16 into at most `max_chars` units
+// of `target`, stopping before a character that does not fit. Advances
+// `offset` past what was encoded and returns the units written; no
+// terminator is added. Lets a long value be returned in pieces without
+// converting it all first.
+size_t utf8_to_utf16_partial(const char* src, size_t length, size_t& offset,
+                             SQLWCHAR* target, size_t max_chars);
+
 // Convert SQLCHAR* to std::string (UTF-8 passthrough)
 std::string sql_to_string(const SQLCHAR* sql_str, SQLSMALLINT length);
 
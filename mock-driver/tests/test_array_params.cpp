@@ -0,0 +1,153 @@
+// Array Parameter Tests - INSERT executed for arrays of parameter sets
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <string>
+#include <vector>
+
+class ArrayParamsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        ASSERT_EQ(SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0), SQL_SUCCESS);
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc), SQL_SUCCESS);
+
+        const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+        SQLRETURN ret = SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                         NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt)));
+
+        SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE ARRAY_TEST", SQL_NTS);
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt,
+            (SQLCHAR*)"CREATE TABLE ARRAY_TEST (ID INTEGER, NAME VARCHAR(20), KIND VARCHAR(10))", SQL_NTS)));
+    }
+
+    void TearDown() override {
+        if (hstmt != SQL_NULL_HSTMT) {
+            SQLFreeStmt(hstmt, SQL_CLOSE);
+            SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE ARRAY_TEST", SQL_NTS);
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        }
+        if (hdbc != SQL_NULL_HDBC) {
+            SQLDisconnect(hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        }
+        if (henv != SQL_NULL_HENV) {
+            SQLFreeHandle(SQL_HANDLE_ENV, henv);
+        }
+    }
+
+    // Read back all rows as "ID:NAME:KIND"
+    std::vector<std::string> select_rows() {
+        std::vector<std::string> rows;
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+        SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0);
+        SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)SQL_PARAM_BIND_BY_COLUMN, 0);
+        if (!SQL_SUCCEEDED(SQLExecDirect(hstmt,
+                (SQLCHAR*)"SELECT ID, NAME, KIND FROM ARRAY_TEST", SQL_NTS))) {
+            return rows;
+        }
+        while (SQL_SUCCEEDED(SQLFetch(hstmt))) {
+            SQLINTEGER id = 0;
+            char name[32] = {0};
+            char kind[16] = {0};
+            SQLLEN ind = 0, name_ind = 0, kind_ind = 0;
+            SQLGetData(hstmt, 1, SQL_C_SLONG, &id, 0, &ind);
+            SQLGetData(hstmt, 2, SQL_C_CHAR, name, sizeof(name), &name_ind);
+            SQLGetData(hstmt, 3, SQL_C_CHAR, kind, sizeof(kind), &kind_ind);
+            rows.push_back(std::to_string(id) + ":" +
+                           (name_ind == SQL_NULL_DATA ? "<null>" : name) + ":" +
+                           (kind_ind == SQL_NULL_DATA ? "<null>" : kind));
+        }
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return rows;
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(ArrayParamsTest, ColumnWiseInsertWithLiteralAndIgnoredSet) {
+    ASSERT_EQ(SQLPrepare(hstmt,
+        (SQLCHAR*)"INSERT INTO ARRAY_TEST (ID, KIND, NAME) VALUES (?, 'fixed', ?)", SQL_NTS),
+        SQL_SUCCESS);
+
+    SQLINTEGER ids[3] = {1, 2, 3};
+    char names[3][20] = {"one", "two", "three"};
+    SQLLEN name_ind[3] = {SQL_NTS, SQL_NTS, SQL_NULL_DATA};
+    SQLUSMALLINT ops[3] = {SQL_PARAM_PROCEED, SQL_PARAM_IGNORE, SQL_PARAM_PROCEED};
+    SQLUSMALLINT status[3] = {0, 0, 0};
+    SQLULEN processed = 0;
+
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)3, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_OPERATION_PTR, ops, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR, status, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0,
+                               ids, 0, nullptr), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 20, 0,
+                               names, sizeof(names[0]), name_ind), SQL_SUCCESS);
+
+    ASSERT_EQ(SQLExecute(hstmt), SQL_SUCCESS);
+    EXPECT_EQ(processed, 3u);
+    EXPECT_EQ(status[0], SQL_PARAM_SUCCESS);
+    EXPECT_EQ(status[1], SQL_PARAM_UNUSED);
+    EXPECT_EQ(status[2], SQL_PARAM_SUCCESS);
+    SQLLEN row_count = 0;
+    EXPECT_EQ(SQLRowCount(hstmt, &row_count), SQL_SUCCESS);
+    EXPECT_EQ(row_count, 2);
+
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_OPERATION_PTR, nullptr, 0);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR, nullptr, 0);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMS_PROCESSED_PTR, nullptr, 0);
+    EXPECT_EQ(select_rows(), (std::vector<std::string>{"1:one:fixed", "3:<null>:fixed"}));
+}
+
+TEST_F(ArrayParamsTest, RowWiseInsert) {
+    ASSERT_EQ(SQLPrepare(hstmt,
+        (SQLCHAR*)"INSERT INTO ARRAY_TEST VALUES (?, ?, ?)", SQL_NTS), SQL_SUCCESS);
+
+    struct Row {
+        SQLINTEGER id;
+        SQLLEN id_ind;
+        char name[20];
+        SQLLEN name_ind;
+        char kind[10];
+        SQLLEN kind_ind;
+    };
+    Row rows[2] = {{7, 0, "seven", SQL_NTS, "a", SQL_NTS},
+                   {8, 0, "eight", 3, "b", SQL_NTS}};
+
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)2, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)sizeof(Row), 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0,
+                               &rows[0].id, 0, &rows[0].id_ind), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 20, 0,
+                               rows[0].name, sizeof(rows[0].name), &rows[0].name_ind), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindParameter(hstmt, 3, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 10, 0,
+                               rows[0].kind, sizeof(rows[0].kind), &rows[0].kind_ind), SQL_SUCCESS);
+
+    ASSERT_EQ(SQLExecute(hstmt), SQL_SUCCESS);
+    EXPECT_EQ(select_rows(), (std::vector<std::string>{"7:seven:a", "8:eig:b"}));
+}
+
+TEST_F(ArrayParamsTest, MissingTableFailsEverySet) {
+    ASSERT_EQ(SQLPrepare(hstmt,
+        (SQLCHAR*)"INSERT INTO NO_SUCH_TABLE (ID) VALUES (?)", SQL_NTS), SQL_SUCCESS);
+
+    SQLINTEGER ids[2] = {1, 2};
+    SQLUSMALLINT status[2] = {0, 0};
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)2, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR, status, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0,
+                               ids, 0, nullptr), SQL_SUCCESS);
+
+    EXPECT_EQ(SQLExecute(hstmt), SQL_ERROR);
+    EXPECT_EQ(status[0], SQL_PARAM_ERROR);
+    EXPECT_EQ(status[1], SQL_PARAM_ERROR);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAM_STATUS_PTR, nullptr, 0);
+}
@@ -0,0 +1,203 @@
+// Asynchronous Execution Tests - SQL_ATTR_ASYNC_ENABLE on the worker pool
+#include <gtest/gtest.h>
+#include "driver/handles.hpp"
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+class AsyncTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        SQLRETURN ret;
+
+        ret = SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv);
+        ASSERT_EQ(ret, SQL_SUCCESS);
+
+        ret = SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+        ASSERT_EQ(ret, SQL_SUCCESS);
+
+        ret = SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+        ASSERT_EQ(ret, SQL_SUCCESS);
+
+        const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;"
+                               "ResultSetSize=5;Latency=50ms;";
+        ret = SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str, SQL_NTS, NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+        ret = SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+        ret = SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0);
+        ASSERT_EQ(ret, SQL_SUCCESS);
+    }
+
+    void TearDown() override {
+        if (hstmt != SQL_NULL_HSTMT) {
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        }
+        if (hdbc != SQL_NULL_HDBC) {
+            SQLDisconnect(hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        }
+        if (henv != SQL_NULL_HENV) {
+            SQLFreeHandle(SQL_HANDLE_ENV, henv);
+        }
+    }
+
+    // Repeat SQLExecDirect until it stops returning SQL_STILL_EXECUTING
+    SQLRETURN exec_to_completion(SQLHSTMT stmt, const char* sql) {
+        SQLRETURN ret;
+        while ((ret = SQLExecDirect(stmt, (SQLCHAR*)sql, SQL_NTS)) == SQL_STILL_EXECUTING) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return ret;
+    }
+
+    std::string first_sqlstate(SQLSMALLINT type, SQLHANDLE handle) {
+        SQLCHAR sqlstate[6] = {0};
+        SQLINTEGER native = 0;
+        SQLCHAR message[256];
+        SQLSMALLINT len = 0;
+        SQLGetDiagRec(type, handle, 1, sqlstate, &native, message, sizeof(message), &len);
+        return reinterpret_cast<char*>(sqlstate);
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(AsyncTest, ReportsStatementAsyncMode) {
+    SQLUINTEGER mode = 0;
+    SQLRETURN ret = SQLGetInfo(hdbc, SQL_ASYNC_MODE, &mode, sizeof(mode), NULL);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    EXPECT_EQ(mode, static_cast<SQLUINTEGER>(SQL_AM_STATEMENT));
+}
+
+TEST_F(AsyncTest, ExecDirectReturnsStillExecutingThenCompletes) {
+    const char* sql = "SELECT * FROM USERS";
+    SQLRETURN ret = SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS);
+    EXPECT_EQ(ret, SQL_STILL_EXECUTING);
+
+    ret = exec_to_completion(hstmt, sql);
+    ASSERT_TRUE(SQL_SUCCEEDED(ret));
+
+    int rows = 0;
+    for (;;) {
+        while ((ret = SQLFetch(hstmt)) == SQL_STILL_EXECUTING) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        if (ret == SQL_NO_DATA) break;
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        ++rows;
+    }
+    EXPECT_EQ(rows, 5);
+}
+
+TEST_F(AsyncTest, OtherFunctionsFailWithSequenceErrorWhilePending) {
+    SQLRETURN ret = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT * FROM USERS", SQL_NTS);
+    ASSERT_EQ(ret, SQL_STILL_EXECUTING);
+
+    SQLSMALLINT cols = 0;
+    ret = SQLNumResultCols(hstmt, &cols);
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(SQL_HANDLE_STMT, hstmt), "HY010");
+
+    ret = SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+    EXPECT_EQ(ret, SQL_ERROR);
+
+    ret = SQLDisconnect(hdbc);
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(SQL_HANDLE_DBC, hdbc), "HY010");
+
+    ret = exec_to_completion(hstmt, "SELECT * FROM USERS");
+    EXPECT_TRUE(SQL_SUCCEEDED(ret));
+}
+
+TEST_F(AsyncTest, SequenceErrorsStayOutOfOperationDiagnostics) {
+    const char* sql = "SELECT * FROM NO_SUCH_TABLE";
+    SQLRETURN ret = SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS);
+    ASSERT_EQ(ret, SQL_STILL_EXECUTING);
+
+    SQLSMALLINT cols = 0;
+    ret = SQLNumResultCols(hstmt, &cols);
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(SQL_HANDLE_STMT, hstmt), "HY010");
+
+    // The completing call reports only the operation's own records
+    ret = exec_to_completion(hstmt, sql);
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(SQL_HANDLE_STMT, hstmt), "42S02");
+    SQLINTEGER records = 0;
+    ret = SQLGetDiagField(SQL_HANDLE_STMT, hstmt, 0, SQL_DIAG_NUMBER, &records, 0, NULL);
+    ASSERT_EQ(ret, SQL_SUCCESS);
+    EXPECT_EQ(records, 1);
+}
+
+TEST_F(AsyncTest, CancelCompletesWithOperationCanceled) {
+    const char* sql = "SELECT * FROM USERS";
+    SQLRETURN ret = SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS);
+    ASSERT_EQ(ret, SQL_STILL_EXECUTING);
+
+    ret = SQLCancel(hstmt);
+    EXPECT_EQ(ret, SQL_SUCCESS);
+
+    ret = exec_to_completion(hstmt, sql);
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(SQL_HANDLE_STMT, hstmt), "HY008");
+
+    // The statement is usable again afterwards
+    ret = exec_to_completion(hstmt, sql);
+    EXPECT_TRUE(SQL_SUCCEEDED(ret));
+}
+
+TEST_F(AsyncTest, StatementsOverlapOnWorkerPool) {
+    SQLHSTMT second = SQL_NULL_HSTMT;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &second)));
+    ASSERT_EQ(SQLSetStmtAttr(second, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0),
+              SQL_SUCCESS);
+
+    const char* sql = "SELECT * FROM USERS";
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS), SQL_STILL_EXECUTING);
+    ASSERT_EQ(SQLExecDirect(second, (SQLCHAR*)sql, SQL_NTS), SQL_STILL_EXECUTING);
+    EXPECT_TRUE(SQL_SUCCEEDED(exec_to_completion(hstmt, sql)));
+    EXPECT_TRUE(SQL_SUCCEEDED(exec_to_completion(second, sql)));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    // Two 50ms executions run concurrently, not back to back
+    EXPECT_LT(elapsed.count(), 95);
+
+    SQLFreeHandle(SQL_HANDLE_STMT, second);
+}
+
+TEST_F(AsyncTest, AsyncStatementsLockWithoutThreadSafety) {
+    SQLHDBC unlocked = SQL_NULL_HDBC;
+    ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &unlocked), SQL_SUCCESS);
+    const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;"
+                           "ResultSetSize=5;ThreadSafety=None;";
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(unlocked, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                               NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+    SQLHSTMT stmt = SQL_NULL_HSTMT;
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, unlocked, &stmt)));
+    auto* handle = mock_odbc::validate_stmt_handle(stmt);
+    EXPECT_FALSE(handle->thread_safe_);
+
+    // The worker and the polling thread share the statement, so it locks
+    ASSERT_EQ(SQLSetStmtAttr(stmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0),
+              SQL_SUCCESS);
+    EXPECT_TRUE(handle->thread_safe_);
+    EXPECT_TRUE(SQL_SUCCEEDED(exec_to_completion(stmt, "SELECT * FROM USERS")));
+
+    ASSERT_EQ(SQLSetStmtAttr(stmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_OFF, 0),
+              SQL_SUCCESS);
+    EXPECT_FALSE(handle->thread_safe_);
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    SQLDisconnect(unlocked);
+    SQLFreeHandle(SQL_HANDLE_DBC, unlocked);
+}
@@ -0,0 +1,166 @@
+// Bulk Operations Tests - SQLBulkOperations(SQL_ADD) from a bound rowset
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <cstring>
+#include <string>
+#include <vector>
+
+class BulkOperationsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        ASSERT_EQ(SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0), SQL_SUCCESS);
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc), SQL_SUCCESS);
+
+        const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+        SQLRETURN ret = SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                         NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt)));
+
+        SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE BULK_TEST", SQL_NTS);
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt,
+            (SQLCHAR*)"CREATE TABLE BULK_TEST (ID INTEGER, NAME VARCHAR(20))", SQL_NTS)));
+    }
+
+    void TearDown() override {
+        if (hstmt != SQL_NULL_HSTMT) {
+            SQLFreeStmt(hstmt, SQL_CLOSE);
+            SQLFreeStmt(hstmt, SQL_UNBIND);
+            SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE BULK_TEST", SQL_NTS);
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        }
+        if (hdbc != SQL_NULL_HDBC) {
+            SQLDisconnect(hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        }
+        if (henv != SQL_NULL_HENV) {
+            SQLFreeHandle(SQL_HANDLE_ENV, henv);
+        }
+    }
+
+    std::string first_sqlstate() {
+        SQLCHAR sqlstate[6] = {0};
+        SQLINTEGER native = 0;
+        SQLCHAR message[256];
+        SQLSMALLINT len = 0;
+        SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, sqlstate, &native, message, sizeof(message), &len);
+        return reinterpret_cast<char*>(sqlstate);
+    }
+
+    // Open an updatable result set over BULK_TEST to add rows through
+    void open_rowset() {
+        ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_CONCURRENCY, (SQLPOINTER)SQL_CONCUR_LOCK, 0),
+                  SQL_SUCCESS);
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt,
+            (SQLCHAR*)"SELECT ID, NAME FROM BULK_TEST", SQL_NTS)));
+    }
+
+    // Read back all rows as "ID:NAME"
+    std::vector<std::string> select_rows() {
+        std::vector<std::string> rows;
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        SQLFreeStmt(hstmt, SQL_UNBIND);
+        if (!SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)"SELECT ID, NAME FROM BULK_TEST", SQL_NTS))) {
+            return rows;
+        }
+        while (SQL_SUCCEEDED(SQLFetch(hstmt))) {
+            SQLINTEGER id = 0;
+            char name[32] = {0};
+            SQLLEN id_ind = 0, name_ind = 0;
+            SQLGetData(hstmt, 1, SQL_C_SLONG, &id, 0, &id_ind);
+            SQLGetData(hstmt, 2, SQL_C_CHAR, name, sizeof(name), &name_ind);
+            rows.push_back(std::to_string(id) + ":" + (name_ind == SQL_NULL_DATA ? "<null>" : name));
+        }
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return rows;
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(BulkOperationsTest, AddAppendsColumnWiseRowset) {
+    open_rowset();
+
+    SQLINTEGER ids[3] = {1, 2, 3};
+    SQLLEN id_ind[3] = {0, 0, 0};
+    char names[3][20] = {"one", "two", ""};
+    SQLLEN name_ind[3] = {SQL_NTS, 3, SQL_NULL_DATA};
+    SQLUSMALLINT status[3] = {0, 0, 0};
+
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)3, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_STATUS_PTR, status, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindCol(hstmt, 1, SQL_C_SLONG, ids, 0, id_ind), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindCol(hstmt, 2, SQL_C_CHAR, names, sizeof(names[0]), name_ind), SQL_SUCCESS);
+
+    ASSERT_EQ(SQLBulkOperations(hstmt, SQL_ADD), SQL_SUCCESS);
+    for (auto s : status) EXPECT_EQ(s, SQL_ROW_ADDED);
+    SQLLEN row_count = 0;
+    EXPECT_EQ(SQLRowCount(hstmt, &row_count), SQL_SUCCESS);
+    EXPECT_EQ(row_count, 3);
+
+    EXPECT_EQ(select_rows(), (std::vector<std::string>{"1:one", "2:two", "3:<null>"}));
+}
+
+TEST_F(BulkOperationsTest, AddReadsRowWiseBinding) {
+    open_rowset();
+
+    struct Row {
+        SQLINTEGER id;
+        SQLLEN id_ind;
+        char name[20];
+        SQLLEN name_ind;
+    };
+    Row rows[2] = {{10, 0, "ten", SQL_NTS}, {20, 0, "twenty", SQL_NTS}};
+
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)2, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)sizeof(Row), 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindCol(hstmt, 1, SQL_C_SLONG, &rows[0].id, 0, &rows[0].id_ind), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindCol(hstmt, 2, SQL_C_CHAR, rows[0].name, sizeof(rows[0].name), &rows[0].name_ind),
+              SQL_SUCCESS);
+
+    ASSERT_EQ(SQLBulkOperations(hstmt, SQL_ADD), SQL_SUCCESS);
+
+    // The statement still reads single rows afterwards
+    SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)1, 0);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_BIND_TYPE, (SQLPOINTER)SQL_BIND_BY_COLUMN, 0);
+    EXPECT_EQ(select_rows(), (std::vector<std::string>{"10:ten", "20:twenty"}));
+}
+
+TEST_F(BulkOperationsTest, UnboundColumnsAreNull) {
+    open_rowset();
+
+    SQLINTEGER id = 7;
+    ASSERT_EQ(SQLBindCol(hstmt, 1, SQL_C_SLONG, &id, 0, nullptr), SQL_SUCCESS);
+    ASSERT_EQ(SQLBulkOperations(hstmt, SQL_ADD), SQL_SUCCESS);
+
+    EXPECT_EQ(select_rows(), (std::vector<std::string>{"7:<null>"}));
+}
+
+TEST_F(BulkOperationsTest, ReadOnlyCursorIsRejected) {
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt,
+        (SQLCHAR*)"SELECT ID, NAME FROM BULK_TEST", SQL_NTS)));
+
+    SQLINTEGER id = 1;
+    ASSERT_EQ(SQLBindCol(hstmt, 1, SQL_C_SLONG, &id, 0, nullptr), SQL_SUCCESS);
+    EXPECT_EQ(SQLBulkOperations(hstmt, SQL_ADD), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "HY092");
+}
+
+TEST_F(BulkOperationsTest, RequiresResultSet) {
+    SQLFreeStmt(hstmt, SQL_CLOSE);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_CONCURRENCY, (SQLPOINTER)SQL_CONCUR_LOCK, 0),
+              SQL_SUCCESS);
+    EXPECT_EQ(SQLBulkOperations(hstmt, SQL_ADD), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "HY010");
+}
+
+TEST_F(BulkOperationsTest, OtherOperationsAreNotImplemented) {
+    open_rowset();
+    EXPECT_EQ(SQLBulkOperations(hstmt, SQL_UPDATE_BY_BOOKMARK), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "HYC00");
+}
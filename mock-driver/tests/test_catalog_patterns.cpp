@@ -0,0 +1,247 @@
+// Catalog Pattern Tests - compiled search patterns and SQL_ATTR_METADATA_ID
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include "mock/like_pattern.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace mock_odbc;
+
+TEST(LikePatternTest, PlainNames) {
+    LikePattern pattern("Orders");
+    ASSERT_NE(pattern.exact_name(), nullptr);
+    EXPECT_EQ(*pattern.exact_name(), "ORDERS");
+    EXPECT_TRUE(pattern.matches("ORDERS"));
+    EXPECT_TRUE(pattern.matches("orders"));
+    EXPECT_FALSE(pattern.matches("ORDER"));
+    EXPECT_FALSE(pattern.matches("ORDERS2"));
+
+    EXPECT_TRUE(LikePattern("").matches_all());
+    EXPECT_TRUE(LikePattern("%").matches_all());
+    EXPECT_TRUE(LikePattern("%%").matches("anything"));
+}
+
+TEST(LikePatternTest, Wildcards) {
+    LikePattern prefix("ord%");
+    EXPECT_EQ(prefix.exact_name(), nullptr);
+    EXPECT_TRUE(prefix.matches("ORDERS"));
+    EXPECT_TRUE(prefix.matches("ORD"));
+    EXPECT_FALSE(prefix.matches("OR"));
+    EXPECT_FALSE(prefix.matches("WORDS"));
+
+    LikePattern suffix("%_ID");
+    EXPECT_TRUE(suffix.matches("CUSTOMER_ID"));
+    EXPECT_TRUE(suffix.matches("X_ID"));
+    EXPECT_FALSE(suffix.matches("ID"));
+    EXPECT_FALSE(suffix.matches("IDENT"));
+
+    LikePattern one("T_BLE_1");
+    EXPECT_TRUE(one.matches("TABLE_1"));
+    EXPECT_TRUE(one.matches("TxBLEx1"));
+    EXPECT_FALSE(one.matches("TABLE_10"));
+
+    LikePattern inner("%A%B_%C");
+    EXPECT_TRUE(inner.matches("ABXC"));
+    EXPECT_TRUE(inner.matches("xxAyyBzwwC"));
+    EXPECT_FALSE(inner.matches("ABC"));
+    EXPECT_FALSE(inner.matches("BxAC"));
+
+    LikePattern contains("%USER%");
+    EXPECT_TRUE(contains.matches("USERS"));
+    EXPECT_TRUE(contains.matches("APP_USER_ROLES"));
+    EXPECT_FALSE(contains.matches("USE"));
+
+    // The last segment is pinned to the end even when it also occurs earlier
+    LikePattern ends("A%A");
+    EXPECT_TRUE(ends.matches("AA"));
+    EXPECT_TRUE(ends.matches("ABA"));
+    EXPECT_FALSE(ends.matches("A"));
+    EXPECT_FALSE(ends.matches("AAB"));
+}
+
+TEST(LikePatternTest, EscapedWildcards) {
+    LikePattern name("ORDER\\_ITEMS");
+    ASSERT_NE(name.exact_name(), nullptr);
+    EXPECT_EQ(*name.exact_name(), "ORDER_ITEMS");
+    EXPECT_TRUE(name.matches("order_items"));
+    EXPECT_FALSE(name.matches("ORDERXITEMS"));
+
+    LikePattern prefix("TABLE\\_1%");
+    EXPECT_TRUE(prefix.matches("TABLE_1"));
+    EXPECT_TRUE(prefix.matches("TABLE_15"));
+    EXPECT_FALSE(prefix.matches("TABLEX1"));
+
+    EXPECT_TRUE(LikePattern("100\\%").matches("100%"));
+    EXPECT_FALSE(LikePattern("100\\%").matches("1000"));
+    EXPECT_TRUE(LikePattern("A\\\\B").matches("A\\B"));
+    // An escape before an ordinary character is itself ordinary
+    EXPECT_TRUE(LikePattern("A\\B").matches("A\\B"));
+    // Without an escape character the backslash is literal
+    EXPECT_TRUE(LikePattern("A\\_", '\0').matches("A\\x"));
+}
+
+TEST(LikePatternTest, Identifiers) {
+    LikePattern plain = LikePattern::identifier("order_%");
+    ASSERT_NE(plain.exact_name(), nullptr);
+    EXPECT_TRUE(plain.matches("ORDER_%"));
+    EXPECT_FALSE(plain.matches("ORDER_ITEMS"));
+
+    LikePattern quoted = LikePattern::identifier("\"My \"\"Table\"\"\"");
+    ASSERT_NE(quoted.exact_name(), nullptr);
+    EXPECT_EQ(*quoted.exact_name(), "MY \"TABLE\"");
+}
+
+class CatalogPatternTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+        SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(hdbc, NULL,
+            (SQLCHAR*)"Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;", SQL_NTS,
+            NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+        SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+    }
+
+    void TearDown() override {
+        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        SQLDisconnect(hdbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        SQLFreeHandle(SQL_HANDLE_ENV, henv);
+    }
+
+    // TABLE_NAME of every row SQLTables returns for `pattern`
+    std::vector<std::string> tables(const char* pattern) {
+        std::vector<std::string> names;
+        EXPECT_EQ(SQLTables(hstmt, NULL, 0, NULL, 0, (SQLCHAR*)pattern, SQL_NTS, NULL, 0),
+                  SQL_SUCCESS) << pattern;
+        SQLCHAR name[128];
+        SQLLEN ind = 0;
+        while (SQLFetch(hstmt) == SQL_SUCCESS) {
+            SQLGetData(hstmt, 3, SQL_C_CHAR, name, sizeof(name), &ind);
+            names.emplace_back(reinterpret_cast<char*>(name));
+        }
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        std::sort(names.begin(), names.end());
+        return names;
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+using Names = std::vector<std::string>;
+
+TEST_F(CatalogPatternTest, SearchPatterns) {
+    EXPECT_EQ(tables("orders"), Names({"ORDERS"}));
+    EXPECT_EQ(tables("ORDER%"), Names({"ORDERS", "ORDER_ITEMS"}));
+    EXPECT_EQ(tables("ORDER_%"), Names({"ORDERS", "ORDER_ITEMS"}));
+    EXPECT_EQ(tables("ORDER\\_%"), Names({"ORDER_ITEMS"}));
+    EXPECT_EQ(tables("%S"), Names({"CUSTOMERS", "ORDERS", "ORDER_ITEMS", "PRODUCTS", "USERS"}));
+    EXPECT_EQ(tables("NO_SUCH_TABLE"), Names());
+}
+
+TEST_F(CatalogPatternTest, MetadataIdTreatsArgumentsAsIdentifiers) {
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_METADATA_ID, (SQLPOINTER)SQL_TRUE, 0), SQL_SUCCESS);
+    SQLULEN value = SQL_FALSE;
+    ASSERT_EQ(SQLGetStmtAttr(hstmt, SQL_ATTR_METADATA_ID, &value, 0, NULL), SQL_SUCCESS);
+    EXPECT_EQ(value, static_cast<SQLULEN>(SQL_TRUE));
+
+    EXPECT_EQ(tables("ORDER%"), Names());
+    EXPECT_EQ(tables("\"orders\""), Names({"ORDERS"}));
+
+    // Columns of ORDERS named exactly ORDER_ID
+    ASSERT_EQ(SQLColumns(hstmt, NULL, 0, NULL, 0, (SQLCHAR*)"ORDERS", SQL_NTS,
+                         (SQLCHAR*)"ORDER_ID", SQL_NTS), SQL_SUCCESS);
+    int rows = 0;
+    while (SQLFetch(hstmt) == SQL_SUCCESS) ++rows;
+    SQLFreeStmt(hstmt, SQL_CLOSE);
+    EXPECT_EQ(rows, 1);
+
+    // Identifiers can't be null pointers
+    EXPECT_EQ(SQLColumns(hstmt, NULL, 0, NULL, 0, (SQLCHAR*)"ORDERS", SQL_NTS, NULL, 0), SQL_ERROR);
+    SQLCHAR state[6] = {};
+    SQLINTEGER native = 0;
+    SQLSMALLINT len = 0;
+    SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, state, &native, NULL, 0, &len);
+    EXPECT_STREQ(reinterpret_cast<char*>(state), "HY009");
+}
+
+TEST_F(CatalogPatternTest, ConnectionMetadataIdAppliesToNewStatements) {
+    ASSERT_EQ(SQLSetConnectAttr(hdbc, SQL_ATTR_METADATA_ID, (SQLPOINTER)SQL_TRUE, 0), SQL_SUCCESS);
+    SQLHSTMT later = SQL_NULL_HSTMT;
+    ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &later), SQL_SUCCESS);
+    SQLULEN value = SQL_FALSE;
+    ASSERT_EQ(SQLGetStmtAttr(later, SQL_ATTR_METADATA_ID, &value, 0, NULL), SQL_SUCCESS);
+    EXPECT_EQ(value, static_cast<SQLULEN>(SQL_TRUE));
+    SQLFreeHandle(SQL_HANDLE_STMT, later);
+
+    // The statement allocated before keeps treating arguments as patterns
+    EXPECT_EQ(tables("ORDER\\_%"), Names({"ORDER_ITEMS"}));
+}
+
+// Pattern and exact-name calls over 100000 tables: exact names are a hash
+// lookup and prefix patterns a single comparison per table
+TEST(CatalogPatternScaleTest, HundredThousandTables) {
+    SQLHENV env = SQL_NULL_HENV;
+    SQLHDBC dbc = SQL_NULL_HDBC;
+    SQLHSTMT stmt = SQL_NULL_HSTMT;
+    ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &env), SQL_SUCCESS);
+    SQLSetEnvAttr(env, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+    SQLAllocHandle(SQL_HANDLE_DBC, env, &dbc);
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(dbc, NULL,
+        (SQLCHAR*)"Driver={Mock ODBC Driver};Mode=Success;Catalog=Large;"
+                  "CatalogTables=100000;CatalogColumns=4;", SQL_NTS,
+        NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+    SQLAllocHandle(SQL_HANDLE_STMT, dbc, &stmt);
+
+    auto count_rows = [&] {
+        size_t rows = 0;
+        while (SQLFetch(stmt) == SQL_SUCCESS) ++rows;
+        SQLCloseCursor(stmt);
+        return rows;
+    };
+    auto timed = [](auto&& call) {
+        auto start = std::chrono::steady_clock::now();
+        call();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    };
+
+    size_t exact_rows = 0, prefix_rows = 0, column_rows = 0;
+    // The '_' in the names is escaped; unescaped it is a wildcard and the
+    // call scans every table
+    double exact_ms = timed([&] {
+        for (int i = 1; i <= 1000; ++i) {
+            std::string name = "TABLE\\_" + std::to_string(i * 97);
+            SQLTables(stmt, NULL, 0, NULL, 0, (SQLCHAR*)name.c_str(), SQL_NTS, NULL, 0);
+            exact_rows += count_rows();
+        }
+    });
+    // TABLE_99 and TABLE_990 .. TABLE_99999
+    double prefix_ms = timed([&] {
+        SQLTables(stmt, NULL, 0, NULL, 0, (SQLCHAR*)"TABLE\\_99%", SQL_NTS, NULL, 0);
+        prefix_rows = count_rows();
+    });
+    double column_ms = timed([&] {
+        SQLColumns(stmt, NULL, 0, NULL, 0, (SQLCHAR*)"TABLE\\_5000%", SQL_NTS,
+                   (SQLCHAR*)"COLUMN\\_1", SQL_NTS);
+        column_rows = count_rows();
+    });
+
+    EXPECT_EQ(exact_rows, 1000u);
+    EXPECT_EQ(prefix_rows, 1111u);
+    EXPECT_EQ(column_rows, 11u);   // TABLE_5000 and TABLE_50000 .. TABLE_50009
+    std::cout << "100000 tables: 1000 exact SQLTables in " << exact_ms << "ms, prefix SQLTables in "
+              << prefix_ms << "ms, prefix SQLColumns in " << column_ms << "ms\n";
+
+    SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+    SQLDisconnect(dbc);
+    SQLFreeHandle(SQL_HANDLE_DBC, dbc);
+    SQLFreeHandle(SQL_HANDLE_ENV, env);
+}
@@ -1,6 +1,7 @@
 // Tests for Connection String Configuration Parsing
 #include <gtest/gtest.h>
 #include "driver/config.hpp"
+#include <thread>
 
 using namespace mock_odbc;
 
@@ -41,6 +42,17 @@ TEST(ConfigTest, ParseCatalog) {
     EXPECT_EQ(config.catalog, "Empty");
 }
 
+TEST(ConfigTest, ParseCatalogSize) {
+    DriverConfig config = parse_connection_string("Catalog=Large;CatalogTables=10000;CatalogColumns=50;");
+    EXPECT_EQ(config.catalog, "Large");
+    EXPECT_EQ(config.catalog_tables, 10000);
+    EXPECT_EQ(config.catalog_columns, 50);
+    
+    config = parse_connection_string("Catalog=Large;");
+    EXPECT_EQ(config.catalog_tables, 100);
+    EXPECT_EQ(config.catalog_columns, 20);
+}
+
 TEST(ConfigTest, ParseResultSetSize) {
     DriverConfig config = parse_connection_string("ResultSetSize=50;");
     EXPECT_EQ(config.result_set_size, 50);
@@ -61,7 +73,106 @@ TEST(ConfigTest, ParseErrorCode) {
 
 TEST(ConfigTest, ParseLatency) {
     DriverConfig config = parse_connection_string("Latency=100ms;");
-    EXPECT_EQ(config.latency.count(), 100);
+    EXPECT_EQ(config.latency.base.count(), 100000);
+    EXPECT_EQ(config.latency.distribution, LatencyDistribution::Fixed);
+    
+    config = parse_connection_string("Latency=250us;");
+    EXPECT_EQ(config.latency.base.count(), 250);
+}
+
+TEST(ConfigTest, ParseLatencyDistribution) {
+    DriverConfig config = parse_connection_string(
+        "Latency=1ms;LatencyDistribution=Bimodal;LatencySpike=50ms;LatencySpikeProbability=5;");
+    EXPECT_EQ(config.latency.distribution, LatencyDistribution::Bimodal);
+    EXPECT_EQ(config.latency.spike.count(), 50000);
+    EXPECT_DOUBLE_EQ(config.latency.spike_probability, 5.0);
+    
+    config = parse_connection_string("Latency=10ms;LatencyDistribution=LogNormal;LatencyJitter=2ms;");
+    EXPECT_EQ(config.latency.distribution, LatencyDistribution::LogNormal);
+    EXPECT_EQ(config.latency.jitter.count(), 2000);
+}
+
+TEST(ConfigTest, ParsePerFunctionLatency) {
+    DriverConfig config = parse_connection_string("Latency=5ms;Latency.SQLFetch=200us;");
+    
+    const LatencyProfile* fetch = config.latency_for(DriverFunction::SQLFetch, false);
+    ASSERT_NE(fetch, nullptr);
+    EXPECT_EQ(fetch->base.count(), 200);
+    
+    // Round-trip functions fall back to the driver-wide latency; others get none
+    const LatencyProfile* exec = config.latency_for(DriverFunction::SQLExecDirect, true);
+    ASSERT_NE(exec, nullptr);
+    EXPECT_EQ(exec->base.count(), 5000);
+    EXPECT_EQ(config.latency_for(DriverFunction::SQLGetData, false), nullptr);
+}
+
+TEST(ConfigTest, ParseUnknownPerFunctionLatency) {
+    EXPECT_TRUE(parse_connection_string("Latency.SQLFetch=1ms;").bad_latency_function.empty());
+    EXPECT_EQ(parse_connection_string("Latency.SQLGetInfo=1ms;").bad_latency_function,
+              "sqlgetinfo");
+}
+
+TEST(ConfigTest, LatencySamplesStayInRange) {
+    LatencyProfile uniform;
+    uniform.distribution = LatencyDistribution::Uniform;
+    uniform.base = std::chrono::microseconds(1000);
+    uniform.jitter = std::chrono::microseconds(500);
+    
+    LatencyProfile bimodal;
+    bimodal.distribution = LatencyDistribution::Bimodal;
+    bimodal.base = std::chrono::microseconds(100);
+    bimodal.spike = std::chrono::microseconds(9000);
+    bimodal.spike_probability = 50.0;
+    
+    int spikes = 0;
+    for (int i = 0; i < 1000; ++i) {
+        auto u = uniform.sample().count();
+        EXPECT_GE(u, 500);
+        EXPECT_LE(u, 1500);
+        
+        auto b = bimodal.sample().count();
+        EXPECT_TRUE(b == 100 || b == 9000);
+        if (b == 9000) ++spikes;
+    }
+    EXPECT_GT(spikes, 350);
+    EXPECT_LT(spikes, 650);
+}
+
+TEST(ConfigTest, CancelInterruptsLatencyWait) {
+    DriverConfig config = parse_connection_string("Latency=5s;");
+    CancelSignal signal;
+    
+    auto start = std::chrono::steady_clock::now();
+    std::thread canceler([&signal] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        signal.cancel();
+    });
+    bool completed = config.apply_latency(DriverFunction::SQLExecDirect, true, &signal);
+    canceler.join();
+    
+    EXPECT_FALSE(completed);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds(1));
+}
+
+TEST(ConfigTest, ParseNetwork) {
+    DriverConfig config = parse_connection_string("NetworkRTT=40ms;NetworkBandwidth=2MB;FetchBatchRows=50;");
+    EXPECT_EQ(config.network.round_trip.count(), 40000);
+    EXPECT_EQ(config.network.bandwidth, 2u * 1024u * 1024u);
+    EXPECT_EQ(config.network.fetch_batch_rows, 50);
+    EXPECT_TRUE(config.network.enabled());
+    
+    // One round trip plus 1 MB at 2 MB/s
+    EXPECT_EQ(config.network.transfer_time(1024 * 1024).count(), 40000 + 500000);
+    
+    EXPECT_FALSE(parse_connection_string("").network.enabled());
+}
+
+TEST(ConfigTest, ParseAsyncWorkers) {
+    DriverConfig config = parse_connection_string("AsyncWorkers=8;");
+    EXPECT_EQ(config.async_workers, 8);
+
+    config = parse_connection_string("AsyncWorkers=0;");
+    EXPECT_EQ(config.async_workers, 1);
 }
 
 TEST(ConfigTest, ParseMaxConnections) {
@@ -115,6 +226,33 @@ TEST(ConfigTest, ShouldFailPartial) {
     EXPECT_FALSE(config.should_fail("SQLPrepare"));
 }
 
+TEST(ConfigTest, ShouldFailBitmask) {
+    auto config = parse_connection_string("Mode=Partial;FailOn=sqlexecute, SQLEndTran,NotAFunction");
+    EXPECT_TRUE(config.should_fail(DriverFunction::SQLExecute));
+    EXPECT_TRUE(config.should_fail(DriverFunction::SQLEndTran));
+    EXPECT_FALSE(config.should_fail(DriverFunction::SQLFetch));
+    EXPECT_FALSE(config.should_fail(DriverFunction::SQLDriverConnect));
+    
+    // Names without a DriverFunction still fail through the string check
+    EXPECT_TRUE(config.should_fail("NotAFunction"));
+    
+    config.mode = BehaviorMode::Failure;
+    EXPECT_TRUE(config.should_fail(DriverFunction::SQLFetch));
+    config.mode = BehaviorMode::Success;
+    EXPECT_FALSE(config.should_fail(DriverFunction::SQLExecute));
+    config.mode = BehaviorMode::Random;
+    config.failure_probability = 100;
+    EXPECT_TRUE(config.should_fail(DriverFunction::SQLFetch));
+    config.failure_probability = 0;
+    EXPECT_FALSE(config.should_fail(DriverFunction::SQLFetch));
+}
+
+TEST(ConfigTest, ParseThreadSafety) {
+    EXPECT_EQ(parse_connection_string("Mode=Success").thread_safety, ThreadSafetyMode::Handle);
+    EXPECT_EQ(parse_connection_string("ThreadSafety=None").thread_safety, ThreadSafetyMode::None);
+    EXPECT_EQ(parse_connection_string("ThreadSafety=handle").thread_safety, ThreadSafetyMode::Handle);
+}
+
 TEST(ConfigTest, ParseConnectionStringPairs) {
     auto pairs = parse_connection_string_pairs(
         "Driver={Mock ODBC Driver};Server=localhost;Database=test;UID=user;PWD=pass;");
@@ -155,3 +293,28 @@ TEST(ConfigTest, GetIntValue) {
     EXPECT_EQ(get_int_value(pairs, "missing", 100), 100);
     EXPECT_EQ(get_int_value(pairs, "invalid", 50), 50);  // Returns default on parse error
 }
+
+TEST(ConfigTest, ParseDataGeneratorKeys) {
+    DriverConfig config = parse_connection_string(
+        "Driver={Mock};DataSeed=42;DataThreads=4;DataSpec=/tmp/spec.txt;"
+        "Gen.*=nulls=0.1;Gen.Users.Age=dist=normal mean=40 stddev=10;");
+    ASSERT_TRUE(config.data_seed.has_value());
+    EXPECT_EQ(*config.data_seed, 42u);
+    EXPECT_EQ(config.data_threads, 4);
+    EXPECT_EQ(config.data_spec_file, "/tmp/spec.txt");
+    ASSERT_EQ(config.column_specs.size(), 2u);
+    EXPECT_EQ(config.column_specs[0].first, "*");
+    EXPECT_EQ(config.column_specs[0].second, "nulls=0.1");
+    EXPECT_EQ(config.column_specs[1].first, "USERS.AGE");
+    EXPECT_EQ(config.column_specs[1].second, "dist=normal mean=40 stddev=10");
+
+    DriverConfig defaults = parse_connection_string("Driver={Mock};");
+    EXPECT_FALSE(defaults.data_seed.has_value());
+    EXPECT_TRUE(defaults.column_specs.empty());
+
+    for (const char* bad : {"DataSeed=forty;", "DataSeed=-1;", "DataSeed=99999999999999999999;"}) {
+        DriverConfig rejected = parse_connection_string(bad);
+        EXPECT_FALSE(rejected.data_seed.has_value()) << bad;
+        EXPECT_FALSE(rejected.bad_data_seed.empty()) << bad;
+    }
+}
@@ -0,0 +1,202 @@
+// Data-at-Execution Tests - SQLParamData/SQLPutData streaming into INSERT
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <string>
+#include <vector>
+
+class DataAtExecTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        ASSERT_EQ(SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0), SQL_SUCCESS);
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc), SQL_SUCCESS);
+
+        const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+        SQLRETURN ret = SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                         NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt)));
+
+        SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE DAE_TEST", SQL_NTS);
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt,
+            (SQLCHAR*)"CREATE TABLE DAE_TEST (ID INTEGER, DATA BLOB)", SQL_NTS)));
+    }
+
+    void TearDown() override {
+        if (hstmt != SQL_NULL_HSTMT) {
+            SQLCancel(hstmt);
+            SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE DAE_TEST", SQL_NTS);
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        }
+        if (hdbc != SQL_NULL_HDBC) {
+            SQLDisconnect(hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        }
+        if (henv != SQL_NULL_HENV) {
+            SQLFreeHandle(SQL_HANDLE_ENV, henv);
+        }
+    }
+
+    std::string first_sqlstate() {
+        SQLCHAR sqlstate[6] = {0};
+        SQLINTEGER native = 0;
+        SQLCHAR message[256];
+        SQLSMALLINT len = 0;
+        SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, sqlstate, &native, message, sizeof(message), &len);
+        return reinterpret_cast<char*>(sqlstate);
+    }
+
+    // Read back DATA for the row with the given ID
+    std::string select_data(int id) {
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        std::string sql = "SELECT DATA FROM DAE_TEST WHERE ID = " + std::to_string(id);
+        if (!SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)sql.c_str(), SQL_NTS))) return "<error>";
+        if (!SQL_SUCCEEDED(SQLFetch(hstmt))) return "<no row>";
+        std::vector<char> buffer(1 << 20);
+        SQLLEN ind = 0;
+        SQLGetData(hstmt, 1, SQL_C_CHAR, buffer.data(), static_cast<SQLLEN>(buffer.size()), &ind);
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        if (ind == SQL_NULL_DATA) return "<null>";
+        return std::string(buffer.data(), static_cast<size_t>(ind));
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(DataAtExecTest, StreamsChunksIntoInsertedRow) {
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO DAE_TEST (ID, DATA) VALUES (?, ?)", SQL_NTS),
+              SQL_SUCCESS);
+
+    SQLINTEGER id = 1;
+    SQLLEN id_ind = 0;
+    const size_t chunk = 4096;
+    const size_t chunks = 16;
+    SQLLEN data_ind = SQL_LEN_DATA_AT_EXEC(static_cast<SQLLEN>(chunk * chunks));
+    char token = 'D';  // Identifies the parameter in SQLParamData
+    ASSERT_EQ(SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                               0, 0, &id, 0, &id_ind), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_BINARY, SQL_LONGVARBINARY,
+                               chunk * chunks, 0, &token, 0, &data_ind), SQL_SUCCESS);
+
+    ASSERT_EQ(SQLExecute(hstmt), SQL_NEED_DATA);
+
+    SQLPOINTER which = nullptr;
+    ASSERT_EQ(SQLParamData(hstmt, &which), SQL_NEED_DATA);
+    EXPECT_EQ(which, static_cast<SQLPOINTER>(&token));
+
+    std::string expected;
+    for (size_t i = 0; i < chunks; ++i) {
+        std::string piece(chunk, static_cast<char>('a' + i));
+        expected += piece;
+        ASSERT_EQ(SQLPutData(hstmt, (SQLPOINTER)piece.data(), static_cast<SQLLEN>(piece.size())),
+                  SQL_SUCCESS);
+    }
+
+    ASSERT_EQ(SQLParamData(hstmt, &which), SQL_SUCCESS);
+
+    SQLLEN rows = 0;
+    ASSERT_EQ(SQLRowCount(hstmt, &rows), SQL_SUCCESS);
+    EXPECT_EQ(rows, 1);
+    EXPECT_EQ(select_data(1), expected);
+}
+
+TEST_F(DataAtExecTest, ExecDirectAcceptsNullAndUnannouncedLength) {
+    SQLINTEGER id = 2;
+    SQLLEN id_ind = 0;
+    SQLLEN data_ind = SQL_DATA_AT_EXEC;
+    char token = 'N';
+    ASSERT_EQ(SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                               0, 0, &id, 0, &id_ind), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR,
+                               0, 0, &token, 0, &data_ind), SQL_SUCCESS);
+
+    const char* sql = "INSERT INTO DAE_TEST (ID, DATA) VALUES (?, ?)";
+    ASSERT_EQ(SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS), SQL_NEED_DATA);
+
+    SQLPOINTER which = nullptr;
+    ASSERT_EQ(SQLParamData(hstmt, &which), SQL_NEED_DATA);
+    ASSERT_EQ(SQLPutData(hstmt, NULL, SQL_NULL_DATA), SQL_SUCCESS);
+    ASSERT_EQ(SQLParamData(hstmt, &which), SQL_SUCCESS);
+    EXPECT_EQ(select_data(2), "<null>");
+
+    // Same statement again, with a text value sent in NTS pieces
+    id = 3;
+    ASSERT_EQ(SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS), SQL_NEED_DATA);
+    ASSERT_EQ(SQLParamData(hstmt, &which), SQL_NEED_DATA);
+    ASSERT_EQ(SQLPutData(hstmt, (SQLPOINTER)"hello ", SQL_NTS), SQL_SUCCESS);
+    ASSERT_EQ(SQLPutData(hstmt, (SQLPOINTER)"world", SQL_NTS), SQL_SUCCESS);
+    ASSERT_EQ(SQLParamData(hstmt, &which), SQL_SUCCESS);
+    EXPECT_EQ(select_data(3), "hello world");
+}
+
+TEST_F(DataAtExecTest, FixedSizeValueIsDecoded) {
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO DAE_TEST (ID, DATA) VALUES (?, 'x')", SQL_NTS),
+              SQL_SUCCESS);
+    SQLLEN id_ind = SQL_DATA_AT_EXEC;
+    SQLINTEGER token = 0;
+    ASSERT_EQ(SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                               0, 0, &token, 0, &id_ind), SQL_SUCCESS);
+
+    ASSERT_EQ(SQLExecute(hstmt), SQL_NEED_DATA);
+    SQLPOINTER which = nullptr;
+    ASSERT_EQ(SQLParamData(hstmt, &which), SQL_NEED_DATA);
+    SQLINTEGER id = 4;
+    ASSERT_EQ(SQLPutData(hstmt, &id, 0), SQL_SUCCESS);
+
+    // Fixed-size data cannot be sent in pieces
+    EXPECT_EQ(SQLPutData(hstmt, &id, 0), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "HY019");
+
+    ASSERT_EQ(SQLParamData(hstmt, &which), SQL_SUCCESS);
+    EXPECT_EQ(select_data(4), "x");
+}
+
+TEST_F(DataAtExecTest, SequenceErrorsAndCancel) {
+    SQLPOINTER which = nullptr;
+    EXPECT_EQ(SQLParamData(hstmt, &which), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "HY010");
+    EXPECT_EQ(SQLPutData(hstmt, (SQLPOINTER)"x", 1), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "HY010");
+
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO DAE_TEST (ID, DATA) VALUES (5, ?)", SQL_NTS),
+              SQL_SUCCESS);
+    SQLLEN data_ind = SQL_DATA_AT_EXEC;
+    char token = 'C';
+    ASSERT_EQ(SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR,
+                               0, 0, &token, 0, &data_ind), SQL_SUCCESS);
+    ASSERT_EQ(SQLExecute(hstmt), SQL_NEED_DATA);
+
+    // SQLPutData before the first SQLParamData, and other functions while
+    // data is pending, are sequence errors
+    EXPECT_EQ(SQLPutData(hstmt, (SQLPOINTER)"x", 1), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "HY010");
+    EXPECT_EQ(SQLExecute(hstmt), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "HY010");
+
+    // SQLCancel abandons the sequence without inserting
+    ASSERT_EQ(SQLCancel(hstmt), SQL_SUCCESS);
+    EXPECT_EQ(SQLParamData(hstmt, &which), SQL_ERROR);
+    EXPECT_EQ(select_data(5), "<no row>");
+}
+
+TEST_F(DataAtExecTest, ArraysOfParametersAreNotSupported) {
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO DAE_TEST (ID, DATA) VALUES (6, ?)", SQL_NTS),
+              SQL_SUCCESS);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)2, 0), SQL_SUCCESS);
+    SQLLEN data_ind[2] = {SQL_DATA_AT_EXEC, SQL_DATA_AT_EXEC};
+    char tokens[2] = {'A', 'B'};
+    ASSERT_EQ(SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR,
+                               0, 0, tokens, 1, data_ind), SQL_SUCCESS);
+
+    EXPECT_EQ(SQLExecute(hstmt), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "HYC00");
+
+    SQLPOINTER which = nullptr;
+    EXPECT_EQ(SQLParamData(hstmt, &which), SQL_ERROR);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0), SQL_SUCCESS);
+    EXPECT_EQ(select_data(6), "<no row>");
+}
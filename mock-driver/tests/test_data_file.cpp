@@ -0,0 +1,401 @@
+// Data File Tests - user tables kept in a memory-mapped file (DataFile=)
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include "mock/data_file.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace mock_odbc;
+
+class DataFileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        const auto* info = ::testing::UnitTest::GetInstance()->current_test_info();
+        path = (std::filesystem::temp_directory_path() /
+                (std::string("mock_odbc_") + info->name() + ".dat")).string();
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        ASSERT_EQ(SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0), SQL_SUCCESS);
+    }
+
+    void TearDown() override {
+        disconnect();
+        if (henv != SQL_NULL_HENV) {
+            SQLFreeHandle(SQL_HANDLE_ENV, henv);
+        }
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    SQLRETURN connect(const std::string& data_file) {
+        SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+        std::string conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+        if (!data_file.empty()) conn_str += "DataFile=" + data_file + ";";
+        SQLRETURN ret = SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str.c_str(), SQL_NTS,
+                                         NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+        if (SQL_SUCCEEDED(ret)) {
+            SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+        }
+        return ret;
+    }
+
+    void disconnect() {
+        if (hstmt != SQL_NULL_HSTMT) {
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+            hstmt = SQL_NULL_HSTMT;
+        }
+        if (hdbc != SQL_NULL_HDBC) {
+            SQLDisconnect(hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+            hdbc = SQL_NULL_HDBC;
+        }
+    }
+
+    SQLRETURN exec(const char* sql) {
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS);
+    }
+
+    // Read back all rows of a two-column query as "ID:NAME"
+    std::vector<std::string> select_rows(const char* sql) {
+        std::vector<std::string> rows;
+        if (!SQL_SUCCEEDED(exec(sql))) return rows;
+        while (SQL_SUCCEEDED(SQLFetch(hstmt))) {
+            SQLINTEGER id = 0;
+            char name[32] = {0};
+            SQLLEN id_ind = 0, name_ind = 0;
+            SQLGetData(hstmt, 1, SQL_C_SLONG, &id, 0, &id_ind);
+            SQLGetData(hstmt, 2, SQL_C_CHAR, name, sizeof(name), &name_ind);
+            rows.push_back((id_ind == SQL_NULL_DATA ? std::string("<null>") : std::to_string(id)) +
+                           ":" + (name_ind == SQL_NULL_DATA ? "<null>" : name));
+        }
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return rows;
+    }
+
+    std::string first_sqlstate(SQLSMALLINT type, SQLHANDLE handle) {
+        SQLCHAR sqlstate[6] = {0};
+        SQLINTEGER native = 0;
+        SQLCHAR message[256];
+        SQLSMALLINT len = 0;
+        SQLGetDiagRec(type, handle, 1, sqlstate, &native, message, sizeof(message), &len);
+        return reinterpret_cast<char*>(sqlstate);
+    }
+
+    std::string path;
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(DataFileTest, RowsPersistAcrossConnections) {
+    ASSERT_TRUE(SQL_SUCCEEDED(connect(path)));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE TABLE PEOPLE (ID INTEGER, NAME VARCHAR(20))")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO PEOPLE (ID, NAME) VALUES (1, 'Ada')")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO PEOPLE (ID, NAME) VALUES (2, NULL)")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO PEOPLE (ID) VALUES (3)")));
+    disconnect();
+
+    ASSERT_TRUE(SQL_SUCCEEDED(connect(path)));
+    EXPECT_EQ(select_rows("SELECT ID, NAME FROM PEOPLE"),
+              (std::vector<std::string>{"1:Ada", "2:<null>", "3:<null>"}));
+}
+
+TEST_F(DataFileTest, TablesWithoutDataFileStayInMemory) {
+    ASSERT_TRUE(SQL_SUCCEEDED(connect("")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE TABLE SCRATCH (ID INTEGER, NAME VARCHAR(20))")));
+    disconnect();
+
+    ASSERT_TRUE(SQL_SUCCEEDED(connect(path)));
+    EXPECT_FALSE(SQL_SUCCEEDED(exec("SELECT ID, NAME FROM SCRATCH")));
+    EXPECT_EQ(first_sqlstate(SQL_HANDLE_STMT, hstmt), "42S02");
+}
+
+TEST_F(DataFileTest, WhereAndProjectionOnFileTable) {
+    ASSERT_TRUE(SQL_SUCCEEDED(connect(path)));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE TABLE ITEMS (ID INTEGER, NAME VARCHAR(20), PRICE DOUBLE)")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO ITEMS VALUES (1, 'pen', 1.5)")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO ITEMS VALUES (2, 'ink', 4.25)")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO ITEMS VALUES (3, 'pad', 2.0)")));
+
+    EXPECT_EQ(select_rows("SELECT ID, NAME FROM ITEMS WHERE ID = 2"),
+              (std::vector<std::string>{"2:ink"}));
+
+    // Projected columns come back in the requested order
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("SELECT PRICE, ID FROM ITEMS")));
+    std::vector<double> prices;
+    while (SQL_SUCCEEDED(SQLFetch(hstmt))) {
+        double price = 0;
+        SQLINTEGER id = 0;
+        SQLGetData(hstmt, 1, SQL_C_DOUBLE, &price, 0, nullptr);
+        SQLGetData(hstmt, 2, SQL_C_SLONG, &id, 0, nullptr);
+        EXPECT_EQ(id, static_cast<SQLINTEGER>(prices.size() + 1));
+        prices.push_back(price);
+    }
+    EXPECT_EQ(prices, (std::vector<double>{1.5, 4.25, 2.0}));
+
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("SELECT COUNT(*) FROM ITEMS")));
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hstmt)));
+    SQLINTEGER count = 0;
+    SQLGetData(hstmt, 1, SQL_C_SLONG, &count, 0, nullptr);
+    EXPECT_EQ(count, 3);
+}
+
+TEST_F(DataFileTest, ScrollableCursorOverFileTable) {
+    ASSERT_TRUE(SQL_SUCCEEDED(connect(path)));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE TABLE NUMS (ID INTEGER, NAME VARCHAR(20))")));
+
+    // One array INSERT writes a single row group
+    constexpr SQLULEN kRows = 50;
+    std::vector<SQLINTEGER> ids(kRows);
+    std::vector<SQLLEN> id_ind(kRows, 0);
+    for (SQLULEN i = 0; i < kRows; ++i) ids[i] = static_cast<SQLINTEGER>(i + 1);
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO NUMS (ID) VALUES (?)", SQL_NTS), SQL_SUCCESS);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)kRows, 0);
+    SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0,
+                     ids.data(), 0, id_ind.data());
+    ASSERT_EQ(SQLExecute(hstmt), SQL_SUCCESS);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0);
+    SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO NUMS (ID) VALUES (51)")));
+
+    SQLFreeStmt(hstmt, SQL_CLOSE);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)SQL_CURSOR_STATIC, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("SELECT ID FROM NUMS")));
+    SQLINTEGER id = 0;
+    SQLLEN ind = 0;
+    SQLBindCol(hstmt, 1, SQL_C_SLONG, &id, 0, &ind);
+
+    ASSERT_EQ(SQLFetchScroll(hstmt, SQL_FETCH_LAST, 0), SQL_SUCCESS);
+    EXPECT_EQ(id, 51);
+    ASSERT_EQ(SQLFetchScroll(hstmt, SQL_FETCH_ABSOLUTE, 25), SQL_SUCCESS);
+    EXPECT_EQ(id, 25);
+    ASSERT_EQ(SQLFetchScroll(hstmt, SQL_FETCH_RELATIVE, 26), SQL_SUCCESS);
+    EXPECT_EQ(id, 51);
+    EXPECT_EQ(SQLFetchScroll(hstmt, SQL_FETCH_NEXT, 0), SQL_NO_DATA);
+}
+
+TEST_F(DataFileTest, DropTableRemovesItFromFile) {
+    ASSERT_TRUE(SQL_SUCCEEDED(connect(path)));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE TABLE GONE (ID INTEGER, NAME VARCHAR(20))")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO GONE VALUES (1, 'x')")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("DROP TABLE GONE")));
+
+    // A new table of the same name starts empty
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE TABLE GONE (ID INTEGER, NAME VARCHAR(20))")));
+    EXPECT_TRUE(select_rows("SELECT ID, NAME FROM GONE").empty());
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("DROP TABLE GONE")));
+    disconnect();
+
+    std::string error;
+    auto file = DataFile::open(path, error);
+    ASSERT_TRUE(file) << error;
+    EXPECT_TRUE(file->tables().empty());
+}
+
+TEST_F(DataFileTest, TransactionsCommitToFile) {
+    ASSERT_TRUE(SQL_SUCCEEDED(connect(path)));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE TABLE KEPT (ID INTEGER, NAME VARCHAR(20))")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO KEPT VALUES (1, 'a')")));
+    SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO KEPT VALUES (2, 'b')")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("UPDATE KEPT SET NAME = 'z' WHERE ID = 1")));
+    ASSERT_EQ(SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_ROLLBACK), SQL_SUCCESS);
+    EXPECT_EQ(select_rows("SELECT ID, NAME FROM KEPT"), (std::vector<std::string>{"1:a"}));
+
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO KEPT VALUES (3, 'c')")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("UPDATE KEPT SET NAME = 'y' WHERE ID = 1")));
+    ASSERT_EQ(SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_COMMIT), SQL_SUCCESS);
+    disconnect();
+
+    ASSERT_TRUE(SQL_SUCCEEDED(connect(path)));
+    EXPECT_EQ(select_rows("SELECT ID, NAME FROM KEPT ORDER BY ID"),
+              (std::vector<std::string>{"1:y", "3:c"}));
+}
+
+TEST_F(DataFileTest, ReopenRestoresTablesAndValues) {
+    {
+        std::string error;
+        auto file = DataFile::open(path, error);
+        ASSERT_TRUE(file) << error;
+        MockTable table;
+        table.name = "MIXED";
+        table.type = "TABLE";
+        table.remarks = "User-created table";
+        table.columns.push_back({"A", SQL_BIGINT, 19, 0, SQL_NULLABLE, false, false, "", "", ""});
+        table.columns.push_back({"B", SQL_VARCHAR, 50, 0, SQL_NULLABLE, false, false, "", "", ""});
+        ASSERT_TRUE(file->create_table(table));
+        std::vector<MockRow> rows;
+        rows.push_back({9007199254740993LL, std::string("first")});
+        rows.push_back({std::monostate{}, std::string()});
+        rows.push_back({-7LL, 0.125});  // A cell keeps its own type
+        ASSERT_TRUE(file->append_rows("MIXED", rows));
+        ASSERT_TRUE(file->append_rows("MIXED", {{42LL, std::string("second group")}}));
+    }
+
+    std::string error;
+    auto file = DataFile::open(path, error);
+    ASSERT_TRUE(file) << error;
+    ASSERT_EQ(file->tables().size(), 1u);
+    EXPECT_EQ(file->tables()[0].columns[1].column_size, 50u);
+
+    auto snapshot = file->snapshot("MIXED");
+    ASSERT_TRUE(snapshot);
+    ASSERT_EQ(snapshot->row_count(), 4u);
+    EXPECT_EQ(snapshot->cell(0, 0), CellValue(9007199254740993LL));
+    EXPECT_EQ(snapshot->cell(0, 1), CellValue(std::string("first")));
+    EXPECT_EQ(snapshot->cell(1, 0), CellValue(std::monostate{}));
+    EXPECT_EQ(snapshot->cell(1, 1), CellValue(std::string()));
+    EXPECT_EQ(snapshot->cell(2, 1), CellValue(0.125));
+    EXPECT_EQ(snapshot->cell(3, 1), CellValue(std::string("second group")));
+
+    // A snapshot keeps its rows while the table grows
+    ASSERT_TRUE(file->append_rows("MIXED", {{1LL, std::string("later")}}));
+    EXPECT_EQ(snapshot->row_count(), 4u);
+    EXPECT_EQ(file->snapshot("MIXED")->row_count(), 5u);
+}
+
+TEST_F(DataFileTest, DeletedRowsStayDeletedAfterReopen) {
+    {
+        std::string error;
+        auto file = DataFile::open(path, error);
+        ASSERT_TRUE(file) << error;
+        MockTable table;
+        table.name = "T";
+        table.columns.push_back({"ID", SQL_INTEGER, 10, 0, SQL_NO_NULLS, true, false, "", "", ""});
+        table.columns.push_back({"V", SQL_VARCHAR, 20, 0, SQL_NULLABLE, false, false, "", "", ""});
+        ASSERT_TRUE(file->create_table(table));
+        std::vector<MockRow> rows;
+        for (long long i = 0; i < 6; ++i) rows.push_back({i, std::string("v") + std::to_string(i)});
+        ASSERT_TRUE(file->append_rows("T", rows));
+
+        auto before = file->snapshot("T");
+        ASSERT_TRUE(file->delete_rows("T", {1, 4}));
+        // Row 2 (ID 3) is replaced by an updated copy at the end
+        ASSERT_TRUE(file->delete_rows("T", {2}, {{3LL, std::string("updated")}}));
+        EXPECT_EQ(before->row_count(), 6u);   // Earlier snapshots are unaffected
+        EXPECT_EQ(before->cell(1, 0), CellValue(1LL));
+    }
+
+    std::string error;
+    auto file = DataFile::open(path, error);
+    ASSERT_TRUE(file) << error;
+    auto snapshot = file->snapshot("T");
+    ASSERT_TRUE(snapshot);
+    ASSERT_EQ(snapshot->row_count(), 4u);
+    std::vector<long long> ids;
+    for (const auto& row : snapshot->materialize()) ids.push_back(std::get<long long>(row[0]));
+    EXPECT_EQ(ids, std::vector<long long>({0, 2, 5, 3}));
+    EXPECT_EQ(snapshot->cell(3, 1), CellValue(std::string("updated")));
+
+    // Appends after a delete get the next row numbers
+    ASSERT_TRUE(file->append_rows("T", {{9LL, std::string("new")}}));
+    snapshot = file->snapshot("T");
+    ASSERT_EQ(snapshot->row_count(), 5u);
+    EXPECT_EQ(snapshot->cell(4, 0), CellValue(9LL));
+}
+
+TEST_F(DataFileTest, TruncatedRecordIsDiscarded) {
+    {
+        std::string error;
+        auto file = DataFile::open(path, error);
+        ASSERT_TRUE(file) << error;
+        MockTable table;
+        table.name = "T";
+        table.columns.push_back({"ID", SQL_INTEGER, 10, 0, SQL_NULLABLE, false, false, "", "", ""});
+        ASSERT_TRUE(file->create_table(table));
+        ASSERT_TRUE(file->append_rows("T", {{1LL}, {2LL}}));
+    }
+    auto intact_size = std::filesystem::file_size(path);
+
+    // A record header promising more payload than was written
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::app);
+        uint32_t kind = 2, reserved = 0;
+        uint64_t payload = 4096;
+        out.write(reinterpret_cast<const char*>(&kind), sizeof(kind));
+        out.write(reinterpret_cast<const char*>(&reserved), sizeof(reserved));
+        out.write(reinterpret_cast<const char*>(&payload), sizeof(payload));
+        out.write("partial", 7);
+    }
+
+    std::string error;
+    auto file = DataFile::open(path, error);
+    ASSERT_TRUE(file) << error;
+    EXPECT_EQ(std::filesystem::file_size(path), intact_size);
+    ASSERT_TRUE(file->append_rows("T", {{3LL}}));
+    auto snapshot = file->snapshot("T");
+    ASSERT_EQ(snapshot->row_count(), 3u);
+    EXPECT_EQ(snapshot->cell(2, 0), CellValue(3LL));
+}
+
+TEST_F(DataFileTest, FetchThroughputFromMapping) {
+    ASSERT_TRUE(SQL_SUCCEEDED(connect(path)));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE TABLE WIDE (ID INTEGER, NAME VARCHAR(16))")));
+
+    const int batch = 10000;
+    const int batches = 20;
+    std::vector<SQLINTEGER> ids(batch);
+    std::vector<SQLLEN> id_ind(batch, 0);
+    std::vector<char> names(batch * 16, 'x');
+    std::vector<SQLLEN> name_ind(batch, 12);
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO WIDE (ID, NAME) VALUES (?, ?)", SQL_NTS),
+              SQL_SUCCESS);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(intptr_t)batch, 0);
+    SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0,
+                     ids.data(), 0, id_ind.data());
+    SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 16, 0,
+                     names.data(), 16, name_ind.data());
+    for (int b = 0; b < batches; ++b) {
+        for (int i = 0; i < batch; ++i) ids[i] = b * batch + i;
+        ASSERT_EQ(SQLExecute(hstmt), SQL_SUCCESS);
+    }
+    SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0);
+    disconnect();
+
+    ASSERT_TRUE(SQL_SUCCEEDED(connect(path)));
+    SQLINTEGER id = 0;
+    char name[17] = {0};
+    SQLLEN ind1 = 0, ind2 = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("SELECT ID, NAME FROM WIDE")));
+    SQLBindCol(hstmt, 1, SQL_C_SLONG, &id, 0, &ind1);
+    SQLBindCol(hstmt, 2, SQL_C_CHAR, name, sizeof(name), &ind2);
+    int fetched = 0;
+    long long id_sum = 0;
+    while (SQLFetch(hstmt) == SQL_SUCCESS) {
+        id_sum += id;
+        ++fetched;
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    const int total = batch * batches;
+    std::cout << total << " rows fetched from the data file in " << duration.count() << "ms ("
+              << (total / std::max<double>(duration.count(), 1.0) / 1000.0) << "M rows/s)\n";
+
+    EXPECT_EQ(fetched, total);
+    EXPECT_EQ(id_sum, static_cast<long long>(total) * (total - 1) / 2);
+    EXPECT_STREQ(name, "xxxxxxxxxxxx");
+    // Rows are decoded from the mapping one at a time; CI runners may be slower
+    EXPECT_LT(duration.count(), 2000) << "Fetch from data file too slow";
+}
+
+TEST_F(DataFileTest, ConnectFailsOnForeignFile) {
+    {
+        std::ofstream out(path, std::ios::binary);
+        out << "this is not a mock data file";
+    }
+    EXPECT_EQ(connect(path), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(SQL_HANDLE_DBC, hdbc), "08001");
+}
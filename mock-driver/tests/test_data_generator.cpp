@@ -0,0 +1,254 @@
+// Data Generator Tests - seeded column distributions (DataSeed=, Gen.*=)
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include "mock/data_generator.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace mock_odbc;
+
+namespace {
+
+MockTable make_table() {
+    MockTable table;
+    table.name = "METRICS";
+    table.type = "TABLE";
+    table.columns = {
+        {"ID", SQL_INTEGER, 10, 0, SQL_NO_NULLS, true, true, "", "", ""},
+        {"SCORE", SQL_INTEGER, 10, 0, SQL_NULLABLE, false, false, "", "", ""},
+        {"AMOUNT", SQL_DECIMAL, 10, 2, SQL_NULLABLE, false, false, "", "", ""},
+        {"LABEL", SQL_VARCHAR, 40, 0, SQL_NULLABLE, false, false, "", "", ""},
+        {"CREATED", SQL_TYPE_TIMESTAMP, 26, 6, SQL_NULLABLE, false, false, "", "", ""}
+    };
+    return table;
+}
+
+size_t column_index(const MockTable& table, const std::string& name) {
+    for (size_t i = 0; i < table.columns.size(); ++i) {
+        if (table.columns[i].name == name) return i;
+    }
+    return table.columns.size();
+}
+
+// Count UTF-8 code points, not bytes
+size_t code_points(const std::string& s) {
+    return static_cast<size_t>(std::count_if(s.begin(), s.end(),
+        [](char c) { return (static_cast<unsigned char>(c) & 0xC0) != 0x80; }));
+}
+
+} // anonymous namespace
+
+class DataGeneratorTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        std::string error;
+        DataGenerator::instance().configure(DriverConfig{}, error);
+    }
+
+    void configure(uint64_t seed, std::vector<std::pair<std::string, std::string>> specs,
+                   int threads = 0) {
+        DriverConfig config;
+        config.data_seed = seed;
+        config.column_specs = std::move(specs);
+        config.data_threads = threads;
+        std::string error;
+        ASSERT_TRUE(DataGenerator::instance().configure(config, error)) << error;
+    }
+
+    std::vector<MockRow> generate(size_t rows) {
+        return DataGenerator::instance().generate(table, rows);
+    }
+
+    MockTable table = make_table();
+};
+
+TEST_F(DataGeneratorTest, DisabledWithoutSettings) {
+    std::string error;
+    ASSERT_TRUE(DataGenerator::instance().configure(DriverConfig{}, error));
+    EXPECT_FALSE(DataGenerator::instance().enabled());
+}
+
+TEST_F(DataGeneratorTest, SameSeedSameData) {
+    configure(7, {{"*", "nulls=0.1"}});
+    auto first = generate(5000);
+    auto second = generate(5000);
+    EXPECT_EQ(first, second);
+
+    configure(8, {{"*", "nulls=0.1"}});
+    EXPECT_NE(generate(5000), first);
+}
+
+TEST_F(DataGeneratorTest, ThreadCountDoesNotChangeData) {
+    configure(11, {{"LABEL", "unicode=0.3"}}, 1);
+    auto serial = generate(40000);
+    configure(11, {{"LABEL", "unicode=0.3"}}, 4);
+    auto parallel = generate(40000);
+    EXPECT_EQ(serial, parallel);
+}
+
+TEST_F(DataGeneratorTest, PrimaryKeyIsSequential) {
+    configure(1, {{"*", "dist=zipf"}});
+    auto rows = generate(100);
+    size_t id = column_index(table, "ID");
+    for (size_t r = 0; r < rows.size(); ++r) {
+        ASSERT_EQ(std::get<long long>(rows[r][id]), static_cast<long long>(r + 1));
+    }
+}
+
+TEST_F(DataGeneratorTest, NullRatio) {
+    configure(3, {{"SCORE", "nulls=0.25"}});
+    auto rows = generate(20000);
+    size_t score = column_index(table, "SCORE");
+    size_t nulls = std::count_if(rows.begin(), rows.end(), [&](const MockRow& row) {
+        return std::holds_alternative<std::monostate>(row[score]);
+    });
+    EXPECT_NEAR(static_cast<double>(nulls) / rows.size(), 0.25, 0.02);
+}
+
+TEST_F(DataGeneratorTest, CardinalityBoundsDistinctValues) {
+    configure(5, {{"LABEL", "cardinality=17"}, {"AMOUNT", "cardinality=3"}});
+    auto rows = generate(10000);
+    std::set<std::string> labels;
+    std::set<double> amounts;
+    for (const auto& row : rows) {
+        labels.insert(std::get<std::string>(row[column_index(table, "LABEL")]));
+        amounts.insert(std::get<double>(row[column_index(table, "AMOUNT")]));
+    }
+    EXPECT_EQ(labels.size(), 17u);
+    EXPECT_EQ(amounts.size(), 3u);
+}
+
+TEST_F(DataGeneratorTest, ZipfFavoursLowRanks) {
+    configure(9, {{"METRICS.SCORE", "dist=zipf skew=1.1 min=1 max=1000"}});
+    auto rows = generate(50000);
+    std::map<long long, size_t> counts;
+    for (const auto& row : rows) {
+        long long v = std::get<long long>(row[column_index(table, "SCORE")]);
+        ASSERT_GE(v, 1);
+        ASSERT_LE(v, 1000);
+        ++counts[v];
+    }
+    auto most = std::max_element(counts.begin(), counts.end(),
+        [](const auto& a, const auto& b) { return a.second < b.second; });
+    EXPECT_EQ(most->first, 1);
+    EXPECT_GT(counts[1], counts[2]);
+    EXPECT_GT(counts[2], counts[10]);
+}
+
+TEST_F(DataGeneratorTest, NormalMeanAndSpread) {
+    configure(13, {{"AMOUNT", "dist=normal mean=500 stddev=50"}});
+    auto rows = generate(20000);
+    double sum = 0, sq = 0;
+    for (const auto& row : rows) {
+        double v = std::get<double>(row[column_index(table, "AMOUNT")]);
+        sum += v;
+        sq += v * v;
+    }
+    double mean = sum / rows.size();
+    double stddev = std::sqrt(sq / rows.size() - mean * mean);
+    EXPECT_NEAR(mean, 500.0, 2.0);
+    EXPECT_NEAR(stddev, 50.0, 2.0);
+}
+
+TEST_F(DataGeneratorTest, StringLengthAndUnicodeShare) {
+    configure(17, {{"LABEL", "length=5..12 unicode=0.5"}});
+    auto rows = generate(5000);
+    size_t chars = 0, non_ascii = 0;
+    for (const auto& row : rows) {
+        const auto& s = std::get<std::string>(row[column_index(table, "LABEL")]);
+        size_t n = code_points(s);
+        ASSERT_GE(n, 5u);
+        ASSERT_LE(n, 12u);
+        chars += n;
+        non_ascii += n - static_cast<size_t>(std::count_if(s.begin(), s.end(),
+            [](char c) { return (static_cast<unsigned char>(c) & 0x80) == 0; }));
+    }
+    EXPECT_NEAR(static_cast<double>(non_ascii) / chars, 0.5, 0.03);
+}
+
+TEST_F(DataGeneratorTest, LengthCappedByColumnSize) {
+    configure(19, {{"LABEL", "length=100..200"}});
+    for (const auto& row : generate(200)) {
+        EXPECT_EQ(code_points(std::get<std::string>(row[column_index(table, "LABEL")])), 40u);
+    }
+}
+
+TEST_F(DataGeneratorTest, InvalidSpecsAreRejected) {
+    ColumnSpec spec;
+    std::string error;
+    EXPECT_FALSE(apply_column_spec("dist=poisson", spec, error));
+    EXPECT_FALSE(apply_column_spec("nulls=1.5", spec, error));
+    EXPECT_FALSE(apply_column_spec("length=9..3", spec, error));
+    EXPECT_FALSE(apply_column_spec("colour=red", spec, error));
+    EXPECT_FALSE(apply_column_spec("min=10 max=1", spec, error));
+
+    spec = ColumnSpec{};
+    EXPECT_TRUE(apply_column_spec("dist=zipf, skew=0.8, cardinality=50", spec, error)) << error;
+    EXPECT_EQ(spec.distribution, ValueDistribution::Zipf);
+    EXPECT_EQ(spec.cardinality, 50u);
+
+    DriverConfig config;
+    config.column_specs = {{"SCORE", "skew=-1"}};
+    EXPECT_FALSE(DataGenerator::instance().configure(config, error));
+    EXPECT_NE(error.find("SCORE"), std::string::npos);
+}
+
+TEST_F(DataGeneratorTest, ConnectionStringDrivesSelect) {
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+    ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+    SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+
+    auto fetch_statuses = [&](const std::string& extra) {
+        std::vector<std::string> statuses;
+        SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+        std::string conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;"
+                               "ResultSetSize=50;" + extra;
+        SQLRETURN ret = SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str.c_str(), SQL_NTS,
+                                         NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+        EXPECT_TRUE(SQL_SUCCEEDED(ret));
+        SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+        EXPECT_EQ(SQLExecDirect(hstmt, (SQLCHAR*)"SELECT STATUS FROM ORDERS", SQL_NTS), SQL_SUCCESS);
+        SQLCHAR buf[64];
+        SQLLEN ind;
+        while (SQLFetch(hstmt) == SQL_SUCCESS) {
+            SQLGetData(hstmt, 1, SQL_C_CHAR, buf, sizeof(buf), &ind);
+            statuses.push_back(ind == SQL_NULL_DATA ? "<null>" : reinterpret_cast<char*>(buf));
+        }
+        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        SQLDisconnect(hdbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        return statuses;
+    };
+
+    auto first = fetch_statuses("DataSeed=99;Gen.ORDERS.STATUS=cardinality=4 length=6;");
+    auto second = fetch_statuses("DataSeed=99;Gen.ORDERS.STATUS=cardinality=4 length=6;");
+    ASSERT_EQ(first.size(), 50u);
+    EXPECT_EQ(first, second);
+    EXPECT_LE(std::set<std::string>(first.begin(), first.end()).size(), 4u);
+    for (const auto& s : first) {
+        EXPECT_EQ(s.size(), 6u);
+    }
+
+    // A bad spec or seed fails the connect
+    for (const char* bad : {"Driver={Mock ODBC Driver};Gen.STATUS=dist=bogus;",
+                            "Driver={Mock ODBC Driver};DataSeed=12abc;"}) {
+        SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+        EXPECT_EQ(SQLDriverConnect(hdbc, NULL, (SQLCHAR*)bad, SQL_NTS, NULL, 0, NULL,
+                                   SQL_DRIVER_NOPROMPT), SQL_ERROR) << bad;
+        SQLCHAR state[6] = {0};
+        SQLINTEGER native;
+        SQLSMALLINT len;
+        SQLGetDiagRec(SQL_HANDLE_DBC, hdbc, 1, state, &native, NULL, 0, &len);
+        EXPECT_STREQ(reinterpret_cast<char*>(state), "08001") << bad;
+        SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+    }
+    SQLFreeHandle(SQL_HANDLE_ENV, henv);
+}
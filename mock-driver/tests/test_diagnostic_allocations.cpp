@@ -0,0 +1,95 @@
+// Diagnostic Allocation Tests - heap use of the success and error paths.
+// Built as its own executable because it replaces the global operator new.
+#include <gtest/gtest.h>
+#include "driver/handles.hpp"
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <cstdlib>
+#include <new>
+#include <string>
+
+// Count heap allocations made on this thread while counting is on
+namespace {
+thread_local bool g_counting = false;
+thread_local size_t g_allocations = 0;
+
+struct AllocationCounter {
+    AllocationCounter() { g_allocations = 0; g_counting = true; }
+    ~AllocationCounter() { g_counting = false; }
+    size_t count() const { return g_allocations; }
+};
+} // anonymous namespace
+
+void* operator new(std::size_t size) {
+    if (g_counting) ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+using namespace mock_odbc;
+
+class DiagnosticAllocationTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc), SQL_SUCCESS);
+        const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                                   NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt), SQL_SUCCESS);
+    }
+
+    void TearDown() override {
+        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        SQLDisconnect(hdbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        SQLFreeHandle(SQL_HANDLE_ENV, henv);
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(DiagnosticAllocationTest, SuccessfulCallsDoNotAllocate) {
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)"SELECT * FROM USERS", SQL_NTS)));
+    // Leave a diagnostic behind so the first fetch has one to clear
+    SQLINTEGER id = 0;
+    SQLLEN ind = 0;
+    EXPECT_EQ(SQLGetData(hstmt, 1, SQL_C_SLONG, &id, 0, &ind), SQL_ERROR);
+
+    size_t rows = 0;
+    AllocationCounter counter;
+    while (SQLFetch(hstmt) == SQL_SUCCESS) {
+        SQLGetData(hstmt, 1, SQL_C_SLONG, &id, 0, &ind);
+        ++rows;
+    }
+    size_t allocations = counter.count();
+    EXPECT_GT(rows, 0u);
+    EXPECT_EQ(allocations, 0u);
+}
+
+TEST_F(DiagnosticAllocationTest, RepeatedErrorsAllocateOnce) {
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)"SELECT * FROM USERS", SQL_NTS)));
+    ASSERT_EQ(SQLFetch(hstmt), SQL_SUCCESS);
+    auto* stmt = validate_stmt_handle(hstmt);
+
+    // An invalid column posts 07009; the first error sizes the buffers
+    SQLINTEGER value = 0;
+    SQLLEN ind = 0;
+    stmt->clear_diagnostics();
+    EXPECT_EQ(SQLGetData(hstmt, 999, SQL_C_SLONG, &value, 0, &ind), SQL_ERROR);
+
+    AllocationCounter counter;
+    for (int i = 0; i < 1000; ++i) {
+        stmt->clear_diagnostics();
+        SQLGetData(hstmt, 999, SQL_C_SLONG, &value, 0, &ind);
+    }
+    size_t allocations = counter.count();
+    EXPECT_EQ(stmt->diagnostic_count(), 1u);
+    EXPECT_EQ(allocations, 0u);
+}
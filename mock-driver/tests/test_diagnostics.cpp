@@ -0,0 +1,86 @@
+// Diagnostics Tests - inline diagnostic records and per-parameter-set
+// errors (heap use is checked in test_diagnostic_allocations.cpp)
+#include <gtest/gtest.h>
+#include "driver/handles.hpp"
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <string>
+
+using namespace mock_odbc;
+
+class DiagnosticsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc), SQL_SUCCESS);
+        const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                                   NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt), SQL_SUCCESS);
+    }
+
+    void TearDown() override {
+        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        SQLDisconnect(hdbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        SQLFreeHandle(SQL_HANDLE_ENV, henv);
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(DiagnosticsTest, RecordsBeyondInlineCapacity) {
+    auto* stmt = validate_stmt_handle(hstmt);
+    const size_t total = DiagnosticArea::kInlineRecords * 3;
+    for (int round = 0; round < 2; ++round) {
+        stmt->clear_diagnostics();
+        for (size_t i = 0; i < total; ++i) {
+            stmt->add_diagnostic(i % 2 ? "01004" : "42S02", static_cast<SQLINTEGER>(i),
+                                 "Record " + std::to_string(i));
+        }
+        ASSERT_EQ(stmt->diagnostic_count(), total);
+        for (size_t i = 0; i < total; ++i) {
+            const DiagnosticRecord* rec = stmt->get_diagnostic(static_cast<SQLSMALLINT>(i + 1));
+            ASSERT_NE(rec, nullptr);
+            EXPECT_STREQ(rec->sqlstate, i % 2 ? "01004" : "42S02");
+            EXPECT_EQ(rec->native_error, static_cast<SQLINTEGER>(i));
+            EXPECT_EQ(stmt->diagnostic_message(*rec), "Record " + std::to_string(i));
+        }
+        EXPECT_EQ(stmt->get_diagnostic(static_cast<SQLSMALLINT>(total + 1)), nullptr);
+    }
+}
+
+TEST_F(DiagnosticsTest, ParameterSetErrorsCarryRowNumber) {
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO NO_SUCH_TABLE (ID) VALUES (?)", SQL_NTS),
+              SQL_SUCCESS);
+    const SQLULEN sets = 6;
+    SQLINTEGER ids[sets] = {1, 2, 3, 4, 5, 6};
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)sets, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0,
+                               ids, 0, nullptr), SQL_SUCCESS);
+    EXPECT_EQ(SQLExecute(hstmt), SQL_ERROR);
+
+    SQLINTEGER count = 0;
+    SQLGetDiagField(SQL_HANDLE_STMT, hstmt, 0, SQL_DIAG_NUMBER, &count, 0, NULL);
+    ASSERT_EQ(count, static_cast<SQLINTEGER>(sets));
+    for (SQLSMALLINT rec = 1; rec <= count; ++rec) {
+        SQLLEN row = 0;
+        SQLGetDiagField(SQL_HANDLE_STMT, hstmt, rec, SQL_DIAG_ROW_NUMBER, &row, 0, NULL);
+        EXPECT_EQ(row, rec);
+
+        SQLCHAR state[6] = {0};
+        SQLCHAR message[256] = {0};
+        SQLINTEGER native = 0;
+        SQLSMALLINT len = 0;
+        ASSERT_EQ(SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, rec, state, &native, message,
+                                sizeof(message), &len), SQL_SUCCESS);
+        std::string text(reinterpret_cast<char*>(message));
+        std::string prefix = "Parameter set " + std::to_string(rec) + ": ";
+        EXPECT_EQ(text.compare(0, prefix.size(), prefix), 0) << text;
+        EXPECT_EQ(len, static_cast<SQLSMALLINT>(text.size()));
+    }
+}
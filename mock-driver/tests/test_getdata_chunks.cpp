@@ -0,0 +1,181 @@
+// Chunked SQLGetData Tests - reading a long column in successive pieces
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <string>
+#include <vector>
+
+class GetDataChunksTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        ASSERT_EQ(SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0), SQL_SUCCESS);
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc), SQL_SUCCESS);
+
+        const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+        SQLRETURN ret = SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                         NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt)));
+
+        SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE GETDATA_TEST", SQL_NTS);
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt,
+            (SQLCHAR*)"CREATE TABLE GETDATA_TEST (ID INTEGER, DATA VARCHAR(100))", SQL_NTS)));
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt,
+            (SQLCHAR*)"INSERT INTO GETDATA_TEST (ID, DATA) VALUES (1, 'abcdefghijklmnopqrstuvwxyz')",
+            SQL_NTS)));
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt,
+            (SQLCHAR*)"INSERT INTO GETDATA_TEST (ID, DATA) VALUES (2, 'Zo\xC3\xAB \xF0\x9F\x98\x80!')",
+            SQL_NTS)));
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+    }
+
+    void TearDown() override {
+        if (hstmt != SQL_NULL_HSTMT) {
+            SQLFreeStmt(hstmt, SQL_CLOSE);
+            SQLExecDirect(hstmt, (SQLCHAR*)"DROP TABLE GETDATA_TEST", SQL_NTS);
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        }
+        if (hdbc != SQL_NULL_HDBC) {
+            SQLDisconnect(hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        }
+        if (henv != SQL_NULL_HENV) {
+            SQLFreeHandle(SQL_HANDLE_ENV, henv);
+        }
+    }
+
+    std::string first_sqlstate() {
+        SQLCHAR sqlstate[6] = {0};
+        SQLINTEGER native = 0;
+        SQLCHAR message[256];
+        SQLSMALLINT len = 0;
+        SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, sqlstate, &native, message, sizeof(message), &len);
+        return reinterpret_cast<char*>(sqlstate);
+    }
+
+    void fetch_row(int id) {
+        std::string sql = "SELECT DATA FROM GETDATA_TEST WHERE ID = " + std::to_string(id);
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)sql.c_str(), SQL_NTS)));
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hstmt)));
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(GetDataChunksTest, CharReturnsSuccessivePieces) {
+    fetch_row(1);
+
+    char buffer[11];
+    SQLLEN ind = 0;
+    std::string value;
+    std::vector<SQLLEN> reported;
+    SQLRETURN ret;
+    while ((ret = SQLGetData(hstmt, 1, SQL_C_CHAR, buffer, sizeof(buffer), &ind)) != SQL_NO_DATA) {
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        if (ret == SQL_SUCCESS_WITH_INFO) {
+            EXPECT_EQ(first_sqlstate(), "01004");
+        }
+        reported.push_back(ind);
+        value += buffer;
+    }
+
+    EXPECT_EQ(value, "abcdefghijklmnopqrstuvwxyz");
+    // Each call reports the bytes remaining before it
+    EXPECT_EQ(reported, (std::vector<SQLLEN>{26, 16, 6}));
+}
+
+TEST_F(GetDataChunksTest, BinaryPiecesHaveNoTerminator) {
+    fetch_row(1);
+
+    unsigned char buffer[8];
+    SQLLEN ind = 0;
+    EXPECT_EQ(SQLGetData(hstmt, 1, SQL_C_BINARY, buffer, sizeof(buffer), &ind), SQL_SUCCESS_WITH_INFO);
+    EXPECT_EQ(ind, 26);
+    EXPECT_EQ(std::string(reinterpret_cast<char*>(buffer), 8), "abcdefgh");
+
+    std::string rest;
+    while (SQL_SUCCEEDED(SQLGetData(hstmt, 1, SQL_C_BINARY, buffer, sizeof(buffer), &ind))) {
+        rest.append(reinterpret_cast<char*>(buffer), static_cast<size_t>(std::min<SQLLEN>(ind, 8)));
+    }
+    EXPECT_EQ(rest, "ijklmnopqrstuvwxyz");
+}
+
+TEST_F(GetDataChunksTest, WideCharDoesNotSplitSurrogatePairs) {
+    fetch_row(2);
+
+    // "Zoë 😀!" is 7 UTF-16 units; the emoji needs a surrogate pair
+    SQLWCHAR buffer[5];
+    SQLLEN ind = 0;
+    ASSERT_EQ(SQLGetData(hstmt, 1, SQL_C_WCHAR, buffer, sizeof(buffer), &ind), SQL_SUCCESS_WITH_INFO);
+    EXPECT_EQ(ind, static_cast<SQLLEN>(7 * sizeof(SQLWCHAR)));
+    // Four units fit before the terminator, but the pair would not, so only three are returned
+    EXPECT_EQ(buffer[0], 'Z');
+    EXPECT_EQ(buffer[2], 0x00EB);
+    EXPECT_EQ(buffer[3], ' ');
+    EXPECT_EQ(buffer[4], 0);
+
+    ASSERT_EQ(SQLGetData(hstmt, 1, SQL_C_WCHAR, buffer, sizeof(buffer), &ind), SQL_SUCCESS);
+    EXPECT_EQ(ind, static_cast<SQLLEN>(3 * sizeof(SQLWCHAR)));
+    EXPECT_EQ(buffer[0], 0xD83D);
+    EXPECT_EQ(buffer[1], 0xDE00);
+    EXPECT_EQ(buffer[2], '!');
+    EXPECT_EQ(buffer[3], 0);
+
+    EXPECT_EQ(SQLGetData(hstmt, 1, SQL_C_WCHAR, buffer, sizeof(buffer), &ind), SQL_NO_DATA);
+}
+
+TEST_F(GetDataChunksTest, WideCharSplitsSurrogatePairsForSmallBuffers) {
+    // "Zoë 😀!": the 4-byte UTF-8 emoji is the pair at units 4 and 5
+    const std::vector<SQLWCHAR> expected = {'Z', 'o', 0x00EB, ' ', 0xD83D, 0xDE00, '!'};
+
+    // Three units hold the pair and its terminator; two hold only half of it
+    for (size_t buffer_units : {3u, 2u}) {
+        fetch_row(2);
+        SQLWCHAR buffer[3];
+        SQLLEN ind = 0;
+        std::vector<SQLWCHAR> read;
+        SQLRETURN ret;
+        int calls = 0;
+        while ((ret = SQLGetData(hstmt, 1, SQL_C_WCHAR, buffer,
+                                 static_cast<SQLLEN>(buffer_units * sizeof(SQLWCHAR)), &ind)) != SQL_NO_DATA) {
+            ASSERT_TRUE(SQL_SUCCEEDED(ret));
+            ASSERT_LT(++calls, 10) << "no progress with a " << buffer_units << "-unit buffer";
+            for (size_t i = 0; i < buffer_units && buffer[i] != 0; ++i) read.push_back(buffer[i]);
+        }
+        EXPECT_EQ(read, expected) << buffer_units << "-unit buffer";
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+    }
+}
+
+TEST_F(GetDataChunksTest, ZeroLengthBufferOnlyReportsLength) {
+    fetch_row(1);
+
+    SQLLEN ind = 0;
+    EXPECT_EQ(SQLGetData(hstmt, 1, SQL_C_CHAR, nullptr, 0, &ind), SQL_SUCCESS_WITH_INFO);
+    EXPECT_EQ(ind, 26);
+
+    // Nothing was consumed, so the whole value is still returned
+    char buffer[64];
+    EXPECT_EQ(SQLGetData(hstmt, 1, SQL_C_CHAR, buffer, sizeof(buffer), &ind), SQL_SUCCESS);
+    EXPECT_EQ(ind, 26);
+    EXPECT_STREQ(buffer, "abcdefghijklmnopqrstuvwxyz");
+}
+
+TEST_F(GetDataChunksTest, FetchRestartsTheColumn) {
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt,
+        (SQLCHAR*)"SELECT DATA FROM GETDATA_TEST", SQL_NTS)));
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hstmt)));
+
+    char buffer[64];
+    SQLLEN ind = 0;
+    ASSERT_EQ(SQLGetData(hstmt, 1, SQL_C_CHAR, buffer, sizeof(buffer), &ind), SQL_SUCCESS);
+    EXPECT_EQ(SQLGetData(hstmt, 1, SQL_C_CHAR, buffer, sizeof(buffer), &ind), SQL_NO_DATA);
+
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hstmt)));
+    EXPECT_EQ(SQLGetData(hstmt, 1, SQL_C_CHAR, buffer, sizeof(buffer), &ind), SQL_SUCCESS);
+    EXPECT_EQ(ind, 10);  // UTF-8 bytes of the second row
+}
@@ -0,0 +1,124 @@
+// SQLGetInfo Tests - answers from the compile-time info table
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include "mock/info_table.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace mock_odbc;
+
+// Constant answers are resolved by the compiler
+static_assert(find_info(SQL_SEARCH_PATTERN_ESCAPE) != nullptr);
+static_assert(find_info(SQL_SEARCH_PATTERN_ESCAPE)->text == "\\");
+static_assert(find_info(SQL_DBMS_NAME)->dynamic);
+
+class SQLGetInfoTest : public ::testing::Test {
+protected:
+    void connect(const char* conn_str) {
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv)));
+        SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc)));
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(hdbc, nullptr, (SQLCHAR*)conn_str, SQL_NTS,
+                                                   nullptr, 0, nullptr, SQL_DRIVER_NOPROMPT)));
+    }
+
+    void SetUp() override {
+        connect("Driver={Mock ODBC Driver};Mode=Success;MaxConnections=7;");
+    }
+
+    void TearDown() override {
+        if (hdbc) {
+            SQLDisconnect(hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        }
+        if (henv) SQLFreeHandle(SQL_HANDLE_ENV, henv);
+    }
+
+    std::string get_string(SQLUSMALLINT info_type) {
+        char buffer[256] = {};
+        SQLSMALLINT length = 0;
+        EXPECT_EQ(SQLGetInfo(hdbc, info_type, buffer, sizeof(buffer), &length), SQL_SUCCESS);
+        EXPECT_EQ(static_cast<size_t>(length), std::strlen(buffer));
+        return buffer;
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+};
+
+TEST_F(SQLGetInfoTest, StringAnswers) {
+    EXPECT_EQ(get_string(SQL_SEARCH_PATTERN_ESCAPE), "\\");
+    EXPECT_EQ(get_string(SQL_CATALOG_NAME_SEPARATOR), ".");
+    EXPECT_EQ(get_string(SQL_LIKE_ESCAPE_CLAUSE), "Y");
+    EXPECT_EQ(get_string(SQL_DBMS_NAME), "MockDB");
+}
+
+TEST_F(SQLGetInfoTest, NumericAnswers) {
+    SQLUSMALLINT small = 0;
+    ASSERT_EQ(SQLGetInfo(hdbc, SQL_MAX_IDENTIFIER_LEN, &small, sizeof(small), nullptr), SQL_SUCCESS);
+    EXPECT_EQ(small, 128);
+    ASSERT_EQ(SQLGetInfo(hdbc, SQL_TXN_CAPABLE, &small, sizeof(small), nullptr), SQL_SUCCESS);
+    EXPECT_EQ(small, SQL_TC_ALL);
+
+    SQLUINTEGER mask = 0;
+    ASSERT_EQ(SQLGetInfo(hdbc, SQL_GETDATA_EXTENSIONS, &mask, sizeof(mask), nullptr), SQL_SUCCESS);
+    EXPECT_NE(mask & SQL_GD_ANY_COLUMN, 0u);
+}
+
+TEST_F(SQLGetInfoTest, ConnectionDependentAnswers) {
+    SQLUSMALLINT max_connections = 0;
+    ASSERT_EQ(SQLGetInfo(hdbc, SQL_MAX_DRIVER_CONNECTIONS, &max_connections,
+                         sizeof(max_connections), nullptr), SQL_SUCCESS);
+    EXPECT_EQ(max_connections, 7);
+    EXPECT_EQ(get_string(SQL_DATA_SOURCE_READ_ONLY), "N");
+}
+
+TEST_F(SQLGetInfoTest, UnknownInfoTypeIsRejected) {
+    char buffer[64];
+    EXPECT_EQ(SQLGetInfo(hdbc, 65000, buffer, sizeof(buffer), nullptr), SQL_ERROR);
+
+    SQLCHAR state[6] = {};
+    SQLINTEGER native = 0;
+    SQLCHAR message[256];
+    SQLSMALLINT length = 0;
+    ASSERT_EQ(SQLGetDiagRec(SQL_HANDLE_DBC, hdbc, 1, state, &native, message,
+                            sizeof(message), &length), SQL_SUCCESS);
+    EXPECT_STREQ(reinterpret_cast<char*>(state), "HY096");
+}
+
+TEST_F(SQLGetInfoTest, WideStringAnswers) {
+    // SQL_LIKE_ESCAPE_CLAUSE is a string and comes back as UTF-16
+    SQLWCHAR buffer[16] = {};
+    SQLSMALLINT length = 0;
+    ASSERT_EQ(SQLGetInfoW(hdbc, SQL_LIKE_ESCAPE_CLAUSE, buffer, sizeof(buffer), &length), SQL_SUCCESS);
+    EXPECT_EQ(length, static_cast<SQLSMALLINT>(sizeof(SQLWCHAR)));
+    EXPECT_EQ(buffer[0], SQLWCHAR('Y'));
+    EXPECT_EQ(buffer[1], SQLWCHAR(0));
+
+    SQLUSMALLINT small = 0;
+    ASSERT_EQ(SQLGetInfoW(hdbc, SQL_MAX_IDENTIFIER_LEN, &small, sizeof(small), nullptr), SQL_SUCCESS);
+    EXPECT_EQ(small, 128);
+}
+
+TEST_F(SQLGetInfoTest, LookupPerformance) {
+    const SQLUSMALLINT info_types[] = {SQL_SEARCH_PATTERN_ESCAPE, SQL_MAX_IDENTIFIER_LEN,
+                                       SQL_GETDATA_EXTENSIONS, SQL_DBMS_NAME};
+    const int iterations = 100000;
+    char buffer[64];
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        for (SQLUSMALLINT info_type : info_types) {
+            ASSERT_EQ(SQLGetInfo(hdbc, info_type, buffer, sizeof(buffer), nullptr), SQL_SUCCESS);
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "SQLGetInfo: " << iterations * 4 << " calls in " << elapsed << "us ("
+              << static_cast<double>(elapsed) * 1000.0 / (iterations * 4) << "ns/call)" << std::endl;
+}
@@ -3,6 +3,9 @@
 #include <windows.h>
 #include <sql.h>
 #include <sqlext.h>
+#include <algorithm>
+#include <string>
+#include <vector>
 
 class SQLGetTypeInfoTest : public ::testing::Test {
 protected:
@@ -81,3 +84,32 @@ TEST_F(SQLGetTypeInfoTest, CanGetSpecificType) {
     SQLRETURN ret = SQLGetTypeInfo(hstmt, SQL_INTEGER);
     EXPECT_TRUE(SQL_SUCCEEDED(ret)) << "SQLGetTypeInfo for SQL_INTEGER should succeed";
 }
+
+TEST_F(SQLGetTypeInfoTest, RowsAreOrderedByDataType) {
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLGetTypeInfo(hstmt, SQL_ALL_TYPES)));
+    std::vector<SQLSMALLINT> data_types;
+    SQLSMALLINT data_type = 0;
+    SQLLEN ind = 0;
+    while (SQLFetch(hstmt) == SQL_SUCCESS) {
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLGetData(hstmt, 2, SQL_C_SSHORT, &data_type, 0, &ind)));
+        data_types.push_back(data_type);
+    }
+    EXPECT_EQ(data_types.size(), 23u);
+    EXPECT_TRUE(std::is_sorted(data_types.begin(), data_types.end()));
+}
+
+TEST_F(SQLGetTypeInfoTest, SpecificTypeReturnsOnlyThatType) {
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLGetTypeInfo(hstmt, SQL_TYPE_TIMESTAMP)));
+    std::vector<std::string> names;
+    SQLCHAR name[64];
+    SQLLEN ind = 0;
+    while (SQLFetch(hstmt) == SQL_SUCCESS) {
+        SQLGetData(hstmt, 1, SQL_C_CHAR, name, sizeof(name), &ind);
+        names.emplace_back(reinterpret_cast<char*>(name));
+    }
+    EXPECT_EQ(names, std::vector<std::string>({"TIMESTAMP"}));
+
+    SQLFreeStmt(hstmt, SQL_CLOSE);
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLGetTypeInfo(hstmt, SQL_INTERVAL_DAY)));
+    EXPECT_EQ(SQLFetch(hstmt), SQL_NO_DATA);
+}
@@ -0,0 +1,222 @@
+// Handle Pool Tests - slab-allocated statement and descriptor handles,
+// recycling and validation of freed handles, and connections sharing the
+// mock database
+#include <gtest/gtest.h>
+#include "driver/handles.hpp"
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+using namespace mock_odbc;
+
+class HandlePoolTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc), SQL_SUCCESS);
+        const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                                   NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+    }
+
+    void TearDown() override {
+        if (hdbc != SQL_NULL_HDBC) {
+            SQLDisconnect(hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        }
+        SQLFreeHandle(SQL_HANDLE_ENV, henv);
+    }
+
+    SQLHSTMT alloc_stmt() {
+        SQLHSTMT hstmt = SQL_NULL_HSTMT;
+        EXPECT_EQ(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt), SQL_SUCCESS);
+        return hstmt;
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+};
+
+TEST_F(HandlePoolTest, FreedStatementFailsValidation) {
+    SQLHSTMT hstmt = alloc_stmt();
+    SQLHDESC ard = SQL_NULL_HDESC;
+    ASSERT_EQ(SQLGetStmtAttr(hstmt, SQL_ATTR_APP_ROW_DESC, &ard, 0, NULL), SQL_SUCCESS);
+    ASSERT_NE(validate_desc_handle(ard), nullptr);
+
+    ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hstmt), SQL_SUCCESS);
+
+    // The slot still belongs to the pool, so reading it is safe and the
+    // statement and its implicit descriptors are recognised as freed
+    EXPECT_EQ(validate_stmt_handle(hstmt), nullptr);
+    EXPECT_EQ(validate_desc_handle(ard), nullptr);
+    EXPECT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, hstmt), SQL_INVALID_HANDLE);
+    EXPECT_EQ(SQLExecDirect(hstmt, (SQLCHAR*)"SELECT 1", SQL_NTS), SQL_INVALID_HANDLE);
+}
+
+TEST_F(HandlePoolTest, FreedSlotsAreRecycled) {
+    auto* conn = validate_dbc_handle(hdbc);
+    std::set<SQLHSTMT> seen;
+    for (int round = 0; round < 100; ++round) {
+        // More than one slab's worth per round
+        std::vector<SQLHSTMT> stmts;
+        for (int i = 0; i < 40; ++i) stmts.push_back(alloc_stmt());
+        EXPECT_EQ(conn->statements_.size(), 40u);
+        for (auto h : stmts) {
+            auto* stmt = validate_stmt_handle(h);
+            ASSERT_NE(stmt, nullptr);
+            EXPECT_NE(validate_desc_handle(stmt->app_row_desc_), nullptr);
+            seen.insert(h);
+        }
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(stmts[round % 40], (SQLCHAR*)"SELECT * FROM USERS", SQL_NTS)));
+        for (auto h : stmts) ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_STMT, h), SQL_SUCCESS);
+        EXPECT_TRUE(conn->statements_.empty());
+    }
+    // 4000 statements came out of two slabs of 32 slots
+    EXPECT_LE(seen.size(), 64u);
+}
+
+TEST_F(HandlePoolTest, UnlinkFromMiddleOfList) {
+    SQLHSTMT a = alloc_stmt(), b = alloc_stmt(), c = alloc_stmt();
+    ASSERT_EQ(SQLFreeStmt(b, SQL_DROP), SQL_SUCCESS);
+
+    auto* conn = validate_dbc_handle(hdbc);
+    std::vector<StatementHandle*> listed(conn->statements_.begin(), conn->statements_.end());
+    ASSERT_EQ(listed.size(), 2u);
+    EXPECT_EQ(listed[0], validate_stmt_handle(a));
+    EXPECT_EQ(listed[1], validate_stmt_handle(c));
+
+    SQLFreeHandle(SQL_HANDLE_STMT, c);
+    SQLFreeHandle(SQL_HANDLE_STMT, a);
+    EXPECT_TRUE(conn->statements_.empty());
+}
+
+TEST_F(HandlePoolTest, ImplicitDescriptorCannotBeFreed) {
+    SQLHSTMT hstmt = alloc_stmt();
+    SQLHDESC ird = SQL_NULL_HDESC;
+    ASSERT_EQ(SQLGetStmtAttr(hstmt, SQL_ATTR_IMP_ROW_DESC, &ird, 0, NULL), SQL_SUCCESS);
+
+    EXPECT_EQ(SQLFreeHandle(SQL_HANDLE_DESC, ird), SQL_ERROR);
+    SQLCHAR state[6] = {0};
+    SQLINTEGER native = 0;
+    SQLSMALLINT len = 0;
+    SQLGetDiagRec(SQL_HANDLE_DESC, ird, 1, state, &native, NULL, 0, &len);
+    EXPECT_STREQ(reinterpret_cast<char*>(state), "HY017");
+    EXPECT_NE(validate_desc_handle(ird), nullptr);
+
+    SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+}
+
+TEST_F(HandlePoolTest, ExplicitDescriptorsFreedWithConnection) {
+    SQLHDESC kept = SQL_NULL_HDESC, freed = SQL_NULL_HDESC;
+    ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DESC, hdbc, &kept), SQL_SUCCESS);
+    ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DESC, hdbc, &freed), SQL_SUCCESS);
+
+    SQLSMALLINT alloc_type = 0;
+    SQLGetDescField(kept, 0, SQL_DESC_ALLOC_TYPE, &alloc_type, 0, NULL);
+    EXPECT_EQ(alloc_type, SQL_DESC_ALLOC_USER);
+
+    auto* conn = validate_dbc_handle(hdbc);
+    EXPECT_EQ(conn->descriptors_.size(), 2u);
+    ASSERT_EQ(SQLFreeHandle(SQL_HANDLE_DESC, freed), SQL_SUCCESS);
+    EXPECT_EQ(validate_desc_handle(freed), nullptr);
+    EXPECT_EQ(SQLFreeHandle(SQL_HANDLE_DESC, freed), SQL_INVALID_HANDLE);
+    EXPECT_EQ(conn->descriptors_.size(), 1u);
+
+    // Freeing the connection releases the one left (checked under ASan)
+    SQLDisconnect(hdbc);
+    EXPECT_EQ(SQLFreeHandle(SQL_HANDLE_DBC, hdbc), SQL_SUCCESS);
+    hdbc = SQL_NULL_HDBC;
+}
+
+TEST_F(HandlePoolTest, ConcurrentStatementChurn) {
+    const int threads = 4;
+    const int per_thread = 50000;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> workers;
+    std::vector<int> failures(threads, 0);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < per_thread; ++i) {
+                SQLHSTMT h = SQL_NULL_HSTMT;
+                if (SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &h) != SQL_SUCCESS ||
+                    SQLFreeHandle(SQL_HANDLE_STMT, h) != SQL_SUCCESS) {
+                    ++failures[t];
+                }
+            }
+        });
+    }
+    for (auto& w : workers) w.join();
+    auto elapsed = std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - start);
+
+    for (int f : failures) EXPECT_EQ(f, 0);
+    auto* conn = validate_dbc_handle(hdbc);
+    EXPECT_TRUE(conn->statements_.empty());
+
+    double rate = threads * per_thread / elapsed.count();
+    std::cout << threads << " threads: " << threads * per_thread << " statement alloc/free pairs in "
+              << static_cast<long>(elapsed.count() * 1000) << "ms (" << static_cast<long>(rate)
+              << "/s)\n";
+    // Well above the 50k/s an application pool needs, with room for CI
+    EXPECT_GT(rate, 50000.0);
+}
+
+TEST_F(HandlePoolTest, SecondConnectionKeepsSharedCatalog) {
+    SQLHSTMT hstmt = alloc_stmt();
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)"CREATE TABLE KEPT (ID INTEGER)", SQL_NTS)));
+    SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+
+    // Same connection string while the first is open: the table survives
+    SQLHDBC other = SQL_NULL_HDBC;
+    ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &other), SQL_SUCCESS);
+    const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(other, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                                   NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+        ASSERT_EQ(SQLDisconnect(other), SQL_SUCCESS);
+    }
+    SQLFreeHandle(SQL_HANDLE_DBC, other);
+
+    hstmt = alloc_stmt();
+    EXPECT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)"SELECT * FROM KEPT", SQL_NTS)));
+    SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+}
+
+TEST_F(HandlePoolTest, ConcurrentConnects) {
+    const int threads = 4;
+    const int per_thread = 200;
+    const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+
+    std::vector<std::thread> workers;
+    std::vector<int> failures(threads, 0);
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            SQLHDBC h = SQL_NULL_HDBC;
+            if (SQLAllocHandle(SQL_HANDLE_DBC, henv, &h) != SQL_SUCCESS) {
+                ++failures[t];
+                return;
+            }
+            for (int i = 0; i < per_thread; ++i) {
+                SQLHSTMT s = SQL_NULL_HSTMT;
+                if (!SQL_SUCCEEDED(SQLDriverConnect(h, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                                    NULL, 0, NULL, SQL_DRIVER_NOPROMPT)) ||
+                    SQLAllocHandle(SQL_HANDLE_STMT, h, &s) != SQL_SUCCESS ||
+                    !SQL_SUCCEEDED(SQLExecDirect(s, (SQLCHAR*)"SELECT * FROM USERS", SQL_NTS)) ||
+                    SQLFreeHandle(SQL_HANDLE_STMT, s) != SQL_SUCCESS ||
+                    SQLDisconnect(h) != SQL_SUCCESS) {
+                    ++failures[t];
+                }
+            }
+            SQLFreeHandle(SQL_HANDLE_DBC, h);
+        });
+    }
+    for (auto& w : workers) w.join();
+    for (int f : failures) EXPECT_EQ(f, 0);
+}
@@ -151,9 +151,9 @@ TEST_F(HandleTest, DiagnosticRecords) {
     // Get diagnostic
     const DiagnosticRecord* rec = env->get_diagnostic(1);
     ASSERT_NE(rec, nullptr);
-    EXPECT_EQ(rec->sqlstate, "42000");
+    EXPECT_STREQ(rec->sqlstate, "42000");
     EXPECT_EQ(rec->native_error, 100);
-    EXPECT_EQ(rec->message, "Test error message");
+    EXPECT_EQ(env->diagnostic_message(*rec), "Test error message");
     
     // Invalid record number
     EXPECT_EQ(env->get_diagnostic(0), nullptr);
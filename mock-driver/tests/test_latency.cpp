@@ -0,0 +1,152 @@
+// Latency Injection Tests - distributions, per-function latency, cancellation,
+// simulated network round trips
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <chrono>
+#include <string>
+#include <thread>
+
+class LatencyTest : public ::testing::Test {
+protected:
+    void TearDown() override {
+        if (hstmt != SQL_NULL_HSTMT) {
+            SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        }
+        if (hdbc != SQL_NULL_HDBC) {
+            SQLDisconnect(hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        }
+        if (henv != SQL_NULL_HENV) {
+            SQLFreeHandle(SQL_HANDLE_ENV, henv);
+        }
+    }
+
+    void connect(const std::string& extra) {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        ASSERT_EQ(SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0), SQL_SUCCESS);
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc), SQL_SUCCESS);
+
+        std::string conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;ResultSetSize=3;" + extra;
+        SQLRETURN ret = SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str.c_str(), SQL_NTS,
+                                         NULL, 0, NULL, SQL_DRIVER_NOPROMPT);
+        ASSERT_TRUE(SQL_SUCCEEDED(ret));
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt)));
+    }
+
+    static std::chrono::milliseconds elapsed_since(std::chrono::steady_clock::time_point start) {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - start);
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(LatencyTest, PerFunctionLatencyAppliesToFetch) {
+    connect("Latency.SQLFetch=20ms;");
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)"SELECT * FROM USERS", SQL_NTS)));
+    EXPECT_LT(elapsed_since(start).count(), 20);
+
+    start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLFetch(hstmt)));
+    EXPECT_GE(elapsed_since(start).count(), 19);
+}
+
+TEST_F(LatencyTest, UnknownPerFunctionLatencyFailsConnect) {
+    ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+    ASSERT_EQ(SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0), SQL_SUCCESS);
+    ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc), SQL_SUCCESS);
+
+    const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Latency.SQLGetInfo=1ms;";
+    EXPECT_EQ(SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                               NULL, 0, NULL, SQL_DRIVER_NOPROMPT), SQL_ERROR);
+    SQLCHAR sqlstate[6] = {0};
+    SQLINTEGER native = 0;
+    SQLCHAR message[256];
+    SQLSMALLINT len = 0;
+    SQLGetDiagRec(SQL_HANDLE_DBC, hdbc, 1, sqlstate, &native, message, sizeof(message), &len);
+    EXPECT_STREQ(reinterpret_cast<char*>(sqlstate), "08001");
+}
+
+TEST_F(LatencyTest, CancelInterruptsSynchronousExecution) {
+    connect("Latency.SQLExecDirect=5s;");
+
+    std::thread canceler([this] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        SQLCancel(hstmt);
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    SQLRETURN ret = SQLExecDirect(hstmt, (SQLCHAR*)"SELECT * FROM USERS", SQL_NTS);
+    auto waited = elapsed_since(start);
+    canceler.join();
+
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_LT(waited.count(), 1000);
+
+    SQLCHAR sqlstate[6] = {0};
+    SQLINTEGER native = 0;
+    SQLCHAR message[256];
+    SQLSMALLINT len = 0;
+    SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, sqlstate, &native, message, sizeof(message), &len);
+    EXPECT_STREQ(reinterpret_cast<char*>(sqlstate), "HY008");
+}
+
+TEST_F(LatencyTest, CancelInterruptsAsynchronousExecution) {
+    connect("Latency.SQLExecDirect=5s;");
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_ASYNC_ENABLE, (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0),
+              SQL_SUCCESS);
+
+    const char* sql = "SELECT * FROM USERS";
+    ASSERT_EQ(SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS), SQL_STILL_EXECUTING);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(SQLCancel(hstmt), SQL_SUCCESS);
+    SQLRETURN ret;
+    while ((ret = SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS)) == SQL_STILL_EXECUTING) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(ret, SQL_ERROR);
+    EXPECT_LT(elapsed_since(start).count(), 1000);
+}
+
+TEST_F(LatencyTest, FetchRoundTripsFollowRowArraySize) {
+    connect("ResultSetSize=6;NetworkRTT=15ms;FetchBatchRows=1;");
+    const char* sql = "SELECT * FROM USERS";
+
+    // One round trip per row
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS)));
+    auto start = std::chrono::steady_clock::now();
+    int rows = 0;
+    while (SQL_SUCCEEDED(SQLFetch(hstmt))) ++rows;
+    auto per_row = elapsed_since(start);
+    ASSERT_GT(rows, 1);
+    EXPECT_GE(per_row.count(), 15 * rows - 1);
+
+    // A rowset of 100 arrives in a single round trip
+    SQLFreeStmt(hstmt, SQL_CLOSE);
+    ASSERT_EQ(SQLSetStmtAttr(hstmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)100, 0), SQL_SUCCESS);
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)sql, SQL_NTS)));
+    start = std::chrono::steady_clock::now();
+    while (SQL_SUCCEEDED(SQLFetch(hstmt))) {
+    }
+    auto batched = elapsed_since(start);
+    EXPECT_GE(batched.count(), 14);
+    EXPECT_LT(batched.count(), 15 * rows - 1);
+}
+
+TEST_F(LatencyTest, BandwidthChargesBytesTransferred) {
+    // 1 KB/s: every byte of the SQL text costs about a millisecond
+    connect("NetworkBandwidth=1K;");
+    std::string sql = "SELECT * FROM USERS" + std::string(40, ' ');
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLExecDirect(hstmt, (SQLCHAR*)sql.c_str(), SQL_NTS)));
+    EXPECT_GE(elapsed_since(start).count(), 55);
+}
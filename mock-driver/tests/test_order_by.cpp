@@ -0,0 +1,205 @@
+// ORDER BY / LIMIT Tests - multi-key ordering, paging clauses and top-N
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include "mock/row_order.hpp"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace mock_odbc;
+
+TEST(RowOrderTest, TypedKeysNullsAndTies) {
+    std::vector<MockRow> rows = {
+        {3LL, std::string("b")},
+        {std::monostate{}, std::string("a")},
+        {1LL, std::string("c")},
+        {3LL, std::string("a")},
+        {2LL, std::monostate{}}
+    };
+    RowSource source;
+    source.rows = &rows;
+    std::vector<uint32_t> all = {0, 1, 2, 3, 4};
+
+    SortKey first;
+    first.column = 0;
+    first.data_type = SQL_INTEGER;
+    SortKey second;
+    second.column = 1;
+    second.data_type = SQL_VARCHAR;
+
+    std::vector<uint32_t> order = all;
+    order_rows(source, {first, second}, order, order.size());
+    EXPECT_EQ(order, std::vector<uint32_t>({1, 2, 4, 3, 0}));
+
+    // Descending with NULLs last; equal keys keep table order
+    first.descending = true;
+    first.nulls_first = false;
+    order = all;
+    order_rows(source, {first}, order, order.size());
+    EXPECT_EQ(order, std::vector<uint32_t>({0, 3, 4, 2, 1}));
+
+    // Top-N keeps only the rows asked for
+    std::vector<MockRow> many;
+    for (long long i = 0; i < 1000; ++i) {
+        many.push_back({(i * 7919) % 1000});
+    }
+    source.rows = &many;
+    std::vector<uint32_t> top(many.size());
+    for (uint32_t i = 0; i < top.size(); ++i) top[i] = i;
+    first.column = 0;
+    first.descending = false;
+    order_rows(source, {first}, top, 3);
+    ASSERT_EQ(top.size(), 3u);
+    EXPECT_EQ(std::get<long long>(many[top[0]][0]), 0);
+    EXPECT_EQ(std::get<long long>(many[top[2]][0]), 2);
+}
+
+TEST(RowOrderTest, MixedColumnFallsBack) {
+    // An INTEGER column holding text compares through compare_cells
+    std::vector<MockRow> rows = {{10LL}, {std::string("9")}, {2.5}, {std::string("100")}};
+    RowSource source;
+    source.rows = &rows;
+    SortKey key;
+    key.column = 0;
+    key.data_type = SQL_INTEGER;
+    std::vector<uint32_t> order = {0, 1, 2, 3};
+    order_rows(source, {key}, order, order.size());
+    EXPECT_EQ(order, std::vector<uint32_t>({2, 1, 0, 3}));
+}
+
+class OrderByTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+        SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+    }
+
+    void TearDown() override {
+        if (hstmt != SQL_NULL_HSTMT) SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        SQLDisconnect(hdbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        SQLFreeHandle(SQL_HANDLE_ENV, henv);
+    }
+
+    void connect(int result_set_size) {
+        std::string conn = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;ResultSetSize=" +
+                           std::to_string(result_set_size) + ";";
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn.c_str(), SQL_NTS,
+                                                   NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+        SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+    }
+
+    SQLRETURN exec(const std::string& sql) {
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return SQLExecDirect(hstmt, (SQLCHAR*)sql.c_str(), SQL_NTS);
+    }
+
+    // First column of every row, as integers (-1 for NULL)
+    std::vector<long long> column_values(const std::string& sql) {
+        std::vector<long long> values;
+        EXPECT_TRUE(SQL_SUCCEEDED(exec(sql))) << sql;
+        SQLBIGINT v = 0;
+        SQLLEN ind = 0;
+        while (SQLFetch(hstmt) == SQL_SUCCESS) {
+            SQLGetData(hstmt, 1, SQL_C_SBIGINT, &v, 0, &ind);
+            values.push_back(ind == SQL_NULL_DATA ? -1 : v);
+        }
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return values;
+    }
+
+    std::string first_sqlstate() {
+        SQLCHAR state[6] = {0};
+        SQLINTEGER native = 0;
+        SQLSMALLINT len = 0;
+        SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, state, &native, NULL, 0, &len);
+        return reinterpret_cast<char*>(state);
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+using Values = std::vector<long long>;
+
+TEST_F(OrderByTest, MultipleKeysAndPositions) {
+    connect(100);
+    // STOCK_QUANTITY is row % 10 + 1
+    EXPECT_EQ(column_values("SELECT PRODUCT_ID FROM PRODUCTS ORDER BY STOCK_QUANTITY DESC, PRODUCT_ID LIMIT 3"),
+              Values({10, 20, 30}));
+    EXPECT_EQ(column_values("SELECT PRODUCT_ID, STOCK_QUANTITY FROM PRODUCTS ORDER BY 2, 1 DESC LIMIT 2"),
+              Values({91, 81}));
+    EXPECT_EQ(column_values("SELECT PRODUCT_ID FROM PRODUCTS ORDER BY PRODUCTS.PRICE DESC, \"PRODUCT_ID\" ASC LIMIT 2"),
+              Values({100, 99}));
+}
+
+TEST_F(OrderByTest, PagingClauses) {
+    connect(100);
+    EXPECT_EQ(column_values("SELECT TOP 2 PRODUCT_ID FROM PRODUCTS"), Values({1, 2}));
+    EXPECT_EQ(column_values("SELECT TOP (3) PRODUCT_ID FROM PRODUCTS ORDER BY PRODUCT_ID DESC"),
+              Values({100, 99, 98}));
+    EXPECT_EQ(column_values("SELECT PRODUCT_ID FROM PRODUCTS LIMIT 2 OFFSET 10"), Values({11, 12}));
+    EXPECT_EQ(column_values("SELECT PRODUCT_ID FROM PRODUCTS LIMIT 10, 2;"), Values({11, 12}));
+    EXPECT_EQ(column_values("SELECT PRODUCT_ID FROM PRODUCTS ORDER BY PRODUCT_ID DESC "
+                            "OFFSET 5 ROWS FETCH NEXT 2 ROWS ONLY"),
+              Values({95, 94}));
+    EXPECT_EQ(column_values("SELECT PRODUCT_ID FROM PRODUCTS FETCH FIRST ROW ONLY"), Values({1}));
+    EXPECT_EQ(column_values("SELECT PRODUCT_ID FROM PRODUCTS OFFSET 98 ROWS"), Values({99, 100}));
+    EXPECT_EQ(column_values("SELECT PRODUCT_ID FROM PRODUCTS LIMIT 0"), Values({}));
+    EXPECT_EQ(column_values("SELECT PRODUCT_ID FROM PRODUCTS LIMIT 5 OFFSET 200"), Values({}));
+}
+
+TEST_F(OrderByTest, WhereOrderAndLimitOnStoredRows) {
+    connect(10);
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE TABLE T (ID INTEGER PRIMARY KEY, V INTEGER, S VARCHAR(10))")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO T (ID, V, S) VALUES (1, 30, 'c')")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO T (ID, V, S) VALUES (2, NULL, 'a')")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO T (ID, V, S) VALUES (3, 10, 'b')")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO T (ID, V, S) VALUES (4, 20, 'a')")));
+
+    EXPECT_EQ(column_values("SELECT ID FROM T ORDER BY V"), Values({2, 3, 4, 1}));
+    EXPECT_EQ(column_values("SELECT ID FROM T ORDER BY V DESC"), Values({1, 4, 3, 2}));
+    EXPECT_EQ(column_values("SELECT ID FROM T ORDER BY V NULLS LAST"), Values({3, 4, 1, 2}));
+    EXPECT_EQ(column_values("SELECT ID FROM T ORDER BY S, V DESC"), Values({4, 2, 3, 1}));
+    EXPECT_EQ(column_values("SELECT ID FROM T WHERE ID > 1 ORDER BY S DESC LIMIT 2"), Values({3, 2}));
+    EXPECT_EQ(column_values("SELECT V FROM T WHERE V IS NOT NULL ORDER BY ID DESC FETCH FIRST 1 ROWS ONLY"),
+              Values({20}));
+}
+
+TEST_F(OrderByTest, Errors) {
+    connect(10);
+    EXPECT_EQ(exec("SELECT * FROM PRODUCTS ORDER BY NOPE"), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "42S22");
+    EXPECT_EQ(exec("SELECT PRODUCT_ID FROM PRODUCTS ORDER BY 2"), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "42000");
+    EXPECT_EQ(exec("SELECT * FROM PRODUCTS ORDER BY UPPER(NAME)"), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "42000");
+    EXPECT_EQ(exec("SELECT * FROM PRODUCTS LIMIT ten"), SQL_ERROR);
+    EXPECT_EQ(first_sqlstate(), "42000");
+}
+
+TEST_F(OrderByTest, TopNOnLargeTable) {
+    const int total = 1000000;
+    connect(total);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    auto top = column_values("SELECT CUSTOMER_ID FROM CUSTOMERS ORDER BY BALANCE DESC LIMIT 10");
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    ASSERT_EQ(top.size(), 10u);
+    EXPECT_EQ(top.front(), total);
+    EXPECT_EQ(top.back(), total - 9);
+    std::cout << "ORDER BY ... LIMIT 10 over " << total << " rows in " << duration.count() << "ms\n";
+
+    // Paging without ORDER BY makes only the rows it returns
+    start = std::chrono::high_resolution_clock::now();
+    EXPECT_EQ(column_values("SELECT CUSTOMER_ID FROM CUSTOMERS LIMIT 3 OFFSET 5"), Values({6, 7, 8}));
+    end = std::chrono::high_resolution_clock::now();
+    EXPECT_LT(std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count(), 100);
+}
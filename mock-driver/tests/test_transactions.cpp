@@ -0,0 +1,315 @@
+// Transaction Tests - snapshot isolation, commit/rollback per connection
+// and first-committer-wins conflicts between concurrent writers
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// One connection with one statement
+struct Session {
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+
+    SQLRETURN exec(const std::string& sql) {
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return SQLExecDirect(hstmt, (SQLCHAR*)sql.c_str(), SQL_NTS);
+    }
+
+    // First column of the first row, or -1
+    long long scalar(const std::string& sql) {
+        SQLBIGINT value = -1;
+        EXPECT_TRUE(SQL_SUCCEEDED(exec(sql))) << sql;
+        if (SQLFetch(hstmt) == SQL_SUCCESS) SQLGetData(hstmt, 1, SQL_C_SBIGINT, &value, 0, NULL);
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return value;
+    }
+
+    void manual_commit() {
+        SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0);
+    }
+
+    SQLRETURN end(SQLSMALLINT type) { return SQLEndTran(SQL_HANDLE_DBC, hdbc, type); }
+
+    std::string dbc_sqlstate() {
+        SQLCHAR state[6] = {0};
+        SQLINTEGER native = 0;
+        SQLSMALLINT len = 0;
+        SQLGetDiagRec(SQL_HANDLE_DBC, hdbc, 1, state, &native, NULL, 0, &len);
+        return reinterpret_cast<char*>(state);
+    }
+};
+
+} // anonymous namespace
+
+class TransactionTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+    }
+
+    void TearDown() override {
+        for (auto& s : sessions) {
+            SQLFreeHandle(SQL_HANDLE_STMT, s->hstmt);
+            SQLDisconnect(s->hdbc);
+            SQLFreeHandle(SQL_HANDLE_DBC, s->hdbc);
+        }
+        SQLFreeHandle(SQL_HANDLE_ENV, henv);
+    }
+
+    // Connections share the catalog while any of them is open, so the
+    // tables a test creates are visible to all its sessions
+    Session& open() {
+        auto s = std::make_unique<Session>();
+        SQLAllocHandle(SQL_HANDLE_DBC, henv, &s->hdbc);
+        const char* conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+        EXPECT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(s->hdbc, NULL, (SQLCHAR*)conn_str, SQL_NTS,
+                                                   NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+        SQLAllocHandle(SQL_HANDLE_STMT, s->hdbc, &s->hstmt);
+        sessions.push_back(std::move(s));
+        return *sessions.back();
+    }
+
+    void create_accounts(Session& s, int count, int balance) {
+        ASSERT_TRUE(SQL_SUCCEEDED(s.exec(
+            "CREATE TABLE ACCOUNTS (ID INTEGER PRIMARY KEY, BALANCE INTEGER)")));
+        for (int i = 1; i <= count; ++i) {
+            ASSERT_TRUE(SQL_SUCCEEDED(s.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (" +
+                std::to_string(i) + ", " + std::to_string(balance) + ")")));
+        }
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    std::vector<std::unique_ptr<Session>> sessions;
+};
+
+TEST_F(TransactionTest, UncommittedWritesStayPrivate) {
+    Session& a = open();
+    Session& b = open();
+    create_accounts(a, 3, 100);
+    a.manual_commit();
+
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (4, 100)")));
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("UPDATE ACCOUNTS SET BALANCE = 0 WHERE ID = 1")));
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 4);
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 1"), 0);
+    EXPECT_EQ(b.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 3);
+    EXPECT_EQ(b.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 1"), 100);
+
+    ASSERT_EQ(a.end(SQL_COMMIT), SQL_SUCCESS);
+    EXPECT_EQ(b.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 4);
+    EXPECT_EQ(b.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 1"), 0);
+}
+
+TEST_F(TransactionTest, RollbackDiscardsOnlyItsOwnWrites) {
+    Session& a = open();
+    Session& b = open();
+    create_accounts(a, 3, 100);
+    a.manual_commit();
+    b.manual_commit();
+
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("DELETE FROM ACCOUNTS WHERE ID = 2")));
+    ASSERT_TRUE(SQL_SUCCEEDED(b.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (9, 900)")));
+    ASSERT_EQ(a.end(SQL_ROLLBACK), SQL_SUCCESS);
+    ASSERT_EQ(b.end(SQL_COMMIT), SQL_SUCCESS);
+
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 4);
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 2"), 100);
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 9"), 900);
+}
+
+TEST_F(TransactionTest, CommitAppliesOnlyTheChangedRows) {
+    Session& a = open();
+    Session& b = open();
+    create_accounts(a, 3, 100);
+    a.manual_commit();
+
+    // Writes before and after the transaction first reads its own changes,
+    // to snapshot rows and to rows it inserted
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("UPDATE ACCOUNTS SET BALANCE = 1 WHERE ID = 1")));
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (4, 400)")));
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (5, 500)")));
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("DELETE FROM ACCOUNTS WHERE ID = 5")));
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("UPDATE ACCOUNTS SET BALANCE = BALANCE + 1 WHERE ID >= 3")));
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("DELETE FROM ACCOUNTS WHERE ID = 2")));
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (6, 600)")));
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 4);
+    EXPECT_EQ(b.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 3);
+
+    ASSERT_EQ(a.end(SQL_COMMIT), SQL_SUCCESS);
+    EXPECT_EQ(b.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 4);
+    EXPECT_EQ(b.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 1"), 1);
+    EXPECT_EQ(b.scalar("SELECT COUNT(*) FROM ACCOUNTS WHERE ID = 2"), 0);
+    EXPECT_EQ(b.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 3"), 101);
+    EXPECT_EQ(b.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 4"), 401);
+    EXPECT_EQ(b.scalar("SELECT COUNT(*) FROM ACCOUNTS WHERE ID = 5"), 0);
+    EXPECT_EQ(b.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 6"), 600);
+}
+
+TEST_F(TransactionTest, SQLConnectKeepsAutocommitSetBeforeConnecting) {
+    auto s = std::make_unique<Session>();
+    SQLAllocHandle(SQL_HANDLE_DBC, henv, &s->hdbc);
+    s->manual_commit();
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLConnect(s->hdbc, (SQLCHAR*)"MockDSN", SQL_NTS,
+                                         (SQLCHAR*)"user", SQL_NTS, (SQLCHAR*)"", SQL_NTS)));
+    SQLAllocHandle(SQL_HANDLE_STMT, s->hdbc, &s->hstmt);
+    sessions.push_back(std::move(s));
+    Session& a = *sessions.back();
+
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("CREATE TABLE ACCOUNTS (ID INTEGER PRIMARY KEY, BALANCE INTEGER)")));
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (1, 100)")));
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 1);
+    ASSERT_EQ(a.end(SQL_ROLLBACK), SQL_SUCCESS);
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 0);
+}
+
+TEST_F(TransactionTest, ReadsComeFromTheSnapshot) {
+    Session& a = open();
+    Session& b = open();
+    create_accounts(a, 3, 100);
+    a.manual_commit();
+
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 3"), 100);
+    ASSERT_TRUE(SQL_SUCCEEDED(b.exec("UPDATE ACCOUNTS SET BALANCE = 5 WHERE ID = 3")));
+    ASSERT_TRUE(SQL_SUCCEEDED(b.exec("DELETE FROM ACCOUNTS WHERE ID = 1")));
+    ASSERT_TRUE(SQL_SUCCEEDED(b.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (7, 7)")));
+
+    // Still the rows as of the transaction's first statement
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 3"), 100);
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS WHERE ID < 10"), 3);
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 1"), 100);
+
+    ASSERT_EQ(a.end(SQL_COMMIT), SQL_SUCCESS);
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 3"), 5);
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 3);
+}
+
+TEST_F(TransactionTest, FirstCommitterWins) {
+    Session& a = open();
+    Session& b = open();
+    create_accounts(a, 3, 100);
+    a.manual_commit();
+    b.manual_commit();
+
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("UPDATE ACCOUNTS SET BALANCE = BALANCE - 10 WHERE ID = 1")));
+    ASSERT_TRUE(SQL_SUCCEEDED(b.exec("UPDATE ACCOUNTS SET BALANCE = BALANCE - 20 WHERE ID = 1")));
+    ASSERT_TRUE(SQL_SUCCEEDED(b.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (8, 8)")));
+    ASSERT_EQ(a.end(SQL_COMMIT), SQL_SUCCESS);
+    EXPECT_EQ(b.end(SQL_COMMIT), SQL_ERROR);
+    EXPECT_EQ(b.dbc_sqlstate(), "40001");
+
+    // None of the loser's writes were published
+    EXPECT_EQ(b.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 1"), 90);
+    EXPECT_EQ(b.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 3);
+    ASSERT_EQ(b.end(SQL_COMMIT), SQL_SUCCESS);
+
+    // Writers of different rows both commit
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("UPDATE ACCOUNTS SET BALANCE = 1 WHERE ID = 2")));
+    ASSERT_TRUE(SQL_SUCCEEDED(b.exec("DELETE FROM ACCOUNTS WHERE ID = 3")));
+    EXPECT_EQ(b.end(SQL_COMMIT), SQL_SUCCESS);
+    EXPECT_EQ(a.end(SQL_COMMIT), SQL_SUCCESS);
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 2"), 1);
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 2);
+}
+
+TEST_F(TransactionTest, AutocommitOnCommitsAndDisconnectRollsBack) {
+    Session& a = open();
+    Session& b = open();
+    create_accounts(a, 1, 100);
+    a.manual_commit();
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (2, 200)")));
+    ASSERT_EQ(SQLSetConnectAttr(a.hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0),
+              SQL_SUCCESS);
+    EXPECT_EQ(b.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 2);
+
+    b.manual_commit();
+    ASSERT_TRUE(SQL_SUCCEEDED(b.exec("DELETE FROM ACCOUNTS")));
+    SQLFreeStmt(b.hstmt, SQL_CLOSE);
+    ASSERT_EQ(SQLDisconnect(b.hdbc), SQL_SUCCESS);
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS"), 2);
+}
+
+TEST_F(TransactionTest, IndexesFollowCommittedWrites) {
+    Session& a = open();
+    create_accounts(a, 50, 100);
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 40"), 100);
+    a.manual_commit();
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("UPDATE ACCOUNTS SET ID = 140 WHERE ID = 40")));
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("DELETE FROM ACCOUNTS WHERE ID = 10")));
+    ASSERT_TRUE(SQL_SUCCEEDED(a.exec("INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (60, 6)")));
+    ASSERT_EQ(a.end(SQL_COMMIT), SQL_SUCCESS);
+
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS WHERE ID = 40"), 0);
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 140"), 100);
+    EXPECT_EQ(a.scalar("SELECT COUNT(*) FROM ACCOUNTS WHERE ID = 10"), 0);
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 60"), 6);
+    EXPECT_EQ(a.scalar("SELECT BALANCE FROM ACCOUNTS WHERE ID = 11"), 100);
+}
+
+TEST_F(TransactionTest, ConcurrentTransfersThroughput) {
+    const int writers = 4;
+    const int accounts = 1000;
+    const int transfers_per_writer = 2000;
+    for (int i = 0; i < writers; ++i) open();
+    create_accounts(*sessions[0], accounts, 1000);
+
+    std::atomic<long long> commits{0}, conflicts{0}, commit_us{0};
+    auto start = std::chrono::high_resolution_clock::now();
+    std::vector<std::thread> threads;
+    for (int w = 0; w < writers; ++w) {
+        threads.emplace_back([&, w] {
+            Session& s = *sessions[w];
+            s.manual_commit();
+            std::mt19937 rng(static_cast<unsigned>(w + 1));
+            std::uniform_int_distribution<int> pick(1, accounts);
+            for (int t = 0; t < transfers_per_writer;) {
+                int from = pick(rng), to = pick(rng);
+                if (from == to) continue;
+                s.exec("UPDATE ACCOUNTS SET BALANCE = BALANCE - 1 WHERE ID = " + std::to_string(from));
+                s.exec("UPDATE ACCOUNTS SET BALANCE = BALANCE + 1 WHERE ID = " + std::to_string(to));
+                auto before = std::chrono::high_resolution_clock::now();
+                SQLRETURN ret = s.end(SQL_COMMIT);
+                commit_us += std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::high_resolution_clock::now() - before).count();
+                if (SQL_SUCCEEDED(ret)) {
+                    ++commits;
+                    ++t;
+                } else {
+                    ++conflicts;   // Rolled back; retry another transfer
+                }
+            }
+        });
+    }
+    for (auto& t : threads) t.join();
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    long long attempts = commits + conflicts;
+    std::cout << writers << " writers: " << commits << " commits, " << conflicts << " conflicts ("
+              << (100.0 * conflicts / std::max(attempts, 1LL)) << "%) in " << duration.count()
+              << "ms, mean commit " << (static_cast<double>(commit_us) / std::max(attempts, 1LL))
+              << "us\n";
+    EXPECT_EQ(commits, writers * transfers_per_writer);
+    // Transfers move money; committed or not, none may create or lose any
+    EXPECT_EQ(sessions[0]->scalar("SELECT COUNT(*) FROM ACCOUNTS WHERE BALANCE >= 0"), accounts);
+    long long total = 0;
+    ASSERT_TRUE(SQL_SUCCEEDED(sessions[0]->exec("SELECT BALANCE FROM ACCOUNTS")));
+    SQLBIGINT balance = 0;
+    while (SQLFetch(sessions[0]->hstmt) == SQL_SUCCESS) {
+        SQLGetData(sessions[0]->hstmt, 1, SQL_C_SBIGINT, &balance, 0, NULL);
+        total += balance;
+    }
+    EXPECT_EQ(total, 1000LL * accounts);
+    EXPECT_LT(duration.count(), 10000) << "Transactions too slow";
+}
@@ -0,0 +1,289 @@
+// UPDATE / DELETE Tests - in-place writes, affected-row counts and indexes
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+class UpdateDeleteTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+        connect("");
+    }
+
+    void TearDown() override {
+        disconnect();
+        SQLFreeHandle(SQL_HANDLE_ENV, henv);
+    }
+
+    void connect(const std::string& data_file) {
+        SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+        std::string conn_str = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+        if (!data_file.empty()) conn_str += "DataFile=" + data_file + ";";
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(hdbc, NULL, (SQLCHAR*)conn_str.c_str(), SQL_NTS,
+                                                   NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+        SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+    }
+
+    void disconnect() {
+        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        SQLDisconnect(hdbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+    }
+
+    SQLRETURN exec(const std::string& sql) {
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return SQLExecDirect(hstmt, (SQLCHAR*)sql.c_str(), SQL_NTS);
+    }
+
+    // Execute a write and return SQLRowCount, or -2 when it fails
+    SQLLEN write(const std::string& sql) {
+        if (!SQL_SUCCEEDED(exec(sql))) return -2;
+        SQLLEN count = -1;
+        SQLRowCount(hstmt, &count);
+        return count;
+    }
+
+    std::string sqlstate() {
+        SQLCHAR state[6] = {0};
+        SQLINTEGER native = 0;
+        SQLSMALLINT len = 0;
+        SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, state, &native, NULL, 0, &len);
+        return reinterpret_cast<char*>(state);
+    }
+
+    // Rows as "ID:QTY:NAME", NULLs as "-"
+    std::vector<std::string> rows(const std::string& sql) {
+        std::vector<std::string> result;
+        EXPECT_TRUE(SQL_SUCCEEDED(exec(sql))) << sql;
+        while (SQLFetch(hstmt) == SQL_SUCCESS) {
+            std::string row;
+            for (SQLUSMALLINT c = 1; c <= 3; ++c) {
+                char value[32] = {0};
+                SQLLEN ind = 0;
+                SQLGetData(hstmt, c, SQL_C_CHAR, value, sizeof(value), &ind);
+                if (c > 1) row += ":";
+                row += ind == SQL_NULL_DATA ? "-" : value;
+            }
+            result.push_back(row);
+        }
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return result;
+    }
+
+    long long count(const std::string& sql) {
+        SQLBIGINT value = -1;
+        EXPECT_TRUE(SQL_SUCCEEDED(exec(sql))) << sql;
+        if (SQLFetch(hstmt) == SQL_SUCCESS) SQLGetData(hstmt, 1, SQL_C_SBIGINT, &value, 0, NULL);
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return value;
+    }
+
+    void create_stock() {
+        ASSERT_TRUE(SQL_SUCCEEDED(exec(
+            "CREATE TABLE STOCK (ID INTEGER PRIMARY KEY, QTY INTEGER, NAME VARCHAR(20))")));
+        for (int i = 1; i <= 5; ++i) {
+            ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO STOCK (ID, QTY, NAME) VALUES (" +
+                std::to_string(i) + ", " + std::to_string(i * 10) + ", 'item" + std::to_string(i) + "')")));
+        }
+    }
+
+    using Rows = std::vector<std::string>;
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(UpdateDeleteTest, UpdateChangesMatchingRows) {
+    create_stock();
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = QTY + 5, NAME = 'restocked' WHERE ID IN (2, 4)"), 2);
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK"),
+              Rows({"1:10:item1", "2:25:restocked", "3:30:item3", "4:45:restocked", "5:50:item5"}));
+
+    // Every assignment reads the old row
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = ID, ID = QTY WHERE ID = 1"), 1);
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE NAME = 'item1'"), Rows({"10:1:item1"}));
+
+    EXPECT_EQ(write("UPDATE STOCK SET NAME = NULL WHERE QTY > 1000"), 0);
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = QTY * 2"), 5);
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE ID = 3"), Rows({"3:60:item3"}));
+}
+
+TEST_F(UpdateDeleteTest, ParametersInSetAndWhere) {
+    create_stock();
+    SQLINTEGER delta = 7, id = 3;
+    char name[] = "bound";
+    SQLLEN name_ind = SQL_NTS;
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"UPDATE STOCK SET QTY = QTY - ?, NAME = ? WHERE ID = ?", SQL_NTS),
+              SQL_SUCCESS);
+    SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &delta, 0, NULL);
+    SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 20, 0, name, 0, &name_ind);
+    SQLBindParameter(hstmt, 3, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &id, 0, NULL);
+    ASSERT_EQ(SQLExecute(hstmt), SQL_SUCCESS);
+    SQLLEN count = 0;
+    SQLRowCount(hstmt, &count);
+    EXPECT_EQ(count, 1);
+    SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE ID = 3"), Rows({"3:23:bound"}));
+}
+
+TEST_F(UpdateDeleteTest, DeleteCompactsRows) {
+    create_stock();
+    EXPECT_EQ(write("DELETE FROM STOCK WHERE QTY BETWEEN 20 AND 40"), 3);
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK"), Rows({"1:10:item1", "5:50:item5"}));
+    EXPECT_EQ(write("DELETE FROM STOCK WHERE ID = 3"), 0);
+
+    // Primary key lookups see the renumbered rows
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE ID = 5"), Rows({"5:50:item5"}));
+    EXPECT_EQ(write("DELETE FROM STOCK"), 2);
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK"), Rows({}));
+    EXPECT_EQ(count("SELECT COUNT(*) FROM STOCK"), 0);
+}
+
+TEST_F(UpdateDeleteTest, IndexesFollowUpdatedKeys) {
+    create_stock();
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE INDEX IX_STOCK_QTY ON STOCK (QTY)")));
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE QTY >= 40"), Rows({"4:40:item4", "5:50:item5"}));
+
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = 99, ID = 77 WHERE ID = 2"), 1);
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE QTY >= 40"),
+              Rows({"77:99:item2", "4:40:item4", "5:50:item5"}));
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE ID = 77"), Rows({"77:99:item2"}));
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE ID = 2"), Rows({}));
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE QTY = 20"), Rows({}));
+}
+
+TEST_F(UpdateDeleteTest, PresetTablesReportMatchesOnly) {
+    // CUSTOMERS rows are generated on every read, so nothing is changed
+    EXPECT_EQ(write("UPDATE CUSTOMERS SET NAME = 'x' WHERE CUSTOMER_ID <= 3"), 3);
+    EXPECT_EQ(write("DELETE FROM CUSTOMERS WHERE CUSTOMER_ID = 2"), 1);
+    EXPECT_EQ(count("SELECT COUNT(*) FROM CUSTOMERS WHERE CUSTOMER_ID = 2"), 1);
+}
+
+TEST_F(UpdateDeleteTest, Errors) {
+    create_stock();
+    EXPECT_EQ(write("UPDATE STOCK SET NOPE = 1"), -2);
+    EXPECT_EQ(sqlstate(), "42S22");
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = 1 WHERE NOPE = 1"), -2);
+    EXPECT_EQ(sqlstate(), "42S22");
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = QTY / 0"), -2);
+    EXPECT_EQ(sqlstate(), "22012");
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = 9223372036854775807 + 1"), -2);
+    EXPECT_EQ(sqlstate(), "22003");
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = -9223372036854775807 - 2"), -2);
+    EXPECT_EQ(sqlstate(), "22003");
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = 4294967296 * 4294967296"), -2);
+    EXPECT_EQ(sqlstate(), "22003");
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = -9223372036854775808 / -1"), -2);
+    EXPECT_EQ(sqlstate(), "22003");
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = NAME + 1"), -2);
+    EXPECT_EQ(sqlstate(), "22018");
+    EXPECT_EQ(write("UPDATE STOCK WHERE ID = 1"), -2);
+    EXPECT_EQ(sqlstate(), "42000");
+    EXPECT_EQ(write("DELETE FROM MISSING"), -2);
+    EXPECT_EQ(sqlstate(), "42S02");
+    // A failed statement changes nothing
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE ID = 1"), Rows({"1:10:item1"}));
+}
+
+TEST_F(UpdateDeleteTest, FileTableWritesPersist) {
+    std::string path = (std::filesystem::temp_directory_path() / "mock_odbc_update_delete.dat").string();
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    disconnect();
+    connect(path);
+
+    create_stock();
+    EXPECT_EQ(write("UPDATE STOCK SET QTY = 0 WHERE ID = 1"), 1);
+    EXPECT_EQ(write("DELETE FROM STOCK WHERE ID IN (3, 4)"), 2);
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK WHERE ID = 1"), Rows({"1:0:item1"}));
+    Rows expected = rows("SELECT ID, QTY, NAME FROM STOCK ORDER BY ID");
+    EXPECT_EQ(expected, Rows({"1:0:item1", "2:20:item2", "5:50:item5"}));
+
+    disconnect();
+    connect("");
+    EXPECT_EQ(exec("SELECT ID FROM STOCK"), SQL_ERROR);
+    disconnect();
+    connect(path);
+    EXPECT_EQ(rows("SELECT ID, QTY, NAME FROM STOCK ORDER BY ID"), expected);
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("DROP TABLE STOCK")));
+    disconnect();
+    connect("");
+    std::filesystem::remove(path, ec);
+}
+
+TEST_F(UpdateDeleteTest, MixedReadWriteThroughput) {
+    const int total = 50000;
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE TABLE ACCOUNTS (ID INTEGER PRIMARY KEY, BALANCE INTEGER)")));
+    std::vector<SQLINTEGER> ids(total), balances(total, 100);
+    for (int i = 0; i < total; ++i) ids[i] = i;
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO ACCOUNTS (ID, BALANCE) VALUES (?, ?)", SQL_NTS),
+              SQL_SUCCESS);
+    SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, ids.data(), 0, NULL);
+    SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, balances.data(), 0, NULL);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(intptr_t)total, 0);
+    ASSERT_EQ(SQLExecute(hstmt), SQL_SUCCESS);
+    SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+    SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0);
+
+    // Transfers: debit one account, credit another, read one back
+    SQLHSTMT update = SQL_NULL_HSTMT, select = SQL_NULL_HSTMT;
+    SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &update);
+    SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &select);
+    SQLINTEGER key = 0, amount = 0, balance = 0;
+    ASSERT_EQ(SQLPrepare(update, (SQLCHAR*)"UPDATE ACCOUNTS SET BALANCE = BALANCE + ? WHERE ID = ?", SQL_NTS),
+              SQL_SUCCESS);
+    SQLBindParameter(update, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &amount, 0, NULL);
+    SQLBindParameter(update, 2, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &key, 0, NULL);
+    ASSERT_EQ(SQLPrepare(select, (SQLCHAR*)"SELECT BALANCE FROM ACCOUNTS WHERE ID = ?", SQL_NTS), SQL_SUCCESS);
+    SQLBindParameter(select, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &key, 0, NULL);
+    SQLBindCol(select, 1, SQL_C_SLONG, &balance, 0, NULL);
+
+    const int transfers = 10000;
+    SQLLEN updated = 0, affected = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < transfers; ++i) {
+        SQLINTEGER from = static_cast<SQLINTEGER>((i * 7919LL) % total);
+        SQLINTEGER to = static_cast<SQLINTEGER>((i * 104729LL + 1) % total);
+        key = from;
+        amount = -1;
+        ASSERT_EQ(SQLExecute(update), SQL_SUCCESS);
+        SQLRowCount(update, &affected);
+        updated += affected;
+        key = to;
+        amount = 1;
+        ASSERT_EQ(SQLExecute(update), SQL_SUCCESS);
+        SQLRowCount(update, &affected);
+        updated += affected;
+        ASSERT_EQ(SQLExecute(select), SQL_SUCCESS);
+        while (SQLFetch(select) == SQL_SUCCESS) {}
+        SQLFreeStmt(select, SQL_CLOSE);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+    SQLFreeHandle(SQL_HANDLE_STMT, update);
+    SQLFreeHandle(SQL_HANDLE_STMT, select);
+
+    std::cout << transfers << " transfers (2 updates + 1 lookup) on " << total << " rows in "
+              << duration.count() << "ms\n";
+    EXPECT_EQ(updated, 2 * transfers);
+    // Transfers move money around; the total stays the same
+    SQLBIGINT sum = 0;
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("SELECT BALANCE FROM ACCOUNTS")));
+    while (SQLFetch(hstmt) == SQL_SUCCESS) {
+        SQLINTEGER v = 0;
+        SQLGetData(hstmt, 1, SQL_C_SLONG, &v, 0, NULL);
+        sum += v;
+    }
+    EXPECT_EQ(sum, 100LL * total);
+    // Each statement is a hash lookup; a scan per statement would take far longer
+    EXPECT_LT(duration.count(), 5000) << "Mixed read/write workload too slow";
+}
@@ -0,0 +1,414 @@
+// WHERE Clause Tests - predicate evaluation and row indexes on stored tables
+#include <gtest/gtest.h>
+#include <windows.h>
+#include <sql.h>
+#include <sqlext.h>
+#include "mock/predicate.hpp"
+#include "mock/table_index.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace mock_odbc;
+
+namespace {
+
+MockTable people_table() {
+    MockTable table;
+    table.name = "PEOPLE";
+    table.columns = {
+        {"ID", SQL_INTEGER, 10, 0, SQL_NO_NULLS, true, false, "", "", ""},
+        {"NAME", SQL_VARCHAR, 20, 0, SQL_NULLABLE, false, false, "", "", ""},
+        {"AGE", SQL_INTEGER, 10, 0, SQL_NULLABLE, false, false, "", "", ""},
+        {"SCORE", SQL_DOUBLE, 15, 0, SQL_NULLABLE, false, false, "", "", ""}
+    };
+    return table;
+}
+
+std::vector<MockRow> people_rows() {
+    return {
+        {1LL, std::string("Ada"), 36LL, 9.5},
+        {2LL, std::string("Brian"), 41LL, 7.25},
+        {3LL, std::string("Carla"), std::monostate{}, 8.0},
+        {4LL, std::string("Dan"), 29LL, std::monostate{}},
+        {5LL, std::monostate{}, 52LL, 6.5},
+        {6LL, std::string("Alan"), 41LL, 9.0}
+    };
+}
+
+} // anonymous namespace
+
+class PredicateTest : public ::testing::Test {
+protected:
+    // IDs of the rows matching `where`, or {-1} when it doesn't compile
+    std::vector<long long> ids(const std::string& where, std::vector<CellValue> params = {}) {
+        Predicate predicate;
+        std::string sqlstate, error;
+        if (!predicate.compile(where, table, params, 1, sqlstate, error)) {
+            last_sqlstate = sqlstate;
+            return {-1};
+        }
+        RowSource source;
+        source.rows = &rows;
+        std::vector<long long> result;
+        for (uint32_t r : predicate.scan(source)) {
+            result.push_back(std::get<long long>(rows[r][0]));
+        }
+        return result;
+    }
+
+    MockTable table = people_table();
+    std::vector<MockRow> rows = people_rows();
+    std::string last_sqlstate;
+};
+
+using Ids = std::vector<long long>;
+
+TEST_F(PredicateTest, Comparisons) {
+    EXPECT_EQ(ids("ID = 3"), Ids({3}));
+    EXPECT_EQ(ids("AGE > 40"), Ids({2, 5, 6}));
+    EXPECT_EQ(ids("AGE <= 36"), Ids({1, 4}));
+    EXPECT_EQ(ids("AGE <> 41"), Ids({1, 4, 5}));
+    EXPECT_EQ(ids("AGE != 41"), Ids({1, 4, 5}));
+    EXPECT_EQ(ids("40 < AGE"), Ids({2, 5, 6}));
+    EXPECT_EQ(ids("SCORE >= 9"), Ids({1, 6}));
+    EXPECT_EQ(ids("NAME = 'Dan'"), Ids({4}));
+    EXPECT_EQ(ids("people.ID = 2"), Ids({2}));
+    EXPECT_EQ(ids("AGE = -1"), Ids({}));
+}
+
+TEST_F(PredicateTest, AndOrNotAndParentheses) {
+    EXPECT_EQ(ids("AGE = 41 AND NAME = 'Alan'"), Ids({6}));
+    EXPECT_EQ(ids("ID = 1 OR ID = 4 OR NAME = 'Brian'"), Ids({1, 2, 4}));
+    EXPECT_EQ(ids("(ID = 1 OR ID = 2) AND SCORE > 8"), Ids({1}));
+    EXPECT_EQ(ids("ID = 1 OR ID = 2 AND SCORE > 8"), Ids({1}));
+    EXPECT_EQ(ids("NOT (ID = 1 OR ID = 2)"), Ids({3, 4, 5, 6}));
+    EXPECT_EQ(ids("NOT AGE > 40"), Ids({1, 4}));
+}
+
+TEST_F(PredicateTest, BetweenInLikeIsNull) {
+    EXPECT_EQ(ids("AGE BETWEEN 30 AND 41"), Ids({1, 2, 6}));
+    EXPECT_EQ(ids("AGE NOT BETWEEN 30 AND 41"), Ids({4, 5}));
+    EXPECT_EQ(ids("ID IN (2, 4, 9)"), Ids({2, 4}));
+    EXPECT_EQ(ids("NAME NOT IN ('Ada', 'Dan')"), Ids({2, 3, 6}));
+    EXPECT_EQ(ids("NAME LIKE 'A%'"), Ids({1, 6}));
+    EXPECT_EQ(ids("NAME LIKE '_a%'"), Ids({3, 4}));
+    EXPECT_EQ(ids("NAME NOT LIKE '%r%'"), Ids({1, 4, 6}));
+    EXPECT_EQ(ids("AGE IS NULL"), Ids({3}));
+    EXPECT_EQ(ids("NAME IS NOT NULL AND SCORE IS NULL"), Ids({4}));
+}
+
+TEST_F(PredicateTest, NullNeverMatches) {
+    // Rows with a NULL AGE are in neither result
+    EXPECT_EQ(ids("AGE = 41 OR AGE <> 41"), Ids({1, 2, 4, 5, 6}));
+    EXPECT_EQ(ids("NOT (AGE = 41)"), Ids({1, 4, 5}));
+    EXPECT_EQ(ids("AGE = NULL"), Ids({}));
+    EXPECT_EQ(ids("ID NOT IN (1, NULL)"), Ids({}));
+}
+
+TEST_F(PredicateTest, NotOfUnknownIsUnknown) {
+    // NULL = 1 folds to unknown, which NOT leaves unknown
+    EXPECT_EQ(ids("NOT (NULL = 1)"), Ids({}));
+    EXPECT_EQ(ids("NOT (ID = 1 OR NULL = 1)"), Ids({}));
+    EXPECT_EQ(ids("NOT (ID = 1 AND NULL = 1)"), Ids({2, 3, 4, 5, 6}));
+    EXPECT_EQ(ids("NULL = 1 OR ID = 2"), Ids({2}));
+    EXPECT_EQ(ids("NOT (1 IN (2, NULL))"), Ids({}));
+    EXPECT_EQ(ids("NOT (1 = 0)"), Ids({1, 2, 3, 4, 5, 6}));
+    EXPECT_EQ(ids("NOT (NULL IS NULL)"), Ids({}));
+}
+
+TEST_F(PredicateTest, ConstantsAndParameters) {
+    EXPECT_EQ(ids("1=0"), Ids({}));
+    EXPECT_EQ(ids("1 = 1 AND ID < 3"), Ids({1, 2}));
+    EXPECT_EQ(ids("ID = ?", {4LL}), Ids({4}));
+    // Text bound against an integer column compares as a number
+    EXPECT_EQ(ids("ID = ? OR NAME = ?", {std::string("5"), std::string("Ada")}), Ids({1, 5}));
+    EXPECT_EQ(ids("AGE BETWEEN ? AND ?", {30LL, 40LL}), Ids({1}));
+    EXPECT_EQ(ids("ID = ?"), Ids({}));   // Unbound marker is NULL
+}
+
+TEST_F(PredicateTest, Errors) {
+    EXPECT_EQ(ids("MISSING = 1"), Ids({-1}));
+    EXPECT_EQ(last_sqlstate, "42S22");
+    EXPECT_EQ(ids("ID = "), Ids({-1}));
+    EXPECT_EQ(last_sqlstate, "42000");
+    EXPECT_EQ(ids("ID = 'abc"), Ids({-1}));
+    EXPECT_EQ(ids("(ID = 1"), Ids({-1}));
+    EXPECT_EQ(ids("ID = 1 ID = 2"), Ids({-1}));
+}
+
+TEST_F(PredicateTest, KeyConditions) {
+    Predicate predicate;
+    std::string sqlstate, error;
+    ASSERT_TRUE(predicate.compile("ID = 3 AND AGE BETWEEN 1 AND 9 AND NAME <> 'x'", table, {}, 1,
+                                  sqlstate, error));
+    ASSERT_EQ(predicate.key_conditions().size(), 2u);
+    EXPECT_FALSE(predicate.key_conditions()[0].is_range());
+    EXPECT_TRUE(predicate.key_conditions()[1].is_range());
+
+    // Nothing an index can answer under OR
+    ASSERT_TRUE(predicate.compile("ID = 3 OR AGE = 1", table, {}, 1, sqlstate, error));
+    EXPECT_TRUE(predicate.key_conditions().empty());
+}
+
+TEST(TableIndexTest, HashAndSortedLookups) {
+    std::vector<MockRow> rows;
+    for (long long i = 0; i < 1000; ++i) {
+        rows.push_back({(i * 7919) % 1000, i % 10 == 0 ? CellValue{} : CellValue{i % 50}});
+    }
+    RowSource source;
+    source.rows = &rows;
+
+    TableIndex hash("H", 0, TableIndex::Kind::Hash);
+    TableIndex sorted("S", 1, TableIndex::Kind::Sorted);
+    hash.catch_up(source);
+    sorted.catch_up(source);
+
+    KeyCondition point;
+    point.column = 0;
+    point.keys = {CellValue{123LL}, CellValue{std::string("456")}, CellValue{123.0}};
+    std::vector<uint32_t> found;
+    ASSERT_TRUE(hash.lookup(point, found));
+    ASSERT_EQ(found.size(), 2u);
+    for (uint32_t r : found) {
+        long long key = std::get<long long>(rows[r][0]);
+        EXPECT_TRUE(key == 123 || key == 456);
+    }
+
+    KeyCondition range;
+    range.column = 1;
+    range.low = CellValue{11LL};
+    range.high = CellValue{13LL};
+    range.high_inclusive = false;
+    EXPECT_FALSE(hash.lookup(range, found));
+    ASSERT_TRUE(sorted.lookup(range, found));
+    EXPECT_TRUE(std::is_sorted(found.begin(), found.end()));
+    EXPECT_EQ(found.size(), 40u);   // 11 and 12, 20 rows each
+
+    // Rows appended out of order are picked up by catch_up
+    rows.push_back({5000LL, 11LL});
+    rows.push_back({5001LL, 1LL});
+    hash.catch_up(source);
+    sorted.catch_up(source);
+    EXPECT_EQ(sorted.indexed_rows(), rows.size());
+    ASSERT_TRUE(sorted.lookup(range, found));
+    EXPECT_EQ(found.size(), 41u);
+    EXPECT_EQ(found.back(), 1000u);
+    point.keys = {CellValue{5001LL}};
+    ASSERT_TRUE(hash.lookup(point, found));
+    EXPECT_EQ(found, std::vector<uint32_t>({1001}));
+}
+
+class WhereClauseTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        ASSERT_EQ(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &henv), SQL_SUCCESS);
+        SQLSetEnvAttr(henv, SQL_ATTR_ODBC_VERSION, (SQLPOINTER)SQL_OV_ODBC3, 0);
+        SQLAllocHandle(SQL_HANDLE_DBC, henv, &hdbc);
+        ASSERT_TRUE(SQL_SUCCEEDED(SQLDriverConnect(hdbc, NULL,
+            (SQLCHAR*)"Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;", SQL_NTS,
+            NULL, 0, NULL, SQL_DRIVER_NOPROMPT)));
+        SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &hstmt);
+    }
+
+    void TearDown() override {
+        SQLFreeHandle(SQL_HANDLE_STMT, hstmt);
+        SQLDisconnect(hdbc);
+        SQLFreeHandle(SQL_HANDLE_DBC, hdbc);
+        SQLFreeHandle(SQL_HANDLE_ENV, henv);
+    }
+
+    SQLRETURN exec(const std::string& sql) {
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return SQLExecDirect(hstmt, (SQLCHAR*)sql.c_str(), SQL_NTS);
+    }
+
+    // First column of every row, as integers
+    std::vector<long long> column_values(const std::string& sql) {
+        std::vector<long long> values;
+        EXPECT_TRUE(SQL_SUCCEEDED(exec(sql))) << sql;
+        SQLBIGINT v = 0;
+        SQLLEN ind = 0;
+        while (SQLFetch(hstmt) == SQL_SUCCESS) {
+            SQLGetData(hstmt, 1, SQL_C_SBIGINT, &v, 0, &ind);
+            values.push_back(ind == SQL_NULL_DATA ? -1 : v);
+        }
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return values;
+    }
+
+    // Insert rows (ID, GRP, NAME) = (i, i % 100, 'name<i>') for i in [0, count)
+    void fill_items(int count) {
+        ASSERT_TRUE(SQL_SUCCEEDED(exec(
+            "CREATE TABLE ITEMS (ID INTEGER PRIMARY KEY, GRP INTEGER NOT NULL, NAME VARCHAR(16))")));
+        const int batch = 10000;
+        std::vector<SQLINTEGER> id(batch), grp(batch);
+        std::vector<char> name(batch * 16);
+        std::vector<SQLLEN> name_ind(batch, SQL_NTS);
+        ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"INSERT INTO ITEMS (ID, GRP, NAME) VALUES (?, ?, ?)", SQL_NTS),
+                  SQL_SUCCESS);
+        SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, id.data(), 0, NULL);
+        SQLBindParameter(hstmt, 2, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, grp.data(), 0, NULL);
+        SQLBindParameter(hstmt, 3, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR, 16, 0, name.data(), 16,
+                         name_ind.data());
+        for (int start = 0; start < count; start += batch) {
+            int n = std::min(batch, count - start);
+            for (int i = 0; i < n; ++i) {
+                id[i] = start + i;
+                grp[i] = (start + i) % 100;
+                std::snprintf(&name[i * 16], 16, "name%d", start + i);
+            }
+            SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(intptr_t)n, 0);
+            ASSERT_EQ(SQLExecute(hstmt), SQL_SUCCESS);
+        }
+        SQLFreeStmt(hstmt, SQL_RESET_PARAMS);
+        SQLSetStmtAttr(hstmt, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)1, 0);
+    }
+
+    SQLHENV henv = SQL_NULL_HENV;
+    SQLHDBC hdbc = SQL_NULL_HDBC;
+    SQLHSTMT hstmt = SQL_NULL_HSTMT;
+};
+
+TEST_F(WhereClauseTest, FiltersStoredRows) {
+    fill_items(1000);
+    EXPECT_EQ(column_values("SELECT ID FROM ITEMS WHERE ID = 42"), std::vector<long long>({42}));
+    EXPECT_EQ(column_values("SELECT ID FROM ITEMS WHERE ID IN (7, 3, 999) ORDER BY ID"),
+              std::vector<long long>({3, 7, 999}));
+    EXPECT_EQ(column_values("SELECT ID FROM ITEMS WHERE GRP = 5 AND ID < 300"),
+              std::vector<long long>({5, 105, 205}));
+    EXPECT_EQ(column_values("SELECT ID FROM ITEMS WHERE NAME LIKE 'name99_' OR ID = 1"),
+              std::vector<long long>({1, 990, 991, 992, 993, 994, 995, 996, 997, 998, 999}));
+    EXPECT_EQ(column_values("SELECT COUNT(*) FROM ITEMS WHERE GRP BETWEEN 10 AND 19"),
+              std::vector<long long>({100}));
+    EXPECT_EQ(column_values("SELECT COUNT(*) FROM ITEMS WHERE 1=0"), std::vector<long long>({0}));
+}
+
+TEST_F(WhereClauseTest, ErrorsReportSqlState) {
+    fill_items(10);
+    EXPECT_EQ(exec("SELECT ID FROM ITEMS WHERE NOPE = 1"), SQL_ERROR);
+    SQLCHAR state[6] = {0};
+    SQLINTEGER native = 0;
+    SQLSMALLINT len = 0;
+    SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, state, &native, NULL, 0, &len);
+    EXPECT_STREQ(reinterpret_cast<char*>(state), "42S22");
+
+    EXPECT_EQ(exec("SELECT ID FROM ITEMS WHERE ID = = 1"), SQL_ERROR);
+    SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, state, &native, NULL, 0, &len);
+    EXPECT_STREQ(reinterpret_cast<char*>(state), "42000");
+}
+
+TEST_F(WhereClauseTest, CreateAndDropIndex) {
+    fill_items(500);
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("CREATE INDEX IX_ITEMS_GRP ON ITEMS (GRP)")));
+    EXPECT_EQ(exec("CREATE INDEX IX_ITEMS_GRP ON ITEMS (NAME)"), SQL_ERROR);
+    EXPECT_EQ(exec("CREATE INDEX IX_BAD ON ITEMS (NOPE)"), SQL_ERROR);
+
+    // Range answered by the sorted index, rows still in table order
+    EXPECT_EQ(column_values("SELECT ID FROM ITEMS WHERE GRP >= 98 AND ID < 300"),
+              std::vector<long long>({98, 99, 198, 199, 298, 299}));
+
+    // Rows inserted after the index was built are found too
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO ITEMS (ID, GRP, NAME) VALUES (5000, 99, 'late')")));
+    EXPECT_EQ(column_values("SELECT COUNT(*) FROM ITEMS WHERE GRP = 99"), std::vector<long long>({6}));
+
+    // SQLStatistics reports the index
+    ASSERT_TRUE(SQL_SUCCEEDED(SQLStatistics(hstmt, NULL, 0, NULL, 0, (SQLCHAR*)"ITEMS", SQL_NTS,
+                                            SQL_INDEX_ALL, SQL_QUICK)));
+    bool listed = false;
+    char name[64];
+    SQLLEN ind = 0;
+    while (SQLFetch(hstmt) == SQL_SUCCESS) {
+        if (SQL_SUCCEEDED(SQLGetData(hstmt, 6, SQL_C_CHAR, name, sizeof(name), &ind)) &&
+            ind != SQL_NULL_DATA && std::string(name) == "IX_ITEMS_GRP") {
+            listed = true;
+        }
+    }
+    EXPECT_TRUE(listed);
+
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("DROP INDEX IX_ITEMS_GRP")));
+    EXPECT_EQ(exec("DROP INDEX IX_ITEMS_GRP"), SQL_ERROR);
+    EXPECT_EQ(column_values("SELECT COUNT(*) FROM ITEMS WHERE GRP = 99"), std::vector<long long>({6}));
+}
+
+TEST_F(WhereClauseTest, RollbackKeepsIndexedCommittedRows) {
+    fill_items(100);
+    EXPECT_EQ(column_values("SELECT ID FROM ITEMS WHERE ID = 50"), std::vector<long long>({50}));
+    SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0);
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("INSERT INTO ITEMS (ID, GRP, NAME) VALUES (1000, 1, 'x')")));
+    ASSERT_TRUE(SQL_SUCCEEDED(exec("DELETE FROM ITEMS WHERE ID = 50")));
+    EXPECT_EQ(column_values("SELECT ID FROM ITEMS WHERE ID = 1000"), std::vector<long long>({1000}));
+    EXPECT_EQ(column_values("SELECT ID FROM ITEMS WHERE ID = 50"), std::vector<long long>({}));
+    ASSERT_EQ(SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_ROLLBACK), SQL_SUCCESS);
+    EXPECT_EQ(column_values("SELECT ID FROM ITEMS WHERE ID = 50"), std::vector<long long>({50}));
+    EXPECT_EQ(column_values("SELECT ID FROM ITEMS WHERE ID = 1000"), std::vector<long long>({}));
+}
+
+TEST_F(WhereClauseTest, PreparedPointLookupThroughput) {
+    const int total = 200000;
+    fill_items(total);
+
+    SQLINTEGER key = 0, found_id = 0;
+    SQLLEN found_ind = 0;
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"SELECT ID, NAME FROM ITEMS WHERE ID = ?", SQL_NTS), SQL_SUCCESS);
+    SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &key, 0, NULL);
+    SQLBindCol(hstmt, 1, SQL_C_SLONG, &found_id, 0, &found_ind);
+
+    const int lookups = 20000;
+    int hits = 0;
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < lookups; ++i) {
+        key = static_cast<SQLINTEGER>((i * 7919LL) % total);
+        ASSERT_EQ(SQLExecute(hstmt), SQL_SUCCESS);
+        while (SQLFetch(hstmt) == SQL_SUCCESS) {
+            if (found_id == key) ++hits;
+        }
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
+
+    std::cout << lookups << " primary key lookups on " << total << " rows in " << duration.count()
+              << "ms (" << (lookups / std::max<double>(duration.count(), 1.0)) << "K lookups/s)\n";
+    EXPECT_EQ(hits, lookups);
+    // A scan per lookup would take minutes; the hash index keeps this short
+    EXPECT_LT(duration.count(), 5000) << "Primary key lookups too slow";
+}
+
+TEST_F(WhereClauseTest, PreparedQueryReusedAcrossExecutions) {
+    fill_items(10);
+    ASSERT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"SELECT COUNT(*) FROM ITEMS WHERE ID >= ?", SQL_NTS), SQL_SUCCESS);
+    SQLINTEGER low = 5;
+    SQLBindParameter(hstmt, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &low, 0, NULL);
+    auto count = [&] {
+        SQLBIGINT v = -1;
+        SQLLEN ind = 0;
+        EXPECT_EQ(SQLExecute(hstmt), SQL_SUCCESS);
+        EXPECT_EQ(SQLFetch(hstmt), SQL_SUCCESS);
+        SQLGetData(hstmt, 1, SQL_C_SBIGINT, &v, 0, &ind);
+        SQLFreeStmt(hstmt, SQL_CLOSE);
+        return v;
+    };
+    EXPECT_EQ(count(), 5);
+
+    // Each execution sees the current parameter and the current rows
+    low = 8;
+    EXPECT_EQ(count(), 2);
+    SQLHSTMT other = SQL_NULL_HSTMT;
+    SQLAllocHandle(SQL_HANDLE_STMT, hdbc, &other);
+    ASSERT_EQ(SQLExecDirect(other, (SQLCHAR*)"INSERT INTO ITEMS (ID, GRP, NAME) VALUES (50, 0, 'x')",
+                            SQL_NTS), SQL_SUCCESS);
+    SQLFreeHandle(SQL_HANDLE_STMT, other);
+    EXPECT_EQ(count(), 3);
+
+    // A failed prepare leaves nothing to execute
+    EXPECT_EQ(SQLPrepare(hstmt, (SQLCHAR*)"UPDATE ITEMS", SQL_NTS), SQL_ERROR);
+    EXPECT_EQ(SQLExecute(hstmt), SQL_ERROR);
+    SQLCHAR state[6] = {0};
+    SQLINTEGER native = 0;
+    SQLSMALLINT len = 0;
+    SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1, state, &native, NULL, 0, &len);
+    EXPECT_STREQ(reinterpret_cast<char*>(state), "HY010");
+}
@@ -0,0 +1,320 @@
+#include "alloc_profiler.hpp"
+
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+// Sanitizers install their own malloc; leave it alone under them.
+#if defined(__SANITIZE_ADDRESS__) || defined(__SANITIZE_THREAD__)
+#define ODBC_CRUSHER_NO_MALLOC_HOOKS 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer) || __has_feature(thread_sanitizer) || __has_feature(memory_sanitizer)
+#define ODBC_CRUSHER_NO_MALLOC_HOOKS 1
+#endif
+#endif
+
+#if defined(__GLIBC__) && !defined(ODBC_CRUSHER_NO_MALLOC_HOOKS)
+#define ODBC_CRUSHER_MALLOC_HOOKS 1
+#include <malloc.h>
+#endif
+
+namespace odbc_crusher::core {
+
+namespace {
+
+// Counters live in plain arrays of atomics: the hooks run inside malloc and
+// must never allocate themselves.
+struct Counters {
+    std::atomic<uint64_t> allocations{0};
+    std::atomic<uint64_t> deallocations{0};
+    std::atomic<uint64_t> bytes_allocated{0};
+    std::atomic<uint64_t> bytes_freed{0};
+    std::atomic<uint64_t> rows_fetched{0};
+
+    AllocStats load() const noexcept {
+        AllocStats s;
+        s.allocations = allocations.load(std::memory_order_relaxed);
+        s.deallocations = deallocations.load(std::memory_order_relaxed);
+        s.bytes_allocated = bytes_allocated.load(std::memory_order_relaxed);
+        s.bytes_freed = bytes_freed.load(std::memory_order_relaxed);
+        s.rows_fetched = rows_fetched.load(std::memory_order_relaxed);
+        return s;
+    }
+
+    void clear() noexcept {
+        allocations.store(0, std::memory_order_relaxed);
+        deallocations.store(0, std::memory_order_relaxed);
+        bytes_allocated.store(0, std::memory_order_relaxed);
+        bytes_freed.store(0, std::memory_order_relaxed);
+        rows_fetched.store(0, std::memory_order_relaxed);
+    }
+};
+
+struct CallSlot {
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> calls{0};
+    Counters counters;
+};
+
+constexpr int kMaxCallSlots = 64;
+
+std::atomic<bool> g_enabled{false};
+Counters g_totals;
+CallSlot g_slots[kMaxCallSlots];
+std::atomic<int> g_slot_count{0};
+std::mutex g_slot_mutex;
+
+thread_local int t_current_slot = -1;
+
+// Checked by the hooks before they size a block, so an unprofiled run pays
+// one branch per call
+inline bool recording() noexcept {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+inline void record_alloc(size_t bytes) noexcept {
+    if (!recording()) return;
+    g_totals.allocations.fetch_add(1, std::memory_order_relaxed);
+    g_totals.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+    int slot = t_current_slot;
+    if (slot >= 0) {
+        g_slots[slot].counters.allocations.fetch_add(1, std::memory_order_relaxed);
+        g_slots[slot].counters.bytes_allocated.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+inline void record_free(size_t bytes) noexcept {
+    if (!recording()) return;
+    g_totals.deallocations.fetch_add(1, std::memory_order_relaxed);
+    g_totals.bytes_freed.fetch_add(bytes, std::memory_order_relaxed);
+    int slot = t_current_slot;
+    if (slot >= 0) {
+        g_slots[slot].counters.deallocations.fetch_add(1, std::memory_order_relaxed);
+        g_slots[slot].counters.bytes_freed.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+// Find the slot for a function name, claiming a new one on first use.
+// Returns -1 once every slot is taken.
+int find_or_claim_slot(const char* function) noexcept {
+    int count = g_slot_count.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        const char* name = g_slots[i].name.load(std::memory_order_relaxed);
+        if (name == function || std::strcmp(name, function) == 0) return i;
+    }
+
+    std::lock_guard<std::mutex> lock(g_slot_mutex);
+    count = g_slot_count.load(std::memory_order_relaxed);
+    for (int i = 0; i < count; ++i) {
+        if (std::strcmp(g_slots[i].name.load(std::memory_order_relaxed), function) == 0) return i;
+    }
+    if (count >= kMaxCallSlots) return -1;
+    g_slots[count].name.store(function, std::memory_order_relaxed);
+    g_slot_count.store(count + 1, std::memory_order_release);
+    return count;
+}
+
+} // anonymous namespace
+
+AllocStats AllocStats::operator-(const AllocStats& start) const noexcept {
+    AllocStats d;
+    d.allocations = allocations - start.allocations;
+    d.deallocations = deallocations - start.deallocations;
+    d.bytes_allocated = bytes_allocated - start.bytes_allocated;
+    d.bytes_freed = bytes_freed - start.bytes_freed;
+    d.rows_fetched = rows_fetched - start.rows_fetched;
+    return d;
+}
+
+void AllocProfiler::set_enabled(bool enabled) noexcept {
+    g_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool AllocProfiler::enabled() noexcept {
+    return g_enabled.load(std::memory_order_relaxed);
+}
+
+bool AllocProfiler::sees_driver_allocations() noexcept {
+#ifdef ODBC_CRUSHER_MALLOC_HOOKS
+    return true;
+#elif defined(_WIN32)
+    return false;
+#else
+    // Replaced operator new is picked up by shared objects that use the
+    // same C++ runtime through symbol interposition.
+    return true;
+#endif
+}
+
+AllocStats AllocProfiler::snapshot() noexcept {
+    return g_totals.load();
+}
+
+void AllocProfiler::add_rows_fetched(uint64_t rows) noexcept {
+    if (!enabled()) return;
+    g_totals.rows_fetched.fetch_add(rows, std::memory_order_relaxed);
+    int slot = t_current_slot;
+    if (slot >= 0) {
+        g_slots[slot].counters.rows_fetched.fetch_add(rows, std::memory_order_relaxed);
+    }
+}
+
+std::vector<CallAllocStats> AllocProfiler::per_call_stats() {
+    std::vector<CallAllocStats> out;
+    int count = g_slot_count.load(std::memory_order_acquire);
+    out.reserve(static_cast<size_t>(count));
+    for (int i = 0; i < count; ++i) {
+        CallAllocStats entry;
+        entry.function = g_slots[i].name.load(std::memory_order_relaxed);
+        entry.calls = g_slots[i].calls.load(std::memory_order_relaxed);
+        entry.stats = g_slots[i].counters.load();
+        out.push_back(std::move(entry));
+    }
+    return out;
+}
+
+void AllocProfiler::reset() noexcept {
+    g_totals.clear();
+    int count = g_slot_count.load(std::memory_order_acquire);
+    for (int i = 0; i < count; ++i) {
+        g_slots[i].calls.store(0, std::memory_order_relaxed);
+        g_slots[i].counters.clear();
+    }
+}
+
+AllocProfiler::CallScope::CallScope(const char* function) noexcept
+    : previous_slot_(t_current_slot) {
+    if (!enabled()) return;
+    int slot = find_or_claim_slot(function);
+    if (slot >= 0) {
+        g_slots[slot].calls.fetch_add(1, std::memory_order_relaxed);
+        t_current_slot = slot;
+    }
+}
+
+AllocProfiler::CallScope::~CallScope() {
+    t_current_slot = previous_slot_;
+}
+
+} // namespace odbc_crusher::core
+
+// ---------------------------------------------------------------------------
+// Allocation hooks
+// ---------------------------------------------------------------------------
+
+#ifdef ODBC_CRUSHER_MALLOC_HOOKS
+
+// Interpose the malloc family. Definitions in the executable take precedence
+// over libc for every shared object in the process, including the ODBC driver
+// manager and the driver itself. Sizes are taken from malloc_usable_size() so
+// alloc and free of the same block always agree.
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t count, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void* ptr);
+
+void* malloc(size_t size) noexcept {
+    void* p = __libc_malloc(size);
+    if (p && odbc_crusher::core::recording()) odbc_crusher::core::record_alloc(malloc_usable_size(p));
+    return p;
+}
+
+void* calloc(size_t count, size_t size) noexcept {
+    void* p = __libc_calloc(count, size);
+    if (p && odbc_crusher::core::recording()) odbc_crusher::core::record_alloc(malloc_usable_size(p));
+    return p;
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+    if (!odbc_crusher::core::recording()) return __libc_realloc(ptr, size);
+    size_t old_size = ptr ? malloc_usable_size(ptr) : 0;
+    void* p = __libc_realloc(ptr, size);
+    if (p || size == 0) {
+        if (ptr) odbc_crusher::core::record_free(old_size);
+        if (p) odbc_crusher::core::record_alloc(malloc_usable_size(p));
+    }
+    return p;
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+    void* p = __libc_memalign(alignment, size);
+    if (p && odbc_crusher::core::recording()) odbc_crusher::core::record_alloc(malloc_usable_size(p));
+    return p;
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+    return memalign(alignment, size);
+}
+
+int posix_memalign(void** out, size_t alignment, size_t size) noexcept {
+    if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) return EINVAL;
+    void* p = memalign(alignment, size);
+    if (!p) return ENOMEM;
+    *out = p;
+    return 0;
+}
+
+void free(void* ptr) noexcept {
+    if (!ptr) return;
+    if (odbc_crusher::core::recording()) odbc_crusher::core::record_free(malloc_usable_size(ptr));
+    __libc_free(ptr);
+}
+} // extern "C"
+
+#else
+
+// Replace the global (non-aligned) operator new/delete. Each block carries a
+// small header with its size so unsized deletes can be accounted for.
+namespace {
+
+constexpr size_t kHeaderSize = alignof(std::max_align_t);
+
+void* counted_new(size_t size) noexcept {
+    void* raw = std::malloc(size + kHeaderSize);
+    if (!raw) return nullptr;
+    *static_cast<size_t*>(raw) = size;
+    odbc_crusher::core::record_alloc(size);
+    return static_cast<char*>(raw) + kHeaderSize;
+}
+
+void counted_delete(void* ptr) noexcept {
+    if (!ptr) return;
+    void* raw = static_cast<char*>(ptr) - kHeaderSize;
+    odbc_crusher::core::record_free(*static_cast<size_t*>(raw));
+    std::free(raw);
+}
+
+void* counted_new_or_throw(size_t size) {
+    if (size == 0) size = 1;
+    for (;;) {
+        if (void* p = counted_new(size)) return p;
+        std::new_handler handler = std::get_new_handler();
+        if (!handler) throw std::bad_alloc();
+        handler();
+    }
+}
+
+} // anonymous namespace
+
+void* operator new(size_t size) { return counted_new_or_throw(size); }
+void* operator new[](size_t size) { return counted_new_or_throw(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept {
+    try { return counted_new_or_throw(size); } catch (...) { return nullptr; }
+}
+void* operator new[](size_t size, const std::nothrow_t&) noexcept {
+    try { return counted_new_or_throw(size); } catch (...) { return nullptr; }
+}
+void operator delete(void* ptr) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { counted_delete(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { counted_delete(ptr); }
+
+#endif
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace odbc_crusher::core {
+
+// Allocation counters over a window (one test, one ODBC call type, ...)
+struct AllocStats {
+    uint64_t allocations = 0;
+    uint64_t deallocations = 0;
+    uint64_t bytes_allocated = 0;
+    uint64_t bytes_freed = 0;
+    uint64_t rows_fetched = 0;      // Rows fetched through OdbcStatement::fetch()
+
+    // Bytes allocated in the window and not freed in the window
+    int64_t retained_bytes() const noexcept {
+        return static_cast<int64_t>(bytes_allocated) - static_cast<int64_t>(bytes_freed);
+    }
+
+    // Allocations per fetched row, or 0.0 when no rows were fetched
+    double allocations_per_row() const noexcept {
+        return rows_fetched > 0
+            ? static_cast<double>(allocations) / static_cast<double>(rows_fetched)
+            : 0.0;
+    }
+
+    // Difference between two snapshots (this = end, start = beginning of window)
+    AllocStats operator-(const AllocStats& start) const noexcept;
+};
+
+// Allocation totals attributed to one ODBC function
+struct CallAllocStats {
+    std::string function;
+    uint64_t calls = 0;
+    AllocStats stats;
+};
+
+// Opt-in allocation profiler for the crusher process (--profile-allocations).
+//
+// On glibc the malloc family is interposed process-wide, so allocations made
+// inside the driver under test are counted whether it is written in C or C++.
+// On other platforms the global operator new/delete are replaced instead, which
+// only sees C++ allocations routed through the crusher's own runtime (on
+// Windows the driver DLL has its own heap and is therefore not counted).
+//
+// While disabled the hooks cost one relaxed atomic load per allocation.
+class AllocProfiler {
+public:
+    static void set_enabled(bool enabled) noexcept;
+    static bool enabled() noexcept;
+
+    // True when allocations made inside the driver are visible to the hooks
+    static bool sees_driver_allocations() noexcept;
+
+    // Process-wide totals since the last reset()
+    static AllocStats snapshot() noexcept;
+
+    // Record rows fetched; attributed to the active CallScope, if any
+    static void add_rows_fetched(uint64_t rows) noexcept;
+
+    // Totals per ODBC function, in first-seen order
+    static std::vector<CallAllocStats> per_call_stats();
+
+    static void reset() noexcept;
+
+    // Attributes allocations on the current thread to an ODBC function while
+    // in scope. Scopes nest; the innermost one wins. The name must have static
+    // storage duration (a string literal) since only the pointer is kept.
+    class CallScope {
+    public:
+        explicit CallScope(const char* function) noexcept;
+        ~CallScope();
+
+        CallScope(const CallScope&) = delete;
+        CallScope& operator=(const CallScope&) = delete;
+
+    private:
+        int previous_slot_;
+    };
+};
+
+} // namespace odbc_crusher::core
@@ -1,5 +1,6 @@
 #include "odbc_connection.hpp"
 #include "odbc_error.hpp"
+#include "alloc_profiler.hpp"
 
 namespace odbc_crusher::core {
 
@@ -31,6 +32,7 @@ void OdbcConnection::connect(std::string_view connection_string) {
     SQLCHAR out_conn_str[1024];
     SQLSMALLINT out_conn_str_len;
     
+    AllocProfiler::CallScope scope("SQLDriverConnect");
     SQLRETURN ret = SQLDriverConnect(
         handle_,
         nullptr,  // No window handle
@@ -44,6 +46,7 @@ void OdbcConnection::connect(std::string_view connection_string) {
     
     check_odbc_result(ret, SQL_HANDLE_DBC, handle_, "SQLDriverConnect");
     connected_ = true;
+    connection_string_ = connection_string;
 }
 
 void OdbcConnection::disconnect() {
@@ -51,6 +54,7 @@ void OdbcConnection::disconnect() {
         return;
     }
     
+    AllocProfiler::CallScope scope("SQLDisconnect");
     SQLRETURN ret = SQLDisconnect(handle_);
     check_odbc_result(ret, SQL_HANDLE_DBC, handle_, "SQLDisconnect");
     connected_ = false;
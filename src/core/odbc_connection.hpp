@@ -25,10 +25,14 @@ public:
     SQLHDBC get_handle() const noexcept { return handle_; }
     OdbcEnvironment& get_environment() const noexcept { return env_; }
     
+    // The string passed to connect(), for tests that open more connections
+    const std::string& connection_string() const noexcept { return connection_string_; }
+    
 private:
     SQLHDBC handle_ = SQL_NULL_HDBC;
     OdbcEnvironment& env_;
     bool connected_ = false;
+    std::string connection_string_;
 };
 
 } // namespace odbc_crusher::core
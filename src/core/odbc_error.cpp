@@ -4,7 +4,7 @@
 
 namespace odbc_crusher::core {
 
-OdbcError OdbcError::from_handle(SQLSMALLINT handle_type, SQLHANDLE handle, const std::string& context) {
+std::vector<OdbcDiagnostic> read_diagnostics(SQLSMALLINT handle_type, SQLHANDLE handle) {
     std::vector<OdbcDiagnostic> diagnostics;
     
     SQLSMALLINT rec = 1;
@@ -26,8 +26,22 @@ OdbcError OdbcError::from_handle(SQLSMALLINT handle_type, SQLHANDLE handle, cons
         rec++;
     }
     
-    std::string error_msg = context.empty() ? "ODBC error" : context;
-    return OdbcError(error_msg, std::move(diagnostics));
+    return diagnostics;
+}
+
+SqlState SqlState::from_handle(SQLSMALLINT handle_type, SQLHANDLE handle, SQLSMALLINT record) noexcept {
+    SQLCHAR state[6] = {0};
+    SQLINTEGER native = 0;
+    SQLSMALLINT len = 0;
+    if (!SQL_SUCCEEDED(SQLGetDiagRec(handle_type, handle, record, state, &native, nullptr, 0, &len))) {
+        return SqlState();
+    }
+    return SqlState(reinterpret_cast<const char*>(state));
+}
+
+OdbcError OdbcError::from_handle(SQLSMALLINT handle_type, SQLHANDLE handle, std::string_view context) {
+    std::string error_msg = context.empty() ? "ODBC error" : std::string(context);
+    return OdbcError(error_msg, read_diagnostics(handle_type, handle));
 }
 
 OdbcError::OdbcError(const std::string& message)
@@ -50,7 +64,31 @@ std::string OdbcError::format_diagnostics() const {
     return oss.str();
 }
 
-void check_odbc_result(SQLRETURN ret, SQLSMALLINT handle_type, SQLHANDLE handle, const std::string& context) {
+const SqlState& OdbcResult::sqlstate() const {
+    if (!sqlstate_) {
+        if (diagnostics_ && !diagnostics_->empty()) {
+            sqlstate_ = SqlState(diagnostics_->front().sqlstate.c_str());
+        } else {
+            sqlstate_ = SqlState::from_handle(handle_type_, handle_);
+        }
+    }
+    return *sqlstate_;
+}
+
+const std::vector<OdbcDiagnostic>& OdbcResult::diagnostics() const {
+    if (!diagnostics_) {
+        diagnostics_ = read_diagnostics(handle_type_, handle_);
+    }
+    return *diagnostics_;
+}
+
+void OdbcResult::throw_if_error(std::string_view context) const {
+    if (ok()) return;
+    std::string error_msg = context.empty() ? "ODBC error" : std::string(context);
+    throw OdbcError(error_msg, diagnostics());
+}
+
+void check_odbc_result(SQLRETURN ret, SQLSMALLINT handle_type, SQLHANDLE handle, std::string_view context) {
     if (!SQL_SUCCEEDED(ret)) {
         throw OdbcError::from_handle(handle_type, handle, context);
     }
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <vector>
 #include <stdexcept>
 #include <optional>
+#include <cstring>
 
 #ifdef _WIN32
 #include <windows.h>
@@ -22,11 +24,47 @@ struct OdbcDiagnostic {
     SQLSMALLINT record_number;      // Diagnostic record number
 };
 
+// Read every diagnostic record on a handle
+std::vector<OdbcDiagnostic> read_diagnostics(SQLSMALLINT handle_type, SQLHANDLE handle);
+
+// A five-character SQLSTATE held by value. Comparing two of them, or one
+// against a literal, is a five-byte compare with no allocation.
+class SqlState {
+public:
+    SqlState() noexcept = default;
+    SqlState(const char* code) noexcept {
+        if (code) std::strncpy(code_, code, 5);
+    }
+    
+    // SQLSTATE of one diagnostic record, without fetching its message.
+    // Empty when the record does not exist.
+    static SqlState from_handle(SQLSMALLINT handle_type, SQLHANDLE handle,
+                                SQLSMALLINT record = 1) noexcept;
+    
+    bool empty() const noexcept { return code_[0] == '\0'; }
+    const char* c_str() const noexcept { return code_; }
+    std::string str() const { return code_; }
+    
+    // Two-character class, e.g. "40" for transaction rollback
+    bool is_class(const char* cls) const noexcept {
+        return std::memcmp(code_, cls, 2) == 0;
+    }
+    
+    bool operator==(const SqlState& other) const noexcept {
+        return std::memcmp(code_, other.code_, 5) == 0;
+    }
+    bool operator!=(const SqlState& other) const noexcept { return !(*this == other); }
+    
+private:
+    char code_[6] = {0};
+};
+
 // Exception class for ODBC errors
 class OdbcError : public std::runtime_error {
 public:
-    // Extract all diagnostic records from a handle
-    static OdbcError from_handle(SQLSMALLINT handle_type, SQLHANDLE handle, const std::string& context = "");
+    // Extract all diagnostic records from a handle. An exception can outlive
+    // the handle it came from, so the records are copied straight away.
+    static OdbcError from_handle(SQLSMALLINT handle_type, SQLHANDLE handle, std::string_view context = {});
     
     explicit OdbcError(const std::string& message);
     OdbcError(const std::string& message, std::vector<OdbcDiagnostic> diagnostics);
@@ -39,7 +77,35 @@ private:
     std::vector<OdbcDiagnostic> diagnostics_;
 };
 
+// Result of an ODBC call, for paths where failure is expected and usually
+// ignored. Nothing is read from the driver until the SQLSTATE or the
+// diagnostics are asked for, and then only once. Diagnostics belong to the
+// handle, so inspect them before the next call on it.
+class [[nodiscard]] OdbcResult {
+public:
+    OdbcResult(SQLRETURN ret, SQLSMALLINT handle_type, SQLHANDLE handle) noexcept
+        : ret_(ret), handle_type_(handle_type), handle_(handle) {}
+    
+    SQLRETURN code() const noexcept { return ret_; }
+    bool ok() const noexcept { return SQL_SUCCEEDED(ret_); }
+    explicit operator bool() const noexcept { return ok(); }
+    
+    // SQLSTATE of the first record
+    const SqlState& sqlstate() const;
+    const std::vector<OdbcDiagnostic>& diagnostics() const;
+    
+    // Throw an OdbcError carrying the diagnostics if the call failed
+    void throw_if_error(std::string_view context) const;
+
+private:
+    SQLRETURN ret_;
+    SQLSMALLINT handle_type_;
+    SQLHANDLE handle_;
+    mutable std::optional<SqlState> sqlstate_;
+    mutable std::optional<std::vector<OdbcDiagnostic>> diagnostics_;
+};
+
 // Check ODBC return code and throw on error
-void check_odbc_result(SQLRETURN ret, SQLSMALLINT handle_type, SQLHANDLE handle, const std::string& context);
+void check_odbc_result(SQLRETURN ret, SQLSMALLINT handle_type, SQLHANDLE handle, std::string_view context);
 
 } // namespace odbc_crusher::core
@@ -1,5 +1,6 @@
 #include "odbc_statement.hpp"
 #include "odbc_error.hpp"
+#include "alloc_profiler.hpp"
 
 namespace odbc_crusher::core {
 
@@ -27,26 +28,42 @@ void OdbcStatement::recycle() noexcept {
 }
 
 void OdbcStatement::execute(std::string_view sql) {
+    try_execute(sql).throw_if_error("SQLExecDirect");
+}
+
+void OdbcStatement::prepare(std::string_view sql) {
+    try_prepare(sql).throw_if_error("SQLPrepare");
+}
+
+void OdbcStatement::execute_prepared() {
+    try_execute_prepared().throw_if_error("SQLExecute");
+}
+
+OdbcResult OdbcStatement::try_execute(std::string_view sql) {
     recycle();
+    AllocProfiler::CallScope scope("SQLExecDirect");
     SQLRETURN ret = SQLExecDirect(handle_, (SQLCHAR*)sql.data(), static_cast<SQLINTEGER>(sql.length()));
-    check_odbc_result(ret, SQL_HANDLE_STMT, handle_, "SQLExecDirect");
+    return OdbcResult(ret, SQL_HANDLE_STMT, handle_);
 }
 
-void OdbcStatement::prepare(std::string_view sql) {
+OdbcResult OdbcStatement::try_prepare(std::string_view sql) {
     recycle();
+    AllocProfiler::CallScope scope("SQLPrepare");
     SQLRETURN ret = SQLPrepare(handle_, (SQLCHAR*)sql.data(), static_cast<SQLINTEGER>(sql.length()));
-    check_odbc_result(ret, SQL_HANDLE_STMT, handle_, "SQLPrepare");
+    return OdbcResult(ret, SQL_HANDLE_STMT, handle_);
 }
 
-void OdbcStatement::execute_prepared() {
+OdbcResult OdbcStatement::try_execute_prepared() {
     // Close any open cursor from a previous execution, but don't reset
     // params since we're re-executing a prepared statement with bindings.
     SQLFreeStmt(handle_, SQL_CLOSE);
+    AllocProfiler::CallScope scope("SQLExecute");
     SQLRETURN ret = SQLExecute(handle_);
-    check_odbc_result(ret, SQL_HANDLE_STMT, handle_, "SQLExecute");
+    return OdbcResult(ret, SQL_HANDLE_STMT, handle_);
 }
 
 bool OdbcStatement::fetch() {
+    AllocProfiler::CallScope scope("SQLFetch");
     SQLRETURN ret = SQLFetch(handle_);
     
     if (ret == SQL_NO_DATA) {
@@ -55,6 +72,7 @@ bool OdbcStatement::fetch() {
     
     // Allow SQL_SUCCESS_WITH_INFO (warnings)
     if (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO) {
+        AllocProfiler::add_rows_fetched(1);
         return true;
     }
     
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "odbc_connection.hpp"
+#include "odbc_error.hpp"
 #include <string>
 #include <string_view>
 
@@ -22,6 +23,11 @@ public:
     void prepare(std::string_view sql);
     void execute_prepared();
     
+    // Non-throwing forms for callers that expect some calls to fail
+    OdbcResult try_execute(std::string_view sql);
+    OdbcResult try_prepare(std::string_view sql);
+    OdbcResult try_execute_prepared();
+    
     bool fetch();
     void close_cursor();
     void recycle() noexcept;
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+namespace odbc_crusher::core {
+
+// CPU time consumed by the calling thread
+std::chrono::microseconds thread_cpu_time() noexcept;
+
+// Peak resident set size of the process in bytes, or 0 when the platform
+// does not report it. Includes memory used by the ODBC driver.
+uint64_t peak_rss_bytes() noexcept;
+
+} // namespace odbc_crusher::core
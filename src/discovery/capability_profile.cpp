@@ -0,0 +1,420 @@
+#include "capability_profile.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace odbc_crusher::discovery {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// First line of every profile; bump the number when the layout changes so
+// older files are ignored and rewritten
+constexpr const char* kFormatHeader = "odbc-crusher capability profile 2";
+
+// Connection string keywords that carry credentials; they are left out of
+// the connection hash
+bool is_credential(const std::string& upper_keyword) {
+    static const char* const kCredentials[] = {
+        "UID", "USER", "USERID", "USER ID", "USERNAME", "PWD", "PASSWORD",
+        "TOKEN", "ACCESSTOKEN", "ACCESS_TOKEN", "AUTHENTICATION"
+    };
+    return std::find(std::begin(kCredentials), std::end(kCredentials), upper_keyword) !=
+           std::end(kCredentials);
+}
+
+std::string trim(const std::string& text) {
+    size_t start = text.find_first_not_of(" \t");
+    if (start == std::string::npos) return "";
+    size_t end = text.find_last_not_of(" \t");
+    return text.substr(start, end - start + 1);
+}
+
+// FNV-1a over `fields`, each followed by a NUL
+std::uint64_t hash_fields(std::initializer_list<const std::string*> fields) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (const std::string* field : fields) {
+        for (char c : *field) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ULL;
+        }
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+std::string to_hex(std::uint64_t value) {
+    char hex[17];
+    std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(value));
+    return hex;
+}
+
+std::string get_info_string(core::OdbcConnection& conn, SQLUSMALLINT info_type) {
+    SQLCHAR buffer[1024] = {0};
+    SQLSMALLINT length = 0;
+    SQLRETURN ret = SQLGetInfo(conn.get_handle(), info_type, buffer, sizeof(buffer), &length);
+    if (!SQL_SUCCEEDED(ret)) return "";
+    return reinterpret_cast<char*>(buffer);
+}
+
+// Fields are tab-separated, one record per line
+std::string escape(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (char c : text) {
+        switch (c) {
+            case '\\': out += "\\\\"; break;
+            case '\t': out += "\\t"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            default: out += c; break;
+        }
+    }
+    return out;
+}
+
+std::string unescape(const std::string& text) {
+    std::string out;
+    out.reserve(text.size());
+    for (size_t i = 0; i < text.size(); ++i) {
+        if (text[i] != '\\' || i + 1 == text.size()) {
+            out += text[i];
+            continue;
+        }
+        switch (text[++i]) {
+            case 't': out += '\t'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            default: out += text[i]; break;
+        }
+    }
+    return out;
+}
+
+std::vector<std::string> split_fields(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t tab = line.find('\t', start);
+        fields.push_back(unescape(line.substr(start, tab - start)));
+        if (tab == std::string::npos) break;
+        start = tab + 1;
+    }
+    return fields;
+}
+
+bool to_number(const std::string& text, long long& value) {
+    if (text.empty()) return false;
+    char* end = nullptr;
+    value = std::strtoll(text.c_str(), &end, 10);
+    return *end == '\0';
+}
+
+template<typename T>
+bool to_field(const std::string& text, T& value) {
+    long long number = 0;
+    if (!to_number(text, number)) return false;
+    value = static_cast<T>(number);
+    return true;
+}
+
+std::string type_line(const DataTypeInfo& t) {
+    std::ostringstream line;
+    line << "t\t" << escape(t.type_name) << '\t' << t.data_type << '\t' << t.column_size
+         << '\t' << escape(t.literal_prefix) << '\t' << escape(t.literal_suffix)
+         << '\t' << escape(t.create_params) << '\t' << t.nullable << '\t' << t.case_sensitive
+         << '\t' << t.searchable << '\t' << t.unsigned_attribute << '\t' << t.fixed_prec_scale
+         << '\t' << t.auto_unique_value << '\t' << escape(t.local_type_name)
+         << '\t' << t.minimum_scale << '\t' << t.maximum_scale << '\t' << t.sql_data_type
+         << '\t' << t.sql_datetime_sub << '\t' << t.num_prec_radix;
+    return line.str();
+}
+
+// `fields` is a "t" line split into its 19 fields
+bool parse_type(const std::vector<std::string>& fields, DataTypeInfo& t) {
+    if (fields.size() != 19) return false;
+    t.type_name = fields[1];
+    t.literal_prefix = fields[4];
+    t.literal_suffix = fields[5];
+    t.create_params = fields[6];
+    t.local_type_name = fields[13];
+    return to_field(fields[2], t.data_type) && to_field(fields[3], t.column_size) &&
+           to_field(fields[7], t.nullable) && to_field(fields[8], t.case_sensitive) &&
+           to_field(fields[9], t.searchable) && to_field(fields[10], t.unsigned_attribute) &&
+           to_field(fields[11], t.fixed_prec_scale) && to_field(fields[12], t.auto_unique_value) &&
+           to_field(fields[14], t.minimum_scale) && to_field(fields[15], t.maximum_scale) &&
+           to_field(fields[16], t.sql_data_type) && to_field(fields[17], t.sql_datetime_sub) &&
+           to_field(fields[18], t.num_prec_radix);
+}
+
+// The function bitmap as one run of four hex digits per word
+std::string bitmap_to_hex(const CapabilityProfile::FunctionBitmap& bitmap) {
+    std::string hex;
+    hex.reserve(bitmap.size() * 4);
+    char word[5];
+    for (SQLUSMALLINT w : bitmap) {
+        std::snprintf(word, sizeof(word), "%04x", static_cast<unsigned>(w));
+        hex += word;
+    }
+    return hex;
+}
+
+bool hex_to_bitmap(const std::string& hex, CapabilityProfile::FunctionBitmap& bitmap) {
+    if (hex.size() != bitmap.size() * 4) return false;
+    for (size_t i = 0; i < bitmap.size(); ++i) {
+        std::string word = hex.substr(i * 4, 4);
+        char* end = nullptr;
+        unsigned long value = std::strtoul(word.c_str(), &end, 16);
+        if (*end != '\0') return false;
+        bitmap[i] = static_cast<SQLUSMALLINT>(value);
+    }
+    return true;
+}
+
+} // anonymous namespace
+
+CapabilityProfile::Key CapabilityProfile::Key::query(core::OdbcConnection& conn) {
+    Key key;
+    key.driver_name = get_info_string(conn, SQL_DRIVER_NAME);
+    key.driver_ver = get_info_string(conn, SQL_DRIVER_VER);
+    key.dbms_name = get_info_string(conn, SQL_DBMS_NAME);
+    key.dbms_ver = get_info_string(conn, SQL_DBMS_VER);
+    key.connection_hash = hash_connection_string(conn.connection_string());
+    return key;
+}
+
+std::string CapabilityProfile::Key::hash_connection_string(const std::string& connection_string) {
+    // KEYWORD=value attributes split at ';' outside {braces}
+    std::vector<std::string> attributes;
+    std::string current;
+    bool in_braces = false;
+    for (char c : connection_string + ";") {
+        if (c == '{') in_braces = true;
+        if (c == '}') in_braces = false;
+        if (c != ';' || in_braces) {
+            current += c;
+            continue;
+        }
+        size_t eq = current.find('=');
+        std::string keyword = trim(current.substr(0, eq));
+        std::transform(keyword.begin(), keyword.end(), keyword.begin(),
+                       [](unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
+        if (!keyword.empty() && !is_credential(keyword)) {
+            std::string value = eq == std::string::npos ? "" : trim(current.substr(eq + 1));
+            attributes.push_back(keyword + "=" + value);
+        }
+        current.clear();
+    }
+    std::sort(attributes.begin(), attributes.end());
+
+    std::string normalized;
+    for (const auto& attribute : attributes) normalized += attribute + ";";
+    return to_hex(hash_fields({&normalized}));
+}
+
+std::string CapabilityProfile::Key::file_name() const {
+    std::string name;
+    for (char c : driver_name) {
+        if (name.size() == 40) break;
+        bool safe = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') ||
+                    (c >= '0' && c <= '9') || c == '-' || c == '.';
+        name += safe ? c : '_';
+    }
+    if (name.empty()) name = "driver";
+
+    return name + "-" +
+           to_hex(hash_fields({&driver_name, &driver_ver, &dbms_name, &dbms_ver, &connection_hash})) +
+           ".profile";
+}
+
+bool CapabilityProfile::Key::operator==(const Key& other) const {
+    return driver_name == other.driver_name && driver_ver == other.driver_ver &&
+           dbms_name == other.dbms_name && dbms_ver == other.dbms_ver &&
+           connection_hash == other.connection_hash;
+}
+
+const std::optional<std::string>* CapabilityProfile::find_info_string(SQLUSMALLINT info_type) const {
+    auto it = info_strings_.find(info_type);
+    return it != info_strings_.end() ? &it->second : nullptr;
+}
+
+const std::optional<SQLUINTEGER>* CapabilityProfile::find_info_uint(SQLUSMALLINT info_type) const {
+    auto it = info_uints_.find(info_type);
+    return it != info_uints_.end() ? &it->second : nullptr;
+}
+
+void CapabilityProfile::record_info_string(SQLUSMALLINT info_type,
+                                           const std::optional<std::string>& value) {
+    info_strings_[info_type] = value;
+    modified_ = true;
+}
+
+void CapabilityProfile::record_info_uint(SQLUSMALLINT info_type, std::optional<SQLUINTEGER> value) {
+    info_uints_[info_type] = value;
+    modified_ = true;
+}
+
+void CapabilityProfile::record_types(const std::vector<DataTypeInfo>& types) {
+    types_ = types;
+    modified_ = true;
+}
+
+void CapabilityProfile::record_functions(const FunctionBitmap& bitmap) {
+    functions_ = bitmap;
+    modified_ = true;
+}
+
+std::optional<bool> CapabilityProfile::supports_function(SQLUSMALLINT function_id) const {
+    if (!functions_) return std::nullopt;
+    if (function_id >= SQL_API_ODBC3_ALL_FUNCTIONS_SIZE * 16) return false;
+    return ((*functions_)[function_id / 16] & (1 << (function_id % 16))) != 0;
+}
+
+void CapabilityProfile::save(const std::string& path) const {
+    std::ostringstream out;
+    out << kFormatHeader << '\n';
+    out << "key\t" << escape(key_.driver_name) << '\t' << escape(key_.driver_ver) << '\t'
+        << escape(key_.dbms_name) << '\t' << escape(key_.dbms_ver) << '\t'
+        << escape(key_.connection_hash) << '\n';
+    for (const auto& [info_type, value] : info_strings_) {
+        if (value) {
+            out << "s\t" << info_type << '\t' << escape(*value) << '\n';
+        } else {
+            out << "e\ts\t" << info_type << '\n';
+        }
+    }
+    for (const auto& [info_type, value] : info_uints_) {
+        if (value) {
+            out << "u\t" << info_type << '\t' << *value << '\n';
+        } else {
+            out << "e\tu\t" << info_type << '\n';
+        }
+    }
+    if (functions_) {
+        out << "functions\t" << bitmap_to_hex(*functions_) << '\n';
+    }
+    if (types_) {
+        out << "types\t" << types_->size() << '\n';
+        for (const auto& t : *types_) out << type_line(t) << '\n';
+    }
+
+    // Readers never see a half-written file: write beside it, then rename.
+    // The temporary name is unique, so concurrent runs saving the same
+    // profile don't write into one file.
+    fs::path target(path);
+    std::error_code ec;
+    if (target.has_parent_path()) fs::create_directories(target.parent_path(), ec);
+    static std::atomic<unsigned> saves{0};
+    std::ostringstream suffix;
+    suffix << ".tmp-" << std::hex << std::random_device{}() << '-'
+           << std::hash<std::thread::id>{}(std::this_thread::get_id()) << '-' << saves++;
+    fs::path temp = target;
+    temp += suffix.str();
+    {
+        std::ofstream file(temp, std::ios::binary | std::ios::trunc);
+        file << out.str();
+        if (!file.flush()) {
+            throw std::runtime_error("Cannot write capability profile " + temp.string());
+        }
+    }
+    fs::rename(temp, target, ec);
+    if (ec) {
+        fs::remove(temp, ec);
+        throw std::runtime_error("Cannot write capability profile " + target.string());
+    }
+}
+
+std::optional<CapabilityProfile> CapabilityProfile::load(const std::string& path, const Key& key) {
+    std::ifstream file(path, std::ios::binary);
+    if (!file) return std::nullopt;
+
+    std::string line;
+    if (!std::getline(file, line) || line != kFormatHeader) return std::nullopt;
+
+    CapabilityProfile profile(key);
+    bool have_key = false;
+    size_t expected_types = 0;
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+        auto fields = split_fields(line);
+        const std::string& tag = fields[0];
+        SQLUSMALLINT info_type = 0;
+
+        if (tag == "key" && fields.size() == 6) {
+            Key stored{fields[1], fields[2], fields[3], fields[4], fields[5]};
+            if (stored != key) return std::nullopt;
+            have_key = true;
+        } else if (tag == "s" && fields.size() == 3 && to_field(fields[1], info_type)) {
+            profile.info_strings_[info_type] = fields[2];
+        } else if (tag == "u" && fields.size() == 3 && to_field(fields[1], info_type)) {
+            long long value = 0;
+            if (!to_number(fields[2], value)) return std::nullopt;
+            profile.info_uints_[info_type] = static_cast<SQLUINTEGER>(value);
+        } else if (tag == "e" && fields.size() == 3 && to_field(fields[2], info_type)) {
+            if (fields[1] == "s") {
+                profile.info_strings_[info_type] = std::nullopt;
+            } else {
+                profile.info_uints_[info_type] = std::nullopt;
+            }
+        } else if (tag == "functions" && fields.size() == 2) {
+            FunctionBitmap bitmap{};
+            if (!hex_to_bitmap(fields[1], bitmap)) return std::nullopt;
+            profile.functions_ = bitmap;
+        } else if (tag == "types" && fields.size() == 2) {
+            long long count = 0;
+            if (!to_number(fields[1], count) || count < 0 || count > 100000) return std::nullopt;
+            expected_types = static_cast<size_t>(count);
+            profile.types_.emplace();
+            profile.types_->reserve(expected_types);
+        } else if (tag == "t" && profile.types_) {
+            DataTypeInfo type{};
+            if (!parse_type(fields, type)) return std::nullopt;
+            profile.types_->push_back(std::move(type));
+        } else {
+            return std::nullopt;
+        }
+    }
+
+    // A truncated file is as good as none
+    if (!have_key || (profile.types_ && profile.types_->size() != expected_types)) {
+        return std::nullopt;
+    }
+    return profile;
+}
+
+std::string CapabilityProfile::default_directory() {
+    if (const char* dir = std::getenv("ODBC_CRUSHER_CACHE_DIR"); dir && *dir) {
+        return dir;
+    }
+
+    fs::path base;
+#ifdef _WIN32
+    if (const char* local = std::getenv("LOCALAPPDATA"); local && *local) base = local;
+#else
+    if (const char* xdg = std::getenv("XDG_CACHE_HOME"); xdg && *xdg) {
+        base = xdg;
+    } else if (const char* home = std::getenv("HOME"); home && *home) {
+        base = fs::path(home) / ".cache";
+    }
+#endif
+    if (base.empty()) return "";
+    return (base / "odbc-crusher").string();
+}
+
+std::string CapabilityProfile::path_for(const std::string& directory, const Key& key) {
+    return (fs::path(directory) / key.file_name()).string();
+}
+
+} // namespace odbc_crusher::discovery
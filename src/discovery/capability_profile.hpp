@@ -0,0 +1,98 @@
+#pragma once
+
+#include "core/odbc_connection.hpp"
+#include "type_info.hpp"
+#include <array>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace odbc_crusher::discovery {
+
+// What discovery learned about a driver, kept in the form the driver gave
+// it: SQLGetInfo answers, the SQLGetTypeInfo rows and the SQLGetFunctions
+// bitmap. Saved as a small text file keyed by driver and DBMS version and
+// by the connection string, so later runs with the same driver, server and
+// connection options replay it instead of asking the driver again.
+class CapabilityProfile {
+public:
+    // The driver build, server and connection options a profile describes
+    struct Key {
+        std::string driver_name;
+        std::string driver_ver;
+        std::string dbms_name;
+        std::string dbms_ver;
+        std::string connection_hash;   // hash_connection_string() of the connection's string
+
+        // Four SQLGetInfo calls, answers the driver refuses left empty, and
+        // the hash of the connection's connection string
+        static Key query(core::OdbcConnection& conn);
+
+        // Hash of a connection string without its credentials (UID, PWD and
+        // the like), insensitive to keyword case and attribute order.
+        // Options such as a driver's type set or injected failures change
+        // what discovery sees, so they select a different profile.
+        static std::string hash_connection_string(const std::string& connection_string);
+
+        // Driver name made safe for a file name, plus a hash of all fields
+        std::string file_name() const;
+
+        bool operator==(const Key& other) const;
+        bool operator!=(const Key& other) const { return !(*this == other); }
+    };
+
+    using FunctionBitmap = std::array<SQLUSMALLINT, SQL_API_ODBC3_ALL_FUNCTIONS_SIZE>;
+
+    CapabilityProfile() = default;
+    explicit CapabilityProfile(Key key) : key_(std::move(key)) {}
+
+    const Key& key() const { return key_; }
+
+    // Recorded SQLGetInfo answers. nullptr: the info type was never asked;
+    // a recorded nullopt: the driver returned an error for it.
+    const std::optional<std::string>* find_info_string(SQLUSMALLINT info_type) const;
+    const std::optional<SQLUINTEGER>* find_info_uint(SQLUSMALLINT info_type) const;
+    void record_info_string(SQLUSMALLINT info_type, const std::optional<std::string>& value);
+    void record_info_uint(SQLUSMALLINT info_type, std::optional<SQLUINTEGER> value);
+
+    // SQLGetTypeInfo(SQL_ALL_TYPES) rows; nullptr until recorded
+    const std::vector<DataTypeInfo>* types() const { return types_ ? &*types_ : nullptr; }
+    void record_types(const std::vector<DataTypeInfo>& types);
+
+    // SQLGetFunctions(SQL_API_ODBC3_ALL_FUNCTIONS); nullptr until recorded
+    const FunctionBitmap* functions() const { return functions_ ? &*functions_ : nullptr; }
+    void record_functions(const FunctionBitmap& bitmap);
+
+    // SQL_FUNC_EXISTS on the recorded bitmap; nullopt without one
+    std::optional<bool> supports_function(SQLUSMALLINT function_id) const;
+
+    // Something was recorded since the profile was created or loaded
+    bool modified() const { return modified_; }
+
+    // Writes the profile to `path` (through a uniquely named temporary file,
+    // creating directories as needed). Throws std::runtime_error on I/O
+    // failure.
+    void save(const std::string& path) const;
+
+    // The profile stored at `path` if it exists, is readable, has this
+    // format version and was written for `key`; otherwise nullopt
+    static std::optional<CapabilityProfile> load(const std::string& path, const Key& key);
+
+    // $ODBC_CRUSHER_CACHE_DIR, else the platform's user cache directory
+    // with "odbc-crusher" appended; empty when none can be found
+    static std::string default_directory();
+
+    // `directory`/`key.file_name()`
+    static std::string path_for(const std::string& directory, const Key& key);
+
+private:
+    Key key_;
+    std::map<SQLUSMALLINT, std::optional<std::string>> info_strings_;
+    std::map<SQLUSMALLINT, std::optional<SQLUINTEGER>> info_uints_;
+    std::optional<std::vector<DataTypeInfo>> types_;
+    std::optional<FunctionBitmap> functions_;
+    bool modified_ = false;
+};
+
+} // namespace odbc_crusher::discovery
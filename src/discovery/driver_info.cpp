@@ -1,4 +1,5 @@
 #include "driver_info.hpp"
+#include "capability_profile.hpp"
 #include "core/odbc_error.hpp"
 #include <sstream>
 #include <iomanip>
@@ -120,29 +121,59 @@ void DriverInfo::collect() {
     collect_scalar_functions();
 }
 
+void DriverInfo::collect(CapabilityProfile& profile) {
+    profile_ = &profile;
+    collect();
+    profile_ = nullptr;
+}
+
+namespace {
+
+// Answers that differ between connections to the same driver and server
+bool is_connection_specific(SQLUSMALLINT info_type) {
+    return info_type == SQL_USER_NAME || info_type == SQL_SERVER_NAME ||
+           info_type == SQL_DATABASE_NAME || info_type == SQL_DATA_SOURCE_NAME ||
+           info_type == SQL_DATA_SOURCE_READ_ONLY;
+}
+
+} // anonymous namespace
+
 std::optional<std::string> DriverInfo::get_info_string(SQLUSMALLINT info_type) {
+    bool cacheable = profile_ && !is_connection_specific(info_type);
+    if (cacheable) {
+        if (const auto* answer = profile_->find_info_string(info_type)) return *answer;
+    }
+    
     SQLCHAR buffer[1024] = {0};
     SQLSMALLINT buffer_length = 0;
     
     SQLRETURN ret = SQLGetInfo(conn_.get_handle(), info_type, buffer, sizeof(buffer), &buffer_length);
     
+    std::optional<std::string> result;
     if (SQL_SUCCEEDED(ret)) {
-        return std::string(reinterpret_cast<char*>(buffer), buffer_length);
+        result = std::string(reinterpret_cast<char*>(buffer), buffer_length);
     }
     
-    return std::nullopt;
+    if (cacheable) profile_->record_info_string(info_type, result);
+    return result;
 }
 
 std::optional<SQLUINTEGER> DriverInfo::get_info_uint(SQLUSMALLINT info_type) {
+    if (profile_) {
+        if (const auto* answer = profile_->find_info_uint(info_type)) return *answer;
+    }
+    
     SQLUINTEGER value = 0;
     
     SQLRETURN ret = SQLGetInfo(conn_.get_handle(), info_type, &value, sizeof(value), nullptr);
     
+    std::optional<SQLUINTEGER> result;
     if (SQL_SUCCEEDED(ret)) {
-        return value;
+        result = value;
     }
     
-    return std::nullopt;
+    if (profile_) profile_->record_info_uint(info_type, result);
+    return result;
 }
 
 std::string DriverInfo::format_summary() const {
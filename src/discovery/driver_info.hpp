@@ -8,6 +8,8 @@
 
 namespace odbc_crusher::discovery {
 
+class CapabilityProfile;
+
 // Driver and DBMS information collected via SQLGetInfo
 class DriverInfo {
 public:
@@ -53,6 +55,12 @@ public:
     
     // Collect all information
     void collect();
+
+    // Collect, answering SQLGetInfo from `profile` where it holds the answer
+    // and recording in it the answers it lacks. Values that belong to the
+    // connection rather than the driver (user, server and database name)
+    // are always asked.
+    void collect(CapabilityProfile& profile);
     
     // Driver information
     std::optional<std::string> driver_name() const { return driver_name_; }
@@ -81,6 +89,7 @@ public:
     
 private:
     core::OdbcConnection& conn_;
+    CapabilityProfile* profile_ = nullptr;   // Set during collect(profile)
     
     // Cached information
     std::optional<std::string> driver_name_;
@@ -1,4 +1,5 @@
 #include "function_info.hpp"
+#include "capability_profile.hpp"
 #include "core/odbc_error.hpp"
 #include <sstream>
 #include <iomanip>
@@ -11,12 +12,26 @@ FunctionInfo::FunctionInfo(core::OdbcConnection& conn)
 }
 
 void FunctionInfo::collect() {
-    functions_.clear();
-    
     // Get all ODBC 3.x functions via bitmap
     SQLRETURN ret = SQLGetFunctions(conn_.get_handle(), SQL_API_ODBC3_ALL_FUNCTIONS, function_bitmap_.data());
     core::check_odbc_result(ret, SQL_HANDLE_DBC, conn_.get_handle(), "SQLGetFunctions");
     
+    list_functions();
+}
+
+void FunctionInfo::collect(CapabilityProfile& profile) {
+    if (const auto* cached = profile.functions()) {
+        function_bitmap_ = *cached;
+        list_functions();
+        return;
+    }
+    collect();
+    profile.record_functions(function_bitmap_);
+}
+
+void FunctionInfo::list_functions() {
+    functions_.clear();
+    
     // Important ODBC functions to check
     std::vector<SQLUSMALLINT> important_functions = {
         // Connection functions
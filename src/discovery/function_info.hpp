@@ -7,6 +7,8 @@
 
 namespace odbc_crusher::discovery {
 
+class CapabilityProfile;
+
 // ODBC function availability information
 struct FunctionAvailability {
     SQLUSMALLINT function_id;
@@ -29,6 +31,9 @@ public:
     
     // Collect all function information
     void collect();
+
+    // Take the bitmap from `profile` if it has one, else collect and record it
+    void collect(CapabilityProfile& profile);
     
     // Check if a specific function is supported
     bool is_supported(SQLUSMALLINT function_id) const;
@@ -55,6 +60,9 @@ private:
     // Bitmap for all ODBC 3.x functions
     std::array<SQLUSMALLINT, SQL_API_ODBC3_ALL_FUNCTIONS_SIZE> function_bitmap_;
     
+    // Fill functions_ from function_bitmap_
+    void list_functions();
+    
     // Helper to get function name
     static std::string get_function_name(SQLUSMALLINT function_id);
 };
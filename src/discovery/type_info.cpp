@@ -1,4 +1,5 @@
 #include "type_info.hpp"
+#include "capability_profile.hpp"
 #include "core/odbc_statement.hpp"
 #include "core/odbc_error.hpp"
 #include <sstream>
@@ -113,6 +114,15 @@ void TypeInfo::collect() {
     }
 }
 
+void TypeInfo::collect(CapabilityProfile& profile) {
+    if (const auto* cached = profile.types()) {
+        types_ = *cached;
+        return;
+    }
+    collect();
+    profile.record_types(types_);
+}
+
 std::string TypeInfo::format_summary() const {
     std::ostringstream oss;
     
@@ -7,6 +7,8 @@
 
 namespace odbc_crusher::discovery {
 
+class CapabilityProfile;
+
 // Information about a single data type
 struct DataTypeInfo {
     std::string type_name;          // Data type name (e.g., "VARCHAR")
@@ -45,6 +47,9 @@ public:
     
     // Collect all type information
     void collect();
+
+    // Take the rows from `profile` if it has them, else collect and record them
+    void collect(CapabilityProfile& profile);
     
     // Get all types
     const std::vector<DataTypeInfo>& types() const { return types_; }
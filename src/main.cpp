@@ -6,6 +6,7 @@
 #include "core/odbc_connection.hpp"
 #include "core/odbc_error.hpp"
 #include "core/crash_guard.hpp"
+#include "core/alloc_profiler.hpp"
 #include "tests/connection_tests.hpp"
 #include "tests/statement_tests.hpp"
 #include "tests/metadata_tests.hpp"
@@ -29,9 +30,15 @@
 #include "tests/escape_sequence_tests.hpp"
 #include "tests/numeric_struct_tests.hpp"
 #include "tests/cursor_stress_tests.hpp"
+#include "tests/lob_streaming_tests.hpp"
+#include "tests/lob_read_tests.hpp"
+#include "tests/bulk_insert_tests.hpp"
+#include "tests/prepared_statement_tests.hpp"
+#include "tests/catalog_scale_tests.hpp"
 #include "discovery/driver_info.hpp"
 #include "discovery/type_info.hpp"
 #include "discovery/function_info.hpp"
+#include "discovery/capability_profile.hpp"
 #include "reporting/console_reporter.hpp"
 #include "reporting/json_reporter.hpp"
 
@@ -58,10 +65,12 @@ void tally_results(const std::vector<tests::TestResult>& results,
 
 template<typename T>
 void run_test_category(T& test_suite, reporting::Reporter& reporter,
+                       const discovery::CapabilityProfile* capabilities,
                        size_t& total_tests, size_t& total_passed,
                        size_t& total_failed, size_t& total_skipped,
                        size_t& total_errors) {
     std::vector<tests::TestResult> results;
+    test_suite.set_capabilities(capabilities);
     
     auto guard = core::execute_with_crash_guard([&]() {
         results = test_suite.run();
@@ -84,6 +93,8 @@ void run_test_category(T& test_suite, reporting::Reporter& reporter,
         results.push_back(crash_result);
     }
     
+    tests::attribute_allocations(results, core::AllocProfiler::snapshot());
+    
     reporter.report_category(test_suite.category_name(), results);
     tally_results(results, total_tests, total_passed, total_failed,
                   total_skipped, total_errors);
@@ -127,7 +138,88 @@ int main(int argc, char** argv) {
     app.add_option("-f,--file", json_file,
                    "Write JSON output to FILE instead of stdout");
     
+    bool profile_allocations = false;
+    app.add_flag("--profile-allocations", profile_allocations,
+                 "Count heap allocations per test and per ODBC call type");
+    
+    tests::AsyncBenchmarkOptions async_options;
+    int async_poll_us = static_cast<int>(async_options.poll_interval.count());
+    app.add_option("--async-concurrency", async_options.concurrency,
+                   "Statements in flight for the async overlap benchmark (default 4)")
+        ->check(CLI::Range(2, 64));
+    app.add_option("--async-poll-us", async_poll_us,
+                   "Initial async polling interval in microseconds (default 100)")
+        ->check(CLI::Range(1, 1000000));
+    app.add_option("--async-poll-backoff", async_options.poll_backoff,
+                   "Polling interval multiplier per round (default 2.0)")
+        ->check(CLI::Range(1.0, 10.0));
+    
+    tests::LobBenchmarkOptions lob_options;
+    app.add_option("--lob-size", lob_options.lob_bytes,
+                   "Size of the LOB streamed by the LOB streaming benchmark, e.g. 2GB (default 16MB)")
+        ->transform(CLI::AsSizeValue(false));
+    app.add_option("--lob-chunk", lob_options.chunk_bytes,
+                   "Bytes per SQLPutData call in the LOB streaming benchmark (default 64KB)")
+        ->transform(CLI::AsSizeValue(false));
+    
+    tests::LobReadOptions lob_read_options;
+    app.add_option("--lob-read-size", lob_read_options.lob_bytes,
+                   "Size of the LOB read back by the LOB read benchmark (default 16MB)")
+        ->transform(CLI::AsSizeValue(false));
+    
+    tests::BulkInsertOptions bulk_options;
+    app.add_option("--bulk-rows", bulk_options.rows,
+                   "Rows inserted per method by the bulk insert benchmark (default 10000)")
+        ->check(CLI::Range(1, 10000000));
+    app.add_option("--bulk-batch", bulk_options.batch_rows,
+                   "Rows per parameter array or rowset in the bulk insert benchmark (default 1000)")
+        ->check(CLI::Range(1, 1000000));
+    
+    tests::TransactionBenchmarkOptions txn_options;
+    app.add_option("--txn-writers", txn_options.writers,
+                   "Concurrent connections in the concurrent commit benchmark (default 4)")
+        ->check(CLI::Range(1, 256));
+    app.add_option("--txn-count", txn_options.transactions,
+                   "Transactions committed per writer in the concurrent commit benchmark (default 500)")
+        ->check(CLI::Range(1, 10000000));
+    
+    tests::ConnectBenchmarkOptions connect_options;
+    app.add_option("--connect-count", connect_options.connects,
+                   "Connections per phase, and per thread, in the connection benchmark (default 20)")
+        ->check(CLI::Range(1, 100000));
+    app.add_option("--connect-threads", connect_options.threads,
+                   "Threads in the connection benchmark's concurrent connect storm (default 8)")
+        ->check(CLI::Range(1, 256));
+    
+    tests::PreparedStatementOptions prep_options;
+    app.add_option("--prep-count", prep_options.executions,
+                   "Executions per method in the prepared statement reuse benchmark (default 1000)")
+        ->check(CLI::Range(1, 10000000));
+    
+    tests::CatalogScaleOptions catalog_options;
+    app.add_flag("--catalog-create-tables", catalog_options.create_tables,
+                 "Let the catalog scaling benchmark create tables when the catalog has fewer than --catalog-tables");
+    app.add_option("--catalog-tables", catalog_options.tables,
+                   "Tables the catalog scaling benchmark creates with --catalog-create-tables (default 100)")
+        ->check(CLI::Range(1, 1000000));
+    app.add_option("--catalog-columns", catalog_options.columns,
+                   "Columns per table the catalog scaling benchmark creates (default 20)")
+        ->check(CLI::Range(1, 1000));
+    app.add_option("--catalog-lookups", catalog_options.lookups,
+                   "Exact-name and pattern calls per function in the catalog scaling benchmark (default 50)")
+        ->check(CLI::Range(1, 100000));
+    
+    bool refresh_discovery = false;
+    app.add_flag("--refresh-discovery", refresh_discovery,
+                 "Query the driver's capabilities even if a cached profile exists, and rewrite it");
+    
+    std::string discovery_cache = discovery::CapabilityProfile::default_directory();
+    app.add_option("--discovery-cache", discovery_cache,
+                   "Directory of cached driver capability profiles; \"\" disables the cache "
+                   "(default $ODBC_CRUSHER_CACHE_DIR or the user cache directory)");
+    
     CLI11_PARSE(app, argc, argv);
+    async_options.poll_interval = std::chrono::microseconds(async_poll_us);
     
     try {
         // Create reporter
@@ -151,15 +243,32 @@ int main(int argc, char** argv) {
         // Phase 1: Collect driver information (for all output formats)
         // Wrapped in crash guard because some drivers (e.g. DuckDB on Linux)
         // can SIGSEGV during SQLGetTypeInfo or SQLGetInfo.
+        // A capability profile cached by an earlier run against the same
+        // driver and DBMS version answers everything but the four SQLGetInfo
+        // calls that identify them.
         discovery::DriverInfo driver_info(conn);
         discovery::TypeInfo type_info(conn);
         discovery::FunctionInfo func_info(conn);
+        discovery::CapabilityProfile capabilities;
+        std::string profile_path;
+        bool profile_loaded = false;
         
         bool discovery_ok = true;
         auto discovery_guard = core::execute_with_crash_guard([&]() {
-            driver_info.collect();
-            type_info.collect();
-            func_info.collect();
+            auto key = discovery::CapabilityProfile::Key::query(conn);
+            capabilities = discovery::CapabilityProfile(key);
+            if (!discovery_cache.empty()) {
+                profile_path = discovery::CapabilityProfile::path_for(discovery_cache, key);
+                if (!refresh_discovery) {
+                    if (auto cached = discovery::CapabilityProfile::load(profile_path, key)) {
+                        capabilities = std::move(*cached);
+                        profile_loaded = true;
+                    }
+                }
+            }
+            driver_info.collect(capabilities);
+            type_info.collect(capabilities);
+            func_info.collect(capabilities);
         });
         
         if (discovery_guard.crashed) {
@@ -168,6 +277,18 @@ int main(int argc, char** argv) {
                       << discovery_guard.description << "\n"
                       << "Continuing with limited information...\n\n";
             std::cerr << std::flush;
+        } else if (!profile_path.empty()) {
+            if (profile_loaded && output_format == "console") {
+                std::cout << "Driver capabilities loaded from " << profile_path
+                          << " (--refresh-discovery to query the driver again)\n";
+            }
+            if (capabilities.modified()) {
+                try {
+                    capabilities.save(profile_path);
+                } catch (const std::exception& e) {
+                    std::cerr << "WARNING: " << e.what() << "\n";
+                }
+            }
         }
         
         if (discovery_ok) {
@@ -201,80 +322,115 @@ int main(int argc, char** argv) {
         size_t total_errors = 0;
         auto overall_start = std::chrono::high_resolution_clock::now();
         
+        if (profile_allocations) {
+            core::AllocProfiler::reset();
+            core::AllocProfiler::set_enabled(true);
+        }
+        
+        // Categories consult the profile to skip work the driver can't do;
+        // after a crash it may be incomplete, so they ask the driver instead
+        const discovery::CapabilityProfile* capabilities_ptr = discovery_ok ? &capabilities : nullptr;
+        
         // Run all test categories
-        tests::ConnectionTests conn_tests(conn);
-        run_test_category(conn_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        tests::ConnectionTests conn_tests(conn, connect_options);
+        run_test_category(conn_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::StatementTests stmt_tests(conn);
-        run_test_category(stmt_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(stmt_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::MetadataTests meta_tests(conn);
-        run_test_category(meta_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(meta_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::DataTypeTests type_tests(conn);
-        run_test_category(type_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(type_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
-        tests::TransactionTests txn_tests(conn);
-        run_test_category(txn_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        tests::TransactionTests txn_tests(conn, txn_options);
+        run_test_category(txn_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
-        tests::AdvancedTests adv_tests(conn);
-        run_test_category(adv_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        tests::AdvancedTests adv_tests(conn, async_options);
+        run_test_category(adv_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::BufferValidationTests buffer_tests(conn);
-        run_test_category(buffer_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(buffer_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::ErrorQueueTests error_tests(conn);
-        run_test_category(error_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(error_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::StateMachineTests state_tests(conn);
-        run_test_category(state_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(state_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::DescriptorTests desc_tests(conn);
-        run_test_category(desc_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(desc_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::CancellationTests cancel_tests(conn);
-        run_test_category(cancel_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(cancel_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::SqlstateTests sqlstate_tests(conn);
-        run_test_category(sqlstate_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(sqlstate_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::BoundaryTests boundary_tests(conn);
-        run_test_category(boundary_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(boundary_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::DataTypeEdgeCaseTests dtype_edge_tests(conn);
-        run_test_category(dtype_edge_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(dtype_edge_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::UnicodeTests unicode_tests(conn);
-        run_test_category(unicode_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(unicode_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::CatalogDepthTests catalog_depth_tests(conn);
-        run_test_category(catalog_depth_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(catalog_depth_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::DiagnosticDepthTests diag_depth_tests(conn);
-        run_test_category(diag_depth_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(diag_depth_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::CursorBehaviorTests cursor_tests(conn);
-        run_test_category(cursor_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(cursor_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::ParameterBindingTests param_tests(conn);
-        run_test_category(param_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(param_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::ArrayParamTests array_param_tests(conn);
-        run_test_category(array_param_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(array_param_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::EscapeSequenceTests escape_tests(conn);
-        run_test_category(escape_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(escape_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::NumericStructTests numeric_tests(conn);
-        run_test_category(numeric_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(numeric_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         tests::CursorStressTests cursor_stress_tests(conn);
-        run_test_category(cursor_stress_tests, *reporter, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        run_test_category(cursor_stress_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        
+        tests::LobStreamingTests lob_tests(conn, lob_options);
+        run_test_category(lob_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        
+        tests::LobReadTests lob_read_tests(conn, lob_read_options);
+        run_test_category(lob_read_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        
+        tests::BulkInsertTests bulk_insert_tests(conn, bulk_options);
+        run_test_category(bulk_insert_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        
+        tests::PreparedStatementTests prep_tests(conn, prep_options);
+        run_test_category(prep_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
+        
+        tests::CatalogScaleTests catalog_scale_tests(conn, catalog_options);
+        run_test_category(catalog_scale_tests, *reporter, capabilities_ptr, total_tests, total_passed, total_failed, total_skipped, total_errors);
         
         auto overall_end = std::chrono::high_resolution_clock::now();
         auto total_duration = std::chrono::duration_cast<std::chrono::microseconds>(
             overall_end - overall_start);
         
+        if (profile_allocations) {
+            core::AllocProfiler::set_enabled(false);
+            auto totals = core::AllocProfiler::snapshot();
+            auto per_call = core::AllocProfiler::per_call_stats();
+            if (auto* console_rep = dynamic_cast<reporting::ConsoleReporter*>(reporter.get())) {
+                console_rep->report_allocation_profile(totals, per_call);
+            } else if (auto* json_rep = dynamic_cast<reporting::JsonReporter*>(reporter.get())) {
+                json_rep->report_allocation_profile(totals, per_call);
+            }
+        }
+        
         // Report summary
         reporter->report_summary(total_tests, total_passed, total_failed,
                                 total_skipped, total_errors, total_duration);
@@ -70,6 +70,9 @@ void ConsoleReporter::report_category(const std::string& category_name,
             out_ << "      Expected:    " << result.expected << "\n";
             out_ << "      Actual:      " << result.actual << "\n";
             out_ << "      Duration:    " << format_duration(result.duration) << "\n";
+            if (result.allocations) {
+                out_ << "      Allocations: " << format_allocations(*result.allocations) << "\n";
+            }
             
             if (result.diagnostic && !result.diagnostic->empty()) {
                 out_ << "      Diagnostic:  " << *result.diagnostic << "\n";
@@ -78,7 +81,11 @@ void ConsoleReporter::report_category(const std::string& category_name,
                 out_ << "      Suggestion:  " << *result.suggestion << "\n";
             }
         } else {
-            out_ << " (" << format_duration(result.duration) << ")\n";
+            out_ << " (" << format_duration(result.duration);
+            if (result.allocations) {
+                out_ << ", " << result.allocations->allocations << " allocs";
+            }
+            out_ << ")\n";
         }
     }
     
@@ -177,6 +184,17 @@ std::string ConsoleReporter::format_duration(std::chrono::microseconds duration)
     }
 }
 
+std::string ConsoleReporter::format_allocations(const core::AllocStats& stats) const {
+    std::ostringstream oss;
+    oss << stats.allocations << " allocs, " << stats.bytes_allocated << " bytes, "
+        << stats.retained_bytes() << " bytes retained";
+    if (stats.rows_fetched > 0) {
+        oss << ", " << std::fixed << std::setprecision(1)
+            << stats.allocations_per_row() << " allocs/row";
+    }
+    return oss.str();
+}
+
 void ConsoleReporter::report_driver_info(const discovery::DriverInfo::Properties& props) {
     out_ << "DRIVER:\n";
     out_ << "  Driver Name:          " << props.driver_name << "\n";
@@ -294,4 +312,39 @@ void ConsoleReporter::report_scalar_functions(const discovery::DriverInfo::Scala
     out_ << "\n";
 }
 
+void ConsoleReporter::report_allocation_profile(const core::AllocStats& totals,
+                                                const std::vector<core::CallAllocStats>& per_call) {
+    out_ << "ALLOCATION PROFILE:\n";
+    out_ << "  Total:  " << format_allocations(totals) << "\n";
+    if (!core::AllocProfiler::sees_driver_allocations()) {
+        out_ << "  (driver-side allocations are not visible on this platform)\n";
+    }
+    
+    if (!per_call.empty()) {
+        out_ << "\n";
+        out_ << "  " << std::left << std::setw(20) << "Function"
+             << std::right << std::setw(10) << "Calls"
+             << std::setw(12) << "Allocs"
+             << std::setw(12) << "Allocs/call"
+             << std::setw(14) << "Bytes"
+             << std::setw(12) << "Allocs/row" << "\n";
+        for (const auto& call : per_call) {
+            double per_call_allocs = call.calls > 0
+                ? static_cast<double>(call.stats.allocations) / call.calls : 0.0;
+            out_ << "  " << std::left << std::setw(20) << call.function
+                 << std::right << std::setw(10) << call.calls
+                 << std::setw(12) << call.stats.allocations
+                 << std::setw(12) << std::fixed << std::setprecision(1) << per_call_allocs
+                 << std::setw(14) << call.stats.bytes_allocated;
+            if (call.stats.rows_fetched > 0) {
+                out_ << std::setw(12) << call.stats.allocations_per_row();
+            } else {
+                out_ << std::setw(12) << "-";
+            }
+            out_ << "\n";
+        }
+    }
+    out_ << "\n";
+}
+
 } // namespace odbc_crusher::reporting
@@ -28,6 +28,10 @@ public:
     void report_function_info(const discovery::FunctionInfo::FunctionSupport& funcs);
     void report_scalar_functions(const discovery::DriverInfo::ScalarFunctionSupport& sf);
     
+    // Allocation profiling (--profile-allocations)
+    void report_allocation_profile(const core::AllocStats& totals,
+                                   const std::vector<core::CallAllocStats>& per_call);
+    
 private:
     std::ostream& out_;
     bool verbose_;
@@ -35,6 +39,7 @@ private:
     
     std::string status_icon(tests::TestStatus status) const;
     std::string format_duration(std::chrono::microseconds duration) const;
+    std::string format_allocations(const core::AllocStats& stats) const;
 };
 
 } // namespace odbc_crusher::reporting
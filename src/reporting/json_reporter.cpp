@@ -4,6 +4,24 @@
 
 namespace odbc_crusher::reporting {
 
+namespace {
+
+nlohmann::json alloc_stats_to_json(const core::AllocStats& stats) {
+    nlohmann::json j;
+    j["allocations"] = stats.allocations;
+    j["deallocations"] = stats.deallocations;
+    j["bytes_allocated"] = stats.bytes_allocated;
+    j["bytes_freed"] = stats.bytes_freed;
+    j["bytes_retained"] = stats.retained_bytes();
+    j["rows_fetched"] = stats.rows_fetched;
+    if (stats.rows_fetched > 0) {
+        j["allocations_per_row"] = stats.allocations_per_row();
+    }
+    return j;
+}
+
+} // anonymous namespace
+
 void JsonReporter::report_start(const std::string& connection_string) {
     root_ = nlohmann::json::object();
     root_["connection_string"] = connection_string;
@@ -52,6 +70,9 @@ void JsonReporter::report_category(const std::string& category_name,
         if (result.suggestion) {
             test["suggestion"] = *result.suggestion;
         }
+        if (result.allocations) {
+            test["allocations"] = alloc_stats_to_json(*result.allocations);
+        }
         
         tests_array.push_back(test);
     }
@@ -165,4 +186,21 @@ void JsonReporter::report_scalar_functions(const discovery::DriverInfo::ScalarFu
     root_["scalar_functions"] = scalar;
 }
 
+void JsonReporter::report_allocation_profile(const core::AllocStats& totals,
+                                             const std::vector<core::CallAllocStats>& per_call) {
+    nlohmann::json profile;
+    profile["driver_allocations_visible"] = core::AllocProfiler::sees_driver_allocations();
+    profile["totals"] = alloc_stats_to_json(totals);
+    
+    nlohmann::json calls = nlohmann::json::array();
+    for (const auto& call : per_call) {
+        nlohmann::json entry = alloc_stats_to_json(call.stats);
+        entry["function"] = call.function;
+        entry["calls"] = call.calls;
+        calls.push_back(entry);
+    }
+    profile["per_call"] = calls;
+    root_["allocation_profile"] = profile;
+}
+
 } // namespace odbc_crusher::reporting
@@ -29,6 +29,10 @@ public:
     void report_function_info(const discovery::FunctionInfo::FunctionSupport& funcs);
     void report_scalar_functions(const discovery::DriverInfo::ScalarFunctionSupport& sf);
     
+    // Allocation profiling (--profile-allocations)
+    void report_allocation_profile(const core::AllocStats& totals,
+                                   const std::vector<core::CallAllocStats>& per_call);
+    
 private:
     std::string output_file_;
     nlohmann::json root_;
@@ -1,17 +1,47 @@
 #include "advanced_tests.hpp"
 #include "core/odbc_statement.hpp"
 #include "core/odbc_error.hpp"
+#include "core/resource_usage.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <memory>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 namespace odbc_crusher::tests {
 
+namespace {
+
+// Turns asynchronous execution back off on a set of statements however the
+// test using them exits
+class AsyncEnableReset {
+public:
+    explicit AsyncEnableReset(const std::vector<std::unique_ptr<core::OdbcStatement>>& stmts)
+        : stmts_(stmts) {}
+    ~AsyncEnableReset() {
+        for (const auto& stmt : stmts_) {
+            SQLFreeStmt(stmt->get_handle(), SQL_CLOSE);
+            SQLSetStmtAttr(stmt->get_handle(), SQL_ATTR_ASYNC_ENABLE,
+                           (SQLPOINTER)SQL_ASYNC_ENABLE_OFF, 0);
+        }
+    }
+    AsyncEnableReset(const AsyncEnableReset&) = delete;
+    AsyncEnableReset& operator=(const AsyncEnableReset&) = delete;
+
+private:
+    const std::vector<std::unique_ptr<core::OdbcStatement>>& stmts_;
+};
+
+} // namespace
+
 std::vector<TestResult> AdvancedTests::run() {
     std::vector<TestResult> results;
     
     results.push_back(test_cursor_types());
     results.push_back(test_array_binding());
     results.push_back(test_async_capability());
+    results.push_back(test_async_overlap());
     results.push_back(test_rowset_size());
     results.push_back(test_positioned_operations());
     results.push_back(test_statement_attributes());
@@ -232,6 +262,180 @@ TestResult AdvancedTests::test_async_capability() {
     return result;
 }
 
+TestResult AdvancedTests::test_async_overlap() {
+    TestResult result = make_result(
+        "test_async_overlap",
+        "SQLExecDirect (SQL_ASYNC_ENABLE_ON)",
+        TestStatus::PASS,
+        "K concurrent async statements finish faster than K sequential ones",
+        "",
+        Severity::INFO,
+        ConformanceLevel::LEVEL_2,
+        "ODBC 3.8 Asynchronous Execution (Polling Method)"
+    );
+    
+    try {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        
+        const size_t k = static_cast<size_t>(std::max(async_options_.concurrency, 1));
+        std::vector<std::unique_ptr<core::OdbcStatement>> stmts;
+        for (size_t i = 0; i < k; ++i) {
+            stmts.push_back(std::make_unique<core::OdbcStatement>(conn_));
+        }
+        
+        // Find a query the driver accepts; it doubles as a warm-up
+        std::string query;
+        for (const char* candidate : {"SELECT 1", "SELECT 1 FROM RDB$DATABASE"}) {
+            SQLRETURN rc = SQLExecDirect(stmts[0]->get_handle(),
+                                         (SQLCHAR*)candidate, SQL_NTS);
+            SQLFreeStmt(stmts[0]->get_handle(), SQL_CLOSE);
+            if (SQL_SUCCEEDED(rc)) {
+                query = candidate;
+                break;
+            }
+        }
+        if (query.empty()) {
+            result.status = TestStatus::SKIP_INCONCLUSIVE;
+            result.actual = "No test query could be executed";
+            auto end_time = std::chrono::high_resolution_clock::now();
+            result.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+            return result;
+        }
+        SQLCHAR* sql = (SQLCHAR*)query.c_str();
+        
+        // Baseline: K executions one after another
+        auto seq_start = std::chrono::steady_clock::now();
+        for (auto& stmt : stmts) {
+            SQLExecDirect(stmt->get_handle(), sql, SQL_NTS);
+            SQLFreeStmt(stmt->get_handle(), SQL_CLOSE);
+        }
+        auto sequential = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - seq_start);
+        
+        AsyncEnableReset async_reset(stmts);
+        for (auto& stmt : stmts) {
+            SQLRETURN rc = SQLSetStmtAttr(stmt->get_handle(), SQL_ATTR_ASYNC_ENABLE,
+                                          (SQLPOINTER)SQL_ASYNC_ENABLE_ON, 0);
+            if (!SQL_SUCCEEDED(rc)) {
+                result.status = TestStatus::SKIP_UNSUPPORTED;
+                result.actual = "Asynchronous execution not supported";
+                auto end_time = std::chrono::high_resolution_clock::now();
+                result.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+                return result;
+            }
+        }
+        
+        // Overlapped: start all K, then poll from this thread with backoff
+        std::vector<bool> pending(k, false);
+        int still_executing = 0;
+        int failed = 0;
+        long polls = 0;
+        
+        auto cpu_start = core::thread_cpu_time();
+        auto conc_start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < k; ++i) {
+            SQLRETURN rc = SQLExecDirect(stmts[i]->get_handle(), sql, SQL_NTS);
+            if (rc == SQL_STILL_EXECUTING) {
+                pending[i] = true;
+                ++still_executing;
+            } else if (!SQL_SUCCEEDED(rc)) {
+                ++failed;
+            }
+        }
+        
+        // Statements still running at the deadline are canceled and get
+        // a short grace period to report it
+        constexpr auto kCancelGrace = std::chrono::seconds(1);
+        const auto deadline = conc_start + async_options_.timeout;
+        bool timed_out = false;
+        int timed_out_count = 0;
+        
+        auto interval = async_options_.poll_interval;
+        int remaining = still_executing;
+        while (remaining > 0) {
+            auto now = std::chrono::steady_clock::now();
+            if (!timed_out && now >= deadline) {
+                timed_out = true;
+                timed_out_count = remaining;
+                for (size_t i = 0; i < k; ++i) {
+                    if (pending[i]) SQLCancel(stmts[i]->get_handle());
+                }
+            } else if (timed_out && now >= deadline + kCancelGrace) {
+                break;
+            }
+            
+            std::this_thread::sleep_for(interval);
+            interval = std::min(async_options_.max_poll_interval,
+                std::chrono::microseconds(static_cast<long long>(
+                    static_cast<double>(interval.count()) * async_options_.poll_backoff)));
+            
+            for (size_t i = 0; i < k; ++i) {
+                if (!pending[i]) continue;
+                SQLRETURN rc = SQLExecDirect(stmts[i]->get_handle(), sql, SQL_NTS);
+                ++polls;
+                if (rc == SQL_STILL_EXECUTING) continue;
+                pending[i] = false;
+                --remaining;
+                if (!timed_out && !SQL_SUCCEEDED(rc)) ++failed;
+            }
+        }
+        auto concurrent = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - conc_start);
+        auto poll_cpu = core::thread_cpu_time() - cpu_start;
+        
+        double speedup = concurrent.count() > 0
+            ? static_cast<double>(sequential.count()) / static_cast<double>(concurrent.count())
+            : 0.0;
+        
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(2)
+            << k << " statements: sequential " << sequential.count() / 1000.0 << " ms, "
+            << "async " << concurrent.count() / 1000.0 << " ms (speedup " << speedup
+            << "x of " << k << "x ideal); " << still_executing << "/" << k
+            << " returned SQL_STILL_EXECUTING, " << polls << " polls, "
+            << poll_cpu.count() / 1000.0 << " ms polling CPU";
+        result.actual = oss.str();
+        
+        // Below ~1ms per statement timer and scheduling noise dominate
+        constexpr auto kMinMeasurable = std::chrono::microseconds(1000);
+        
+        if (timed_out) {
+            result.status = TestStatus::FAIL;
+            result.severity = Severity::ERR;
+            result.actual += "; " + std::to_string(timed_out_count) +
+                " async executions still running after " +
+                std::to_string(async_options_.timeout.count()) + " ms were canceled";
+            if (remaining > 0) {
+                result.actual += ", " + std::to_string(remaining) + " never completed";
+            }
+        } else if (failed > 0) {
+            result.status = TestStatus::FAIL;
+            result.severity = Severity::ERR;
+            result.actual += "; " + std::to_string(failed) + " async executions failed";
+        } else if (k < 2 || sequential < kMinMeasurable * k) {
+            result.status = TestStatus::SKIP_INCONCLUSIVE;
+            result.suggestion = "Statements complete too quickly to measure overlap; "
+                                "use a slower query or a driver with network latency";
+        } else if (speedup < 1.5) {
+            result.status = TestStatus::FAIL;
+            result.severity = Severity::WARNING;
+            result.suggestion = still_executing == 0
+                ? "Driver accepts SQL_ATTR_ASYNC_ENABLE but completes every call synchronously"
+                : "Driver reports SQL_STILL_EXECUTING but executes async statements one at a time";
+        }
+        
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+        
+    } catch (const core::OdbcError& e) {
+        result.status = TestStatus::ERR;
+        result.actual = e.what();
+        result.diagnostic = e.format_diagnostics();
+    }
+    
+    return result;
+}
+
 TestResult AdvancedTests::test_rowset_size() {
     TestResult result = make_result(
         "test_rowset_size",
@@ -464,7 +668,7 @@ TestResult AdvancedTests::test_fetch_scroll_next() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 SQLRETURN rc = SQLFetchScroll(stmt.get_handle(), SQL_FETCH_NEXT, 0);
                 
@@ -527,7 +731,7 @@ TestResult AdvancedTests::test_fetch_scroll_first_last() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 SQLRETURN rc = SQLFetchScroll(stmt.get_handle(), SQL_FETCH_FIRST, 0);
                 
@@ -599,7 +803,7 @@ TestResult AdvancedTests::test_fetch_scroll_absolute() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 SQLRETURN rc = SQLFetchScroll(stmt.get_handle(), SQL_FETCH_ABSOLUTE, 1);
                 
@@ -1,14 +1,25 @@
 #pragma once
 
 #include "test_base.hpp"
+#include <chrono>
 
 namespace odbc_crusher::tests {
 
+// Parameters of the async overlap benchmark (test_async_overlap)
+struct AsyncBenchmarkOptions {
+    int concurrency = 4;                                   // K statements in flight
+    std::chrono::microseconds poll_interval{100};          // First wait between polling rounds
+    double poll_backoff = 2.0;                             // Wait multiplier per round
+    std::chrono::microseconds max_poll_interval{10000};    // Upper bound on the wait
+    std::chrono::milliseconds timeout{30000};              // Cancel statements still running after this
+};
+
 // Advanced ODBC feature tests (Phase 9 + Phase 12 extensions)
 class AdvancedTests : public TestBase {
 public:
-    explicit AdvancedTests(core::OdbcConnection& conn)
-        : TestBase(conn) {}
+    explicit AdvancedTests(core::OdbcConnection& conn,
+                           AsyncBenchmarkOptions async_options = {})
+        : TestBase(conn), async_options_(async_options) {}
     
     std::vector<TestResult> run() override;
     std::string category_name() const override { return "Advanced Features"; }
@@ -17,6 +28,7 @@ private:
     TestResult test_cursor_types();
     TestResult test_array_binding();
     TestResult test_async_capability();
+    TestResult test_async_overlap();
     TestResult test_rowset_size();
     TestResult test_positioned_operations();
     TestResult test_statement_attributes();
@@ -26,6 +38,8 @@ private:
     TestResult test_fetch_scroll_first_last();
     TestResult test_fetch_scroll_absolute();
     TestResult test_cursor_scrollable_attr();
+    
+    AsyncBenchmarkOptions async_options_;
 };
 
 } // namespace odbc_crusher::tests
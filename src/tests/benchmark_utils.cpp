@@ -0,0 +1,90 @@
+#include "benchmark_utils.hpp"
+#include "core/odbc_statement.hpp"
+#include "core/odbc_error.hpp"
+#include <algorithm>
+#include <cstdint>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <sql.h>
+#include <sqlext.h>
+
+namespace odbc_crusher::tests {
+
+namespace {
+
+// Turns autocommit on for its lifetime, then restores the previous value
+class AutocommitOn {
+public:
+    explicit AutocommitOn(core::OdbcConnection& conn) : conn_(conn) {
+        SQLGetConnectAttr(conn_.get_handle(), SQL_ATTR_AUTOCOMMIT, &old_, 0, nullptr);
+        SQLSetConnectAttr(conn_.get_handle(), SQL_ATTR_AUTOCOMMIT,
+                          (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0);
+    }
+    ~AutocommitOn() {
+        SQLSetConnectAttr(conn_.get_handle(), SQL_ATTR_AUTOCOMMIT,
+                          (SQLPOINTER)(intptr_t)old_, 0);
+    }
+    AutocommitOn(const AutocommitOn&) = delete;
+    AutocommitOn& operator=(const AutocommitOn&) = delete;
+
+private:
+    core::OdbcConnection& conn_;
+    SQLUINTEGER old_ = SQL_AUTOCOMMIT_ON;
+};
+
+bool try_create(core::OdbcConnection& conn, const std::vector<std::string>& ddl,
+                std::string& error) {
+    for (const auto& sql : ddl) {
+        try {
+            core::OdbcStatement stmt(conn);
+            stmt.execute(sql);
+            return true;
+        } catch (const core::OdbcError& e) {
+            error = e.format_diagnostics();
+        } catch (...) {
+        }
+        // Clean up connection state after failed DDL
+        SQLEndTran(SQL_HANDLE_DBC, conn.get_handle(), SQL_ROLLBACK);
+    }
+    return false;
+}
+
+bool try_drop(core::OdbcConnection& conn, const std::string& table) {
+    try {
+        core::OdbcStatement stmt(conn);
+        stmt.execute("DROP TABLE " + table);
+        return true;
+    } catch (...) {
+        SQLEndTran(SQL_HANDLE_DBC, conn.get_handle(), SQL_ROLLBACK);
+        return false;
+    }
+}
+
+} // anonymous namespace
+
+double percentile(const std::vector<double>& sorted, double p) {
+    if (sorted.empty()) return 0.0;
+    size_t index = static_cast<size_t>(p * static_cast<double>(sorted.size() - 1) + 0.5);
+    return sorted[std::min(index, sorted.size() - 1)];
+}
+
+double micros_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+bool create_scratch_table(core::OdbcConnection& conn, const std::string& table,
+                          const std::vector<std::string>& ddl, std::string& error) {
+    AutocommitOn autocommit(conn);
+    if (try_create(conn, ddl, error)) return true;
+    try_drop(conn, table);
+    return try_create(conn, ddl, error);
+}
+
+bool drop_scratch_table(core::OdbcConnection& conn, const std::string& table) {
+    AutocommitOn autocommit(conn);
+    return try_drop(conn, table);
+}
+
+} // namespace odbc_crusher::tests
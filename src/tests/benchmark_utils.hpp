@@ -0,0 +1,33 @@
+#pragma once
+
+#include "core/odbc_connection.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+// Helpers shared by the benchmark categories: latency statistics and the
+// scratch tables the benchmarks create and drop.
+
+namespace odbc_crusher::tests {
+
+// Value at fraction `p` (0..1) of an ascending sample, by nearest rank;
+// 0 for an empty sample
+double percentile(const std::vector<double>& sorted, double p);
+
+// Microseconds elapsed since `start`
+double micros_since(std::chrono::steady_clock::time_point start);
+
+// Create a scratch table with the first statement in `ddl` the database
+// accepts (type names differ between databases). If none is accepted the
+// table probably survives from an earlier run, so it is dropped and the
+// statements are tried once more. The DDL runs with autocommit on, and
+// the previous setting is restored. On failure `error` holds the last
+// driver diagnostics.
+bool create_scratch_table(core::OdbcConnection& conn, const std::string& table,
+                          const std::vector<std::string>& ddl, std::string& error);
+
+// DROP TABLE with autocommit on, rolling back a failed drop so the
+// connection stays usable. Returns false if the drop failed.
+bool drop_scratch_table(core::OdbcConnection& conn, const std::string& table);
+
+} // namespace odbc_crusher::tests
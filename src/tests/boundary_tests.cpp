@@ -285,7 +285,7 @@ TestResult BoundaryTests::test_describecol_col0() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 SQLCHAR col_name[128] = {0};
                 SQLSMALLINT col_name_len = 0;
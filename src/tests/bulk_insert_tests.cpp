@@ -0,0 +1,355 @@
+#include "bulk_insert_tests.hpp"
+#include "benchmark_utils.hpp"
+#include "core/odbc_statement.hpp"
+#include "core/odbc_error.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <sql.h>
+#include <sqlext.h>
+
+namespace odbc_crusher::tests {
+
+namespace {
+
+constexpr size_t kNameLen = 32;
+
+// NAME value stored for a row
+void format_name(char* out, long id) {
+    std::snprintf(out, kNameLen, "row-%ld", id);
+}
+
+double rows_per_sec(uint64_t rows, std::chrono::microseconds elapsed) {
+    return elapsed.count() > 0 ? static_cast<double>(rows) * 1e6 / static_cast<double>(elapsed.count())
+                               : 0.0;
+}
+
+std::string statement_error(SQLHSTMT h) {
+    return core::OdbcError::from_handle(SQL_HANDLE_STMT, h).format_diagnostics();
+}
+
+} // anonymous namespace
+
+// ── Table lifecycle ──────────────────────────────────────────────────────────
+
+bool BulkInsertTests::create_test_table() {
+    return create_scratch_table(conn_, "ODBC_TEST_BULK",
+                                {"CREATE TABLE ODBC_TEST_BULK (ID INTEGER, NAME VARCHAR(32))"},
+                                last_ddl_error_);
+}
+
+void BulkInsertTests::drop_test_table() {
+    drop_scratch_table(conn_, "ODBC_TEST_BULK");
+}
+
+// ── run() ────────────────────────────────────────────────────────────────────
+
+std::vector<TestResult> BulkInsertTests::run() {
+    std::vector<TestResult> results;
+
+    if (!create_test_table()) {
+        TestResult r = make_result("test_bulk_insert_comparison",
+            "SQLBulkOperations/SQLExecute",
+            TestStatus::SKIP_INCONCLUSIVE,
+            "Batched inserts are faster than one SQLExecute per row",
+            "Could not create test table for the bulk insert benchmark",
+            Severity::INFO, ConformanceLevel::LEVEL_1,
+            "ODBC 3.x Arrays of Parameter Values; SQLBulkOperations");
+        std::string suggestion = "CREATE TABLE privilege is required on the connected database. ";
+        if (!last_ddl_error_.empty()) {
+            suggestion += "DDL error: " + last_ddl_error_;
+        }
+        r.suggestion = suggestion;
+        results.push_back(r);
+        return results;
+    }
+
+    results.push_back(test_bulk_insert_comparison());
+
+    drop_test_table();
+    return results;
+}
+
+// ── Insert methods ───────────────────────────────────────────────────────────
+
+BulkInsertTests::InsertRun BulkInsertTests::insert_row_by_row(long first_id) {
+    InsertRun run;
+    core::OdbcStatement stmt(conn_);
+    SQLHSTMT h = stmt.get_handle();
+
+    SQLINTEGER id = 0;
+    SQLLEN id_ind = 0;
+    char name[kNameLen] = {0};
+    SQLLEN name_ind = SQL_NTS;
+
+    SQLRETURN ret = SQLPrepare(h,
+        (SQLCHAR*)"INSERT INTO ODBC_TEST_BULK (ID, NAME) VALUES (?, ?)", SQL_NTS);
+    if (SQL_SUCCEEDED(ret)) {
+        ret = SQLBindParameter(h, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                               0, 0, &id, 0, &id_ind);
+    }
+    if (SQL_SUCCEEDED(ret)) {
+        ret = SQLBindParameter(h, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                               kNameLen, 0, name, kNameLen, &name_ind);
+    }
+    if (!SQL_SUCCEEDED(ret)) {
+        run.error = statement_error(h);
+        return run;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < options_.rows; ++i) {
+        id = static_cast<SQLINTEGER>(first_id + static_cast<long>(i));
+        format_name(name, id);
+        ret = SQLExecute(h);
+        if (!SQL_SUCCEEDED(ret)) {
+            run.error = statement_error(h);
+            break;
+        }
+        ++run.rows;
+    }
+    run.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    run.ok = run.rows == options_.rows;
+    return run;
+}
+
+BulkInsertTests::InsertRun BulkInsertTests::insert_param_array(long first_id) {
+    InsertRun run;
+    core::OdbcStatement stmt(conn_);
+    SQLHSTMT h = stmt.get_handle();
+
+    const size_t batch = std::max<size_t>(options_.batch_rows, 1);
+    std::vector<SQLINTEGER> ids(batch);
+    std::vector<SQLLEN> id_ind(batch, 0);
+    std::vector<char> names(batch * kNameLen);
+    std::vector<SQLLEN> name_ind(batch, SQL_NTS);
+    SQLULEN processed = 0;
+
+    SQLRETURN ret = SQLPrepare(h,
+        (SQLCHAR*)"INSERT INTO ODBC_TEST_BULK (ID, NAME) VALUES (?, ?)", SQL_NTS);
+    if (SQL_SUCCEEDED(ret)) {
+        ret = SQLSetStmtAttr(h, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER)SQL_PARAM_BIND_BY_COLUMN, 0);
+    }
+    if (SQL_SUCCEEDED(ret)) {
+        ret = SQLSetStmtAttr(h, SQL_ATTR_PARAMS_PROCESSED_PTR, &processed, 0);
+    }
+    if (SQL_SUCCEEDED(ret)) {
+        ret = SQLBindParameter(h, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                               0, 0, ids.data(), 0, id_ind.data());
+    }
+    if (SQL_SUCCEEDED(ret)) {
+        ret = SQLBindParameter(h, 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                               kNameLen, 0, names.data(), kNameLen, name_ind.data());
+    }
+    if (!SQL_SUCCEEDED(ret)) {
+        run.error = statement_error(h);
+        return run;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t done = 0; done < options_.rows;) {
+        size_t n = std::min(batch, options_.rows - done);
+        for (size_t i = 0; i < n; ++i) {
+            ids[i] = static_cast<SQLINTEGER>(first_id + static_cast<long>(done + i));
+            format_name(&names[i * kNameLen], ids[i]);
+        }
+        ret = SQLSetStmtAttr(h, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER)(uintptr_t)n, 0);
+        if (SQL_SUCCEEDED(ret)) {
+            ret = SQLExecute(h);
+        }
+        if (!SQL_SUCCEEDED(ret)) {
+            run.error = statement_error(h);
+            break;
+        }
+        run.rows += processed;
+        done += n;
+    }
+    run.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    run.ok = run.rows == options_.rows;
+    return run;
+}
+
+BulkInsertTests::InsertRun BulkInsertTests::insert_bulk_operations(long first_id) {
+    InsertRun run;
+
+    if (!function_supported(SQL_API_SQLBULKOPERATIONS)) {
+        run.supported = false;
+        return run;
+    }
+
+    core::OdbcStatement stmt(conn_);
+    SQLHSTMT h = stmt.get_handle();
+
+    // SQL_ADD needs an updatable cursor; drivers substitute what they
+    // support (01S02), so failures here are not fatal
+    SQLSetStmtAttr(h, SQL_ATTR_CURSOR_TYPE, (SQLPOINTER)SQL_CURSOR_KEYSET_DRIVEN, 0);
+    SQLSetStmtAttr(h, SQL_ATTR_CONCURRENCY, (SQLPOINTER)SQL_CONCUR_LOCK, 0);
+
+    const size_t batch = std::max<size_t>(options_.batch_rows, 1);
+    std::vector<SQLINTEGER> ids(batch);
+    std::vector<SQLLEN> id_ind(batch, 0);
+    std::vector<char> names(batch * kNameLen);
+    std::vector<SQLLEN> name_ind(batch, SQL_NTS);
+
+    SQLRETURN ret = SQLExecDirect(h,
+        (SQLCHAR*)"SELECT ID, NAME FROM ODBC_TEST_BULK WHERE 1 = 0", SQL_NTS);
+    if (SQL_SUCCEEDED(ret)) {
+        ret = SQLBindCol(h, 1, SQL_C_SLONG, ids.data(), 0, id_ind.data());
+    }
+    if (SQL_SUCCEEDED(ret)) {
+        ret = SQLBindCol(h, 2, SQL_C_CHAR, names.data(), kNameLen, name_ind.data());
+    }
+    if (!SQL_SUCCEEDED(ret)) {
+        run.error = statement_error(h);
+        return run;
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t done = 0; done < options_.rows;) {
+        size_t n = std::min(batch, options_.rows - done);
+        for (size_t i = 0; i < n; ++i) {
+            ids[i] = static_cast<SQLINTEGER>(first_id + static_cast<long>(done + i));
+            format_name(&names[i * kNameLen], ids[i]);
+        }
+        ret = SQLSetStmtAttr(h, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)(uintptr_t)n, 0);
+        if (SQL_SUCCEEDED(ret)) {
+            ret = SQLBulkOperations(h, SQL_ADD);
+        }
+        if (!SQL_SUCCEEDED(ret)) {
+            run.error = statement_error(h);
+            // Optional feature: HYC00 on the first rowset means unsupported
+            if (done == 0 && run.error.find("HYC00") != std::string::npos) {
+                run.supported = false;
+            }
+            break;
+        }
+        run.rows += n;
+        done += n;
+    }
+    run.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    SQLFreeStmt(h, SQL_CLOSE);
+    run.ok = run.rows == options_.rows;
+    return run;
+}
+
+// ── Test: Bulk Insert Comparison ─────────────────────────────────────────────
+TestResult BulkInsertTests::test_bulk_insert_comparison() {
+    TestResult result = make_result(
+        "test_bulk_insert_comparison",
+        "SQLBulkOperations/SQLExecute",
+        TestStatus::PASS,
+        "Arrays of parameters or SQLBulkOperations(SQL_ADD) insert rows faster than one SQLExecute per row",
+        "",
+        Severity::INFO,
+        ConformanceLevel::LEVEL_1,
+        "ODBC 3.x Arrays of Parameter Values; SQLBulkOperations"
+    );
+
+    try {
+        auto start_time = std::chrono::high_resolution_clock::now();
+
+        const long n = static_cast<long>(options_.rows);
+        InsertRun single = insert_row_by_row(1);
+        InsertRun arrays = insert_param_array(n + 1);
+        InsertRun bulk = insert_bulk_operations(2 * n + 1);
+
+        // The table must hold every row the methods reported
+        uint64_t reported = single.rows + arrays.rows + bulk.rows;
+        long long counted = -1;
+        {
+            core::OdbcStatement stmt(conn_);
+            SQLHSTMT h = stmt.get_handle();
+            if (SQL_SUCCEEDED(SQLExecDirect(h, (SQLCHAR*)"SELECT COUNT(*) FROM ODBC_TEST_BULK", SQL_NTS)) &&
+                SQL_SUCCEEDED(SQLFetch(h))) {
+                SQLBIGINT value = 0;
+                SQLLEN ind = 0;
+                if (SQL_SUCCEEDED(SQLGetData(h, 1, SQL_C_SBIGINT, &value, 0, &ind)) &&
+                    ind != SQL_NULL_DATA) {
+                    counted = static_cast<long long>(value);
+                }
+            }
+        }
+
+        const double base = rows_per_sec(single.rows, single.elapsed);
+        auto describe = [&](const char* label, const InsertRun& run) {
+            std::ostringstream part;
+            part << label << ": ";
+            if (!run.supported) {
+                part << "not supported";
+            } else if (!run.ok) {
+                part << "failed after " << run.rows << " rows";
+            } else {
+                double rate = rows_per_sec(run.rows, run.elapsed);
+                part << std::fixed << std::setprecision(0) << rate << " rows/s";
+                if (&run != &single && base > 0.0) {
+                    part << " (" << std::setprecision(1) << rate / base << "x)";
+                }
+            }
+            return part.str();
+        };
+        result.actual = std::to_string(options_.rows) + " rows, batches of " +
+                        std::to_string(options_.batch_rows) + "; " +
+                        describe("row-by-row", single) + "; " +
+                        describe("parameter arrays", arrays) + "; " +
+                        describe("SQLBulkOperations", bulk);
+
+        double best = 0.0;
+        for (const InsertRun* run : {&arrays, &bulk}) {
+            if (run->ok && base > 0.0) {
+                best = std::max(best, rows_per_sec(run->rows, run->elapsed) / base);
+            }
+        }
+
+        // Below this the row-by-row loop is too fast to compare against
+        constexpr std::chrono::microseconds kMinMeasurable{1000};
+
+        if (!single.ok) {
+            result.status = TestStatus::SKIP_INCONCLUSIVE;
+            result.diagnostic = single.error;
+        } else if ((arrays.supported && !arrays.ok) || (bulk.supported && !bulk.ok)) {
+            result.status = TestStatus::FAIL;
+            result.severity = Severity::ERR;
+            result.diagnostic = !arrays.ok ? arrays.error : bulk.error;
+        } else if (counted >= 0 && static_cast<uint64_t>(counted) != reported) {
+            result.status = TestStatus::FAIL;
+            result.severity = Severity::ERR;
+            result.actual += "; table holds " + std::to_string(counted) + " of " +
+                             std::to_string(reported) + " reported rows";
+            result.suggestion = "Every row reported inserted by SQLExecute or SQLBulkOperations "
+                                "must be stored";
+        } else if (single.elapsed < kMinMeasurable) {
+            result.status = TestStatus::SKIP_INCONCLUSIVE;
+            result.actual += "; row-by-row inserts finished too quickly to compare";
+        } else if (best >= 10.0) {
+            result.actual += "; batched insert path detected";
+        } else if (best < 1.5) {
+            result.status = TestStatus::FAIL;
+            result.severity = Severity::WARNING;
+            result.suggestion = "Batched inserts are no faster than one SQLExecute per row; the "
+                                "driver probably sends each parameter set or row separately. "
+                                "Send a whole parameter array or rowset in one round trip";
+        }
+
+        auto end_time = std::chrono::high_resolution_clock::now();
+        result.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+
+    } catch (const core::OdbcError& e) {
+        result.status = TestStatus::ERR;
+        result.actual = e.what();
+        result.diagnostic = e.format_diagnostics();
+    }
+
+    return result;
+}
+
+} // namespace odbc_crusher::tests
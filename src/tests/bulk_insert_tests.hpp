@@ -0,0 +1,54 @@
+#pragma once
+
+#include "test_base.hpp"
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace odbc_crusher::tests {
+
+// Parameters of the bulk insert benchmark (test_bulk_insert_comparison)
+struct BulkInsertOptions {
+    size_t rows = 10000;        // Rows inserted by each method
+    size_t batch_rows = 1000;   // Rows per parameter array or rowset
+};
+
+// Bulk Insert Tests
+// Inserts the same rows three ways — one SQLExecute per row, arrays of
+// parameters, and SQLBulkOperations(SQL_ADD) — and compares throughput.
+class BulkInsertTests : public TestBase {
+public:
+    explicit BulkInsertTests(core::OdbcConnection& conn, BulkInsertOptions options = {})
+        : TestBase(conn), options_(options) {}
+
+    std::vector<TestResult> run() override;
+    std::string category_name() const override { return "Bulk Insert"; }
+
+private:
+    // Table lifecycle — creates ODBC_TEST_BULK with autocommit ON, drops on cleanup
+    bool create_test_table();
+    void drop_test_table();
+
+    // Stores the last DDL error message for reporting in skip suggestions
+    std::string last_ddl_error_;
+
+    // Outcome of inserting options_.rows rows with one method
+    struct InsertRun {
+        bool supported = true;     // False when the driver lacks the method
+        bool ok = false;
+        uint64_t rows = 0;         // Rows reported inserted
+        std::chrono::microseconds elapsed{0};
+        std::string error;
+    };
+
+    // Each inserts IDs first_id .. first_id + options_.rows - 1
+    InsertRun insert_row_by_row(long first_id);
+    InsertRun insert_param_array(long first_id);
+    InsertRun insert_bulk_operations(long first_id);
+
+    TestResult test_bulk_insert_comparison();
+
+    BulkInsertOptions options_;
+};
+
+} // namespace odbc_crusher::tests
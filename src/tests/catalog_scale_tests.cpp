@@ -0,0 +1,362 @@
+#include "catalog_scale_tests.hpp"
+#include "benchmark_utils.hpp"
+#include "core/odbc_statement.hpp"
+#include "core/odbc_error.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <sql.h>
+#include <sqlext.h>
+
+namespace odbc_crusher::tests {
+
+namespace {
+
+constexpr const char* kTablePrefix = "ODBC_TEST_CAT_";
+
+bool same_name(const char* a, const std::string& b) {
+    size_t len = std::strlen(a);
+    if (len != b.size()) return false;
+    for (size_t i = 0; i < len; ++i) {
+        if (std::toupper(static_cast<unsigned char>(a[i])) != std::toupper(static_cast<unsigned char>(b[i]))) {
+            return false;
+        }
+    }
+    return true;
+}
+
+struct CallOutcome {
+    SQLRETURN ret = SQL_ERROR;
+    double us = 0.0;
+    size_t rows = 0;
+    bool found = false;     // A row's TABLE_NAME was expect_table
+};
+
+// Run one catalog function on `hstmt` and fetch its rows, reading TABLE_NAME
+// (column 3 of every catalog result set) as an application would. The time
+// covers the call and the fetch of every row.
+template <typename Call>
+CallOutcome timed_catalog_call(SQLHSTMT hstmt, Call call, const std::string& expect_table) {
+    CallOutcome outcome;
+    auto start = std::chrono::steady_clock::now();
+    outcome.ret = call(hstmt);
+    if (SQL_SUCCEEDED(outcome.ret)) {
+        char name[256];
+        SQLLEN ind = 0;
+        while (SQL_SUCCEEDED(SQLFetch(hstmt))) {
+            ++outcome.rows;
+            if (SQL_SUCCEEDED(SQLGetData(hstmt, 3, SQL_C_CHAR, name, sizeof(name), &ind)) &&
+                ind != SQL_NULL_DATA && !expect_table.empty() && same_name(name, expect_table)) {
+                outcome.found = true;
+            }
+        }
+    }
+    outcome.us = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    SQLFreeStmt(hstmt, SQL_CLOSE);
+    return outcome;
+}
+
+// A function the driver reports as not implemented
+bool is_unsupported(const core::SqlState& state) {
+    return state == "IM001" || state == "HYC00";
+}
+
+// `name` as a search pattern argument matching only itself: '_' and '%'
+// (both common in table names) prefixed with the driver's
+// SQL_SEARCH_PATTERN_ESCAPE. Unescaped, "ORDER_ITEMS" is a pattern and
+// drivers can't answer it with a lookup by name.
+std::string escape_pattern(const std::string& name, const std::string& escape) {
+    if (escape.empty()) return name;
+    std::string pattern;
+    pattern.reserve(name.size() + 4);
+    for (char c : name) {
+        if (c == '_' || c == '%' || escape.find(c) != std::string::npos) pattern += escape;
+        pattern += c;
+    }
+    return pattern;
+}
+
+} // anonymous namespace
+
+// ── Table lifecycle ──────────────────────────────────────────────────────────
+
+bool CatalogScaleTests::prepare_tables() {
+    // Use the catalog as it is unless asked to grow it
+    try {
+        core::OdbcStatement stmt(conn_);
+        if (SQL_SUCCEEDED(SQLTables(stmt.get_handle(), nullptr, 0, nullptr, 0,
+                                    (SQLCHAR*)"%", SQL_NTS, (SQLCHAR*)"TABLE", SQL_NTS))) {
+            char name[256];
+            SQLLEN ind = 0;
+            while (stmt.fetch()) {
+                if (SQL_SUCCEEDED(SQLGetData(stmt.get_handle(), 3, SQL_C_CHAR, name, sizeof(name), &ind)) &&
+                    ind != SQL_NULL_DATA) {
+                    table_names_.emplace_back(name);
+                }
+            }
+        }
+    } catch (const core::OdbcError&) {}
+    if (!options_.create_tables) return !table_names_.empty();
+    if (!table_names_.empty() && table_names_.size() >= options_.tables) return true;
+    table_names_.clear();
+
+    const size_t columns = std::max<size_t>(options_.columns, 1);
+    for (size_t i = 1; i <= options_.tables; ++i) {
+        std::string name = kTablePrefix + std::to_string(i);
+        std::string ddl = "CREATE TABLE " + name + " (C1 INTEGER NOT NULL PRIMARY KEY";
+        for (size_t c = 2; c <= columns; ++c) {
+            ddl += ", C" + std::to_string(c) + (c % 2 ? " INTEGER" : " VARCHAR(20)");
+        }
+        ddl += ")";
+
+        if (!create_scratch_table(conn_, name, {ddl}, last_ddl_error_)) {
+            drop_created_tables();
+            return false;
+        }
+        ++created_tables_;
+        table_names_.push_back(name);
+    }
+    return true;
+}
+
+void CatalogScaleTests::drop_created_tables() {
+    for (size_t i = 1; i <= created_tables_; ++i) {
+        drop_scratch_table(conn_, kTablePrefix + std::to_string(i));
+    }
+    created_tables_ = 0;
+}
+
+// ── run() ────────────────────────────────────────────────────────────────────
+
+std::vector<TestResult> CatalogScaleTests::run() {
+    std::vector<TestResult> results;
+
+    // Don't create thousands of tables for a driver that can't list them
+    if (!function_supported(SQL_API_SQLTABLES) || !function_supported(SQL_API_SQLCOLUMNS)) {
+        TestResult r = make_result("test_catalog_scaling",
+            "SQLTables/SQLColumns/SQLPrimaryKeys/SQLStatistics",
+            TestStatus::SKIP_UNSUPPORTED,
+            "Catalog functions stay fast as the catalog grows",
+            "SQLGetFunctions reports SQLTables or SQLColumns as not implemented",
+            Severity::INFO, ConformanceLevel::CORE,
+            "ODBC 3.x Catalog Functions");
+        r.suggestion = "SQLTables and SQLColumns are Core catalog functions";
+        results.push_back(r);
+        return results;
+    }
+
+    if (!prepare_tables()) {
+        TestResult r = make_result("test_catalog_scaling",
+            "SQLTables/SQLColumns/SQLPrimaryKeys/SQLStatistics",
+            TestStatus::SKIP_INCONCLUSIVE,
+            "Catalog functions stay fast as the catalog grows",
+            options_.create_tables ? "Could not create the tables for the catalog scaling benchmark"
+                                   : "SQLTables lists no tables to time",
+            Severity::INFO, ConformanceLevel::CORE,
+            "ODBC 3.x Catalog Functions");
+        if (!options_.create_tables) {
+            r.suggestion = "Connect to a database with tables, or pass --catalog-create-tables "
+                           "to create --catalog-tables tables for the benchmark";
+        } else {
+            std::string suggestion = "CREATE TABLE privilege is required on the connected database. ";
+            if (!last_ddl_error_.empty()) {
+                suggestion += "DDL error: " + last_ddl_error_;
+            }
+            r.suggestion = suggestion;
+        }
+        results.push_back(r);
+        return results;
+    }
+
+    results.push_back(test_catalog_scaling());
+    drop_created_tables();
+
+    return results;
+}
+
+// ── test_catalog_scaling ─────────────────────────────────────────────────────
+
+TestResult CatalogScaleTests::test_catalog_scaling() {
+    TestResult result = make_result(
+        "test_catalog_scaling",
+        "SQLTables/SQLColumns/SQLPrimaryKeys/SQLStatistics",
+        TestStatus::PASS,
+        "Exact-name catalog calls cost about one round trip and a full-schema sweep is one query per function",
+        "",
+        Severity::INFO,
+        ConformanceLevel::CORE,
+        "ODBC 3.x Catalog Functions; Arguments in Catalog Functions"
+    );
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    // Evenly spread sample of tables for the exact-name and pattern calls
+    const size_t tables = table_names_.size();
+    const size_t lookups = std::min(std::max<size_t>(options_.lookups, 1), tables);
+    std::vector<std::string> sample;
+    for (size_t i = 0; i < lookups; ++i) sample.push_back(table_names_[i * tables / lookups]);
+
+    core::OdbcStatement stmt(conn_);
+    SQLHSTMT hstmt = stmt.get_handle();
+
+    SQLCHAR escape_buf[8] = {0};
+    SQLSMALLINT escape_len = 0;
+    std::string escape;
+    if (SQL_SUCCEEDED(SQLGetInfo(conn_.get_handle(), SQL_SEARCH_PATTERN_ESCAPE,
+                                 escape_buf, sizeof(escape_buf), &escape_len))) {
+        escape = reinterpret_cast<char*>(escape_buf);
+    }
+
+    // Add a call to `run`; the first failure is kept, and a function the
+    // driver doesn't implement is marked unsupported
+    auto record = [&](CatalogRun& run, const CallOutcome& outcome, const std::string& expect,
+                      const char* function) {
+        if (!run.supported || !run.error.empty()) return;
+        if (!SQL_SUCCEEDED(outcome.ret)) {
+            core::SqlState state = core::SqlState::from_handle(SQL_HANDLE_STMT, hstmt);
+            if (is_unsupported(state)) {
+                run.supported = false;
+            } else {
+                run.error = core::OdbcError::from_handle(SQL_HANDLE_STMT, hstmt, function).format_diagnostics();
+            }
+            return;
+        }
+        run.call_us.push_back(outcome.us);
+        run.total_us += outcome.us;
+        run.rows += outcome.rows;
+        if (!expect.empty() && !outcome.found) ++run.missing;
+    };
+
+    // Full-schema sweep: every table, then every column of every table
+    CatalogRun sweep_tables, sweep_columns;
+    record(sweep_tables, timed_catalog_call(hstmt, [](SQLHSTMT h) {
+        return SQLTables(h, nullptr, 0, nullptr, 0, (SQLCHAR*)"%", SQL_NTS, (SQLCHAR*)"TABLE", SQL_NTS);
+    }, ""), "", "SQLTables");
+    record(sweep_columns, timed_catalog_call(hstmt, [](SQLHSTMT h) {
+        return SQLColumns(h, nullptr, 0, nullptr, 0, (SQLCHAR*)"%", SQL_NTS, (SQLCHAR*)"%", SQL_NTS);
+    }, ""), "", "SQLColumns");
+
+    // Exact names, and '%' patterns matching a handful of tables each.
+    // SQLTables and SQLColumns take patterns, so their names are escaped;
+    // SQLPrimaryKeys and SQLStatistics take plain names.
+    CatalogRun exact_tables, exact_columns, exact_keys, exact_stats, pattern_tables, pattern_columns;
+    for (const auto& name : sample) {
+        SQLCHAR* table = (SQLCHAR*)name.c_str();
+        std::string escaped = escape_pattern(name, escape);
+        SQLCHAR* table_pattern = (SQLCHAR*)escaped.c_str();
+        record(exact_tables, timed_catalog_call(hstmt, [&](SQLHSTMT h) {
+            return SQLTables(h, nullptr, 0, nullptr, 0, table_pattern, SQL_NTS, nullptr, 0);
+        }, name), name, "SQLTables");
+        record(exact_columns, timed_catalog_call(hstmt, [&](SQLHSTMT h) {
+            return SQLColumns(h, nullptr, 0, nullptr, 0, table_pattern, SQL_NTS, (SQLCHAR*)"%", SQL_NTS);
+        }, name), name, "SQLColumns");
+        record(exact_keys, timed_catalog_call(hstmt, [&](SQLHSTMT h) {
+            return SQLPrimaryKeys(h, nullptr, 0, nullptr, 0, table, SQL_NTS);
+        }, ""), "", "SQLPrimaryKeys");
+        record(exact_stats, timed_catalog_call(hstmt, [&](SQLHSTMT h) {
+            return SQLStatistics(h, nullptr, 0, nullptr, 0, table, SQL_NTS, SQL_INDEX_ALL, SQL_QUICK);
+        }, ""), "", "SQLStatistics");
+
+        // The name without its last character, then '%'
+        std::string prefix = escape_pattern(name.substr(0, name.size() - 1), escape) + "%";
+        SQLCHAR* pattern = (SQLCHAR*)prefix.c_str();
+        record(pattern_tables, timed_catalog_call(hstmt, [&](SQLHSTMT h) {
+            return SQLTables(h, nullptr, 0, nullptr, 0, pattern, SQL_NTS, nullptr, 0);
+        }, name), name, "SQLTables");
+        record(pattern_columns, timed_catalog_call(hstmt, [&](SQLHSTMT h) {
+            return SQLColumns(h, nullptr, 0, nullptr, 0, pattern, SQL_NTS, (SQLCHAR*)"%", SQL_NTS);
+        }, name), name, "SQLColumns");
+    }
+
+    CatalogRun* runs[] = {&sweep_tables, &sweep_columns, &exact_tables, &exact_columns,
+                          &exact_keys, &exact_stats, &pattern_tables, &pattern_columns};
+    for (CatalogRun* run : runs) std::sort(run->call_us.begin(), run->call_us.end());
+
+    auto per_second = [](double count, double us) { return us > 0.0 ? count * 1e6 / us : 0.0; };
+    const double sweep_us = sweep_tables.total_us + sweep_columns.total_us;
+    const double exact_columns_p50 = percentile(exact_columns.call_us, 0.50);
+    const size_t catalog_tables = sweep_tables.rows;
+
+    std::ostringstream actual;
+    actual << std::fixed << std::setprecision(1) << sweep_tables.rows << " tables, " << sweep_columns.rows
+           << " columns; full sweep " << sweep_us / 1000.0 << "ms (SQLTables "
+           << sweep_tables.total_us / 1000.0 << "ms, SQLColumns " << sweep_columns.total_us / 1000.0
+           << "ms, " << std::setprecision(0)
+           << per_second(static_cast<double>(sweep_tables.rows + sweep_columns.rows), sweep_us) << " rows/s)";
+    auto describe = [&](const char* label, const CatalogRun& run) {
+        actual << "; " << label;
+        if (!run.supported) {
+            actual << " not supported";
+            return;
+        }
+        actual << std::setprecision(1) << " p50 " << percentile(run.call_us, 0.50) << "us p99 "
+               << percentile(run.call_us, 0.99) << "us, " << std::setprecision(0)
+               << per_second(static_cast<double>(run.call_us.size()), run.total_us) << " calls/s, "
+               << per_second(static_cast<double>(run.rows), run.total_us) << " rows/s";
+    };
+    describe("exact SQLTables", exact_tables);
+    describe("exact SQLColumns", exact_columns);
+    describe("SQLPrimaryKeys", exact_keys);
+    describe("SQLStatistics", exact_stats);
+    describe("pattern SQLTables", pattern_tables);
+    describe("pattern SQLColumns", pattern_columns);
+    result.actual = actual.str();
+
+    // A catalog query costs at least a round trip to the server; below this
+    // the catalog is in the client and call counts don't matter
+    constexpr double kMinRoundTripUs = 100.0;
+    // Below this the sweep is too fast to compare against
+    constexpr double kMinMeasurableUs = 1000.0;
+
+    std::string error;
+    for (CatalogRun* run : runs) {
+        if (error.empty()) error = run->error;
+    }
+    const size_t missing = exact_tables.missing + exact_columns.missing +
+                           pattern_tables.missing + pattern_columns.missing;
+
+    if (!sweep_tables.supported || !sweep_columns.supported) {
+        result.status = TestStatus::SKIP_UNSUPPORTED;
+        result.suggestion = "SQLTables and SQLColumns are Core catalog functions";
+    } else if (!error.empty()) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::ERR;
+        result.diagnostic = error;
+    } else if (missing) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::ERR;
+        result.actual += "; " + std::to_string(missing) + " calls did not return the table they named";
+        result.suggestion = "A catalog call with a table's exact name, or a pattern covering it, "
+                            "must return that table";
+    } else if (sweep_us < kMinMeasurableUs) {
+        result.status = TestStatus::SKIP_INCONCLUSIVE;
+        result.actual += "; catalog calls finished too quickly to compare";
+    } else if (catalog_tables >= 100 && exact_columns_p50 >= kMinRoundTripUs &&
+               sweep_columns.total_us >= 0.5 * exact_columns_p50 * static_cast<double>(catalog_tables)) {
+        // One SQLColumns for the whole schema costs about as much as one per
+        // table: the driver runs a server query per table behind it
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::WARNING;
+        result.suggestion = "SQLColumns for every table costs as much as calling it once per table: "
+                            "the driver probably sends one query per table, so BI tools that read "
+                            "the schema at connect wait minutes on large catalogs";
+    } else if (catalog_tables >= 1000 && exact_columns_p50 > 0.1 * sweep_columns.total_us) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::WARNING;
+        result.suggestion = "SQLColumns for one table costs over a tenth of the full sweep: the driver "
+                            "probably reads the whole catalog and filters it on the client";
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    result.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+    return result;
+}
+
+} // namespace odbc_crusher::tests
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "test_base.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace odbc_crusher::tests {
+
+// Parameters of the catalog scaling benchmark (test_catalog_scaling)
+struct CatalogScaleOptions {
+    size_t tables = 100;        // Tables to create when create_tables is set
+    size_t columns = 20;        // Columns per created table
+    size_t lookups = 50;        // Exact-name and pattern calls per catalog function
+    bool create_tables = false; // Create tables when the catalog has fewer than `tables`
+};
+
+// Catalog Scale Tests
+// Times SQLTables, SQLColumns, SQLPrimaryKeys and SQLStatistics with exact
+// names, with '%' patterns and in the full-schema sweep BI tools run at
+// connect. Uses the tables already in the catalog (e.g. the mock driver's
+// Large preset scaled with CatalogTables/CatalogColumns); only with
+// options.create_tables does it create ODBC_TEST_CAT_<n> to reach
+// options.tables.
+class CatalogScaleTests : public TestBase {
+public:
+    explicit CatalogScaleTests(core::OdbcConnection& conn, CatalogScaleOptions options = {})
+        : TestBase(conn), options_(options) {}
+
+    std::vector<TestResult> run() override;
+    std::string category_name() const override { return "Catalog Scale"; }
+
+private:
+    // List the catalog's tables, creating them when asked to; fills table_names_
+    bool prepare_tables();
+    void drop_created_tables();
+
+    // Stores the last DDL error message for reporting in skip suggestions
+    std::string last_ddl_error_;
+
+    std::vector<std::string> table_names_;   // Every table in the catalog, or the created ones
+    size_t created_tables_ = 0;              // ODBC_TEST_CAT_1.. created by prepare_tables()
+
+    // Calls of one catalog function
+    struct CatalogRun {
+        bool supported = true;
+        std::vector<double> call_us;    // Per call including the fetch of every row, sorted
+        double total_us = 0.0;
+        size_t rows = 0;
+        size_t missing = 0;             // Exact-name calls that did not return the table
+        std::string error;
+    };
+
+    TestResult test_catalog_scaling();
+
+    CatalogScaleOptions options_;
+};
+
+} // namespace odbc_crusher::tests
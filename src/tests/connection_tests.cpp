@@ -1,10 +1,59 @@
 #include "connection_tests.hpp"
+#include "benchmark_utils.hpp"
 #include "core/odbc_statement.hpp"
 #include "core/odbc_error.hpp"
+#include <algorithm>
+#include <atomic>
+#include <iomanip>
+#include <memory>
 #include <sstream>
+#include <thread>
 
 namespace odbc_crusher::tests {
 
+namespace {
+
+// The cheapest query the data source accepts, or empty if none of these run
+std::string find_probe_query(core::OdbcConnection& conn) {
+    for (const char* query : {"SELECT 1", "SELECT 1 FROM RDB$DATABASE", "SELECT 1 FROM DUAL"}) {
+        try {
+            core::OdbcStatement stmt(conn);
+            if (stmt.try_execute(query)) return query;
+        } catch (const core::OdbcError&) {}
+    }
+    return {};
+}
+
+// Connect, run the probe query and fetch its rows, then disconnect,
+// recording the latency of the connect and of the query. Failures are
+// counted and the first one kept.
+void connect_cycle(core::OdbcConnection& conn, const std::string& connection_string,
+                   const std::string& probe, std::vector<double>& connect_us,
+                   std::vector<double>& query_us, size_t& failures, std::string& error) {
+    try {
+        auto start = std::chrono::steady_clock::now();
+        conn.connect(connection_string);
+        connect_us.push_back(micros_since(start));
+        if (!probe.empty()) {
+            start = std::chrono::steady_clock::now();
+            core::OdbcStatement stmt(conn);
+            stmt.try_execute(probe).throw_if_error("SQLExecDirect");
+            while (stmt.fetch()) {}
+            query_us.push_back(micros_since(start));
+        }
+        conn.disconnect();
+    } catch (const core::OdbcError& e) {
+        if (error.empty()) error = e.format_diagnostics();
+        ++failures;
+        // Leave the handle ready for the next cycle
+        try {
+            conn.disconnect();
+        } catch (const core::OdbcError&) {}
+    }
+}
+
+} // anonymous namespace
+
 std::vector<TestResult> ConnectionTests::run() {
     std::vector<TestResult> results;
     
@@ -14,6 +63,7 @@ std::vector<TestResult> ConnectionTests::run() {
     results.push_back(test_connection_attributes());
     results.push_back(test_connection_timeout());
     results.push_back(test_connection_pooling());
+    results.push_back(test_connect_latency());
     
     return results;
 }
@@ -286,4 +336,219 @@ TestResult ConnectionTests::test_connection_pooling() {
     return result;
 }
 
+// ── Connection establishment benchmark ──────────────────────────────────────
+
+ConnectionTests::ConnectRun ConnectionTests::run_cold_connects(const std::string& probe) {
+    ConnectRun run;
+    auto begin = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < options_.connects; ++i) {
+        try {
+            core::OdbcEnvironment env;
+            core::OdbcConnection conn(env);
+            connect_cycle(conn, conn_.connection_string(), probe, run.connect_us,
+                          run.query_us, run.failures, run.error);
+        } catch (const core::OdbcError& e) {
+            if (run.error.empty()) run.error = e.format_diagnostics();
+            ++run.failures;
+        }
+    }
+    run.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin);
+    return run;
+}
+
+ConnectionTests::ConnectRun ConnectionTests::run_reconnects(const std::string& probe) {
+    ConnectRun run;
+    try {
+        core::OdbcConnection conn(conn_.get_environment());
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < options_.connects; ++i) {
+            connect_cycle(conn, conn_.connection_string(), probe, run.connect_us,
+                          run.query_us, run.failures, run.error);
+        }
+        run.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin);
+    } catch (const core::OdbcError& e) {
+        run.error = e.format_diagnostics();
+        run.failures = options_.connects;
+    }
+    return run;
+}
+
+ConnectionTests::ConnectRun ConnectionTests::run_pooled_connects(const std::string& probe) {
+    ConnectRun run;
+    
+    // Pooling is a process-wide driver manager setting, read when an
+    // environment is allocated; only a driver manager accepts it
+    if (!SQL_SUCCEEDED(SQLSetEnvAttr(SQL_NULL_HENV, SQL_ATTR_CONNECTION_POOLING,
+                                     (SQLPOINTER)SQL_CP_ONE_PER_HENV, 0))) {
+        run.available = false;
+        return run;
+    }
+    
+    try {
+        core::OdbcEnvironment env;
+        auto begin = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < options_.connects; ++i) {
+            // A new handle each time: the pool, not the handle, keeps the
+            // connection open between iterations
+            core::OdbcConnection conn(env);
+            connect_cycle(conn, conn_.connection_string(), probe, run.connect_us,
+                          run.query_us, run.failures, run.error);
+        }
+        run.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - begin);
+    } catch (const core::OdbcError& e) {
+        if (run.error.empty()) run.error = e.format_diagnostics();
+        ++run.failures;
+    }
+    
+    // Environments allocated later, by this run or others, don't pool
+    SQLSetEnvAttr(SQL_NULL_HENV, SQL_ATTR_CONNECTION_POOLING, (SQLPOINTER)SQL_CP_OFF, 0);
+    return run;
+}
+
+ConnectionTests::ConnectRun ConnectionTests::run_connect_storm(const std::string& probe) {
+    ConnectRun run;
+    const size_t threads = options_.threads;
+    std::vector<ConnectRun> per_thread(threads);
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    
+    auto worker = [&](size_t t) {
+        ConnectRun& mine = per_thread[t];
+        std::unique_ptr<core::OdbcConnection> conn;
+        try {
+            conn = std::make_unique<core::OdbcConnection>(conn_.get_environment());
+        } catch (const core::OdbcError& e) {
+            mine.error = e.format_diagnostics();
+            mine.failures = options_.connects;
+        }
+        // Start together so the connects really overlap
+        ++ready;
+        while (!go) std::this_thread::yield();
+        if (!conn) return;
+        for (size_t i = 0; i < options_.connects; ++i) {
+            connect_cycle(*conn, conn_.connection_string(), probe, mine.connect_us,
+                          mine.query_us, mine.failures, mine.error);
+        }
+    };
+    
+    std::vector<std::thread> workers;
+    for (size_t t = 0; t < threads; ++t) workers.emplace_back(worker, t);
+    while (ready < threads) std::this_thread::yield();
+    auto begin = std::chrono::steady_clock::now();
+    go = true;
+    for (auto& w : workers) w.join();
+    run.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - begin);
+    
+    for (auto& mine : per_thread) {
+        run.connect_us.insert(run.connect_us.end(), mine.connect_us.begin(), mine.connect_us.end());
+        run.query_us.insert(run.query_us.end(), mine.query_us.begin(), mine.query_us.end());
+        run.failures += mine.failures;
+        if (run.error.empty()) run.error = mine.error;
+    }
+    return run;
+}
+
+TestResult ConnectionTests::test_connect_latency() {
+    TestResult result = make_result(
+        "test_connect_latency",
+        "SQLDriverConnect/SQLDisconnect",
+        TestStatus::PASS,
+        "Connections open reliably, sequentially and concurrently; concurrent connects overlap",
+        "",
+        Severity::INFO,
+        ConformanceLevel::CORE,
+        "ODBC 3.8 SQLDriverConnect; Driver Manager Connection Pooling"
+    );
+    
+    auto start_time = std::chrono::high_resolution_clock::now();
+    
+    const std::string probe = find_probe_query(conn_);
+    ConnectRun cold = run_cold_connects(probe);
+    ConnectRun reconnect = run_reconnects(probe);
+    ConnectRun pooled = run_pooled_connects(probe);
+    ConnectRun storm = run_connect_storm(probe);
+    for (ConnectRun* run : {&cold, &reconnect, &pooled, &storm}) {
+        std::sort(run->connect_us.begin(), run->connect_us.end());
+        std::sort(run->query_us.begin(), run->query_us.end());
+    }
+    
+    auto rate = [](const ConnectRun& run) {
+        double seconds = static_cast<double>(run.elapsed.count()) / 1e6;
+        return seconds > 0.0 ? static_cast<double>(run.connect_us.size()) / seconds : 0.0;
+    };
+    const double reconnect_p50 = percentile(reconnect.connect_us, 0.50);
+    const double pooled_p50 = percentile(pooled.connect_us, 0.50);
+    const double sequential_rate = rate(reconnect);
+    const double storm_rate = rate(storm);
+    
+    std::ostringstream actual;
+    actual << std::fixed << std::setprecision(1) << options_.connects << " connects per phase";
+    auto describe = [&](const char* label, const ConnectRun& run) {
+        actual << "; " << label << " p50 " << percentile(run.connect_us, 0.50) << "us p99 "
+               << percentile(run.connect_us, 0.99) << "us";
+        if (!run.query_us.empty()) {
+            actual << ", first query p50 " << percentile(run.query_us, 0.50) << "us";
+        }
+    };
+    describe("cold connect", cold);
+    describe("reconnect", reconnect);
+    if (!pooled.available) {
+        actual << "; DM pooling not available";
+    } else {
+        describe("pooled", pooled);
+        if (pooled_p50 > 0.0) {
+            actual << " (" << reconnect_p50 / pooled_p50 << "x reconnect)";
+        }
+    }
+    describe((std::to_string(options_.threads) + "-thread storm").c_str(), storm);
+    actual << ", " << std::setprecision(0) << storm_rate << " connects/s ("
+           << std::setprecision(1) << (sequential_rate > 0.0 ? storm_rate / sequential_rate : 0.0)
+           << "x sequential)";
+    if (probe.empty()) {
+        actual << "; no probe query ran, first query not timed";
+    }
+    result.actual = actual.str();
+    
+    // A connect that goes over the network costs at least this much; below
+    // it connects are in-process and thread overhead swamps any overlap
+    constexpr double kMinNetworkConnectUs = 1000.0;
+    
+    if (cold.failures || reconnect.failures || pooled.failures) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::ERR;
+        result.actual += "; " + std::to_string(cold.failures + reconnect.failures + pooled.failures) +
+                         " sequential connects failed";
+        result.diagnostic = !cold.error.empty() ? cold.error
+                          : !reconnect.error.empty() ? reconnect.error : pooled.error;
+        result.suggestion = "Connecting again with the string that opened the main connection failed";
+    } else if (storm.failures) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::WARNING;
+        result.actual += "; " + std::to_string(storm.failures) + " of " +
+                         std::to_string(options_.threads * options_.connects) +
+                         " concurrent connects failed";
+        result.diagnostic = storm.error;
+        result.suggestion = "Connects that succeed one at a time fail when several threads connect "
+                            "at once: the driver probably shares unprotected state between "
+                            "connections, or the server limits concurrent logins";
+    } else if (reconnect_p50 < kMinNetworkConnectUs) {
+        result.actual += "; connects too fast to judge overlap";
+    } else if (options_.threads > 1 && storm_rate < 1.5 * sequential_rate) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::WARNING;
+        result.suggestion = "Concurrent connects are barely faster than connecting one at a time: "
+                            "the driver or driver manager probably serializes SQLDriverConnect "
+                            "behind a global lock, so an application pool fills slowly after a "
+                            "restart or failover";
+    }
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    result.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+    return result;
+}
+
 } // namespace odbc_crusher::tests
@@ -1,14 +1,24 @@
 #pragma once
 
 #include "test_base.hpp"
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
 
 namespace odbc_crusher::tests {
 
+// Parameters of the connection establishment benchmark (test_connect_latency)
+struct ConnectBenchmarkOptions {
+    size_t connects = 20;   // Connections per phase, and per thread in the storm
+    size_t threads = 8;     // Threads in the concurrent connect storm
+};
+
 // Connection-related tests (Phase 3)
 class ConnectionTests : public TestBase {
 public:
-    explicit ConnectionTests(core::OdbcConnection& conn)
-        : TestBase(conn) {}
+    explicit ConnectionTests(core::OdbcConnection& conn, ConnectBenchmarkOptions options = {})
+        : TestBase(conn), options_(options) {}
     
     std::vector<TestResult> run() override;
     std::string category_name() const override { return "Connection Tests"; }
@@ -20,6 +30,28 @@ private:
     TestResult test_multiple_statements();
     TestResult test_connection_attributes();
     TestResult test_connection_pooling();
+    TestResult test_connect_latency();
+    
+    // Outcome of one phase of the connection benchmark
+    struct ConnectRun {
+        bool available = true;            // False when the phase could not be set up
+        std::vector<double> connect_us;   // Per SQLDriverConnect, sorted
+        std::vector<double> query_us;     // First query after each connect, sorted
+        std::chrono::microseconds elapsed{0};
+        size_t failures = 0;
+        std::string error;                // First failure
+    };
+    
+    // Fresh environment and connection handle for every connect
+    ConnectRun run_cold_connects(const std::string& probe);
+    // One connection handle connected and disconnected repeatedly
+    ConnectRun run_reconnects(const std::string& probe);
+    // Driver manager pooling on; disconnect returns the connection to the pool
+    ConnectRun run_pooled_connects(const std::string& probe);
+    // options_.threads threads connecting at once through one environment
+    ConnectRun run_connect_storm(const std::string& probe);
+    
+    ConnectBenchmarkOptions options_;
 };
 
 } // namespace odbc_crusher::tests
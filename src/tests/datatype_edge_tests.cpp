@@ -43,7 +43,7 @@ TestResult DataTypeEdgeCaseTests::test_integer_zero() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     SQLINTEGER value = -1;
                     SQLLEN indicator = 0;
@@ -105,7 +105,7 @@ TestResult DataTypeEdgeCaseTests::test_integer_max() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     SQLINTEGER value = 0;
                     SQLLEN indicator = 0;
@@ -167,7 +167,7 @@ TestResult DataTypeEdgeCaseTests::test_integer_min() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     SQLINTEGER value = 0;
                     SQLLEN indicator = 0;
@@ -229,7 +229,7 @@ TestResult DataTypeEdgeCaseTests::test_varchar_empty() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     char buffer[256] = {0};
                     SQLLEN indicator = 0;
@@ -296,7 +296,7 @@ TestResult DataTypeEdgeCaseTests::test_varchar_special_chars() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     char buffer[256] = {0};
                     SQLLEN indicator = 0;
@@ -357,7 +357,7 @@ TestResult DataTypeEdgeCaseTests::test_null_integer() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     SQLINTEGER value = 42;  // sentinel
                     SQLLEN indicator = 0;
@@ -423,7 +423,7 @@ TestResult DataTypeEdgeCaseTests::test_null_varchar() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     char buffer[256];
                     std::memset(buffer, 'X', sizeof(buffer));
@@ -487,7 +487,7 @@ TestResult DataTypeEdgeCaseTests::test_integer_as_string() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     char buffer[256] = {0};
                     SQLLEN indicator = 0;
@@ -554,7 +554,7 @@ TestResult DataTypeEdgeCaseTests::test_string_as_integer() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     SQLINTEGER value = 0;
                     SQLLEN indicator = 0;
@@ -626,7 +626,7 @@ TestResult DataTypeEdgeCaseTests::test_decimal_values() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     double value = 0.0;
                     SQLLEN indicator = 0;
@@ -49,7 +49,7 @@ TestResult DataTypeTests::test_integer_types() {
         bool success = false;
         for (const auto& query : test_queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 if (stmt.fetch()) {
                     SQLINTEGER value = 0;
@@ -113,7 +113,7 @@ TestResult DataTypeTests::test_decimal_types() {
         bool success = false;
         for (const auto& query : test_queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 if (stmt.fetch()) {
                     SQLDOUBLE value = 0.0;
@@ -179,7 +179,7 @@ TestResult DataTypeTests::test_float_types() {
         bool success = false;
         for (const auto& query : test_queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 if (stmt.fetch()) {
                     SQLDOUBLE value = 0.0;
@@ -245,7 +245,7 @@ TestResult DataTypeTests::test_string_types() {
         bool success = false;
         for (const auto& query : test_queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 if (stmt.fetch()) {
                     SQLCHAR buffer[256] = {0};
@@ -318,7 +318,7 @@ TestResult DataTypeTests::test_date_time_types() {
         bool success = false;
         for (const auto& query : test_queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 if (stmt.fetch()) {
                     SQL_DATE_STRUCT date_value;
@@ -389,7 +389,7 @@ TestResult DataTypeTests::test_null_values() {
         bool success = false;
         for (const auto& query : test_queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 if (stmt.fetch()) {
                     SQLINTEGER value = 0;
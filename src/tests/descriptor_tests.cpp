@@ -108,7 +108,7 @@ TestResult DescriptorTests::test_ird_after_prepare() {
         
         for (const auto& query : queries) {
             try {
-                stmt.prepare(query);
+                if (!stmt.try_prepare(query)) continue;
                 
                 // Get IRD handle
                 SQLHDESC ird = SQL_NULL_HDESC;
@@ -302,7 +302,7 @@ TestResult DescriptorTests::test_auto_populate_after_exec() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 // Check SQLNumResultCols (which reads from IRD)
                 SQLSMALLINT num_cols = 0;
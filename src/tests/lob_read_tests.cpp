@@ -0,0 +1,307 @@
+#include "lob_read_tests.hpp"
+#include "benchmark_utils.hpp"
+#include "core/odbc_statement.hpp"
+#include "core/odbc_error.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <sql.h>
+#include <sqlext.h>
+
+namespace odbc_crusher::tests {
+
+namespace {
+
+double to_mib(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+std::string format_size(size_t bytes) {
+    if (bytes >= 1024 * 1024 && bytes % (1024 * 1024) == 0) {
+        return std::to_string(bytes / (1024 * 1024)) + "MB";
+    }
+    if (bytes >= 1024 && bytes % 1024 == 0) {
+        return std::to_string(bytes / 1024) + "KB";
+    }
+    return std::to_string(bytes) + "B";
+}
+
+// Outcome of reading the value once with a fixed buffer size
+struct ChunkedRead {
+    SQLRETURN ret = SQL_SUCCESS;
+    uint64_t bytes = 0;            // Bytes placed in the buffer, excluding terminators
+    uint64_t calls = 0;            // SQLGetData calls that returned data
+    SQLLEN first_length = 0;       // Length reported by the first call
+    std::chrono::microseconds elapsed{0};
+};
+
+// Fetch the single row and drain column 1 with SQLGetData
+ChunkedRead read_in_chunks(SQLHSTMT h, SQLSMALLINT c_type, std::vector<char>& buffer) {
+    ChunkedRead read;
+    const SQLLEN buflen = static_cast<SQLLEN>(buffer.size());
+    const SQLLEN terminator = c_type == SQL_C_CHAR ? 1
+                            : c_type == SQL_C_WCHAR ? static_cast<SQLLEN>(sizeof(SQLWCHAR))
+                            : 0;
+
+    read.ret = SQLExecDirect(h, (SQLCHAR*)"SELECT DATA FROM ODBC_TEST_LOB_READ", SQL_NTS);
+    if (!SQL_SUCCEEDED(read.ret)) return read;
+    read.ret = SQLFetch(h);
+    if (!SQL_SUCCEEDED(read.ret)) return read;
+
+    auto start = std::chrono::steady_clock::now();
+    for (;;) {
+        SQLLEN ind = 0;
+        SQLRETURN ret = SQLGetData(h, 1, c_type, buffer.data(), buflen, &ind);
+        if (ret == SQL_NO_DATA) break;
+        if (!SQL_SUCCEEDED(ret) || ind == SQL_NULL_DATA) {
+            read.ret = ret;
+            break;
+        }
+        if (read.calls++ == 0) read.first_length = ind;
+
+        SQLLEN room = buflen - terminator;
+        if (c_type == SQL_C_WCHAR) room -= room % static_cast<SQLLEN>(sizeof(SQLWCHAR));
+        // A truncated piece fills the buffer as far as it goes
+        read.bytes += static_cast<uint64_t>(ind == SQL_NO_TOTAL ? room : std::min(ind, room));
+        if (ret == SQL_SUCCESS) break;
+    }
+    read.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start);
+    SQLFreeStmt(h, SQL_CLOSE);
+    return read;
+}
+
+} // anonymous namespace
+
+// ── Table lifecycle ──────────────────────────────────────────────────────────
+
+bool LobReadTests::create_test_table() {
+    // The long character type name differs between databases
+    if (!create_scratch_table(conn_, "ODBC_TEST_LOB_READ", {
+            "CREATE TABLE ODBC_TEST_LOB_READ (ID INTEGER, DATA CLOB)",
+            "CREATE TABLE ODBC_TEST_LOB_READ (ID INTEGER, DATA TEXT)",
+            "CREATE TABLE ODBC_TEST_LOB_READ (ID INTEGER, DATA VARCHAR(MAX))",
+            "CREATE TABLE ODBC_TEST_LOB_READ (ID INTEGER, DATA LONGTEXT)",
+            "CREATE TABLE ODBC_TEST_LOB_READ (ID INTEGER, DATA LONG VARCHAR)"
+        }, last_ddl_error_)) {
+        return false;
+    }
+
+    // Ensure autocommit ON so the value commits immediately
+    SQLUINTEGER old_ac = 0;
+    SQLGetConnectAttr(conn_.get_handle(), SQL_ATTR_AUTOCOMMIT, &old_ac, 0, nullptr);
+    SQLSetConnectAttr(conn_.get_handle(), SQL_ATTR_AUTOCOMMIT,
+                      (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0);
+    bool inserted = false;
+    try {
+        inserted = insert_test_value();
+    } catch (...) {
+    }
+
+    // Restore autocommit setting
+    SQLSetConnectAttr(conn_.get_handle(), SQL_ATTR_AUTOCOMMIT,
+                      (SQLPOINTER)(intptr_t)old_ac, 0);
+    return inserted;
+}
+
+bool LobReadTests::insert_test_value() {
+    core::OdbcStatement stmt(conn_);
+    SQLHSTMT h = stmt.get_handle();
+
+    SQLRETURN ret = SQLPrepare(h,
+        (SQLCHAR*)"INSERT INTO ODBC_TEST_LOB_READ (ID, DATA) VALUES (1, ?)", SQL_NTS);
+    if (!SQL_SUCCEEDED(ret)) {
+        last_ddl_error_ = core::OdbcError::from_handle(SQL_HANDLE_STMT, h).format_diagnostics();
+        return false;
+    }
+
+    // ASCII text, so the value has the same length as CHAR and BINARY and
+    // a known length as WCHAR
+    const uint64_t total = options_.lob_bytes;
+    std::vector<char> piece(std::min<uint64_t>(total, 1024 * 1024));
+    for (size_t i = 0; i < piece.size(); ++i) {
+        piece[i] = static_cast<char>('A' + i % 26);
+    }
+
+    SQLLEN data_ind = SQL_DATA_AT_EXEC;
+    const uint64_t max_announced = static_cast<uint64_t>(
+        std::numeric_limits<SQLLEN>::max() + SQL_LEN_DATA_AT_EXEC_OFFSET);
+    if (total <= max_announced) {
+        data_ind = SQL_LEN_DATA_AT_EXEC(static_cast<SQLLEN>(total));
+    }
+    SQLPOINTER token = reinterpret_cast<SQLPOINTER>(static_cast<intptr_t>(1));
+    ret = SQLBindParameter(h, 1, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_LONGVARCHAR,
+                           static_cast<SQLULEN>(total), 0, token, 0, &data_ind);
+    if (SQL_SUCCEEDED(ret)) {
+        ret = SQLExecute(h);
+    }
+
+    uint64_t sent = 0;
+    SQLPOINTER which = nullptr;
+    if (ret == SQL_NEED_DATA) {
+        ret = SQLParamData(h, &which);
+    }
+    while (ret == SQL_NEED_DATA) {
+        while (sent < total) {
+            size_t n = static_cast<size_t>(std::min<uint64_t>(piece.size(), total - sent));
+            ret = SQLPutData(h, piece.data(), static_cast<SQLLEN>(n));
+            if (!SQL_SUCCEEDED(ret)) break;
+            sent += n;
+        }
+        if (!SQL_SUCCEEDED(ret)) break;
+        ret = SQLParamData(h, &which);
+    }
+
+    if (!SQL_SUCCEEDED(ret)) {
+        last_ddl_error_ = core::OdbcError::from_handle(SQL_HANDLE_STMT, h).format_diagnostics();
+        SQLCancel(h);
+        return false;
+    }
+    return true;
+}
+
+void LobReadTests::drop_test_table() {
+    drop_scratch_table(conn_, "ODBC_TEST_LOB_READ");
+}
+
+// ── run() ────────────────────────────────────────────────────────────────────
+
+std::vector<TestResult> LobReadTests::run() {
+    std::vector<TestResult> results;
+
+    if (!create_test_table()) {
+        TestResult r = make_result("test_get_data_chunks",
+            "SQLGetData",
+            TestStatus::SKIP_INCONCLUSIVE,
+            "A LOB is read back in pieces with SQLGetData",
+            "Could not create and fill a table with a long character column",
+            Severity::INFO, ConformanceLevel::CORE,
+            "ODBC 3.x Getting Long Data");
+        std::string suggestion = "CREATE TABLE and INSERT privileges are required on the connected database. ";
+        if (!last_ddl_error_.empty()) {
+            suggestion += "Error: " + last_ddl_error_;
+        }
+        r.suggestion = suggestion;
+        results.push_back(r);
+        drop_test_table();
+        return results;
+    }
+
+    results.push_back(test_get_data_chunks("test_get_data_chunks_char", SQL_C_CHAR, "SQL_C_CHAR"));
+    results.push_back(test_get_data_chunks("test_get_data_chunks_wchar", SQL_C_WCHAR, "SQL_C_WCHAR"));
+    results.push_back(test_get_data_chunks("test_get_data_chunks_binary", SQL_C_BINARY, "SQL_C_BINARY"));
+
+    drop_test_table();
+    return results;
+}
+
+// ── Test: Chunked SQLGetData ─────────────────────────────────────────────────
+TestResult LobReadTests::test_get_data_chunks(const std::string& test_name,
+                                              SQLSMALLINT c_type,
+                                              const std::string& c_type_name) {
+    TestResult result = make_result(
+        test_name,
+        "SQLGetData(" + c_type_name + ")",
+        TestStatus::PASS,
+        "Repeated SQLGetData calls return the whole LOB in buffer-sized pieces with 01004",
+        "",
+        Severity::INFO,
+        ConformanceLevel::CORE,
+        "ODBC 3.x Getting Long Data"
+    );
+
+    try {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        auto finish = [&]() {
+            auto end_time = std::chrono::high_resolution_clock::now();
+            result.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+            return result;
+        };
+
+        core::OdbcStatement stmt(conn_);
+        SQLHSTMT h = stmt.get_handle();
+
+        const uint64_t expected = c_type == SQL_C_WCHAR
+            ? options_.lob_bytes * sizeof(SQLWCHAR)
+            : options_.lob_bytes;
+
+        // Chunk sizes grow by 4x; no point going past the size of the value
+        const size_t min_chunk = std::max<size_t>(options_.min_chunk_bytes, 16);
+        const size_t max_chunk = static_cast<size_t>(std::max<uint64_t>(
+            min_chunk, std::min<uint64_t>(options_.max_chunk_bytes, expected + sizeof(SQLWCHAR))));
+
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1)
+            << "Read " << to_mib(expected) << " MB:";
+        double best = 0.0;
+        double worst = std::numeric_limits<double>::max();
+        std::vector<char> buffer;
+
+        for (size_t chunk = min_chunk; chunk <= max_chunk; chunk *= 4) {
+            buffer.resize(chunk);
+            ChunkedRead read = read_in_chunks(h, c_type, buffer);
+
+            if (!SQL_SUCCEEDED(read.ret)) {
+                result.status = read.calls == 0 ? TestStatus::SKIP_INCONCLUSIVE : TestStatus::FAIL;
+                result.severity = read.calls == 0 ? Severity::INFO : Severity::ERR;
+                result.actual = "Reading with a " + format_size(chunk) + " buffer failed with return code " +
+                                std::to_string(read.ret);
+                result.diagnostic = core::OdbcError::from_handle(SQL_HANDLE_STMT, h).format_diagnostics();
+                SQLFreeStmt(h, SQL_CLOSE);
+                return finish();
+            }
+            if (read.bytes != expected) {
+                result.status = TestStatus::FAIL;
+                result.severity = Severity::ERR;
+                result.actual = "Reading with a " + format_size(chunk) + " buffer returned " +
+                                std::to_string(read.bytes) + " of " + std::to_string(expected) +
+                                " bytes in " + std::to_string(read.calls) + " calls";
+                result.suggestion = "Each SQLGetData call on the same column must continue where the "
+                                    "previous one stopped, returning 01004 until the last piece";
+                return finish();
+            }
+            if (read.first_length != SQL_NO_TOTAL &&
+                static_cast<uint64_t>(read.first_length) != expected) {
+                result.status = TestStatus::FAIL;
+                result.severity = Severity::WARNING;
+                result.actual = "The first SQLGetData call reported a length of " +
+                                std::to_string(read.first_length) + " instead of " +
+                                std::to_string(expected);
+                result.suggestion = "StrLen_or_IndPtr must hold the length of the data still "
+                                    "available, or SQL_NO_TOTAL";
+                return finish();
+            }
+
+            double seconds = static_cast<double>(read.elapsed.count()) / 1e6;
+            double mb_per_sec = seconds > 0.0 ? to_mib(read.bytes) / seconds : 0.0;
+            if (seconds > 0.0) {
+                best = std::max(best, mb_per_sec);
+                worst = std::min(worst, mb_per_sec);
+            }
+            oss << " " << format_size(chunk) << "=" << mb_per_sec << " MB/s";
+        }
+
+        if (best > 0.0 && worst < std::numeric_limits<double>::max()) {
+            oss << " (" << std::setprecision(1) << best / std::max(worst, 1e-9)
+                << "x between slowest and fastest)";
+        }
+        result.actual = oss.str();
+        return finish();
+
+    } catch (const core::OdbcError& e) {
+        result.status = TestStatus::ERR;
+        result.actual = e.what();
+        result.diagnostic = e.format_diagnostics();
+    }
+
+    return result;
+}
+
+} // namespace odbc_crusher::tests
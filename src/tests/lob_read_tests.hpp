@@ -0,0 +1,44 @@
+#pragma once
+
+#include "test_base.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace odbc_crusher::tests {
+
+// Parameters of the LOB read benchmark
+struct LobReadOptions {
+    uint64_t lob_bytes = 16ull * 1024 * 1024;   // Size of the value read back
+    size_t min_chunk_bytes = 1024;              // Smallest SQLGetData buffer
+    size_t max_chunk_bytes = 16 * 1024 * 1024;  // Largest SQLGetData buffer
+};
+
+// LOB Read Tests
+// Reads a long character value back with repeated SQLGetData calls as
+// SQL_C_CHAR, SQL_C_WCHAR and SQL_C_BINARY, sweeping the buffer size, and
+// measures throughput per chunk size.
+class LobReadTests : public TestBase {
+public:
+    explicit LobReadTests(core::OdbcConnection& conn, LobReadOptions options = {})
+        : TestBase(conn), options_(options) {}
+
+    std::vector<TestResult> run() override;
+    std::string category_name() const override { return "LOB Read"; }
+
+private:
+    // Table lifecycle — creates ODBC_TEST_LOB_READ with autocommit ON and
+    // inserts the value through a data-at-execution parameter
+    bool create_test_table();
+    bool insert_test_value();
+    void drop_test_table();
+
+    // Stores the last setup error message for reporting in skip suggestions
+    std::string last_ddl_error_;
+
+    TestResult test_get_data_chunks(const std::string& test_name, SQLSMALLINT c_type,
+                                    const std::string& c_type_name);
+
+    LobReadOptions options_;
+};
+
+} // namespace odbc_crusher::tests
@@ -0,0 +1,236 @@
+#include "lob_streaming_tests.hpp"
+#include "benchmark_utils.hpp"
+#include "core/odbc_statement.hpp"
+#include "core/odbc_error.hpp"
+#include "core/resource_usage.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <vector>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <sql.h>
+#include <sqlext.h>
+
+namespace odbc_crusher::tests {
+
+namespace {
+
+double to_mib(uint64_t bytes) {
+    return static_cast<double>(bytes) / (1024.0 * 1024.0);
+}
+
+} // anonymous namespace
+
+// ── Table lifecycle ──────────────────────────────────────────────────────────
+
+bool LobStreamingTests::create_test_table() {
+    // The long binary type name differs between databases
+    return create_scratch_table(conn_, "ODBC_TEST_LOB", {
+        "CREATE TABLE ODBC_TEST_LOB (ID INTEGER, DATA BLOB)",
+        "CREATE TABLE ODBC_TEST_LOB (ID INTEGER, DATA BYTEA)",
+        "CREATE TABLE ODBC_TEST_LOB (ID INTEGER, DATA VARBINARY(MAX))",
+        "CREATE TABLE ODBC_TEST_LOB (ID INTEGER, DATA LONGBLOB)",
+        "CREATE TABLE ODBC_TEST_LOB (ID INTEGER, DATA LONG VARBINARY)"
+    }, last_ddl_error_);
+}
+
+void LobStreamingTests::drop_test_table() {
+    drop_scratch_table(conn_, "ODBC_TEST_LOB");
+}
+
+// ── run() ────────────────────────────────────────────────────────────────────
+
+std::vector<TestResult> LobStreamingTests::run() {
+    std::vector<TestResult> results;
+
+    if (!create_test_table()) {
+        TestResult r = make_result("test_put_data_streaming",
+            "SQLParamData/SQLPutData",
+            TestStatus::SKIP_INCONCLUSIVE,
+            "A LOB streamed in chunks with SQLPutData is inserted",
+            "Could not create a table with a long binary column",
+            Severity::INFO, ConformanceLevel::CORE,
+            "ODBC 3.x Sending Long Data");
+        std::string suggestion = "CREATE TABLE privilege is required on the connected database. ";
+        if (!last_ddl_error_.empty()) {
+            suggestion += "DDL error: " + last_ddl_error_;
+        }
+        r.suggestion = suggestion;
+        results.push_back(r);
+        return results;
+    }
+
+    results.push_back(test_put_data_streaming());
+
+    drop_test_table();
+    return results;
+}
+
+// ── Test: Data-at-Execution Streaming ────────────────────────────────────────
+TestResult LobStreamingTests::test_put_data_streaming() {
+    TestResult result = make_result(
+        "test_put_data_streaming",
+        "SQLParamData/SQLPutData",
+        TestStatus::PASS,
+        "A LOB bound with SQL_LEN_DATA_AT_EXEC and sent in fixed-size SQLPutData chunks is inserted",
+        "",
+        Severity::INFO,
+        ConformanceLevel::CORE,
+        "ODBC 3.x Sending Long Data"
+    );
+
+    try {
+        auto start_time = std::chrono::high_resolution_clock::now();
+        auto finish = [&]() {
+            auto end_time = std::chrono::high_resolution_clock::now();
+            result.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+            return result;
+        };
+
+        core::OdbcStatement stmt(conn_);
+        SQLHSTMT h = stmt.get_handle();
+
+        SQLRETURN ret = SQLPrepare(h,
+            (SQLCHAR*)"INSERT INTO ODBC_TEST_LOB (ID, DATA) VALUES (?, ?)", SQL_NTS);
+        if (!SQL_SUCCEEDED(ret)) {
+            result.status = TestStatus::SKIP_INCONCLUSIVE;
+            result.actual = "Could not prepare parameterized INSERT";
+            return finish();
+        }
+
+        const uint64_t total = options_.lob_bytes;
+        const size_t chunk = std::max<size_t>(options_.chunk_bytes, 1);
+
+        // Announce the length when SQLLEN can carry it, so the driver can
+        // size its buffer once
+        SQLLEN data_ind = SQL_DATA_AT_EXEC;
+        const uint64_t max_announced = static_cast<uint64_t>(
+            std::numeric_limits<SQLLEN>::max() + SQL_LEN_DATA_AT_EXEC_OFFSET);
+        if (total <= max_announced) {
+            data_ind = SQL_LEN_DATA_AT_EXEC(static_cast<SQLLEN>(total));
+        }
+
+        SQLINTEGER id = 1;
+        SQLLEN id_ind = 0;
+        // Any value identifying the parameter when SQLParamData asks for it
+        SQLPOINTER token = reinterpret_cast<SQLPOINTER>(static_cast<intptr_t>(2));
+
+        ret = SQLBindParameter(h, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                               0, 0, &id, 0, &id_ind);
+        if (SQL_SUCCEEDED(ret)) {
+            ret = SQLBindParameter(h, 2, SQL_PARAM_INPUT, SQL_C_BINARY, SQL_LONGVARBINARY,
+                                   static_cast<SQLULEN>(total), 0, token, 0, &data_ind);
+        }
+        if (!SQL_SUCCEEDED(ret)) {
+            result.status = TestStatus::SKIP_INCONCLUSIVE;
+            result.actual = "Could not bind data-at-execution parameter";
+            return finish();
+        }
+
+        std::vector<unsigned char> buffer(chunk);
+        for (size_t i = 0; i < chunk; ++i) {
+            buffer[i] = static_cast<unsigned char>(i * 31 + 7);
+        }
+
+        uint64_t rss_before = core::peak_rss_bytes();
+        auto stream_start = std::chrono::steady_clock::now();
+
+        ret = SQLExecute(h);
+        if (ret != SQL_NEED_DATA) {
+            if (SQL_SUCCEEDED(ret)) {
+                result.status = TestStatus::FAIL;
+                result.severity = Severity::ERR;
+                result.actual = "SQLExecute returned " + std::to_string(ret) +
+                                " instead of SQL_NEED_DATA";
+                result.suggestion = "A parameter bound with SQL_LEN_DATA_AT_EXEC must make "
+                                    "SQLExecute return SQL_NEED_DATA until its value is sent";
+            } else {
+                result.status = TestStatus::SKIP_INCONCLUSIVE;
+                result.actual = "SQLExecute with a data-at-execution parameter failed";
+                result.diagnostic = core::OdbcError::from_handle(SQL_HANDLE_STMT, h).format_diagnostics();
+            }
+            return finish();
+        }
+
+        uint64_t sent = 0;
+        uint64_t chunks = 0;
+        bool unexpected_param = false;
+        SQLPOINTER which = nullptr;
+        ret = SQLParamData(h, &which);
+        while (ret == SQL_NEED_DATA) {
+            if (which != token) {
+                unexpected_param = true;
+                break;
+            }
+            while (sent < total) {
+                size_t n = static_cast<size_t>(std::min<uint64_t>(chunk, total - sent));
+                ret = SQLPutData(h, buffer.data(), static_cast<SQLLEN>(n));
+                if (!SQL_SUCCEEDED(ret)) break;
+                sent += n;
+                ++chunks;
+            }
+            if (!SQL_SUCCEEDED(ret)) break;
+            ret = SQLParamData(h, &which);
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - stream_start);
+        uint64_t rss_after = core::peak_rss_bytes();
+        uint64_t rss_growth = rss_after > rss_before ? rss_after - rss_before : 0;
+
+        double seconds = static_cast<double>(elapsed.count()) / 1e6;
+        double mb_per_sec = seconds > 0.0 ? to_mib(sent) / seconds : 0.0;
+
+        std::ostringstream oss;
+        oss << std::fixed << std::setprecision(1)
+            << "Streamed " << to_mib(sent) << " of " << to_mib(total) << " MB in "
+            << chunks << " chunks of " << chunk / 1024.0 << " KB in "
+            << std::setprecision(2) << elapsed.count() / 1000.0 << " ms: "
+            << std::setprecision(1) << mb_per_sec << " MB/s";
+        if (rss_after > 0) {
+            oss << "; peak RSS " << to_mib(rss_after) << " MB (+" << to_mib(rss_growth) << " MB)";
+        }
+        result.actual = oss.str();
+
+        // More than a few copies of the value in memory points at buffers
+        // that are re-copied as chunks arrive
+        constexpr uint64_t kMinMeasurable = 16ull * 1024 * 1024;
+
+        if (unexpected_param) {
+            result.status = TestStatus::FAIL;
+            result.severity = Severity::ERR;
+            result.actual += "; SQLParamData returned a pointer that was not bound";
+            result.suggestion = "SQLParamData must return the ParameterValuePtr bound for the "
+                                "data-at-execution parameter";
+            SQLCancel(h);
+        } else if (!SQL_SUCCEEDED(ret)) {
+            result.status = TestStatus::FAIL;
+            result.severity = Severity::ERR;
+            result.actual += "; streaming failed with return code " + std::to_string(ret);
+            result.diagnostic = core::OdbcError::from_handle(SQL_HANDLE_STMT, h).format_diagnostics();
+            SQLCancel(h);
+        } else if (total >= kMinMeasurable && rss_growth > 4 * total) {
+            result.status = TestStatus::FAIL;
+            result.severity = Severity::WARNING;
+            result.suggestion = "Peak memory grew by more than four times the LOB size; collect "
+                                "SQLPutData chunks into one buffer sized from SQL_LEN_DATA_AT_EXEC "
+                                "or grown geometrically";
+        }
+
+        return finish();
+
+    } catch (const core::OdbcError& e) {
+        result.status = TestStatus::ERR;
+        result.actual = e.what();
+        result.diagnostic = e.format_diagnostics();
+    }
+
+    return result;
+}
+
+} // namespace odbc_crusher::tests
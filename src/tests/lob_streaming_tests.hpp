@@ -0,0 +1,40 @@
+#pragma once
+
+#include "test_base.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace odbc_crusher::tests {
+
+// Parameters of the LOB streaming benchmark (test_put_data_streaming)
+struct LobBenchmarkOptions {
+    uint64_t lob_bytes = 16ull * 1024 * 1024;   // Size of the streamed value
+    size_t chunk_bytes = 64 * 1024;             // Bytes per SQLPutData call
+};
+
+// LOB Streaming Tests
+// Streams a large binary value into a table through data-at-execution
+// parameters (SQLParamData/SQLPutData) and measures throughput and memory.
+class LobStreamingTests : public TestBase {
+public:
+    explicit LobStreamingTests(core::OdbcConnection& conn,
+                               LobBenchmarkOptions options = {})
+        : TestBase(conn), options_(options) {}
+
+    std::vector<TestResult> run() override;
+    std::string category_name() const override { return "LOB Streaming"; }
+
+private:
+    // Table lifecycle — creates ODBC_TEST_LOB with autocommit ON, drops on cleanup
+    bool create_test_table();
+    void drop_test_table();
+
+    // Stores the last DDL error message for reporting in skip suggestions
+    std::string last_ddl_error_;
+
+    TestResult test_put_data_streaming();
+
+    LobBenchmarkOptions options_;
+};
+
+} // namespace odbc_crusher::tests
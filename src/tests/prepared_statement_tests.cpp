@@ -0,0 +1,301 @@
+#include "prepared_statement_tests.hpp"
+#include "benchmark_utils.hpp"
+#include "core/odbc_statement.hpp"
+#include "core/odbc_error.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+#include <sql.h>
+#include <sqlext.h>
+
+namespace odbc_crusher::tests {
+
+namespace {
+
+constexpr size_t kNameLen = 32;
+constexpr const char* kQuery = "SELECT NAME FROM ODBC_TEST_PREP WHERE ID = ?";
+
+// NAME value stored for a row
+void format_name(char* out, long id) {
+    std::snprintf(out, kNameLen, "row-%ld", id);
+}
+
+// Fetch the point query's row and check it is the one with this ID
+bool fetch_keyed_row(core::OdbcStatement& stmt, long id) {
+    if (!stmt.fetch()) return false;
+    char name[kNameLen] = {0};
+    SQLLEN ind = 0;
+    if (!SQL_SUCCEEDED(SQLGetData(stmt.get_handle(), 1, SQL_C_CHAR, name, sizeof(name), &ind))) {
+        return false;
+    }
+    char expected[kNameLen];
+    format_name(expected, id);
+    return std::strcmp(name, expected) == 0;
+}
+
+} // anonymous namespace
+
+// ── Table lifecycle ──────────────────────────────────────────────────────────
+
+bool PreparedStatementTests::create_test_table() {
+    try {
+        // Ensure autocommit ON so the rows commit immediately
+        SQLSetConnectAttr(conn_.get_handle(), SQL_ATTR_AUTOCOMMIT,
+                          (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0);
+
+        if (!create_scratch_table(conn_, "ODBC_TEST_PREP",
+                                  {"CREATE TABLE ODBC_TEST_PREP (ID INTEGER, NAME VARCHAR(32))"},
+                                  last_ddl_error_)) {
+            return false;
+        }
+
+        core::OdbcStatement insert(conn_);
+        insert.prepare("INSERT INTO ODBC_TEST_PREP (ID, NAME) VALUES (?, ?)");
+        SQLINTEGER id = 0;
+        char name[kNameLen] = {0};
+        SQLLEN name_ind = SQL_NTS;
+        SQLBindParameter(insert.get_handle(), 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                         0, 0, &id, 0, nullptr);
+        SQLBindParameter(insert.get_handle(), 2, SQL_PARAM_INPUT, SQL_C_CHAR, SQL_VARCHAR,
+                         kNameLen, 0, name, kNameLen, &name_ind);
+        for (size_t i = 1; i <= options_.rows; ++i) {
+            id = static_cast<SQLINTEGER>(i);
+            format_name(name, id);
+            insert.execute_prepared();
+        }
+        return true;
+    } catch (const core::OdbcError& e) {
+        last_ddl_error_ = e.format_diagnostics();
+        return false;
+    }
+}
+
+void PreparedStatementTests::drop_test_table() {
+    drop_scratch_table(conn_, "ODBC_TEST_PREP");
+}
+
+// ── run() ────────────────────────────────────────────────────────────────────
+
+std::vector<TestResult> PreparedStatementTests::run() {
+    std::vector<TestResult> results;
+
+    if (!create_test_table()) {
+        TestResult r = make_result("test_prepared_reuse",
+            "SQLPrepare/SQLExecute",
+            TestStatus::SKIP_INCONCLUSIVE,
+            "Executing a prepared statement is cheaper than SQLExecDirect",
+            "Could not create test table for the prepared statement benchmark",
+            Severity::INFO, ConformanceLevel::CORE,
+            "ODBC 3.x Prepared Execution");
+        std::string suggestion = "CREATE TABLE privilege is required on the connected database. ";
+        if (!last_ddl_error_.empty()) {
+            suggestion += "DDL error: " + last_ddl_error_;
+        }
+        r.suggestion = suggestion;
+        results.push_back(r);
+        return results;
+    }
+
+    results.push_back(test_prepared_reuse());
+
+    drop_test_table();
+    return results;
+}
+
+// ── Execution methods ────────────────────────────────────────────────────────
+// Execution i looks up ID (i % rows) + 1, so every method reads the same rows
+
+PreparedStatementTests::ReuseRun PreparedStatementTests::run_exec_direct() {
+    ReuseRun run;
+    const size_t rows = std::max<size_t>(options_.rows, 1);
+    try {
+        core::OdbcStatement stmt(conn_);
+        char sql[96];
+        run.execute_us.reserve(options_.executions);
+        for (size_t i = 0; i < options_.executions; ++i) {
+            long id = static_cast<long>(i % rows) + 1;
+            std::snprintf(sql, sizeof(sql), "SELECT NAME FROM ODBC_TEST_PREP WHERE ID = %ld", id);
+            auto start = std::chrono::steady_clock::now();
+            stmt.execute(sql);
+            bool found = fetch_keyed_row(stmt, id);
+            run.execute_us.push_back(micros_since(start));
+            if (!found) ++run.wrong_rows;
+        }
+        run.ok = true;
+    } catch (const core::OdbcError& e) {
+        run.error = e.format_diagnostics();
+    }
+    std::sort(run.execute_us.begin(), run.execute_us.end());
+    return run;
+}
+
+PreparedStatementTests::ReuseRun PreparedStatementTests::run_prepare_once() {
+    ReuseRun run;
+    const size_t rows = std::max<size_t>(options_.rows, 1);
+    try {
+        core::OdbcStatement stmt(conn_);
+        SQLINTEGER id = 0;
+        stmt.prepare(kQuery);
+        core::check_odbc_result(
+            SQLBindParameter(stmt.get_handle(), 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                             0, 0, &id, 0, nullptr),
+            SQL_HANDLE_STMT, stmt.get_handle(), "SQLBindParameter");
+        run.execute_us.reserve(options_.executions);
+        for (size_t i = 0; i < options_.executions; ++i) {
+            id = static_cast<SQLINTEGER>(i % rows) + 1;
+            auto start = std::chrono::steady_clock::now();
+            stmt.execute_prepared();
+            bool found = fetch_keyed_row(stmt, id);
+            run.execute_us.push_back(micros_since(start));
+            if (!found) ++run.wrong_rows;
+        }
+        run.ok = true;
+    } catch (const core::OdbcError& e) {
+        run.error = e.format_diagnostics();
+    }
+    std::sort(run.execute_us.begin(), run.execute_us.end());
+    return run;
+}
+
+PreparedStatementTests::ReuseRun PreparedStatementTests::run_reprepare() {
+    ReuseRun run;
+    const size_t rows = std::max<size_t>(options_.rows, 1);
+    try {
+        core::OdbcStatement stmt(conn_);
+        SQLINTEGER id = 0;
+        run.execute_us.reserve(options_.executions);
+        run.prepare_us.reserve(options_.executions);
+        for (size_t i = 0; i < options_.executions; ++i) {
+            id = static_cast<SQLINTEGER>(i % rows) + 1;
+            auto start = std::chrono::steady_clock::now();
+            // prepare() resets the parameters, so bind again each time
+            stmt.prepare(kQuery);
+            core::check_odbc_result(
+                SQLBindParameter(stmt.get_handle(), 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER,
+                                 0, 0, &id, 0, nullptr),
+                SQL_HANDLE_STMT, stmt.get_handle(), "SQLBindParameter");
+            run.prepare_us.push_back(micros_since(start));
+            stmt.execute_prepared();
+            bool found = fetch_keyed_row(stmt, id);
+            run.execute_us.push_back(micros_since(start));
+            if (!found) ++run.wrong_rows;
+        }
+        run.ok = true;
+    } catch (const core::OdbcError& e) {
+        run.error = e.format_diagnostics();
+    }
+    std::sort(run.execute_us.begin(), run.execute_us.end());
+    std::sort(run.prepare_us.begin(), run.prepare_us.end());
+    return run;
+}
+
+// ── Test: Prepared Statement Reuse ───────────────────────────────────────────
+TestResult PreparedStatementTests::test_prepared_reuse() {
+    TestResult result = make_result(
+        "test_prepared_reuse",
+        "SQLPrepare/SQLExecute",
+        TestStatus::PASS,
+        "Executing a prepared statement is cheaper than SQLExecDirect, so preparing pays off after a few executions",
+        "",
+        Severity::INFO,
+        ConformanceLevel::CORE,
+        "ODBC 3.x Prepared Execution; Direct Execution"
+    );
+
+    auto start_time = std::chrono::high_resolution_clock::now();
+
+    ReuseRun direct = run_exec_direct();
+    ReuseRun prepared = run_prepare_once();
+    ReuseRun reprepared = run_reprepare();
+
+    const double direct_p50 = percentile(direct.execute_us, 0.50);
+    const double prepared_p50 = percentile(prepared.execute_us, 0.50);
+    const double prepare_p50 = percentile(reprepared.prepare_us, 0.50);
+
+    std::ostringstream actual;
+    actual << std::fixed << std::setprecision(1) << options_.executions << " executions each; ";
+    auto describe = [&](const char* label, const ReuseRun& run) {
+        actual << label << " ";
+        if (!run.ok) {
+            actual << "failed after " << run.execute_us.size() << " executions";
+        } else {
+            actual << "p50 " << percentile(run.execute_us, 0.50) << "us p90 "
+                   << percentile(run.execute_us, 0.90) << "us p99 "
+                   << percentile(run.execute_us, 0.99) << "us";
+        }
+    };
+    describe("SQLExecDirect", direct);
+    actual << "; ";
+    describe("prepared once", prepared);
+    actual << "; ";
+    describe("re-prepared", reprepared);
+    if (reprepared.ok) {
+        actual << "; SQLPrepare p50 " << prepare_p50 << "us";
+    }
+
+    // Preparing once costs one SQLPrepare and saves the difference on every
+    // execution: it pays off once N * saving exceeds the prepare
+    const double saving = direct_p50 - prepared_p50;
+    if (direct.ok && prepared.ok && reprepared.ok) {
+        if (saving > 0.0) {
+            auto break_even = static_cast<long long>(std::max(1.0, std::ceil(prepare_p50 / saving)));
+            actual << "; break-even after " << break_even << " executions";
+        } else {
+            actual << "; preparing never breaks even";
+        }
+    }
+    result.actual = actual.str();
+
+    // Below this the direct loop is too fast to compare against
+    constexpr double kMinMeasurableUs = 1000.0;
+    double direct_total = 0.0;
+    for (double us : direct.execute_us) direct_total += us;
+
+    if (!direct.ok) {
+        result.status = TestStatus::SKIP_INCONCLUSIVE;
+        result.diagnostic = direct.error;
+    } else if (!prepared.ok || !reprepared.ok) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::ERR;
+        result.diagnostic = !prepared.ok ? prepared.error : reprepared.error;
+    } else if (direct.wrong_rows || prepared.wrong_rows || reprepared.wrong_rows) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::ERR;
+        result.actual += "; wrong or missing row in " +
+                         std::to_string(direct.wrong_rows + prepared.wrong_rows + reprepared.wrong_rows) +
+                         " executions";
+        result.suggestion = "Each execution must return the row whose ID was bound or embedded";
+    } else if (direct_total < kMinMeasurableUs) {
+        result.status = TestStatus::SKIP_INCONCLUSIVE;
+        result.actual += "; executions finished too quickly to compare";
+    } else if (prepare_p50 < 0.1 * direct_p50 && prepared_p50 >= 0.9 * direct_p50) {
+        // A server-side prepare costs about a round trip; one that costs
+        // nothing and saves nothing never left the client
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::INFO;
+        result.suggestion = "SQLPrepare returns almost at once and SQLExecute costs as much as "
+                            "SQLExecDirect: the driver probably emulates prepared statements and "
+                            "sends the full SQL text on every execution";
+    } else if (saving <= 0.0) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::WARNING;
+        result.suggestion = "Executing a prepared statement is no faster than SQLExecDirect, so "
+                            "applications gain nothing by preparing. The driver or server probably "
+                            "parses or plans the statement again on every SQLExecute";
+    }
+
+    auto end_time = std::chrono::high_resolution_clock::now();
+    result.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+    return result;
+}
+
+} // namespace odbc_crusher::tests
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "test_base.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace odbc_crusher::tests {
+
+// Parameters of the prepared statement reuse benchmark (test_prepared_reuse)
+struct PreparedStatementOptions {
+    size_t executions = 1000;   // Executions per method
+    size_t rows = 100;          // Rows in the queried table
+};
+
+// Prepared Statement Tests
+// Runs the same point query three ways — SQLExecDirect with a literal key,
+// one SQLPrepare followed by SQLExecute per key, and SQLPrepare before every
+// SQLExecute — and compares per-execution latency.
+class PreparedStatementTests : public TestBase {
+public:
+    explicit PreparedStatementTests(core::OdbcConnection& conn, PreparedStatementOptions options = {})
+        : TestBase(conn), options_(options) {}
+
+    std::vector<TestResult> run() override;
+    std::string category_name() const override { return "Prepared Statements"; }
+
+private:
+    // Table lifecycle — creates and fills ODBC_TEST_PREP, drops on cleanup
+    bool create_test_table();
+    void drop_test_table();
+
+    // Stores the last DDL error message for reporting in skip suggestions
+    std::string last_ddl_error_;
+
+    // Outcome of options_.executions executions with one method
+    struct ReuseRun {
+        bool ok = false;
+        std::vector<double> execute_us;   // Per execution, sorted; includes the fetch
+        std::vector<double> prepare_us;   // Per SQLPrepare and bind, sorted (re-prepare only)
+        size_t wrong_rows = 0;            // Executions that did not return the keyed row
+        std::string error;
+    };
+
+    ReuseRun run_exec_direct();
+    ReuseRun run_prepare_once();
+    ReuseRun run_reprepare();
+
+    TestResult test_prepared_reuse();
+
+    PreparedStatementOptions options_;
+};
+
+} // namespace odbc_crusher::tests
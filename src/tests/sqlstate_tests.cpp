@@ -20,29 +20,11 @@ std::vector<TestResult> SqlstateTests::run() {
 }
 
 std::string SqlstateTests::get_stmt_sqlstate(SQLHSTMT hstmt) {
-    SQLCHAR sqlstate[6] = {0};
-    SQLINTEGER native = 0;
-    SQLCHAR msg[256] = {0};
-    SQLSMALLINT msg_len = 0;
-    SQLRETURN rc = SQLGetDiagRec(SQL_HANDLE_STMT, hstmt, 1,
-                                 sqlstate, &native, msg, sizeof(msg), &msg_len);
-    if (SQL_SUCCEEDED(rc)) {
-        return std::string(reinterpret_cast<char*>(sqlstate));
-    }
-    return "";
+    return core::SqlState::from_handle(SQL_HANDLE_STMT, hstmt).str();
 }
 
 std::string SqlstateTests::get_conn_sqlstate(SQLHDBC hdbc) {
-    SQLCHAR sqlstate[6] = {0};
-    SQLINTEGER native = 0;
-    SQLCHAR msg[256] = {0};
-    SQLSMALLINT msg_len = 0;
-    SQLRETURN rc = SQLGetDiagRec(SQL_HANDLE_DBC, hdbc, 1,
-                                 sqlstate, &native, msg, sizeof(msg), &msg_len);
-    if (SQL_SUCCEEDED(rc)) {
-        return std::string(reinterpret_cast<char*>(sqlstate));
-    }
-    return "";
+    return core::SqlState::from_handle(SQL_HANDLE_DBC, hdbc).str();
 }
 
 TestResult SqlstateTests::test_execute_without_prepare() {
@@ -163,7 +145,7 @@ TestResult SqlstateTests::test_getdata_col0_no_bookmark() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     // Now try SQLGetData with column 0 (bookmark) when bookmarks aren't enabled
                     SQLINTEGER value = 0;
@@ -232,7 +214,7 @@ TestResult SqlstateTests::test_getdata_col_out_of_range() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 if (stmt.fetch()) {
                     // Try a column way beyond what exists
                     SQLINTEGER value = 0;
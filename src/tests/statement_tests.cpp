@@ -61,7 +61,7 @@ TestResult StatementTests::test_simple_query() {
         
         for (const auto& query : test_queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 success = true;
                 successful_query = query;
                 break;
@@ -119,7 +119,7 @@ TestResult StatementTests::test_prepared_statement() {
         bool success = false;
         for (const auto& query : test_queries) {
             try {
-                stmt.prepare(query);
+                if (!stmt.try_prepare(query)) continue;
                 stmt.execute_prepared();
                 success = true;
                 result.actual = "Successfully prepared and executed query";
@@ -180,7 +180,7 @@ TestResult StatementTests::test_parameter_binding() {
         
         for (const auto& query : test_queries) {
             try {
-                stmt.prepare(query);
+                if (!stmt.try_prepare(query)) continue;
                 
                 SQLRETURN ret = SQLBindParameter(
                     stmt.get_handle(),
@@ -262,7 +262,7 @@ TestResult StatementTests::test_result_fetching() {
         bool success = false;
         for (const auto& query : test_queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 if (stmt.fetch()) {
                     result.actual = "Successfully fetched result row";
@@ -317,7 +317,7 @@ TestResult StatementTests::test_column_metadata() {
         bool success = false;
         for (const auto& query : test_queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 SQLSMALLINT num_cols = 0;
                 SQLRETURN ret = SQLNumResultCols(stmt.get_handle(), &num_cols);
@@ -454,7 +454,7 @@ TestResult StatementTests::test_multiple_result_sets() {
         bool success = false;
         for (const auto& query : test_queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 stmt.fetch();
                 
                 // Check for more results
@@ -517,7 +517,7 @@ TestResult StatementTests::test_bind_col_integer() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 SQLINTEGER value = 0;
                 SQLLEN indicator = 0;
@@ -580,7 +580,7 @@ TestResult StatementTests::test_bind_col_string() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 SQLCHAR value[256] = {0};
                 SQLLEN indicator = 0;
@@ -639,7 +639,7 @@ TestResult StatementTests::test_fetch_bound_vs_getdata() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 // Bind column 1
                 SQLINTEGER bound_value = 0;
@@ -764,7 +764,7 @@ TestResult StatementTests::test_row_count() {
         
         for (const auto& query : queries) {
             try {
-                stmt.execute(query);
+                if (!stmt.try_execute(query)) continue;
                 
                 SQLLEN row_count = -1;
                 SQLRETURN rc = SQLRowCount(stmt.get_handle(), &row_count);
@@ -823,7 +823,7 @@ TestResult StatementTests::test_num_params() {
         
         for (const auto& query : queries) {
             try {
-                stmt.prepare(query);
+                if (!stmt.try_prepare(query)) continue;
                 
                 SQLSMALLINT num_params = -1;
                 SQLRETURN rc = SQLNumParams(stmt.get_handle(), &num_params);
@@ -887,7 +887,7 @@ TestResult StatementTests::test_describe_param() {
         
         for (const auto& query : queries) {
             try {
-                stmt.prepare(query);
+                if (!stmt.try_prepare(query)) continue;
                 
                 SQLSMALLINT sql_type = 0;
                 SQLULEN param_size = 0;
@@ -1,4 +1,5 @@
 #include "test_base.hpp"
+#include "discovery/capability_profile.hpp"
 
 namespace odbc_crusher::tests {
 
@@ -22,7 +23,40 @@ TestResult TestBase::make_result(
     result.expected = expected;
     result.actual = actual;
     result.duration = std::chrono::microseconds(0);
+    if (core::AllocProfiler::enabled()) {
+        // Start of this test's window; attribute_allocations() turns it into a delta
+        result.allocations = core::AllocProfiler::snapshot();
+    }
     return result;
 }
 
+bool TestBase::function_supported(SQLUSMALLINT function_id) const {
+    if (capabilities_) {
+        if (auto supported = capabilities_->supports_function(function_id)) {
+            return *supported;
+        }
+    }
+    SQLUSMALLINT exists = SQL_FALSE;
+    return SQL_SUCCEEDED(SQLGetFunctions(conn_.get_handle(), function_id, &exists)) &&
+           exists == SQL_TRUE;
+}
+
+void attribute_allocations(std::vector<TestResult>& results,
+                           const core::AllocStats& category_end) {
+    if (!core::AllocProfiler::enabled()) {
+        return;
+    }
+    
+    // Walk backwards so each window ends where the following one starts
+    core::AllocStats window_end = category_end;
+    for (auto it = results.rbegin(); it != results.rend(); ++it) {
+        if (!it->allocations) {
+            continue;
+        }
+        core::AllocStats start = *it->allocations;
+        it->allocations = window_end - start;
+        window_end = start;
+    }
+}
+
 } // namespace odbc_crusher::tests
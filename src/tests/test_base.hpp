@@ -1,11 +1,16 @@
 #pragma once
 
 #include "core/odbc_connection.hpp"
+#include "core/alloc_profiler.hpp"
 #include <string>
 #include <vector>
 #include <chrono>
 #include <optional>
 
+namespace odbc_crusher::discovery {
+class CapabilityProfile;
+}
+
 namespace odbc_crusher::tests {
 
 // Test status
@@ -46,6 +51,7 @@ struct TestResult {
     std::optional<std::string> diagnostic;
     std::optional<std::string> suggestion;
     std::chrono::microseconds duration;
+    std::optional<core::AllocStats> allocations;  // Only with --profile-allocations
 };
 
 // Base class for all ODBC tests
@@ -62,8 +68,18 @@ public:
     // Get test category name
     virtual std::string category_name() const = 0;
     
+    // What discovery found out about the driver, cached or live; not owned
+    void set_capabilities(const discovery::CapabilityProfile* capabilities) {
+        capabilities_ = capabilities;
+    }
+    
 protected:
     core::OdbcConnection& conn_;
+    const discovery::CapabilityProfile* capabilities_ = nullptr;
+    
+    // SQLGetFunctions for one function, answered from the capability
+    // profile when discovery recorded one
+    bool function_supported(SQLUSMALLINT function_id) const;
     
     // Helper to create test result
     TestResult make_result(
@@ -87,6 +103,12 @@ protected:
     }
 };
 
+// Turn the allocation snapshots taken by make_result() into per-test deltas.
+// Each test's window runs from its make_result() call to the next test's (the
+// last one ends at `category_end`). No-op unless the profiler is enabled.
+void attribute_allocations(std::vector<TestResult>& results,
+                           const core::AllocStats& category_end);
+
 // Helper to convert conformance level to string
 inline const char* conformance_to_string(ConformanceLevel level) {
     switch (level) {
@@ -1,10 +1,43 @@
 #include "transaction_tests.hpp"
+#include "benchmark_utils.hpp"
 #include "core/odbc_statement.hpp"
 #include "core/odbc_error.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iomanip>
+#include <memory>
+#include <random>
 #include <sstream>
+#include <thread>
 
 namespace odbc_crusher::tests {
 
+namespace {
+
+constexpr long kStartBalance = 1000;
+
+// Commits from one run of the concurrent commit benchmark
+struct CommitRun {
+    size_t writers = 0;
+    uint64_t commits = 0;
+    uint64_t conflicts = 0;                  // Transactions rolled back by a class 40 SQLSTATE
+    uint64_t failed_commits = 0;             // Of those, the ones SQLEndTran(SQL_COMMIT) refused
+    std::vector<double> commit_us;           // SQLEndTran(SQL_COMMIT) latency of each successful commit
+    std::chrono::microseconds elapsed{0};
+    std::string setup_error;                 // Connecting or creating the table failed
+    std::string error;                       // First failure that was not a conflict
+    bool balance_changed = false;            // The transfers did not preserve the total
+};
+
+// Class 40 is "transaction rollback": serialization failures (40001) and
+// deadlocks, which a writer retries
+bool is_conflict(const core::SqlState& sqlstate) {
+    return sqlstate.is_class("40");
+}
+
+} // anonymous namespace
+
 std::vector<TestResult> TransactionTests::run() {
     std::vector<TestResult> results;
     
@@ -13,6 +46,7 @@ std::vector<TestResult> TransactionTests::run() {
     results.push_back(test_manual_commit());
     results.push_back(test_manual_rollback());
     results.push_back(test_transaction_isolation_levels());
+    results.push_back(test_concurrent_commits());
     
     return results;
 }
@@ -537,4 +571,219 @@ TestResult TransactionTests::test_transaction_isolation_levels() {
     return result;
 }
 
+TestResult TransactionTests::test_concurrent_commits() {
+    TestResult result = make_result(
+        "test_concurrent_commits",
+        "SQLEndTran(SQL_COMMIT)",
+        TestStatus::PASS,
+        "Concurrent writers commit transfers atomically; conflicts roll back whole transactions",
+        "",
+        Severity::INFO,
+        ConformanceLevel::CORE,
+        "ODBC 3.8 SQLEndTran; SQLSTATE 40001"
+    );
+    
+    auto start_time = std::chrono::high_resolution_clock::now();
+    const size_t accounts = std::max<size_t>(options_.accounts, 2);
+    
+    // Connect the writers first: some drivers reset their state when a
+    // connection is opened
+    auto run_writers = [&](size_t writers) {
+        CommitRun run;
+        run.writers = writers;
+        std::vector<std::unique_ptr<core::OdbcConnection>> conns;
+        try {
+            for (size_t i = 0; i < writers; ++i) {
+                conns.push_back(std::make_unique<core::OdbcConnection>(conn_.get_environment()));
+                conns.back()->connect(conn_.connection_string());
+            }
+            
+            SQLSetConnectAttr(conn_.get_handle(), SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0);
+            core::OdbcStatement ddl(conn_);
+            try {
+                ddl.execute("DROP TABLE ODBC_TEST_TXN_BENCH");
+            } catch (const core::OdbcError&) {}
+            ddl.execute("CREATE TABLE ODBC_TEST_TXN_BENCH (ID INTEGER, BALANCE INTEGER)");
+            core::OdbcStatement seed(conn_);
+            seed.prepare("INSERT INTO ODBC_TEST_TXN_BENCH (ID, BALANCE) VALUES (?, ?)");
+            SQLINTEGER id = 0, balance = kStartBalance;
+            SQLBindParameter(seed.get_handle(), 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &id, 0, nullptr);
+            SQLBindParameter(seed.get_handle(), 2, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &balance, 0, nullptr);
+            for (size_t i = 1; i <= accounts; ++i) {
+                id = static_cast<SQLINTEGER>(i);
+                seed.execute_prepared();
+            }
+        } catch (const core::OdbcError& e) {
+            run.setup_error = e.format_diagnostics();
+            return run;
+        }
+        
+        std::atomic<uint64_t> commits{0}, conflicts{0}, failed_commits{0};
+        std::vector<std::vector<double>> latencies(writers);
+        std::vector<std::string> errors(writers);
+        auto writer = [&](size_t w) {
+            core::OdbcConnection& c = *conns[w];
+            SQLHDBC hdbc = c.get_handle();
+            SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_OFF, 0);
+            core::OdbcStatement debit(c), credit(c);
+            SQLINTEGER from = 0, to = 0;
+            SQLHSTMT hd = debit.get_handle(), hc = credit.get_handle();
+            if (!SQL_SUCCEEDED(SQLPrepare(hd, (SQLCHAR*)"UPDATE ODBC_TEST_TXN_BENCH SET BALANCE = BALANCE - 1 WHERE ID = ?", SQL_NTS)) ||
+                !SQL_SUCCEEDED(SQLPrepare(hc, (SQLCHAR*)"UPDATE ODBC_TEST_TXN_BENCH SET BALANCE = BALANCE + 1 WHERE ID = ?", SQL_NTS))) {
+                errors[w] = "SQLPrepare of the transfer UPDATEs failed with SQLSTATE " +
+                            core::SqlState::from_handle(SQL_HANDLE_STMT, hd).str();
+                return;
+            }
+            SQLBindParameter(hd, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &from, 0, nullptr);
+            SQLBindParameter(hc, 1, SQL_PARAM_INPUT, SQL_C_SLONG, SQL_INTEGER, 0, 0, &to, 0, nullptr);
+            
+            std::mt19937 rng(static_cast<unsigned>(w + 1));
+            std::uniform_int_distribution<SQLINTEGER> pick(1, static_cast<SQLINTEGER>(accounts));
+            auto& lat = latencies[w];
+            // A writer that keeps conflicting gives up rather than spin
+            const size_t max_attempts = options_.transactions * 20 + 100;
+            size_t attempts = 0;
+            for (size_t done = 0; done < options_.transactions;) {
+                if (++attempts > max_attempts) {
+                    errors[w] = "Gave up after " + std::to_string(max_attempts) + " attempts, " +
+                                std::to_string(done) + " committed";
+                    break;
+                }
+                from = pick(rng);
+                do { to = pick(rng); } while (to == from);
+                
+                core::SqlState state;
+                SQLRETURN ret = SQLExecute(hd);
+                if (!SQL_SUCCEEDED(ret)) state = core::SqlState::from_handle(SQL_HANDLE_STMT, hd);
+                if (SQL_SUCCEEDED(ret)) {
+                    SQLFreeStmt(hd, SQL_CLOSE);
+                    ret = SQLExecute(hc);
+                    if (!SQL_SUCCEEDED(ret)) state = core::SqlState::from_handle(SQL_HANDLE_STMT, hc);
+                    SQLFreeStmt(hc, SQL_CLOSE);
+                }
+                if (SQL_SUCCEEDED(ret)) {
+                    auto before = std::chrono::steady_clock::now();
+                    ret = SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_COMMIT);
+                    if (SQL_SUCCEEDED(ret)) {
+                        lat.push_back(std::chrono::duration<double, std::micro>(
+                            std::chrono::steady_clock::now() - before).count());
+                        ++commits;
+                        ++done;
+                        continue;
+                    }
+                    ++failed_commits;
+                    state = core::SqlState::from_handle(SQL_HANDLE_DBC, hdbc);
+                }
+                SQLEndTran(SQL_HANDLE_DBC, hdbc, SQL_ROLLBACK);
+                if (!is_conflict(state)) {
+                    errors[w] = "Transfer failed with SQLSTATE " + state.str();
+                    return;
+                }
+                ++conflicts;
+            }
+            SQLSetConnectAttr(hdbc, SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0);
+        };
+        
+        auto begin = std::chrono::high_resolution_clock::now();
+        std::vector<std::thread> threads;
+        for (size_t w = 0; w < writers; ++w) threads.emplace_back(writer, w);
+        for (auto& t : threads) t.join();
+        run.elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::high_resolution_clock::now() - begin);
+        
+        run.commits = commits;
+        run.conflicts = conflicts;
+        run.failed_commits = failed_commits;
+        for (auto& lat : latencies) run.commit_us.insert(run.commit_us.end(), lat.begin(), lat.end());
+        std::sort(run.commit_us.begin(), run.commit_us.end());
+        for (auto& e : errors) {
+            if (run.error.empty() && !e.empty()) run.error = e;
+        }
+        
+        // Transfers move balance between rows: whatever committed, the
+        // total must be unchanged
+        if (run.error.empty()) {
+            try {
+                core::OdbcStatement check(conn_);
+                check.execute("SELECT BALANCE FROM ODBC_TEST_TXN_BENCH");
+                long long total = 0;
+                size_t rows = 0;
+                while (check.fetch()) {
+                    SQLBIGINT value = 0;
+                    SQLLEN ind = 0;
+                    SQLGetData(check.get_handle(), 1, SQL_C_SBIGINT, &value, 0, &ind);
+                    total += value;
+                    ++rows;
+                }
+                if (rows != accounts || total != static_cast<long long>(accounts) * kStartBalance) {
+                    run.balance_changed = true;
+                    run.error = "Balances total " + std::to_string(total) + " over " +
+                                std::to_string(rows) + " rows after the transfers, expected " +
+                                std::to_string(static_cast<long long>(accounts) * kStartBalance) +
+                                " over " + std::to_string(accounts);
+                }
+            } catch (const core::OdbcError& e) {
+                run.error = e.format_diagnostics();
+            }
+        }
+        return run;
+    };
+    
+    std::vector<CommitRun> runs;
+    runs.push_back(run_writers(1));
+    if (options_.writers > 1 && runs[0].setup_error.empty() && runs[0].error.empty()) {
+        runs.push_back(run_writers(options_.writers));
+    }
+    
+    // Drop the table; the writers are gone, so this connection can
+    try {
+        SQLSetConnectAttr(conn_.get_handle(), SQL_ATTR_AUTOCOMMIT, (SQLPOINTER)SQL_AUTOCOMMIT_ON, 0);
+        core::OdbcStatement drop(conn_);
+        drop.execute("DROP TABLE ODBC_TEST_TXN_BENCH");
+    } catch (const core::OdbcError&) {}
+    
+    std::ostringstream actual;
+    actual << std::fixed;
+    for (const auto& run : runs) {
+        if (&run != &runs.front()) actual << "; ";
+        uint64_t attempts = run.commits + run.conflicts;
+        double seconds = static_cast<double>(run.elapsed.count()) / 1e6;
+        actual << run.writers << (run.writers == 1 ? " writer: " : " writers: ")
+               << std::setprecision(0) << (seconds > 0.0 ? static_cast<double>(run.commits) / seconds : 0.0)
+               << " commits/s, commit p50 " << std::setprecision(1) << percentile(run.commit_us, 0.50)
+               << "us p99 " << percentile(run.commit_us, 0.99) << "us, "
+               << std::setprecision(1) << (attempts ? 100.0 * static_cast<double>(run.conflicts) / static_cast<double>(attempts) : 0.0)
+               << "% conflicts (" << run.failed_commits << " at commit)";
+    }
+    result.actual = actual.str();
+    
+    const CommitRun& last = runs.back();
+    if (!last.setup_error.empty()) {
+        result.status = TestStatus::SKIP_INCONCLUSIVE;
+        result.actual = "Could not set up concurrent transfers with " + std::to_string(last.writers) +
+                        (last.writers == 1 ? " writer" : " writers");
+        result.diagnostic = last.setup_error;
+        result.suggestion = "The benchmark needs CREATE TABLE rights and one extra connection per writer";
+    } else if (last.balance_changed) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::CRITICAL;
+        result.diagnostic = last.error;
+        result.suggestion = "A commit must publish all of a transaction's writes or none, and a "
+                            "conflicting transaction must be rolled back whole";
+    } else if (!last.error.empty()) {
+        result.status = TestStatus::FAIL;
+        result.severity = Severity::ERR;
+        result.diagnostic = last.error;
+    } else if (runs.size() > 1 && runs[1].conflicts * 2 > runs[1].commits) {
+        // More than a third of transactions rolled back
+        result.severity = Severity::WARNING;
+        result.suggestion = "Concurrent writers conflict heavily; the driver or server may lock "
+                            "more than the rows a transaction writes";
+    }
+    
+    auto end_time = std::chrono::high_resolution_clock::now();
+    result.duration = std::chrono::duration_cast<std::chrono::microseconds>(end_time - start_time);
+    return result;
+}
+
 } // namespace odbc_crusher::tests
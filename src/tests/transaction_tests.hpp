@@ -1,14 +1,22 @@
 #pragma once
 
 #include "test_base.hpp"
+#include <cstddef>
 
 namespace odbc_crusher::tests {
 
+// Parameters of the concurrent commit benchmark (test_concurrent_commits)
+struct TransactionBenchmarkOptions {
+    size_t writers = 4;             // Connections committing at once
+    size_t transactions = 500;      // Committed transfers per writer
+    size_t accounts = 100;          // Rows the transfers pick from; fewer means more conflicts
+};
+
 // Transaction tests (Phase 8)
 class TransactionTests : public TestBase {
 public:
-    explicit TransactionTests(core::OdbcConnection& conn)
-        : TestBase(conn) {}
+    explicit TransactionTests(core::OdbcConnection& conn, TransactionBenchmarkOptions options = {})
+        : TestBase(conn), options_(options) {}
     
     std::vector<TestResult> run() override;
     std::string category_name() const override { return "Transaction Tests"; }
@@ -20,12 +28,19 @@ private:
     TestResult test_manual_rollback();
     TestResult test_transaction_isolation_levels();
     
+    // Transfers between rows of ODBC_TEST_TXN_BENCH from 1 and then
+    // options_.writers connections at once, each transfer one transaction;
+    // reports commit latency percentiles, commits/s and the conflict rate
+    TestResult test_concurrent_commits();
+    
     // Helper to create test table
     bool create_test_table();
     void drop_test_table();
     
     // Stores the last DDL error message for reporting in skip suggestions
     std::string last_ddl_error_;
+    
+    TransactionBenchmarkOptions options_;
 };
 
 } // namespace odbc_crusher::tests
@@ -2,6 +2,8 @@
 #include "tests/advanced_tests.hpp"
 #include "core/odbc_environment.hpp"
 #include "core/odbc_connection.hpp"
+#include "mock_connection.hpp"
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
@@ -90,3 +92,28 @@ TEST_F(AdvancedTestsTest, RunMySQLAdvancedTests) {
     std::cout << "\n";
     EXPECT_GT(passed + skipped, 0);
 }
+
+TEST_F(AdvancedTestsTest, AsyncOverlapWithMockLatency) {
+    core::OdbcConnection conn(*env);
+    try {
+        conn.connect(std::string(test::get_mock_connection()) + "Latency=20ms;");
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+    
+    tests::AsyncBenchmarkOptions options;
+    options.concurrency = 4;
+    tests::AdvancedTests tests(conn, options);
+    auto results = tests.run();
+    
+    auto it = std::find_if(results.begin(), results.end(), [](const tests::TestResult& r) {
+        return r.test_name == "test_async_overlap";
+    });
+    ASSERT_NE(it, results.end());
+    std::cout << it->actual << "\n";
+    
+    // The mock runs async statements on its worker pool, so four 20ms
+    // executions overlap instead of taking 80ms back to back
+    EXPECT_EQ(it->status, tests::TestStatus::PASS) << it->actual;
+    EXPECT_NE(it->actual.find("4/4 returned SQL_STILL_EXECUTING"), std::string::npos);
+}
@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+#include "core/alloc_profiler.hpp"
+#include "core/odbc_environment.hpp"
+#include "core/odbc_connection.hpp"
+#include "core/odbc_statement.hpp"
+#include "tests/cursor_stress_tests.hpp"
+#include "mock_connection.hpp"
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace odbc_crusher;
+
+namespace {
+
+// Keeps allocations observable so the compiler cannot elide them
+std::vector<std::unique_ptr<std::string>> g_sink;
+
+} // anonymous namespace
+
+class AllocProfilerTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        core::AllocProfiler::reset();
+        core::AllocProfiler::set_enabled(true);
+    }
+
+    void TearDown() override {
+        core::AllocProfiler::set_enabled(false);
+        g_sink.clear();
+    }
+};
+
+TEST_F(AllocProfilerTest, CountsAllocationsWhileEnabled) {
+    auto before = core::AllocProfiler::snapshot();
+    for (int i = 0; i < 10; ++i) {
+        g_sink.push_back(std::make_unique<std::string>(256, 'x'));
+    }
+    auto delta = core::AllocProfiler::snapshot() - before;
+
+    EXPECT_GE(delta.allocations, 20u);  // unique_ptr target + string buffer each
+    EXPECT_GE(delta.bytes_allocated, 10u * 256u);
+
+    g_sink.clear();
+    auto after_free = core::AllocProfiler::snapshot() - before;
+    EXPECT_GE(after_free.deallocations, 20u);
+}
+
+TEST_F(AllocProfilerTest, IgnoresAllocationsWhileDisabled) {
+    core::AllocProfiler::set_enabled(false);
+    auto before = core::AllocProfiler::snapshot();
+    g_sink.push_back(std::make_unique<std::string>(256, 'x'));
+    auto delta = core::AllocProfiler::snapshot() - before;
+
+    EXPECT_EQ(delta.allocations, 0u);
+}
+
+TEST_F(AllocProfilerTest, AttributesToInnermostCallScope) {
+    {
+        core::AllocProfiler::CallScope outer("SQLTestOuter");
+        g_sink.push_back(std::make_unique<std::string>(256, 'a'));
+        {
+            core::AllocProfiler::CallScope inner("SQLTestInner");
+            g_sink.push_back(std::make_unique<std::string>(256, 'b'));
+            g_sink.push_back(std::make_unique<std::string>(256, 'c'));
+            core::AllocProfiler::add_rows_fetched(2);
+        }
+    }
+
+    const core::CallAllocStats* outer = nullptr;
+    const core::CallAllocStats* inner = nullptr;
+    auto stats = core::AllocProfiler::per_call_stats();
+    for (const auto& s : stats) {
+        if (s.function == "SQLTestOuter") outer = &s;
+        if (s.function == "SQLTestInner") inner = &s;
+    }
+    ASSERT_NE(outer, nullptr);
+    ASSERT_NE(inner, nullptr);
+
+    EXPECT_EQ(outer->calls, 1u);
+    EXPECT_EQ(inner->calls, 1u);
+    EXPECT_GE(outer->stats.allocations, 2u);
+    EXPECT_GE(inner->stats.allocations, 4u);
+    EXPECT_EQ(inner->stats.rows_fetched, 2u);
+    EXPECT_EQ(outer->stats.rows_fetched, 0u);
+    EXPECT_GT(inner->stats.allocations_per_row(), 0.0);
+}
+
+TEST_F(AllocProfilerTest, AttributesFetchedRowsAndTestWindows) {
+    core::OdbcEnvironment env;
+    core::OdbcConnection conn(env);
+    try {
+        conn.connect(test::get_connection_or_mock("FIREBIRD_ODBC_CONNECTION", "Mock"));
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+
+    {
+        core::OdbcStatement stmt(conn);
+        stmt.execute("SELECT * FROM CUSTOMERS");
+        while (stmt.fetch()) {
+        }
+    }
+
+    bool saw_fetch = false;
+    for (const auto& s : core::AllocProfiler::per_call_stats()) {
+        if (s.function == "SQLFetch") {
+            saw_fetch = true;
+            EXPECT_GT(s.calls, 0u);
+            EXPECT_GT(s.stats.rows_fetched, 0u);
+        }
+    }
+    EXPECT_TRUE(saw_fetch);
+
+    // Every result of a category carries its own allocation window
+    tests::CursorStressTests suite(conn);
+    auto results = suite.run();
+    tests::attribute_allocations(results, core::AllocProfiler::snapshot());
+    ASSERT_FALSE(results.empty());
+    for (const auto& r : results) {
+        ASSERT_TRUE(r.allocations.has_value()) << r.test_name;
+        EXPECT_GT(r.allocations->allocations, 0u) << r.test_name;
+    }
+}
@@ -0,0 +1,42 @@
+#include <gtest/gtest.h>
+#include "tests/bulk_insert_tests.hpp"
+#include "core/odbc_environment.hpp"
+#include "core/odbc_connection.hpp"
+#include "mock_connection.hpp"
+#include <iostream>
+
+using namespace odbc_crusher;
+
+class BulkInsertTestsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        env = std::make_unique<core::OdbcEnvironment>();
+    }
+    std::unique_ptr<core::OdbcEnvironment> env;
+};
+
+TEST_F(BulkInsertTestsTest, ComparesInsertMethodsThroughMockDriver) {
+    core::OdbcConnection conn(*env);
+    try {
+        conn.connect(test::get_mock_connection());
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+    
+    tests::BulkInsertOptions options;
+    options.rows = 5000;
+    options.batch_rows = 500;
+    tests::BulkInsertTests test_suite(conn, options);
+    auto results = test_suite.run();
+    
+    ASSERT_EQ(results.size(), 1u);
+    const auto& r = results[0];
+    std::cout << "[" << tests::status_to_string(r.status) << "] " << r.test_name
+              << ": " << r.actual << "\n";
+    
+    // The mock driver implements both batched paths and stores every row
+    EXPECT_NE(r.status, tests::TestStatus::FAIL) << r.actual << r.diagnostic.value_or("");
+    EXPECT_NE(r.status, tests::TestStatus::ERR) << r.actual << r.diagnostic.value_or("");
+    EXPECT_NE(r.actual.find("SQLBulkOperations: "), std::string::npos) << r.actual;
+    EXPECT_EQ(r.actual.find("not supported"), std::string::npos) << r.actual;
+}
@@ -0,0 +1,241 @@
+#include <gtest/gtest.h>
+#include "discovery/capability_profile.hpp"
+#include "discovery/driver_info.hpp"
+#include "discovery/type_info.hpp"
+#include "discovery/function_info.hpp"
+#include "tests/catalog_scale_tests.hpp"
+#include "core/odbc_environment.hpp"
+#include "core/odbc_connection.hpp"
+#include "core/odbc_error.hpp"
+#include "mock_connection.hpp"
+#include <filesystem>
+#include <fstream>
+
+using namespace odbc_crusher;
+using discovery::CapabilityProfile;
+
+class CapabilityProfileTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        dir = std::filesystem::temp_directory_path() /
+              ("odbc_crusher_profile_" +
+               std::string(::testing::UnitTest::GetInstance()->current_test_info()->name()));
+        std::filesystem::remove_all(dir);
+        key = {"mockodbc.so", "01.00.0000", "MockDB", "1.0"};
+    }
+
+    void TearDown() override {
+        std::error_code ec;
+        std::filesystem::remove_all(dir, ec);
+    }
+
+    std::string path() const { return CapabilityProfile::path_for(dir.string(), key); }
+
+    static discovery::DataTypeInfo make_type(const std::string& name, SQLSMALLINT data_type) {
+        discovery::DataTypeInfo t{};
+        t.type_name = name;
+        t.data_type = data_type;
+        t.column_size = 255;
+        t.literal_prefix = "'";
+        t.literal_suffix = "'";
+        t.create_params = "length";
+        t.nullable = SQL_NULLABLE;
+        t.local_type_name = name + "\twith\ttabs";
+        t.num_prec_radix = 10;
+        return t;
+    }
+
+    std::filesystem::path dir;
+    CapabilityProfile::Key key;
+};
+
+TEST_F(CapabilityProfileTest, SaveAndLoadRoundTrip) {
+    CapabilityProfile profile(key);
+    EXPECT_FALSE(profile.modified());
+    profile.record_info_string(SQL_IDENTIFIER_QUOTE_CHAR, std::string("\""));
+    profile.record_info_string(SQL_CATALOG_TERM, std::string("multi\nline \\ text"));
+    profile.record_info_string(SQL_PROCEDURES, std::nullopt);
+    profile.record_info_uint(SQL_STRING_FUNCTIONS, 0x00FFFFFFu);
+    profile.record_info_uint(SQL_OJ_CAPABILITIES, std::nullopt);
+    profile.record_types({make_type("VARCHAR", SQL_VARCHAR), make_type("INTEGER", SQL_INTEGER)});
+    CapabilityProfile::FunctionBitmap bitmap{};
+    bitmap[SQL_API_SQLTABLES / 16] = static_cast<SQLUSMALLINT>(1u << (SQL_API_SQLTABLES % 16));
+    profile.record_functions(bitmap);
+    EXPECT_TRUE(profile.modified());
+
+    profile.save(path());
+
+    auto loaded = CapabilityProfile::load(path(), key);
+    ASSERT_TRUE(loaded.has_value());
+    EXPECT_FALSE(loaded->modified());
+    EXPECT_TRUE(loaded->key() == key);
+
+    ASSERT_NE(loaded->find_info_string(SQL_IDENTIFIER_QUOTE_CHAR), nullptr);
+    EXPECT_EQ(*loaded->find_info_string(SQL_IDENTIFIER_QUOTE_CHAR), std::string("\""));
+    EXPECT_EQ(*loaded->find_info_string(SQL_CATALOG_TERM), std::string("multi\nline \\ text"));
+    ASSERT_NE(loaded->find_info_string(SQL_PROCEDURES), nullptr);
+    EXPECT_FALSE(loaded->find_info_string(SQL_PROCEDURES)->has_value());
+    EXPECT_EQ(loaded->find_info_string(SQL_SCHEMA_TERM), nullptr);
+    EXPECT_EQ(*loaded->find_info_uint(SQL_STRING_FUNCTIONS), SQLUINTEGER(0x00FFFFFFu));
+    EXPECT_FALSE(loaded->find_info_uint(SQL_OJ_CAPABILITIES)->has_value());
+
+    ASSERT_NE(loaded->types(), nullptr);
+    ASSERT_EQ(loaded->types()->size(), 2u);
+    EXPECT_EQ((*loaded->types())[0].type_name, "VARCHAR");
+    EXPECT_EQ((*loaded->types())[0].local_type_name, "VARCHAR\twith\ttabs");
+    EXPECT_EQ((*loaded->types())[1].data_type, SQL_INTEGER);
+    EXPECT_EQ((*loaded->types())[1].num_prec_radix, 10);
+
+    EXPECT_EQ(loaded->supports_function(SQL_API_SQLTABLES), std::optional<bool>(true));
+    EXPECT_EQ(loaded->supports_function(SQL_API_SQLCOLUMNS), std::optional<bool>(false));
+    EXPECT_EQ(CapabilityProfile(key).supports_function(SQL_API_SQLTABLES), std::nullopt);
+}
+
+TEST_F(CapabilityProfileTest, RejectsOtherKeysAndDamagedFiles) {
+    EXPECT_FALSE(CapabilityProfile::load(path(), key).has_value());   // missing
+
+    CapabilityProfile profile(key);
+    profile.record_types({make_type("CHAR", SQL_CHAR)});
+    profile.save(path());
+    ASSERT_TRUE(CapabilityProfile::load(path(), key).has_value());
+
+    // A new driver or server version is a different profile
+    auto upgraded = key;
+    upgraded.dbms_ver = "2.0";
+    EXPECT_FALSE(CapabilityProfile::load(path(), upgraded).has_value());
+    EXPECT_NE(upgraded.file_name(), key.file_name());
+
+    // Truncated: the last type row is missing
+    {
+        std::ifstream in(path());
+        std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        content.resize(content.rfind("\nt\t") + 1);
+        std::ofstream out(path(), std::ios::trunc);
+        out << content;
+    }
+    EXPECT_FALSE(CapabilityProfile::load(path(), key).has_value());
+
+    // Another format version
+    {
+        std::ofstream out(path(), std::ios::trunc);
+        out << "odbc-crusher capability profile 0\n";
+    }
+    EXPECT_FALSE(CapabilityProfile::load(path(), key).has_value());
+}
+
+TEST_F(CapabilityProfileTest, FileNameIsSafe) {
+    CapabilityProfile::Key odd{"C:\\drivers\\my driver?.dll", "1", "", ""};
+    std::string name = odd.file_name();
+    EXPECT_EQ(name.find_first_of("\\/:?* "), std::string::npos) << name;
+    EXPECT_EQ(name.rfind(".profile"), name.size() - 8);
+    EXPECT_EQ(CapabilityProfile::Key{}.file_name().rfind("driver-", 0), 0u);
+}
+
+TEST_F(CapabilityProfileTest, ConnectionOptionsAreInTheKey) {
+    using Key = CapabilityProfile::Key;
+    const std::string base = "Driver={Mock ODBC Driver};Mode=Success;Catalog=Default;";
+    std::string plain = Key::hash_connection_string(base);
+
+    // Credentials, keyword case and attribute order don't matter
+    EXPECT_EQ(Key::hash_connection_string(base + "UID=alice;PWD=secret;"), plain);
+    EXPECT_EQ(Key::hash_connection_string("catalog=Default; MODE=Success;Driver={Mock ODBC Driver}"), plain);
+
+    // Options that change what discovery sees do
+    EXPECT_NE(Key::hash_connection_string(base + "Types=BasicTypes;"), plain);
+    EXPECT_NE(Key::hash_connection_string(base + "FailOn=SQLGetTypeInfo;"), plain);
+
+    Key basic = key;
+    basic.connection_hash = Key::hash_connection_string(base + "Types=BasicTypes;");
+    key.connection_hash = plain;
+    EXPECT_NE(basic.file_name(), key.file_name());
+    CapabilityProfile profile(key);
+    profile.record_types({make_type("CHAR", SQL_CHAR)});
+    profile.save(path());
+    EXPECT_TRUE(CapabilityProfile::load(path(), key).has_value());
+    EXPECT_FALSE(CapabilityProfile::load(path(), basic).has_value());
+}
+
+TEST_F(CapabilityProfileTest, SaveLeavesNoTemporaryFiles) {
+    CapabilityProfile profile(key);
+    profile.record_types({make_type("CHAR", SQL_CHAR)});
+    profile.save(path());
+    profile.save(path());
+    size_t files = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(dir)) {
+        EXPECT_EQ(entry.path().string(), path());
+        ++files;
+    }
+    EXPECT_EQ(files, 1u);
+}
+
+TEST_F(CapabilityProfileTest, ReplaysDiscoveryWithoutTheDriver) {
+    core::OdbcEnvironment env;
+    core::OdbcConnection conn(env);
+    try {
+        conn.connect(test::get_mock_connection());
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+
+    auto live_key = CapabilityProfile::Key::query(conn);
+    EXPECT_FALSE(live_key.driver_name.empty());
+    CapabilityProfile profile(live_key);
+    discovery::DriverInfo driver_info(conn);
+    discovery::TypeInfo type_info(conn);
+    discovery::FunctionInfo func_info(conn);
+    driver_info.collect(profile);
+    type_info.collect(profile);
+    func_info.collect(profile);
+    ASSERT_NE(profile.types(), nullptr);
+    ASSERT_NE(profile.functions(), nullptr);
+    EXPECT_GT(type_info.count(), 0u);
+    // Connection-specific answers are never stored
+    EXPECT_EQ(profile.find_info_string(SQL_USER_NAME), nullptr);
+    EXPECT_EQ(profile.find_info_string(SQL_DATA_SOURCE_NAME), nullptr);
+    EXPECT_EQ(profile.find_info_string(SQL_DATA_SOURCE_READ_ONLY), nullptr);
+    profile.save(CapabilityProfile::path_for(dir.string(), live_key));
+
+    // A connection on which SQLGetTypeInfo fails still gets the type list,
+    // because the profile answers it
+    core::OdbcConnection failing(env);
+    failing.connect(test::get_mock_connection_with_failure("SQLGetTypeInfo"));
+    auto cached = CapabilityProfile::load(CapabilityProfile::path_for(dir.string(), live_key), live_key);
+    ASSERT_TRUE(cached.has_value());
+
+    discovery::DriverInfo cached_driver(failing);
+    discovery::TypeInfo cached_types(failing);
+    discovery::FunctionInfo cached_funcs(failing);
+    EXPECT_THROW(cached_types.collect(), core::OdbcError);
+    EXPECT_NO_THROW(cached_types.collect(*cached));
+    cached_driver.collect(*cached);
+    cached_funcs.collect(*cached);
+    EXPECT_FALSE(cached->modified());
+
+    EXPECT_EQ(cached_types.count(), type_info.count());
+    EXPECT_EQ(cached_driver.get_properties().dbms_name, driver_info.get_properties().dbms_name);
+    EXPECT_EQ(cached_driver.get_scalar_functions().string_bitmask,
+              driver_info.get_scalar_functions().string_bitmask);
+    EXPECT_EQ(cached_funcs.supported_count(), func_info.supported_count());
+}
+
+TEST_F(CapabilityProfileTest, CategoriesSkipFunctionsTheProfileLacks) {
+    core::OdbcEnvironment env;
+    core::OdbcConnection conn(env);
+    try {
+        conn.connect(test::get_mock_connection());
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+
+    // No bit for SQLTables: the benchmark skips before creating any table
+    CapabilityProfile profile(key);
+    profile.record_functions(CapabilityProfile::FunctionBitmap{});
+
+    tests::CatalogScaleTests test_suite(conn);
+    test_suite.set_capabilities(&profile);
+    auto results = test_suite.run();
+
+    ASSERT_EQ(results.size(), 1u);
+    EXPECT_EQ(results[0].status, tests::TestStatus::SKIP_UNSUPPORTED);
+    EXPECT_NE(results[0].actual.find("not implemented"), std::string::npos) << results[0].actual;
+}
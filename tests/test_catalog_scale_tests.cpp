@@ -0,0 +1,100 @@
+#include <gtest/gtest.h>
+#include "tests/catalog_scale_tests.hpp"
+#include "core/odbc_environment.hpp"
+#include "core/odbc_connection.hpp"
+#include "core/odbc_statement.hpp"
+#include "mock_connection.hpp"
+#include <iostream>
+
+using namespace odbc_crusher;
+
+class CatalogScaleTestsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        env = std::make_unique<core::OdbcEnvironment>();
+    }
+    std::unique_ptr<core::OdbcEnvironment> env;
+};
+
+TEST_F(CatalogScaleTestsTest, TimesCatalogFunctionsOnLargeMockCatalog) {
+    core::OdbcConnection conn(*env);
+    try {
+        conn.connect("Driver={Mock ODBC Driver};Mode=Success;Catalog=Large;"
+                     "CatalogTables=2000;CatalogColumns=50;");
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+    
+    tests::CatalogScaleOptions options;
+    options.tables = 2000;
+    tests::CatalogScaleTests test_suite(conn, options);
+    auto results = test_suite.run();
+    
+    ASSERT_EQ(results.size(), 1u);
+    const auto& r = results[0];
+    std::cout << "[" << tests::status_to_string(r.status) << "] " << r.test_name
+              << ": " << r.actual << "\n";
+    
+    // The generated tables are used as they are: 2000 of them plus the
+    // default preset's, each call returns the table it named
+    EXPECT_NE(r.status, tests::TestStatus::ERR) << r.actual << r.diagnostic.value_or("");
+    EXPECT_FALSE(r.status == tests::TestStatus::FAIL && r.severity == tests::Severity::ERR)
+        << r.actual << r.diagnostic.value_or("");
+    EXPECT_NE(r.actual.find("columns; full sweep"), std::string::npos) << r.actual;
+}
+
+TEST_F(CatalogScaleTestsTest, CreatesTablesWhenCatalogIsSmall) {
+    core::OdbcConnection conn(*env);
+    try {
+        conn.connect(test::get_mock_connection());
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+    
+    tests::CatalogScaleOptions options;
+    options.tables = 30;
+    options.columns = 8;
+    options.create_tables = true;
+    tests::CatalogScaleTests test_suite(conn, options);
+    auto results = test_suite.run();
+    
+    ASSERT_EQ(results.size(), 1u);
+    const auto& r = results[0];
+    std::cout << "[" << tests::status_to_string(r.status) << "] " << r.test_name
+              << ": " << r.actual << "\n";
+    
+    // The created tables are found by name and dropped again
+    EXPECT_NE(r.status, tests::TestStatus::ERR) << r.actual << r.diagnostic.value_or("");
+    EXPECT_NE(r.status, tests::TestStatus::FAIL) << r.actual << r.diagnostic.value_or("");
+    EXPECT_NE(r.actual.find("columns; full sweep"), std::string::npos) << r.actual;
+    
+    core::OdbcStatement check(conn);
+    EXPECT_FALSE(check.try_execute("SELECT * FROM ODBC_TEST_CAT_1"));
+}
+
+TEST_F(CatalogScaleTestsTest, UsesExistingTablesByDefault) {
+    core::OdbcConnection conn(*env);
+    try {
+        conn.connect(test::get_mock_connection());
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+    
+    tests::CatalogScaleOptions options;
+    options.tables = 30;
+    tests::CatalogScaleTests test_suite(conn, options);
+    auto results = test_suite.run();
+    
+    ASSERT_EQ(results.size(), 1u);
+    const auto& r = results[0];
+    std::cout << "[" << tests::status_to_string(r.status) << "] " << r.test_name
+              << ": " << r.actual << "\n";
+    
+    // Only the default preset's tables are timed; none are created
+    EXPECT_NE(r.status, tests::TestStatus::ERR) << r.actual << r.diagnostic.value_or("");
+    ASSERT_NE(r.actual.find(" tables, "), std::string::npos) << r.actual;
+    EXPECT_LT(std::stoul(r.actual), 30u) << r.actual;
+    
+    core::OdbcStatement check(conn);
+    EXPECT_FALSE(check.try_execute("SELECT * FROM ODBC_TEST_CAT_1"));
+}
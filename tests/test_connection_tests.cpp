@@ -2,6 +2,8 @@
 #include "tests/connection_tests.hpp"
 #include "core/odbc_environment.hpp"
 #include "core/odbc_connection.hpp"
+#include "mock_connection.hpp"
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 
@@ -102,3 +104,31 @@ TEST_F(ConnectionTestsTest, RunMySQLConnectionTests) {
     std::cout << "\n";
     EXPECT_GT(passed, 0);
 }
+
+TEST_F(ConnectionTestsTest, ConnectLatencyThroughMockDriver) {
+    core::OdbcConnection conn(*env);
+    try {
+        conn.connect(test::get_mock_connection());
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+    
+    tests::ConnectBenchmarkOptions options;
+    options.connects = 10;
+    options.threads = 4;
+    tests::ConnectionTests test_suite(conn, options);
+    auto results = test_suite.run();
+    
+    auto it = std::find_if(results.begin(), results.end(),
+                           [](const tests::TestResult& r) { return r.test_name == "test_connect_latency"; });
+    ASSERT_NE(it, results.end());
+    std::cout << "[" << tests::status_to_string(it->status) << "] " << it->test_name
+              << ": " << it->actual << "\n";
+    
+    // Every phase reconnects with the main connection's string, and the
+    // storm's connects all succeed
+    EXPECT_NE(it->status, tests::TestStatus::FAIL) << it->actual << it->diagnostic.value_or("");
+    EXPECT_NE(it->status, tests::TestStatus::ERR) << it->actual << it->diagnostic.value_or("");
+    EXPECT_NE(it->actual.find("4-thread storm"), std::string::npos) << it->actual;
+    EXPECT_TRUE(conn.is_connected());
+}
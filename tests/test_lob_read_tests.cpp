@@ -0,0 +1,41 @@
+#include <gtest/gtest.h>
+#include "tests/lob_read_tests.hpp"
+#include "core/odbc_environment.hpp"
+#include "core/odbc_connection.hpp"
+#include "mock_connection.hpp"
+#include <iostream>
+
+using namespace odbc_crusher;
+
+class LobReadTestsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        env = std::make_unique<core::OdbcEnvironment>();
+    }
+    std::unique_ptr<core::OdbcEnvironment> env;
+};
+
+TEST_F(LobReadTestsTest, ReadsLobInChunksThroughMockDriver) {
+    core::OdbcConnection conn(*env);
+    try {
+        conn.connect(test::get_mock_connection());
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+    
+    tests::LobReadOptions options;
+    options.lob_bytes = 1024 * 1024;
+    tests::LobReadTests test_suite(conn, options);
+    auto results = test_suite.run();
+    
+    ASSERT_EQ(results.size(), 3u);
+    for (const auto& r : results) {
+        std::cout << "[" << tests::status_to_string(r.status) << "] " << r.test_name
+                  << ": " << r.actual << "\n";
+        
+        // The mock driver returns successive pieces of the stored value
+        EXPECT_EQ(r.status, tests::TestStatus::PASS) << r.actual << r.diagnostic.value_or("");
+        EXPECT_NE(r.actual.find("1KB="), std::string::npos) << r.actual;
+        EXPECT_NE(r.actual.find("1MB="), std::string::npos) << r.actual;
+    }
+}
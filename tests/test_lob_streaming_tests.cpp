@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include "tests/lob_streaming_tests.hpp"
+#include "core/odbc_environment.hpp"
+#include "core/odbc_connection.hpp"
+#include "mock_connection.hpp"
+#include <iostream>
+
+using namespace odbc_crusher;
+
+class LobStreamingTestsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        env = std::make_unique<core::OdbcEnvironment>();
+    }
+    std::unique_ptr<core::OdbcEnvironment> env;
+};
+
+TEST_F(LobStreamingTestsTest, StreamsLobThroughMockDriver) {
+    core::OdbcConnection conn(*env);
+    try {
+        conn.connect(test::get_mock_connection());
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+    
+    tests::LobBenchmarkOptions options;
+    options.lob_bytes = 4 * 1024 * 1024;
+    options.chunk_bytes = 32 * 1024;
+    tests::LobStreamingTests test_suite(conn, options);
+    auto results = test_suite.run();
+    
+    ASSERT_EQ(results.size(), 1u);
+    const auto& r = results[0];
+    std::cout << "[" << tests::status_to_string(r.status) << "] " << r.test_name
+              << ": " << r.actual << "\n";
+    
+    // The mock driver collects SQLPutData chunks and inserts the value
+    EXPECT_EQ(r.status, tests::TestStatus::PASS) << r.actual << r.diagnostic.value_or("");
+    EXPECT_NE(r.actual.find("Streamed 4.0 of 4.0 MB in 128 chunks"), std::string::npos) << r.actual;
+}
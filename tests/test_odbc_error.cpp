@@ -30,3 +30,39 @@ TEST(OdbcErrorTest, FormatDiagnostics) {
     EXPECT_NE(formatted.find("12345"), std::string::npos);
     EXPECT_NE(formatted.find("Connection failed"), std::string::npos);
 }
+
+TEST(OdbcErrorTest, SqlStateCompare) {
+    SqlState state("40001");
+    EXPECT_TRUE(state == "40001");
+    EXPECT_TRUE(state != "40002");
+    EXPECT_TRUE(state.is_class("40"));
+    EXPECT_FALSE(state.is_class("42"));
+    EXPECT_EQ(state.str(), "40001");
+    
+    SqlState none;
+    EXPECT_TRUE(none.empty());
+    EXPECT_FALSE(none.is_class("40"));
+    EXPECT_TRUE(none != state);
+}
+
+TEST(OdbcErrorTest, ResultSuccess) {
+    OdbcResult result(SQL_SUCCESS_WITH_INFO, SQL_HANDLE_STMT, SQL_NULL_HANDLE);
+    EXPECT_TRUE(result.ok());
+    EXPECT_TRUE(static_cast<bool>(result));
+    EXPECT_EQ(result.code(), SQL_SUCCESS_WITH_INFO);
+    EXPECT_NO_THROW(result.throw_if_error("SQLExecDirect"));
+}
+
+TEST(OdbcErrorTest, ResultFailureThrows) {
+    // A null handle has no diagnostics to read
+    OdbcResult result(SQL_ERROR, SQL_HANDLE_STMT, SQL_NULL_HANDLE);
+    EXPECT_FALSE(result.ok());
+    EXPECT_TRUE(result.sqlstate().empty());
+    try {
+        result.throw_if_error("SQLExecDirect");
+        FAIL() << "Expected OdbcError";
+    } catch (const OdbcError& e) {
+        EXPECT_STREQ(e.what(), "SQLExecDirect");
+        EXPECT_TRUE(e.diagnostics().empty());
+    }
+}
@@ -0,0 +1,48 @@
+#include <gtest/gtest.h>
+#include "tests/prepared_statement_tests.hpp"
+#include "core/odbc_environment.hpp"
+#include "core/odbc_connection.hpp"
+#include "mock_connection.hpp"
+#include <iostream>
+
+using namespace odbc_crusher;
+
+class PreparedStatementTestsTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        env = std::make_unique<core::OdbcEnvironment>();
+    }
+    std::unique_ptr<core::OdbcEnvironment> env;
+};
+
+TEST_F(PreparedStatementTestsTest, ComparesExecutionMethodsThroughMockDriver) {
+    core::OdbcConnection conn(*env);
+    try {
+        conn.connect(test::get_mock_connection());
+    } catch (const std::exception& e) {
+        GTEST_SKIP() << "Could not connect: " << e.what();
+    }
+    
+    tests::PreparedStatementOptions options;
+    options.executions = 2000;
+    tests::PreparedStatementTests test_suite(conn, options);
+    auto results = test_suite.run();
+    
+    ASSERT_EQ(results.size(), 1u);
+    const auto& r = results[0];
+    std::cout << "[" << tests::status_to_string(r.status) << "] " << r.test_name
+              << ": " << r.actual << "\n";
+    
+    // The outcome of the timing comparison depends on the machine; check
+    // that all three loops ran and returned the right rows
+    EXPECT_NE(r.status, tests::TestStatus::ERR) << r.actual << r.diagnostic.value_or("");
+    EXPECT_FALSE(r.diagnostic.has_value()) << r.diagnostic.value_or("");
+    EXPECT_NE(r.severity, tests::Severity::ERR) << r.actual;
+    EXPECT_EQ(r.actual.find("wrong or missing row"), std::string::npos) << r.actual;
+    for (const char* part : {"SQLExecDirect p50 ", "prepared once p50 ", "re-prepared p50 ",
+                             "SQLPrepare p50 "}) {
+        EXPECT_NE(r.actual.find(part), std::string::npos) << part << " missing: " << r.actual;
+    }
+    EXPECT_TRUE(r.actual.find("break-even after") != std::string::npos ||
+                r.actual.find("preparing never breaks even") != std::string::npos) << r.actual;
+}